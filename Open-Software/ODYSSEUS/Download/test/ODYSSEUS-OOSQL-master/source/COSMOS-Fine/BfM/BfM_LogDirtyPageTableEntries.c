@@ -78,7 +78,7 @@
  *  The log records is a part of a checkpoint log records.
  *
  * Exports:
- *  Four BfM_LogDirtyPageTableEntries(void)
+ *  Four BfM_LogDirtyPageTableEntries(Four, Lsn_T*)
  */
 
 
@@ -97,11 +97,12 @@
 /*@
  * Internal Function Prototypes
  */
-static Four bfm_LogDirtyPageTableEntries(Four, Four);
+static Four bfm_LogDirtyPageTableEntries(Four, Four, Lsn_T*);
 
 
 Four BfM_LogDirtyPageTableEntries(
-    Four		handle)
+    Four		handle,
+    Lsn_T		*minRecLsn)		/* INOUT lowered to the smallest recLsn of the logged pages */
 {
     Four 		e;                     /* error code */
     Four 		type;                  /* buffer type */
@@ -114,7 +115,7 @@ Four BfM_LogDirtyPageTableEntries(
     for (type = 0; type < NUM_BUF_TYPES; type++) {
 
         /* log dirty page table entries */
-        e = bfm_LogDirtyPageTableEntries(handle,type);
+        e = bfm_LogDirtyPageTableEntries(handle, type, minRecLsn);
         if (e < eNOERROR) ERR(handle, e);
     }
 
@@ -126,7 +127,8 @@ Four BfM_LogDirtyPageTableEntries(
 
 Four bfm_LogDirtyPageTableEntries(
     Four		handle,
-    Four 		type)                  	/* IN buffer type */
+    Four 		type,                  	/* IN buffer type */
+    Lsn_T		*minRecLsn)		/* INOUT lowered to the smallest recLsn of the logged pages */
 {
     Four 		e;			/* returned error number */
     BufTBLEntry 	*anEntry;		/* Buffer Table Entry to be checked */
@@ -164,6 +166,8 @@ Four bfm_LogDirtyPageTableEntries(
 		dirtyPages[nDirtyPages].pid = *((PageID*)&(anEntry->key));
 		dirtyPages[nDirtyPages].recLsn = anEntry->recLsn;
 
+		if (LSN_CMP_LT(anEntry->recLsn, *minRecLsn)) *minRecLsn = anEntry->recLsn;
+
 		nDirtyPages++;
 
 	    } /* if  */
@@ -160,6 +160,13 @@ Four BfM_RemoveLogPages(
 		SET_NILBFMHASHKEY(anEntry->key);
                 anEntry->fixed = 0;
 
+		/* the buffer can be reused without replacement */
+		e = bfm_addFreeBuffer(handle, anEntry, type);
+		if (e < eNOERROR) {
+		    ERROR_PASS(handle, bfm_unlock(handle, (TrainID *)&localKey, type));
+		    ERR(handle, e);
+		}
+
 		/*@ release latch */
 		/* mutex begin :: for update Buffer Table Entry */
 		ERROR_PASS(handle, bfm_unlock(handle, (TrainID *)&localKey, type));
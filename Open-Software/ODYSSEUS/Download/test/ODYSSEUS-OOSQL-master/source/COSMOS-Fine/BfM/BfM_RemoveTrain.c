@@ -185,6 +185,13 @@ Four BfM_RemoveTrain(
     /* fixed counter is reset to 0. */
     anEntry->fixed = 0;
 
+    /* the buffer can be reused without replacement */
+    e = bfm_addFreeBuffer(handle, anEntry, type);
+    if (e < eNOERROR) {
+        ERROR_PASS(handle, bfm_unlock(handle, trainId, type));
+        ERR(handle, e);
+    }
+
 
     /*@
      * release latch
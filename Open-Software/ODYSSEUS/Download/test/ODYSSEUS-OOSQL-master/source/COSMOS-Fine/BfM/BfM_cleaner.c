@@ -0,0 +1,686 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: BfM_cleaner.c
+ *
+ * Description :
+ *  Background page cleaners of the buffer manager.
+ *  A page cleaner periodically writes out the dirty buffers which the
+ *  clock hand of bfm_allocBuffer() will visit next, so that a victim can
+ *  be reused without a synchronous write in the foreground thread.
+ *  The cleaners are started when the first handle of a process is
+ *  allocated, and stopped before the last one of the process is freed.
+ *  The first cleaner of a process also bounds the log which the restart
+ *  recovery has to scan (CFG_RMTARGETREDODISTANCE): it writes out the
+ *  buffers dirty for long in the order of their recLsn and takes a
+ *  checkpoint when that moves the redo point ahead.
+ *
+ * Exports:
+ *  Four BfM_StartCleaners(Four)
+ *  Four BfM_StopCleaners(Four)
+ *  Four BfM_NumCleaners(void)
+ *  Four BfM_GetStatistics(Four, Four, BfM_Statistics_T*)
+ *  Four bfm_cleanBuffers(Four, Four)
+ */
+
+
+#include <stdlib.h>  /* for qsort */
+#ifndef WIN32
+#include <unistd.h>  /* for usleep */
+#endif /* WIN32 */
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "SHM.h"
+#include "RDsM.h"
+#include "BfM.h"
+#include "LOG.h"
+#include "RM.h"
+#include "THM_cosmosThread.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*
+ * Per-process data structures of the page cleaners
+ */
+static cosmos_thread_t  bfm_cleanerTids[BFM_MAX_CLEANERS];    /* thread ids of the cleaners */
+static Four             bfm_cleanerHandles[BFM_MAX_CLEANERS]; /* handles of the cleaners */
+static Four             bfm_nCleaners = 0;                    /* # of running cleaners */
+static volatile Boolean bfm_stopCleanersFlag = FALSE;         /* TRUE if the cleaners should exit */
+
+
+/* a dirty buffer found by the cleaner */
+typedef struct {
+    BfMHashKey  key;		/* page in the buffer */
+    BufTBLEntry *entry;		/* buffer table entry of the buffer */
+    Lsn_T       recLsn;		/* recovery lsn of the buffer */
+} bfm_CleanCandidate;
+
+
+/*
+ * Internal Function Prototypes
+ */
+static void *bfm_cleanerMain(void *);
+static Four bfm_boundRedoDistance(Four);
+static Four bfm_writeOldBuffers(Four, Four, Lsn_T *, Eight, Lsn_T *);
+static int bfm_compareCleanCandidates(const void *, const void *);
+static int bfm_compareRecLsns(const void *, const void *);
+
+
+
+/*@================================
+ * BfM_StartCleaners( )
+ *================================*/
+/*
+ * Function: Four BfM_StartCleaners(Four)
+ *
+ * Description :
+ *  Start CFG_BFMNUMCLEANERS page cleaners in this process.
+ *  Each cleaner runs on its own handle which is allocated here.
+ *
+ * CAUTION :: This function is called in the critical section for the
+ *            shared memory access.
+ *
+ * Returns :
+ *  error codes
+ */
+Four BfM_StartCleaners(
+    Four handle)		/* IN handle of the calling thread */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four cleanerHandle;		/* handle of a new cleaner */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_StartCleaners(handle=%ld)", handle));
+
+
+    if (bfm_nCleaners > 0) return(eNOERROR);
+
+    bfm_stopCleanersFlag = FALSE;
+
+    for (i = 0; i < CFG_BFMNUMCLEANERS && i < BFM_MAX_CLEANERS; i++) {
+
+	e = THM_AllocHandle(&cleanerHandle);
+	if (e < eNOERROR) ERR(handle, e);
+
+	bfm_cleanerHandles[i] = cleanerHandle;
+
+	e = cosmos_thread_create(&bfm_cleanerTids[i], bfm_cleanerMain, (void *)&bfm_cleanerHandles[i], 0);
+	if (e < eNOERROR) {
+	    (void) THM_FreeHandle(cleanerHandle);
+	    ERR(handle, e);
+	}
+
+	bfm_nCleaners++;
+    }
+
+    return(eNOERROR);
+
+} /* BfM_StartCleaners() */
+
+
+
+/*@================================
+ * BfM_StopCleaners( )
+ *================================*/
+/*
+ * Function: Four BfM_StopCleaners(Four)
+ *
+ * Description :
+ *  Stop all the page cleaners of this process and free their handles.
+ *
+ * CAUTION :: This function is called in the critical section for the
+ *            shared memory access. The cleaners never enter the critical
+ *            section, so they can be waited for here.
+ *
+ * Returns :
+ *  error codes
+ */
+Four BfM_StopCleaners(
+    Four handle)		/* IN handle of the calling thread */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_StopCleaners(handle=%ld)", handle));
+
+
+    bfm_stopCleanersFlag = TRUE;
+
+    for (i = 0; i < bfm_nCleaners; i++) {
+	e = cosmos_thread_wait(bfm_cleanerTids[i]);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    for (i = 0; i < bfm_nCleaners; i++) {
+	e = RDsM_DetachVolumes(bfm_cleanerHandles[i]);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = THM_FreeHandle(bfm_cleanerHandles[i]);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    bfm_nCleaners = 0;
+
+    return(eNOERROR);
+
+} /* BfM_StopCleaners() */
+
+
+
+/*@================================
+ * BfM_NumCleaners( )
+ *================================*/
+/*
+ * Function: Four BfM_NumCleaners(void)
+ *
+ * Description :
+ *  Return the number of page cleaners running in this process.
+ *
+ * Returns :
+ *  # of page cleaners
+ */
+Four BfM_NumCleaners(void)
+{
+    return(bfm_nCleaners);
+
+} /* BfM_NumCleaners() */
+
+
+
+/*@================================
+ * BfM_GetStatistics( )
+ *================================*/
+/*
+ * Function: Four BfM_GetStatistics(Four, Four, BfM_Statistics_T*)
+ *
+ * Description :
+ *  Get the statistics of the buffer pool of the given type.
+ *  The statistics are gathered without latches, so they are approximate.
+ *
+ * Returns :
+ *  error codes
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER - bad parameter
+ */
+Four BfM_GetStatistics(
+    Four handle,
+    Four type,			/* IN buffer type */
+    BfM_Statistics_T *stats)	/* OUT statistics */
+{
+    Four i;			/* loop index */
+    BufTBLEntry *anEntry;	/* buffer table entry */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_GetStatistics(type=%ld, stats=%P)", type, stats));
+
+
+    if (IS_BAD_BUFFERTYPE(type)) ERR(handle, eBADBUFFERTYPE_BFM);
+
+    if (stats == NULL) ERR(handle, eBADPARAMETER);
+
+    stats->nBufs = BI_NBUFS(type);
+    stats->nDirtyBufs = 0;
+
+    for (i = 0; i < BI_NBUFS(type); i++) {
+	anEntry = &BI_BTENTRY(type, i);
+	if (anEntry->dirtyFlag && !anEntry->invalidFlag) stats->nDirtyBufs++;
+    }
+
+    stats->nVictims = BI_NVICTIMS(type);
+    stats->nDirtyVictims = BI_NDIRTYVICTIMS(type);
+    stats->nCleanerWrites = BI_NCLEANERWRITES(type);
+    stats->nPrefetched = BI_NPREFETCHED(type);
+    stats->nPrefetchHits = BI_NPREFETCHHITS(type);
+
+    return(eNOERROR);
+
+} /* BfM_GetStatistics() */
+
+
+
+/*@================================
+ * bfm_cleanBuffers( )
+ *================================*/
+/*
+ * Function: Four bfm_cleanBuffers(Four, Four)
+ *
+ * Description :
+ *  Write out the dirty buffers among the next (CFG_BFMCLEANRATIO)% of the
+ *  buffers which the clock hand of each partition will visit. The buffers are written in the
+ *  order of their page ids to reduce the seek time of the disk.
+ *  Only the buffers not fixed by anyone are written; they are locked by
+ *  bfm_lock() as bfm_allocBuffer() does before it flushes a victim.
+ *  Write-Ahead-Logging is guaranteed by bfm_flushBuffer().
+ *
+ * Returns :
+ *  error codes
+ */
+Four bfm_cleanBuffers(
+    Four handle,
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four partNo;		/* partition number */
+    bfm_Partition *part;	/* partition being scanned */
+    Four nScan;			/* # of buffers to be scanned */
+    Four idx;			/* index of the buffer being scanned in the partition */
+    Four nCandidates;		/* # of dirty buffers found */
+    BufTBLEntry *anEntry;	/* buffer table entry */
+    bfm_CleanCandidate *candidates; /* dirty buffers to be written */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_cleanBuffers(type=%ld)", type));
+
+
+    if (IS_BAD_BUFFERTYPE(type)) ERR(handle, eBADBUFFERTYPE_BFM);
+
+    nScan = (BI_NBUFS(type) * CFG_BFMCLEANRATIO) / 100;
+    if (nScan <= 0) return(eNOERROR);
+
+    /* Only one cleaner scans a buffer pool at a time. */
+    e = SHM_getLatch(handle, &BI_CLEANERLATCH(type), procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+    if (e == SHM_BUSYLATCH) return(eNOERROR);
+    if (e < eNOERROR) ERR(handle, e);
+
+    candidates = (bfm_CleanCandidate *)malloc(sizeof(bfm_CleanCandidate) * nScan);
+    if (candidates == NULL) ERRL1(handle, eMEMORYALLOCERR, &BI_CLEANERLATCH(type));
+
+    /*
+     * Collect the dirty buffers ahead of the clock hands.
+     * The entries are read without latch; they are checked again
+     * after bfm_lock() is acquired.
+     */
+    nCandidates = 0;
+    for (partNo = 0; partNo < BI_NPARTITIONS(type); partNo++) {
+	part = &BI_PARTITION(type, partNo);
+
+	idx = part->nextVictim % part->nBufs;
+	for (i = 0; i < (part->nBufs * CFG_BFMCLEANRATIO) / 100; i++, idx = (idx + 1) % part->nBufs) {
+	    anEntry = &BI_BTENTRY(type, part->firstBuf + idx);
+
+	    if (anEntry->dirtyFlag && !anEntry->invalidFlag && anEntry->fixed <= 0 &&
+		!IS_NILBFMHASHKEY(anEntry->key)) {
+		candidates[nCandidates].key = anEntry->key;
+		candidates[nCandidates].entry = anEntry;
+		nCandidates++;
+	    }
+	}
+    }
+
+    qsort(candidates, nCandidates, sizeof(bfm_CleanCandidate), bfm_compareCleanCandidates);
+
+    for (i = 0; i < nCandidates && !bfm_stopCleanersFlag; i++) {
+	anEntry = candidates[i].entry;
+
+	/* The volume may have been dismounted since; skip the buffer then. */
+	e = RDsM_AttachVolume(handle, candidates[i].key.volNo);
+	if (e < eNOERROR) continue;
+
+	e = bfm_lock(handle, (TrainID *)&candidates[i].key, type);
+	if (e < eNOERROR) break;
+
+	if (EQUALKEY(&anEntry->key, &candidates[i].key) &&
+	    anEntry->dirtyFlag && !anEntry->invalidFlag && anEntry->fixed == 0) {
+
+	    e = bfm_flushBuffer(handle, anEntry, type);
+
+	    /* The page will have no update logged before the next log record. */
+	    if (e >= eNOERROR) e = LOG_GetNextLogRecordLsn(handle, &anEntry->recLsn);
+
+	    if (e >= eNOERROR) BI_NCLEANERWRITES(type)++;
+	}
+
+	if (e < eNOERROR) {
+	    (void) bfm_unlock(handle, (TrainID *)&candidates[i].key, type);
+	    break;
+	}
+
+	e = bfm_unlock(handle, (TrainID *)&candidates[i].key, type);
+	if (e < eNOERROR) break;
+    }
+
+    free(candidates);
+
+    if (e < eNOERROR) ERRL1(handle, e, &BI_CLEANERLATCH(type));
+
+    e = SHM_releaseLatch(handle, &BI_CLEANERLATCH(type), procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_cleanBuffers() */
+
+
+
+/*
+ * Function: void *bfm_cleanerMain(void*)
+ *
+ * Description :
+ *  Start routine of a page cleaner.
+ *  It cleans every buffer pool and sleeps CFG_BFMCLEANERINTERVAL msec
+ *  until BfM_StopCleaners() is called. An error is reported by ERR()
+ *  and the cleaner retries at the next pass.
+ */
+static void *bfm_cleanerMain(
+    void *arg)			/* IN pointer to the handle of the cleaner */
+{
+    Four handle = *(Four *)arg;	/* handle of this cleaner */
+    Four type;			/* buffer type */
+    Boolean firstCleaner = ((Four *)arg == &bfm_cleanerHandles[0]);
+
+
+    while (!bfm_stopCleanersFlag) {
+
+	for (type = 0; type < NUM_BUF_TYPES && !bfm_stopCleanersFlag; type++)
+	    (void) bfm_cleanBuffers(handle, type);
+
+	if (firstCleaner && !bfm_stopCleanersFlag &&
+	    (CFG_RMTARGETREDODISTANCE > 0 || CFG_RMCHECKPOINTDISTANCE > 0))
+	    (void) bfm_boundRedoDistance(handle);
+
+	if (!bfm_stopCleanersFlag) usleep(CFG_BFMCLEANERINTERVAL * 1000);
+    }
+
+    return(NULL);
+
+} /* bfm_cleanerMain() */
+
+
+
+/*
+ * Function: Four bfm_boundRedoDistance(Four)
+ *
+ * Description :
+ *  Keep the log scanned by the restart recovery within
+ *  CFG_RMTARGETREDODISTANCE Kbytes.
+ *  The buffers whose recLsn is more than a half of the target behind the
+ *  end of the log are written out in every pass. So the write rate follows
+ *  the log generation rate: the faster the log grows, the more buffers
+ *  fall behind between two passes.
+ *  A checkpoint is taken when the redo distance of the recent checkpoint
+ *  reaches 3/4 of the target and the dirty buffers left allow a later redo
+ *  point, or when CFG_RMCHECKPOINTDISTANCE Kbytes of log have been written
+ *  since the recent checkpoint.
+ *
+ * Returns :
+ *  error codes
+ */
+static Four bfm_boundRedoDistance(
+    Four handle)
+{
+    Four e;			/* error returned */
+    Four type;			/* buffer type */
+    Eight target;		/* target redo distance in bytes */
+    Boolean checkpointFlag;	/* TRUE if a checkpoint should be taken */
+    Lsn_T minRecLsn;		/* the smallest recLsn of the dirty buffers left */
+    Lsn_T ckptLsn;		/* lsn of the recent checkpoint */
+    LOG_Statistics_T logStats;	/* log manager statistics */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_boundRedoDistance()"));
+
+
+    e = LOG_GetStatistics(handle, &logStats);
+    if (e < eNOERROR) ERR(handle, e);
+
+    checkpointFlag = (CFG_RMCHECKPOINTDISTANCE > 0 &&
+		      LOG_GET_DISTANCE_BTW_LSNS(logStats.nextLsn, logStats.checkpointLsn) >= (Eight)CFG_RMCHECKPOINTDISTANCE * 1024);
+
+    target = (Eight)CFG_RMTARGETREDODISTANCE * 1024;
+    if (target > 0) {
+
+	minRecLsn = logStats.nextLsn;
+	for (type = 0; type < NUM_BUF_TYPES && !bfm_stopCleanersFlag; type++) {
+	    e = bfm_writeOldBuffers(handle, type, &logStats.nextLsn, target / 2, &minRecLsn);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+
+	if (logStats.redoDistance >= target - target / 4 && LSN_CMP_GT(minRecLsn, logStats.redoLsn))
+	    checkpointFlag = TRUE;
+    }
+
+    if (!checkpointFlag || bfm_stopCleanersFlag) return(eNOERROR);
+
+    /* The checkpoints are serialized with those of the log file switch. */
+    e = SHM_getLatch(handle, &LOG_LATCH4LOGFILESWITCH, procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+    if (e == SHM_BUSYLATCH) return(eNOERROR);
+    if (e < eNOERROR) ERR(handle, e);
+
+    /* Another process may have taken a checkpoint meanwhile. */
+    e = LOG_GetCheckpointLsn(handle, &ckptLsn);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4LOGFILESWITCH);
+
+    if (LSN_CMP_EQ(ckptLsn, logStats.checkpointLsn)) {
+	e = RM_Checkpoint(handle);
+	if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4LOGFILESWITCH);
+    }
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4LOGFILESWITCH, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_boundRedoDistance() */
+
+
+
+/*
+ * Function: Four bfm_writeOldBuffers(Four, Four, Lsn_T*, Eight, Lsn_T*)
+ *
+ * Description :
+ *  Write out the dirty buffers whose recLsn is more than 'maxDistance'
+ *  bytes of log behind 'nextLsn', in the order of their recLsn.
+ *  The fixed buffers are skipped. 'minRecLsn' is lowered to the recLsn
+ *  of the dirty buffers left.
+ *
+ * Returns :
+ *  error codes
+ */
+static Four bfm_writeOldBuffers(
+    Four handle,
+    Four type,			/* IN buffer type */
+    Lsn_T *nextLsn,		/* IN lsn of the next log record */
+    Eight maxDistance,		/* IN distance from nextLsn allowed for a dirty buffer */
+    Lsn_T *minRecLsn)		/* INOUT the smallest recLsn of the dirty buffers left */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four nCandidates;		/* # of buffers to be written */
+    BufTBLEntry *anEntry;	/* buffer table entry */
+    bfm_CleanCandidate *candidates; /* buffers to be written */
+
+
+    candidates = (bfm_CleanCandidate *)malloc(sizeof(bfm_CleanCandidate) * BI_NBUFS(type));
+    if (candidates == NULL) ERR(handle, eMEMORYALLOCERR);
+
+    /*
+     * Collect the old dirty buffers.
+     * The entries are read without latch; they are checked again
+     * after bfm_lock() is acquired.
+     */
+    nCandidates = 0;
+    for (i = 0; i < BI_NBUFS(type); i++) {
+	anEntry = &BI_BTENTRY(type, i);
+
+	if (!anEntry->dirtyFlag || anEntry->invalidFlag || IS_NILBFMHASHKEY(anEntry->key)) continue;
+
+	if (anEntry->fixed <= 0 && LOG_GET_DISTANCE_BTW_LSNS(*nextLsn, anEntry->recLsn) > maxDistance) {
+	    candidates[nCandidates].key = anEntry->key;
+	    candidates[nCandidates].entry = anEntry;
+	    candidates[nCandidates].recLsn = anEntry->recLsn;
+	    nCandidates++;
+	}
+	else if (LSN_CMP_LT(anEntry->recLsn, *minRecLsn))
+	    *minRecLsn = anEntry->recLsn;
+    }
+
+    qsort(candidates, nCandidates, sizeof(bfm_CleanCandidate), bfm_compareRecLsns);
+
+    e = eNOERROR;
+    for (i = 0; i < nCandidates && !bfm_stopCleanersFlag; i++) {
+	anEntry = candidates[i].entry;
+
+	/* The volume may have been dismounted since; skip the buffer then. */
+	if (RDsM_AttachVolume(handle, candidates[i].key.volNo) < eNOERROR) continue;
+
+	e = bfm_lock(handle, (TrainID *)&candidates[i].key, type);
+	if (e < eNOERROR) break;
+
+	if (EQUALKEY(&anEntry->key, &candidates[i].key) &&
+	    anEntry->dirtyFlag && !anEntry->invalidFlag) {
+
+	    if (anEntry->fixed == 0) {
+		e = bfm_flushBuffer(handle, anEntry, type);
+
+		/* The page will have no update logged before the next log record. */
+		if (e >= eNOERROR) e = LOG_GetNextLogRecordLsn(handle, &anEntry->recLsn);
+
+		if (e >= eNOERROR) BI_NCLEANERWRITES(type)++;
+	    }
+	    else if (LSN_CMP_LT(anEntry->recLsn, *minRecLsn))
+		*minRecLsn = anEntry->recLsn;
+	}
+
+	if (e < eNOERROR) {
+	    (void) bfm_unlock(handle, (TrainID *)&candidates[i].key, type);
+	    break;
+	}
+
+	e = bfm_unlock(handle, (TrainID *)&candidates[i].key, type);
+	if (e < eNOERROR) break;
+    }
+
+    /* the buffers not visited are still dirty */
+    for ( ; i < nCandidates; i++)
+	if (LSN_CMP_LT(candidates[i].recLsn, *minRecLsn)) *minRecLsn = candidates[i].recLsn;
+
+    free(candidates);
+
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_writeOldBuffers() */
+
+
+
+/*
+ * Function: int bfm_compareCleanCandidates(const void*, const void*)
+ *
+ * Description :
+ *  Compare two dirty buffers by their page ids; used by qsort().
+ */
+static int bfm_compareCleanCandidates(
+    const void *c1,		/* IN first buffer */
+    const void *c2)		/* IN second buffer */
+{
+    const BfMHashKey *k1 = &((const bfm_CleanCandidate *)c1)->key;
+    const BfMHashKey *k2 = &((const bfm_CleanCandidate *)c2)->key;
+
+
+    if (k1->volNo != k2->volNo) return((k1->volNo < k2->volNo) ? -1 : 1);
+    if (k1->pageNo != k2->pageNo) return((k1->pageNo < k2->pageNo) ? -1 : 1);
+
+    return(0);
+
+} /* bfm_compareCleanCandidates() */
+
+
+
+/*
+ * Function: int bfm_compareRecLsns(const void*, const void*)
+ *
+ * Description :
+ *  Compare two dirty buffers by their recLsns; used by qsort().
+ */
+static int bfm_compareRecLsns(
+    const void *c1,		/* IN first buffer */
+    const void *c2)		/* IN second buffer */
+{
+    const Lsn_T *l1 = &((const bfm_CleanCandidate *)c1)->recLsn;
+    const Lsn_T *l2 = &((const bfm_CleanCandidate *)c2)->recLsn;
+
+
+    if (LSN_CMP_LT(*l1, *l2)) return(-1);
+    if (LSN_CMP_GT(*l1, *l2)) return(1);
+
+    return(0);
+
+} /* bfm_compareRecLsns() */
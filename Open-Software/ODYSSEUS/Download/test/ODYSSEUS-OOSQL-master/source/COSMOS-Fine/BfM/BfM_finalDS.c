@@ -208,9 +208,10 @@ Four bfm_finalBufferInfo(
     /* free all the allocated memory */
 
     ERROR_PASS(handle, SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFTABLE(type)), procIndex));
-    ERROR_PASS(handle, SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFFERPOOL(type)), procIndex));
+    /* the buffers are released with the buffer pool segment by SHM_endProcess() */
     ERROR_PASS(handle, SHM_free(handle, (char *)PHYSICAL_PTR(BI_HASHTABLE(type)), procIndex));
     ERROR_PASS(handle, SHM_free(handle, (char *)PHYSICAL_PTR(BI_LOCKHASHTABLE(type)), procIndex));
+    ERROR_PASS(handle, bfm_finalPartitions(handle, type));
 
     return(eNOERROR);
 
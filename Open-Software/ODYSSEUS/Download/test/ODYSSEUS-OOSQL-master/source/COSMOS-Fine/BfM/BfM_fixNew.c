@@ -78,6 +78,7 @@
  *
  * Exports:
  *  Four BfM_fixNewBuffer(Four, TrainID *, Four, Buffer_ACC_CB *, Four)
+ *  Four BfM_fixNewBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB *, Four, Four)
  */
 
 
@@ -99,6 +100,31 @@
  * Function: Four BfM_fixNewBuffer(Four, TrainID *, Four, Buffer_ACC_CB *, Four)
  *
  * Description :
+ *  Same as BfM_fixNewBufferWithHint() with BFM_HINT_NORMAL.
+ *
+ * Returns :
+ *  error code
+ */
+Four BfM_fixNewBuffer(
+    Four handle,
+    TrainID *trainId,		/* IN train to be used */
+    Four mode,			/* IN M_FREE, M_SHARED or M_EXCLUSIVE */
+    Buffer_ACC_CB **acc_cb,	/* OUT pointer to the access control block */
+    Four    type )		/* IN buffer type */
+{
+    return(BfM_fixNewBufferWithHint(handle, trainId, mode, acc_cb, type, BFM_HINT_NORMAL));
+
+}  /* BfM_fixNewBuffer */
+
+
+
+/*@================================
+ * BfM_fixNewBufferWithHint()
+ *================================*/
+/*
+ * Function: Four BfM_fixNewBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB *, Four, Four)
+ *
+ * Description :
  *  Return a buffer which has the disk content indicated by `trainId'.
  *  Before the allocation of a buffer, look up the train in the buffer
  *  pool using hashing mechanism.   If the train already  exist in the pool
@@ -106,6 +132,8 @@
  *  buffer table entry.   Otherwise, i.e. the train does not exist  in the
  *  pool,  allocate a buffer (a buffer selected as victim may be forced out
  *  by the buffer replacement algorithm) and return it.
+ *  With BFM_HINT_SEQUENTIAL, the buffer is allocated from the ring of
+ *  the calling thread and the access does not promote the buffer.
  *
  * Returns :
  *  error code
@@ -117,12 +145,13 @@
  *  1) parameter acc_cb
  *     pointer to buffer access control block holding the disk train indicated by `trainId'
  */
-Four BfM_fixNewBuffer(
+Four BfM_fixNewBufferWithHint(
     Four handle,
     TrainID *trainId,		/* IN train to be used */
     Four mode,			/* IN M_FREE, M_SHARED or M_EXCLUSIVE */
     Buffer_ACC_CB **acc_cb,	/* OUT pointer to the access control block */
-    Four    type )		/* IN buffer type */
+    Four    type,		/* IN buffer type */
+    Four    hint )		/* IN access hint */
 {
     BufTBLEntry *anEntry;	/* a buffer Table Entry */
     Four status;		/* for returned message */
@@ -136,7 +165,7 @@ Four BfM_fixNewBuffer(
     COMMON_PerThreadDS_T *common_perThreadDSptr = COMMON_PER_THREAD_DS_PTR(handle);
 
 
-    TR_PRINT(handle, TR_BFM, TR1,("BfM_fixNewBuffer(trainId=%P, acc_cb=%P, mode+%ld type=%ld)", trainId, acc_cb, mode, type));
+    TR_PRINT(handle, TR_BFM, TR1,("BfM_fixNewBufferWithHint(trainId=%P, acc_cb=%P, mode+%ld type=%ld hint=%ld)", trainId, acc_cb, mode, type, hint));
 
 
     /*@ Check the validity of given parameters */
@@ -149,6 +178,10 @@ Four BfM_fixNewBuffer(
     if (IS_BAD_BUFFERTYPE(type))
 	ERR(handle, eBADBUFFERTYPE_BFM);
 
+    /* Is the access hint valid? */
+    if (IS_BAD_ACCESSHINT(hint))
+	ERR(handle, eBADPARAMETER);
+
 
     /*@ get latch */
     /* Mutex Begin : mutual exclusively fix the trainID page */
@@ -162,7 +195,10 @@ Four BfM_fixNewBuffer(
 
 	/*@ allocate a buffer */
         /* Allocate a buffer from the buffer pool of type 'type' */
-        e = bfm_allocBuffer(handle, type, &anEntry);
+        if (hint == BFM_HINT_SEQUENTIAL)
+            e = bfm_allocRingBuffer(handle, trainId, type, &anEntry);
+        else
+            e = bfm_allocBuffer(handle, type, &anEntry);
 
         if( e < 0 ) {  /* Buffer Allocation Error */
 	    ERROR_PASS(handle, bfm_unlock(handle, trainId, type));
@@ -172,6 +208,9 @@ Four BfM_fixNewBuffer(
 	/* initialize before next use */
 	anEntry->dirtyFlag = FALSE;
 	anEntry->invalidFlag = FALSE;
+	anEntry->referFlag = FALSE;
+	anEntry->probationFlag = (CFG_BFMREPLACEMENTPOLICY == BFM_POLICY_2Q);
+	anEntry->prefetchFlag = FALSE;
 
         /* fill the buffer table using the given parameters */
  	anEntry->key = *((BfMHashKey *)trainId);
@@ -199,9 +238,15 @@ Four BfM_fixNewBuffer(
 	ERROR_PASS(handle, bfm_unlock(handle, trainId, type));
 	ERR(handle, status);
     }
-    else
+    else {
         anEntry->fixed++;       /* increase counter */
 
+	/* the second reference promotes the buffer (BFM_POLICY_2Q) */
+	if (hint == BFM_HINT_NORMAL) anEntry->probationFlag = FALSE;
+
+	anEntry->prefetchFlag = FALSE;
+    }
+
 
     /* Now, buffer page fixed in the pool */
     /* Mutex End : mutual exclusively fix the trainID page */
@@ -233,6 +278,7 @@ Four BfM_fixNewBuffer(
     (*acc_cb)->dirtyFlag = FALSE;
     (*acc_cb)->invalidFlag = FALSE;
     (*acc_cb)->type = type;
+    (*acc_cb)->accessHint = hint;
 
     ADD_BACB_INTO_MYFIXEDBACB(handle, (*acc_cb));
 
@@ -249,5 +295,5 @@ Four BfM_fixNewBuffer(
 
     return( eNOERROR );   /* No error */
 
-}  /* BfM_fixNewBuffer */
+}  /* BfM_fixNewBufferWithHint */
 
@@ -78,6 +78,7 @@
  *
  * Exports:
  *  Four BfM_getAndFixBuffer(Four, TrainID *, Four, Buffer_ACC_CB *, Four)
+ *  Four BfM_getAndFixBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB *, Four, Four)
  */
 
 
@@ -99,6 +100,31 @@
  * Function: Four BfM_getAndFixBuffer(Four, TrainID *, Four, Buffer_ACC_CB *, Four)
  *
  * Description :
+ *  Same as BfM_getAndFixBufferWithHint() with BFM_HINT_NORMAL.
+ *
+ * Returns :
+ *  error code
+ */
+Four BfM_getAndFixBuffer(
+    Four handle,
+    TrainID *trainId,		/* IN train to be used */
+    Four mode,			/* IN M_FREE, M_SHARED or M_EXCLUSIVE */
+    Buffer_ACC_CB **acc_cb,	/* OUT pointer to the access control block */
+    Four    type )		/* IN buffer type */
+{
+    return(BfM_getAndFixBufferWithHint(handle, trainId, mode, acc_cb, type, BFM_HINT_NORMAL));
+
+}  /* BfM_getAndFixBuffer */
+
+
+
+/*@================================
+ * BfM_getAndFixBufferWithHint( )
+ *================================*/
+/*
+ * Function: Four BfM_getAndFixBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB *, Four, Four)
+ *
+ * Description :
  *  Return a buffer which has the disk content indicated by `trainId'.
  *  Before the allocation of a buffer, look up the train in the buffer
  *  pool using hashing mechanism.   If the train already  exist in the pool
@@ -107,6 +133,8 @@
  *  pool,  allocate a buffer (a buffer selected as victim may be forced out
  *  by the buffer replacement algorithm), read a disk train into the
  *  selected buffer train, and return it.
+ *  With BFM_HINT_SEQUENTIAL, the buffer is allocated from the ring of
+ *  the calling thread and the access does not promote the buffer.
  *
  * Returns :
  *  error code
@@ -118,12 +146,13 @@
  *  1) parameter acc_cb
  *     pointer to buffer access control block holding the disk train indicated by `trainId'
  */
-Four BfM_getAndFixBuffer(
+Four BfM_getAndFixBufferWithHint(
     Four handle,
     TrainID *trainId,		/* IN train to be used */
     Four mode,			/* IN M_FREE, M_SHARED or M_EXCLUSIVE */
     Buffer_ACC_CB **acc_cb,	/* OUT pointer to the access control block */
-    Four    type )		/* IN buffer type */
+    Four    type,		/* IN buffer type */
+    Four    hint )		/* IN access hint */
 {
     BufTBLEntry *anEntry;	/* a buffer Table Entry */
     Four status;		/* for returned message */
@@ -133,7 +162,7 @@ Four BfM_getAndFixBuffer(
     /* pointer for BfM Data Structure of perThreadTable */
     BfM_PerThreadDS_T *bfm_perThreadDSptr = BfM_PER_THREAD_DS_PTR(handle);
 
-    TR_PRINT(handle, TR_BFM, TR1,("BfM_getAndFixBuffer(trainId=%P, acc_cb=%P, mode+%ld type=%ld)", trainId, acc_cb, mode, type));
+    TR_PRINT(handle, TR_BFM, TR1,("BfM_getAndFixBufferWithHint(trainId=%P, acc_cb=%P, mode+%ld type=%ld hint=%ld)", trainId, acc_cb, mode, type, hint));
 
 
     /*@ Check the validity of given parameters */
@@ -146,6 +175,15 @@ Four BfM_getAndFixBuffer(
     if (IS_BAD_BUFFERTYPE(type))
 	ERR(handle, eBADBUFFERTYPE_BFM);
 
+    /* Is the access hint valid? */
+    if (IS_BAD_ACCESSHINT(hint))
+	ERR(handle, eBADPARAMETER);
+
+
+    /* read ahead the trains which a sequential access will need next */
+    if (hint == BFM_HINT_SEQUENTIAL)
+	ERROR_PASS(handle, bfm_readAhead(handle, trainId, type));
+
 
     /*@ get latch */
     /* Mutex Begin : mutual exclusively fix the trainID page */
@@ -160,7 +198,10 @@ Four BfM_getAndFixBuffer(
 	/*@ allocate a buffer */
         /* Allocate a buffer from the buffer pool of type 'type' */
         /* bfm_allocBuffer set the anEntry->fixed to 1 */
-        e = bfm_allocBuffer(handle, type, &anEntry);
+        if (hint == BFM_HINT_SEQUENTIAL)
+            e = bfm_allocRingBuffer(handle, trainId, type, &anEntry);
+        else
+            e = bfm_allocBuffer(handle, type, &anEntry);
 
         if( e < 0 ) {  /* Buffer Allocation Error */
 	    ERROR_PASS(handle, bfm_unlock(handle, trainId, type));
@@ -179,6 +220,9 @@ Four BfM_getAndFixBuffer(
 	/* initialize before next use */
 	anEntry->dirtyFlag = FALSE;
 	anEntry->invalidFlag = FALSE;
+	anEntry->referFlag = FALSE;
+	anEntry->probationFlag = (CFG_BFMREPLACEMENTPOLICY == BFM_POLICY_2Q);
+	anEntry->prefetchFlag = FALSE;
 
         /* Initialize the recovery LSN of the new buffer. */
         e = LOG_GetNextLogRecordLsn(handle, &anEntry->recLsn);
@@ -203,10 +247,21 @@ Four BfM_getAndFixBuffer(
 	ERROR_PASS(handle, bfm_unlock(handle, trainId, type));
 	ERR(handle, status);
     }
-    else
-    /*@ increase the counter */
-    /* increase fix counter */
-    anEntry->fixed++;
+    else {
+	/*@ increase the counter */
+	/* increase fix counter */
+	anEntry->fixed++;
+
+	/* the second reference promotes the buffer (BFM_POLICY_2Q) */
+	if (hint == BFM_HINT_NORMAL) anEntry->probationFlag = FALSE;
+
+	/* the train was read ahead in time */
+	if (anEntry->prefetchFlag) {
+	    anEntry->prefetchFlag = FALSE;
+	    BI_NPREFETCHHITS(type)++;
+	    bfm_perThreadDSptr->readAhead[type].nHits++;
+	}
+    }
 
     /*@ release latch */
     /* Mutex End : mutual exclusively fix the trainID page */
@@ -245,10 +300,11 @@ Four BfM_getAndFixBuffer(
     (*acc_cb)->dirtyFlag = FALSE;
     (*acc_cb)->invalidFlag = FALSE;
     (*acc_cb)->type = type;
+    (*acc_cb)->accessHint = hint;
     /* (*acc_cb)->latchFlag = latchFlag; */
 
     ADD_BACB_INTO_MYFIXEDBACB(handle, (*acc_cb));
 
     return( eNOERROR );   /* No error */
 
-}  /* BfM_getAndFixBuffer */
+}  /* BfM_getAndFixBufferWithHint */
@@ -143,6 +143,7 @@ Four BfM_initLocalDS(
 )
 {
     Four e;			/* error number */
+    Four type;			/* buffer type */
     Lock_ctrlBlock *lock_cb1, *lock_cb2;
 
     /* pointer for BfM Data Structure of perThreadTable */
@@ -158,6 +159,18 @@ Four BfM_initLocalDS(
     bfm_perThreadDSptr->MyFixed_BACB.prev = &(bfm_perThreadDSptr->MyFixed_BACB);
     bfm_perThreadDSptr->MyFixed_BACB.next = &(bfm_perThreadDSptr->MyFixed_BACB);
 
+    /* the rings for the sequential accesses are empty */
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+	bfm_perThreadDSptr->ring[type].nEntries = 0;
+	bfm_perThreadDSptr->ring[type].next = 0;
+    }
+
+    /* no sequential access has been detected yet */
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+	bfm_perThreadDSptr->readAhead[type].volNo = NIL;
+	bfm_perThreadDSptr->readAhead[type].nSequential = 0;
+    }
+
     e = Util_getElementFromPool(handle, &BI_LOCK_CB_POOL(PAGE_BUF), &lock_cb1);
     if (e < eNOERROR) ERR(handle, e);
 
@@ -184,7 +197,7 @@ Four BfM_initLocalDS(
  * bfm_initBufferInfo( )
  *================================*/
 /*
- * Function: Four bfm_initBufferInfo(Four, Four, Four, Four)
+ * Function: Four bfm_initBufferInfo(Four, Four, Four, Eight)
  *
  * Description:
  *  Initialize the BufferInfo data structure.
@@ -197,7 +210,7 @@ Four bfm_initBufferInfo(
     Four handle,
     Four type,			/* IN buffer type */
     Four bufSize,		/* IN buffer size */
-    Four nBufs)			/* IN number of buffers */
+    Eight nBufs)		/* IN number of buffers */
 {
     Four e;			/* error code */
     Four i;			/* loop index */
@@ -221,10 +234,12 @@ Four bfm_initBufferInfo(
     BI_BUFTABLE(type) = LOGICAL_PTR(physical_ptr);
     if ( e < eNOERROR )	ERR(handle, e);
 
-    /* allocate memory for buffer pool */
-    e = SHM_alloc(handle, nBufs*bufSize*PAGESIZE, -1, (char **)&physical_ptr);
-    BI_BUFFERPOOL(type) = LOGICAL_PTR(physical_ptr);
-    if ( e < eNOERROR )	ERR(handle, e);
+    /* allocate memory for buffer pool from the buffer pool segment */
+    e = SHM_allocBufferPool(handle, nBufs*bufSize*PAGESIZE, &BI_BUFFERPOOLOFFSET(type));
+    if ( e < eNOERROR ) {
+	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFTABLE(type)), -1);
+	ERR(handle, e);
+    }
 
     /*@
      * initialize the allocated memory
@@ -235,6 +250,7 @@ Four bfm_initBufferInfo(
 	/* reset dirty/invalid Flag */
 	anEntry->dirtyFlag = FALSE;
 	anEntry->invalidFlag = TRUE;
+	anEntry->prefetchFlag = FALSE;
 
 	/* fixed counter is reset to 0. */
 	anEntry->fixed = 0;
@@ -247,14 +263,28 @@ Four bfm_initBufferInfo(
 	if (e < eNOERROR) ERR(handle, e);
     }
 
-    /* initialize pointer of next victim */
-    BI_NEXTVICTIM(type) = 0;
+    /* divide the buffer pool into partitions; the clock hands are initialized here */
+    e = bfm_initPartitions(handle, type, CFG_BFMNUMPARTITIONS);
+    if (e < eNOERROR) {
+	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFTABLE(type)), -1);
+	ERR(handle, e);
+    }
+
+    /* initialize the page cleaner latch and the statistics */
+    e = SHM_initLatch(handle, &BI_CLEANERLATCH(type));
+    if (e < eNOERROR) ERR(handle, e);
+
+    BI_NVICTIMS(type) = 0;
+    BI_NDIRTYVICTIMS(type) = 0;
+    BI_NCLEANERWRITES(type) = 0;
+    BI_NPREFETCHED(type) = 0;
+    BI_NPREFETCHHITS(type) = 0;
 
     /* Initialize the hash table */
     e = bfm_initBufferHashTable(handle, type);
     if (e < eNOERROR) {
+	SHM_free(handle, (char *)PHYSICAL_PTR(BI_PARTITIONS(type)), -1);
 	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFTABLE(type)), -1);
-	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFFERPOOL(type)), -1);
 	ERR(handle, e);
     }
 
@@ -262,8 +292,8 @@ Four bfm_initBufferInfo(
     e = bfm_initLockHashTable(handle, type);
     if (e < eNOERROR) {
 	SHM_free(handle, (char *)PHYSICAL_PTR(BI_HASHTABLE(type)), -1);
+	SHM_free(handle, (char *)PHYSICAL_PTR(BI_PARTITIONS(type)), -1);
 	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFTABLE(type)), -1);
-	SHM_free(handle, (char *)PHYSICAL_PTR(BI_BUFFERPOOL(type)), -1);
 	ERR(handle, e);
     }
 
@@ -0,0 +1,705 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: BfM_prefetch.c
+ *
+ * Description :
+ *  Sequential readahead of the buffer manager.
+ *  The sequential accesses of a thread (BFM_HINT_SEQUENTIAL) are detected by
+ *  bfm_readAhead(), which reads ahead the next trains of the access with one
+ *  multi-train read and loads them into the buffer pool. The trains are read
+ *  by the prefetcher threads of the process if CFG_BFMNUMPREFETCHERS > 0,
+ *  otherwise by the accessing thread itself.
+ *  The readahead window grows while the trains read ahead are accessed and
+ *  shrinks when they are replaced before the access.
+ *  BfM_PrefetchTrains() loads a known set of trains, e.g. the dirty pages
+ *  of the restart recovery, in the same way.
+ *
+ * Exports:
+ *  Four BfM_StartPrefetchers(Four)
+ *  Four BfM_StopPrefetchers(Four)
+ *  Four BfM_NumPrefetchers(void)
+ *  Four BfM_PrefetchTrains(Four, PageID*, Four, Four)
+ *  Four bfm_readAhead(Four, TrainID*, Four)
+ *  Four bfm_prefetchTrains(Four, PageID*, Four, Four)
+ */
+
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memcpy */
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "SHM.h"
+#include "RDsM.h"
+#include "BfM.h"
+#include "LOG.h"
+#include "THM_cosmosThread.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/* a readahead request waiting for a prefetcher */
+typedef struct {
+    PageID      trainId;	/* first train to be read */
+    Four        nTrains;	/* # of trains to be read */
+    Four        type;		/* buffer type */
+} bfm_PrefetchRequest;
+
+
+/*
+ * Per-process data structures of the prefetchers
+ */
+static cosmos_thread_t  bfm_prefetcherTids[BFM_MAX_PREFETCHERS];    /* thread ids of the prefetchers */
+static Four             bfm_prefetcherHandles[BFM_MAX_PREFETCHERS]; /* handles of the prefetchers */
+static Four             bfm_nPrefetchers = 0;                       /* # of running prefetchers */
+static Boolean          bfm_stopPrefetchersFlag = FALSE;            /* TRUE if the prefetchers should exit */
+
+/* queue of the readahead requests; protected by bfm_prefetchQueueMutex */
+static bfm_PrefetchRequest   bfm_prefetchQueue[BFM_PREFETCH_QUEUE_SIZE];
+static Four                  bfm_prefetchQueueHead = 0;   /* index of the oldest request */
+static Four                  bfm_prefetchQueueCount = 0;  /* # of requests in the queue */
+static cosmos_thread_mutex_t bfm_prefetchQueueMutex;
+static cosmos_thread_cond_t  bfm_prefetchQueueCond;      /* signaled when a request is queued */
+
+
+/*
+ * Internal Function Prototypes
+ */
+static void *bfm_prefetcherMain(void *);
+static Four bfm_queuePrefetchRequest(Four, PageID *, Four, Four);
+
+
+
+/*@================================
+ * BfM_StartPrefetchers( )
+ *================================*/
+/*
+ * Function: Four BfM_StartPrefetchers(Four)
+ *
+ * Description :
+ *  Start CFG_BFMNUMPREFETCHERS prefetchers in this process.
+ *  Each prefetcher runs on its own handle which is allocated here.
+ *
+ * CAUTION :: This function is called in the critical section for the
+ *            shared memory access.
+ *
+ * Returns :
+ *  error codes
+ */
+Four BfM_StartPrefetchers(
+    Four handle)		/* IN handle of the calling thread */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four prefetcherHandle;	/* handle of a new prefetcher */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_StartPrefetchers(handle=%ld)", handle));
+
+
+    if (bfm_nPrefetchers > 0) return(eNOERROR);
+
+    e = cosmos_thread_mutex_create(&bfm_prefetchQueueMutex, 0);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = cosmos_thread_cond_create(&bfm_prefetchQueueCond, 0);
+    if (e < eNOERROR) ERR(handle, e);
+
+    bfm_stopPrefetchersFlag = FALSE;
+    bfm_prefetchQueueHead = 0;
+    bfm_prefetchQueueCount = 0;
+
+    for (i = 0; i < CFG_BFMNUMPREFETCHERS && i < BFM_MAX_PREFETCHERS; i++) {
+
+	e = THM_AllocHandle(&prefetcherHandle);
+	if (e < eNOERROR) ERR(handle, e);
+
+	bfm_prefetcherHandles[i] = prefetcherHandle;
+
+	e = cosmos_thread_create(&bfm_prefetcherTids[i], bfm_prefetcherMain, (void *)&bfm_prefetcherHandles[i], 0);
+	if (e < eNOERROR) {
+	    (void) THM_FreeHandle(prefetcherHandle);
+	    ERR(handle, e);
+	}
+
+	bfm_nPrefetchers++;
+    }
+
+    return(eNOERROR);
+
+} /* BfM_StartPrefetchers() */
+
+
+
+/*@================================
+ * BfM_StopPrefetchers( )
+ *================================*/
+/*
+ * Function: Four BfM_StopPrefetchers(Four)
+ *
+ * Description :
+ *  Stop all the prefetchers of this process and free their handles.
+ *  The requests still in the queue are discarded.
+ *
+ * CAUTION :: This function is called in the critical section for the
+ *            shared memory access. The prefetchers never enter the critical
+ *            section, so they can be waited for here.
+ *
+ * Returns :
+ *  error codes
+ */
+Four BfM_StopPrefetchers(
+    Four handle)		/* IN handle of the calling thread */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_StopPrefetchers(handle=%ld)", handle));
+
+
+    if (bfm_nPrefetchers == 0) return(eNOERROR);
+
+    e = cosmos_thread_mutex_lock(&bfm_prefetchQueueMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    bfm_stopPrefetchersFlag = TRUE;
+
+    /* wake up every prefetcher waiting for a request */
+    for (i = 0; i < bfm_nPrefetchers; i++)
+	(void) cosmos_thread_cond_signal(&bfm_prefetchQueueCond);
+
+    e = cosmos_thread_mutex_unlock(&bfm_prefetchQueueMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    for (i = 0; i < bfm_nPrefetchers; i++) {
+	e = cosmos_thread_wait(bfm_prefetcherTids[i]);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    for (i = 0; i < bfm_nPrefetchers; i++) {
+	e = RDsM_DetachVolumes(bfm_prefetcherHandles[i]);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = THM_FreeHandle(bfm_prefetcherHandles[i]);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    bfm_nPrefetchers = 0;
+
+    e = cosmos_thread_cond_destroy(&bfm_prefetchQueueCond);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = cosmos_thread_mutex_destroy(&bfm_prefetchQueueMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* BfM_StopPrefetchers() */
+
+
+
+/*@================================
+ * BfM_NumPrefetchers( )
+ *================================*/
+/*
+ * Function: Four BfM_NumPrefetchers(void)
+ *
+ * Description :
+ *  Return the number of prefetchers running in this process.
+ *
+ * Returns :
+ *  # of prefetchers
+ */
+Four BfM_NumPrefetchers(void)
+{
+    return(bfm_nPrefetchers);
+
+} /* BfM_NumPrefetchers() */
+
+
+
+/*@================================
+ * BfM_PrefetchTrains( )
+ *================================*/
+/*
+ * Function: Four BfM_PrefetchTrains(Four, PageID*, Four, Four)
+ *
+ * Description :
+ *  Load the trains 'trainIds' into the buffer pool without fixing them.
+ *  'trainIds' should be sorted by the volume and page numbers; the trains
+ *  consecutive in an extent are read with one bfm_prefetchTrains().
+ *  At most a half of the buffer pool is loaded, so that the trains loaded
+ *  first are not replaced by the later ones before they are accessed.
+ *
+ * Returns :
+ *  error codes
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ */
+Four BfM_PrefetchTrains(
+    Four handle,
+    PageID *trainIds,		/* IN trains to be loaded */
+    Four nTrains,		/* IN # of trains */
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error returned */
+    Four i, j;			/* loop indexes */
+    Four bufSize;		/* size of a train in pages */
+    Four extSize;		/* extent size of the current volume */
+    VolNo volNo;		/* the current volume */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("BfM_PrefetchTrains(trainIds=%P, nTrains=%ld, type=%ld)",
+				   trainIds, nTrains, type));
+
+
+    if (IS_BAD_BUFFERTYPE(type)) ERR(handle, eBADBUFFERTYPE_BFM);
+
+    bufSize = BI_BUFSIZE(type);
+    nTrains = MIN(nTrains, BI_NBUFS(type) / 2);
+
+    volNo = NIL;
+    extSize = 1;
+    for (i = 0; i < nTrains; i = j) {
+
+	if (trainIds[i].volNo != volNo) {
+	    e = RDsM_GetSizeOfExt(handle, trainIds[i].volNo, &extSize);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    volNo = trainIds[i].volNo;
+	}
+
+	/*@ find the trains consecutive in the extent of the i-th train */
+	for (j = i + 1; j < nTrains; j++)
+	    if (trainIds[j].volNo != volNo ||
+		trainIds[j].pageNo != trainIds[j-1].pageNo + bufSize ||
+		trainIds[j].pageNo / extSize != trainIds[i].pageNo / extSize) break;
+
+	e = bfm_prefetchTrains(handle, &trainIds[i], j - i, type);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* BfM_PrefetchTrains() */
+
+
+
+/*@================================
+ * bfm_readAhead( )
+ *================================*/
+/*
+ * Function: Four bfm_readAhead(Four, TrainID*, Four)
+ *
+ * Description :
+ *  Called before the train 'trainId' is accessed sequentially.
+ *  The repeated accesses to the same train are counted once.
+ *  After BFM_READAHEAD_TRIGGER consecutive trains are accessed in order,
+ *  read ahead the next window of trains when a half of the trains read
+ *  ahead before have been accessed. The window does not go beyond the
+ *  extent of 'trainId', because the next extent of the same file is not
+ *  known to the buffer manager.
+ *  The window is doubled if at least 3/4 of the trains read ahead and passed
+ *  by the access have been hit, and halved if less than a half of them.
+ *
+ * Returns :
+ *  error codes
+ */
+Four bfm_readAhead(
+    Four handle,
+    TrainID *trainId,		/* IN train to be accessed */
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four bufSize;		/* size of a train in pages */
+    Four nAhead;		/* # of trains read ahead and not yet passed by */
+    Four nPassed;		/* # of trains read ahead and passed by */
+    PageNo start;		/* first train of the new window */
+    PageNo extEnd;		/* first page after the extent of 'trainId' */
+    Four nTrains;		/* # of trains in the new window */
+    Four first;			/* first train of the window not in the buffer pool */
+    Four last;			/* last train of the window not in the buffer pool */
+    Four nMissing;		/* # of trains of the window not in the buffer pool */
+    PageID aTrainId;		/* a train of the window */
+    BufTBLEntry *anEntry;	/* buffer table entry */
+    BfM_PerThreadDS_T *bfm_perThreadDSptr = BfM_PER_THREAD_DS_PTR(handle);
+    bfm_ReadAhead *ra = &bfm_perThreadDSptr->readAhead[type];
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_readAhead(trainId=%P, type=%ld)", trainId, type));
+
+
+    if (CFG_BFMMAXREADAHEAD <= 0) return(eNOERROR);
+
+    bufSize = BI_BUFSIZE(type);
+
+    /* the train accessed last is accessed again (e.g. for its next object) */
+    if (trainId->volNo == ra->volNo && trainId->pageNo == ra->lastPageNo) return(eNOERROR);
+
+    /*@ detect the sequential access */
+    if (trainId->volNo == ra->volNo && trainId->pageNo == ra->lastPageNo + bufSize) {
+	ra->nSequential++;
+    } else {
+	if (trainId->volNo != ra->volNo) {
+	    e = RDsM_GetSizeOfExt(handle, trainId->volNo, &ra->extSize);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    ra->volNo = trainId->volNo;
+	}
+
+	/* a new sequential access may begin here */
+	ra->nSequential = 0;
+	ra->window = MIN(BFM_MIN_READAHEAD, CFG_BFMMAXREADAHEAD);
+	ra->end = trainId->pageNo + bufSize;
+	ra->nIssued = 0;
+	ra->nHits = 0;
+    }
+    ra->lastPageNo = trainId->pageNo;
+
+    if (ra->nSequential < BFM_READAHEAD_TRIGGER) return(eNOERROR);
+
+    nAhead = MAX(0, (ra->end - trainId->pageNo) / bufSize - 1);
+    if (nAhead > ra->window / 2) return(eNOERROR);
+
+    /*@ adjust the window by the hit rate */
+    nPassed = ra->nIssued - MIN(ra->nIssued, nAhead);
+    if (nPassed > 0) {
+	if (ra->nHits * 2 < nPassed)
+	    ra->window = MAX(MIN(BFM_MIN_READAHEAD, CFG_BFMMAXREADAHEAD), ra->window / 2);
+	else if (ra->nHits * 4 >= nPassed * 3)
+	    ra->window = MIN(CFG_BFMMAXREADAHEAD, ra->window * 2);
+
+	ra->nIssued -= nPassed;
+	ra->nHits = 0;
+    }
+
+    /*@ determine the new window */
+    start = MAX(ra->end, trainId->pageNo + bufSize);
+    extEnd = (trainId->pageNo / ra->extSize + 1) * ra->extSize;
+    nTrains = MIN(ra->window, (extEnd - start) / bufSize);
+    if (nTrains <= 0) return(eNOERROR);
+
+    ra->end = start + nTrains * bufSize;
+
+    /*
+     * Skip the trains already in the buffer pool.
+     * They are looked up without bfm_lock(), so the result is only a hint;
+     * bfm_prefetchTrains() looks them up again.
+     */
+    first = last = NIL;
+    nMissing = 0;
+    for (i = 0; i < nTrains; i++) {
+	MAKE_PAGEID(aTrainId, trainId->volNo, start + i * bufSize);
+
+	e = bfm_lookUp(handle, (BfMHashKey *)&aTrainId, type, &anEntry);
+	if (e == NOTFOUND_IN_HTABLE) {
+	    if (first == NIL) first = i;
+	    last = i;
+	    nMissing++;
+	}
+	else if (e < eNOERROR) ERR(handle, e);
+    }
+
+    if (nMissing == 0) return(eNOERROR);
+
+    ra->nIssued += nMissing;
+
+    /*@ read ahead the trains */
+    MAKE_PAGEID(aTrainId, trainId->volNo, start + first * bufSize);
+
+    if (bfm_nPrefetchers > 0)
+	e = bfm_queuePrefetchRequest(handle, &aTrainId, last - first + 1, type);
+    else
+	e = bfm_prefetchTrains(handle, &aTrainId, last - first + 1, type);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_readAhead() */
+
+
+
+/*@================================
+ * bfm_prefetchTrains( )
+ *================================*/
+/*
+ * Function: Four bfm_prefetchTrains(Four, PageID*, Four, Four)
+ *
+ * Description :
+ *  Read 'nTrains' consecutive trains beginning with 'firstTrainId' with
+ *  one RDsM_ReadTrains() and load the trains not in the buffer pool into
+ *  the buffer pool. The loaded buffers are not fixed.
+ *  The trains are read without bfm_lock(), so a train written after its
+ *  write sequence number was remembered is discarded; the buffer pool may
+ *  have a newer image of it which has been written and replaced meanwhile.
+ *
+ * Returns :
+ *  error codes
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eMEMORYALLOCERR - memory allocation error
+ */
+Four bfm_prefetchTrains(
+    Four handle,
+    PageID *firstTrainId,	/* IN first train to be read */
+    Four nTrains,		/* IN # of trains to be read */
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error returned */
+    Four i;			/* loop index */
+    Four bufSize;		/* size of a train in pages */
+    PageID trainId;		/* a train being loaded */
+    UFour *writeSeqs;		/* write sequence numbers before the read */
+    char *trains;		/* trains read */
+    BufTBLEntry *anEntry;	/* buffer table entry */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_prefetchTrains(firstTrainId=%P, nTrains=%ld, type=%ld)",
+				   firstTrainId, nTrains, type));
+
+
+    if (IS_BAD_BUFFERTYPE(type)) ERR(handle, eBADBUFFERTYPE_BFM);
+
+    if (nTrains <= 0) return(eNOERROR);
+
+    bufSize = BI_BUFSIZE(type);
+
+    writeSeqs = (UFour *)malloc(sizeof(UFour) * nTrains);
+    if (writeSeqs == NULL) ERR(handle, eMEMORYALLOCERR);
+
+    trains = (char *)malloc(nTrains * bufSize * PAGESIZE);
+    if (trains == NULL) {
+	free(writeSeqs);
+	ERR(handle, eMEMORYALLOCERR);
+    }
+
+    /*@ read the trains */
+    for (i = 0; i < nTrains; i++)
+	writeSeqs[i] = RDSM_WRITESEQ(firstTrainId->volNo, firstTrainId->pageNo + i * bufSize);
+
+    e = RDsM_ReadTrains(handle, firstTrainId, trains, nTrains, bufSize);
+    if (e < eNOERROR) {
+	free(writeSeqs);
+	free(trains);
+	ERR(handle, e);
+    }
+
+    /*@ load the trains into the buffer pool */
+    for (i = 0; i < nTrains; i++) {
+	MAKE_PAGEID(trainId, firstTrainId->volNo, firstTrainId->pageNo + i * bufSize);
+
+	e = bfm_lock(handle, &trainId, type);
+	if (e < eNOERROR) break;
+
+	e = bfm_lookUp(handle, (BfMHashKey *)&trainId, type, &anEntry);
+	if (e == NOTFOUND_IN_HTABLE) {
+
+	    e = eNOERROR;
+	    if (writeSeqs[i] == RDSM_WRITESEQ(trainId.volNo, trainId.pageNo)) {
+
+		/* bfm_allocBuffer sets the anEntry->fixed to 1 */
+		e = bfm_allocBuffer(handle, type, &anEntry);
+
+		if (e >= eNOERROR) {
+		    memcpy(BI_BUFFER(type, anEntry), &trains[i * bufSize * PAGESIZE], bufSize * PAGESIZE);
+
+		    anEntry->dirtyFlag = FALSE;
+		    anEntry->invalidFlag = FALSE;
+		    anEntry->referFlag = FALSE;
+		    anEntry->probationFlag = (CFG_BFMREPLACEMENTPOLICY == BFM_POLICY_2Q);
+		    anEntry->prefetchFlag = TRUE;
+
+		    e = LOG_GetNextLogRecordLsn(handle, &anEntry->recLsn);
+		}
+
+		if (e >= eNOERROR) {
+		    anEntry->key = *((BfMHashKey *)&trainId);
+		    e = bfm_insert(handle, (BfMHashKey *)&trainId, anEntry, type);
+		}
+
+		if (e >= eNOERROR) {
+		    anEntry->fixed = 0;
+		    BI_NPREFETCHED(type)++;
+		}
+	    }
+	}
+
+	if (e < eNOERROR) {
+	    (void) bfm_unlock(handle, &trainId, type);
+	    break;
+	}
+
+	e = bfm_unlock(handle, &trainId, type);
+	if (e < eNOERROR) break;
+    }
+
+    free(writeSeqs);
+    free(trains);
+
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_prefetchTrains() */
+
+
+
+/*
+ * Function: Four bfm_queuePrefetchRequest(Four, PageID*, Four, Four)
+ *
+ * Description :
+ *  Queue a readahead request for the prefetchers.
+ *  The request is dropped if the queue is full; the trains are read
+ *  on demand then.
+ *
+ * Returns :
+ *  error codes
+ */
+static Four bfm_queuePrefetchRequest(
+    Four handle,
+    PageID *firstTrainId,	/* IN first train to be read */
+    Four nTrains,		/* IN # of trains to be read */
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error returned */
+    bfm_PrefetchRequest *request; /* the queued request */
+
+
+    e = cosmos_thread_mutex_lock(&bfm_prefetchQueueMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    if (bfm_prefetchQueueCount < BFM_PREFETCH_QUEUE_SIZE) {
+	request = &bfm_prefetchQueue[(bfm_prefetchQueueHead + bfm_prefetchQueueCount) % BFM_PREFETCH_QUEUE_SIZE];
+	request->trainId = *firstTrainId;
+	request->nTrains = nTrains;
+	request->type = type;
+	bfm_prefetchQueueCount++;
+
+	(void) cosmos_thread_cond_signal(&bfm_prefetchQueueCond);
+    }
+
+    e = cosmos_thread_mutex_unlock(&bfm_prefetchQueueMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_queuePrefetchRequest() */
+
+
+
+/*
+ * Function: void *bfm_prefetcherMain(void*)
+ *
+ * Description :
+ *  Start routine of a prefetcher.
+ *  It serves the readahead requests in the queue until
+ *  BfM_StopPrefetchers() is called. An error is reported by ERR()
+ *  and the request is dropped.
+ */
+static void *bfm_prefetcherMain(
+    void *arg)			/* IN pointer to the handle of the prefetcher */
+{
+    Four handle = *(Four *)arg;	/* handle of this prefetcher */
+    bfm_PrefetchRequest request; /* request being served */
+
+
+    for (;;) {
+
+	if (cosmos_thread_mutex_lock(&bfm_prefetchQueueMutex) < eNOERROR) break;
+
+	while (bfm_prefetchQueueCount == 0 && !bfm_stopPrefetchersFlag)
+	    (void) cosmos_thread_cond_wait(&bfm_prefetchQueueCond, &bfm_prefetchQueueMutex);
+
+	if (bfm_stopPrefetchersFlag) {
+	    (void) cosmos_thread_mutex_unlock(&bfm_prefetchQueueMutex);
+	    break;
+	}
+
+	request = bfm_prefetchQueue[bfm_prefetchQueueHead];
+	bfm_prefetchQueueHead = (bfm_prefetchQueueHead + 1) % BFM_PREFETCH_QUEUE_SIZE;
+	bfm_prefetchQueueCount--;
+
+	(void) cosmos_thread_mutex_unlock(&bfm_prefetchQueueMutex);
+
+	/* The volume may have been dismounted since; drop the request then. */
+	if (RDsM_AttachVolume(handle, request.trainId.volNo) < eNOERROR) continue;
+
+	(void) bfm_prefetchTrains(handle, &request.trainId, request.nTrains, request.type);
+    }
+
+    return(NULL);
+
+} /* bfm_prefetcherMain() */
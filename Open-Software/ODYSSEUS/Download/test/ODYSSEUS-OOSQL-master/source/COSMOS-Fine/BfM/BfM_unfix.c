@@ -165,7 +165,10 @@ Four BfM_unfixBuffer(
     }
 
     /* set reference bit according to given Second Chance algorithm */
-    anEntry->referFlag = TRUE;
+    /* A sequential access or the first access of a new buffer under
+     * BFM_POLICY_2Q does not give a second chance. */
+    if (acc_cb->accessHint == BFM_HINT_NORMAL && !anEntry->probationFlag)
+	anEntry->referFlag = TRUE;
 
     anEntry->fixed--;
 
@@ -100,13 +100,14 @@
  * Description :
  *  Allocate a new buffer from the buffer pool.
  *  The used buffer pool is specified by the parameter 'type'.
- *  This routine uses the second chance buffer replacement algorithm
- *  to select a victim.  That is, if the reference bit of current checking
- *  entry (indicated by BI_NEXTVICTIM(type), macro for
- *  bufInfo[type].nextVictim) is set, then simply clear
- *  the bit for the second chance and proceed to the next entry, otherwise
- *  the current buffer indicated by BI_NEXTVICTIM(type) is selected to be
- *  returned.
+ *  A free buffer in the partition of the calling thread is used first.
+ *  Otherwise this routine uses the second chance buffer replacement algorithm
+ *  to select a victim in the partition.  That is, if the reference bit of
+ *  current checking entry (indicated by nextVictim of the partition) is set,
+ *  then simply clear the bit for the second chance and proceed to the next
+ *  entry, otherwise the current buffer indicated by nextVictim is selected
+ *  to be returned. If the clock hand goes round the partition twice without
+ *  finding a victim, the next partition is tried.
  *  Before return the buffer, if the dirty bit of the victim is set, it
  *  must be force out to the disk.
  *
@@ -122,6 +123,9 @@ Four bfm_allocBuffer(
     BufTBLEntry **victimEntry)	/* OUT a Buffer Table Entry to be victim  */
 {
     UFour j;			/* loop index */
+    Four nSteps;		/* # of buffers checked in the current partition */
+    Four partNo;		/* current partition */
+    bfm_Partition *part;	/* current partition */
     Four e;			/* for error */
     BfMHashKey localKey;	/* local key to handle replaced entry */
 
@@ -129,12 +133,31 @@ Four bfm_allocBuffer(
     TR_PRINT(handle, TR_BFM, TR1, ("bfm_allocBuffer(type=%ld, victimEntry=%p)", type, victimEntry));
 
 
+    partNo = BFM_MY_PARTITION(handle, type);
+    part = &BI_PARTITION(type, partNo);
+
     /* THINK :: exit condition of for loop is needed ?? */
     /* starting from the NextVictim, find the victim */
 
-    for  (j = BI_NEXTVICTIM(type)++;; j = BI_NEXTVICTIM(type)++) {
+    for (nSteps = 0;; nSteps++) {
+
+	/* move to the next partition after two rounds of the clock hand */
+	if (nSteps == 2*part->nBufs) {
+	    partNo = (partNo + 1) % BI_NPARTITIONS(type);
+	    part = &BI_PARTITION(type, partNo);
+	    nSteps = 0;
+	}
+
+	/* use a free buffer if any */
+	if (nSteps == 0) {
+	    e = bfm_getFreeBuffer(handle, partNo, type, victimEntry);
+	    if (e < eNOERROR) ERR(handle, e);
 
-	*victimEntry = &BI_BTENTRY(type, (j % BI_NBUFS(type)));
+	    if (*victimEntry != NULL) return(eNOERROR);
+	}
+
+	j = part->nextVictim++;
+	*victimEntry = &BI_BTENTRY(type, part->firstBuf + (j % part->nBufs));
 
 	if ( (*victimEntry)->fixed <= 0 ) {
 
@@ -246,13 +269,17 @@ Four bfm_allocBuffer(
 		    }
 
 		    /* if the dirty bit is set, force out to the disk */
+		    /* NOTE: the page cleaners try to keep this case rare (see BfM_cleaner.c) */
 		    if( (*victimEntry)->dirtyFlag && !(*victimEntry)->invalidFlag)  {
+			BI_NDIRTYVICTIMS(type)++;
+
 			e = bfm_flushBuffer(handle, *victimEntry, type);
 			if( e < 0 ) {
 			    ERROR_PASS(handle, bfm_unlock(handle, (TrainID *)&(*victimEntry)->key, type));
 			    ERR(handle,  e );
 			}
 		    }
+		    BI_NVICTIMS(type)++;
 		    (*victimEntry)->invalidFlag = TRUE;
 
 		    /* Mutex VALID End */
@@ -104,7 +104,8 @@
  *
  * Description :
  *  Write a train specified by 'anEntry->key' into the disk.
- *  Force it out to the disk using RDsM, especially RDsM_WriteTrain( ).
+ *  The train is written by RDsM_SubmitIOs( ) without the sync; the
+ *  checkpoint and the dismount force the written trains out to the disk.
  *
  * Returns :
  *  error codes
@@ -116,6 +117,7 @@ Four bfm_flushBuffer(
 {
     Four e;			/* for errors */
     PageHdr_T *pageHdr;         /* page header */
+    RDsM_IORequest_T req;       /* write request */
 
 
     TR_PRINT(handle, TR_BFM, TR1,
@@ -136,7 +138,13 @@ Four bfm_flushBuffer(
     if (e < eNOERROR) ERR(handle, e);
 
     /*@ write a train into the disk */
-    e = RDsM_WriteTrain(handle, BI_BUFFER(type, anEntry), (PageID *)&anEntry->key, BI_BUFSIZE(type) );
+    req.opType = RDSM_IO_WRITE;
+    req.trainId = *(PageID *)&anEntry->key;
+    req.nPages = BI_BUFSIZE(type);
+    req.bufPtr = BI_BUFFER(type, anEntry);
+    req.callback = NULL;
+
+    e = RDsM_SubmitIOs(handle, &req, 1);
     if (e < eNOERROR) ERR(handle,  e );
 
     /*@ clear the dirty bit */
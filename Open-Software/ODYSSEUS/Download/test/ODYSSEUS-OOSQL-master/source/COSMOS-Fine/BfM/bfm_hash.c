@@ -84,6 +84,10 @@
  * CAUTION :: For Concurrency Control, these functions are called
  *             after bfm_lock(handle, &bufEntry->key, type) is called.
  *
+ *  bfm_lookUp() first traverses the hash chain without latch and uses the
+ *  result only if the version of the hash chain has not been changed.
+ *  bfm_insert() and bfm_delete() change the version under the latch.
+ *
  * Exports:
  *  Four bfm_insert(Four, BfMHashKey *, BufTBLEntry *, Four)
  *  Four bfm_delete(Four, BufTBLEntry *, Four)
@@ -145,8 +149,10 @@ Four bfm_insert(
     if ( e < eNOERROR ) ERR(handle, e);
 
     /* insert anEntry into hash chain */
+    BFM_BEGIN_HASHCHAIN_UPDATE(hashEntryPtr);
     anEntry->nextHashChain = hashEntryPtr->entryPtr;
     hashEntryPtr->entryPtr = LOGICAL_PTR(anEntry); 
+    BFM_END_HASHCHAIN_UPDATE(hashEntryPtr);
 
     /*@ release latch */
     /* MUTEX end */
@@ -206,8 +212,11 @@ Four bfm_delete(
      */
     prevEntry = PHYSICAL_PTR(hashEntryPtr->entryPtr);
 
-    if ( prevEntry == anEntry )
+    if ( prevEntry == anEntry ) {
+	BFM_BEGIN_HASHCHAIN_UPDATE(hashEntryPtr);
 	hashEntryPtr->entryPtr = anEntry->nextHashChain;
+	BFM_END_HASHCHAIN_UPDATE(hashEntryPtr);
+    }
 
     else {
 
@@ -226,7 +235,9 @@ Four bfm_delete(
 	}
 
 	/* delete from hash chain */
+	BFM_BEGIN_HASHCHAIN_UPDATE(hashEntryPtr);
 	prevEntry->nextHashChain = anEntry->nextHashChain;
+	BFM_END_HASHCHAIN_UPDATE(hashEntryPtr);
     }
 
     /*@ release latch */
@@ -263,6 +274,11 @@ Four bfm_lookUp(
     bfmHashEntry *hashEntryPtr; /* hash table entry holding anEntry */
     Four  e;			/* error returned */
     Seed         tempSeed;      /* temp seed */
+#ifdef BFM_OPTIMISTIC_LOOKUP
+    Four  nTries;		/* # of latch-free trials */
+    Four  nVisited;		/* # of entries visited in the hash chain */
+    UFour version;		/* version of the hash chain when the traversal began */
+#endif
 
     TR_PRINT(handle, TR_BFM, TR1, ("bfm_LookUp( key=%P, type=%ld )", lookupedKey, type));
 
@@ -273,6 +289,34 @@ Four bfm_lookUp(
     /* @ find corresponding hash entry */
     hashEntryPtr = &BI_HASHENTRY(type, BFM_HASH(lookupedKey, tempSeed, type));
 
+#ifdef BFM_OPTIMISTIC_LOOKUP
+    /*
+     * search the hash chain without latch.
+     * The entries are never freed, so a traversal of a chain being updated
+     * only gives a wrong result, which is detected by the changed version;
+     * nVisited prevents an endless loop in such a chain.
+     */
+    for (nTries = 0; nTries < BFM_MAX_OPTIMISTIC_TRIES; nTries++) {
+
+	version = hashEntryPtr->version;
+	BFM_MEMORY_BARRIER();
+
+	if (version & 1) continue; /* being updated */
+
+	nVisited = 0;
+	*anEntry = PHYSICAL_PTR(hashEntryPtr->entryPtr);
+	while ( *anEntry && nVisited < BI_NBUFS(type) && !EQUALKEY(&((*anEntry)->key), lookupedKey) ) {
+	    *anEntry = PHYSICAL_PTR((*anEntry)->nextHashChain);
+	    nVisited++;
+	}
+
+	BFM_MEMORY_BARRIER();
+	if (hashEntryPtr->version == version && nVisited < BI_NBUFS(type)) break;
+    }
+
+    if (nTries == BFM_MAX_OPTIMISTIC_TRIES) {
+#endif
+
     /* get latch */
     /* MUTEX begin : protect from updating the chain */
     e = SHM_getLatch(handle,  &hashEntryPtr->latch, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
@@ -288,6 +332,10 @@ Four bfm_lookUp(
     e = SHM_releaseLatch(handle,  &hashEntryPtr->latch, procIndex);
     if ( e < eNOERROR ) ERR(handle, e);
 
+#ifdef BFM_OPTIMISTIC_LOOKUP
+    }
+#endif
+
     /* the key does not exist in the table */
     if ( !(*anEntry) )  {
 #ifdef TRACE
@@ -352,6 +400,7 @@ Four bfm_initBufferHashTable(
         i < HASHTABLESIZE(type); hashEntryPtr++, i++ ) { 
 
 	hashEntryPtr->entryPtr = LOGICAL_PTR(NULL);
+	hashEntryPtr->version = 0;
 	SHM_initLatch(handle, &hashEntryPtr->latch);
     }
     return(eNOERROR);
@@ -182,7 +182,7 @@ Four bfm_lock(
     lock_cb->key = *key;
     /* SHM_initLatch(handle, &lock_cb->latch); */ 
 
-    if (lock_cb->latch.mode != M_FREE || lock_cb->latch.queue != LOGICAL_PTR(NULL)) ERR(handle, eINTERNAL);
+    if (!SHM_IS_LATCH_FREE(lock_cb->latch)) ERR(handle, eINTERNAL);
 
 
     /* insert into hash chain */
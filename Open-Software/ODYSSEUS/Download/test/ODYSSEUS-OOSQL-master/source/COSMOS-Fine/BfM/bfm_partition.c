@@ -0,0 +1,336 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: bfm_partition.c
+ *
+ * Description:
+ *  The buffers of a buffer pool are divided into partitions.
+ *  Each partition has its own clock hand and its own free list of the
+ *  buffers which hold no train, so the threads allocating buffers mostly
+ *  work on different partitions. A thread starts from its own partition
+ *  (see BFM_MY_PARTITION()) and visits the other partitions only when its
+ *  partition has no buffer to replace.
+ *
+ *  The free list is only a hint: a buffer may be taken by the clock hand
+ *  while it is in the free list, so the buffer is checked again when it
+ *  is taken from the free list.
+ *
+ * Exports:
+ *  Four bfm_initPartitions(Four, Four, Four)
+ *  Four bfm_finalPartitions(Four, Four)
+ *  Four bfm_addFreeBuffer(Four, BufTBLEntry *, Four)
+ *  Four bfm_getFreeBuffer(Four, Four, Four, BufTBLEntry **)
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "SHM.h"
+#include "BfM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*@================================
+ * bfm_initPartitions( )
+ *================================*/
+/*
+ * Function: Four bfm_initPartitions(Four, Four, Four)
+ *
+ * Description:
+ *  Divide the buffer pool into the given number of partitions and
+ *  put all the buffers into the free lists of their partitions.
+ *  The number of partitions is reduced so that a partition has
+ *  at least BFM_MIN_BUFS_IN_PARTITION buffers.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bfm_initPartitions(
+    Four handle,
+    Four type,			/* IN buffer type */
+    Four nPartitions)		/* IN # of partitions requested */
+{
+    Four e;			/* error code */
+    Four i;			/* loop index */
+    Four partNo;		/* partition number */
+    Four partSize;		/* # of buffers in a partition */
+    bfm_Partition *part;	/* a partition */
+    BufTBLEntry *anEntry;	/* a Buffer Table Entry */
+    void *physical_ptr;
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_initPartitions(type=%ld, nPartitions=%ld)", type, nPartitions));
+
+
+    if (nPartitions > BI_NBUFS(type) / BFM_MIN_BUFS_IN_PARTITION)
+	nPartitions = BI_NBUFS(type) / BFM_MIN_BUFS_IN_PARTITION;
+    if (nPartitions < 1) nPartitions = 1;
+
+    e = SHM_alloc(handle, sizeof(bfm_Partition)*nPartitions, -1, (char **)&physical_ptr);
+    if (e < eNOERROR) ERR(handle, e);
+    BI_PARTITIONS(type) = LOGICAL_PTR(physical_ptr);
+    BI_NPARTITIONS(type) = nPartitions;
+
+    /* The last partition takes the remainder. */
+    partSize = BI_NBUFS(type) / nPartitions;
+
+    for (partNo = 0; partNo < nPartitions; partNo++) {
+	part = &BI_PARTITION(type, partNo);
+
+	part->nextVictim = 0;
+	part->firstBuf = partNo * partSize;
+	part->nBufs = (partNo == nPartitions - 1) ? BI_NBUFS(type) - part->firstBuf : partSize;
+
+	e = SHM_initLatch(handle, &part->freeListLatch);
+	if (e < eNOERROR) ERR(handle, e);
+
+	/* All the buffers are free at first. */
+	part->freeList = NIL;
+	for (i = part->nBufs - 1; i >= 0; i--) {
+	    anEntry = &BI_BTENTRY(type, part->firstBuf + i);
+	    anEntry->nextFree = part->freeList;
+	    anEntry->freeListFlag = TRUE;
+	    part->freeList = part->firstBuf + i;
+	}
+    }
+
+    return(eNOERROR);
+
+} /* bfm_initPartitions() */
+
+
+
+/*@================================
+ * bfm_finalPartitions( )
+ *================================*/
+/*
+ * Function: Four bfm_finalPartitions(Four, Four)
+ *
+ * Description:
+ *  Free the partitions of the buffer pool.
+ *
+ * Returns:
+ *  error code
+ */
+Four bfm_finalPartitions(
+    Four handle,
+    Four type)			/* IN buffer type */
+{
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_finalPartitions(type=%ld)", type));
+
+
+    ERROR_PASS(handle, SHM_free(handle, (char *)PHYSICAL_PTR(BI_PARTITIONS(type)), procIndex));
+
+    return(eNOERROR);
+
+} /* bfm_finalPartitions() */
+
+
+
+/*@================================
+ * bfm_addFreeBuffer( )
+ *================================*/
+/*
+ * Function: Four bfm_addFreeBuffer(Four, BufTBLEntry *, Four)
+ *
+ * Description:
+ *  Put a buffer, which has been invalidated and deleted from the hash
+ *  table, into the free list of its partition.
+ *  The caller must hold bfm_lock() on the train which was in the buffer.
+ *
+ * Returns:
+ *  error code
+ */
+Four bfm_addFreeBuffer(
+    Four handle,
+    BufTBLEntry *anEntry,	/* IN buffer to be freed */
+    Four type)			/* IN buffer type */
+{
+    Four e;			/* error code */
+    Four idx;			/* index of the buffer */
+    bfm_Partition *part;	/* partition of the buffer */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_addFreeBuffer(anEntry=%P, type=%ld)", anEntry, type));
+
+
+    idx = BI_BUFINDEX(type, anEntry);
+
+    /* The last partition may be larger than the others. */
+    part = &BI_PARTITION(type, MIN(idx / BI_PARTITION(type, 0).nBufs, BI_NPARTITIONS(type) - 1));
+
+    e = SHM_getLatch(handle, &part->freeListLatch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    if (!anEntry->freeListFlag) {
+	anEntry->nextFree = part->freeList;
+	anEntry->freeListFlag = TRUE;
+	part->freeList = idx;
+    }
+
+    e = SHM_releaseLatch(handle, &part->freeListLatch, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* bfm_addFreeBuffer() */
+
+
+
+/*@================================
+ * bfm_getFreeBuffer( )
+ *================================*/
+/*
+ * Function: Four bfm_getFreeBuffer(Four, Four, Four, BufTBLEntry **)
+ *
+ * Description:
+ *  Take a free buffer from the free list of the given partition and fix it
+ *  as bfm_allocBuffer() does for an invalid buffer. The buffers which were
+ *  taken by others in the meantime are dropped from the free list.
+ *
+ * Returns:
+ *  error code
+ *
+ * Side effects:
+ *  *anEntry is NULL if the partition has no free buffer.
+ */
+Four bfm_getFreeBuffer(
+    Four handle,
+    Four partNo,		/* IN partition number */
+    Four type,			/* IN buffer type */
+    BufTBLEntry **anEntry)	/* OUT free buffer */
+{
+    Four e;			/* error code */
+    bfm_Partition *part;	/* the partition */
+    BufTBLEntry *freeEntry;	/* buffer taken from the free list */
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_getFreeBuffer(partNo=%ld, type=%ld)", partNo, type));
+
+
+    *anEntry = NULL;
+    part = &BI_PARTITION(type, partNo);
+
+    /* Do not bother with the latch if the free list is empty. */
+    while (part->freeList != NIL) {
+
+	e = SHM_getLatch(handle, &part->freeListLatch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (part->freeList == NIL) {
+	    freeEntry = NULL;
+	} else {
+	    freeEntry = &BI_BTENTRY(type, part->freeList);
+	    part->freeList = freeEntry->nextFree;
+	    freeEntry->freeListFlag = FALSE;
+	}
+
+	e = SHM_releaseLatch(handle, &part->freeListLatch, procIndex);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (freeEntry == NULL) break;
+
+	/* the buffer may have been taken by the clock hand */
+	if (!freeEntry->invalidFlag || !IS_NILBFMHASHKEY(freeEntry->key) || freeEntry->fixed > 0)
+	    continue;
+
+	/* same as the invalid case of bfm_allocBuffer() */
+	e = SHM_getLatch(handle, &freeEntry->latch, procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (e == SHM_BUSYLATCH) continue;
+
+	if (freeEntry->fixed > 0 || !freeEntry->invalidFlag || !IS_NILBFMHASHKEY(freeEntry->key)) {
+	    e = SHM_releaseLatch(handle, &freeEntry->latch, procIndex);
+	    if (e < eNOERROR) ERR(handle, e);
+	    continue;
+	}
+
+	freeEntry->fixed = 1;	/* set fix value quickly */
+	freeEntry->invalidFlag = FALSE;
+
+	e = SHM_releaseLatch(handle, &freeEntry->latch, procIndex);
+	if (e < eNOERROR) ERR(handle, e);
+
+	*anEntry = freeEntry;
+	break;
+    }
+
+    return(eNOERROR);
+
+} /* bfm_getFreeBuffer() */
@@ -0,0 +1,211 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: bfm_ring.c
+ *
+ * Description:
+ *  A thread accessing trains sequentially, i.e. with BFM_HINT_SEQUENTIAL,
+ *  uses a ring of at most BFM_RING_SIZE buffers instead of taking a victim
+ *  chosen by the replacement algorithm for each train. So a large
+ *  sequential scan replaces only a few buffers and leaves the working set
+ *  of the other transactions in the buffer pool.
+ *
+ *  A buffer in the ring is reused only if it still holds the train read by
+ *  this thread and nobody has referenced it since; otherwise it is left to
+ *  the replacement algorithm and a new buffer is taken for the ring.
+ *
+ * Exports:
+ *  Four bfm_allocRingBuffer(Four, TrainID *, Four, BufTBLEntry **)
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "SHM.h"
+#include "BfM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*@================================
+ * bfm_allocRingBuffer( )
+ *================================*/
+/*
+ * Function: Four bfm_allocRingBuffer(Four, TrainID *, Four, BufTBLEntry **)
+ *
+ * Description:
+ *  Allocate a buffer for the given train from the ring of the calling
+ *  thread. If the ring is not full or the buffer to be reused is busy,
+ *  a buffer is allocated by bfm_allocBuffer() and put into the ring.
+ *  The caller holds bfm_lock() on 'trainId' as for bfm_allocBuffer().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  *victimEntry is fixed and marked invalid as by bfm_allocBuffer().
+ */
+Four bfm_allocRingBuffer(
+    Four handle,
+    TrainID *trainId,		/* IN train to be read into the buffer */
+    Four type,			/* IN buffer type */
+    BufTBLEntry **victimEntry)	/* OUT allocated buffer */
+{
+    Four e;			/* error code */
+    Four slot;			/* slot of the ring */
+    BufTBLEntry *anEntry;	/* buffer to be reused */
+    BfMHashKey localKey;	/* train in the buffer to be reused */
+    bfm_BufferRing *ring;	/* ring of the calling thread */
+
+    /* pointer for BfM Data Structure of perThreadTable */
+    BfM_PerThreadDS_T *bfm_perThreadDSptr = BfM_PER_THREAD_DS_PTR(handle);
+
+
+    TR_PRINT(handle, TR_BFM, TR1, ("bfm_allocRingBuffer(trainId=%P, type=%ld)", trainId, type));
+
+
+    ring = &bfm_perThreadDSptr->ring[type];
+
+    if (ring->nEntries < BFM_RING_SIZE) {
+	slot = ring->nEntries++;
+    }
+    else {
+	slot = ring->next;
+	ring->next = (ring->next + 1) % BFM_RING_SIZE;
+
+	anEntry = &BI_BTENTRY(type, ring->bufIdx[slot]);
+	localKey = ring->key[slot];
+
+	/* check without the lock first */
+	if (EQUALKEY(&anEntry->key, &localKey) && anEntry->fixed <= 0 &&
+	    !anEntry->referFlag && !anEntry->invalidFlag) {
+
+	    /* Mutex VALID Begin */
+	    e = bfm_lock(handle, (TrainID *)&localKey, type);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    if (EQUALKEY(&anEntry->key, &localKey) && anEntry->fixed <= 0 &&
+		!anEntry->referFlag && !anEntry->invalidFlag) {
+
+		anEntry->fixed = 1; /* set fix value quickly */
+
+		/* Delete the buffer from the hash table */
+		e = bfm_delete(handle, anEntry, type);
+		if (e < eNOERROR) {
+		    ERROR_PASS(handle, bfm_unlock(handle, (TrainID *)&localKey, type));
+		    ERR(handle, e);
+		}
+
+		/* if the dirty bit is set, force out to the disk */
+		if (anEntry->dirtyFlag) {
+		    BI_NDIRTYVICTIMS(type)++;
+
+		    e = bfm_flushBuffer(handle, anEntry, type);
+		    if (e < eNOERROR) {
+			ERROR_PASS(handle, bfm_unlock(handle, (TrainID *)&localKey, type));
+			ERR(handle, e);
+		    }
+		}
+		BI_NVICTIMS(type)++;
+		anEntry->invalidFlag = TRUE;
+
+		/* Mutex VALID End */
+		e = bfm_unlock(handle, (TrainID *)&localKey, type);
+		if (e < eNOERROR) ERR(handle, e);
+
+		ring->key[slot] = *((BfMHashKey *)trainId);
+		*victimEntry = anEntry;
+
+		return(eNOERROR);
+	    }
+
+	    /* Mutex VALID End */
+	    e = bfm_unlock(handle, (TrainID *)&localKey, type);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+    }
+
+    /* take a new buffer for the ring */
+    e = bfm_allocBuffer(handle, type, victimEntry);
+    if (e < eNOERROR) ERR(handle, e);
+
+    ring->bufIdx[slot] = BI_BUFINDEX(type, *victimEntry);
+    ring->key[slot] = *((BfMHashKey *)trainId);
+
+    return(eNOERROR);
+
+} /* bfm_allocRingBuffer() */
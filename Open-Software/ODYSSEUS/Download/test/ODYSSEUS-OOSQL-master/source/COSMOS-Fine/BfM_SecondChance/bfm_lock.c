@@ -179,7 +179,7 @@ Four bfm_lock(
     lock_cb->lockCounter = 1;
     lock_cb->key = *key;
 
-    if (lock_cb->latch.mode != M_FREE || lock_cb->latch.queue != LOGICAL_PTR(NULL)) ERR(handle, eINTERNAL);
+    if (!SHM_IS_LATCH_FREE(lock_cb->latch)) ERR(handle, eINTERNAL);
 	    
     /* insert into hash chain */
     lock_cb->nextHashChain = hashEntryPtr->blockPtr;
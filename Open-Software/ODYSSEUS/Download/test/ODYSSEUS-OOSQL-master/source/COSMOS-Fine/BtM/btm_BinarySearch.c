@@ -89,6 +89,7 @@
  */
 
 
+#include <string.h>
 #include "common.h"
 #include "error.h"
 #include "trace.h"
@@ -98,6 +99,26 @@
 #include "perThreadDS.h"
 
 
+/*
+ * BTM_FIXED_KEY_SEARCH
+ *  Binary search loop for single-part ascending keys of a fixed-width type.
+ *  The keys are compared as native values without calling a compare routine;
+ *  'low', 'mid', and 'high' are updated as in the general loop.
+ */
+#define BTM_FIXED_KEY_SEARCH(_type, _page, _entryType, _kval, _low, _mid, _high) \
+{ \
+    _type _key, _entryKey; \
+    \
+    memcpy(&_key, &((_kval)->val[0]), sizeof(_type)); \
+    do { \
+	(_mid) = ((_low) + (_high))/2; \
+	memcpy(&_entryKey, ((_entryType*)&((_page)->data[(_page)->slot[-(_mid)]]))->kval, sizeof(_type)); \
+	if (_key <= _entryKey) (_high) = (_mid) - 1; \
+	if (_key >= _entryKey) (_low) = (_mid) + 1; \
+    } while ((_high) >= (_low)); \
+}
+
+
 
 /*@================================
  * btm_BinarySearchInternal( )
@@ -129,6 +150,7 @@ Boolean btm_BinarySearchInternal(
     Four mid;			/* mid index */
     Four high;			/* high index */
     Four cmp;			/* result of comparison */
+    btm_KeyCompareFunc compare;	/* key compare routine for kdesc */
     btm_InternalEntry *entry;	/* an internal entry */
 
 
@@ -140,13 +162,21 @@ Boolean btm_BinarySearchInternal(
     high = ipage->hdr.nSlots - 1;
 
     if (high >=0) {
+	/* choose the compare routine once rather than interpreting kdesc on each probe */
+	compare = btm_GetKeyCompareFunc(kdesc);
+
 	/* find the key value by using binary search */
+	if (compare == btm_IntKeyCompare)
+	    BTM_FIXED_KEY_SEARCH(Four_Invariable, ipage, btm_InternalEntry, kval, low, mid, high)
+	else if (compare == btm_LongLongKeyCompare)
+	    BTM_FIXED_KEY_SEARCH(Eight_Invariable, ipage, btm_InternalEntry, kval, low, mid, high)
+	else
 	do {
 	    mid = (low + high)/2;	/*@ get the mid index */
 
 	    entry = (btm_InternalEntry*)&(ipage->data[ipage->slot[-mid]]);
 
-	    cmp = btm_KeyCompare(handle, kdesc, kval, (KeyValue*)&entry->klen);
+	    cmp = (*compare)(handle, kdesc, kval, (KeyValue*)&entry->klen);
 
 	    if (cmp != GREAT) high = mid - 1;
 	    if (cmp != LESS) low = mid + 1;
@@ -199,6 +229,7 @@ Boolean btm_BinarySearchLeaf(
     Four mid;			/* mid index */
     Four high;			/* high index */
     Four cmp;			/* result of comparison */
+    btm_KeyCompareFunc compare;	/* key compare routine for kdesc */
     btm_LeafEntry *entry;	/* a leaf entry */
 
 
@@ -210,13 +241,21 @@ Boolean btm_BinarySearchLeaf(
     high = lpage->hdr.nSlots - 1;
 
     if (high >= 0) {
+	/* choose the compare routine once rather than interpreting kdesc on each probe */
+	compare = btm_GetKeyCompareFunc(kdesc);
+
 	/* find the key value by using binary search. */
+	if (compare == btm_IntKeyCompare)
+	    BTM_FIXED_KEY_SEARCH(Four_Invariable, lpage, btm_LeafEntry, kval, low, mid, high)
+	else if (compare == btm_LongLongKeyCompare)
+	    BTM_FIXED_KEY_SEARCH(Eight_Invariable, lpage, btm_LeafEntry, kval, low, mid, high)
+	else
 	do {
 	    mid = (low + high)/2; 	/*@ get the mid index */
 
 	    entry = (btm_LeafEntry*)&(lpage->data[lpage->slot[-mid]]);
 
-	    cmp = btm_KeyCompare(handle, kdesc, kval, (KeyValue*)&entry->klen);
+	    cmp = (*compare)(handle, kdesc, kval, (KeyValue*)&entry->klen);
 
 	    if(cmp != GREAT) high = mid - 1;
 	    if(cmp != LESS) low = mid + 1;
@@ -75,10 +75,15 @@
  *
  * Description :
  *  This file includes two compare routines, one for keys used in Btree Index
- *  and another for ObjectIDs.
+ *  and another for ObjectIDs. It also has the key compare routines specialized
+ *  for single-part ascending keys, which do not interpret the key descriptor.
  *
  * Exports:
  *  Four btm_KeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*)
+ *  btm_KeyCompareFunc btm_GetKeyCompareFunc(KeyDesc*)
+ *  Four btm_ChooseKeyCompareFunc(KeyDesc*)
+ *  Four btm_IntKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*)
+ *  Four btm_LongLongKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*)
  *  Four btm_ObjectIdComp(Four, ObjectID*, ObjectID*)
  */
 
@@ -292,6 +297,162 @@ Four btm_KeyCompare(
 
 
 
+/*
+ * Specialized key compare routines
+ * Each of them compares single-part ascending keys of one type. They have the
+ * same interface and results as btm_KeyCompare().
+ */
+#define BTM_FIXED_KEY_COMPARE(_func, _type) \
+Four _func( \
+    Four 	handle, \
+    KeyDesc 	*kdesc, \
+    KeyValue 	*key1, \
+    KeyValue 	*key2) \
+{ \
+    _type 	v1, v2; \
+    \
+    memcpy(&v1, &(key1->val[0]), sizeof(_type)); \
+    memcpy(&v2, &(key2->val[0]), sizeof(_type)); \
+    \
+    return((v1 == v2) ? EQUAL : ((v1 > v2) ? GREAT : LESS)); \
+}
+
+static Four btm_ShortKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
+static Four btm_FloatKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
+static Four btm_DoubleKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
+
+BTM_FIXED_KEY_COMPARE(btm_ShortKeyCompare, Two_Invariable)
+BTM_FIXED_KEY_COMPARE(btm_IntKeyCompare, Four_Invariable)
+BTM_FIXED_KEY_COMPARE(btm_LongLongKeyCompare, Eight_Invariable)
+BTM_FIXED_KEY_COMPARE(btm_FloatKeyCompare, float)
+BTM_FIXED_KEY_COMPARE(btm_DoubleKeyCompare, double)
+
+
+static Four btm_StringKeyCompare(
+    Four 			handle,
+    KeyDesc 			*kdesc,		/* IN key descriptor for key1 and key2 */
+    KeyValue 			*key1,		/* IN the first key value */
+    KeyValue 			*key2)		/* IN the second key value */
+{
+    Four 			rtn;		/* return value */
+
+
+    rtn = memcmp(&(key1->val[0]), &(key2->val[0]), kdesc->kpart[0].length);
+
+    return((rtn == 0) ? EQUAL : ((rtn > 0) ? GREAT : LESS));
+}
+
+
+static Four btm_VarStringKeyCompare(
+    Four 			handle,
+    KeyDesc 			*kdesc,		/* IN key descriptor for key1 and key2 */
+    KeyValue 			*key1,		/* IN the first key value */
+    KeyValue 			*key2)		/* IN the second key value */
+{
+    Two  			len1, len2;	/* string length */
+    Four 			rtn;		/* return value */
+
+
+    memcpy(&len1, &(key1->val[0]), sizeof(Two));
+    memcpy(&len2, &(key2->val[0]), sizeof(Two));
+
+    rtn = memcmp(&(key1->val[sizeof(Two)]), &(key2->val[sizeof(Two)]), MIN(len1, len2));
+
+    /* left and right strings are same in MIN(len1, len2) bytes */
+    if (rtn == 0) return((len1 == len2) ? EQUAL : ((len1 > len2) ? GREAT : LESS));
+
+    return((rtn > 0) ? GREAT : LESS);
+}
+
+
+
+/*
+ * Key compare routines by the number recorded in KEYFLAG_COMPARE_MASK
+ * The number 0 means that no routine is recorded.
+ */
+#define BTM_COMPARE_NONE	0
+#define BTM_COMPARE_GENERAL	1
+#define BTM_COMPARE_SHORT	2
+#define BTM_COMPARE_INT		3
+#define BTM_COMPARE_LONG_LONG	4
+#define BTM_COMPARE_FLOAT	5
+#define BTM_COMPARE_DOUBLE	6
+#define BTM_COMPARE_STRING	7
+#define BTM_COMPARE_VARSTRING	8
+
+static btm_KeyCompareFunc btm_keyCompareFuncs[] = {
+    NULL, btm_KeyCompare, btm_ShortKeyCompare, btm_IntKeyCompare, btm_LongLongKeyCompare,
+    btm_FloatKeyCompare, btm_DoubleKeyCompare, btm_StringKeyCompare, btm_VarStringKeyCompare
+};
+
+
+
+/*@================================
+ * btm_ChooseKeyCompareFunc( )
+ *================================*/
+/*
+ * Function: Four btm_ChooseKeyCompareFunc(KeyDesc*)
+ *
+ * Description:
+ *  Choose the key compare routine for the keys described by "kdesc".
+ *  Single-part ascending keys get a routine specialized for their type;
+ *  the others are compared by btm_KeyCompare(). The routine recorded in
+ *  "kdesc" is ignored.
+ *
+ * Returns:
+ *  number of the key compare routine
+ */
+Four btm_ChooseKeyCompareFunc(
+    KeyDesc 			*kdesc)		/* IN key descriptor */
+{
+    if (kdesc->nparts != 1 || (kdesc->kpart[0].type & SM_DESC)) return(BTM_COMPARE_GENERAL);
+
+    switch (kdesc->kpart[0].type & SM_TYPE_MASK) {
+      case SM_SHORT:		return(BTM_COMPARE_SHORT);
+      case SM_INT:
+      case SM_LONG:		return(BTM_COMPARE_INT);
+      case SM_LONG_LONG:	return(BTM_COMPARE_LONG_LONG);
+      case SM_FLOAT:		return(BTM_COMPARE_FLOAT);
+      case SM_DOUBLE:		return(BTM_COMPARE_DOUBLE);
+      case SM_STRING:		return(BTM_COMPARE_STRING);
+      case SM_VARSTRING:	return(BTM_COMPARE_VARSTRING);
+      default:			return(BTM_COMPARE_GENERAL);
+    }
+
+}   /* btm_ChooseKeyCompareFunc() */
+
+
+
+/*@================================
+ * btm_GetKeyCompareFunc( )
+ *================================*/
+/*
+ * Function: btm_KeyCompareFunc btm_GetKeyCompareFunc(KeyDesc*)
+ *
+ * Description:
+ *  Get the key compare routine for the keys described by "kdesc". The
+ *  routine recorded by BtM_SetKeyCompareFunc() is used if any; otherwise
+ *  the routine is chosen now.
+ *
+ * Returns:
+ *  key compare routine
+ */
+btm_KeyCompareFunc btm_GetKeyCompareFunc(
+    KeyDesc 			*kdesc)		/* IN key descriptor */
+{
+    Four 			funcNo;		/* number of the key compare routine */
+
+
+    funcNo = (kdesc->flag & KEYFLAG_COMPARE_MASK) >> KEYFLAG_COMPARE_SHIFT;
+
+    if (funcNo == BTM_COMPARE_NONE) funcNo = btm_ChooseKeyCompareFunc(kdesc);
+
+    return(btm_keyCompareFuncs[funcNo]);
+
+}   /* btm_GetKeyCompareFunc() */
+
+
+
 /*@================================
  * btm_ObjectIdComp( )
  *================================*/
@@ -105,7 +105,8 @@
 /* Internal Function Prototypes */
 Four btm_SplitInternal(Four, XactTableEntry_T*, BtreeIndexInfo*, Buffer_ACC_CB*, Four, btm_InternalEntry*, btm_InternalEntry*, LogParameter_T*); 
 Four btm_SplitRoot(Four, XactTableEntry_T*, BtreeIndexInfo*, Buffer_ACC_CB*, KeyDesc*, btm_InternalEntry*, LogParameter_T*); 
-Four btm_SplitLeaf(Four, XactTableEntry_T*, BtreeIndexInfo*, Buffer_ACC_CB*, Buffer_ACC_CB*, btm_InternalEntry*, LogParameter_T*);
+Four btm_SplitLeaf(Four, XactTableEntry_T*, BtreeIndexInfo*, Buffer_ACC_CB*, Buffer_ACC_CB*, KeyDesc*, btm_InternalEntry*, LogParameter_T*);
+static Boolean btm_TruncateSeparator(KeyDesc*, btm_LeafEntry*, btm_LeafEntry*, btm_InternalEntry*);
 Four btm_InsertInternal(Four, XactTableEntry_T*, Buffer_ACC_CB*, Four, btm_InternalEntry*, LogParameter_T*);
 Four btm_RequestExclusiveTreeLatch(Four, btm_TraversePath *,Buffer_ACC_CB*);
 
@@ -218,7 +219,7 @@ Four btm_Split(
 		done = TRUE;
 
 	    } else {
-		e = btm_SplitLeaf(handle, xactEntry, iinfo, orig_BCB, next_BCB, &overflowedEntry, logParam);
+		e = btm_SplitLeaf(handle, xactEntry, iinfo, orig_BCB, next_BCB, kdesc, &overflowedEntry, logParam);
 		if (e < eNOERROR) ERR(handle, e); 
 	    }
 
@@ -411,7 +412,7 @@ Four btm_SplitRoot(
 
     /* Split the new page. */
     if (newPage->any.hdr.type & LEAF)
-        e = btm_SplitLeaf(handle, xactEntry, iinfo, new_BCB, NULL, &overflowedEntry, logParam);
+        e = btm_SplitLeaf(handle, xactEntry, iinfo, new_BCB, NULL, kdesc, &overflowedEntry, logParam);
     else {
         btm_BinarySearchInternal(handle, &newPage->bi, kdesc, (KeyValue*)&entry->klen, &slotNo);
 
@@ -717,11 +718,13 @@ Four btm_SplitInternal(
 
 
 /*
- * Function: Four btm_SplitLeaf(Four, Buffer_ACC_CB*, btm_InternalEntry*)
+ * Function: Four btm_SplitLeaf(Four, Buffer_ACC_CB*, KeyDesc*, btm_InternalEntry*)
  *
  * Description:
  *  Split a leaf page. Return an overflow entry resulting from the leaf page
- *  split.
+ *  split. If possible, the key of the overflow entry is the shortest
+ *  separator between the two pages instead of the full first key of the
+ *  new page.
  *
  * Returns:
  *  Error codes
@@ -733,6 +736,7 @@ Four btm_SplitLeaf(
     BtreeIndexInfo   *iinfo,          /* IN    btree index info */
     Buffer_ACC_CB *orig_BCB,	      /* INOUT buffer control block for original page */
     Buffer_ACC_CB *next_BCB,	      /* INOUT buffer control block of next leaf page  */
+    KeyDesc *kdesc,		      /* IN    key descriptor */
     btm_InternalEntry *overflowEntry, /* OUT entry to be returned */
     LogParameter_T *logParam)   /* IN log parameter */
 {
@@ -828,8 +832,12 @@ Four btm_SplitLeaf(
     nEntryOffset = npage->slot[0];
     nEntry = (btm_LeafEntry*)&(npage->data[nEntryOffset]);
     overflowEntry->spid = newPid.pageNo;
-    overflowEntry->klen = nEntry->klen;
-    memcpy(&(overflowEntry->kval[0]), &(nEntry->kval[0]), overflowEntry->klen);
+    fEntry = (fpage->hdr.nSlots > 0) ? (btm_LeafEntry*)&(fpage->data[fpage->slot[-(fpage->hdr.nSlots-1)]]) : NULL;
+    if (!BTM_SUFFIX_TRUNCATION || fEntry == NULL || npage->hdr.nSlots == 0 ||
+        !btm_TruncateSeparator(kdesc, fEntry, nEntry, overflowEntry)) {
+        overflowEntry->klen = nEntry->klen;
+        memcpy(&(overflowEntry->kval[0]), &(nEntry->kval[0]), overflowEntry->klen);
+    }
 
     /* Leaves are connected by doubly linked list, so it should update the links. */
     MAKE_PAGEID(nextPid, fpage->hdr.pid.volNo, fpage->hdr.nextPage);
@@ -943,6 +951,91 @@ Four btm_SplitLeaf(
 } /* btm_SplitLeaf() */
 
 
+
+/*
+ * Function: Boolean btm_TruncateSeparator(KeyDesc*, btm_LeafEntry*, btm_LeafEntry*, btm_InternalEntry*)
+ *
+ * Description:
+ *  Make the shortest separator key S such that left < S <= right, where
+ *  'left' is the last entry of the left page and 'right' is the first entry
+ *  of the right page after a leaf split. S is the key of 'right' with the
+ *  last key part cut just after the first byte that differs from 'left'.
+ *  This is possible only when the keys first differ in the last key part
+ *  and that part is an ascending SM_VARSTRING; the other key parts are kept
+ *  whole because btm_KeyCompare() reads them at fixed positions.
+ *
+ * Returns:
+ *  TRUE if 'separator' is filled with a truncated key, FALSE otherwise
+ */
+static Boolean btm_TruncateSeparator(
+    KeyDesc *kdesc,		/* IN key descriptor */
+    btm_LeafEntry *left,	/* IN the last entry of the left page */
+    btm_LeafEntry *right,	/* IN the first entry of the right page */
+    btm_InternalEntry *separator) /* OUT entry whose key is the separator */
+{
+    Four i;			/* index for # of key parts */
+    Four offset;		/* offset of the current key part */
+    Four kpartSize;		/* size of the current key part */
+    Four prefixLen;		/* length of the common prefix */
+    Two len1, len2;		/* string length */
+    Two newLen;			/* length of the truncated string */
+
+
+    if (kdesc == NULL) return(FALSE);
+
+    /* The key parts before the last one should be same in both keys. */
+    for (offset = 0, i = 0; i < kdesc->nparts - 1; i++, offset += kpartSize) {
+
+	switch (kdesc->kpart[i].type & SM_TYPE_MASK) {
+	  case SM_VARSTRING:
+	    memcpy(&len1, &(left->kval[offset]), sizeof(Two));
+	    memcpy(&len2, &(right->kval[offset]), sizeof(Two));
+	    if (len1 != len2) return(FALSE);
+	    kpartSize = sizeof(Two) + len1;
+	    break;
+
+	  case SM_SHORT:	kpartSize = sizeof(Two_Invariable); break;
+	  case SM_INT:
+	  case SM_LONG:		kpartSize = sizeof(Four_Invariable); break;
+	  case SM_LONG_LONG:	kpartSize = sizeof(Eight_Invariable); break;
+	  case SM_FLOAT:	kpartSize = sizeof(float); break;
+	  case SM_DOUBLE:	kpartSize = sizeof(double); break;
+	  case SM_STRING:	kpartSize = kdesc->kpart[i].length; break;
+	  case SM_PAGEID:
+	  case SM_FILEID:
+	  case SM_INDEXID:	kpartSize = sizeof(PageID); break;
+	  case SM_OID:		kpartSize = sizeof(OID); break;
+	  default:		return(FALSE);
+	}
+
+	if (memcmp(&(left->kval[offset]), &(right->kval[offset]), kpartSize) != 0) return(FALSE);
+    }
+
+    if (((kdesc->kpart[i].type & SM_TYPE_MASK) != SM_VARSTRING) || (kdesc->kpart[i].type & SM_DESC))
+	return(FALSE);
+
+    memcpy(&len1, &(left->kval[offset]), sizeof(Two));
+    memcpy(&len2, &(right->kval[offset]), sizeof(Two));
+
+    for (prefixLen = 0; prefixLen < MIN(len1, len2); prefixLen++)
+	if (left->kval[offset+sizeof(Two)+prefixLen] != right->kval[offset+sizeof(Two)+prefixLen]) break;
+
+    /* 'right' is not greater than 'left'; it cannot happen in a valid page */
+    if (prefixLen == len2) return(FALSE);
+
+    newLen = prefixLen + 1;
+    if (newLen == len2) return(FALSE);	/* nothing to truncate */
+
+    memcpy(&(separator->kval[0]), &(right->kval[0]), offset);
+    memcpy(&(separator->kval[offset]), &newLen, sizeof(Two));
+    memcpy(&(separator->kval[offset+sizeof(Two)]), &(right->kval[offset+sizeof(Two)]), newLen);
+    separator->klen = offset + sizeof(Two) + newLen;
+
+    return(TRUE);
+
+} /* btm_TruncateSeparator() */
+
+
 /*
  * Function: Four btm_InsertInternal(Four, Buffer_ACC_CB*, Four, btm_InternalEntry*)
  *
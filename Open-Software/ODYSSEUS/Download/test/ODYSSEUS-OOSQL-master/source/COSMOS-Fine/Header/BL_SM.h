@@ -93,6 +93,7 @@ typedef struct {
     Four                    streamId;              /* index for the used volume on the mount table */
     Four                    btmBlkLdId;            /* index for the used volume on the mount table */
     FileID                  fid;                   /* file ID on which B+ tree index is built */
+    MLGF_KeyDesc            mlgfKdesc;             /* key descriptor of MLGF index */
 } SM_IdxBlkLdTableEntry;
 
 
@@ -124,5 +125,9 @@ Four SM_InitSortedIndexBulkLoad(Four, IndexID*, KeyDesc*, Two, Two, LockParamete
 Four SM_NextSortedIndexBulkLoad(Four, Four, KeyValue*, ObjectID*);
 Four SM_FinalSortedIndexBulkLoad(Four, Four);
 
+Four SM_InitMLGFBulkLoad(Four, VolID, MLGF_KeyDesc*);
+Four SM_NextMLGFBulkLoad(Four, Four, MLGF_HashValue[], ObjectID*, char*);
+Four SM_FinalMLGFBulkLoad(Four, Four, IndexID*, Two, Two, LockParameter*);
+
 
 #endif /* _BL_SM_H_ */
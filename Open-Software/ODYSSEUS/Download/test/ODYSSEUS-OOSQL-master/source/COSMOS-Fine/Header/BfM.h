@@ -98,6 +98,7 @@ struct _buffer_acc_cb {
     One		invalidFlag;	/* flag says caller destroyed page */
     Two         type;		/* Buffer type */
     Four    	latchFlag;      /* flag says caller got the latch on this buffer page */
+    Two		accessHint;	/* BFM_HINT_NORMAL or BFM_HINT_SEQUENTIAL */
     Buffer_ACC_CB *prev;	/* pointer to the previous block by this process */
     Buffer_ACC_CB *next;	/* pointer to the next block by this process */
 
@@ -107,6 +108,16 @@ struct _buffer_acc_cb {
 /* macro to detect a bad buffer type value */
 #define IS_BAD_BUFFERTYPE(type) (type < 0 || type >= NUM_BUF_TYPES)
 
+/* Access Hints
+ * A train accessed with BFM_HINT_SEQUENTIAL is not expected to be accessed
+ * again soon: it is read into one of the few buffers reused in turn by the
+ * thread, and the access does not give the buffer a second chance.
+ */
+#define BFM_HINT_NORMAL		0
+#define BFM_HINT_SEQUENTIAL	1
+
+#define IS_BAD_ACCESSHINT(hint) (hint != BFM_HINT_NORMAL && hint != BFM_HINT_SEQUENTIAL)
+
 /* The structure of key type used at hashing in buffer manager */
 /* same as "typedef BfMHashKey PageID; */
 typedef PageID BfMHashKey;
@@ -153,37 +164,132 @@ struct buftblentry {
     unsigned	dirtyFlag:1;	/* whether the buffer page is modified */
     unsigned 	invalidFlag:1;	/* whether the buffer page is invalid or not */
     unsigned	referFlag:1;    /* whether the buffer page is refered or not */
+    unsigned	probationFlag:1; /* BFM_POLICY_2Q: not referenced since it was read */
+    unsigned	prefetchFlag:1;	/* read ahead and not yet accessed */
     LATCH_TYPE  latch;		/* Mutex for access of buffer table entry & page */
 
     LOGICAL_PTR_TYPE(BufTBLEntry *) nextHashChain; /* next element of the hash chain */
 
+    Four        nextFree;	/* index of the next buffer in the free list of the partition */
+    One         freeListFlag;	/* whether the buffer is in the free list (protected by freeListLatch) */
+
 };
 
 
 /* The structure of HashTable which is used for searching */
+/* The version is incremented before and after the hash chain is updated,
+ * so it is odd while the chain is being updated. bfm_lookUp() traverses the
+ * chain without latch and validates the result with the version. */
 typedef struct {
     LATCH_TYPE  latch;		/* latch for access hash chain */
     LOGICAL_PTR_TYPE(BufTBLEntry *) entryPtr; /* pointer to buffer table entry */ 
+    volatile UFour version;	/* version of the hash chain */
 } bfmHashEntry;
 
+/* The latch-free lookup needs a memory barrier; it is used only if the
+ * compiler provides one. Otherwise bfm_lookUp() always gets the latch. */
+#if defined(__GNUC__) && !defined(SINGLE_USER)
+#define BFM_OPTIMISTIC_LOOKUP
+#define BFM_MEMORY_BARRIER()    __sync_synchronize()
+#define BFM_MAX_OPTIMISTIC_TRIES 3   /* # of latch-free trials before getting the latch */
+#endif
+
+/* surround an update of a hash chain; called with the latch of the hash entry */
+#ifdef BFM_OPTIMISTIC_LOOKUP
+#define BFM_BEGIN_HASHCHAIN_UPDATE(_hashEntryPtr) \
+BEGIN_MACRO \
+(_hashEntryPtr)->version++; \
+BFM_MEMORY_BARRIER(); \
+END_MACRO
+#define BFM_END_HASHCHAIN_UPDATE(_hashEntryPtr) \
+BEGIN_MACRO \
+BFM_MEMORY_BARRIER(); \
+(_hashEntryPtr)->version++; \
+END_MACRO
+#else
+#define BFM_BEGIN_HASHCHAIN_UPDATE(_hashEntryPtr)
+#define BFM_END_HASHCHAIN_UPDATE(_hashEntryPtr)
+#endif
+
+
+/* The structure of a buffer pool partition.
+ * The buffers of a buffer pool are divided into the partitions of the
+ * (almost) same size; each partition has its own clock hand and free list
+ * so that the threads allocating buffers in different partitions do not
+ * contend for the same cache line.
+ */
+typedef struct {
+    UFour       nextVictim;	/* index of NextVictim in this partition */
+    Four        firstBuf;	/* index of the first buffer of this partition */
+    Four        nBufs;		/* # of buffers in this partition */
+    LATCH_TYPE  freeListLatch;	/* latch for the free list */
+    Four        freeList;	/* index of the first free buffer (NIL if empty) */
+    char        pad[BFM_CACHE_LINE_SIZE]; /* keep the partitions on different cache lines */
+} bfm_Partition;
+
 
 /* type definition for buffer pool information */
 typedef struct {
-    Two          bufSize;	/* size of a buffer in page size */
-    Two          nBufs;		/* # of buffers in this buffer pool */
+    Eight        bufSize;	/* size of a buffer in page size */
+    Eight        nBufs;		/* # of buffers in this buffer pool */
 
     /* locking mechanism in buffer manager */
     Pool         lock_cb_pool; /* pool of lock control block */
     LOGICAL_PTR_TYPE(Lock_hashEntry *) lockHashTable; /* hash table for lock control block */ 
 
     LOGICAL_PTR_TYPE(BufTBLEntry *) bufTable; /* for */ 
-    LOGICAL_PTR_TYPE(char *) bufferPool; /* a set of buffers */
+    Eight        bufferPoolOffset; /* offset of the buffers in the buffer pool segment */
     LOGICAL_PTR_TYPE(bfmHashEntry *) hashTable;	/* hash table */
 
-    UFour        nextVictim;     /* index of NextVictim in Buffer */
+    Four         nPartitions;    /* # of partitions of the buffer pool */
+    LOGICAL_PTR_TYPE(bfm_Partition *) partitions; /* partitions, each with its clock hand */
+
+    /* background page cleaner */
+    LATCH_TYPE   cleanerLatch;   /* only one cleaner scans a buffer pool at a time */
+
+    /* statistics (updated without latch, so they are approximate) */
+    UFour        nVictims;       /* # of victims selected by bfm_allocBuffer() */
+    UFour        nDirtyVictims;  /* # of victims flushed synchronously by bfm_allocBuffer() */
+    UFour        nCleanerWrites; /* # of buffers written by the page cleaners */
+    UFour        nPrefetched;    /* # of trains read ahead into the buffer pool */
+    UFour        nPrefetchHits;  /* # of trains read ahead and accessed afterwards */
 } BufferInfo;
 
 
+/* the buffers reused in turn by the sequential accesses of a thread */
+typedef struct {
+    Four         nEntries;       /* # of buffers in the ring */
+    Four         next;           /* slot of the buffer to be reused next */
+    Four         bufIdx[BFM_RING_SIZE]; /* index of the buffer */
+    BfMHashKey   key[BFM_RING_SIZE]; /* train read into the buffer by this thread */
+} bfm_BufferRing;
+
+
+/* the sequential access detector and readahead window of a thread */
+typedef struct {
+    VolNo        volNo;          /* volume of the last sequential access */
+    Four         extSize;        /* extent size of the volume */
+    PageNo       lastPageNo;     /* train accessed last */
+    Four         nSequential;    /* # of consecutive trains accessed in order */
+    Four         window;         /* # of trains to be read ahead at a time */
+    PageNo       end;            /* first train not yet read ahead */
+    Four         nIssued;        /* # of trains read ahead since the window was adjusted */
+    Four         nHits;          /* # of them accessed by this thread */
+} bfm_ReadAhead;
+
+
+/* buffer manager statistics returned by BfM_GetStatistics() */
+typedef struct {
+    Eight        nBufs;          /* # of buffers in the buffer pool */
+    Four         nDirtyBufs;     /* # of dirty buffers at the time of the call */
+    UFour        nVictims;       /* # of victims selected by the replacement algorithm */
+    UFour        nDirtyVictims;  /* # of victims which the foreground had to flush */
+    UFour        nCleanerWrites; /* # of buffers written by the page cleaners */
+    UFour        nPrefetched;    /* # of trains read ahead into the buffer pool */
+    UFour        nPrefetchHits;  /* # of trains read ahead and accessed afterwards */
+} BfM_Statistics_T;
+
+
 /* constant definition: The BfMHashKey don't exist in the hash table. */
 #define NOTFOUND_IN_HTABLE  -1
 
@@ -235,6 +341,7 @@ typedef struct {
 
 extern BfM_SHM *bfm_shmPtr;
 extern Four procIndex;
+extern char *shm_bufferPoolPtr;		/* defined in SHM_initDS.c */
 
 /* define statement for Buffer Manager */
 
@@ -243,11 +350,29 @@ extern Four procIndex;
 #define BI_BUFTABLE(type)	 (bfm_shmPtr->bufInfo[type].bufTable)
 #define BI_BTENTRY(type, idx)    (((BufTBLEntry*)PHYSICAL_PTR(bfm_shmPtr->bufInfo[type].bufTable))[idx]) 
 
-#define BI_NEXTVICTIM(type)      (bfm_shmPtr->bufInfo[type].nextVictim)
+/* for buffer pool partitions */
+#define BI_NPARTITIONS(type)     (bfm_shmPtr->bufInfo[type].nPartitions)
+#define BI_PARTITIONS(type)      (bfm_shmPtr->bufInfo[type].partitions)
+#define BI_PARTITION(type, idx)  (((bfm_Partition*)PHYSICAL_PTR(bfm_shmPtr->bufInfo[type].partitions))[idx])
+#define BI_BUFINDEX(type, entry) ((Four)((entry) - &BI_BTENTRY(type, 0)))
+
+/* the partition used first by the calling thread */
+#define BFM_MY_PARTITION(_handle, type) ((procIndex*MAXTHREADS + (_handle)) % BI_NPARTITIONS(type))
+
+/* for background page cleaner & statistics */
+#define BI_CLEANERLATCH(type)    (bfm_shmPtr->bufInfo[type].cleanerLatch)
+#define BI_NVICTIMS(type)        (bfm_shmPtr->bufInfo[type].nVictims)
+#define BI_NDIRTYVICTIMS(type)   (bfm_shmPtr->bufInfo[type].nDirtyVictims)
+#define BI_NCLEANERWRITES(type)  (bfm_shmPtr->bufInfo[type].nCleanerWrites)
+#define BI_NPREFETCHED(type)     (bfm_shmPtr->bufInfo[type].nPrefetched)
+#define BI_NPREFETCHHITS(type)   (bfm_shmPtr->bufInfo[type].nPrefetchHits)
 
 /* for buffer pool */
-#define BI_BUFFERPOOL(type)	 (bfm_shmPtr->bufInfo[type].bufferPool)
-#define BI_BUFFER(type, entry)	 ( (char*)PHYSICAL_PTR(BI_BUFFERPOOL(type)) + BI_BUFSIZE(type)*PAGESIZE*(entry-&BI_BTENTRY(type,0))) 
+/* The buffers are not in the shared heap but in the buffer pool segment,
+ * which may be attached at a different address in each process. */
+#define BI_BUFFERPOOLOFFSET(type) (bfm_shmPtr->bufInfo[type].bufferPoolOffset)
+#define BI_BUFFERPOOL(type)	 (shm_bufferPoolPtr + BI_BUFFERPOOLOFFSET(type))
+#define BI_BUFFER(type, entry)	 ( BI_BUFFERPOOL(type) + BI_BUFSIZE(type)*PAGESIZE*(Eight)(entry-&BI_BTENTRY(type,0))) 
 
 /* for buffer hash table */
 #define BI_HASHTABLE(type)	 (bfm_shmPtr->bufInfo[type].hashTable)
@@ -271,15 +396,23 @@ extern Four procIndex;
 /*
  * Function Prototypes
  */
+Four bfm_addFreeBuffer(Four, BufTBLEntry *, Four);
 Four bfm_allocBuffer(Four, Four, BufTBLEntry **);
+Four bfm_allocRingBuffer(Four, TrainID *, Four, BufTBLEntry **);
+Four bfm_cleanBuffers(Four, Four);
 Four bfm_delete(Four, BufTBLEntry *, Four);
 Four bfm_finalBufferInfo(Four, Four);
+Four bfm_finalPartitions(Four, Four);
 Four bfm_flushBuffer(Four, BufTBLEntry *, Four);
-Four bfm_initBufferInfo(Four, Four, Four, Four);
+Four bfm_getFreeBuffer(Four, Four, Four, BufTBLEntry **);
+Four bfm_initBufferInfo(Four, Four, Four, Eight);
 Four bfm_initBufferHashTable(Four, Four);
 Four bfm_initLockHashTable(Four, Four);
+Four bfm_initPartitions(Four, Four, Four);
 Four bfm_insert(Four, BfMHashKey *, BufTBLEntry *, Four);
 Four bfm_lookUp(Four, BfMHashKey *, Four, BufTBLEntry **);
+Four bfm_prefetchTrains(Four, PageID *, Four, Four);
+Four bfm_readAhead(Four, TrainID *, Four);
 Four bfm_readBuffer(Four, TrainID *, char *, Four);
 void bfm_dump_buffertable(Four, Four);
 void bfm_dump_hashtable(Four, Four);
@@ -292,14 +425,24 @@ Four BfM_FlushTrain(Four, TrainID*, Four);
 Four BfM_unfixBuffer(Four, Buffer_ACC_CB *, Four);
 Four BfM_unfixMyBACB(Four);
 Four BfM_getAndFixBuffer(Four, TrainID *, Four, Buffer_ACC_CB **, Four);
+Four BfM_getAndFixBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB **, Four, Four);
 Four BfM_fixNewBuffer(Four, TrainID *, Four, Buffer_ACC_CB **, Four);
+Four BfM_fixNewBufferWithHint(Four, TrainID *, Four, Buffer_ACC_CB **, Four, Four);
 Four BfM_initSharedDS(Four);	
 Four BfM_initLocalDS(Four);
 Four BfM_UpdateDirtyPageTableEntries(Four); 
-Four BfM_LogDirtyPageTableEntries(Four);
+Four BfM_LogDirtyPageTableEntries(Four, Lsn_T *);
 Four BfM_readTrain(Four, TrainID *, char *, Four); 
 Four BfM_RemoveLogPages(Four);
 Four BfM_RemoveTrain(Four, TrainID*, Four, Boolean); 
+Four BfM_StartCleaners(Four);
+Four BfM_StopCleaners(Four);
+Four BfM_NumCleaners(void);
+Four BfM_GetStatistics(Four, Four, BfM_Statistics_T*);
+Four BfM_StartPrefetchers(Four);
+Four BfM_StopPrefetchers(Four);
+Four BfM_NumPrefetchers(void);
+Four BfM_PrefetchTrains(Four, PageID *, Four, Four);
 
 /* reduce # of useless function call request in COSMOS-CC/SINGLE */
 #ifndef SINGLE_USER
@@ -96,6 +96,24 @@
 #define GREAT 1
 #define LESS  2
 
+/*
+ * Key comparison function
+ * btm_GetKeyCompareFunc() returns a function specialized for the key
+ * descriptor, or btm_KeyCompare() when there is no specialized one.
+ */
+typedef Four (*btm_KeyCompareFunc)(Four, KeyDesc*, KeyValue*, KeyValue*);
+
+/*
+ * Key compare routine recorded in a key descriptor
+ * BtM_SetKeyCompareFunc() records the number of the chosen routine in the
+ * spare bits of the flag of the key descriptor kept by an open index scan,
+ * so that the routine is not chosen again on every search. 0 means that no
+ * routine is recorded. The key descriptors in the catalog and in the log
+ * records never have these bits set.
+ */
+#define KEYFLAG_COMPARE_MASK	0x0f00
+#define KEYFLAG_COMPARE_SHIFT	8
+
 /*
  * Btree Operations
  */
@@ -485,6 +503,10 @@ Boolean btm_BinarySearchOidArray(Four, ObjectID[], ObjectID*, Four, Four*);
 void btm_CompactInternalPage(Four, BtreeInternal*, Four);
 void btm_CompactLeafPage(Four, BtreeLeaf*, Four);
 Four btm_KeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
+btm_KeyCompareFunc btm_GetKeyCompareFunc(KeyDesc*);
+Four btm_ChooseKeyCompareFunc(KeyDesc*);
+Four btm_IntKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
+Four btm_LongLongKeyCompare(Four, KeyDesc*, KeyValue*, KeyValue*);
 Four btm_ObjectIdComp(Four, ObjectID*, ObjectID*);
 Four btm_DeleteLeaf(Four, XactTableEntry_T*, BtreeIndexInfo*, FileID*, btm_TraversePath*, PageID*, KeyDesc*, KeyValue*, ObjectID*, LockParameter*, LogParameter_T*);
 Four btm_DeleteLeafPage(Four, XactTableEntry_T*, BtreeIndexInfo*, Buffer_ACC_CB*, Buffer_ACC_CB*, Buffer_ACC_CB*, LogParameter_T*);
@@ -553,6 +575,7 @@ Four BtM_GetStatistics_BtreePageInfo(Four, PageID*, Four, Four*, sm_PageInfo*, L
 Four BtM_GetTreeLatchPtrFromIndexId(Four, IndexID*, LATCH_TYPE**);
 Four BtM_ReleaseTreeLatchPtr(Four, IndexID*);
 Four BtM_ReleaseAllTreeLatchPtr(Four);
+void BtM_SetKeyCompareFunc(KeyDesc*);
 
 Four btm_GetSegmentIDFromIndexInfo(Four, XactTableEntry_T*, BtreeIndexInfo*, SegmentID_T*, Four);
 
@@ -84,6 +84,15 @@
 #define	MAXLOCKHASHENTRY	(MAXLOCKBUCKET*2)+3
 #define MAXXACTHASHENTRY	(MAXXACTBUCKET*2)+3
 
+/*
+ * The lock table is partitioned by the lock hash value. Each partition has
+ * its own lock bucket and request node pools, which start with a subpool of
+ * the following size and grow by a subpool on demand.
+ */
+#define LM_NUM_PARTITIONS		16
+#define LM_LOCKBUCKET_SUBPOOL_SIZE	(MAXLOCKBUCKET/LM_NUM_PARTITIONS)
+#define LM_REQUESTNODE_SUBPOOL_SIZE	(MAXREQUESTNODE/LM_NUM_PARTITIONS)
+
 
 #define N_LEVEL 		6        /* L_OBJECT/L_FLAT/L_FILE/L_PAGE/L_KEYVALUE */ 
 
@@ -127,6 +136,8 @@ struct rnode {
     LOGICAL_PTR_TYPE(RequestNode_Type *) higherRequestNode; /* higher requestNode pointer */ 
     LOGICAL_PTR_TYPE(XactBucket_Type *)  xactBucketPtr;	/* the transaction bucket pointer */
 
+    Four		partitionNo;	/* lock table partition whose pool has this node */
+
 };
 
 
@@ -154,6 +165,8 @@ struct lbucket {
     LOGICAL_PTR_TYPE(LockBucket_Type *) prev; /* previous lock bucket pointer */ 
     LOGICAL_PTR_TYPE(LockBucket_Type *) next; /* next lock bucket pointer */ 
 
+    Four		partitionNo;	/* lock table partition of this bucket */
+
 };
 
 
@@ -185,24 +198,34 @@ struct xbucket {
 
     LOGICAL_PTR_TYPE(XactBucket_Type *) prev; /* previous transaction bucket pointer */
     LOGICAL_PTR_TYPE(XactBucket_Type *) next; /* next transaction bucket pointer*/
-
-#ifndef WFG
-    /* Waits for Graph(WFG) for deadlock detection */
-    /* binary tree representation of trees */
-
-    LOGICAL_PTR_TYPE(XactBucket_Type *) waitingfor; /* this transaction is waiting for waitingfor transaction */
-    Four                                deadlockVisit;  /* deadlock detection flag */
-#endif
 };
 
-/* Stack type to detect deadlock */
+/*
+ * Waits-for graph for deadlock detection
+ * The graph is a snapshot of the lock table taken in the local memory; a node
+ * is a waiting request and an edge points to a transaction blocking it.
+ */
 typedef struct {
-    XactBucket_Type 	*xactBucket;   	/* transaction bucket pointer */
-    Four            	cost;           /* the cost for aborting this transaction */
-} lm_DeadlockStackEntry;
+    XactID		xactID;		/* waiting transaction */
+    LockLevel		level;		/* level of the lock waited for */
+    TargetID		target;		/* the lock waited for */
+    Four		hashValue;	/* lock hash table entry of the lock */
+    Four		cost;		/* the cost for aborting this transaction */
+    Four		firstEdge;	/* index of the first outgoing edge */
+    Four		nEdges;		/* # of outgoing edges */
+    Four		nextEdge;	/* next edge to follow in the depth-first search */
+    Four		state;		/* LM_WFG_NEW, LM_WFG_ONSTACK, ... */
+} lm_WFGNode;
 
-#define MAXDEADLOCKCHAIN 	TOTALTHREADS 
-#define INITDEADLOCKSTACKTOP 	0
+typedef struct {
+    XactID		xactID;		/* blocking transaction */
+    Four		to;		/* index of its node; NIL if it is not waiting */
+} lm_WFGEdge;
+
+#define LM_WFG_NEW		0
+#define LM_WFG_ONSTACK		1
+#define LM_WFG_DONE		2
+#define LM_WFG_REMOVED		3	/* chosen as a victim in this detection */
 
 /* macro for deadlock detection */
 #define NUMOFGETLOCK(p) ((p)->nLock[L_FLAT_PAGE] + (p)->nLock[L_FLAT_OBJECT] + (p)->nLock[L_FILE] + (p)->nLock[L_PAGE] + (p)->nLock[L_KEYVALUE]- \
@@ -222,19 +245,29 @@ struct xacthashentry {
 
 
 /*** BEGIN_OF_SHM_RELATED_AREA ***/
+/*
+ * Lock table partition
+ * A lock hash table entry i belongs to the partition (i % LM_NUM_PARTITIONS),
+ * and the lock buckets and the request nodes of the locks hashed to the entry
+ * are allocated from the pools of the partition.
+ */
+typedef struct {
+    Pool      		requestNodePool; 		 /* request node pool */
+    Pool      		lockBucketPool; 		 /* lock bucket pool */
+} LM_Partition_T;
+
 /*
  * Shared Memory Structure
  */
 typedef struct {
 
     /* Per lock object information */
-    LATCH_TYPE    	lmLatch;
+    LATCH_TYPE    	lmLatch;			 /* serializes the deadlock detection */
 
     LATCH_TYPE    	maxLockOnFileLatch;
     Four          	maxLockOnFile;
 
-    Pool      		requestNodePool; 		 /* request node pool */
-    Pool      		lockBucketPool; 		 /* lock bucket pool */
+    LM_Partition_T 	partition[LM_NUM_PARTITIONS]; 	 /* lock table partitions */
     LockHashEntry 	lockHashTable[MAXLOCKHASHENTRY]; /* lock hash table */
 
     /* Per transaction information */
@@ -249,9 +282,10 @@ extern Four procIndex;
 
 #define LM_XACTHASHTABLE    		lm_shmPtr->xactHashTable
 #define LM_LOCKHASHTABLE    		lm_shmPtr->lockHashTable
-#define LM_LOCKBUCKETPOOL   		lm_shmPtr->lockBucketPool
+#define LM_PARTITION_OF_HASHVALUE(_v)	((_v) % LM_NUM_PARTITIONS)
+#define LM_LOCKBUCKETPOOL(_p)   	lm_shmPtr->partition[_p].lockBucketPool
 #define LM_XACTBUCKETPOOL   		lm_shmPtr->xactBucketPool
-#define LM_REQUESTNODEPOOL  		lm_shmPtr->requestNodePool
+#define LM_REQUESTNODEPOOL(_p)  	lm_shmPtr->partition[_p].requestNodePool
 #define LM_LATCH                	lm_shmPtr->lmLatch
 #define LM_MAX_LOCKS_ON_FILE_LATCH   	lm_shmPtr->maxLockOnFileLatch 
 #define LM_MAX_LOCKS_ON_FILE    	lm_shmPtr->maxLockOnFile
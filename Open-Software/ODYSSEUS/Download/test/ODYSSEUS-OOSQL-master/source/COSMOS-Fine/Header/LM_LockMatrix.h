@@ -78,7 +78,14 @@
 #define OK		1
 #define NONEED		2
 
-static Two_Invariable LOCK_conversion[MAXLOCKMODES][MAXLOCKMODES]= {
+/* the tables below are used by some of the files including this header only */
+#ifdef __GNUC__
+#define LM_MATRIX_UNUSED	__attribute__((unused))
+#else
+#define LM_MATRIX_UNUSED
+#endif
+
+static Two_Invariable LM_MATRIX_UNUSED LOCK_conversion[MAXLOCKMODES][MAXLOCKMODES]= {
   { L_NL,  L_IS,  L_IX,  L_S,   L_SIX, L_X },
   { L_IS,  L_IS,  L_IX,  L_S,   L_SIX, L_X },
   { L_IX,  L_IX,  L_IX,  L_SIX, L_SIX, L_X },
@@ -87,7 +94,7 @@ static Two_Invariable LOCK_conversion[MAXLOCKMODES][MAXLOCKMODES]= {
   { L_X,   L_X,   L_X,   L_X,   L_X,   L_X }
 };
 
-static Two_Invariable LOCK_compatible[MAXLOCKMODES][MAXLOCKMODES]= {
+static Two_Invariable LM_MATRIX_UNUSED LOCK_compatible[MAXLOCKMODES][MAXLOCKMODES]= {
   { OK,  OK,    OK,    OK,    OK,    OK    },
   { OK,  OK,    OK,    OK,    OK,    NOTOK },
   { OK,  OK,    OK,    NOTOK, NOTOK, NOTOK },
@@ -96,7 +103,7 @@ static Two_Invariable LOCK_compatible[MAXLOCKMODES][MAXLOCKMODES]= {
   { OK,  NOTOK, NOTOK, NOTOK, NOTOK, NOTOK }
 };
 
-static Two_Invariable LOCK_supreme[MAXLOCKMODES][MAXLOCKMODES] = {
+static Two_Invariable LM_MATRIX_UNUSED LOCK_supreme[MAXLOCKMODES][MAXLOCKMODES] = {
   { L_NL,  L_IS,  L_IX,  L_S,   L_SIX, L_X },
   { L_IS,  L_IS,  L_IX,  L_S,   L_SIX, L_X },
   { L_IX,  L_IX,  L_IX,  L_SIX, L_SIX, L_X },
@@ -105,7 +112,7 @@ static Two_Invariable LOCK_supreme[MAXLOCKMODES][MAXLOCKMODES] = {
   { L_X,   L_X,   L_X,   L_X,   L_X,   L_X }
 };
 
-static Two_Invariable LOCK_super[MAXLOCKMODES] = { L_NL,   L_S,   L_X,   L_S,   L_X,   L_X };
+static Two_Invariable LM_MATRIX_UNUSED LOCK_super[MAXLOCKMODES] = { L_NL,   L_S,   L_X,   L_S,   L_X,   L_X };
 
 /* table for rule of lock hierachy */
 /* left side is parent level and right side is child level */
@@ -113,7 +120,7 @@ static Two_Invariable LOCK_super[MAXLOCKMODES] = { L_NL,   L_S,   L_X,   L_S,
 /* OK     :: child lock request matches lock request rule */
 /* NONEED :: parent lock implicitly sets on its descendants */
 
-static Two_Invariable LOCK_hierarchy[MAXLOCKMODES][MAXLOCKMODES] = {
+static Two_Invariable LM_MATRIX_UNUSED LOCK_hierarchy[MAXLOCKMODES][MAXLOCKMODES] = {
   { NOTOK, NOTOK,  NOTOK,  NOTOK,  NOTOK,  NOTOK },
   { OK,    OK,     NOTOK,  OK,     NOTOK,  NOTOK },
   { OK,    OK,     OK,     OK,     OK,     OK },
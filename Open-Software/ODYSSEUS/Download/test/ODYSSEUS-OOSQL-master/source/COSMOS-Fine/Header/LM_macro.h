@@ -184,7 +184,6 @@
 	(x)->ccLevel = (cc);\
 	(x)->maxLowLocks = 0;\
 	(x)->waitingLock = LOGICAL_PTR(NULL);\
-	(x)->waitingfor = LOGICAL_PTR(NULL);\
 	for (i =0; i < N_LEVEL; i++) {\
 	    (x)->nLock[i] = 0;\
 	    (x)->nUnlock[i] = 0;\
@@ -196,9 +195,10 @@
         e = Util_freeElementToPool(_handle, &LM_XACTBUCKETPOOL, (x));\
         if ( e < 0 ) ERR(_handle, e);
 
-#define GET_NEWREQUESTNODE(_handle, p, xid, m, dur, st, xbucket, _e) \
-	(_e) = Util_getElementFromPool(_handle, &LM_REQUESTNODEPOOL, &(p));\
+#define GET_NEWREQUESTNODE(_handle, p, part, xid, m, dur, st, xbucket, _e) \
+	(_e) = Util_getElementFromPool(_handle, &LM_REQUESTNODEPOOL(part), &(p));\
 	if ( (_e) >= 0 ){ \
+	   (p)->partitionNo = (part);\
 	   ASSIGN_XACTID((p)->xactID, *(xid));\
 	   (p)->counter = 1; \
       	   (p)->mode = (m); \
@@ -213,8 +213,14 @@
 	}
 
 #define FREE_REQUESTNODE(_handle, p)\
-        e = Util_freeElementToPool(_handle, &LM_REQUESTNODEPOOL, (p));\
-        if ( e < eNOERROR ) ERRL1(_handle, e, &LM_LATCH);
+        e = Util_freeElementToPool(_handle, &LM_REQUESTNODEPOOL((p)->partitionNo), (p));\
+        if ( e < eNOERROR ) ERR(_handle, e);
+
+#define CHECK_LOCKBUCKETPOOLS(_handle, _e) \
+	{   Four _p; \
+	    for (_p = 0; _p < LM_NUM_PARTITIONS; _p++) \
+		(_e) = Util_checkPool(_handle, &LM_LOCKBUCKETPOOL(_p)); \
+	}
 
 #define SEARCH_FILELOCKBUCKET(link, fid, locate)\
 	(locate) = NULL;\
@@ -256,25 +262,19 @@
 	while ( nodeptr && !EQUAL_OBJECTID(((LockBucket_Type*)PHYSICAL_PTR(nodeptr->lockHDR))->target.objectID, *targetID) )\
 	nodeptr = PHYSICAL_PTR(nodeptr->nextGrantedEntry);
 
-#define INSTANT_DURATION_HANDLING(_handle, latch, lm_latch, lockCounter, reply) \
+#define INSTANT_DURATION_HANDLING(_handle, latch, lockCounter, reply) \
 	{\
 	    e = SHM_releaseLatch(_handle, &latch, procIndex);\
-	    if (e < 0) ERRL1(_handle, e, &lm_latch);\
-	    (lockCounter)++;\
-	    \
-	    e = SHM_releaseLatch(_handle, &lm_latch, procIndex);\
 	    if (e < 0) ERR(_handle, e);\
+	    (lockCounter)++;\
 	    \
 	    (reply) = (LockReply)mode;\
 	    return(eNOERROR);\
 	}
 
-#define CONDITIONAL_LOCK_HANDLING(_handle, latch, lm_latch, reply) \
+#define CONDITIONAL_LOCK_HANDLING(_handle, latch, reply) \
 	{\
 	    e = SHM_releaseLatch(_handle, &latch, procIndex);\
-	    if (e < 0) ERRL1(_handle, e, &lm_latch);\
-	    \
-	    e = SHM_releaseLatch(_handle, &lm_latch, procIndex);\
 	    if (e < 0) ERR(_handle, e);\
 	    \
 	    (reply) = LR_NOTOK;\
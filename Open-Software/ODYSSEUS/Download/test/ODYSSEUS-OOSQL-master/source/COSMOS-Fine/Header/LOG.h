@@ -556,6 +556,10 @@ END_MACRO
 #define LOG_GET_DISTANCE_BTW_PAGES(w1,p1,w2,p2) \
  (((w1) - (w2))*(LOG_LOGMASTER.numPages) + (p1) - (p2))
 
+/* # of log bytes from lsn l2 to lsn l1 */
+#define LOG_GET_DISTANCE_BTW_LSNS(l1,l2) \
+ (((Eight)(l1).wrapCount - (Eight)(l2).wrapCount)*(LOG_LOGMASTER.numBytes) + (Eight)(l1).offset - (Eight)(l2).offset)
+
 #define LOG_GET_PHYSICAL_PAGENO(_logMaster, _wrapCount, _pageNo) \
  ( (_pageNo) + (_logMaster).firstPageNoOfFirstLogFile + (((_wrapCount) % (_logMaster).nLogFiles) * (_logMaster).numPages) )
 
@@ -569,6 +573,20 @@ END_MACRO
 
 
 
+/* log manager statistics returned by LOG_GetStatistics() */
+typedef struct {
+    UFour        nGroupCommits;  /* # of log flushes done for committing transactions */
+    UFour        nGroupedXacts;  /* # of commits served by those log flushes */
+    Four         maxGroupSize;   /* the largest # of commits served by one log flush */
+    Lsn_T        flushedLsn;     /* the log is durable up to this lsn */
+    Lsn_T        nextLsn;        /* lsn of the log record to be written next */
+    Lsn_T        checkpointLsn;  /* lsn of the recent checkpoint */
+    Lsn_T        redoLsn;        /* where the restart would begin the redo pass */
+    Eight        redoDistance;   /* # of log bytes from redoLsn to nextLsn */
+} LOG_Statistics_T;
+
+
+
 /*-------------------- BEGIN OF Shared Memory Section -----------------------*/
 /*
  * Shared Memory Data Structures
@@ -576,6 +594,7 @@ END_MACRO
 typedef struct LOG_LogBufferTableEntry_T_tag {
     Four pageNo;                /* page number of the page whose contents are in the buffer page */
     Four wrapCount;             /* wrapcount of the page whose contents are in the buffer page */
+    Four nPending;              /* # of bytes reserved in the buffer page but not copied yet */
 } LOG_LogBufferTableEntry_T;
 
 typedef struct LOG_LogBufferInfo_T_tag {
@@ -584,16 +603,34 @@ typedef struct LOG_LogBufferInfo_T_tag {
 } LOG_LogBufferInfo_T;
 
 
+/* queue of the committers waiting for their commit log records to be flushed */
+typedef struct log_CommitQueue_T_tag {
+    Four  nWaiters;             /* # of committers queued for the next log flush */
+    UFour groupNo;              /* incremented whenever a leader takes the queued committers */
+    Lsn_T maxLsn;               /* the last log record requested by the queued committers */
+    Four  maxLsnLength;         /* length of that log record */
+    UFour nGroups;              /* # of log flushes done for the committers */
+    UFour nGroupedXacts;        /* # of committers served by those log flushes */
+    Four  maxGroupSize;         /* the largest # of committers served by one log flush */
+} log_CommitQueue_T;
+
 typedef struct {
 
     LATCH_TYPE 			latch_logHead;
     LATCH_TYPE 			latch_logTail;
     LATCH_TYPE 			latch_logFileSwitch;
+    LATCH_TYPE 			latch_groupCommit;	/* held by the group commit leader */
+    LATCH_TYPE 			latch_commitQueue;	/* protects commitQueue */
 
     log_LogPage_T 		logBufferPage[NUM_WRITE_LOG_BUFS];
     LOG_LogBufferTableEntry_T 	logBufferTable[NUM_WRITE_LOG_BUFS];
     LOG_LogBufferInfo_T 	logBufferInfo;
     LOG_LogMaster_T 		logMaster;
+    Lsn_T 			flushedLsn;	/* the log is durable up to (but not including) this lsn */
+    Lsn_T 			redoLsn;	/* redo point of the recent checkpoint */
+    log_CommitQueue_T 		commitQueue;
+    UEight 			reserveWord;	/* log space open for reservation without the latch */
+    Four 			reserveBase;	/* offset in the head page where the space was opened */
 
 } LOG_SHM;
 
@@ -607,19 +644,63 @@ extern Four procIndex;
 #define LOG_LATCH4HEAD       		(log_shmPtr->latch_logHead)
 #define LOG_LATCH4TAIL       		(log_shmPtr->latch_logTail)
 #define LOG_LATCH4LOGFILESWITCH    	(log_shmPtr->latch_logFileSwitch)
+#define LOG_LATCH4GROUPCOMMIT    	(log_shmPtr->latch_groupCommit)
+#define LOG_LATCH4COMMITQUEUE    	(log_shmPtr->latch_commitQueue)
 
 #define	LOG_LBI_TAIL			(log_shmPtr->logBufferInfo.tail)
 #define	LOG_LBI_HEAD			(log_shmPtr->logBufferInfo.head)
 
 #define	LOG_LBT_PAGENO(_index)		(log_shmPtr->logBufferTable[_index].pageNo)
 #define	LOG_LBT_WRAPCOUNT(_index)	(log_shmPtr->logBufferTable[_index].wrapCount)
+#define	LOG_LBT_NPENDING(_index)	(log_shmPtr->logBufferTable[_index].nPending)	/* updated atomically */
 
 #define LOG_LOGMASTER	        	(log_shmPtr->logMaster)
 #define LOG_LOGBUFFERPAGE		(log_shmPtr->logBufferPage)
+#define LOG_FLUSHEDLSN			(log_shmPtr->flushedLsn)	/* protected by LOG_LATCH4TAIL */
+#define LOG_REDOLSN			(log_shmPtr->redoLsn)		/* protected by LOG_LATCH4HEAD */
+#define LOG_COMMITQUEUE			(log_shmPtr->commitQueue)	/* protected by LOG_LATCH4COMMITQUEUE */
+#define LOG_RESERVEWORD			(log_shmPtr->reserveWord)	/* updated atomically */
+#define LOG_RESERVEBASE			(log_shmPtr->reserveBase)	/* protected by LOG_LATCH4HEAD */
+
+/*
+ * LOG_RESERVEWORD (see log_WriteLogRecord.c)
+ * bits  0-15 : offset in the head page where the next log record begins
+ * bits 16-31 : the largest offset the log records may end at
+ * bits 32-39 : index of the head page in the log buffer pool
+ * bits 40-62 : generation, increased whenever the word is opened
+ * bit  63    : set if the word is closed
+ */
+#define LOG_RW_CLOSED			((UEight)1 << 63)
+#define LOG_RW_OFFSET(_w)		((Four)((_w) & 0xFFFF))
+#define LOG_RW_LIMIT(_w)		((Four)(((_w) >> 16) & 0xFFFF))
+#define LOG_RW_BUFIDX(_w)		((Four)(((_w) >> 32) & 0xFF))
+#define LOG_RW_GENERATION(_w)		(((_w) >> 40) & 0x7FFFFF)
+#define LOG_RW_MAKE(_gen,_bufIdx,_limit,_offset) \
+    ((((UEight)(_gen) & 0x7FFFFF) << 40) | ((UEight)(_bufIdx) << 32) | ((UEight)(_limit) << 16) | (UEight)(_offset))
+
+/* close the word with no space reserved; the latch holder sets nextLsn */
+#define LOG_RESET_RESERVEWORD() \
+BEGIN_MACRO \
+    LOG_RESERVEWORD = LOG_RW_CLOSED; \
+    LOG_RESERVEBASE = 0; \
+END_MACRO
 
 /*-------------------- END OF Shared Memory Section -------------------------*/
 
 
+/*
+ * log space reserved for a log record by log_ReserveLogSpace()
+ * The space begins at 'offsetInPage' of the buffer page 'bufIdx' and
+ * continues on the following buffer pages.
+ */
+typedef struct log_LogSpace_T_tag {
+    Four bufIdx;                /* log buffer page where the space begins */
+    Four offsetInPage;          /* offset of the space in that page */
+    Four skip;                  /* # of bytes of the log record already copied */
+    Four length;                /* # of bytes of the space */
+} log_LogSpace_T;
+
+
 
 extern LOG_LogRecTableEntry_T LOG_logRecTbl[];
 
@@ -632,12 +713,18 @@ Four log_AllocLogBuffer(Four, Four, Four);
 Four log_AllocPage(Four, Four*, Four*);
 Four log_BufFinal(Four);
 Four log_BufInit(Four);
+Four log_CloseLogSpace(Four);
+Four log_CopyLogRecord(Four, LOG_LogRecInfo_T*, log_LogSpace_T*);
 Four log_FlushLogBuffers(Four, Four, Boolean);
 Four log_GetAndFixBuffer(Four, Four, Four, log_LogPage_T**);
 Four log_GetLogRecordLength(Four, LOG_LogRecInfo_T*);
+Four log_GetNextLsn(Four, Lsn_T*);
+Four log_OpenLogSpace(Four);
 Four log_ReadLogRecord(Four, Lsn_T*, LOG_LogRecInfo_T*);
+Four log_ReserveLogSpace(Four, LOG_LogRecInfo_T*, Four, log_LogSpace_T*);
+Four log_SettleLogSpace(Four);
+Boolean log_TryReserveLogSpace(Four, Four, Lsn_T*, log_LogSpace_T*);
 Four log_UnfixBuffer(Four);
-Four log_WriteLogRecord(Four, LOG_LogRecInfo_T*);
 
 
 /*
@@ -646,6 +733,8 @@ Four log_WriteLogRecord(Four, LOG_LogRecInfo_T*);
 Four LOG_CloseScan(Four);
 Four LOG_GetCheckpointLsn(Four, Lsn_T*);
 Four LOG_GetNextLogRecordLsn(Four, Lsn_T*);
+Four LOG_GetStatistics(Four, LOG_Statistics_T*);
+Four LOG_GroupCommit(Four, Lsn_T*, Four);
 Four LOG_FlushLogRecords(Four, Lsn_T*, Four);
 Four LOG_InitLocalDS(Four);
 Four LOG_InitSharedDS(Four);
@@ -656,7 +745,7 @@ Four LOG_NextRecord(Four, Lsn_T*, LOG_LogRecInfo_T*, Four*);
 Four LOG_OpenScan(Four, Lsn_T*);
 Four LOG_OpenVolume(Four, Four);
 Four LOG_ReadLogRecord(Four, Lsn_T*, LOG_LogRecInfo_T*, Four*);
-Four LOG_SetCheckpointLsn(Four, Lsn_T*);
+Four LOG_SetCheckpointLsn(Four, Lsn_T*, Lsn_T*);
 Four LOG_SetNextLogRecordLsn(Four, Lsn_T*);
 Four LOG_SwitchLogFile(Four, Four); 
 Four LOG_WriteLogRecord(Four, XactTableEntry_T*, LOG_LogRecInfo_T*, Lsn_T*, Four*);
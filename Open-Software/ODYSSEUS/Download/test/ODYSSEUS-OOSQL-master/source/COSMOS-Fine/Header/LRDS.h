@@ -902,6 +902,7 @@ Four LRDS_Text_DeleteKeywords(Four, Four, Boolean, TupleID*, Four, Four, char*);
 Four LRDS_Text_GetIndexID(Four, Four, Four, IndexID*);
 Four LRDS_MLGF_OpenIndexScan(Four, Four, IndexID*, MLGF_HashValue[], MLGF_HashValue[], Four, BoolExp[], LockParameter*);
 Four LRDS_MLGF_SearchNearTuple(Four, Four, IndexID*, MLGF_HashValue[], TupleID*, LockParameter*);
+Four LRDS_MLGF_OpenNearestTupleScan(Four, Four, IndexID*, MLGF_HashValue[], MLGF_HashToCoordFunc, Four, BoolExp[], LockParameter*);
 Four LRDS_InitLocalDS(Four);
 Four LRDS_InitSharedDS(Four);
 Four LRDS_FinalLocalDS(Four);
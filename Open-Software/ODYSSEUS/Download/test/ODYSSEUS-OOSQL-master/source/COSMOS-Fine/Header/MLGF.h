@@ -389,6 +389,62 @@ END_MACRO
 #define MLGF_CURSOR_PATH_READ_TOP(cursor, pid) \
 pid = MLGF_CURSOR_PATH_PID(&(cursor)->path, (cursor)->pathTop)
 
+
+/*
+ * Type Definition for mlgf_NearestElem
+ *  element of the priority queue of a nearest-neighbour scan
+ */
+#define MLGF_NEAREST_PAGE     0		/* directory or leaf page to be expanded */
+#define MLGF_NEAREST_OVERFLOW 1		/* overflow chain of a leaf entry */
+#define MLGF_NEAREST_OBJECT   2		/* object to be returned */
+
+typedef struct {
+    double         dist;		/* lower bound of the distance to the query point */
+    One            type;		/* MLGF_NEAREST_PAGE/OVERFLOW/OBJECT */
+    LockMode       kLockMode;		/* key range lock mode of the page to expand */
+    PageID         pid;			/* page to expand, or leaf page of the object */
+    PageID         overflow;		/* overflow page to expand or holding the object */
+    ObjectID       oid;			/* ObjectID of the object */
+    MLGF_HashValue keys[MLGF_MAXNUM_KEYS]; /* keys of the object */
+    char           data[MLGF_MAXLEN_EXTRADATA]; /* extra data of the object */
+} mlgf_NearestElem;
+
+#define MLGF_NEAREST_ELEM(queue, i) (((mlgf_NearestElem*)((queue)->heap.ptr))[i])
+#define MLGF_NEAREST_QUEUE_INIT_SIZE 64
+
+/*
+ * Type Definitions for the spatial join of two MLGF indexes
+ */
+typedef struct {
+    PageID         pid[2];		/* a page of each index */
+    MLGF_HashValue min[2][MLGF_MAXNUM_KEYS]; /* regions of the pages */
+    MLGF_HashValue max[2][MLGF_MAXNUM_KEYS];
+} mlgf_JoinPagePair;
+
+typedef struct {
+    ObjectID       oid;			/* ObjectID of the object */
+    MLGF_HashValue keys[MLGF_MAXNUM_KEYS]; /* keys of the object */
+} mlgf_JoinObject;
+
+typedef struct {
+    ObjectID       oid[2];		/* an object of each index */
+} mlgf_JoinObjectPair;
+
+#define MLGF_JOIN_PAGEPAIR(join, i) (((mlgf_JoinPagePair*)((join)->pagePairs.ptr))[i])
+#define MLGF_JOIN_OBJECTPAIR(join, i) (((mlgf_JoinObjectPair*)((join)->objectPairs.ptr))[i])
+#define MLGF_JOIN_OBJECT(join, side, i) (((mlgf_JoinObject*)((join)->objects[side].ptr))[i])
+#define MLGF_JOIN_INIT_SIZE 64
+
+/*
+ * Sort stream tuple of MLGF_BulkLoad()
+ *  Morton value of the keys as big-endian bytes (sort key), ObjectID (sort key),
+ *  keys, and extra data
+ */
+#define MLGF_BLKLD_SORTKEY_LEN(_nKeys) (sizeof(MortonValue)*(_nKeys))
+#define MLGF_BLKLD_MAXTUPLE_LEN \
+(MLGF_BLKLD_SORTKEY_LEN(MLGF_MAXNUM_KEYS) + sizeof(ObjectID) + \
+ sizeof(MLGF_HashValue)*MLGF_MAXNUM_KEYS + MLGF_MAXLEN_EXTRADATA)
+
 /* Stack type to represent a MLGF internal node for tree protocol */
 typedef struct {
     PageID pid;                  /* PageID of this MLGF internal page*/
@@ -602,14 +658,21 @@ Four mlgf_GetSegmentIDFromIndexInfo(Four, XactTableEntry_T*, MLGFIndexInfo*, Seg
 
 
 /* MLGF Interface Function Prototypes */
+Four MLGF_BulkLoad(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, PageID*, Four, Two, Two, LogParameter_T*);
 Four MLGF_CreateIndex(Four, XactTableEntry_T*, IndexID*, MLGF_KeyDesc*, PageID*, SegmentID_T*, LogParameter_T*);
+Four MLGF_MakeBulkLoadTuple(Four, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, char*, char*);
 Four MLGF_DeleteObject(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, LockParameter*, LogParameter_T*);
 Four MLGF_DropIndex(Four, XactTableEntry_T*, IndexID*, PhysicalIndexID*, SegmentID_T*, Boolean, LogParameter_T*); 
 char *MLGF_Err(Four);
 Four MLGF_Fetch(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], MLGF_Cursor*, char*, LockParameter*);
 Four MLGF_FetchNext(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], MLGF_Cursor*, char*, LockParameter*);
+Four MLGF_FetchNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*, MLGF_Cursor*, char*, LockParameter*);
+Four MLGF_FetchNextNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*, MLGF_Cursor*, char*, LockParameter*);
 Four MLGF_InsertObject(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, char*, LockParameter*, LogParameter_T*);
 Four MLGF_SearchNearObject(Four, XactTableEntry_T*, PageID*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, LockParameter*);
+Four MLGF_SpatialJoin(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[],
+		      MLGFIndexInfo*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], MLGF_SpatialJoinCursor*, LockParameter*);
+Four MLGF_NextSpatialJoin(Four, XactTableEntry_T*, MLGF_SpatialJoinCursor*, ObjectID*, ObjectID*, LockParameter*);
 Four MLGF_InitSharedDS(Four);
 Four MLGF_InitLocalDS(Four);
 Four MLGF_FinalLocalDS(Four);
@@ -475,6 +475,7 @@ typedef struct rdsm_UserVolTableEntry_T_tag {
     Four volNo;                                /* volume number */
     Four numDevices;                           /* number of devices in volume */
     VarArray openFileDesc;                     /* open file descriptor for the volume */
+    Boolean attachFlag;                        /* TRUE if opened by RDsM_AttachVolume() */
 } rdsm_UserVolTableEntry_T;
 
 typedef struct RDsM_UserDS_T_tag {
@@ -497,6 +498,32 @@ typedef struct RDsM_ReadWriteBuffer_T_tag {
 #define RDSM_READ_WRITE_BUFFER_SIZE(_buffer)            ((_buffer)->alignedSize)
 #define RDSM_IS_ALIGNED_READ_WRITE_BUFFER(_ptr)         ((((MEMORY_ALIGN_TYPE)_ptr) & RDSM_READ_WRITE_BUFFER_ALIGN_MASK) ? FALSE : TRUE)
 
+/*
+ * I/O request submitted in a batch by RDsM_SubmitIOs()
+ *  A request covers contiguous pages in one extent. The callback, if any, is
+ *  called by the submitting thread after the request completes.
+ */
+#define RDSM_IO_READ    'R'
+#define RDSM_IO_WRITE   'W'
+
+typedef struct RDsM_IORequest_T_tag RDsM_IORequest_T;
+
+struct RDsM_IORequest_T_tag {
+    char     opType;                                    /* IN RDSM_IO_READ or RDSM_IO_WRITE */
+    PageID   trainId;                                   /* IN identifier of the first page */
+    Four     nPages;                                    /* IN # of contiguous pages */
+    char     *bufPtr;                                   /* IN a pointer for the buffer */
+    void     (*callback)(Four, RDsM_IORequest_T*);      /* IN completion callback (NULL if none) */
+    void     *arg;                                      /* IN argument for the callback */
+    Four     status;                                    /* OUT eNOERROR or error code */
+
+    /* filled by RDsM_SubmitIOs() */
+    FileDesc fd;                                        /* open file descriptor for the device */
+    Four     pageOffset;                                /* offset of the first page in the device */
+};
+
+typedef struct rdsm_IOContext_T_tag rdsm_IOContext_T;  /* per handle context of the I/O engine */
+
 /*
  * enable/disable macro of an extent map logging flag
  */
@@ -509,12 +536,15 @@ typedef struct RDsM_ReadWriteBuffer_T_tag {
 /*
  * Shared Memory Data Structures
  */
+#define RDSM_WRITESEQ_SIZE      1024    /* # of write sequence numbers */
+
 typedef struct {
     rdsm_VolTableEntry_T volMountTable[MAXNUMOFVOLS];
     Heap rdsmDevInfoTableHeap;
     Heap rdsmDevInfoForDataVolTableHeap;
     Heap rdsmSegmentInfoTableHeap;
     LATCH_TYPE latch_volMountTable;
+    volatile UFour writeSeq[RDSM_WRITESEQ_SIZE]; /* write sequence numbers of the pages */
 } RDsM_SHM;
 
 extern RDsM_SHM *rdsm_shmPtr;
@@ -527,6 +557,31 @@ extern Four procIndex;
 #define RDSM_DEVINFOFORDATAVOLTABLEHEAP (rdsm_shmPtr->rdsmDevInfoForDataVolTableHeap)
 #define RDSM_SEGMENTINFOTABLEHEAP       (rdsm_shmPtr->rdsmSegmentInfoTableHeap)
 
+/*
+ * The write sequence number of a page is incremented before and after the
+ * page is written by RDsM_WriteTrain() or RDsM_WriteTrains(); the pages
+ * share the numbers by hashing. A reader not holding the page in the
+ * buffer pool (see BfM_prefetch.c) compares the number before the read with
+ * the one after the read to know if a write may have overlapped with it.
+ */
+#define RDSM_WRITESEQ(_volNo, _pageNo) \
+        (rdsm_shmPtr->writeSeq[(UFour)((_volNo) + (_pageNo)) % RDSM_WRITESEQ_SIZE])
+
+#ifdef __GNUC__
+#define RDSM_INCREMENT_WRITESEQ(_volNo, _pageNo) \
+        ((void) __sync_fetch_and_add(&RDSM_WRITESEQ(_volNo, _pageNo), 1))
+#else
+#define RDSM_INCREMENT_WRITESEQ(_volNo, _pageNo) \
+        ((void) RDSM_WRITESEQ(_volNo, _pageNo)++)
+#endif
+
+#define RDSM_INCREMENT_WRITESEQS(_volNo, _pageNo, _nPages) \
+BEGIN_MACRO \
+    Four _i; \
+    for (_i = 0; _i < (_nPages) && _i < RDSM_WRITESEQ_SIZE; _i++) \
+        RDSM_INCREMENT_WRITESEQ(_volNo, (_pageNo) + _i); \
+END_MACRO
+
 /*-------------------- END OF Shared Memory Section -------------------------*/
 
 /* Handle is inserted in function parameter below  */
@@ -549,6 +604,8 @@ Four RDsM_ExtentReorganization(Four, XactTableEntry_T*, Four);
 Four RDsM_MountWithDeviceListString(Four, char*, Four*, Boolean);
 Four RDsM_Dismount(Four, Four, Boolean);
 Four RDsM_DismountDataVolumes(Four);
+Four RDsM_AttachVolume(Four, Four);
+Four RDsM_DetachVolumes(Four);
 Four RDsM_LogMountedVols(Four);
 
 Four RDsM_CreateSegment(Four, XactTableEntry_T*, Four, SegmentID_T*, Four, LogParameter_T*);
@@ -565,6 +622,9 @@ Four RDsM_ReadTrain(Four, PageID *, char *, Four);
 Four RDsM_WriteTrain(Four, char*, PageID*, Four);
 Four RDsM_ReadTrains(Four, PageID *, char *, Four, Four);
 Four RDsM_WriteTrains(Four, char *, PageID *, Four, Four);
+Four RDsM_SubmitIOs(Four, RDsM_IORequest_T*, Four);
+Four RDsM_SyncVolume(Four, Four);
+Four RDsM_SyncVolumes(Four, Four);
 Four RDsM_CopyExtent(Four, XactTableEntry_T*, Four, Four, Four, LogParameter_T*);
 
 Four RDsM_InsertMetaDictEntry(Four, XactTableEntry_T*, Four , char *, char *, Four, LogParameter_T*);
@@ -596,6 +656,11 @@ Four rdsm_WriteTrain(Four, FileDesc, Four, void*, Four);
 
 void rdsm_updateDiskStatistics(Four, FileDesc, Four, Four, char);
 
+Four rdsm_OpenFlags(void);
+Four rdsm_SyncDevice(FileDesc);
+Four rdsm_SubmitIOBatch(Four, RDsM_IORequest_T**, Four);
+Four rdsm_FinalIOContext(Four);
+
 Four rdsm_FormatSegment(Four, MasterPage_T*, Four, Four, Four, Four, Boolean);
 Four rdsm_AllocSegmentForPage(Four, RDsM_VolumeInfo_T*, Four*);
 Four rdsm_AllocSegmentForTrain(Four, RDsM_VolumeInfo_T*, Four*);
@@ -105,6 +105,16 @@ typedef int     key_t;
 
 #define MAXFREESPACE 536870912
 
+/*
+ * The buffers of the buffer manager are placed in a separate segment,
+ * which is backed by huge pages if possible (see SHM_process.c).
+ */
+#define SHM_BUFFERPOOL_SIZE \
+    ((Eight)PAGESIZE*NUM_PAGE_BUFS + (Eight)PAGESIZE*NUM_LOT_LEAF_BUFS*TRAINSIZE2)
+#define SHM_BUFFERPOOL_KEY_OFFSET 1	/* key of the segment = shared memory key + 1 */
+#define SHM_HUGEPAGE_SIZE_2M	((Eight)2*1024*1024)
+#define SHM_HUGEPAGE_SIZE_1G	((Eight)1024*1024*1024)
+
 
 #define PERMS   0666            /* shared mememory/semaphore permissions */
 
@@ -173,6 +183,10 @@ Four  sequence;
 
     Four 	nTotalProcess;
 
+/* Buffer Pool Segment -------------------------------------------------------- */
+    Eight	bufferPoolSize;		/* size of the buffer pool segment */
+    Eight	bufferPoolUsed;		/* allocated bytes in the buffer pool segment */
+
 /* --------------------------------------------------------------------------- */
     LOGICAL_PTR_TYPE(HeapWord *) sharedHeap;	/* Heap for dynamic allocation */
     LATCH_TYPE  latch_sharedHeap; 		/* latch for alloc/free variable size elements */
@@ -195,6 +209,7 @@ Four  sequence;
 /* macros for processTable information */
 extern Four	procIndex;
 extern SemStruct *shmPtr; 
+extern char *shm_bufferPoolPtr;		/* start address of the buffer pool segment */
 
 /* This macros is definded at Util_heap.c & Util_localHeap.c */
 /* Note: We have casted the (x) with 'Four' which is the alignment type. */
@@ -244,6 +259,7 @@ Four shm_initSharedHeap(Four, Four);
  */
 Four SHM_alloc(Four, Four, Four, char **);
 Four SHM_free(Four, char *, Four);
+Four SHM_allocBufferPool(Four, Eight, Eight *);
 Four SHM_semCreateOrOpen(Four, key_t, Four (*)(Four, void*), void*);
 Four SHM_semClose(Four, Four, Four (*)(Four, void*, Boolean), void*);
 Four SHM_semInit(Four, Four, Four);
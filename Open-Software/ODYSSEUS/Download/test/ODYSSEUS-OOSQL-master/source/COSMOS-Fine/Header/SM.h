@@ -167,6 +167,11 @@ typedef struct {
     MLGF_KeyDesc kdesc;		/* key description of the index */
     MLGF_HashValue lowerBound[MLGF_MAXNUM_KEYS]; /* lower bounds */
     MLGF_HashValue upperBound[MLGF_MAXNUM_KEYS]; /* upper bounds */
+    Boolean nearestFlag;	/* TRUE if objects are returned in distance order */
+    MLGF_NearestQueue nearest;	/* priority queue of the nearest-neighbour scan */
+    Boolean joinFlag;		/* TRUE if the scan is joined with another MLGF scan */
+    Four innerScanId;		/* the other scan of the spatial join */
+    MLGF_SpatialJoinCursor join; /* state of the spatial join */
 } sm_ScanInfoForMLGF_Scan;
 
 typedef struct {
@@ -336,6 +341,9 @@ Four SM_MLGF_DropIndex(Four, IndexID*, LockParameter*);
 Four SM_MLGF_InsertIndexEntry(Four, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, void*, LockParameter*);
 Four SM_MLGF_OpenIndexScan(Four, FileID*, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], LockParameter*);
 Four SM_MLGF_SearchNearObject(Four, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, LockParameter*);
+Four SM_MLGF_SetNearestQuery(Four, Four, MLGF_HashValue[], MLGF_HashToCoordFunc);
+Four SM_MLGF_SetSpatialJoin(Four, Four, Four);
+Four SM_MLGF_NextJoinPair(Four, Four, ObjectID*, ObjectID*, LockParameter*);
 Four SM_FormatDataVolume(Four, Four, char**, char*, Four, Four, Four*, Four);
 Four SM_FormatTempDataVolume(Four, Four, char**, char*, Four, Four, Four*, Four);
 Four SM_FormatLogVolume(Four, Four, char**, char*, Four, Four, Four*);
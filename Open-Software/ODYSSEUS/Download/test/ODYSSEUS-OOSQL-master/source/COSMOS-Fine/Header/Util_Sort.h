@@ -254,12 +254,16 @@ Four util_PutTupleIntoSortInBufferArray(Four, SortStreamTableEntry*, Two, char*)
 Four util_PutTupleIntoSortOutBufferArray(Four, XactTableEntry_T*, SortStreamTableEntry*, Two, char*, LogParameter_T*);
 Four util_FlushOutBuffer(Four, XactTableEntry_T*, SortStreamTableEntry*, LogParameter_T*);
 Four util_ReadIthRunIntoInBuffer(Four, SortStreamTableEntry*, Four, Four);
+Four util_ReadRunsIntoInBuffer(Four, SortStreamTableEntry*, Four, Four, Four);
 Four util_CreateLoserTree(Four, SortTupleDesc*, void**, Four*, Four);
 Four util_FixLoserTree(Four, SortTupleDesc*, void**, Four*, Four, Four);
 Four util_QuickSort(Four, SortTupleDesc*, void**, Four);
+Four util_ParallelSort(Four, SortTupleDesc*, void**, Four);
+Four util_NormalizedSort(Four, SortTupleDesc*, void**, Four);
 Four util_SortKeyCompare(Four, SortTupleDesc*, void*, void*);
 Four util_WriteTrains(Four, char *, PageID *, Four, Four);
 Four util_ReadTrains(Four, PageID *, char *, Four, Four);
+Four util_ReadTrainsBatch(Four, Four, PageID **, char **, Four *, Four);
 
 Four Util_GetNumTuplesInSortStream(Four, Four);
 Four Util_GetSizeOfSortStream(Four, Four);
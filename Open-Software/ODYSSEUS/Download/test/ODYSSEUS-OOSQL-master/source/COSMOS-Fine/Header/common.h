@@ -221,6 +221,20 @@ typedef MEMORY_ALIGN_TYPE LogicalPtr_T;
  */
 typedef struct CfgParams_T_tag {
     char logVolumeDeviceList[MAX_DEVICE_NAME_SIZE*MAX_DEVICES_IN_LOG_VOLUME]; /* log device name */
+    Four bfmNumCleaners;        /* # of background page cleaner threads per process (0 = disabled) */
+    Four bfmCleanRatio;         /* percentage of buffers kept clean ahead of the clock hand */
+    Four bfmCleanerInterval;    /* sleep time of a page cleaner between two passes (unit = msec) */
+    Four bfmNumPartitions;      /* # of partitions of a buffer pool, each with its own clock hand */
+    Four bfmReplacementPolicy;  /* BFM_POLICY_CLOCK or BFM_POLICY_2Q */
+    Four bfmNumPrefetchers;     /* # of readahead threads per process (0 = read ahead by the scanning thread) */
+    Four bfmMaxReadAhead;       /* maximum readahead window in trains (0 = disabled) */
+    Four rdsmIOEngine;          /* RDSM_IO_ENGINE_PSYNC, RDSM_IO_ENGINE_AIO or RDSM_IO_ENGINE_URING */
+    Boolean rdsmDirectIO;       /* TRUE if the volumes are opened with O_DIRECT */
+    Four logGroupCommitWindow;  /* time the group commit leader waits for more committers (unit = usec) */
+    Four logGroupCommitSize;    /* maximum # of committers gathered in one log flush */
+    Four rmNumRedoWorkers;      /* # of threads redoing the pages at restart (0 = redo by the restarting thread) */
+    Four rmTargetRedoDistance;  /* log scanned by the restart kept below this by the page cleaners (unit = Kbytes, 0 = unbounded) */
+    Four rmCheckpointDistance;  /* log written between two checkpoints of the page cleaners (unit = Kbytes, 0 = disabled) */
 } CfgParams_T;
 
 
@@ -624,6 +638,9 @@ typedef UFour_Invariable        MLGF_HashValue;
 #define MLGF_MAX_HASHVALUE 	((MLGF_HashValue)(CONSTANT_ALL_BITS_SET(MLGF_HashValue)))
 #define MLGF_RADIX 10
 
+/* maps a hash value back to the coordinate it encodes (nearest-neighbour scan) */
+typedef double (*MLGF_HashToCoordFunc)(MLGF_HashValue);
+
 typedef struct {
     One 		flag;			/* flag */
     One 		nKeys;			/* number of keys */
@@ -698,6 +715,37 @@ typedef struct {
     VarArray path;			   /* traverse path from root to leaf */
 } MLGF_Cursor;
 
+/*
+ * Priority queue of a nearest-neighbour MLGF scan.
+ * Pages and objects are kept in a binary min-heap ordered by their
+ * minimum distance to the query point; an object reaches the top of the
+ * heap only after every region which could contain a nearer one.
+ */
+typedef struct {
+    MLGF_HashValue queryPoint[MLGF_MAXNUM_KEYS]; /* the query point */
+    MLGF_HashToCoordFunc hashToCoord;	/* hash value to coordinate; NULL means identity */
+    Four     nElems;			/* # of elements in the heap */
+    VarArray heap;			/* array of mlgf_NearestElem */
+} MLGF_NearestQueue;
+
+/*
+ * State of a spatial join of two MLGF indexes.
+ * The keys of both indexes are MBRs; the first half of the keys is the
+ * lower corner and the second half the upper corner. Pairs of pages whose
+ * regions may hold intersecting MBRs wait on a stack, and the object pairs
+ * found by joining two leaf pages are buffered until they are returned.
+ */
+typedef struct {
+    MLGF_KeyDesc   kdesc[2];		/* key descriptors of the two indexes */
+    MLGF_HashValue lowerBound[2][MLGF_MAXNUM_KEYS]; /* ranges of the two indexes */
+    MLGF_HashValue upperBound[2][MLGF_MAXNUM_KEYS];
+    Four     nPagePairs;		/* # of page pairs on the stack */
+    VarArray pagePairs;			/* array of mlgf_JoinPagePair */
+    Four     nObjectPairs;		/* # of object pairs not yet returned */
+    VarArray objectPairs;		/* array of mlgf_JoinObjectPair */
+    VarArray objects[2];		/* array of mlgf_JoinObject; the leaf objects being joined */
+} MLGF_SpatialJoinCursor;
+
 /* Universal Cursor */
 typedef union {
     AnyCursor any;		/* for access of 'flag' and 'oid' */
@@ -1057,6 +1105,20 @@ extern Four procIndex;
 
 
 #define CFG_LOGVOLUMEDEVICELIST (common_shmPtr->cfgParams.logVolumeDeviceList)
+#define CFG_BFMNUMCLEANERS      (common_shmPtr->cfgParams.bfmNumCleaners)
+#define CFG_BFMCLEANRATIO       (common_shmPtr->cfgParams.bfmCleanRatio)
+#define CFG_BFMCLEANERINTERVAL  (common_shmPtr->cfgParams.bfmCleanerInterval)
+#define CFG_BFMNUMPARTITIONS    (common_shmPtr->cfgParams.bfmNumPartitions)
+#define CFG_BFMREPLACEMENTPOLICY (common_shmPtr->cfgParams.bfmReplacementPolicy)
+#define CFG_BFMNUMPREFETCHERS   (common_shmPtr->cfgParams.bfmNumPrefetchers)
+#define CFG_BFMMAXREADAHEAD     (common_shmPtr->cfgParams.bfmMaxReadAhead)
+#define CFG_RDSMIOENGINE        (common_shmPtr->cfgParams.rdsmIOEngine)
+#define CFG_RDSMDIRECTIO        (common_shmPtr->cfgParams.rdsmDirectIO)
+#define CFG_LOGGROUPCOMMITWINDOW (common_shmPtr->cfgParams.logGroupCommitWindow)
+#define CFG_LOGGROUPCOMMITSIZE  (common_shmPtr->cfgParams.logGroupCommitSize)
+#define CFG_RMNUMREDOWORKERS    (common_shmPtr->cfgParams.rmNumRedoWorkers)
+#define CFG_RMTARGETREDODISTANCE (common_shmPtr->cfgParams.rmTargetRedoDistance)
+#define CFG_RMCHECKPOINTDISTANCE (common_shmPtr->cfgParams.rmCheckpointDistance)
 
 /*** END_OF_SHM_RELATED_AREA ***/
 
@@ -275,6 +275,9 @@ typedef enum {SM_EQ=0x1, SM_LT=0x2, SM_LE=0x3, SM_GT=0x4, SM_GE=0x5, SM_NE=0x6,
 /* hash value */
 typedef UFour_Invariable MLGF_HashValue;
 
+/* maps a hash value back to the coordinate it encodes (nearest-neighbour scan) */
+typedef double (*MLGF_HashToCoordFunc)(MLGF_HashValue);
+
 /* Btree Key Value */
 typedef struct {
     Two len;
@@ -579,6 +582,9 @@ Four SM_MLGF_DropIndex(Four, IndexID*, LockParameter*);
 Four SM_MLGF_InsertIndexEntry(Four, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, void*, LockParameter*);
 Four SM_MLGF_OpenIndexScan(Four, FileID*, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[], LockParameter*);
 Four SM_MLGF_SearchNearObject(Four, IndexID*, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*, LockParameter*);
+Four SM_MLGF_SetNearestQuery(Four, Four, MLGF_HashValue[], MLGF_HashToCoordFunc);
+Four SM_MLGF_SetSpatialJoin(Four, Four, Four);
+Four SM_MLGF_NextJoinPair(Four, Four, ObjectID*, ObjectID*, LockParameter*);
 Four SM_Mount(Four, Four, char**, Four*);
 Four SM_NextObject(Four, Four, ObjectID*, ObjectHdr*, char*, SM_Cursor**, LockParameter*);
 Four SM_OpenIndexScan(Four, FileID*, IndexID*, KeyDesc*, BoundCond*, BoundCond*, LockParameter*);
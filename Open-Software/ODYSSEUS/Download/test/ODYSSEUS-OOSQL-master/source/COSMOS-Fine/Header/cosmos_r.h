@@ -323,6 +323,9 @@ typedef void* FileDesc;
 /* hash value */
 typedef UFour_Invariable MLGF_HashValue;
 
+/* maps a hash value back to the coordinate it encodes (nearest-neighbour scan) */
+typedef double (*MLGF_HashToCoordFunc)(MLGF_HashValue);
+
 /* MBR type */
 typedef struct {
     MLGF_HashValue values[MBR_NUM_PARTS];
@@ -779,6 +782,7 @@ Four LRDS_GetFileIdOfRelation(Four, Four, char*, FileID*);
 Four LRDS_Init();
 Four LRDS_MLGF_OpenIndexScan(Four, Four, IndexID*, MLGF_HashValue[], MLGF_HashValue[], Four, BoolExp[], LockParameter*);
 Four LRDS_MLGF_SearchNearTuple(Four, Four, IndexID*, MLGF_HashValue[], TupleID*, LockParameter*);
+Four LRDS_MLGF_OpenNearestTupleScan(Four, Four, IndexID*, MLGF_HashValue[], MLGF_HashToCoordFunc, Four, BoolExp[], LockParameter*);
 Four LRDS_Mount(Four, Four, char**, Four*);
 Four LRDS_NextTuple(Four, Four, TupleID*, LRDS_Cursor**);
 Four LRDS_OpenIndexScan(Four, Four, IndexID*, BoundCond*, BoundCond*, Four, BoolExp*, LockParameter*);
@@ -1540,6 +1544,10 @@ typedef struct {
     GlobalHandle		grantedGlobalHandle; /* index of thread which owns this latch */ 
     LOGICAL_PTR_TYPE(TCB*)	queue;		/* waiting queue */
     cosmos_thread_mutex_t       mutex; 	
+    volatile UFour_Invariable	word;		/* futex latch: writer, waiters and handoff bits and # of readers */
+    volatile Four_Invariable	owner;		/* futex latch: owner of the M_EXCLUSIVE latch */
+    volatile Four_Invariable	heir;		/* futex latch: thread the latch is handed off to */
+    Four_Invariable		spinLimit;	/* futex latch: # of spins before parking */
 } LATCH_TYPE;
 
 
@@ -84,6 +84,24 @@
 #define WAITING 	2
 #endif
 
+/*
+ * With USEFUTEX, a latch is a single atomic word and a waiting thread parks
+ * on the word by futex(2). The futex is not private, so it works for the
+ * latches in the shared memory across the processes.
+ */
+#if defined(USEFUTEX) && defined(LINUX) && defined(__GNUC__)
+#define SHM_FUTEX_LATCH
+#endif
+
+/* bits of the latch word */
+#define SHM_LATCH_WRITER	0x80000000	/* held in M_EXCLUSIVE mode */
+#define SHM_LATCH_WAITERS	0x40000000	/* some threads are parked on the word */
+#define SHM_LATCH_HANDOFF	0x20000000	/* the latch is reserved for the heir */
+#define SHM_LATCH_READERS	0x1fffffff	/* # of M_SHARED holders */
+
+/* identifier of a thread stored in the owner field of a latch */
+#define SHM_LATCH_OWNER(_procIndex, _handle)	((_procIndex)*MAXTHREADS + (_handle) + 1)
+
 
 /*
  * Type Definition for Latch Conditions
@@ -146,8 +164,23 @@ typedef struct {
 
     cosmos_thread_mutex_t       mutex; 
 
+    /* used only by the futex latch */
+    volatile UFour_Invariable	word;		/* writer, waiters and handoff bits and # of readers */
+    volatile Four_Invariable	owner;		/* SHM_LATCH_OWNER() of the M_EXCLUSIVE holder */
+    volatile Four_Invariable	heir;		/* SHM_LATCH_OWNER() of the thread the latch is handed off to */
+    Four_Invariable		spinLimit;	/* # of spins before parking; adapted to the hold time */
+
 } LATCH_TYPE;
 
+#ifdef SHM_FUTEX_LATCH
+#define SHM_IS_LATCH_FREE(_latch)	((_latch).word == 0)
+#define SHM_GET_LATCH_MODE(_latch) \
+(((_latch).word & SHM_LATCH_WRITER) ? M_EXCLUSIVE : ((_latch).word & SHM_LATCH_READERS) ? M_SHARED : M_FREE)
+#else
+#define SHM_IS_LATCH_FREE(_latch)	((_latch).mode == M_FREE && (_latch).queue == LOGICAL_PTR(NULL))
+#define SHM_GET_LATCH_MODE(_latch)	((_latch).mode)
+#endif
+
 typedef struct _latchEntry  LatchEntry;
 
 struct _latchEntry {
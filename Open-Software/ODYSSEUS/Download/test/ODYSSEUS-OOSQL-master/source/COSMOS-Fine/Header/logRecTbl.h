@@ -147,6 +147,7 @@ Four Undo_LOT_WriteData(Four, XactTableEntry_T*, Buffer_ACC_CB*, Lsn_T*, LOG_Log
 Four Redo_MLGF_ChangeLeafEntry(Four, void*, LOG_LogRecInfo_T*);
 Four Undo_MLGF_ChangeLeafEntry(Four, XactTableEntry_T*, Buffer_ACC_CB*, Lsn_T*, LOG_LogRecInfo_T*);
 Four Redo_MLGF_CopyPage(Four, void*, LOG_LogRecInfo_T*);
+Four Undo_MLGF_CopyPage(Four, XactTableEntry_T*, Buffer_ACC_CB*, Lsn_T*, LOG_LogRecInfo_T*);
 Four Redo_MLGF_DeleteDirectoryEntries(Four, void*, LOG_LogRecInfo_T*);
 Four Undo_MLGF_DeleteDirectoryEntries(Four, XactTableEntry_T*, Buffer_ACC_CB*, Lsn_T*, LOG_LogRecInfo_T*);
 Four Redo_MLGF_DeleteDirectoryEntry(Four, void*, LOG_LogRecInfo_T*);
@@ -105,6 +105,10 @@
 #define MAXTHREADS	128
 #define TOTALTHREADS	(MAXPROCS*MAXTHREADS)
 
+/* spinning of the futex latch (see SHM_latch.c) */
+#define SHM_LATCH_MIN_SPINS	16	/* a latch spins at least this many times on a multiprocessor */
+#define SHM_LATCH_MAX_SPINS	4096	/* a latch spins at most this many times before parking */
+
 /* datafile bulkload write buffer size by page */
 #define BLKLD_WRITEBUFFERSIZE           10
 #define SIZE_OF_LRDS_TUPLE_BUFFER       PAGESIZE
@@ -152,6 +156,10 @@
 #define DPT_HASH_TABLE_SIZE 32
 #define DPT_INIT_NUM_HASH_TABLE_ENTRIES 100
 
+/* parallel redo (see rm_Redo.c) */
+#define RM_MAX_REDO_WORKERS      16    /* maximum # of redo workers */
+#define RM_REDO_QUEUE_SIZE       1024  /* # of log records queued for a redo worker at most */
+
 
 /*
 ** RDsM
@@ -178,6 +186,13 @@
 #define RDSM_READ_WRITE_BUFFER_INIT_SIZE            (PAGESIZE * 16)
 #define RDSM_READ_WRITE_BUFFER_ALIGN_MASK           (0x00000fff)            /* read/write buffer align size is 4096 */
 
+/* I/O engine which submits the batched I/O requests (see rdsm_IOEngine.c) */
+#define RDSM_IO_ENGINE_PSYNC          0     /* pread()/pwrite() one by one */
+#define RDSM_IO_ENGINE_AIO            1     /* Linux native AIO */
+#define RDSM_IO_ENGINE_URING          2     /* io_uring; falls back to AIO and then to PSYNC */
+#define RDSM_DEFAULT_IO_ENGINE        RDSM_IO_ENGINE_PSYNC
+#define RDSM_IO_QUEUE_DEPTH           64    /* maximum # of I/Os in flight per handle */
+
 
 /*
  * TM
@@ -189,9 +204,39 @@
 /*
 ** BfM
 */
-/* # of buffers in each buffer pool */
+/* # of buffers in each buffer pool (may be overridden by -D option) */
+#ifndef NUM_PAGE_BUFS
 #define NUM_PAGE_BUFS     3000	
+#endif
+#ifndef NUM_LOT_LEAF_BUFS
 #define NUM_LOT_LEAF_BUFS 4000  
+#endif
+
+/* background page cleaner (see BfM_cleaner.c) */
+#define BFM_MAX_CLEANERS              8     /* maximum # of page cleaner threads in a process */
+#define BFM_DEFAULT_CLEAN_RATIO       10    /* % of buffers kept clean ahead of the clock hand */
+#define BFM_DEFAULT_CLEANER_INTERVAL  100   /* msec */
+
+/* buffer pool partitions (see bfm_partition.c) */
+#define BFM_MAX_PARTITIONS            64    /* maximum # of partitions of a buffer pool */
+#define BFM_DEFAULT_NUM_PARTITIONS    1     /* 1 = one clock hand for the whole buffer pool */
+#define BFM_MIN_BUFS_IN_PARTITION     64    /* a partition has at least this many buffers */
+#define BFM_CACHE_LINE_SIZE           64    /* to keep the clock hands on different cache lines */
+
+/* buffer replacement policies (BFM_REPLACEMENT_POLICY) */
+#define BFM_POLICY_CLOCK              0     /* second chance on every reference */
+#define BFM_POLICY_2Q                 1     /* a new buffer earns its second chance on the second reference */
+#define BFM_DEFAULT_REPLACEMENT_POLICY BFM_POLICY_CLOCK
+
+/* # of buffers reused in turn by a sequential access (see bfm_ring.c) */
+#define BFM_RING_SIZE                 16
+
+/* sequential readahead (see BfM_prefetch.c) */
+#define BFM_MAX_PREFETCHERS           8     /* maximum # of prefetcher threads in a process */
+#define BFM_READAHEAD_TRIGGER         2     /* # of sequential accesses before the readahead begins */
+#define BFM_MIN_READAHEAD             4     /* initial (and minimum) readahead window in trains */
+#define BFM_DEFAULT_MAX_READAHEAD     64    /* the readahead window grows up to this many trains */
+#define BFM_PREFETCH_QUEUE_SIZE       64    /* # of pending readahead requests in a process */
 
 /*
 ** BtM
@@ -202,6 +247,9 @@
 /* Btree Maximum Number of Key Parts */
 #define MAXNUMKEYPARTS 8
 
+/* Post the shortest separator on a leaf split (see btm_Split.c) */
+#define BTM_SUFFIX_TRUNCATION TRUE
+
 /* Logical-ID Mapping Table */
 #define BTM_SIZE_OF_HASH_TABLE_FOR_ID_MAPPING      0x10 /* SHOULD be power of 2 */
 #define BTM_INIT_SIZE_MAPPING_TABLE_ENTRY_POOL     10
@@ -238,6 +286,11 @@
 #define NUM_LOG_FILES_IN_LOG_VOLUME  8
 #define NUM_WRITE_LOG_BUFS           10
 
+/* group commit (see LOG_GroupCommit.c) */
+#define LOG_DEFAULT_GROUP_COMMIT_WINDOW   0     /* usec; 0 = no waiting for more committers */
+#define LOG_DEFAULT_GROUP_COMMIT_SIZE     32    /* the leader stops waiting when this many committers queued */
+#define LOG_GROUP_COMMIT_POLL_INTERVAL    50    /* usec between two checks of the commit queue */
+
 
 
 /*
@@ -261,6 +314,13 @@
 #define READ_UNIT       10
 #define MAX_NUM_RUN   ((Four) (SIZE_OF_SORT_IN_BUFFER/READ_UNIT))
 
+/* a run is sorted on this many threads when it has enough tuples (see util_ParallelSort.c) */
+#define UTIL_SORT_NUM_THREADS          4
+#define UTIL_PARALLEL_SORT_MIN_TUPLES  4096
+
+/* # of read requests submitted together by util_ReadTrainsBatch() */
+#define UTIL_MAX_READ_REQUESTS   64
+
 
 
 
@@ -209,6 +209,8 @@ typedef struct BfM_PerThreadDS_T_tag {
     LocalPool      		BACB_pool;    /* pool of Buffer_ACC_CB block */
     Buffer_ACC_CB  		MyFixed_BACB; /* pointer to the doubly linked list of BCBs which are fixed by this process  */
     Lock_ctrlBlock 		*myLCB;
+    bfm_BufferRing		ring[NUM_BUF_TYPES]; /* buffers for the sequential accesses */
+    bfm_ReadAhead		readAhead[NUM_BUF_TYPES]; /* readahead state of the sequential accesses */
 
 } BfM_PerThreadDS_T;
 
@@ -234,6 +236,7 @@ typedef struct RDsM_PerThreadDS_T_tag {
 	Four    		io_num_of_writes;
 	Four    		io_num_of_sequential_writes;
 	RDsM_ReadWriteBuffer_T  rdsm_ReadWriteBuffer;
+	rdsm_IOContext_T	*rdsm_ioCtx;		/* I/O engine context; allocated on the first batch */
 
 } RDsM_PerThreadDS_T;
 
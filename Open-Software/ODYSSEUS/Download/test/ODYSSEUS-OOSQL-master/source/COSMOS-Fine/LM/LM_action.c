@@ -123,23 +123,15 @@ Four LM_beginAction(
 
     if(LM_TEST_ACTION_FLAG_ON(handle)) ERR(handle, eWRONGACTIONSTART_LM); 
 
-    /*@ get latch */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
-    if(xBucket->ccLevel == X_RR_RR) ERRL1(handle, eNONEEDACTION_LM, &LM_LATCH); 
+    if(xBucket->ccLevel == X_RR_RR) ERR(handle, eNONEEDACTION_LM); 
 
     for(i = 0; i < N_LEVEL; i++)
         xBucket->startAction[i] = xBucket->grantedList[i];
 
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if(e < eNOERROR) ERR(handle, e);
-
     /* enable 'LM_actionFlag' */
     if(type == USER_ACTION){
     	LM_ENABLE_ACTION_FLAG(handle);
@@ -184,14 +176,9 @@ Four LM_endAction(
 
     if(!LM_TEST_ACTION_FLAG_ON(handle) && !LM_TEST_AUTO_ACTION_FLAG_ON(handle)) ERR(handle, eWRONGACTIONEND_LM);
 
-    /*@ get latch */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /*
     ** first release Page Lock and then release File Lock
@@ -229,7 +216,7 @@ Four LM_endAction(
             /* request latch for access the lockBucket */
             e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE,
                              M_UNCONDITIONAL, NULL);
-            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+            if (e < eNOERROR) ERR(handle, e);
 
             DELETE_FROM_REQUESTNODE_DLIST(lBucket->queue, aRequest);
             DELETE_FROM_REQUESTNODE_DLIST2(xBucket->grantedList[startLevel], aRequest);
@@ -241,10 +228,6 @@ Four LM_endAction(
             if (e < 0) {
 
                 e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-                /* release lmLatch */
-                e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
                 if (e2 < 0) ERR(handle, e2);
 
                 ERR(handle, e);
@@ -253,7 +236,7 @@ Four LM_endAction(
             if (PHYSICAL_PTR(lBucket->queue)) {
 
                 e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
             }
             else {			/* delete lBucket */
 
@@ -261,7 +244,7 @@ Four LM_endAction(
                 lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH(lBucket->target, tempSeed, startLevel)];
 
                 e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
 
             }
             aRequest = PHYSICAL_PTR(xBucket->grantedList[startLevel]);
@@ -277,9 +260,6 @@ Four LM_endAction(
     else if(type = AUTO_ACTION)
 		LM_DISABLE_AUTO_ACTION_FLAG(handle);
 
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if(e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 
 }
@@ -76,12 +76,18 @@
  * Description:
  * 	deadlock detection and abort the victim
  *
+ *	The detection does not stop the lock manager. It takes a snapshot of
+ *	the waits-for graph latching one lock hash chain at a time, searches
+ *	cycles in the snapshot without any latch, and then validates each cycle
+ *	against the live lock table before aborting its victim.
+ *
  * Exports:
  *	LM_detectDeadlock()
  *
 */
 
 #include <stdio.h>
+#include <stdlib.h>	/* for qsort */
 #include "common.h"
 #include "error.h"
 #include "latch.h"
@@ -96,8 +102,19 @@
 
 
 /*@ function prototype */
-Four lm_detectCycle(Four, XactBucket_Type*, lm_DeadlockStackEntry*, Four*, DeadlockStatus*, Four*);
+Four lm_buildWaitsForGraph(Four, VarArray*, Four*, VarArray*, Four*);
+Four lm_searchCycles(Four, lm_WFGNode*, Four, lm_WFGEdge*);
+Four lm_resolveDeadlock(Four, lm_WFGNode*, Four*, Four, Four);
+RequestNode_Type *lm_nextBlocker(RequestNode_Type*, RequestNode_Type*);
 Four lm_costEvaluation(Four, XactBucket_Type *, Four *);
+static int lm_compareWFGNodes(const void*, const void*);
+static Four lm_findWFGNode(lm_WFGNode*, Four, XactID*);
+
+
+/* initial # of entries of the arrays used by the detection */
+#define LM_WFG_INIT_NODES	64
+#define LM_WFG_INIT_EDGES	128
+
 
 
 /*@================================
@@ -121,37 +138,48 @@ Four LM_detectDeadlock(
 {
     Four 			e;				/* error code */
     Four 			i;				/* index for loop */
-    XactBucket_Type 		*temp;				/* temporary storage of the transaction bucket */
-    DeadlockStatus 		deadlockStatus;			/* deadlock status */
-    lm_DeadlockStackEntry 	lmDeadlockStack[MAXDEADLOCKCHAIN]; /* path of the deadlock detection */
-    Four 			deadlockStack_Top;		/* top of lmDeadlockStack */
-    Four 			victim;				/* index of the victim in lmDeadlockStack */
+    VarArray 			nodes;				/* nodes of the waits-for graph */
+    VarArray 			edges;				/* edges of the waits-for graph */
+    Four 			nNodes;				/* # of nodes */
+    Four 			nEdges;				/* # of edges */
+    lm_WFGEdge 			*edge;				/* an edge */
+
 
-    /* Initialize the deadlock stack top index */
-    deadlockStack_Top = INITDEADLOCKSTACKTOP;
+    if(lm_shmPtr  == NULL) ERR(handle, eFATALERROR_LM);
 
     /*@ get LM_LATCH */
-    /* get the lockLatch to prevent for another transaction
-       to touch the lock table structure */
+    /* LM_LATCH only serializes the deadlock detections; the lock manager
+       does not use it, so the lock requests go on during the detection */
     e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERR(handle, e);
 
-    /* initialize for deadlock detection */
-    for (i = 0; i < MAXXACTHASHENTRY; i++){
-	if(lm_shmPtr  == NULL) ERR(handle, eFATALERROR_LM);
-	for (temp = PHYSICAL_PTR(LM_XACTHASHTABLE[i].bucketPtr); temp != NULL; temp = PHYSICAL_PTR(temp->next)){ 
-	    temp->waitingfor = LOGICAL_PTR(NULL); 
-	    temp->deadlockVisit = 0;
-	}
+    e = Util_initVarArray(handle, &nodes, sizeof(lm_WFGNode), LM_WFG_INIT_NODES);
+    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+
+    e = Util_initVarArray(handle, &edges, sizeof(lm_WFGEdge), LM_WFG_INIT_EDGES);
+    if (e < eNOERROR) {
+	(void) Util_finalVarArray(handle, &nodes);
+	ERRL1(handle, e, &LM_LATCH);
     }
 
-    /* start deadlock detection */
-    for(i=0; i < MAXXACTHASHENTRY; i++)
-	for(temp = PHYSICAL_PTR(LM_XACTHASHTABLE[i].bucketPtr); temp != NULL; temp = PHYSICAL_PTR(temp->next)){ 
-    	    e = lm_detectCycle(handle, temp, lmDeadlockStack,
-                               &deadlockStack_Top, &deadlockStatus, &victim);
-	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
-	}
+    /* take the snapshot of the waits-for graph */
+    e = lm_buildWaitsForGraph(handle, &nodes, &nNodes, &edges, &nEdges);
+
+    if (e >= eNOERROR && nNodes > 1) {
+
+	/* sort the nodes by the transaction id and resolve the edges */
+	qsort(nodes.ptr, nNodes, sizeof(lm_WFGNode), lm_compareWFGNodes);
+
+	for (i = 0, edge = (lm_WFGEdge*)edges.ptr; i < nEdges; i++, edge++)
+	    edge->to = lm_findWFGNode((lm_WFGNode*)nodes.ptr, nNodes, &edge->xactID);
+
+	e = lm_searchCycles(handle, (lm_WFGNode*)nodes.ptr, nNodes, (lm_WFGEdge*)edges.ptr);
+    }
+
+    (void) Util_finalVarArray(handle, &nodes);
+    (void) Util_finalVarArray(handle, &edges);
+
+    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
 
     /*@ release LM_LATCH */
     e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
@@ -163,227 +191,446 @@ Four LM_detectDeadlock(
 
 
 /*@================================
- * lm_detectCycle()
+ * lm_buildWaitsForGraph()
  *================================*/
 /* ------------------------------------------------------------ */
 /*                                                              */
-/* lm_detectCycle ::                                            */
-/*      detect one cycle and select a victim 			*/
+/* lm_buildWaitsForGraph ::                                     */
+/*      take a snapshot of the waits-for graph			*/
 /*                                                              */
 /* paprameters                                                  */
-/*    XactBucket_Type        IN transaction bucket to 		*/
-/*				start deadlock detection 	*/
-/*    lm_DeadlockStackEntry  INOUT deadlock stack		*/
-/*    Four      	     INOUT top of deadlock stack	*/
-/*    DeadlockStatus  	     OUT deadlock ? 			*/
-/*    Four  		     OUT index of deadlock stack	*/
+/*    VarArray    OUT nodes; a node per waiting request		*/
+/*    Four        OUT # of nodes				*/
+/*    VarArray    OUT edges; an edge per blocking request	*/
+/*    Four        OUT # of edges				*/
 /*                                                              */
 /* return value                                                 */
 /*    error code 						*/
 /*                                                              */
 /* ------------------------------------------------------------ */
-
-Four lm_detectCycle(
+Four lm_buildWaitsForGraph(
     Four			handle,
-    XactBucket_Type 		*me,			/* IN transaction bucket to start deadlock detection */
-    lm_DeadlockStackEntry 	*deadlockStack,		/* INOUT deadlock stack */
-    Four 			*deadlockStack_Top,	/* INOUT top of deadlock stack */
-    DeadlockStatus 		*deadlockStatus,	/* OUT deadlock ? */
-    Four 			*victimIndex)		/* OUT index of deadlock stack */
+    VarArray 			*nodes,			/* OUT nodes of the graph */
+    Four 			*nNodes,		/* OUT # of nodes */
+    VarArray 			*edges,			/* OUT edges of the graph */
+    Four 			*nEdges)		/* OUT # of edges */
 {
     Four 			e;			/* error code */
     Four 			i;			/* index for loop */
-    XactBucket_Type 		*him;			/* transaction bucket to be tested */
-    RequestNode_Type 		*them;			/* request node to be tested */
-    RequestNode_Type 		*myRequestNode;		/* my request node */
-    Four 			minCost;		/* minimal cost for aborting victim */
-    Four 			victimCandidateIndex;	/* index of the candidate of victim */
-    XactBucket_Type 		*victim;		/* transaction bucket which is selected victim */
-    RequestNode_Type 		*victimWait;		/* request node of the victim */
-    LockMode 			grantedMode;		/* lock mode of a granted(or converting) request node */
-    cosmos_thread_sem_t 	*semID;			/* semaphore No of the victim */
-    LockBucket_Type 		*lBucket; 
+    LockHashEntry 		*lockHashEntryPtr;	/* a lock hash chain */
+    LockBucket_Type 		*lBucket;		/* a lock bucket in the chain */
+    RequestNode_Type 		*myRequest;		/* a waiting request node */
+    RequestNode_Type 		*them;			/* request node blocking myRequest */
+    lm_WFGNode 			*node;			/* node for myRequest */
+    lm_WFGEdge 			*edge;			/* edge for them */
 
 
-    /*@ check status */
-    /* check that this transaction bucket has been tested */
-    if(me->deadlockVisit)  {
-	*deadlockStatus = DLS_OK;
-	return(eNOERROR);
-    }
+    *nNodes = *nEdges = 0;
 
-    /* if this transaction does not wait any lock then it is not deadlock */
-    if(PHYSICAL_PTR(me->waitingLock) == NULL){
-	*deadlockStatus = DLS_OK;
-	me->deadlockVisit = 1;
-	return(eNOERROR);
-    }
+    for (i = 0; i < MAXLOCKHASHENTRY; i++) {
 
-    /* find my request node */
-    for (myRequestNode = PHYSICAL_PTR( ((LockBucket_Type*)PHYSICAL_PTR(me->waitingLock))->queue);
-	 myRequestNode != NULL && !EQUAL_XACTID(myRequestNode->xactID, me->xactID);
-	 myRequestNode = PHYSICAL_PTR(myRequestNode->next)); 
+	lockHashEntryPtr = &LM_LOCKHASHTABLE[i];
 
-    /* push this transaction into the deadlock stack */
-    deadlockStack[*deadlockStack_Top].xactBucket = me;
-    e = lm_costEvaluation(handle, me, &(deadlockStack[*deadlockStack_Top].cost));
-    if (e < eNOERROR) ERR(handle, e);
+	/* an empty chain has no waiting request */
+	if (PHYSICAL_PTR(lockHashEntryPtr->bucketPtr) == NULL) continue;
+
+	e = SHM_getLatch(handle, &lockHashEntryPtr->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+	if (e < eNOERROR) ERR(handle, e);
 
-    (*deadlockStack_Top)++;
+	for (lBucket = PHYSICAL_PTR(lockHashEntryPtr->bucketPtr); lBucket != NULL; lBucket = PHYSICAL_PTR(lBucket->next)) {
 
-    /*@ search deadlock */
-    /* 'them' is not NULL, because there is a RequestNode (me) at least. */
-    /* Consider L_CONVERTING node. */
+	    if (lBucket->nWaiting == 0) continue;
 
-    for (them = PHYSICAL_PTR( ((LockBucket_Type*)PHYSICAL_PTR(me->waitingLock))->queue);
- 	 them != NULL; 
-	 them = PHYSICAL_PTR(them->next)) {
+	    e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+	    if (e < eNOERROR) ERRL1(handle, e, &lockHashEntryPtr->latch);
 
-	if(myRequestNode->status == L_CONVERTING && them == myRequestNode) continue;
-	if(myRequestNode->status == L_CONVERTING && them->status == L_WAITING) break;
+	    for (myRequest = PHYSICAL_PTR(lBucket->queue); myRequest != NULL; myRequest = PHYSICAL_PTR(myRequest->next)) {
 
-	if(them == myRequestNode && myRequestNode->status == L_WAITING &&
-	   ((LockBucket_Type*)PHYSICAL_PTR(myRequestNode->lockHDR))->status != L_CONVERTING){
-	    if(lm_perProcessDSptr->LOCK_compatible[myRequestNode->mode][((LockBucket_Type*)PHYSICAL_PTR(myRequestNode->lockHDR))->groupMode]){
-		e = wakeup_nextRequest(handle, (LockBucket_Type*)PHYSICAL_PTR(myRequestNode->lockHDR));
-		if(e < eNOERROR) ERR(handle, e);
+		if (myRequest->status != L_WAITING && myRequest->status != L_CONVERTING) continue;
+
+		/* a waiting request compatible with the group mode may have missed its wakeup */
+		if (myRequest->status == L_WAITING &&
+		    lm_perProcessDSptr->LOCK_compatible[myRequest->mode][lBucket->groupMode]) {
+		    e = wakeup_nextRequest(handle, lBucket);
+		    if (e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &lockHashEntryPtr->latch);
+
+		    if (myRequest->status == L_GRANTED) continue;
+		}
+
+		/* add the node for myRequest */
+		if (*nNodes == nodes->nEntries) {
+		    e = Util_doublesizeVarArray(handle, nodes, sizeof(lm_WFGNode));
+		    if (e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &lockHashEntryPtr->latch);
+		}
+
+		node = &((lm_WFGNode*)nodes->ptr)[(*nNodes)++];
+		node->xactID = myRequest->xactID;
+		node->level = lBucket->level;
+		node->target = lBucket->target;
+		node->hashValue = i;
+		node->firstEdge = *nEdges;
+		node->nEdges = 0;
+
+		e = lm_costEvaluation(handle, PHYSICAL_PTR(myRequest->xactBucketPtr), &node->cost);
+		if (e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &lockHashEntryPtr->latch);
+
+		/* add the edges to the transactions blocking myRequest */
+		for (them = lm_nextBlocker(myRequest, NULL); them != NULL; them = lm_nextBlocker(myRequest, them)) {
+
+		    if (*nEdges == edges->nEntries) {
+			e = Util_doublesizeVarArray(handle, edges, sizeof(lm_WFGEdge));
+			if (e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &lockHashEntryPtr->latch);
+		    }
+
+		    edge = &((lm_WFGEdge*)edges->ptr)[(*nEdges)++];
+		    edge->xactID = them->xactID;
+		    edge->to = NIL;
+
+		    node->nEdges++;
+		}
 	    }
-	    break;
+
+	    e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
+	    if (e < eNOERROR) ERRL1(handle, e, &lockHashEntryPtr->latch);
 	}
 
-	if(lm_perProcessDSptr->LOCK_compatible[myRequestNode->mode][them->mode] && 
-	   them->status != L_WAITING && them->status != L_CONVERTING) continue;
-	else if((them->status == L_WAITING || them->status == L_CONVERTING) &&  myRequestNode->mode == them->mode) continue;
+	e = SHM_releaseLatch(handle, &lockHashEntryPtr->latch, procIndex);
+	if (e < eNOERROR) ERR(handle, e);
+    }
 
-        if(PHYSICAL_PTR(me->waitingLock) == NULL) break;
+    return(eNOERROR);
+}
 
-	him = PHYSICAL_PTR(them->xactBucketPtr);
-	me->waitingfor = LOGICAL_PTR(him);
 
-	if(PHYSICAL_PTR(him->waitingfor) != NULL) {
 
-    	    /* deadlock !!
-     	     * It is needed to select a victim to solve the deadlock
-     	     */
-    	    minCost = deadlockStack[*deadlockStack_Top-1].cost;
-    	    victimCandidateIndex = *deadlockStack_Top-1;
+/*@================================
+ * lm_searchCycles()
+ *================================*/
+/* ------------------------------------------------------------ */
+/*                                                              */
+/* lm_searchCycles ::                                           */
+/*      find the cycles of the waits-for graph by the depth	*/
+/*      first search and resolve them one by one		*/
+/*                                                              */
+/* paprameters                                                  */
+/*    lm_WFGNode  IN nodes sorted by the transaction id		*/
+/*    Four        IN # of nodes					*/
+/*    lm_WFGEdge  IN edges					*/
+/*                                                              */
+/* return value                                                 */
+/*    error code 						*/
+/*                                                              */
+/* ------------------------------------------------------------ */
+Four lm_searchCycles(
+    Four			handle,
+    lm_WFGNode 			*nodes,			/* IN nodes of the graph */
+    Four 			nNodes,			/* IN # of nodes */
+    lm_WFGEdge 			*edges)			/* IN edges of the graph */
+{
+    Four 			e;			/* error code */
+    Four 			i, j;			/* index for loop */
+    VarArray 			stack;			/* path of the depth first search */
+    Four 			*path;			/* stack.ptr */
+    Four 			top;			/* top of the stack */
+    Four 			v, w;			/* nodes of an edge */
+    Four 			bottom;			/* stack index of the first node of the cycle */
+    Four 			victim;			/* index of the victim in the cycle */
+    Boolean 			restart;		/* TRUE if a cycle is resolved */
+
+
+    e = Util_initVarArray(handle, &stack, sizeof(Four), nNodes);
+    if (e < eNOERROR) ERR(handle, e);
+    path = (Four*)stack.ptr;
+
+    for (i = 0; i < nNodes; i++) nodes[i].state = LM_WFG_NEW;
+
+    do {
+	restart = FALSE;
+
+	for (i = 0; i < nNodes; i++) {
+	    if (nodes[i].state == LM_WFG_REMOVED) continue;
+	    nodes[i].state = LM_WFG_NEW;
+	    nodes[i].nextEdge = 0;
+	}
+
+	for (i = 0; i < nNodes && !restart; i++) {
+
+	    if (nodes[i].state != LM_WFG_NEW) continue;
+
+	    top = 0;
+	    path[top] = i;
+	    nodes[i].state = LM_WFG_ONSTACK;
+
+	    while (top >= 0) {
+
+		v = path[top];
 
-    	    /* we should include 'him'. */
-    	    for (i = *deadlockStack_Top-2; deadlockStack[i+1].xactBucket != him; i--) {
-		if (minCost > deadlockStack[i].cost) {
-	    	    minCost = deadlockStack[i].cost;
-	    	    victimCandidateIndex = i;
+		/* all the edges of v are followed */
+		if (nodes[v].nextEdge == nodes[v].nEdges) {
+		    nodes[v].state = LM_WFG_DONE;
+		    top--;
+		    continue;
 		}
-    	    }
+
+		w = edges[nodes[v].firstEdge + nodes[v].nextEdge++].to;
+
+		/* the blocking transaction does not wait */
+		if (w == NIL) continue;
+
+		if (nodes[w].state == LM_WFG_NEW) {
+		    path[++top] = w;
+		    nodes[w].state = LM_WFG_ONSTACK;
+		    continue;
+		}
+
+		if (nodes[w].state != LM_WFG_ONSTACK) continue;
+
+		/* deadlock !! path[bottom..top] is a cycle */
+		for (bottom = top; path[bottom] != w; bottom--);
+
+		/* select the victim which has the minimal cost */
+		victim = bottom;
+		for (j = bottom+1; j <= top; j++)
+		    if (nodes[path[j]].cost < nodes[path[victim]].cost) victim = j;
+
 #ifdef TRACE
-	    for (i = *deadlockStack_Top-1; deadlockStack[i+1].xactBucket != him; i--) {
-		printf("Transaction %ld: cost %ld\n", deadlockStack[i].xactBucket->xactID.low, deadlockStack[i].cost);
-	    }
+		for (j = bottom; j <= top; j++)
+		    printf("Transaction %ld: cost %ld\n", nodes[path[j]].xactID.low, nodes[path[j]].cost);
 #endif /* TRACE */
-    	    /* Now, we decide the victim */
-    	    victim = deadlockStack[victimCandidateIndex].xactBucket;
 
-            /* check variables */
-            if (victimCandidateIndex >= MAXDEADLOCKCHAIN) ERR(handle, eINTERNAL);
-            if (victim == NULL) ERR(handle, eINTERNAL);
-            if (PHYSICAL_PTR(victim->waitingLock) == NULL) ERR(handle, eINTERNAL);
+		e = lm_resolveDeadlock(handle, nodes, &path[bottom], top-bottom+1, victim-bottom);
+		if (e < eNOERROR) {
+		    (void) Util_finalVarArray(handle, &stack);
+		    ERR(handle, e);
+		}
 
-            /* find the request node */
-            victimWait = PHYSICAL_PTR( ((LockBucket_Type*)PHYSICAL_PTR(victim->waitingLock))->queue);
-            while (1) {
+		/* the victim leaves the graph even if the cycle has gone; search again */
+		nodes[path[victim]].state = LM_WFG_REMOVED;
+		restart = TRUE;
+		break;
+	    }
+	}
 
-                if (victimWait == NULL) break;
-                if (PHYSICAL_PTR(victimWait->xactBucketPtr) == victim) break;
+    } while (restart);
 
-                victimWait = PHYSICAL_PTR(victimWait->next);
-            }
+    e = Util_finalVarArray(handle, &stack);
+    if (e < eNOERROR) ERR(handle, e);
 
-#ifdef DEBUG
-   	    if(victimWait == NULL){
-		/* error */
-		/* This error may not happen */
-		printf("Victim is not waiting..\n");
-	    }
-#endif /* DEBUG */
+    return(eNOERROR);
+}
+
+
+
+/*@================================
+ * lm_resolveDeadlock()
+ *================================*/
+/* ------------------------------------------------------------ */
+/*                                                              */
+/* lm_resolveDeadlock ::                                        */
+/*      validate a cycle of the snapshot against the lock table	*/
+/*      and abort the victim if the cycle still exists		*/
+/*                                                              */
+/* paprameters                                                  */
+/*    lm_WFGNode  IN nodes of the graph				*/
+/*    Four        IN node indexes of the cycle; cycle[k] waits	*/
+/*                   for cycle[k+1] and the last one for cycle[0] */
+/*    Four        IN # of nodes in the cycle			*/
+/*    Four        IN index of the victim in the cycle		*/
+/*                                                              */
+/* return value                                                 */
+/*    error code 						*/
+/*                                                              */
+/* ------------------------------------------------------------ */
+Four lm_resolveDeadlock(
+    Four			handle,
+    lm_WFGNode 			*nodes,			/* IN nodes of the graph */
+    Four 			*cycle,			/* IN nodes of the cycle */
+    Four 			nMembers,		/* IN # of nodes in the cycle */
+    Four 			victim)			/* IN victim in the cycle */
+{
+    Four 			e, e2;			/* error code */
+    Four 			k;			/* index for loop */
+    lm_WFGNode 			*node;			/* a node of the cycle */
+    LockHashEntry 		*lockHashEntryPtr;	/* lock hash chain of the node */
+    LockBucket_Type 		*lBucket;		/* lock bucket of the node */
+    RequestNode_Type 		*them;			/* a request node in lBucket */
+    VarArray 			requestArray;		/* request nodes of the cycle */
+    RequestNode_Type 		**requests;		/* requestArray.ptr */
+    VarArray 			latchArray;		/* latches held */
+    LATCH_TYPE 			**latches;		/* latchArray.ptr */
+    Four 			nLatches;		/* # of latches held */
+    Boolean 			valid;			/* TRUE if the cycle still exists */
+    RequestNode_Type 		*victimWait;		/* request node of the victim */
+    XactBucket_Type 		*victimBucket;		/* transaction bucket of the victim */
+    cosmos_thread_sem_t 	*semID;			/* semaphore No of the victim */
+
+
+    e = Util_initVarArray(handle, &requestArray, sizeof(RequestNode_Type*), nMembers);
+    if (e < eNOERROR) ERR(handle, e);
+    requests = (RequestNode_Type**)requestArray.ptr;
+
+    e = Util_initVarArray(handle, &latchArray, sizeof(LATCH_TYPE*), 2*nMembers);
+    if (e < eNOERROR) {
+	(void) Util_finalVarArray(handle, &requestArray);
+	ERR(handle, e);
+    }
+    latches = (LATCH_TYPE**)latchArray.ptr;
+    nLatches = 0;
+
+    /*
+     * Latch the lock buckets of the cycle. The latches are requested
+     * conditionally since they are not acquired in the latch order; if one
+     * of them is busy the cycle is left to the next detection.
+     */
+    valid = TRUE;
+    for (k = 0; k < nMembers && valid; k++) {
+
+	node = &nodes[cycle[k]];
+	lockHashEntryPtr = &LM_LOCKHASHTABLE[node->hashValue];
+
+	e = SHM_getLatch(handle, &lockHashEntryPtr->latch, procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+	if (e < eNOERROR) break;
+	if (e == SHM_BUSYLATCH) { valid = FALSE; break; }
+	latches[nLatches++] = &lockHashEntryPtr->latch;
+
+	for (lBucket = PHYSICAL_PTR(lockHashEntryPtr->bucketPtr); lBucket != NULL; lBucket = PHYSICAL_PTR(lBucket->next))
+	    if (lBucket->level == node->level && EQUAL_TARGETID(lBucket->target, (&node->target), node->level)) break;
+
+	if (lBucket == NULL) { valid = FALSE; break; }
+
+	e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+	if (e < eNOERROR) break;
+	if (e == SHM_BUSYLATCH) { valid = FALSE; break; }
+	latches[nLatches++] = &lBucket->latch;
+
+	/* the transaction should still wait for the lock */
+	for (them = PHYSICAL_PTR(lBucket->queue); them != NULL; them = PHYSICAL_PTR(them->next))
+	    if (EQUAL_XACTID(them->xactID, node->xactID)) break;
+
+	if (them == NULL || (them->status != L_WAITING && them->status != L_CONVERTING)) valid = FALSE;
+
+	requests[k] = them;
+    }
+
+    /* each transaction of the cycle should still be blocked by the next one */
+    if (e >= eNOERROR && valid) {
+	for (k = 0; k < nMembers && valid; k++) {
+
+	    node = &nodes[cycle[(k+1) % nMembers]];
+
+	    for (them = lm_nextBlocker(requests[k], NULL); them != NULL; them = lm_nextBlocker(requests[k], them))
+		if (EQUAL_XACTID(them->xactID, node->xactID)) break;
+
+	    if (them == NULL) valid = FALSE;
+	}
+    }
+
+    /* deadlock !! abort the victim */
+    if (e >= eNOERROR && valid) {
+
+	victimWait = requests[victim];
+	victimBucket = PHYSICAL_PTR(victimWait->xactBucketPtr);
+	lBucket = PHYSICAL_PTR(victimWait->lockHDR);
 
-	    /* It is needed to abort the victim */
 #ifdef TRACE
-	    printf("\nvictim is %ld\n", victim->xactID.low);
+	printf("\nvictim is %ld\n", victimBucket->xactID.low);
 #endif /* TRACE */
 
- 	    /* Save the Semaphore ID of the victim. */
-   	    semID = &(((TCB*)PHYSICAL_PTR(victimWait->xcbPtr))->semID);
+	/* Save the Semaphore ID of the victim. */
+	semID = &(((TCB*)PHYSICAL_PTR(victimWait->xcbPtr))->semID);
 
-            /* change lock bucket information */
-	    ((LockBucket_Type*)PHYSICAL_PTR(victimWait->lockHDR))->nWaiting--; 
+	/* change lock bucket information */
+	lBucket->nWaiting--;
 
-	    /* Disconnect/Update the request node. */
-	    if (victimWait->status == L_WAITING) {
-		/* disconnect that request node from the corresponding queue */
-		DELETE_FROM_REQUESTNODE_DLIST(((LockBucket_Type*)PHYSICAL_PTR(victimWait->lockHDR))->queue, victimWait);
+	/* Disconnect/Update the request node. */
+	if (victimWait->status == L_WAITING) {
+	    /* disconnect that request node from the corresponding queue */
+	    DELETE_FROM_REQUESTNODE_DLIST(lBucket->queue, victimWait);
 
-                /* release Request Node */
-		FREE_REQUESTNODE(handle, victimWait);
+	    /* release Request Node */
+	    e = Util_freeElementToPool(handle, &LM_REQUESTNODEPOOL(victimWait->partitionNo), victimWait);
 
-		lBucket = (LockBucket_Type*)PHYSICAL_PTR(victimWait->lockHDR);
-            	if (( e = wakeup_nextRequest(handle, lBucket)) < eNOERROR)
-			ERR(handle, e);
+	    if (e >= eNOERROR) e = wakeup_nextRequest(handle, lBucket);
 
-	    } else { /* L_CONVERTING */
+	} else { /* L_CONVERTING */
 
-		/* revert to the original granted node. */
-		victimWait->mode = victimWait->oldMode;
-		victimWait->status = L_GRANTED;
-	    }
+	    /* revert to the original granted node. */
+	    victimWait->mode = victimWait->oldMode;
+	    victimWait->status = L_GRANTED;
+	}
 
+	if (e >= eNOERROR) {
 	    /* Set the victim-selected transaction's 'waitingLock' to NULL */
-	    victim->waitingLock = LOGICAL_PTR(NULL);
+	    victimBucket->waitingLock = LOGICAL_PTR(NULL);
 
 	    /* Set the victim-selected transaction's status to X_DEADLOCK. */
-	    victim->status = X_DEADLOCK;
+	    victimBucket->status = X_DEADLOCK;
 
 	    /* Wake up the victim. */
 	    e = SHM_semSignal(handle, semID);
-	    if (e < eNOERROR) ERR(handle, e);
+	}
+    }
 
+    /* release the latches in the reverse order */
+    while (nLatches > 0) {
+	e2 = SHM_releaseLatch(handle, latches[--nLatches], procIndex);
+	if (e2 < eNOERROR && e >= eNOERROR) e = e2;
+    }
 
-	    victim->deadlockVisit = 1;
+    (void) Util_finalVarArray(handle, &requestArray);
+    (void) Util_finalVarArray(handle, &latchArray);
 
-	    *victimIndex = victimCandidateIndex;
-	    *deadlockStatus = DLS_DEADLOCK;
+    if (e < eNOERROR) ERR(handle, e);
 
-	    /* pop the entry from the deadlockStack */
-	    (*deadlockStack_Top)--;
-	    me->waitingfor = LOGICAL_PTR(NULL);
+    return(eNOERROR);
+}
 
-	    return(eNOERROR);
 
-	}else {
-	    /* recursively call */
-	    e = lm_detectCycle(handle, him, deadlockStack,
-                               deadlockStack_Top,  deadlockStatus, victimIndex);
-	    if (e < eNOERROR) ERR(handle, e);
 
-	    /* if deadlock, pop the stack entry until the victim is popped */
-	    if ((*deadlockStatus == DLS_DEADLOCK) && (*victimIndex <= *deadlockStack_Top - 1)){
-		(*deadlockStack_Top)--;
-		me->waitingfor = LOGICAL_PTR(NULL);
-		return(eNOERROR);
-	    }
-	}
+/*@================================
+ * lm_nextBlocker()
+ *================================*/
+/* ------------------------------------------------------------ */
+/*                                                              */
+/* lm_nextBlocker ::                                            */
+/*      find the next request node blocking a waiting request	*/
+/*      this function is called with the latch of the lock bucket */
+/*                                                              */
+/* paprameters                                                  */
+/*    RequestNode_Type  IN waiting(or converting) request node	*/
+/*    RequestNode_Type  IN previous blocking request node; NULL	*/
+/*                         to find the first one		*/
+/*                                                              */
+/* return value                                                 */
+/*    next blocking request node; NULL if there is no more	*/
+/*                                                              */
+/* ------------------------------------------------------------ */
+RequestNode_Type *lm_nextBlocker(
+    RequestNode_Type 		*myRequestNode,		/* IN waiting request node */
+    RequestNode_Type 		*them)			/* IN previous blocking request node */
+{
+    if (them == NULL)
+	them = PHYSICAL_PTR(((LockBucket_Type*)PHYSICAL_PTR(myRequestNode->lockHDR))->queue);
+    else
+	them = PHYSICAL_PTR(them->next);
 
-	me->waitingfor = LOGICAL_PTR(NULL);
+    for ( ; them != NULL; them = PHYSICAL_PTR(them->next)) {
 
-    }
+	/* a converting request waits for the granted and converting requests */
+	if (myRequestNode->status == L_CONVERTING && them == myRequestNode) continue;
+	if (myRequestNode->status == L_CONVERTING && them->status == L_WAITING) break;
 
-    me->deadlockVisit = 1;
-    *deadlockStatus = DLS_OK;
+	/* a waiting request waits for the requests ahead of it */
+	if (them == myRequestNode) break;
 
-    /* pop the entry from deadlock Stack */
-    (*deadlockStack_Top)--; 
+	if (lm_perProcessDSptr->LOCK_compatible[myRequestNode->mode][them->mode] &&
+	    them->status != L_WAITING && them->status != L_CONVERTING) continue;
+	else if ((them->status == L_WAITING || them->status == L_CONVERTING) && myRequestNode->mode == them->mode) continue;
 
+	return(them);
+    }
 
-    return(eNOERROR);
+    return(NULL);
 }
 
 
@@ -418,3 +665,59 @@ Four lm_costEvaluation(
 
     return(eNOERROR);
 }
+
+
+
+/*
+ * Function: int lm_compareWFGNodes(const void*, const void*)
+ *
+ * Description :
+ *  Compare two nodes of the waits-for graph by their transaction ids;
+ *  used by qsort().
+ */
+static int lm_compareWFGNodes(
+    const void *n1,		/* IN first node */
+    const void *n2)		/* IN second node */
+{
+    const XactID *x1 = &((const lm_WFGNode *)n1)->xactID;
+    const XactID *x2 = &((const lm_WFGNode *)n2)->xactID;
+
+
+    if (XACTID_CMP_LT(*x1, *x2)) return(-1);
+    if (XACTID_CMP_GT(*x1, *x2)) return(1);
+
+    return(0);
+}
+
+
+
+/*
+ * Function: Four lm_findWFGNode(lm_WFGNode*, Four, XactID*)
+ *
+ * Description :
+ *  Find the node of the given transaction by the binary search.
+ *
+ * Returns:
+ *  index of the node; NIL if the transaction does not wait
+ */
+static Four lm_findWFGNode(
+    lm_WFGNode *nodes,		/* IN nodes sorted by the transaction id */
+    Four nNodes,		/* IN # of nodes */
+    XactID *xactID)		/* IN transaction to find */
+{
+    Four low, high, mid;
+
+
+    for (low = 0, high = nNodes-1; low <= high; ) {
+	mid = (low + high) / 2;
+
+	if (XACTID_CMP_EQ(nodes[mid].xactID, *xactID)) return(mid);
+
+	if (XACTID_CMP_LT(nodes[mid].xactID, *xactID))
+	    low = mid + 1;
+	else
+	    high = mid - 1;
+    }
+
+    return(NIL);
+}
@@ -132,9 +132,9 @@ printf("+---------------------------------------------+\n");
 
 #define PRINT_XACT(xb)\
 printf("\n+--------------------------------------+\n");\
-printf("| status | waitingLock | waitingfor    |\n");\
+printf("| status | waitingLock | maxLowLocks   |\n");\
 printf("+--------------------------------------+\n");\
-printf("|%5ld   | %7P    | %9P  |\n", (xb)->status, (xb)->waitingLock, (xb)->waitingfor);\
+printf("|%5ld   | %7P    | %9ld  |\n", (xb)->status, (xb)->waitingLock, (xb)->maxLowLocks);\
 printf("+--------------------------------------+\n");
 
 
@@ -255,7 +255,7 @@ Four LM_dumpXactLock(XactID *xactID)
 
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     printf("\nGranted Lock of Transaction ");PRINT_XACTID(*xactID);
     PRINT_XACT(xBucket);
@@ -161,8 +161,11 @@ Four LM_initLockTBL(
     register Four	i;
 
 
-    Util_initPool(handle, &LM_REQUESTNODEPOOL, sizeof(RequestNode_Type),MAXREQUESTNODE);
-    Util_initPool(handle, &LM_LOCKBUCKETPOOL, sizeof(LockBucket_Type), MAXLOCKBUCKET);
+    /* each partition starts with a subpool and grows by a subpool on demand */
+    for( i = 0; i < LM_NUM_PARTITIONS; i++) {
+	Util_initPool(handle, &LM_REQUESTNODEPOOL(i), sizeof(RequestNode_Type), LM_REQUESTNODE_SUBPOOL_SIZE);
+	Util_initPool(handle, &LM_LOCKBUCKETPOOL(i), sizeof(LockBucket_Type), LM_LOCKBUCKET_SUBPOOL_SIZE);
+    }
     Util_initPool(handle, &LM_XACTBUCKETPOOL, sizeof(XactBucket_Type), MAXXACTBUCKET);
 
     SHM_initLatch(handle, &LM_LATCH);
@@ -194,9 +197,13 @@ Four LM_cleanupLockTBL(
     Four    	handle
 )
 {
+    register Four	i;
 
-    Util_finalPool(handle, &LM_REQUESTNODEPOOL);
-    Util_finalPool(handle, &LM_LOCKBUCKETPOOL);
+
+    for( i = 0; i < LM_NUM_PARTITIONS; i++) {
+	Util_finalPool(handle, &LM_REQUESTNODEPOOL(i));
+	Util_finalPool(handle, &LM_LOCKBUCKETPOOL(i));
+    }
     Util_finalPool(handle, &LM_XACTBUCKETPOOL);
 
     return(eNOERROR);
@@ -141,13 +141,9 @@ Four LM_logLocksOfPreparedXact(
     /* get my transaction table entry */
     xactEntry = MY_XACT_TABLE_ENTRY(handle);
 
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, L_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /* search the lockBucket from xBucket->grantedList[L_FILE] to xBucket->grantedList[L_OBJECT] */
     /* NOTE: we must get file locks first later for lock hierachy */
@@ -161,7 +157,7 @@ Four LM_logLocksOfPreparedXact(
 
             /* request latch for access the lockBucket */
             e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, L_UNCONDITIONAL, NULL);
-            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+            if (e < eNOERROR) ERR(handle, e);
 
 	    /* fill the bufOfLockTableInfo */
 	    bufOfLockTableInfo[nLocks].target  = lBucket->target;
@@ -186,7 +182,7 @@ Four LM_logLocksOfPreparedXact(
 
 	    /* release latch for the lockBucket */
             e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+            if (e < eNOERROR) ERR(handle, e);
 
             /* For access next granted request node */
             aRequest = PHYSICAL_PTR(aRequest->nextGrantedEntry);
@@ -200,7 +196,7 @@ Four LM_logLocksOfPreparedXact(
                                       nLocks*sizeof(LOG_Image_LM_LocksOfPreparedXact_T), bufOfLockTableInfo);
 
                 e = LOG_WriteLogRecord(handle, xactEntry, &logRecInfo, &lsn, &logRecLen);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
 
                 nLocks = 0;
             } /* if */
@@ -215,13 +211,9 @@ Four LM_logLocksOfPreparedXact(
                               nLocks*sizeof(LOG_Image_LM_LocksOfPreparedXact_T), bufOfLockTableInfo);
 
         e = LOG_WriteLogRecord(handle, xactEntry, &logRecInfo, &lsn, &logRecLen);
-        if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+        if (e < eNOERROR) ERR(handle, e);
     }
 
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
 
     return(eNOERROR);
 }
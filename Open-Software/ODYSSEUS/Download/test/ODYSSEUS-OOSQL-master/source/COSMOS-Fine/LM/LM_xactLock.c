@@ -127,14 +127,9 @@ Four LM_releaseXactLock(
     LockLevel           tmpLevel;
     Seed        	tempSeed;   /* temp seed */
 
-    /*@ get latch */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /*
     ** first release Page Lock and then release File Lock
@@ -154,7 +149,7 @@ Four LM_releaseXactLock(
             /* request latch for access the lockBucket */
             e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE,
                              M_UNCONDITIONAL, NULL);
-            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+            if (e < eNOERROR) ERR(handle, e);
 
             DELETE_FROM_REQUESTNODE_DLIST(lBucket->queue, aRequest);
             DELETE_FROM_REQUESTNODE_DLIST2(xBucket->grantedList[tmpLevel], aRequest);
@@ -166,10 +161,6 @@ Four LM_releaseXactLock(
             if (e < 0) {
 
                 e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-                /* release lmLatch */
-                e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
                 if (e2 < 0) ERR(handle, e2);
 
                 ERR(handle, e);
@@ -178,7 +169,7 @@ Four LM_releaseXactLock(
             if (PHYSICAL_PTR(lBucket->queue)) {
 
                 e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
             }
             else {			/* delete lBucket */
 
@@ -186,7 +177,7 @@ Four LM_releaseXactLock(
                 lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH(lBucket->target, tempSeed, tmpLevel)];
 
                 e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
 
             }
             aRequest = PHYSICAL_PTR(xBucket->grantedList[tmpLevel]);
@@ -196,11 +187,6 @@ Four LM_releaseXactLock(
         tmpLevel++;
     }
 
-    /*@ release latch */
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 }
 
@@ -238,15 +224,10 @@ Four LM_releaseXactManualFlatLock(
     Seed        	tempSeed;  /* temp seed */
 
 
-    /*@ get latch */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /*@ find the requested ones */
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
 
     /*@ release locks */
@@ -265,7 +246,7 @@ Four LM_releaseXactManualFlatLock(
 	/* request latch for access the lockBucket */
 
 	e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
         DELETE_FROM_REQUESTNODE_DLIST(lBucket->queue, aRequest);
         DELETE_FROM_REQUESTNODE_DLIST2(xBucket->grantedList[level], aRequest);
@@ -277,17 +258,13 @@ Four LM_releaseXactManualFlatLock(
 	    e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
 	    if (e2 < 0) ERR(handle, e2);
 
-	    /* release lmLatch */
-	    e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	    if (e2 < 0) ERR(handle, e2);
-
 	    ERR(handle, e);
 	}
 
 	if (PHYSICAL_PTR(lBucket->queue)) { 
 
 	    e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	    if (e < eNOERROR) ERR(handle, e);
 	}
 	else {
 
@@ -295,7 +272,7 @@ Four LM_releaseXactManualFlatLock(
             lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH(lBucket->target, tempSeed, level)]; 
 
 	    e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	    if (e < eNOERROR) ERR(handle, e);
 	}
 	aRequest = PHYSICAL_PTR(xBucket->grantedList[level]);
 
@@ -304,13 +281,8 @@ Four LM_releaseXactManualFlatLock(
 
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-    /*@ release latch */
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 }
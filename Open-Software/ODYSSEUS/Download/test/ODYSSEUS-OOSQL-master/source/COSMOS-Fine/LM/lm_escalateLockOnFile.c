@@ -119,27 +119,19 @@ Four lm_escalateLockOnFile(
     Seed        	tempSeed;		/* temp seed */
 
 
-    /*@ get latch  */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /*@ get the file lock on the given file */
     e = lm_getLock(handle, xactID, (TargetID*)fileID, L_FILE, NULL, mode, duration, conditional,
                    TRUE, lockReply, &xBucket, &flBucket, &oldMode); 
-    if(e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if(e < eNOERROR) ERR(handle, e);
 
     switch(*lockReply){
       case LR_NOTOK:
         /*
         ** Oh! I didn't escalate the lock on the given file..
-        ** Release the LM_LATCH and return
+        ** Just return
         */
-        e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-        if(e < eNOERROR) ERR(handle, e);
-
 		return(LR_NOTOK);
-      case LR_DEADLOCK:  ERRL1(handle, eDEADLOCK, &LM_LATCH);
+      case LR_DEADLOCK:  ERR(handle, eDEADLOCK);
       default: break; /* go ahead */
     }
 
@@ -163,7 +155,7 @@ Four lm_escalateLockOnFile(
 
 	/* request latch for access the lockBucket */
 	e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/* save the pointer */
 	nextRequest = PHYSICAL_PTR(aRequest->nextGrantedEntry);
@@ -194,10 +186,6 @@ Four lm_escalateLockOnFile(
 	if (e < 0) {
 
 	    e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	    if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-	    /* release lmLatch */
-	    e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
 	    if (e2 < 0) ERR(handle, e2);
 
 	    ERR(handle, e);
@@ -206,7 +194,7 @@ Four lm_escalateLockOnFile(
 	if (PHYSICAL_PTR(lBucket->queue)) {
 
 	    e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	    if (e < eNOERROR) ERR(handle, e);
 	}
 	else {			/* delete lBucket */
 
@@ -214,17 +202,12 @@ Four lm_escalateLockOnFile(
 	    lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH(lBucket->target, tempSeed, L_OBJECT)];
 
 	    e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	    if (e < eNOERROR) ERR(handle, e);
 
 	}
 
     }
 
-    /*@ release latch */
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 }
 
@@ -139,20 +139,15 @@ Four lm_getLock(
     *outLBucket = NULL;
     higherRequest = NULL;
 
-    /*@ get latch  */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
     /*@ find the requested ones */
 
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /* set the OUT parameter */
     *xactBucket = xBucket;
@@ -169,7 +164,7 @@ Four lm_getLock(
 
        	    /* request latch for access the lockBucket */
        	    e = SHM_getLatch(handle, &higherLockBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-       	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+       	    if (e < eNOERROR) ERR(handle, e);
 
        	    switch ( lm_perProcessDSptr->LOCK_hierarchy[higherRequest->mode][mode] ) {
 
@@ -177,20 +172,16 @@ Four lm_getLock(
 
        	   	case NONEED :
        	     	    e = SHM_releaseLatch(handle, &higherLockBucket->latch, procIndex);
-       	            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+       	            if (e < eNOERROR) ERR(handle, e);
 
        	            /* return OK result */
        	            *lockReply = LR_NL;
 
-       	            /* release lmLatch */
-       	            e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-       	            if (e < eNOERROR) ERR(handle, e);
-
        	            return(eNOERROR);
 
        	   	case NOTOK  :
        	            e = SHM_releaseLatch(handle, &higherLockBucket->latch, procIndex);
-       	            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+       	            if (e < eNOERROR) ERR(handle, e);
 
 #ifdef TRACE
        	            printf("violate lock hierarchy\n");
@@ -198,11 +189,11 @@ Four lm_getLock(
        	            /* return NOTOK result */
        	            *lockReply = LR_NOTOK;
 
-      	            ERRL1(handle, eLOCKHIERARCHYVIOLATE_LM, &LM_LATCH);
+      	            ERR(handle, eLOCKHIERARCHYVIOLATE_LM);
 
        	   	default	    :	/* impossible case */
 
-       	     	    ERRL2(handle, eWRONGLOCKMODE_LM, &higherLockBucket->latch, &LM_LATCH);
+       	     	    ERRL1(handle, eWRONGLOCKMODE_LM, &higherLockBucket->latch);
 
        	            /* case OK : keep the lock hierarchy protocol */
        	    }
@@ -210,7 +201,7 @@ Four lm_getLock(
        	    /* NO LockBucket LATCH EXISTS when find_lockBucket() is executed */
        	    /* deadlock avoidance between latches */
        	    e = SHM_releaseLatch(handle, &higherLockBucket->latch, procIndex);
-       	    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+       	    if (e < eNOERROR) ERR(handle, e);
 	}
 	else 
 	    higherLockBucket = NULL;
@@ -221,7 +212,7 @@ Four lm_getLock(
     lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH((*lockID), tempSeed, level)];
     e = lm_findLockBucketAndRequestNode(handle, xactID, lockID, level, lockHashEntryPtr,
                                         &lBucket, &aRequest);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /* CASE 1 : First request and No wait case */
     if (!(lBucket) ||
@@ -233,11 +224,11 @@ Four lm_getLock(
 	/* for a INSTANT duration lock, check only that there is no conflicts */
 	if (duration == L_INSTANT) {
 	    if (lBucket) {
-	        INSTANT_DURATION_HANDLING(handle, lBucket->latch, LM_LATCH, 
+	        INSTANT_DURATION_HANDLING(handle, lBucket->latch, 
 			                  xBucket->nLock[level], *lockReply);
 	    }
 	    else {
-	        INSTANT_DURATION_HANDLING(handle, lockHashEntryPtr->latch, LM_LATCH, 
+	        INSTANT_DURATION_HANDLING(handle, lockHashEntryPtr->latch, 
 			                  xBucket->nLock[level], *lockReply);
 	    }
 	}
@@ -247,14 +238,14 @@ Four lm_getLock(
             /* allocate new lock bucket and initialize it */
             e = lm_allocAndInitLockBucket(handle, level, lockID,
                                           lockHashEntryPtr, &lBucket);
-            if(e < eNOERROR) ERRL2(handle, e, &lockHashEntryPtr->latch, &LM_LATCH);
+            if(e < eNOERROR) ERRL1(handle, e, &lockHashEntryPtr->latch);
 
             /* to keep consistent status get the next latch before release prev. one */
             e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-            if (e < eNOERROR) ERRL2(handle, e, &lockHashEntryPtr->latch, &LM_LATCH);
+            if (e < eNOERROR) ERRL1(handle, e, &lockHashEntryPtr->latch);
 
             e = SHM_releaseLatch(handle, &lockHashEntryPtr->latch, procIndex);
-            if (e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &LM_LATCH);
+            if (e < eNOERROR) ERRL1(handle, e, &lBucket->latch);
 
             /* deadlock prevention between latches */
             /* LATCH sequence :: lowerLock -> higherLock */
@@ -273,7 +264,7 @@ Four lm_getLock(
 	/* allocate and fill the new RequestNode  */
 	e = lm_allocAndInsertIntoQueue(handle, xactID, xBucket, lBucket,
                                        mode, duration, L_GRANTED, &aRequest);
-        if(e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &LM_LATCH);
+        if(e < eNOERROR) ERRL1(handle, e, &lBucket->latch);
 
         if(level == L_PAGE || level == L_OBJECT)
             aRequest->higherRequestNode = LOGICAL_PTR(higherRequest);
@@ -281,7 +272,7 @@ Four lm_getLock(
 	lBucket->groupMode = lm_perProcessDSptr->LOCK_supreme[lBucket->groupMode][mode];
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/* update XactBucket */
         xBucket->status = X_NORMAL;
@@ -298,14 +289,9 @@ Four lm_getLock(
         *outLBucket = lBucket; 
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-	/*@ release latch */
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	if (e < eNOERROR) ERR(handle, e);
-
 	return(eNOERROR);
     }
 
@@ -322,30 +308,28 @@ Four lm_getLock(
            without allocating Request Node it return NOTOK */
 
         if ( conditional == L_CONDITIONAL ) {
-            CONDITIONAL_LOCK_HANDLING(handle, lBucket->latch, LM_LATCH, *lockReply);
+            CONDITIONAL_LOCK_HANDLING(handle, lBucket->latch, *lockReply);
         }
 
 	*oldModeForReturn = L_NL;
 
         e = lm_allocAndInsertIntoQueue(handle, xactID, xBucket, lBucket, mode,
                                        duration, L_WAITING, &aRequest);
-        if(e < eNOERROR) ERRL2(handle, e, &lBucket->latch, &LM_LATCH);
+        if(e < eNOERROR) ERRL1(handle, e, &lBucket->latch);
 
         if(level == L_PAGE || level == L_OBJECT)
             aRequest->higherRequestNode = LOGICAL_PTR(higherRequest);
 
         lBucket->nWaiting++;
 
-        /* all latch must be released before waiting for semaphore */
-        e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-        if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
-
         /* make the transaction state waiting for requsted lock */
+        /* NOTE: it is set under the latch of lBucket so that the deadlock
+                 detector and wakeup_nextRequest() see a consistent state */
         xBucket->status = X_WAITING;
         xBucket->waitingLock = LOGICAL_PTR(lBucket);
 
-        /* release lmLatch */
-        e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
+        /* all latch must be released before waiting for semaphore */
+        e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
         if (e < eNOERROR) ERR(handle, e);
 
        /* process waits until conflicting transactions release this lock */
@@ -353,11 +337,6 @@ Four lm_getLock(
         if (e < eNOERROR) ERR(handle, e);
 
 
-        /*@ get latch */
-        /* get the lmLatch for deadlock detection */
-        e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-        if (e < eNOERROR) ERR(handle, e);
-
         /* if deadlock detection is executed THEN ... */
         if (xBucket->status == X_DEADLOCK) {
 
@@ -365,20 +344,16 @@ Four lm_getLock(
             *lockReply = LR_DEADLOCK;
 
 #ifdef TRACE
-            e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+            CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-            /* release lmLatch */
-            e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-            if (e < eNOERROR) ERR(handle, e);
-
             return(eNOERROR);
         }
 
         if (duration == L_INSTANT) {
 
             e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-            if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+            if (e < eNOERROR) ERR(handle, e);
 
             /* drop RequestNode and update LockBucket info */
             DELETE_FROM_REQUESTNODE_DLIST(lBucket->queue, aRequest);
@@ -388,11 +363,6 @@ Four lm_getLock(
 
             if (( e = wakeup_nextRequest(handle, lBucket)) < eNOERROR) {
                 e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-                /*@ release latch */
-                /* release lmLatch */
-                e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
                 if (e2 < 0) ERR(handle, e2);
 
                 ERR(handle, e);
@@ -400,16 +370,12 @@ Four lm_getLock(
 
             if (PHYSICAL_PTR(lBucket->queue)) {
                 e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
             }
             else {
                 if (level == L_FILE && PHYSICAL_PTR(lBucket->lowerLock)) {
                     /* if PageLock in this file exist, it violate the lock hierarchy */
                     e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-                    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
-
-                    /* release lmLatch */
-                    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
                     if (e < eNOERROR) ERR(handle, e);
 
                     ERR(handle, eLOCKHIERARCHYVIOLATE_LM);
@@ -417,7 +383,7 @@ Four lm_getLock(
 
 
                 e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-                if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+                if (e < eNOERROR) ERR(handle, e);
 
             }
 
@@ -427,13 +393,9 @@ Four lm_getLock(
             *lockReply = (LockReply)mode;
 
 #ifdef TRACE
-            e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+            CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-            /* release lmLatch */
-            e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-            if (e < eNOERROR) ERR(handle, e);
-
             return(eNOERROR);
         }
 
@@ -452,13 +414,9 @@ Four lm_getLock(
         *lockReply = (LockReply)mode;
 
 #ifdef TRACE
-        e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+        CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-        /* release lmLatch */
-        e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-        if (e < eNOERROR) ERR(handle, e);
-
         return(eNOERROR);
     }
 
@@ -472,7 +430,7 @@ Four lm_getLock(
 
 	/* if instant duration lock, no need to allocate Request Node */
 	if ( duration == L_INSTANT )
-	    INSTANT_DURATION_HANDLING(handle, lBucket->latch, LM_LATCH, 
+	    INSTANT_DURATION_HANDLING(handle, lBucket->latch, 
 		                      xBucket->nLock[level], *lockReply);
 
 	/*@ update the status */
@@ -485,7 +443,7 @@ Four lm_getLock(
 	*lockReply = (LockReply)aRequest->mode;
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/* update XactBucket */
 	xBucket->status = X_NORMAL;
@@ -495,14 +453,9 @@ Four lm_getLock(
 
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-	/*@ release latch */
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	if (e < eNOERROR) ERR(handle, e);
-
 	return(eNOERROR);
     }
 
@@ -521,7 +474,7 @@ Four lm_getLock(
 
 	/* if instant duration lock, no need to allocate Request Node */
 	if ( duration == L_INSTANT )
-	    INSTANT_DURATION_HANDLING(handle, lBucket->latch, LM_LATCH, 
+	    INSTANT_DURATION_HANDLING(handle, lBucket->latch, 
 		                      xBucket->nLock[level], *lockReply);
 
 	/*@ update the status */
@@ -540,7 +493,7 @@ Four lm_getLock(
 	*lockReply = (LockReply)aRequest->mode;
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/* update XactBucket */
 	xBucket->status = X_NORMAL;
@@ -550,13 +503,9 @@ Four lm_getLock(
 
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	if (e < eNOERROR) ERR(handle, e);
-
 	return(eNOERROR);
 
     }
@@ -565,7 +514,7 @@ Four lm_getLock(
 
     /* if conditional lock, just return NOTOK */
     if ( conditional == L_CONDITIONAL )
-        CONDITIONAL_LOCK_HANDLING(handle, lBucket->latch, LM_LATCH, *lockReply);
+        CONDITIONAL_LOCK_HANDLING(handle, lBucket->latch, *lockReply);
 
     /* now, unconditional lock case */
 
@@ -574,7 +523,7 @@ Four lm_getLock(
     if ( convertFlag ) { 
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/* update XactBucket */
 	xBucket->status = X_DEADLOCK;
@@ -583,13 +532,9 @@ Four lm_getLock(
 	*lockReply = LR_DEADLOCK;
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	if (e < eNOERROR) ERR(handle, e);
-
 	return(eNOERROR);
     }
 
@@ -615,30 +560,19 @@ Four lm_getLock(
 
     lBucket->nWaiting++;        /* Update lBucket info. */
 
-    /* release all latch before sleep */
-    e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
-
-    /* update XactBucket info */
+    /* update XactBucket info under the latch of lBucket */
     xBucket->status = X_CONVERTING;
     xBucket->waitingLock = LOGICAL_PTR(lBucket);
 
-
-    /*@ release latch */
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
+    /* release all latch before sleep */
+    e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
     if (e < eNOERROR) ERR(handle, e);
 
-
     /* process waits until conflicting transactions release this lock */
     e = SHM_semWait(handle, &(((TCB*)PHYSICAL_PTR(aRequest->xcbPtr))->semID));
     if (e < eNOERROR) ERR(handle, e);
 
 
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
     /* if deadlock detection is executed THEN ... */
     if (xBucket->status == X_DEADLOCK) {
 
@@ -646,21 +580,17 @@ Four lm_getLock(
 	*lockReply = LR_DEADLOCK;
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
 	e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL,NULL);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	/*@ update the status */
 	aRequest->mode = aRequest->oldMode;
 	aRequest->duration = oldDuration;
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
-
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
 	if (e < eNOERROR) ERR(handle, e);
 
 	return(eNOERROR);
@@ -669,24 +599,20 @@ Four lm_getLock(
     if ( duration == L_INSTANT ) {
 
 	e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL,NULL);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH); 
+	if (e < eNOERROR) ERR(handle, e); 
 
 	aRequest->mode = oldMode;
 
 	/* give chance to another request */
 	if (( e = wakeup_nextRequest(handle, lBucket)) < eNOERROR) {
 	    e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	    if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-	    /* release lmLatch */
-	    e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
 	    if (e2 < 0) ERR(handle, e2);
 
 	    ERR(handle, e);
 
 	}
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 	*lockReply = (LockReply)mode;
     }
@@ -698,13 +624,9 @@ Four lm_getLock(
     xBucket->nLock[level]++;
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 
     /* end of CASE 2-2 : (conversion case) */
@@ -748,19 +670,14 @@ Four lm_releaseLock(
     Seed  		tempSeed;  		/* temp seed */
 
 
-    /*@ get latch */
-    /* get the lmLatch for deadlock detection */
-    e = SHM_getLatch(handle, &LM_LATCH, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERR(handle, e);
-
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
     /*@ find the requested ones */
     /* if no xactbucket of this xactID, invalid transaction identifier error */
     e = find_xactBucket(handle, xactID, &xBucket);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /* search the RequestNode from xBucket->grantedList[level] */
     switch(level){
@@ -769,10 +686,6 @@ Four lm_releaseLock(
         /*@ error check */
         /* if no RequestNode exists, ERROR */
         if (!aRequest) {
-	        /* release lmLatch */
-		e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-		if (e < eNOERROR) ERR(handle, e);
-
 		return(eNOERROR);
 	}
         break;
@@ -782,10 +695,6 @@ Four lm_releaseLock(
         /*@ error check */
         /* if no RequestNode exists, ERROR */
         if (!aRequest) {
-	        /* release lmLatch */
-		e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-		if (e < eNOERROR) ERR(handle, e);
-
 		return(eNOERROR);
 	}
         break;
@@ -795,10 +704,6 @@ Four lm_releaseLock(
         /*@ error check */
         /* if no RequestNode exists, ERROR */
         if (!aRequest) {
-	        /* release lmLatch */
-		e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-		if (e < eNOERROR) ERR(handle, e);
-
 		return(eNOERROR);
 	}
         break;
@@ -807,10 +712,6 @@ Four lm_releaseLock(
         /*@ error check */
         /* if no RequestNode exists, ERROR */
         if (!aRequest) {
-	        /* release lmLatch */
-		e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-		if (e < eNOERROR) ERR(handle, e);
-
 		return(eNOERROR);
 	}
         break;
@@ -820,7 +721,7 @@ Four lm_releaseLock(
 
     /* request latch for access the lockBucket */
     e = SHM_getLatch(handle, &lBucket->latch, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
-    if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if (e < eNOERROR) ERR(handle, e);
 
     /* check the hierarchical lock protocol */
     if (level == L_FILE && PHYSICAL_PTR(lBucket->lowerLock)) {
@@ -829,7 +730,7 @@ Four lm_releaseLock(
 	    /* if any requests for lower level exist
 	       then error violating lock hierarchy */
 
-	    ERRL2(handle, eLOCKHIERARCHYVIOLATE_LM, &lBucket->latch, &LM_LATCH);
+	    ERRL1(handle, eLOCKHIERARCHYVIOLATE_LM, &lBucket->latch);
 	}
     }
 
@@ -841,23 +742,19 @@ Four lm_releaseLock(
     	aRequest->counter--;
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-	/* release lmLatch */
-	e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-	if (e < eNOERROR) ERR(handle, e);
-
 	return(eNOERROR);
     }
 
     /* check if the requested duration is stronger than granted */
     if ( aRequest->duration < duration ) {
 
-        ERRL2(handle, eWRONGDURATION_LM, &lBucket->latch, &LM_LATCH);
+        ERRL1(handle, eWRONGDURATION_LM, &lBucket->latch);
     }
 
     /* if aRequest->counter was 1(i.e. if it is the last instance of lock) */
@@ -866,10 +763,6 @@ Four lm_releaseLock(
 
     if (( e = wakeup_nextRequest(handle, lBucket)) < eNOERROR) {
 	e2 = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e2 < 0) ERRL1(handle, e2, &LM_LATCH);
-
-	/* release lmLatch */
-	e2 = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
 	if (e2 < 0) ERR(handle, e2);
 
 	ERR(handle, e);
@@ -879,19 +772,19 @@ Four lm_releaseLock(
     if (PHYSICAL_PTR(lBucket->queue)) {
 
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
     }
     else {			/* delete lBucket */
 
 	if (level == L_FILE && PHYSICAL_PTR(lBucket->lowerLock)) {
             /* if PageLock in this file exist, it violate the lock hierarchy */
-	    ERRL2(handle, eLOCKHIERARCHYVIOLATE_LM, &lBucket->latch, &LM_LATCH);
+	    ERRL1(handle, eLOCKHIERARCHYVIOLATE_LM, &lBucket->latch);
 	}
 
 	lockHashEntryPtr = &LM_LOCKHASHTABLE[LOCKTABLE_LOCKID_HASH((*lockID), tempSeed, level)];
 
 	e = lm_deleteLockBucketFromChain(handle, lockHashEntryPtr, lBucket);
-	if (e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+	if (e < eNOERROR) ERR(handle, e);
     }
 
     /*@ update the status */
@@ -924,13 +817,9 @@ Four lm_releaseLock(
     xBucket->nUnlock[level]++;
 
 #ifdef TRACE
-    e = Util_checkPool(handle, &LM_LOCKBUCKETPOOL);
+    CHECK_LOCKBUCKETPOOLS(handle, e);
 #endif
 
-    /* release lmLatch */
-    e = SHM_releaseLatch(handle, &LM_LATCH, procIndex);
-    if (e < eNOERROR) ERR(handle, e);
-
     return(eNOERROR);
 
 }
@@ -1293,7 +1182,7 @@ Four lm_deleteLockBucketFromChain(
 		    if (e < eNOERROR) ERR(handle, e);
 		}
 
-		e = Util_freeElementToPool(handle, &LM_LOCKBUCKETPOOL, lBucket);
+		e = Util_freeElementToPool(handle, &LM_LOCKBUCKETPOOL(lBucket->partitionNo), lBucket);
 		if (e < eNOERROR) ERR(handle, e);
 	    }
 	}
@@ -1314,7 +1203,7 @@ Four lm_deleteLockBucketFromChain(
 	e = SHM_releaseLatch(handle, &lBucket->latch, procIndex);
 	if (e < eNOERROR) ERR(handle, e);
 
-	e = Util_freeElementToPool(handle, &LM_LOCKBUCKETPOOL, lBucket);
+	e = Util_freeElementToPool(handle, &LM_LOCKBUCKETPOOL(lBucket->partitionNo), lBucket);
 	if (e < eNOERROR) ERR(handle, e);
     }
 
@@ -102,7 +102,7 @@
 /*         allocate and initialize lockBucket.                      */
 /*                                                                  */
 /* Assumption ::                                                    */
-/*         this function is called with LM_LATCH                    */
+/*         this function is called with the latch of the hash entry */
 /*                                                                  */
 /* parameters                                                       */
 /*    LockLevel       IN lock level                                 */
@@ -124,15 +124,19 @@ Four lm_allocAndInitLockBucket(
 {
     Four  		e;
     Four  		howMuchLBucket;
+    Four  		partitionNo;		/* lock table partition of the lBucket */
 
     /* check parameters */
     if(lockID == NULL) ERR(handle, eBADPARAMETER);
     if(lockHashEntryPtr == NULL) ERR(handle, eBADPARAMETER);
 
-    /* allocate lBucket */
-    e = Util_getElementFromPool(handle, &LM_LOCKBUCKETPOOL, lBucket);
+    /* allocate lBucket from the pool of the partition of the hash entry */
+    partitionNo = LM_PARTITION_OF_HASHVALUE(lockHashEntryPtr - LM_LOCKHASHTABLE);
+    e = Util_getElementFromPool(handle, &LM_LOCKBUCKETPOOL(partitionNo), lBucket);
     if (e < eNOERROR) ERR(handle, e);
 
+    (*lBucket)->partitionNo = partitionNo;
+
     /* initialize lBucket */
     SHM_initLatch(handle, &(*lBucket)->latch);	  /* initLatch precedes getlatch */
 
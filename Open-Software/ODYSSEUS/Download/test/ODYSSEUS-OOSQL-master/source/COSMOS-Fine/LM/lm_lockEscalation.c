@@ -139,7 +139,7 @@ Four lm_lockEscalation(
 
     /* reset maxFileLock */
     e = lm_resetMaxLocksOnFile(handle);
-    if(e < eNOERROR) ERRL1(handle, e, &LM_LATCH);
+    if(e < eNOERROR) ERR(handle, e);
 
     return(eNOERROR);
 }
@@ -121,13 +121,18 @@ Four lm_resetMaxLocksOnFile(
 {
     Four 	e;
     Four 	usedLocks;
+    Four 	usedLocksInPartition;
+    Four 	i;
 
     e = SHM_getLatch(handle, &LM_MAX_LOCKS_ON_FILE_LATCH,
                      procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
     if(e < eNOERROR) ERR(handle, e);
 
-    e = Util_getElemInPool(handle, &LM_LOCKBUCKETPOOL, &usedLocks);
-    if(e < eNOERROR) ERRL1(handle, e, &LM_MAX_LOCKS_ON_FILE_LATCH);
+    for (usedLocks = 0, i = 0; i < LM_NUM_PARTITIONS; i++) {
+        e = Util_getElemInPool(handle, &LM_LOCKBUCKETPOOL(i), &usedLocksInPartition);
+        if(e < eNOERROR) ERRL1(handle, e, &LM_MAX_LOCKS_ON_FILE_LATCH);
+        usedLocks += usedLocksInPartition;
+    }
 
     LM_MAX_LOCKS_ON_FILE = LM_INIT_MAX_LOCKS_ON_FILE * 10;
 	
@@ -123,7 +123,7 @@ Four lm_allocAndInsertIntoQueue(
     Four 		e;
 
     /* allocate and fill the new RequestNode  */
-    GET_NEWREQUESTNODE(handle, *aRequest, xactID, mode, duration, status, xBucket, e); 
+    GET_NEWREQUESTNODE(handle, *aRequest, lBucket->partitionNo, xactID, mode, duration, status, xBucket, e); 
     if(e < eNOERROR) ERR(handle, e);
 
     /* make connection with lockBucket */
@@ -120,6 +120,10 @@ Four LOG_CloseVolume(
     if (LOG_LOGMASTER.volNo == NIL) ERR(handle, eNOOPENEDLOGVOLUME_LOG);
 
 
+    /* Take in the log space reserved without the latch. */
+    e = log_SettleLogSpace(handle);
+    if (e < eNOERROR) ERR(handle, e);
+
     /*
      *	reflect all the contents in the log buffer into the log file.
      */
@@ -114,6 +114,7 @@ Four LOG_FlushLogRecords(
     Lsn_T 	lsn;                  	/* temporary variable */
     Four 	logBufIdx;            	/* log buffer index */
     Boolean 	flushAllBuffersFlag; 	/* TRUE if all the buffers are to be flushed */
+    Lsn_T 	endLsn;			/* lsn next to the last byte of the log record */
 
 
     TR_PRINT(handle, TR_LOG, TR1, ("LOG_FlushLogRecords(logRecLsn=%P, logRecLength=%lD)",
@@ -158,6 +159,22 @@ Four LOG_FlushLogRecords(
     e = SHM_getLatch(handle, &LOG_LATCH4TAIL, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
 
+    /*
+     * The log records were already flushed out by the others while we were
+     * waiting for the latch.
+     */
+    endLsn = lsn;
+    endLsn.offset++;
+    if (LSN_CMP_LE(endLsn, LOG_FLUSHEDLSN)) {
+	e = SHM_releaseLatch(handle, &LOG_LATCH4TAIL, procIndex);
+	if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
+
+        e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
+        if (e < eNOERROR) ERR(handle, e);
+
+	return(eNOERROR);
+    }
+
 
     /*
      * Get the distance between the log page containg log records and the log
@@ -115,7 +115,9 @@ Four LOG_GetNextLogRecordLsn(
     e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERR(handle, e);
 
-    *lsn = LOG_LOGMASTER.nextLsn;
+    /* The log records may be reserved without the latch meanwhile. */
+    e = log_GetNextLsn(handle, lsn);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
 
     e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
     if (e < eNOERROR) ERR(handle, e);
@@ -0,0 +1,343 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: LOG_GroupCommit.c
+ *
+ * Description:
+ *  Group commit. The committers queue the lsn of their commit log records,
+ *  and a leader among them flushes the log up to the last queued log record
+ *  by one log write on behalf of the whole group.
+ *
+ *  The latch LOG_LATCH4GROUPCOMMIT is held by the leader during the flush;
+ *  the other committers wait until it is released and find their log
+ *  records already flushed. The leader may wait CFG_LOGGROUPCOMMITWINDOW
+ *  usec for up to CFG_LOGGROUPCOMMITSIZE committers before the flush.
+ *
+ * Exports:
+ *  Four LOG_GroupCommit(Four, Lsn_T*, Four)
+ *  Four LOG_GetStatistics(Four, LOG_Statistics_T*)
+ */
+
+
+#include <assert.h>
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util.h"
+#include "LOG.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*@================================
+ * LOG_GroupCommit( )
+ *================================*/
+/*
+ * Function: Four LOG_GroupCommit(Four, Lsn_T*, Four)
+ *
+ * Description:
+ *  Make the given commit (or prepare) log record permanent together with
+ *  the log records of the other committers.
+ *
+ * Returns:
+ *  error code
+ */
+Four LOG_GroupCommit(
+    Four 	handle,
+    Lsn_T 	*logRecLsn,		/* IN log record which should be written into disk */
+    Four 	logRecLength)		/* IN the length of the log record */
+{
+    Four 	e;			/* error code */
+    Lsn_T 	endLsn;			/* lsn next to the last byte of the log record */
+    Lsn_T 	flushLsn;		/* the last log record to be flushed by the leader */
+    Four 	flushLength;		/* its length */
+    UFour 	myGroupNo;		/* group no when this committer was queued */
+    Four 	groupSize;		/* # of committers served by the flush */
+    Four 	waitTime;		/* time the leader waited for the other committers */
+    Boolean 	flushedFlag;		/* TRUE if the log record is already in the disk */
+    Boolean 	leaderFlag;		/* TRUE if we got the latch LOG_LATCH4GROUPCOMMIT */
+
+
+    TR_PRINT(handle, TR_LOG, TR1, ("LOG_GroupCommit(logRecLsn=%P, logRecLength=%lD)",
+			   logRecLsn, logRecLength));
+
+
+    /*
+     *	check input parameter
+     */
+    if (logRecLsn == NULL) ERR(handle, eBADPARAMETER);
+
+    /* If there is no log volume or no log record, we have completed the flush. */
+    if (LOG_LOGMASTER.volNo == NIL) return(eNOERROR);
+
+    assert(logRecLength >= 0);
+    if (logRecLength == 0) return(eNOERROR);
+
+    endLsn = *logRecLsn;
+    endLsn.offset += logRecLength;
+
+
+    /*
+     * Join the commit queue.
+     */
+    e = SHM_getLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    LOG_COMMITQUEUE.nWaiters++;
+    if (LSN_CMP_GT(*logRecLsn, LOG_COMMITQUEUE.maxLsn)) {
+	LOG_COMMITQUEUE.maxLsn = *logRecLsn;
+	LOG_COMMITQUEUE.maxLsnLength = logRecLength;
+    }
+    myGroupNo = LOG_COMMITQUEUE.groupNo;
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    /*
+     * Wait for the current leader to finish its flush, or become the leader.
+     * The latch is waited for in M_INSTANT mode, so that all the waiting
+     * committers check their log records as soon as the leader releases it.
+     */
+    for (;;) {
+	e = SHM_getLatch(handle, &LOG_LATCH4GROUPCOMMIT, procIndex, M_EXCLUSIVE, M_CONDITIONAL, NULL);
+	if (e < eNOERROR) ERR(handle, e);
+	leaderFlag = (e != SHM_BUSYLATCH);
+
+	e = SHM_getLatch(handle, &LOG_LATCH4TAIL, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
+	if (e < eNOERROR) {
+	    if (leaderFlag) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+	    ERR(handle, e);
+	}
+
+	flushedFlag = LSN_CMP_LE(endLsn, LOG_FLUSHEDLSN);
+
+	e = SHM_releaseLatch(handle, &LOG_LATCH4TAIL, procIndex);
+	if (e < eNOERROR) {
+	    if (leaderFlag) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+	    ERR(handle, e);
+	}
+
+	if (flushedFlag) {
+	    /*
+	     * The previous leader (or some other log flush) wrote our log record.
+	     * Leave the queue if no leader has taken us yet.
+	     */
+	    if (leaderFlag) {
+		e = SHM_releaseLatch(handle, &LOG_LATCH4GROUPCOMMIT, procIndex);
+		if (e < eNOERROR) ERR(handle, e);
+	    }
+
+	    e = SHM_getLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    if (myGroupNo == LOG_COMMITQUEUE.groupNo) LOG_COMMITQUEUE.nWaiters--;
+
+	    e = SHM_releaseLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    return(eNOERROR);
+	}
+
+	if (leaderFlag) break;
+
+	e = SHM_getLatch(handle, &LOG_LATCH4GROUPCOMMIT, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL|M_INSTANT, NULL);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    e = SHM_getLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+
+
+    /*
+     * We are the leader. Give the other committers a chance to join the group.
+     */
+    waitTime = 0;
+    while (waitTime < CFG_LOGGROUPCOMMITWINDOW && LOG_COMMITQUEUE.nWaiters < CFG_LOGGROUPCOMMITSIZE) {
+
+	e = SHM_releaseLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex);
+	if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+
+	(void) Util_Sleep(handle, LOG_GROUP_COMMIT_POLL_INTERVAL/1000000.0);
+	waitTime += LOG_GROUP_COMMIT_POLL_INTERVAL;
+
+	e = SHM_getLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+	if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+    }
+
+    /*
+     * Take all the queued committers.
+     * If a failed flush of the previous leader has left us out of the queue,
+     * we add ourselves to the group.
+     */
+    groupSize = LOG_COMMITQUEUE.nWaiters;
+    flushLsn = LOG_COMMITQUEUE.maxLsn;
+    flushLength = LOG_COMMITQUEUE.maxLsnLength;
+
+    if (myGroupNo != LOG_COMMITQUEUE.groupNo) {
+	groupSize++;
+	if (LSN_CMP_GT(*logRecLsn, flushLsn)) {
+	    flushLsn = *logRecLsn;
+	    flushLength = logRecLength;
+	}
+    }
+
+    LOG_COMMITQUEUE.nWaiters = 0;
+    LOG_COMMITQUEUE.groupNo++;
+
+    LOG_COMMITQUEUE.nGroups++;
+    LOG_COMMITQUEUE.nGroupedXacts += groupSize;
+    if (groupSize > LOG_COMMITQUEUE.maxGroupSize) LOG_COMMITQUEUE.maxGroupSize = groupSize;
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+
+
+    /*
+     * Flush the log records of the whole group by one log write.
+     */
+    e = LOG_FlushLogRecords(handle, &flushLsn, flushLength);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4GROUPCOMMIT);
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4GROUPCOMMIT, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    return(eNOERROR);
+
+} /* LOG_GroupCommit() */
+
+
+
+/*@================================
+ * LOG_GetStatistics( )
+ *================================*/
+/*
+ * Function: Four LOG_GetStatistics(Four, LOG_Statistics_T*)
+ *
+ * Description:
+ *  Get the statistics of the log manager.
+ *  The average group size is nGroupedXacts / nGroupCommits.
+ *  redoDistance is the amount of log the restart recovery would scan now.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER - bad parameter
+ */
+Four LOG_GetStatistics(
+    Four 		handle,
+    LOG_Statistics_T 	*stats)		/* OUT statistics */
+{
+    Four 		e;		/* error code */
+
+
+    TR_PRINT(handle, TR_LOG, TR1, ("LOG_GetStatistics(stats=%P)", stats));
+
+
+    if (stats == NULL) ERR(handle, eBADPARAMETER);
+
+    e = SHM_getLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    stats->nGroupCommits = LOG_COMMITQUEUE.nGroups;
+    stats->nGroupedXacts = LOG_COMMITQUEUE.nGroupedXacts;
+    stats->maxGroupSize = LOG_COMMITQUEUE.maxGroupSize;
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4COMMITQUEUE, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = SHM_getLatch(handle, &LOG_LATCH4TAIL, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    stats->flushedLsn = LOG_FLUSHEDLSN;
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4TAIL, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = log_GetNextLsn(handle, &stats->nextLsn);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
+
+    stats->checkpointLsn = LOG_LOGMASTER.checkpointLsn;
+    stats->redoLsn = LOG_REDOLSN;
+    stats->redoDistance = LOG_GET_DISTANCE_BTW_LSNS(stats->nextLsn, stats->redoLsn);
+
+    e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* LOG_GetStatistics() */
@@ -134,6 +134,29 @@ Four LOG_InitSharedDS(
     e = SHM_initLatch(handle, &LOG_LATCH4LOGFILESWITCH);
     if (e < eNOERROR) ERR(handle, e);
 
+    e = SHM_initLatch(handle, &LOG_LATCH4GROUPCOMMIT);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = SHM_initLatch(handle, &LOG_LATCH4COMMITQUEUE);
+    if (e < eNOERROR) ERR(handle, e);
+
+    /*
+     * Initialize the commit queue.
+     */
+    LOG_FLUSHEDLSN.wrapCount = 0;
+    LOG_FLUSHEDLSN.offset = 0;
+
+    SET_NIL_LSN(LOG_REDOLSN);
+
+    LOG_COMMITQUEUE.nWaiters = 0;
+    LOG_COMMITQUEUE.groupNo = 0;
+    LOG_COMMITQUEUE.maxLsn.wrapCount = 0;
+    LOG_COMMITQUEUE.maxLsn.offset = 0;
+    LOG_COMMITQUEUE.maxLsnLength = 0;
+    LOG_COMMITQUEUE.nGroups = 0;
+    LOG_COMMITQUEUE.nGroupedXacts = 0;
+    LOG_COMMITQUEUE.maxGroupSize = 0;
+
     /*
      * Initialize log write buffers.
      */
@@ -134,6 +134,13 @@ Four LOG_OpenVolume(
 
     /* Copy the log master content to the memory data structure. */
     LOG_LOGMASTER = masterPage.master;
+    LOG_RESET_RESERVEWORD();
+
+    /* The log records before nextLsn are already in the disk. */
+    LOG_FLUSHEDLSN = LOG_LOGMASTER.nextLsn;
+
+    /* The redo point is not kept in the log master; the checkpoint lsn is the best guess. */
+    LOG_REDOLSN = LOG_LOGMASTER.checkpointLsn;
 
 
     return(eNOERROR);
@@ -78,7 +78,7 @@
  *  log master into the disk.
  *
  * Exports:
- *  Four LOG_SetCheckpointLsn(Four, LOG_Lsn_T*)
+ *  Four LOG_SetCheckpointLsn(Four, LOG_Lsn_T*, LOG_Lsn_T*)
  */
 
 
@@ -93,32 +93,39 @@
 
 
 /*
- * Function: Four LOG_SetCheckpointLsn(Four, LOG_Lsn_T*)
+ * Function: Four LOG_SetCheckpointLsn(Four, LOG_Lsn_T*, LOG_Lsn_T*)
  *
  * Description:
  *  Write the recent checkpoint LSN into the log master and then write the
- *  log master into the disk.
+ *  log master into the disk. The redo point of the checkpoint is kept in
+ *  the shared memory for LOG_GetStatistics().
  *
  * Returns:
  *  error code
  */
 Four LOG_SetCheckpointLsn(
     Four 		handle,
-    Lsn_T 		*ckptLsn)	/* IN LSN of the recent checkpoint */
+    Lsn_T 		*ckptLsn,	/* IN LSN of the recent checkpoint */
+    Lsn_T 		*redoLsn)	/* IN redo point of the recent checkpoint */
 {
     Four 		e;		/* error code */
     PageID 		pid;		/* page id of the log master page */
     log_LogMasterPage_T masterPage; 	/* log master page */
 
 
-    TR_PRINT(handle, TR_LOG, TR1, ("LOG_SetCheckpointLsn(chkptLsn=%P)", ckptLsn));
+    TR_PRINT(handle, TR_LOG, TR1, ("LOG_SetCheckpointLsn(chkptLsn=%P, redoLsn=%P)", ckptLsn, redoLsn));
 
 
     e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERR(handle, e);
 
+    /* Take in the log space reserved without the latch. */
+    e = log_SettleLogSpace(handle);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
+
     /* Write checkpoint LSN into the log master. */
     LOG_LOGMASTER.checkpointLsn = *ckptLsn;
+    LOG_REDOLSN = *redoLsn;
 
     /* Copy the log master. */
     masterPage.master = LOG_LOGMASTER;
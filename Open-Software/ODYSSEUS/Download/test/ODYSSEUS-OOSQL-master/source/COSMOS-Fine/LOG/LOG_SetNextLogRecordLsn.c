@@ -116,9 +116,16 @@ Four LOG_SetNextLogRecordLsn(
 
     /* This function assumes that concurrency control is provided by the caller. */
 
+    /* No log space is reserved without the latch from now on. */
+    e = log_SettleLogSpace(handle);
+    if (e < eNOERROR) ERR(handle, e);
+
     /* Set the next log record lsn. */
     LOG_LOGMASTER.nextLsn = *lsn;
 
+    /* The log records before the given lsn are already in the disk. */
+    LOG_FLUSHEDLSN = *lsn;
+
     /* Set the number of remained bytes in the current log file. */
     LOG_LOGMASTER.numBytesRemained = LOG_LOGMASTER.numBytes - lsn->offset;
 
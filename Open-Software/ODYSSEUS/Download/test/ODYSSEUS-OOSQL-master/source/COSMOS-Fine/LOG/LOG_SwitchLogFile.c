@@ -124,6 +124,10 @@ Four LOG_SwitchLogFile(
     e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERR(handle, e);
 
+    /* Take in the log space reserved without the latch. */
+    e = log_SettleLogSpace(handle);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
+
     if (LOG_LOGMASTER.numBytesRemained >= logRecLen) {
         e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
         if (e < eNOERROR) ERR(handle, e);
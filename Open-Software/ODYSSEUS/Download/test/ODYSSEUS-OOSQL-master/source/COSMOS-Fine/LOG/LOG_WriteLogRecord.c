@@ -96,6 +96,10 @@
  * Description:
  *  Write a log record which consists of a log record header and a set of
  *  images into the log.
+ *  The log space of a log record which fits in the head page is reserved
+ *  by a compare-and-swap; the other log records reserve the space under
+ *  the latch LOG_LATCH4HEAD. The log record is copied into the space
+ *  without the latch.
  *
  * Returns:
  *  error codes
@@ -108,6 +112,7 @@ Four LOG_WriteLogRecord(
     Four 		*logRecLength)	/* OUT length of the log record (used for flushing log record) */
 {
     Four	       	e;	  	/* error code */
+    log_LogSpace_T	space;		/* log space reserved for the log record */
 
 
     TR_PRINT(handle, TR_LOG, TR1, ("LOG_WriteLogRecord(logRecInfo=%P, lsn=%P, logRecLength=%lD)",
@@ -124,10 +129,20 @@ Four LOG_WriteLogRecord(
     *logRecLength = log_GetLogRecordLength(handle, logRecInfo);
 
 
+    /*
+     *	reserve the space in the head page without the latch if possible
+     */
+    if (log_TryReserveLogSpace(handle, *logRecLength, lsn, &space)) goto CopyRecord;
+
+
     /* get latch */
     e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
     if (e < eNOERROR) ERR(handle, e);
 
+    /* Take in the space reserved without the latch. */
+    e = log_SettleLogSpace(handle);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
+
     /* Check the # of remained bytes. */
     while (*logRecLength > LOG_LOGMASTER.numBytesRemained) {
         e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
@@ -139,6 +154,9 @@ Four LOG_WriteLogRecord(
         /* get latch */
         e = SHM_getLatch(handle, &LOG_LATCH4HEAD, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
         if (e < eNOERROR) ERR(handle, e);
+
+        e = log_SettleLogSpace(handle);
+        if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
     }
 
     /* Get the record lsn. */
@@ -146,9 +164,9 @@ Four LOG_WriteLogRecord(
 
 
     /*
-     *	write the log record into the log
+     *	reserve the space of the log record in the log
      */
-    e = log_WriteLogRecord(handle, logRecInfo);
+    e = log_ReserveLogSpace(handle, logRecInfo, *logRecLength, &space);
     if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
 
 
@@ -167,10 +185,26 @@ Four LOG_WriteLogRecord(
     /*
      * increase the # of written log records
      */
-    LOG_LOGMASTER.logRecordCount++;
+    (void) __sync_fetch_and_add(&LOG_LOGMASTER.logRecordCount, 1);
+
+    /* Let the following log records be reserved without the latch. */
+    e = log_OpenLogSpace(handle);
+    if (e < eNOERROR) ERRL1(handle, e, &LOG_LATCH4HEAD);
 
     /* release latch */
+    /* The space is a part of the log now; fill it before returning the error. */
     e = SHM_releaseLatch(handle, &LOG_LATCH4HEAD, procIndex);
+    if (e < eNOERROR) {
+	(void) log_CopyLogRecord(handle, logRecInfo, &space);
+	ERR(handle, e);
+    }
+
+
+    /*
+     *	copy the log record into the reserved space
+     */
+CopyRecord:
+    e = log_CopyLogRecord(handle, logRecInfo, &space);
     if (e < eNOERROR) ERR(handle, e);
 
 
@@ -117,6 +117,9 @@ Four log_BufInit(
     LOG_LBI_HEAD = 0;
     LOG_LBI_TAIL = 0;
 
+    /* no space is open for the reservation without the latch */
+    LOG_RESET_RESERVEWORD();
+
 
     /*
      *	initialize the logBufferTable
@@ -125,6 +128,7 @@ Four log_BufInit(
 
 	LOG_LBT_PAGENO(i) = NIL;
 	LOG_LBT_WRAPCOUNT(i) = NIL;
+	LOG_LBT_NPENDING(i) = 0;
 
     } /* end for */
 
@@ -82,6 +82,7 @@
 
 
 #include <assert.h>
+#include <sched.h>		/* for sched_yield */
 #include "common.h"
 #include "error.h"
 #include "trace.h"
@@ -97,12 +98,20 @@
  *
  * Description:
  *  Flush log buffers.
+ *  The buffer pages are written in one batch by RDsM_SubmitIOs() and then
+ *  forced out to the disk by one sync of the log volume.
+ *  A buffer page is written after the log records reserved in it have been
+ *  copied by log_CopyLogRecord(); the copiers hold no latch, so waiting
+ *  for them cannot deadlock. The head page is closed for the reservation
+ *  without the latch before it is written.
+ *  LOG_FLUSHEDLSN is advanced to the end of the flushed log records.
  *
  * Returns:
  *  error code
  *
  * Assumption:
- *  The caller is holding the latch LOG_LATCH4TAIL.
+ *  The caller is holding the latch LOG_LATCH4TAIL. If 'lastLogBufIdx' is
+ *  LOG_LBI_HEAD, the caller is also holding the latch LOG_LATCH4HEAD.
  */
 Four log_FlushLogBuffers(
     Four 	handle,
@@ -114,6 +123,9 @@ Four log_FlushLogBuffers(
     PageID 	pid;                 	/* page identifier */
     Four 	old_LOG_LBI_HEAD;	/* temporary value */
     Four 	i;
+    Four 	nReqs;			/* # of write requests */
+    Lsn_T 	flushedLsn;		/* the log is durable up to this lsn after the flush */
+    RDsM_IORequest_T reqs[NUM_WRITE_LOG_BUFS]; /* write requests of the buffer pages */
 
 
     TR_PRINT(handle, TR_LOG, TR1, ("log_FlushLogBuffers(lastLogBufIdx=%lD, lastLogBufKeepFlag=%P)",
@@ -123,16 +135,57 @@ Four log_FlushLogBuffers(
     /* Set the log volume no. */
     pid.volNo = LOG_LOGMASTER.volNo;
 
+    /* No more log records are reserved in the head page without the latch. */
+    if (lastLogBufIdx == LOG_LBI_HEAD) {
+	e = log_CloseLogSpace(handle);
+	if (e < eNOERROR) ERR(handle, e);
+    }
 
-    for (i = LOG_LBI_TAIL; ; i = (i+1) % NUM_WRITE_LOG_BUFS) {
 
-	/*
-	 * flush the buffer page indexed by variable 'i'.
-	 */
+    /*
+     * write the buffer pages from LOG_LBI_TAIL to 'lastLogBufIdx' at once
+     */
+    for (nReqs = 0, i = LOG_LBI_TAIL; ; i = (i+1) % NUM_WRITE_LOG_BUFS) {
+
+	/* wait for the log records reserved in the page to be copied */
+	while (__sync_fetch_and_add(&LOG_LBT_NPENDING(i), 0) > 0) sched_yield();
+
 	pid.pageNo = LOG_GET_PHYSICAL_PAGENO(LOG_LOGMASTER, LOG_LBT_WRAPCOUNT(i), LOG_LBT_PAGENO(i));
 
-	e = RDsM_WriteTrain(handle, (char*)&LOG_LOGBUFFERPAGE[i], &pid, PAGESIZE2);
+	reqs[nReqs].opType = RDSM_IO_WRITE;
+	reqs[nReqs].trainId = pid;
+	reqs[nReqs].nPages = PAGESIZE2;
+	reqs[nReqs].bufPtr = (char*)&LOG_LOGBUFFERPAGE[i];
+	reqs[nReqs].callback = NULL;
+	nReqs++;
+
+	if (i == lastLogBufIdx) break;
+    }
+
+    e = RDsM_SubmitIOs(handle, reqs, nReqs);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = RDsM_SyncVolume(handle, pid.volNo);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    /*
+     * Advance LOG_FLUSHEDLSN.
+     * If the head page was written, all the log records written so far are
+     * in the disk; otherwise the log is durable up to the next page.
+     */
+    if (lastLogBufIdx == LOG_LBI_HEAD) {
+	e = log_GetNextLsn(handle, &flushedLsn);
 	if (e < eNOERROR) ERR(handle, e);
+    } else {
+	flushedLsn.wrapCount = LOG_LBT_WRAPCOUNT(lastLogBufIdx);
+	flushedLsn.offset = LOG_GET_LSN_OFFSET_FROM_PAGE_NO(LOG_LBT_PAGENO(lastLogBufIdx)+1);
+    }
+
+    if (LSN_CMP_GT(flushedLsn, LOG_FLUSHEDLSN)) LOG_FLUSHEDLSN = flushedLsn;
+
+
+    for (i = LOG_LBI_TAIL; ; i = (i+1) % NUM_WRITE_LOG_BUFS) {
 
 	if (i == lastLogBufIdx) {
 
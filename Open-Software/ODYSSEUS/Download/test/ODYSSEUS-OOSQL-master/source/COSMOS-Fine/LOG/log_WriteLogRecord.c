@@ -75,9 +75,33 @@
  *
  * Description:
  *  Write a log record into the log file.
+ *  Writing a log record has two steps. The space of the log record is
+ *  reserved at the end of the log, and log_CopyLogRecord() copies the log
+ *  record into the space without any latch. So the log records of several
+ *  threads are copied into the log buffer pages in parallel.
+ *  LOG_LBT_NPENDING() counts the bytes reserved in a log buffer page but not
+ *  copied yet; log_FlushLogBuffers() waits for it to become 0 before the
+ *  page is written.
+ *
+ *  A log record which fits in the rest of the head page is reserved by
+ *  log_TryReserveLogSpace() with a compare-and-swap on LOG_RESERVEWORD,
+ *  which holds the offset of the end of the log in the head page. The
+ *  other log records are reserved by log_ReserveLogSpace() under the latch
+ *  LOG_LATCH4HEAD, which allocates the log pages, and may switch the log
+ *  files. The latch holders close the word first, so that the space does
+ *  not move under them; log_SettleLogSpace() then adds the space reserved
+ *  by the compare-and-swaps to LOG_LOGMASTER.nextLsn and
+ *  LOG_LOGMASTER.numBytesRemained, and log_OpenLogSpace() opens the rest
+ *  of the head page again.
  *
  * Exports:
- *  Four log_WriteLogRecord(Four, LOG_LogRecInfo_T*)
+ *  Four log_ReserveLogSpace(Four, LOG_LogRecInfo_T*, Four, log_LogSpace_T*)
+ *  Boolean log_TryReserveLogSpace(Four, Four, Lsn_T*, log_LogSpace_T*)
+ *  Four log_CopyLogRecord(Four, LOG_LogRecInfo_T*, log_LogSpace_T*)
+ *  Four log_CloseLogSpace(Four)
+ *  Four log_SettleLogSpace(Four)
+ *  Four log_OpenLogSpace(Four)
+ *  Four log_GetNextLsn(Four, Lsn_T*)
  */
 
 
@@ -91,60 +115,289 @@
 #include "perThreadDS.h"
 
 
+/* Internal Function Prototypes */
+static void log_CancelLogSpace(log_LogSpace_T*);
+
+
 
 /*
- * Function: Four log_WriteLogRecord(Four, LOG_LogRecHdr_T*)
+ * Function: Four log_ReserveLogSpace(Four, LOG_LogRecInfo_T*, Four, log_LogSpace_T*)
  *
  * Description:
- *  Write a log record into the log file. The log record consists of a few
- *  images. The first image should be a log record header.
+ *  Reserve 'length' bytes of the log for the given log record at
+ *  LOG_LOGMASTER.nextLsn. The log buffer pages are allocated for the space
+ *  and their header lsns are advanced over it; LOG_LOGMASTER.nextLsn itself
+ *  is advanced by the caller.
+ *  If the log buffer pool becomes full, the part of the log record
+ *  reserved so far is copied here before the pool is flushed, because the
+ *  flush waits until the reserved bytes are copied.
  *
  * Returns:
  *  error code
  *    eNOERROR
  *
  * Assumption:
- *  The caller is holding the latch LOG_LATCH4HEAD.
+ *  The caller is holding the latch LOG_LATCH4HEAD in M_EXCLUSIVE mode and
+ *  has settled the space reserved by log_TryReserveLogSpace().
  */
-Four log_WriteLogRecord(
+Four log_ReserveLogSpace(
     Four 		handle,
-    LOG_LogRecInfo_T 	*logRecInfo)    /* IN log record infomation */
+    LOG_LogRecInfo_T 	*logRecInfo,    /* IN log record infomation */
+    Four 		length,         /* IN length of the log record */
+    log_LogSpace_T 	*space)		/* OUT reserved space not copied yet */
 {
     Four 		e;              /* returned error code */
     log_LogPage_T 	*logPage;	/* pointer to a log page */
-    Four 		nBytes;         /* size of an image in bytes */
-    Four 		subWritten;     /* sub-written size of a part in a log record */
-    Four 		offsetInPage;   /* offset of a log record in a log page */
+    Four 		nBytes;         /* # of bytes left to be reserved */
+    Four 		subReserved;    /* # of bytes reserved in a log page */
     Four 		spaceLeft;      /* left space in a log page */
-    char 		*basePtrFrom;   /* base pointer from which something is copied */
-    char 		*basePtrTo;     /* base pointer to which something is copied */
     Four 		wrapCount;      /* wrap count of the newly allocated log page */
     Four 		pageNo;		/* page no of the newly allocated log page */
+    Boolean 		copiedFlag;	/* TRUE if the reserved part has been copied */
     PageID 		pid;
-    Four 		i;              /* loop variable */
 
 
-    TR_PRINT(handle, TR_LOG, TR1, ("log_WriteLogRecords(logRecInfo=%P)", logRecInfo));
+    TR_PRINT(handle, TR_LOG, TR1, ("log_ReserveLogSpace(logRecInfo=%P, length=%lD)", logRecInfo, length));
 
 
-    /* calculate the position of this log record in the log page */
-    offsetInPage = LOG_GET_PAGE_OFFSET_IN_PAGE_FROM_LSN_OFFSET(LOG_LOGMASTER.nextLsn.offset);
+    space->bufIdx = LOG_LBI_HEAD;
+    space->offsetInPage = LOG_GET_PAGE_OFFSET_IN_PAGE_FROM_LSN_OFFSET(LOG_LOGMASTER.nextLsn.offset);
+    space->skip = 0;
+    space->length = length;
+    copiedFlag = FALSE;
 
     /* calculate the space left in the log page */
-    spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(offsetInPage);
+    spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(space->offsetInPage);
 
-    /* Get a pointer to destination. */
     logPage = &LOG_LOGBUFFERPAGE[LOG_LBI_HEAD];
-    basePtrTo = &(logPage->data[offsetInPage]);
+
+    for (nBytes = length; nBytes > 0; ) {
+
+	subReserved = MIN(nBytes, spaceLeft);
+
+	/* The copiers may be decreasing the counter of this page meanwhile. */
+	(void) __sync_fetch_and_add(&LOG_LBT_NPENDING(LOG_LBI_HEAD), subReserved);
+	(void) __sync_fetch_and_add(&logPage->hdr.lsn.offset, subReserved);
+
+	nBytes -= subReserved;
+	spaceLeft -= subReserved;
+
+	/*
+	 *	if the current log page becomes full,
+	 *	a new log page should be allocated for the next logging
+	 */
+	if (spaceLeft == 0) {
+
+	    /*
+	     * If the pool is full, log_AllocLogBuffer() flushes it; copy our
+	     * part first. LOG_LBI_TAIL is read without LOG_LATCH4TAIL: it can
+	     * only move forward meanwhile, which makes the pool less full.
+	     */
+	    if (((LOG_LBI_HEAD+1)%NUM_WRITE_LOG_BUFS) == LOG_LBI_TAIL) {
+
+		space->length = length - nBytes - space->skip;
+
+		e = log_CopyLogRecord(handle, logRecInfo, space);
+		if (e < eNOERROR) ERR(handle, e);
+
+		space->skip = length - nBytes;
+		copiedFlag = TRUE;
+	    }
+
+	    /* get the next log buffer page */
+	    /* on an error, the flush should not wait for the bytes reserved so far */
+	    e = log_AllocPage(handle, &pageNo, &wrapCount);
+	    if (e < eNOERROR) {
+		space->length = length - nBytes - space->skip;
+		log_CancelLogSpace(space);
+		ERR(handle, e);
+	    }
+
+	    e = log_AllocLogBuffer(handle, pageNo, wrapCount);
+	    if (e < eNOERROR) {
+		space->length = length - nBytes - space->skip;
+		log_CancelLogSpace(space);
+		ERR(handle, e);
+	    }
+
+	    logPage = &LOG_LOGBUFFERPAGE[LOG_LBI_HEAD];
+
+	    /* Initialize the log buffer page */
+	    pid.volNo = LOG_LOGMASTER.volNo;
+	    pid.pageNo = LOG_GET_PHYSICAL_PAGENO(LOG_LOGMASTER, wrapCount, pageNo);
+	    LOG_INIT_LOG_PAGE(logPage, pid, LOG_GET_LSN_OFFSET_FROM_PAGE_NO(pageNo), wrapCount);
+
+	    spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(0);
+
+	    /* The space not copied yet begins at the new page. */
+	    if (copiedFlag) {
+		space->bufIdx = LOG_LBI_HEAD;
+		space->offsetInPage = 0;
+		copiedFlag = FALSE;
+	    }
+
+	}	/* end if */
+    }
+
+    space->length = length - space->skip;
+
+    return(eNOERROR);
+
+} /* log_ReserveLogSpace() */
+
+
+
+/*
+ * Function: static void log_CancelLogSpace(log_LogSpace_T*)
+ *
+ * Description:
+ *  Give up the space reserved but not copied; the reserved bytes are
+ *  subtracted from the counters of the log buffer pages.
+ */
+static void log_CancelLogSpace(
+    log_LogSpace_T 	*space)		/* IN space to be given up */
+{
+    Four 		bufIdx;         /* log buffer page of the space */
+    Four 		spaceLeft;      /* left space in a log page */
+    Four 		nBytes;         /* # of bytes left to be given up */
+    Four 		subCanceled;    /* # of bytes given up in a log page */
+
+
+    bufIdx = space->bufIdx;
+    spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(space->offsetInPage);
+
+    for (nBytes = space->length; nBytes > 0; ) {
+
+	subCanceled = MIN(nBytes, spaceLeft);
+	(void) __sync_fetch_and_sub(&LOG_LBT_NPENDING(bufIdx), subCanceled);
+	nBytes -= subCanceled;
+
+	bufIdx = (bufIdx + 1) % NUM_WRITE_LOG_BUFS;
+	spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(0);
+    }
+
+    space->length = 0;
+
+} /* log_CancelLogSpace() */
+
+
+
+/*
+ * Function: Boolean log_TryReserveLogSpace(Four, Four, Lsn_T*, log_LogSpace_T*)
+ *
+ * Description:
+ *  Reserve 'length' bytes of the log without the latch LOG_LATCH4HEAD by a
+ *  compare-and-swap on LOG_RESERVEWORD. The reservation fails if the word
+ *  is closed or the log record does not fit in the open space; the caller
+ *  then reserves the space by log_ReserveLogSpace().
+ *  The counter of the head page is raised before the compare-and-swap, so
+ *  the page is not flushed before the log record is copied.
+ *
+ * Returns:
+ *  TRUE if the space is reserved
+ */
+Boolean log_TryReserveLogSpace(
+    Four 		handle,
+    Four 		length,         /* IN length of the log record */
+    Lsn_T 		*lsn,           /* OUT lsn of the log record */
+    log_LogSpace_T 	*space)		/* OUT reserved space */
+{
+    UEight 		word;		/* LOG_RESERVEWORD */
+    Four 		offset;		/* offset of the space in the head page */
+    Four 		bufIdx;         /* index of the head page */
+
+
+    for (;;) {
+	word = __atomic_load_n(&LOG_RESERVEWORD, __ATOMIC_ACQUIRE);
+
+	if (word & LOG_RW_CLOSED) return(FALSE);
+
+	offset = LOG_RW_OFFSET(word);
+	if (offset + length > LOG_RW_LIMIT(word)) return(FALSE);
+
+	bufIdx = LOG_RW_BUFIDX(word);
+
+	/* nextLsn and the base are not changed while the word is open */
+	*lsn = LOG_LOGMASTER.nextLsn;
+	lsn->offset += offset - LOG_RESERVEBASE;
+
+	(void) __sync_fetch_and_add(&LOG_LBT_NPENDING(bufIdx), length);
+
+	if (__sync_bool_compare_and_swap(&LOG_RESERVEWORD, word, word + length)) break;
+
+	(void) __sync_fetch_and_sub(&LOG_LBT_NPENDING(bufIdx), length);
+    }
+
+    (void) __sync_fetch_and_add(&LOG_LOGBUFFERPAGE[bufIdx].hdr.lsn.offset, length);
+    (void) __sync_fetch_and_add(&LOG_LOGMASTER.logRecordCount, 1);
+
+    space->bufIdx = bufIdx;
+    space->offsetInPage = offset;
+    space->skip = 0;
+    space->length = length;
+
+    return(TRUE);
+
+} /* log_TryReserveLogSpace() */
+
+
+
+/*
+ * Function: Four log_CopyLogRecord(Four, LOG_LogRecInfo_T*, log_LogSpace_T*)
+ *
+ * Description:
+ *  Copy the log record into the space reserved by log_ReserveLogSpace().
+ *  The log record consists of a few images. The first image should be a
+ *  log record header. The first 'space->skip' bytes of the log record are
+ *  not copied.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *
+ * Assumption:
+ *  No latch is needed; the reserved space is not flushed until the
+ *  copy is done.
+ */
+Four log_CopyLogRecord(
+    Four 		handle,
+    LOG_LogRecInfo_T 	*logRecInfo,    /* IN log record infomation */
+    log_LogSpace_T 	*space)		/* IN space reserved for the log record */
+{
+    Four 		nBytes;         /* size of an image in bytes */
+    Four 		skip;           /* # of bytes left to be skipped */
+    Four 		toCopy;         /* # of bytes left to be copied */
+    Four 		subWritten;     /* sub-written size of a part in a log record */
+    Four 		spaceLeft;      /* left space in a log page */
+    Four 		bufIdx;         /* log buffer page being filled */
+    Four 		nCopied;        /* # of bytes copied into the page */
+    char 		*basePtrFrom;   /* base pointer from which something is copied */
+    char 		*basePtrTo;     /* base pointer to which something is copied */
+    Four 		i;              /* loop variable */
+
+
+    TR_PRINT(handle, TR_LOG, TR1, ("log_CopyLogRecord(logRecInfo=%P, space=%P)", logRecInfo, space));
+
+
+    if (space->length == 0) return(eNOERROR);
+
+    /* Get a pointer to destination. */
+    bufIdx = space->bufIdx;
+    basePtrTo = &(LOG_LOGBUFFERPAGE[bufIdx].data[space->offsetInPage]);
+    spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(space->offsetInPage);
+    nCopied = 0;
+
+    skip = space->skip;
+    toCopy = space->length;
 
 
     assert(logRecInfo->nImages <= LOG_MAX_NUM_IMAGES);
 
 
     /*
-     * Write log record.
+     * Copy log record.
      */
-    for (i = 0; i < logRecInfo->nImages + 1; i++) {
+    for (i = 0; i < logRecInfo->nImages + 1 && toCopy > 0; i++) {
 	/*
 	 * get a starting address and the number of bytes of the data to
 	 * be written in this loop
@@ -159,6 +412,18 @@ Four log_WriteLogRecord(
 	    nBytes = logRecInfo->imageSize[i-1];
 	}
 
+	/* skip the part copied by log_ReserveLogSpace() */
+	if (skip >= nBytes) {
+	    skip -= nBytes;
+	    continue;
+	}
+	basePtrFrom += skip;
+	nBytes -= skip;
+	skip = 0;
+
+	nBytes = MIN(nBytes, toCopy);
+	toCopy -= nBytes;
+
 	for ( ; nBytes > 0; ) {
 
 	    /* calculate the amount of bytes that can be stored in this log page */
@@ -170,37 +435,166 @@ Four log_WriteLogRecord(
 	    basePtrFrom += subWritten;
 	    basePtrTo += subWritten;
 	    spaceLeft -= subWritten;
+	    nCopied += subWritten;
 
-            logPage->hdr.lsn.offset += subWritten;
-
-	    /*
-	     *	if the current log page becomes full,
-	     *	a new log page should be allocated for the next logging
-	     */
+	    /* the record continues on the next log buffer page */
 	    if (spaceLeft == 0) {
 
-		/* get the next log buffer page */
-		e = log_AllocPage(handle, &pageNo, &wrapCount);
-		if (e < eNOERROR) ERR(handle, e);
+		/* Let the flusher write the page; this is a full barrier. */
+		(void) __sync_fetch_and_sub(&LOG_LBT_NPENDING(bufIdx), nCopied);
 
-		e = log_AllocLogBuffer(handle, pageNo, wrapCount);
-		if (e < eNOERROR) ERR(handle, e);
+		bufIdx = (bufIdx + 1) % NUM_WRITE_LOG_BUFS;
+		basePtrTo = LOG_LOGBUFFERPAGE[bufIdx].data;
+		spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(0);
+		nCopied = 0;
+	    }
+	}
+    }
 
-		logPage = &LOG_LOGBUFFERPAGE[LOG_LBI_HEAD];
+    if (nCopied > 0) (void) __sync_fetch_and_sub(&LOG_LBT_NPENDING(bufIdx), nCopied);
 
-		/* Initialize the log buffer page */
-                pid.volNo = LOG_LOGMASTER.volNo;
-                pid.pageNo = LOG_GET_PHYSICAL_PAGENO(LOG_LOGMASTER, wrapCount, pageNo); 
-		LOG_INIT_LOG_PAGE(logPage, pid, LOG_GET_LSN_OFFSET_FROM_PAGE_NO(pageNo), wrapCount);
+    return(eNOERROR);
 
-		/* adjust variables */
-		basePtrTo = logPage->data;
-		spaceLeft = LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(0);
+} /* log_CopyLogRecord() */
 
-	    }	/* end if */
-	}
+
+
+/*
+ * Function: Four log_CloseLogSpace(Four)
+ *
+ * Description:
+ *  Close LOG_RESERVEWORD, so that log_TryReserveLogSpace() does not
+ *  reserve more space in the head page. The space reserved so far is
+ *  not settled.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *
+ * Assumption:
+ *  The caller is holding the latch LOG_LATCH4HEAD in any mode.
+ */
+Four log_CloseLogSpace(
+    Four 		handle)
+{
+    (void) __sync_fetch_and_or(&LOG_RESERVEWORD, LOG_RW_CLOSED);
+
+    return(eNOERROR);
+
+} /* log_CloseLogSpace() */
+
+
+
+/*
+ * Function: Four log_SettleLogSpace(Four)
+ *
+ * Description:
+ *  Close LOG_RESERVEWORD and add the space reserved by
+ *  log_TryReserveLogSpace() since it was opened to LOG_LOGMASTER.nextLsn
+ *  and LOG_LOGMASTER.numBytesRemained.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *
+ * Assumption:
+ *  The caller is holding the latch LOG_LATCH4HEAD in M_EXCLUSIVE mode.
+ */
+Four log_SettleLogSpace(
+    Four 		handle)
+{
+    UEight 		word;		/* LOG_RESERVEWORD */
+    Four 		nReserved;	/* # of bytes reserved since the word was opened */
+
+
+    word = __sync_fetch_and_or(&LOG_RESERVEWORD, LOG_RW_CLOSED);
+
+    nReserved = LOG_RW_OFFSET(word) - LOG_RESERVEBASE;
+
+    if (nReserved > 0) {
+	LOG_INCREASE_LSN(LOG_LOGMASTER.nextLsn, nReserved);
+	LOG_LOGMASTER.numBytesRemained -= nReserved;
+	LOG_RESERVEBASE = LOG_RW_OFFSET(word);
     }
 
     return(eNOERROR);
 
-} /* log_WriteLogRecord() */
+} /* log_SettleLogSpace() */
+
+
+
+/*
+ * Function: Four log_OpenLogSpace(Four)
+ *
+ * Description:
+ *  Open the rest of the head page for log_TryReserveLogSpace(). The last
+ *  byte of the page is left for log_ReserveLogSpace(), which allocates the
+ *  next page when the page becomes full; the space is also limited by the
+ *  bytes remained in the log file.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *
+ * Assumption:
+ *  The caller is holding the latch LOG_LATCH4HEAD in M_EXCLUSIVE mode and
+ *  has settled the space.
+ */
+Four log_OpenLogSpace(
+    Four 		handle)
+{
+    UEight 		word;		/* LOG_RESERVEWORD */
+    Four 		offset;		/* offset of LOG_LOGMASTER.nextLsn in the head page */
+    Four 		limit;		/* the largest offset of the open space */
+
+
+    word = LOG_RESERVEWORD;
+
+    /* the log volume is not opened */
+    if (LOG_LOGMASTER.volNo == NIL) return(eNOERROR);
+
+    offset = LOG_GET_PAGE_OFFSET_IN_PAGE_FROM_LSN_OFFSET(LOG_LOGMASTER.nextLsn.offset);
+    limit = MIN(offset + (Four)LOG_GET_SPACE_SIZE_FROM_OFFSET_IN_PAGE(offset) - 1,
+		offset + LOG_LOGMASTER.numBytesRemained);
+    if (limit <= offset) return(eNOERROR);
+
+    LOG_RESERVEBASE = offset;
+
+    __atomic_store_n(&LOG_RESERVEWORD,
+		     LOG_RW_MAKE(LOG_RW_GENERATION(word)+1, LOG_LBI_HEAD, limit, offset), __ATOMIC_RELEASE);
+
+    return(eNOERROR);
+
+} /* log_OpenLogSpace() */
+
+
+
+/*
+ * Function: Four log_GetNextLsn(Four, Lsn_T*)
+ *
+ * Description:
+ *  Get the lsn of the log record to be written next, including the space
+ *  reserved by log_TryReserveLogSpace() but not settled.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *
+ * Assumption:
+ *  The caller is holding the latch LOG_LATCH4HEAD in any mode.
+ */
+Four log_GetNextLsn(
+    Four 		handle,
+    Lsn_T 		*lsn)		/* OUT the next lsn */
+{
+    UEight 		word;		/* LOG_RESERVEWORD */
+
+
+    word = __atomic_load_n(&LOG_RESERVEWORD, __ATOMIC_ACQUIRE);
+
+    *lsn = LOG_LOGMASTER.nextLsn;
+    lsn->offset += LOG_RW_OFFSET(word) - LOG_RESERVEBASE;
+
+    return(eNOERROR);
+
+} /* log_GetNextLsn() */
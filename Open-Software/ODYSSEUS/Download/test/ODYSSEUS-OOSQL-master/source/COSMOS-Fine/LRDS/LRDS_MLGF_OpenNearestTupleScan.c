@@ -0,0 +1,148 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: LRDS_MLGF_OpenNearestTupleScan.c
+ *
+ * Description:
+ *  Open a LRDS level scan on the given relation which uses an MLGF index to
+ *  fetch the tuples in increasing distance from a query point.
+ *
+ * Exports:
+ *  Four LRDS_MLGF_OpenNearestTupleScan(Four, Four, IndexID*, MLGF_HashValue[],
+ *                                      MLGF_HashToCoordFunc, Four, BoolExp[], LockParameter*)
+ *
+ * Returns:
+ *  1) scan identifier if the return value is greater than or equal to 0.
+ *  2) Error code if the return value is less than 0.
+ *      eBADPARAMETER
+ *      some errors caused by function calls
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "Util.h"
+#include "SM.h"
+#include "LRDS.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+Four LRDS_MLGF_OpenNearestTupleScan(
+    Four handle,
+    Four orn,			/* IN open relation number */
+    IndexID *iid,		/* IN MLGF index to be used for this scan */
+    MLGF_HashValue queryPoint[], /* IN query point */
+    MLGF_HashToCoordFunc hashToCoord, /* IN hash value to coordinate mapping */
+    Four nBools,		/* IN number of boolean expressions */
+    BoolExp bool[],		/* IN array of boolean expressions */
+    LockParameter *lockup)	/* IN lock mode & duration */
+{
+    Four e;			/* error code */
+    Four i;			/* index variable */
+    Four scanId;		/* scan id of new scan */
+    MLGF_HashValue lowerBounds[MLGF_MAXNUM_KEYS]; /* the whole region */
+    MLGF_HashValue upperBounds[MLGF_MAXNUM_KEYS];
+
+
+    TR_PRINT(handle, TR_LRDS, TR1,
+	     ("LRDS_MLGF_OpenNearestTupleScan(handle, orn=%ld, iid=%P, queryPoint=%P, hashToCoord=%P, nBools=%ld, bool=%P lockup=%P)",
+	      orn, iid, queryPoint, hashToCoord, nBools, bool, lockup));
+
+
+    /*
+    ** check parameters.
+    */
+    if (queryPoint == NULL) ERR(handle, eBADPARAMETER);
+
+    for (i = 0; i < MLGF_MAXNUM_KEYS; i++) {
+	lowerBounds[i] = MLGF_MIN_HASHVALUE;
+	upperBounds[i] = MLGF_MAX_HASHVALUE;
+    }
+
+    /* Open a scan on the whole index and make it return the nearest tuples first. */
+    scanId = LRDS_MLGF_OpenIndexScan(handle, orn, iid, lowerBounds, upperBounds, nBools, bool, lockup);
+    if (scanId < 0) ERR(handle, scanId);
+
+    e = SM_MLGF_SetNearestQuery(handle, LRDS_SCANTABLE(handle)[scanId].smScanId, queryPoint, hashToCoord);
+    if (e < eNOERROR) {
+	ERROR_PASS(handle, LRDS_CloseScan(handle, scanId));
+	ERR(handle, e);
+    }
+
+
+    return(scanId);
+
+} /* LRDS_MLGF_OpenNearestTupleScan( ) */
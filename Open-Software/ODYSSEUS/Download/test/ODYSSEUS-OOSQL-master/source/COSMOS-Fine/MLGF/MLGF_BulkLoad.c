@@ -0,0 +1,1083 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    This module has been implemented based on "The Multilevel Grid File     */
+/*    (MLGF) Version 4.0," which can be downloaded at                         */
+/*    "http://dblab.kaist.ac.kr/Open-Software/MLGF/main.html".                */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * Module: MLGF_BulkLoad.c
+ *
+ * Description:
+ *  Build an MLGF index bottom-up from a stream of objects sorted in the
+ *  Morton order of their keys.
+ *
+ *  Objects with the same keys are merged into one leaf entry; an entry which
+ *  grows beyond MLGF_OP_IN_THRESHOLD is moved into an overflow chain. Entries
+ *  are packed into pages level by level. A page may only hold a region of
+ *  the cyclic split, i.e., a prefix of the Morton value, so when a level
+ *  exceeds the page fill factor the entries sharing the longest prefix with
+ *  the first entry but not with the incoming one are cut off as a page. The
+ *  region of the page becomes a directory entry of the next level whose MBR
+ *  is computed from the entries of the page.
+ *
+ *  Pages other than the root are written to disk directly without logging;
+ *  only the page allocations and the final image of the root are logged.
+ *
+ * Exports:
+ *  Four MLGF_BulkLoad(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                     PageID*, Four, Two, Two, LogParameter_T*)
+ *  Four MLGF_MakeBulkLoadTuple(Four, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*,
+ *                              char*, char*)
+ */
+
+
+#include <stdlib.h> /* for malloc */
+#include <string.h>
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util.h"
+#include "Util_Sort.h"
+#include "TM.h"
+#include "LOG.h"
+#include "RDsM.h"
+#include "BfM.h"
+#include "MLGF.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/* # of tuples read from the sort stream at a time */
+#define MLGF_BLKLD_NUMOFTUPLES 100
+
+/* maximum height of the bulkloaded index */
+#define MLGF_BLKLD_MAXHEIGHT   32
+
+/* an entry of a level: a leaf entry or a directory entry */
+typedef struct {
+    mlgf_MortonValue morton;			/* Morton value; nBits is the length of the region */
+    MLGF_HashValue   keys[MLGF_MAXNUM_KEYS];	/* keys (leaf) or MBR hash values (directory) */
+    ShortPageID      spid;			/* child page (directory) */
+    Two              theta;			/* used bytes of the child page (directory) */
+    Four             offset;			/* offset of the entry in leafData (leaf) */
+    Four             length;			/* length of the entry in leafData (leaf) */
+} mlgf_BlkLdElem;
+
+/* entries of a level which are not yet written to a page */
+typedef struct {
+    VarArray         elems;			/* array of mlgf_BlkLdElem */
+    Four             nElems;			/* # of entries in elems */
+    Boolean          emitted;			/* TRUE if a page of this level was written */
+    mlgf_MortonValue prevRegion;		/* region of the last written page */
+} mlgf_BlkLdLevel;
+
+#define MLGF_BLKLD_ELEM(level, i) (((mlgf_BlkLdElem*)((level)->elems.ptr))[i])
+
+typedef struct {
+    MLGF_KeyDesc      *kdesc;			/* key descriptor of the index */
+    IndexID           iid;			/* index ID written in page headers */
+    PageID            root;			/* root page of the index */
+    Two               eff;			/* extent fill factor */
+    SegmentID_T       pageSegmentID;		/* page segment of the index */
+
+    VarArray          pool;			/* allocated but not yet used pages */
+    Four              nPool;			/* # of pages in pool */
+    Four              poolIdx;			/* next page to use in pool */
+    Boolean           firstAlloc;		/* TRUE until the first allocation */
+
+    Four              leafCapacity;		/* bytes of a leaf page to be filled */
+    Four              dirCapacity;		/* # of entries of a directory page to be filled */
+    Four              overflowCapacity;		/* # of objects of an overflow page to be filled */
+
+    Four              nLevels;			/* # of levels in use */
+    mlgf_BlkLdLevel   level[MLGF_BLKLD_MAXHEIGHT];
+    char              leafData[PAGESIZE];	/* leaf entries of level 0 */
+    Four              leafDataLen;		/* used bytes of leafData */
+
+    Boolean           hasEntry;			/* TRUE if entry holds a leaf entry */
+    Boolean           inOverflow;		/* TRUE if the objects of the entry are in ovPage */
+    mlgf_MortonValue  entryMorton;		/* Morton value of the entry */
+    Four              entryLen;			/* length of the entry */
+    char              entry[PAGESIZE];		/* leaf entry being made */
+    mlgf_OverflowPage ovPage;			/* overflow page being made */
+
+    mlgf_Page         page;			/* page image to be written */
+    char              tuples[MLGF_BLKLD_NUMOFTUPLES][MLGF_BLKLD_MAXTUPLE_LEN];
+} mlgf_BlkLdInfo;
+
+
+/* Internal Function Prototypes */
+static Four mlgf_BlkLdBuild(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, LogParameter_T*);
+static Four mlgf_BlkLdAddObject(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, MLGF_HashValue[], ObjectID*, char*, LogParameter_T*);
+static Four mlgf_BlkLdEndEntry(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, LogParameter_T*);
+static Four mlgf_BlkLdAddElem(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, mlgf_BlkLdElem*, char*, LogParameter_T*);
+static Four mlgf_BlkLdEmitPage(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, mlgf_BlkLdElem*, LogParameter_T*);
+static Four mlgf_BlkLdWriteRoot(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, LogParameter_T*);
+static Four mlgf_BlkLdAllocPage(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, PageID*, LogParameter_T*);
+static Four mlgf_BlkLdWritePage(Four, mlgf_AnyPage*);
+static Four mlgf_BlkLdCommonPrefix(mlgf_MortonValue*, mlgf_MortonValue*);
+static void mlgf_BlkLdGetValidBits(Four, Four, One[]);
+
+
+
+/*
+ * Function: Four MLGF_BulkLoad(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                              PageID*, Four, Two, Two, LogParameter_T*)
+ *
+ * Description:
+ *  Build the MLGF index from the sort stream whose tuples are made by
+ *  MLGF_MakeBulkLoadTuple() and sorted. The index should be empty.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER
+ *    eMEMORYALLOCERR
+ *    some errors caused by function calls
+ */
+Four MLGF_BulkLoad(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGFIndexInfo 		*iinfo,			/* IN MLGF index info */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of MLGF index */
+    PageID 			*root,			/* IN root page of the index */
+    Four 			sortStreamId,		/* IN sort stream holding the sorted tuples */
+    Two 			eff,			/* IN extent fill factor */
+    Two 			pff,			/* IN page fill factor */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    Four 			e2;			/* error code */
+    Four 			i;			/* loop index */
+    Four 			sizeOfExt;		/* # of pages in an extent */
+    Buffer_ACC_CB 		*root_BCB;		/* buffer access control block for root */
+    mlgf_DirectoryPage 		*rootPage;		/* root page */
+    mlgf_BlkLdInfo 		*info;			/* state of the bulkload */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1,
+	     ("MLGF_BulkLoad(xactEntry=%P, iinfo=%P, kdesc=%P, root=%P, sortStreamId=%ld, eff=%ld, pff=%ld, logParam=%P)",
+	      xactEntry, iinfo, kdesc, root, sortStreamId, eff, pff, logParam));
+
+
+    /* check parameters */
+    if (iinfo == NULL || kdesc == NULL || root == NULL) ERR(handle, eBADPARAMETER);
+
+
+    /* Only an empty index can be bulkloaded. */
+    e = BfM_getAndFixBuffer(handle, root, M_FREE, &root_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    rootPage = (mlgf_DirectoryPage*)root_BCB->bufPagePtr;
+
+    if (rootPage->hdr.nEntries != 0) ERRB1(handle, eBADPARAMETER, root_BCB, PAGE_BUF);
+
+    info = (mlgf_BlkLdInfo*)malloc(sizeof(mlgf_BlkLdInfo));
+    if (info == NULL) ERRB1(handle, eMEMORYALLOCERR, root_BCB, PAGE_BUF);
+
+    info->iid = rootPage->hdr.iid;
+
+    e = BfM_unfixBuffer(handle, root_BCB, PAGE_BUF);
+    if (e < eNOERROR) {
+	free(info);
+	ERR(handle, e);
+    }
+
+
+    /* Initialize the state. */
+    info->kdesc = kdesc;
+    info->root = *root;
+    info->eff = eff;
+    info->nPool = 0;
+    info->poolIdx = 0;
+    info->firstAlloc = TRUE;
+    info->nLevels = 0;
+    info->leafDataLen = 0;
+    info->hasEntry = FALSE;
+    info->inOverflow = FALSE;
+    info->pool.nEntries = 0;
+    info->pool.ptr = NULL;
+
+    info->leafCapacity = ((PAGESIZE - MLGF_LP_FIXED + sizeof(Two)) * pff) / 100;
+    info->dirCapacity = MAX(2, (MLGF_MAX_DIRENTRIES(kdesc->nKeys) * pff) / 100);
+    info->overflowCapacity =
+	MAX(1, (MLGF_OVERFLOW_MAXNUM_OBJECTS(MLGF_LEAFENTRY_OBJECTITEM_LEN(kdesc->extraDataLen)) * pff) / 100);
+
+    e = mlgf_GetSegmentIDFromIndexInfo(handle, xactEntry, iinfo, &info->pageSegmentID, PAGESIZE2);
+    if (e >= eNOERROR) e = RDsM_GetSizeOfExt(handle, root->volNo, &sizeOfExt);
+    if (e >= eNOERROR)
+	e = Util_initVarArray(handle, &info->pool, sizeof(PageID), MAX(1, (sizeOfExt * eff) / 100));
+
+    if (e >= eNOERROR) e = mlgf_BlkLdBuild(handle, xactEntry, info, sortStreamId, logParam);
+
+
+    /* Free the pages allocated but not used. */
+    for ( ; info->poolIdx < info->nPool; info->poolIdx++) {
+	e2 = RDsM_FreeTrain(handle, xactEntry, &(((PageID*)info->pool.ptr)[info->poolIdx]), PAGESIZE2, TRUE, logParam);
+	if (e2 < eNOERROR && e >= eNOERROR) e = e2;
+    }
+
+    for (i = 0; i < info->nLevels; i++) {
+	e2 = Util_finalVarArray(handle, &info->level[i].elems);
+	if (e2 < eNOERROR && e >= eNOERROR) e = e2;
+    }
+
+    if (info->pool.ptr != NULL) {
+	e2 = Util_finalVarArray(handle, &info->pool);
+	if (e2 < eNOERROR && e >= eNOERROR) e = e2;
+    }
+
+    free(info);
+
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* MLGF_BulkLoad() */
+
+
+
+/*
+ * Function: Four MLGF_MakeBulkLoadTuple(Four, MLGF_KeyDesc*, MLGF_HashValue[], ObjectID*,
+ *                                       char*, char*)
+ *
+ * Description:
+ *  Make a sort stream tuple for MLGF_BulkLoad(). The tuple consists of the
+ *  Morton value of the keys as big-endian bytes, the ObjectID, the keys and
+ *  the extra data, so sorting on the first MLGF_BLKLD_SORTKEY_LEN() bytes
+ *  and the ObjectID gives the Morton order.
+ *
+ * Returns:
+ *  length of the tuple
+ */
+Four MLGF_MakeBulkLoadTuple(
+    Four 			handle,
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of MLGF index */
+    MLGF_HashValue 		keys[],			/* IN keys of the object */
+    ObjectID 			*oid,			/* IN object to be inserted */
+    char 			*data,			/* IN extra data of the object */
+    char 			*tuple)			/* OUT tuple of at most MLGF_BLKLD_MAXTUPLE_LEN bytes */
+{
+    Four 			i, j;			/* loop indexes */
+    char 			*ptr;			/* points to the next byte of tuple */
+    One 			nValidBits[MLGF_MAXNUM_KEYS]; /* # of valid bits of each key */
+    mlgf_MortonValue 		morton;			/* Morton value of the keys */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1,
+	     ("MLGF_MakeBulkLoadTuple(kdesc=%P, keys=%P, oid=%P, data=%P, tuple=%P)",
+	      kdesc, keys, oid, data, tuple));
+
+
+    for (i = 0; i < kdesc->nKeys; i++)
+	nValidBits[i] = MLGF_MAXNUM_VALIDBITS;
+
+    mlgf_GetMortonValue(handle, keys, nValidBits, &morton, kdesc->nKeys);
+
+    ptr = tuple;
+    for (i = 0; i < kdesc->nKeys; i++)
+	for (j = sizeof(MortonValue) - 1; j >= 0; j--)
+	    *ptr++ = (char)((morton.val[i] >> (j*CHAR_BIT)) & 0xff);
+
+    memcpy(ptr, oid, sizeof(ObjectID));
+    ptr += sizeof(ObjectID);
+
+    memcpy(ptr, keys, sizeof(MLGF_HashValue)*kdesc->nKeys);
+    ptr += sizeof(MLGF_HashValue)*kdesc->nKeys;
+
+    if (kdesc->extraDataLen > 0) {
+	memcpy(ptr, data, kdesc->extraDataLen);
+	ptr += kdesc->extraDataLen;
+    }
+
+    return(ptr - tuple);
+
+} /* MLGF_MakeBulkLoadTuple() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdBuild(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, LogParameter_T*)
+ *
+ * Description:
+ *  Read the sorted tuples, pack them into pages and write the root.
+ *
+ * Returns:
+ *  Error code
+ *    eINTERNAL
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdBuild(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    Four 			sortStreamId,		/* IN sort stream holding the sorted tuples */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    Four 			i;			/* loop index */
+    Four 			h;			/* level */
+    Four 			nKeys;			/* # of keys */
+    Four 			numSortTuples;		/* # of tuples from the sort stream */
+    Boolean 			done;			/* TRUE if the sort stream is exhausted */
+    SortStreamTuple 		sortTuples[MLGF_BLKLD_NUMOFTUPLES]; /* tuples from the sort stream */
+    MLGF_HashValue 		keys[MLGF_MAXNUM_KEYS];	/* keys of an object */
+    ObjectID 			oid;			/* ObjectID of an object */
+    char 			*ptr;			/* points into a tuple */
+
+
+    nKeys = info->kdesc->nKeys;
+
+    /*
+    ** Insert the objects into the leaf level.
+    */
+    while (1) {
+
+	numSortTuples = MLGF_BLKLD_NUMOFTUPLES;
+	for (i = 0; i < numSortTuples; i++) {
+	    sortTuples[i].len = MLGF_BLKLD_MAXTUPLE_LEN;
+	    sortTuples[i].data = &info->tuples[i][0];
+	}
+
+	e = Util_GetTuplesFromSortStream(handle, sortStreamId, &numSortTuples, sortTuples, &done);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (done) break;
+
+	for (i = 0; i < numSortTuples; i++) {
+
+	    ptr = sortTuples[i].data + MLGF_BLKLD_SORTKEY_LEN(nKeys);
+	    memcpy(&oid, ptr, sizeof(ObjectID));
+	    ptr += sizeof(ObjectID);
+	    memcpy(keys, ptr, sizeof(MLGF_HashValue)*nKeys);
+	    ptr += sizeof(MLGF_HashValue)*nKeys;
+
+	    e = mlgf_BlkLdAddObject(handle, xactEntry, info, keys, &oid, ptr, logParam);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+    }
+
+    if (info->hasEntry) {
+	e = mlgf_BlkLdEndEntry(handle, xactEntry, info, logParam);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    /* nothing to load */
+    if (info->nLevels == 0) return(eNOERROR);
+
+
+    /*
+    ** Write the remaining entries bottom-up. The first directory level
+    ** which has never written a page fits in the root.
+    */
+    for (h = 0; h == 0 || info->level[h].emitted; h++) {
+
+	while (info->level[h].nElems > 0) {
+	    e = mlgf_BlkLdEmitPage(handle, xactEntry, info, h, NULL, logParam);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+    }
+
+    e = mlgf_BlkLdWriteRoot(handle, xactEntry, info, h, logParam);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdBuild() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdAddObject(Four, XactTableEntry_T*, mlgf_BlkLdInfo*,
+ *                                    MLGF_HashValue[], ObjectID*, char*, LogParameter_T*)
+ *
+ * Description:
+ *  Add an object to the leaf entry being made. The objects come in the
+ *  Morton order of the keys and in the ObjectID order for the same keys.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdAddObject(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    MLGF_HashValue 		keys[],			/* IN keys of the object */
+    ObjectID 			*oid,			/* IN ObjectID of the object */
+    char 			*data,			/* IN extra data of the object */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    Four 			i;			/* loop index */
+    Four 			nKeys;			/* # of keys */
+    Four 			extraDataLen;		/* length of the extra data */
+    Four 			objectItemLen;		/* length of an object item */
+    mlgf_LeafEntry 		*entry;			/* leaf entry being made */
+    char 			*objectItemPtr;		/* points to the new object item */
+    One 			nValidBits[MLGF_MAXNUM_KEYS]; /* # of valid bits of each key */
+    PageID 			ovPid;			/* overflow page */
+    PageID 			nextPid;		/* next overflow page */
+
+
+    nKeys = info->kdesc->nKeys;
+    extraDataLen = info->kdesc->extraDataLen;
+    objectItemLen = MLGF_LEAFENTRY_OBJECTITEM_LEN(extraDataLen);
+    entry = (mlgf_LeafEntry*)info->entry;
+
+    /* An object with new keys starts a new leaf entry. */
+    if (info->hasEntry && memcmp(entry->keys, keys, sizeof(MLGF_HashValue)*nKeys) != 0) {
+	e = mlgf_BlkLdEndEntry(handle, xactEntry, info, logParam);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    if (!info->hasEntry) {
+	entry->nObjects = 0;
+	memcpy(entry->keys, keys, sizeof(MLGF_HashValue)*nKeys);
+	info->entryLen = MLGF_LEAFENTRY_LENGTH(nKeys, extraDataLen, 0);
+
+	for (i = 0; i < nKeys; i++)
+	    nValidBits[i] = MLGF_MAXNUM_VALIDBITS;
+	mlgf_GetMortonValue(handle, keys, nValidBits, &info->entryMorton, nKeys);
+
+	info->hasEntry = TRUE;
+    }
+
+    if (!info->inOverflow && info->entryLen + objectItemLen > MLGF_OP_IN_THRESHOLD) {
+	/* Move the objects into an overflow chain. */
+	e = mlgf_BlkLdAllocPage(handle, xactEntry, info, &ovPid, logParam);
+	if (e < eNOERROR) ERR(handle, e);
+
+	memset(&info->ovPage, 0, sizeof(mlgf_OverflowPage));
+	MLGF_INIT_OVERFLOW_PAGE(&info->ovPage, info->iid, ovPid, NIL, NIL, extraDataLen);
+
+	memcpy(MLGF_OVERFLOW_ITH_OBJECTITEM(objectItemLen, &info->ovPage, 0),
+	       MLGF_LEAFENTRY_FIRST_OBJECT(nKeys, entry), entry->nObjects*objectItemLen);
+	info->ovPage.hdr.nObjects = entry->nObjects;
+
+	MLGF_LEAFENTRY_FIRST_OVERFLOW(nKeys, entry) = ovPid.pageNo;
+	entry->nObjects = NIL;
+	info->entryLen = MLGF_LEAFENTRY_LENGTH(nKeys, extraDataLen, NIL);
+	info->inOverflow = TRUE;
+    }
+
+    if (info->inOverflow) {
+	if (info->ovPage.hdr.nObjects >= info->overflowCapacity) {
+	    /* Chain a new overflow page and write the full one. */
+	    e = mlgf_BlkLdAllocPage(handle, xactEntry, info, &nextPid, logParam);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    info->ovPage.hdr.nextPage = nextPid.pageNo;
+
+	    e = mlgf_BlkLdWritePage(handle, (mlgf_AnyPage*)&info->ovPage);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    ovPid = info->ovPage.hdr.pid;
+	    memset(&info->ovPage, 0, sizeof(mlgf_OverflowPage));
+	    MLGF_INIT_OVERFLOW_PAGE(&info->ovPage, info->iid, nextPid, ovPid.pageNo, NIL, extraDataLen);
+	}
+
+	objectItemPtr = MLGF_OVERFLOW_ITH_OBJECTITEM(objectItemLen, &info->ovPage, info->ovPage.hdr.nObjects);
+	info->ovPage.hdr.nObjects ++;
+
+    } else {
+	objectItemPtr = MLGF_LEAFENTRY_ITH_OBJECTITEM(nKeys, extraDataLen, entry, entry->nObjects);
+	entry->nObjects ++;
+	info->entryLen += objectItemLen;
+    }
+
+    *((ObjectID*)objectItemPtr) = *oid;
+    if (extraDataLen > 0)
+	memcpy(objectItemPtr + sizeof(ObjectID), data, extraDataLen);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdAddObject() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdEndEntry(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, LogParameter_T*)
+ *
+ * Description:
+ *  Finish the leaf entry being made and add it to the leaf level.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdEndEntry(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    mlgf_BlkLdElem 		elem;			/* the leaf entry as an entry of level 0 */
+
+
+    if (info->inOverflow) {
+	e = mlgf_BlkLdWritePage(handle, (mlgf_AnyPage*)&info->ovPage);
+	if (e < eNOERROR) ERR(handle, e);
+
+	info->inOverflow = FALSE;
+    }
+
+    elem.morton = info->entryMorton;
+    memcpy(elem.keys, ((mlgf_LeafEntry*)info->entry)->keys, sizeof(MLGF_HashValue)*info->kdesc->nKeys);
+    elem.length = info->entryLen;
+
+    info->hasEntry = FALSE;
+
+    e = mlgf_BlkLdAddElem(handle, xactEntry, info, 0, &elem, info->entry, logParam);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdEndEntry() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdAddElem(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four,
+ *                                  mlgf_BlkLdElem*, char*, LogParameter_T*)
+ *
+ * Description:
+ *  Append an entry to the given level. Pages are written from the front of
+ *  the level until the new entry fits in the page fill factor.
+ *
+ * Returns:
+ *  Error code
+ *    eINTERNAL
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdAddElem(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    Four 			h,			/* IN level; 0 is the leaf level */
+    mlgf_BlkLdElem 		*elem,			/* IN entry to append */
+    char 			*entry,			/* IN leaf entry (level 0) */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    mlgf_BlkLdLevel 		*level;			/* the given level */
+
+
+    if (h >= MLGF_BLKLD_MAXHEIGHT) ERR(handle, eINTERNAL);
+
+    level = &info->level[h];
+
+    if (h == info->nLevels) {
+	e = Util_initVarArray(handle, &level->elems, sizeof(mlgf_BlkLdElem),
+			      (h == 0) ? MLGF_BLKLD_NUMOFTUPLES : info->dirCapacity + 1);
+	if (e < eNOERROR) ERR(handle, e);
+
+	level->nElems = 0;
+	level->emitted = FALSE;
+	info->nLevels ++;
+    }
+
+    /* Write pages until the entry fits. */
+    while (level->nElems > 0 &&
+	   ((h == 0) ? (info->leafDataLen + elem->length + (level->nElems+1)*sizeof(Two) > info->leafCapacity)
+		     : (level->nElems + 1 > info->dirCapacity))) {
+	e = mlgf_BlkLdEmitPage(handle, xactEntry, info, h, elem, logParam);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    if (level->nElems == level->elems.nEntries) {
+	e = Util_doublesizeVarArray(handle, &level->elems, sizeof(mlgf_BlkLdElem));
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    MLGF_BLKLD_ELEM(level, level->nElems) = *elem;
+
+    if (h == 0) {
+	MLGF_BLKLD_ELEM(level, level->nElems).offset = info->leafDataLen;
+	memcpy(&info->leafData[info->leafDataLen], entry, elem->length);
+	info->leafDataLen += elem->length;
+    }
+
+    level->nElems ++;
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdAddElem() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdEmitPage(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four,
+ *                                   mlgf_BlkLdElem*, LogParameter_T*)
+ *
+ * Description:
+ *  Write the entries at the front of the given level into a page and add
+ *  the directory entry of the page to the next level. The region of the
+ *  page is the prefix of the first entry just long enough to exclude
+ *  'bound', the entry to be appended next, and the region of the last page
+ *  written at this level; the entries within the region form the page.
+ *  If 'bound' is NULL, the region is widened to hold all the entries as far
+ *  as the last region allows.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdEmitPage(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    Four 			h,			/* IN level; 0 is the leaf level */
+    mlgf_BlkLdElem 		*bound,			/* IN entry to be appended next or NULL */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    Four 			i, k;			/* loop indexes */
+    Four 			n;			/* # of entries written into the page */
+    Four 			len;			/* length of the region of the page */
+    Four 			nKeys;			/* # of keys */
+    Four 			entryLen;		/* length of a directory entry */
+    Four 			nBytes;			/* bytes of the leaf entries written */
+    mlgf_BlkLdLevel 		*level;			/* the given level */
+    mlgf_BlkLdElem 		*first;			/* the first entry of the level */
+    mlgf_BlkLdElem 		*child;			/* an entry written into the page */
+    mlgf_BlkLdElem 		parent;			/* directory entry for the page */
+    mlgf_DirectoryEntry 	*dirEntry;		/* a directory entry in the page */
+    MLGF_HashValue 		*hashValues;		/* hash values of dirEntry */
+    One 			nValidBits[MLGF_MAXNUM_KEYS]; /* # of valid bits of each key */
+    PageID 			pid;			/* the page */
+
+
+    nKeys = info->kdesc->nKeys;
+    level = &info->level[h];
+    first = &MLGF_BLKLD_ELEM(level, 0);
+
+
+    /*
+    ** Get the region of the page.
+    */
+    if (bound != NULL)
+	len = mlgf_BlkLdCommonPrefix(&first->morton, &bound->morton) + 1;
+    else
+	len = mlgf_BlkLdCommonPrefix(&first->morton, &MLGF_BLKLD_ELEM(level, level->nElems-1).morton);
+
+    if (level->emitted)
+	len = MAX(len, mlgf_BlkLdCommonPrefix(&first->morton, &level->prevRegion) + 1);
+
+    for (n = 1; n < level->nElems; n++)
+	if (mlgf_BlkLdCommonPrefix(&first->morton, &MLGF_BLKLD_ELEM(level, n).morton) < len) break;
+
+
+    /*
+    ** Get the MBR of the region.
+    */
+    mlgf_BlkLdGetValidBits(len, nKeys, nValidBits);
+
+    for (k = 0; k < nKeys; k++) {
+	if (MLGF_KEYDESC_IS_MINTYPE(*info->kdesc, k))
+	    parent.keys[k] = MLGF_HASHVALUE_MASK_UPPER_N_BITS(first->keys[k], nValidBits[k]) |
+			     MLGF_HASHVALUE_SET_EXCEPT_UPPER_N_BITS(nValidBits[k]);
+	else
+	    parent.keys[k] = MLGF_HASHVALUE_MASK_UPPER_N_BITS(first->keys[k], nValidBits[k]);
+    }
+
+    for (i = 0; i < n; i++) {
+	child = &MLGF_BLKLD_ELEM(level, i);
+
+	for (k = 0; k < nKeys; k++) {
+	    if ((MLGF_KEYDESC_IS_MINTYPE(*info->kdesc, k) && (parent.keys[k] > child->keys[k])) ||
+		(MLGF_KEYDESC_IS_MAXTYPE(*info->kdesc, k) && (parent.keys[k] < child->keys[k])))
+		parent.keys[k] = child->keys[k];
+	}
+    }
+
+    mlgf_GetMortonValue(handle, parent.keys, nValidBits, &parent.morton, nKeys);
+
+
+    /*
+    ** Make the page.
+    */
+    e = mlgf_BlkLdAllocPage(handle, xactEntry, info, &pid, logParam);
+    if (e < eNOERROR) ERR(handle, e);
+
+    memset(&info->page, 0, sizeof(mlgf_Page));
+
+    if (h == 0) {
+	MLGF_INIT_LEAF_PAGE(&info->page.leaf, info->iid, pid, nKeys, info->kdesc->extraDataLen);
+
+	/* The entries to be written are at the front of leafData. */
+	nBytes = 0;
+	for (i = 0; i < n; i++) {
+	    info->page.leaf.slot[-i] = MLGF_BLKLD_ELEM(level, i).offset;
+	    nBytes += MLGF_BLKLD_ELEM(level, i).length;
+	}
+	memcpy(info->page.leaf.data, info->leafData, nBytes);
+
+	info->page.leaf.hdr.nEntries = n;
+	info->page.leaf.hdr.free = nBytes;
+
+	parent.theta = MLGF_LP_THETA(&info->page.leaf);
+
+	/* Remove the written entries from leafData. */
+	memmove(info->leafData, &info->leafData[nBytes], info->leafDataLen - nBytes);
+	info->leafDataLen -= nBytes;
+	for (i = n; i < level->nElems; i++)
+	    MLGF_BLKLD_ELEM(level, i).offset -= nBytes;
+
+    } else {
+	MLGF_INIT_DIRECTORY_PAGE(&info->page.directory, info->iid, pid, h, FALSE, nKeys);
+
+	entryLen = MLGF_DIRENTRY_LENGTH(nKeys);
+	for (i = 0; i < n; i++) {
+	    child = &MLGF_BLKLD_ELEM(level, i);
+	    dirEntry = MLGF_ITH_DIRENTRY(&info->page.directory, i, entryLen);
+
+	    dirEntry->spid = child->spid;
+	    dirEntry->theta = child->theta;
+	    mlgf_BlkLdGetValidBits(child->morton.nBits, nKeys, dirEntry->nValidBits);
+
+	    hashValues = MLGF_DIRENTRY_HASHVALUEPTR(dirEntry, nKeys);
+	    memcpy(hashValues, child->keys, sizeof(MLGF_HashValue)*nKeys);
+	}
+
+	info->page.directory.hdr.nEntries = n;
+
+	parent.theta = MLGF_DP_THETA(&info->page.directory, entryLen);
+    }
+
+    info->page.any.hdr.lsn = COMMON_PER_THREAD_DS_PTR(handle)->nilLsn;
+    info->page.any.hdr.logRecLen = 0;
+
+    e = mlgf_BlkLdWritePage(handle, &info->page.any);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    /* Remove the written entries from the level. */
+    level->prevRegion = parent.morton;
+    level->emitted = TRUE;
+
+    memmove(&MLGF_BLKLD_ELEM(level, 0), &MLGF_BLKLD_ELEM(level, n), sizeof(mlgf_BlkLdElem)*(level->nElems - n));
+    level->nElems -= n;
+
+
+    /* Add the directory entry of the page to the next level. */
+    parent.spid = pid.pageNo;
+
+    e = mlgf_BlkLdAddElem(handle, xactEntry, info, h+1, &parent, NULL, logParam);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdEmitPage() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdWriteRoot(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, Four, LogParameter_T*)
+ *
+ * Description:
+ *  Copy the entries of the given level into the root with logging.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdWriteRoot(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    Four 			h,			/* IN level which becomes the root */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+    Four 			i;			/* loop index */
+    Four 			nKeys;			/* # of keys */
+    Four 			entryLen;		/* length of a directory entry */
+    mlgf_BlkLdLevel 		*level;			/* the given level */
+    mlgf_BlkLdElem 		*child;			/* an entry of the level */
+    mlgf_DirectoryEntry 	*dirEntry;		/* a directory entry in the root */
+    Buffer_ACC_CB 		*root_BCB;		/* buffer access control block for root */
+    mlgf_DirectoryPage 		*rootPage;		/* root page */
+    Lsn_T 			lsn;                  	/* lsn of the newly written log record */
+    Four 			logRecLen;             	/* log record length */
+    LOG_LogRecInfo_T 		logRecInfo; 		/* log record information */
+
+    /* pointer for COMMON Data Structure of perThreadTable */
+    COMMON_PerThreadDS_T *common_perThreadDSptr = COMMON_PER_THREAD_DS_PTR(handle);
+
+
+    nKeys = info->kdesc->nKeys;
+    level = &info->level[h];
+
+    e = BfM_getAndFixBuffer(handle, &info->root, M_FREE, &root_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    rootPage = (mlgf_DirectoryPage*)root_BCB->bufPagePtr;
+
+    /* Make the new image of the root. */
+    info->page.directory = *rootPage;
+    MLGF_INIT_DIRECTORY_PAGE(&info->page.directory, rootPage->hdr.iid, info->root, h, TRUE, nKeys);
+
+    entryLen = MLGF_DIRENTRY_LENGTH(nKeys);
+    for (i = 0; i < level->nElems; i++) {
+	child = &MLGF_BLKLD_ELEM(level, i);
+	dirEntry = MLGF_ITH_DIRENTRY(&info->page.directory, i, entryLen);
+
+	dirEntry->spid = child->spid;
+	dirEntry->theta = child->theta;
+	mlgf_BlkLdGetValidBits(child->morton.nBits, nKeys, dirEntry->nValidBits);
+	memcpy(MLGF_DIRENTRY_HASHVALUEPTR(dirEntry, nKeys), child->keys, sizeof(MLGF_HashValue)*nKeys);
+    }
+
+    info->page.directory.hdr.nEntries = level->nElems;
+
+    /*
+     * Write log record.
+     */
+    if (logParam->logFlag & LOG_FLAG_DATA_LOGGING) {
+
+	LOG_FILL_LOGRECINFO_2(logRecInfo, xactEntry->xactId, LOG_TYPE_UPDATE,
+			      LOG_ACTION_MLGF_COPY_PAGE, LOG_REDO_UNDO,
+			      info->root, xactEntry->lastLsn, common_perThreadDSptr->nilLsn,
+			      sizeof(mlgf_Page), &info->page,
+			      sizeof(mlgf_Page), rootPage);
+
+	e = LOG_WriteLogRecord(handle, xactEntry, &logRecInfo, &lsn, &logRecLen);
+	if (e < eNOERROR) ERRB1(handle, e, root_BCB, PAGE_BUF);
+
+	*rootPage = info->page.directory;
+
+	rootPage->hdr.lsn = lsn;
+	rootPage->hdr.logRecLen = logRecLen;
+
+    } else {
+	*rootPage = info->page.directory;
+	INCREASE_LSN_BY_ONE(rootPage->hdr.lsn);
+    }
+
+    root_BCB->dirtyFlag = 1;
+
+    e = BfM_unfixBuffer(handle, root_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdWriteRoot() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdAllocPage(Four, XactTableEntry_T*, mlgf_BlkLdInfo*, PageID*, LogParameter_T*)
+ *
+ * Description:
+ *  Get a new page. Pages are allocated an extent at a time, and the first
+ *  extent is taken near the root.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdAllocPage(
+    Four 			handle,
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    mlgf_BlkLdInfo 		*info,			/* INOUT state of the bulkload */
+    PageID 			*pid,			/* OUT allocated page */
+    LogParameter_T 		*logParam)		/* IN log parameter */
+{
+    Four 			e;			/* error code */
+
+
+    if (info->poolIdx == info->nPool) {
+
+	info->nPool = info->pool.nEntries;
+
+	e = RDsM_AllocContigTrainsInExt(handle, xactEntry, info->root.volNo, &info->pageSegmentID,
+					(info->firstAlloc) ? &info->root : NULL,
+					&info->nPool, PAGESIZE2, info->eff, (PageID*)info->pool.ptr, logParam);
+	if (e < eNOERROR) ERR(handle, e);
+
+	/* The extent of the root is full. */
+	if (info->nPool == 0) {
+	    info->nPool = info->pool.nEntries;
+
+	    e = RDsM_AllocContigTrainsInExt(handle, xactEntry, info->root.volNo, &info->pageSegmentID, NULL,
+					    &info->nPool, PAGESIZE2, info->eff, (PageID*)info->pool.ptr, logParam);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+
+	info->poolIdx = 0;
+	info->firstAlloc = FALSE;
+    }
+
+    *pid = ((PageID*)info->pool.ptr)[info->poolIdx++];
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdAllocPage() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdWritePage(Four, mlgf_AnyPage*)
+ *
+ * Description:
+ *  Write the page image to disk directly.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_BlkLdWritePage(
+    Four 			handle,
+    mlgf_AnyPage 		*page)			/* IN page image to write */
+{
+    Four 			e;			/* error code */
+
+
+    e = BfM_FlushTrain(handle, &page->hdr.pid, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = RDsM_WriteTrain(handle, (char*)page, &page->hdr.pid, PAGESIZE2);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = BfM_RemoveTrain(handle, &page->hdr.pid, PAGE_BUF, FALSE);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_BlkLdWritePage() */
+
+
+
+/*
+ * Function: Four mlgf_BlkLdCommonPrefix(mlgf_MortonValue*, mlgf_MortonValue*)
+ *
+ * Description:
+ *  Get the length of the common prefix of two regions.
+ *
+ * Returns:
+ *  # of common leading bits, at most the shorter length of the two
+ */
+static Four mlgf_BlkLdCommonPrefix(
+    mlgf_MortonValue 		*x,			/* IN one region */
+    mlgf_MortonValue 		*y)			/* IN another region */
+{
+    Four 			i;			/* index of a Morton value element */
+    Four 			len;			/* # of common bits */
+    Four 			nBits;			/* shorter length of the two */
+    MortonValue 		diff;			/* differing bits */
+
+
+    nBits = MIN(x->nBits, y->nBits);
+
+    for (i = 0, len = 0; len < nBits; i++, len += MLGF_MORTONVALUE_MAXNUM_BITS) {
+	diff = x->val[i] ^ y->val[i];
+
+	if (diff) {
+	    for ( ; !(diff & MLGF_MORTONVALUE_MSB_SET); diff <<= (unsigned)1) len++;
+	    break;
+	}
+    }
+
+    return(MIN(len, nBits));
+
+} /* mlgf_BlkLdCommonPrefix() */
+
+
+
+/*
+ * Function: void mlgf_BlkLdGetValidBits(Four, Four, One[])
+ *
+ * Description:
+ *  Get the # of valid bits of each key for a region of the given length
+ *  under the cyclic split.
+ *
+ * Returns:
+ *  None
+ */
+static void mlgf_BlkLdGetValidBits(
+    Four 			len,			/* IN length of the region */
+    Four 			nKeys,			/* IN # of keys */
+    One 			nValidBits[])		/* OUT # of valid bits of each key */
+{
+    Four 			k;			/* loop index */
+
+
+    for (k = 0; k < nKeys; k++)
+	nValidBits[k] = len/nKeys + ((k < len%nKeys) ? 1 : 0);
+
+} /* mlgf_BlkLdGetValidBits() */
@@ -0,0 +1,672 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    This module has been implemented based on "The Multilevel Grid File     */
+/*    (MLGF) Version 4.0," which can be downloaded at                         */
+/*    "http://dblab.kaist.ac.kr/Open-Software/MLGF/main.html".                */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * Module: MLGF_FetchNearest.c
+ *
+ * Description:
+ *  Incremental nearest-neighbour search on an MLGF index.
+ *  Pages and objects are visited in best-first order: a priority queue keeps
+ *  every region not yet expanded keyed on the minimum distance between the
+ *  region and the query point, and the queue top is expanded until an object
+ *  reaches the top. Objects are therefore returned in increasing distance
+ *  order, and a scan which is closed after k objects reads only the pages
+ *  whose regions are nearer than the k-th object.
+ *
+ *  For an MBR index (some attributes are MIN type) the distance is that
+ *  between the query point and the MBR; otherwise the keys are taken as a
+ *  point. Hash values are mapped back to coordinates by queue->hashToCoord
+ *  before the distance is computed since the hash function need not be
+ *  linear.
+ *
+ * Exports:
+ *  Four MLGF_FetchNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                         MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*,
+ *                         MLGF_Cursor*, char*, LockParameter*)
+ *  Four MLGF_FetchNextNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                             MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*,
+ *                             MLGF_Cursor*, char*, LockParameter*)
+ */
+
+
+#include <string.h>
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util.h"
+#include "TM.h"
+#include "MLGF.h"
+#include "LM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+/* Internal Function Prototypes */
+static Four mlgf_NextNearest(Four, XactTableEntry_T*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[],
+			     MLGF_NearestQueue*, MLGF_Cursor*, char*, LockParameter*);
+static Four mlgf_ExpandNearestPage(Four, XactTableEntry_T*, MLGF_KeyDesc*, MLGF_HashValue[], MLGF_HashValue[],
+				   MLGF_NearestQueue*, mlgf_NearestElem*, LockParameter*);
+static Four mlgf_ExpandNearestOverflow(Four, MLGF_KeyDesc*, MLGF_NearestQueue*, mlgf_NearestElem*);
+static double mlgf_NearestDistance(MLGF_KeyDesc*, MLGF_NearestQueue*, MLGF_HashValue[], MLGF_HashValue[]);
+static Four mlgf_NearestPush(Four, MLGF_NearestQueue*, mlgf_NearestElem*);
+static void mlgf_NearestPop(MLGF_NearestQueue*, mlgf_NearestElem*);
+
+
+/* TRUE if the element 'a' should be taken before 'b' */
+/* On a tie objects come first so that a scan stops as early as possible. */
+#define MLGF_NEAREST_BEFORE(a, b) \
+((a).dist < (b).dist || ((a).dist == (b).dist && (a).type > (b).type))
+
+
+
+/*
+ * Function: MLGF_FetchNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                             MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*,
+ *                             MLGF_Cursor*, char*, LockParameter*)
+ *
+ * Description:
+ *  Start a nearest-neighbour search and return the object nearest to
+ *  queue->queryPoint among those in the given range. The queue should have
+ *  been initialized by the caller; its heap is reset here.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER
+ *    some errors caused by function calls
+ */
+Four MLGF_FetchNearest(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGFIndexInfo		*iinfo,			/* IN MLGF Index Info */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_HashValue 		*lowerBound,		/* IN lower bound of region to fetch */
+    MLGF_HashValue 		*upperBound,		/* IN upper bound of region to fetch */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue of the search */
+    MLGF_Cursor 		*cursor,		/* OUT return the position of fetched object */
+    char 			*data,			/* OUT return the extra data */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e, i;			/* error code */
+    mlgf_NearestElem		elem;			/* the root element */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1, ("MLGF_FetchNearest(xactEntry=%P, iinfo=%P, kdesc=%P, lowerBound=%P, upperBound=%P, queue=%P, cursor=%P, data=%P, lockup=%P)", xactEntry, iinfo, kdesc, lowerBound, upperBound, queue, cursor, data, lockup));
+
+
+    if (iinfo == NULL || kdesc == NULL || lowerBound == NULL || upperBound == NULL ||
+	queue == NULL || cursor == NULL)
+	ERR(handle, eBADPARAMETER);
+
+    /* Get 'rootPid' from MLGF index info */
+    e = mlgf_GetRootPid(handle, xactEntry, iinfo, &elem.pid, lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    elem.dist = 0.0;
+    elem.type = MLGF_NEAREST_PAGE;
+    elem.kLockMode = L_S;
+    if (lockup) {
+	elem.kLockMode = L_IS;
+	for (i = 0; i < kdesc->nKeys; i++)
+	    if (lowerBound[i] != 0 || upperBound[i] != MLGF_HASHVALUE_ALL_BITS_SET) {
+		elem.kLockMode = L_S;
+		break;
+	    }
+    }
+
+    queue->nElems = 0;
+    e = mlgf_NearestPush(handle, queue, &elem);
+    if (e < eNOERROR) ERR(handle, e);
+
+    MLGF_CURSOR_PATH_INIT(cursor);	/* the path is not used by this search */
+    e = mlgf_NextNearest(handle, xactEntry, kdesc, lowerBound, upperBound, queue, cursor, data, lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* MLGF_FetchNearest( ) */
+
+
+
+/*
+ * Function: MLGF_FetchNextNearest(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                                 MLGF_HashValue[], MLGF_HashValue[], MLGF_NearestQueue*,
+ *                                 MLGF_Cursor*, char*, LockParameter*)
+ *
+ * Description:
+ *  Return the next nearest object of a search started by MLGF_FetchNearest().
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER
+ *    eBADCURSOR
+ *    some errors caused by function calls
+ */
+Four MLGF_FetchNextNearest(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGFIndexInfo		*iinfo,			/* IN MLGF Index Info */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_HashValue 		*lowerBound,		/* IN lower bound of region to fetch */
+    MLGF_HashValue 		*upperBound,		/* IN upper bound of region to fetch */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue of the search */
+    MLGF_Cursor 		*cursor,		/* INOUT return the position of fetched object */
+    char 			*data,			/* OUT return the extra data */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1, ("MLGF_FetchNextNearest(xactEntry=%P, iinfo=%P, kdesc=%P, lowerBound=%P, upperBound=%P, queue=%P, cursor=%P, data=%P, lockup=%P)", xactEntry, iinfo, kdesc, lowerBound, upperBound, queue, cursor, data, lockup));
+
+
+    if (iinfo == NULL || kdesc == NULL || lowerBound == NULL || upperBound == NULL ||
+	queue == NULL || cursor == NULL)
+	ERR(handle, eBADPARAMETER);
+
+    if (cursor->flag == CURSOR_EOS) return(eNOERROR);
+    if (cursor->flag != CURSOR_ON) ERR(handle, eBADCURSOR);
+
+    e = mlgf_NextNearest(handle, xactEntry, kdesc, lowerBound, upperBound, queue, cursor, data, lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* MLGF_FetchNextNearest( ) */
+
+
+
+/*
+ * Function: mlgf_NextNearest(Four, XactTableEntry_T*, MLGF_KeyDesc*, MLGF_HashValue[],
+ *                            MLGF_HashValue[], MLGF_NearestQueue*, MLGF_Cursor*, char*,
+ *                            LockParameter*)
+ *
+ * Description:
+ *  Expand the queue top until an object comes to the top, and make the
+ *  cursor point to the object. If the queue becomes empty, the cursor's flag
+ *  is set to CURSOR_EOS.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_NextNearest(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_HashValue 		*lowerBound,		/* IN lower bound of region to fetch */
+    MLGF_HashValue 		*upperBound,		/* IN upper bound of region to fetch */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue of the search */
+    MLGF_Cursor 		*cursor,		/* OUT return the position of fetched object */
+    char 			*data,			/* OUT return the extra data */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    mlgf_NearestElem		elem;			/* the queue top */
+
+
+    while (queue->nElems > 0) {
+
+	mlgf_NearestPop(queue, &elem);
+
+	switch (elem.type) {
+	  case MLGF_NEAREST_OBJECT:
+	    cursor->leaf = elem.pid;
+	    cursor->overflow = elem.overflow;
+	    cursor->entryNo = 0;
+	    cursor->oidArrayElemNo = 0;
+	    cursor->oid = elem.oid;
+	    memcpy((char*)cursor->keys, (char*)elem.keys, sizeof(cursor->keys[0])*kdesc->nKeys);
+	    if (data) memcpy(data, elem.data, kdesc->extraDataLen);
+	    cursor->flag = CURSOR_ON;
+
+	    return(eNOERROR);
+
+	  case MLGF_NEAREST_OVERFLOW:
+	    e = mlgf_ExpandNearestOverflow(handle, kdesc, queue, &elem);
+	    if (e < eNOERROR) ERR(handle, e);
+	    break;
+
+	  default:		/* MLGF_NEAREST_PAGE */
+	    e = mlgf_ExpandNearestPage(handle, xactEntry, kdesc, lowerBound, upperBound, queue, &elem, lockup);
+	    if (e < eNOERROR) ERR(handle, e);
+	    break;
+	}
+    }
+
+    cursor->flag = CURSOR_EOS;
+
+    return(eNOERROR);
+
+} /* mlgf_NextNearest() */
+
+
+
+/*
+ * Function: mlgf_ExpandNearestPage(Four, XactTableEntry_T*, MLGF_KeyDesc*, MLGF_HashValue[],
+ *                                  MLGF_HashValue[], MLGF_NearestQueue*, mlgf_NearestElem*,
+ *                                  LockParameter*)
+ *
+ * Description:
+ *  Push the entries of a directory or leaf page intersecting the given range
+ *  into the queue. Locks are acquired as mlgf_Fetch() does.
+ *
+ * Returns:
+ *  Error code
+ *    eDEADLOCK
+ *    some errors caused by function calls
+ */
+static Four mlgf_ExpandNearestPage(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_HashValue 		*lowerBound,		/* IN lower bound of region to fetch */
+    MLGF_HashValue 		*upperBound,		/* IN upper bound of region to fetch */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue of the search */
+    mlgf_NearestElem		*page,			/* IN page to expand */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    Four 			i, j, k;		/* index variable */
+    Four 			entryLen;		/* length of a directory entry */
+    char 			*objectItem;		/* starting point of object item of object list */
+    mlgf_Page 			*apage;			/* an MLGF page */
+    mlgf_LeafEntry 		*leafEntry;		/* a leaf entry */
+    mlgf_DirectoryEntry 	*dirEntry; 		/* a directory entry */
+    MLGF_HashValue 		*hashVector;		/* vector of hash values */
+    MLGF_HashValue 		min[MLGF_MAXNUM_KEYS];	/* region represented by an entry */
+    MLGF_HashValue 		max[MLGF_MAXNUM_KEYS];
+    Buffer_ACC_CB 		*page_BCB;		/* buffer control block for the page */
+    mlgf_NearestElem		elem;			/* element to push */
+    LockReply 			lockReply;
+    LockMode 			oldMode;
+    Boolean 			isLeafNode = FALSE;
+
+
+    TR_PRINT(handle, TR_MLGF, TR1,
+	     ("mlgf_ExpandNearestPage(kdesc=%P, lowerBound=%P, upperBound=%P, queue=%P, page=%P)",
+	      kdesc, lowerBound, upperBound, queue, page));
+
+    if (lockup) {
+	e = LM_getKeyRangeLock(handle, &xactEntry->xactId, &page->pid, page->kLockMode, L_MANUAL,
+			       L_UNCONDITIONAL, &lockReply);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (lockReply == LR_DEADLOCK) ERR(handle, eDEADLOCK);
+
+	e = LM_getFlatPageLock(handle, &xactEntry->xactId, &page->pid, lockup->mode, L_MANUAL,
+			       L_UNCONDITIONAL, &lockReply, &oldMode);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (lockReply == LR_DEADLOCK) ERR(handle, eDEADLOCK);
+    }
+
+    e = BfM_getAndFixBuffer(handle, &page->pid, M_FREE, &page_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    apage = (mlgf_Page*)page_BCB->bufPagePtr;
+
+    if (apage->any.hdr.type & MLGF_LEAFPAGE) { /* leaf page */
+
+	/* upgrade lock mode */
+	if (lockup && page->kLockMode == L_IS) {
+	    e = LM_getKeyRangeLock(handle, &xactEntry->xactId, &page->pid, L_S, L_MANUAL,
+				   L_UNCONDITIONAL, &lockReply);
+	    if (e < eNOERROR) ERRB1(handle, e, page_BCB, PAGE_BUF);
+
+	    if (lockReply == LR_DEADLOCK) ERRB1(handle, eDEADLOCK, page_BCB, PAGE_BUF);
+	}
+
+	isLeafNode = TRUE;
+
+	elem.pid = page->pid;
+
+	for (i = 0; i < apage->leaf.hdr.nEntries; i++) {
+	    leafEntry = MLGF_ITH_LEAFENTRY(&apage->leaf, i);
+
+	    for (k = 0; k < kdesc->nKeys; k++)
+		if (leafEntry->keys[k] < lowerBound[k] || leafEntry->keys[k] > upperBound[k])
+		    break;
+
+	    if (k < kdesc->nKeys) continue;
+
+	    elem.dist = mlgf_NearestDistance(kdesc, queue, leafEntry->keys, leafEntry->keys);
+	    memcpy((char*)elem.keys, (char*)leafEntry->keys, sizeof(elem.keys[0])*kdesc->nKeys);
+
+	    if (leafEntry->nObjects >= 0) { /* normal entry */
+
+		elem.type = MLGF_NEAREST_OBJECT;
+		SET_NILPAGEID(elem.overflow);
+
+		for (j = 0; j < leafEntry->nObjects; j++) {
+		    objectItem = MLGF_LEAFENTRY_ITH_OBJECTITEM(kdesc->nKeys, kdesc->extraDataLen, leafEntry, j);
+		    elem.oid = *((ObjectID*)objectItem);
+		    memcpy(elem.data, objectItem+sizeof(ObjectID), kdesc->extraDataLen);
+
+		    e = mlgf_NearestPush(handle, queue, &elem);
+		    if (e < eNOERROR) ERRB1(handle, e, page_BCB, PAGE_BUF);
+		}
+
+	    } else {		/* overflow entry */
+
+		elem.type = MLGF_NEAREST_OVERFLOW;
+		MAKE_PAGEID(elem.overflow, page->pid.volNo,
+			    MLGF_LEAFENTRY_FIRST_OVERFLOW(kdesc->nKeys, leafEntry));
+
+		e = mlgf_NearestPush(handle, queue, &elem);
+		if (e < eNOERROR) ERRB1(handle, e, page_BCB, PAGE_BUF);
+	    }
+	}
+
+    } else {			/* directory page */
+
+	/* Get the length of a directory entry. */
+	entryLen = MLGF_DIRENTRY_LENGTH(kdesc->nKeys);
+
+	elem.type = MLGF_NEAREST_PAGE;
+
+	dirEntry = MLGF_ITH_DIRENTRY(&apage->directory, 0, entryLen);
+	for (i = 0; i < apage->directory.hdr.nEntries; i++, dirEntry = MLGF_NEXT_DIRENTRY(dirEntry, entryLen)) {
+	    hashVector = MLGF_DIRENTRY_HASHVALUEPTR(dirEntry, kdesc->nKeys);
+
+	    for (k = 0; k < kdesc->nKeys; k++) {
+		if (MLGF_KEYDESC_IS_MINTYPE(*kdesc,k)) {
+		    min[k] = hashVector[k];
+		    max[k] = MLGF_HASHVALUE_SET_EXCEPT_UPPER_N_BITS(dirEntry->nValidBits[k]) | hashVector[k];
+		} else {	/* max type attribute */
+		    min[k] = MLGF_HASHVALUE_MASK_UPPER_N_BITS(hashVector[k], dirEntry->nValidBits[k]);
+		    max[k] = hashVector[k];
+		}
+		if (min[k] > upperBound[k] || max[k] < lowerBound[k]) break;
+	    }
+
+	    if (k < kdesc->nKeys) continue;
+
+	    MAKE_PAGEID(elem.pid, page->pid.volNo, dirEntry->spid);
+	    elem.dist = mlgf_NearestDistance(kdesc, queue, min, max);
+	    elem.kLockMode = L_S;
+	    if (lockup && !mlgf_IsContained(handle, kdesc, lowerBound, upperBound, dirEntry))
+		elem.kLockMode = L_IS;
+
+	    e = mlgf_NearestPush(handle, queue, &elem);
+	    if (e < eNOERROR) ERRB1(handle, e, page_BCB, PAGE_BUF);
+	}
+    }
+
+    e = BfM_unfixBuffer(handle, page_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    if (lockup && isLeafNode) {
+	e = LM_releaseFlatPageLock(handle, &xactEntry->xactId, &page->pid, L_MANUAL);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* mlgf_ExpandNearestPage() */
+
+
+
+/*
+ * Function: mlgf_ExpandNearestOverflow(Four, MLGF_KeyDesc*, MLGF_NearestQueue*, mlgf_NearestElem*)
+ *
+ * Description:
+ *  Push the objects of an overflow page into the queue together with the
+ *  next page of the overflow chain. All of them have the same keys, hence
+ *  the same distance.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_ExpandNearestOverflow(
+    Four                        handle,                 /* IN handle */
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue of the search */
+    mlgf_NearestElem		*ovfl)			/* IN overflow page to expand */
+{
+    Four 			e;			/* error code */
+    Four 			i;			/* index variable */
+    Four 			elemLen;		/* length of an object item */
+    char 			*objectItem;		/* points to an element in object array */
+    mlgf_OverflowPage 		*opage;			/* an overflow page */
+    Buffer_ACC_CB 		*ov_BCB;		/* buffer control block for overflow page */
+    mlgf_NearestElem		elem;			/* element to push */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1,
+	     ("mlgf_ExpandNearestOverflow(kdesc=%P, queue=%P, ovfl=%P)", kdesc, queue, ovfl));
+
+    e = BfM_getAndFixBuffer(handle, &ovfl->overflow, M_FREE, &ov_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    opage = (mlgf_OverflowPage*)ov_BCB->bufPagePtr;
+
+    elem = *ovfl;
+    elemLen = MLGF_LEAFENTRY_OBJECTITEM_LEN(kdesc->extraDataLen);
+
+    elem.type = MLGF_NEAREST_OBJECT;
+    for (i = 0; i < opage->hdr.nObjects; i++) {
+	objectItem = MLGF_OVERFLOW_ITH_OBJECTITEM(elemLen, opage, i);
+	elem.oid = *((ObjectID*)objectItem);
+	memcpy(elem.data, objectItem+sizeof(ObjectID), kdesc->extraDataLen);
+
+	e = mlgf_NearestPush(handle, queue, &elem);
+	if (e < eNOERROR) ERRB1(handle, e, ov_BCB, PAGE_BUF);
+    }
+
+    if (opage->hdr.nextPage != NIL) {
+	elem.type = MLGF_NEAREST_OVERFLOW;
+	elem.overflow.pageNo = opage->hdr.nextPage;
+
+	e = mlgf_NearestPush(handle, queue, &elem);
+	if (e < eNOERROR) ERRB1(handle, e, ov_BCB, PAGE_BUF);
+    }
+
+    e = BfM_unfixBuffer(handle, ov_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_ExpandNearestOverflow() */
+
+
+
+/*
+ * Function: mlgf_NearestDistance(MLGF_KeyDesc*, MLGF_NearestQueue*, MLGF_HashValue[], MLGF_HashValue[])
+ *
+ * Description:
+ *  Return the square of the minimum distance between the query point and
+ *  any key in the region [min, max]. For an MBR index, a MIN type attribute
+ *  only contributes when the region lies above the query point and a MAX
+ *  type attribute when it lies below, which gives the distance between the
+ *  query point and the nearest MBR the region can hold.
+ *
+ * Returns:
+ *  the squared distance
+ */
+static double mlgf_NearestDistance(
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of this index */
+    MLGF_NearestQueue		*queue,			/* IN query point and coordinate mapping */
+    MLGF_HashValue 		*min,			/* IN lower corner of the region */
+    MLGF_HashValue 		*max)			/* IN upper corner of the region */
+{
+    Four 			k;			/* index variable */
+    double 			q, lo, hi;		/* coordinates */
+    double 			gap;			/* distance along an axis */
+    double 			dist;			/* the squared distance */
+    Boolean 			mbrFlag;		/* TRUE if the keys are MBRs */
+
+
+    mbrFlag = (kdesc->minMaxTypeVector != 0);
+
+    for (dist = 0.0, k = 0; k < kdesc->nKeys; k++) {
+
+	if (queue->hashToCoord) {
+	    q = (*queue->hashToCoord)(queue->queryPoint[k]);
+	    lo = (*queue->hashToCoord)(min[k]);
+	    hi = (*queue->hashToCoord)(max[k]);
+	} else {
+	    q = (double)queue->queryPoint[k];
+	    lo = (double)min[k];
+	    hi = (double)max[k];
+	}
+
+	gap = 0.0;
+	if (lo > q && (!mbrFlag || MLGF_KEYDESC_IS_MINTYPE(*kdesc,k))) gap = lo - q;
+	else if (hi < q && (!mbrFlag || MLGF_KEYDESC_IS_MAXTYPE(*kdesc,k))) gap = q - hi;
+
+	dist += gap * gap;
+    }
+
+    return(dist);
+
+} /* mlgf_NearestDistance() */
+
+
+
+/*
+ * Function: mlgf_NearestPush(Four, MLGF_NearestQueue*, mlgf_NearestElem*)
+ *
+ * Description:
+ *  Insert an element into the heap.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_NearestPush(
+    Four                        handle,                 /* IN handle */
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue */
+    mlgf_NearestElem		*elem)			/* IN element to insert */
+{
+    Four 			e;			/* error code */
+    Four 			i, parent;		/* heap positions */
+
+
+    if (queue->nElems >= queue->heap.nEntries) {
+	e = Util_doublesizeVarArray(handle, &queue->heap, sizeof(mlgf_NearestElem));
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    /* sift up */
+    for (i = queue->nElems++; i > 0; i = parent) {
+	parent = (i - 1) / 2;
+	if (!MLGF_NEAREST_BEFORE(*elem, MLGF_NEAREST_ELEM(queue, parent))) break;
+	MLGF_NEAREST_ELEM(queue, i) = MLGF_NEAREST_ELEM(queue, parent);
+    }
+    MLGF_NEAREST_ELEM(queue, i) = *elem;
+
+    return(eNOERROR);
+
+} /* mlgf_NearestPush() */
+
+
+
+/*
+ * Function: mlgf_NearestPop(MLGF_NearestQueue*, mlgf_NearestElem*)
+ *
+ * Description:
+ *  Remove the top element of a non-empty heap.
+ *
+ * Returns:
+ *  None
+ */
+static void mlgf_NearestPop(
+    MLGF_NearestQueue		*queue,			/* INOUT priority queue */
+    mlgf_NearestElem		*elem)			/* OUT the removed element */
+{
+    Four 			i, child;		/* heap positions */
+    mlgf_NearestElem		*last;			/* last element of the heap */
+
+
+    *elem = MLGF_NEAREST_ELEM(queue, 0);
+
+    last = &MLGF_NEAREST_ELEM(queue, --queue->nElems);
+
+    /* sift down */
+    for (i = 0; (child = 2*i + 1) < queue->nElems; i = child) {
+	if (child + 1 < queue->nElems &&
+	    MLGF_NEAREST_BEFORE(MLGF_NEAREST_ELEM(queue, child+1), MLGF_NEAREST_ELEM(queue, child)))
+	    child++;
+	if (!MLGF_NEAREST_BEFORE(MLGF_NEAREST_ELEM(queue, child), *last)) break;
+	MLGF_NEAREST_ELEM(queue, i) = MLGF_NEAREST_ELEM(queue, child);
+    }
+    MLGF_NEAREST_ELEM(queue, i) = *last;
+
+} /* mlgf_NearestPop() */
@@ -0,0 +1,733 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    This module has been implemented based on "The Multilevel Grid File     */
+/*    (MLGF) Version 4.0," which can be downloaded at                         */
+/*    "http://dblab.kaist.ac.kr/Open-Software/MLGF/main.html".                */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * Module: MLGF_SpatialJoin.c
+ *
+ * Description:
+ *  Spatial join of two MLGF indexes whose keys are MBRs.
+ *  The two indexes are traversed synchronously: starting from the pair of
+ *  root pages, a pair of pages is expanded into the pairs of their child
+ *  pages whose regions may hold intersecting MBRs. When both pages of a pair
+ *  are leaves, their objects are joined and the pairs of objects whose MBRs
+ *  intersect are returned one at a time. Each page of an index is reached
+ *  through only one directory entry, so no pair of objects is returned
+ *  twice.
+ *
+ *  The keys of both indexes should be hashed by the same function so that
+ *  the hash values of the two indexes can be compared with each other.
+ *
+ * Exports:
+ *  Four MLGF_SpatialJoin(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                        MLGF_HashValue[], MLGF_HashValue[], MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                        MLGF_HashValue[], MLGF_HashValue[], MLGF_SpatialJoinCursor*,
+ *                        LockParameter*)
+ *  Four MLGF_NextSpatialJoin(Four, XactTableEntry_T*, MLGF_SpatialJoinCursor*,
+ *                            ObjectID*, ObjectID*, LockParameter*)
+ */
+
+
+#include <string.h>
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util.h"
+#include "TM.h"
+#include "MLGF.h"
+#include "LM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+/* Internal Function Prototypes */
+static Four mlgf_JoinExpandPagePair(Four, XactTableEntry_T*, MLGF_SpatialJoinCursor*, mlgf_JoinPagePair*, LockParameter*);
+static Four mlgf_JoinFixPage(Four, XactTableEntry_T*, PageID*, Buffer_ACC_CB**, LockParameter*);
+static Four mlgf_JoinUnfixPage(Four, XactTableEntry_T*, PageID*, Buffer_ACC_CB*, LockParameter*);
+static Four mlgf_JoinGatherLeaf(Four, MLGF_SpatialJoinCursor*, Two, PageID*, mlgf_LeafPage*,
+				MLGF_HashValue[], MLGF_HashValue[], Four*);
+static void mlgf_JoinEntryRegion(MLGF_KeyDesc*, mlgf_DirectoryEntry*, MLGF_HashValue[], MLGF_HashValue[]);
+static Boolean mlgf_JoinOverlap(Four, MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[]);
+static Boolean mlgf_JoinInRange(Four, MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[]);
+static Four mlgf_JoinPushPagePair(Four, MLGF_SpatialJoinCursor*, mlgf_JoinPagePair*);
+
+
+
+/*
+ * Function: MLGF_SpatialJoin(Four, XactTableEntry_T*, MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                            MLGF_HashValue[], MLGF_HashValue[], MLGFIndexInfo*, MLGF_KeyDesc*,
+ *                            MLGF_HashValue[], MLGF_HashValue[], MLGF_SpatialJoinCursor*,
+ *                            LockParameter*)
+ *
+ * Description:
+ *  Start a spatial join of two MLGF indexes. Only the objects in the given
+ *  range of each index take part in the join. The VarArrays of the join
+ *  cursor should have been initialized by the caller; the pairs are fetched
+ *  by MLGF_NextSpatialJoin().
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER
+ *    some errors caused by function calls
+ */
+Four MLGF_SpatialJoin(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGFIndexInfo		*iinfo1,		/* IN MLGF Index Info of the first index */
+    MLGF_KeyDesc 		*kdesc1,		/* IN key descriptor of the first index */
+    MLGF_HashValue 		*lowerBound1,		/* IN lower bound of region of the first index */
+    MLGF_HashValue 		*upperBound1,		/* IN upper bound of region of the first index */
+    MLGFIndexInfo		*iinfo2,		/* IN MLGF Index Info of the second index */
+    MLGF_KeyDesc 		*kdesc2,		/* IN key descriptor of the second index */
+    MLGF_HashValue 		*lowerBound2,		/* IN lower bound of region of the second index */
+    MLGF_HashValue 		*upperBound2,		/* IN upper bound of region of the second index */
+    MLGF_SpatialJoinCursor	*join,			/* INOUT state of the join */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e, k;			/* error code */
+    mlgf_JoinPagePair		pair;			/* the pair of root pages */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1, ("MLGF_SpatialJoin(xactEntry=%P, iinfo1=%P, kdesc1=%P, lowerBound1=%P, upperBound1=%P, iinfo2=%P, kdesc2=%P, lowerBound2=%P, upperBound2=%P, join=%P, lockup=%P)", xactEntry, iinfo1, kdesc1, lowerBound1, upperBound1, iinfo2, kdesc2, lowerBound2, upperBound2, join, lockup));
+
+
+    if (iinfo1 == NULL || kdesc1 == NULL || lowerBound1 == NULL || upperBound1 == NULL ||
+	iinfo2 == NULL || kdesc2 == NULL || lowerBound2 == NULL || upperBound2 == NULL || join == NULL)
+	ERR(handle, eBADPARAMETER);
+
+    /* Both indexes should have MBRs of the same dimension. */
+    if (kdesc1->nKeys != kdesc2->nKeys || kdesc1->nKeys % 2 != 0) ERR(handle, eBADPARAMETER);
+
+    join->kdesc[0] = *kdesc1;
+    join->kdesc[1] = *kdesc2;
+    memcpy((char*)join->lowerBound[0], (char*)lowerBound1, sizeof(MLGF_HashValue)*kdesc1->nKeys);
+    memcpy((char*)join->upperBound[0], (char*)upperBound1, sizeof(MLGF_HashValue)*kdesc1->nKeys);
+    memcpy((char*)join->lowerBound[1], (char*)lowerBound2, sizeof(MLGF_HashValue)*kdesc2->nKeys);
+    memcpy((char*)join->upperBound[1], (char*)upperBound2, sizeof(MLGF_HashValue)*kdesc2->nKeys);
+
+    /* Get 'rootPid's from MLGF index infos */
+    e = mlgf_GetRootPid(handle, xactEntry, iinfo1, &pair.pid[0], lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = mlgf_GetRootPid(handle, xactEntry, iinfo2, &pair.pid[1], lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    for (k = 0; k < kdesc1->nKeys; k++) {
+	pair.min[0][k] = pair.min[1][k] = 0;
+	pair.max[0][k] = pair.max[1][k] = MLGF_HASHVALUE_ALL_BITS_SET;
+    }
+
+    join->nPagePairs = 0;
+    join->nObjectPairs = 0;
+
+    e = mlgf_JoinPushPagePair(handle, join, &pair);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* MLGF_SpatialJoin( ) */
+
+
+
+/*
+ * Function: MLGF_NextSpatialJoin(Four, XactTableEntry_T*, MLGF_SpatialJoinCursor*,
+ *                                ObjectID*, ObjectID*, LockParameter*)
+ *
+ * Description:
+ *  Return the next pair of objects whose MBRs intersect. Pairs of pages are
+ *  expanded until some pairs of objects are found.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER
+ *    some errors caused by function calls
+ *  EOS if there is no more pair
+ */
+Four MLGF_NextSpatialJoin(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGF_SpatialJoinCursor	*join,			/* INOUT state of the join */
+    ObjectID			*oid1,			/* OUT object of the first index */
+    ObjectID			*oid2,			/* OUT object of the second index */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    mlgf_JoinPagePair		pair;			/* the pair on the stack top */
+
+
+    TR_PRINT(handle, TR_MLGF, TR1, ("MLGF_NextSpatialJoin(xactEntry=%P, join=%P, oid1=%P, oid2=%P, lockup=%P)", xactEntry, join, oid1, oid2, lockup));
+
+
+    if (join == NULL || oid1 == NULL || oid2 == NULL) ERR(handle, eBADPARAMETER);
+
+    while (join->nObjectPairs == 0) {
+
+	if (join->nPagePairs == 0) return(EOS);
+
+	/* The pair is copied out since the stack may grow while it is expanded. */
+	pair = MLGF_JOIN_PAGEPAIR(join, --join->nPagePairs);
+
+	e = mlgf_JoinExpandPagePair(handle, xactEntry, join, &pair, lockup);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    join->nObjectPairs--;
+    *oid1 = MLGF_JOIN_OBJECTPAIR(join, join->nObjectPairs).oid[0];
+    *oid2 = MLGF_JOIN_OBJECTPAIR(join, join->nObjectPairs).oid[1];
+
+    return(eNOERROR);
+
+} /* MLGF_NextSpatialJoin( ) */
+
+
+
+/*
+ * Function: mlgf_JoinExpandPagePair(Four, XactTableEntry_T*, MLGF_SpatialJoinCursor*,
+ *                                   mlgf_JoinPagePair*, LockParameter*)
+ *
+ * Description:
+ *  Expand a pair of pages. If both pages are directory pages, every pair of
+ *  their entries whose regions may hold intersecting MBRs is pushed. If only
+ *  one is a directory page, its entries are paired with the leaf page. If
+ *  both are leaf pages, their objects are joined and the pairs of objects
+ *  whose MBRs intersect are appended to the object pairs.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_JoinExpandPagePair(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    MLGF_SpatialJoinCursor	*join,			/* INOUT state of the join */
+    mlgf_JoinPagePair		*pair,			/* IN pair of pages to expand */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    Four 			i, j;			/* index variable */
+    Four 			s;			/* side of the directory page */
+    Four 			nKeys;			/* # of keys */
+    Four 			entryLen;		/* length of a directory entry */
+    Four 			nObjects[2];		/* # of gathered objects of each side */
+    mlgf_Page 			*apage[2];		/* the pages of the pair */
+    mlgf_DirectoryEntry 	*dirEntry[2]; 		/* a directory entry of each page */
+    mlgf_JoinObject		*obj1, *obj2;		/* objects to compare */
+    mlgf_JoinObjectPair		*opair;			/* an object pair to return */
+    Buffer_ACC_CB 		*page_BCB[2];		/* buffer control blocks for the pages */
+    mlgf_JoinPagePair		child;			/* page pair to push */
+    Boolean 			isLeaf[2];
+
+
+    TR_PRINT(handle, TR_MLGF, TR1, ("mlgf_JoinExpandPagePair(join=%P, pair=%P)", join, pair));
+
+    nKeys = join->kdesc[0].nKeys;
+    entryLen = MLGF_DIRENTRY_LENGTH(nKeys);
+
+    e = mlgf_JoinFixPage(handle, xactEntry, &pair->pid[0], &page_BCB[0], lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = mlgf_JoinFixPage(handle, xactEntry, &pair->pid[1], &page_BCB[1], lockup);
+    if (e < eNOERROR) ERRB1(handle, e, page_BCB[0], PAGE_BUF);
+
+    for (s = 0; s < 2; s++) {
+	apage[s] = (mlgf_Page*)page_BCB[s]->bufPagePtr;
+	isLeaf[s] = (apage[s]->any.hdr.type & MLGF_LEAFPAGE) ? TRUE : FALSE;
+    }
+
+    if (!isLeaf[0] && !isLeaf[1]) {
+
+	dirEntry[0] = MLGF_ITH_DIRENTRY(&apage[0]->directory, 0, entryLen);
+	for (i = 0; i < apage[0]->directory.hdr.nEntries; i++, dirEntry[0] = MLGF_NEXT_DIRENTRY(dirEntry[0], entryLen)) {
+
+	    mlgf_JoinEntryRegion(&join->kdesc[0], dirEntry[0], child.min[0], child.max[0]);
+	    if (!mlgf_JoinInRange(nKeys, child.min[0], child.max[0], join->lowerBound[0], join->upperBound[0]) ||
+		!mlgf_JoinOverlap(nKeys, child.min[0], child.max[0], pair->min[1], pair->max[1]))
+		continue;
+
+	    MAKE_PAGEID(child.pid[0], pair->pid[0].volNo, dirEntry[0]->spid);
+
+	    dirEntry[1] = MLGF_ITH_DIRENTRY(&apage[1]->directory, 0, entryLen);
+	    for (j = 0; j < apage[1]->directory.hdr.nEntries; j++, dirEntry[1] = MLGF_NEXT_DIRENTRY(dirEntry[1], entryLen)) {
+
+		mlgf_JoinEntryRegion(&join->kdesc[1], dirEntry[1], child.min[1], child.max[1]);
+		if (!mlgf_JoinInRange(nKeys, child.min[1], child.max[1], join->lowerBound[1], join->upperBound[1]) ||
+		    !mlgf_JoinOverlap(nKeys, child.min[0], child.max[0], child.min[1], child.max[1]))
+		    continue;
+
+		MAKE_PAGEID(child.pid[1], pair->pid[1].volNo, dirEntry[1]->spid);
+
+		e = mlgf_JoinPushPagePair(handle, join, &child);
+		if (e < eNOERROR) {
+		    (Four)BfM_unfixBuffer(handle, page_BCB[0], PAGE_BUF);
+		    ERRB1(handle, e, page_BCB[1], PAGE_BUF);
+		}
+	    }
+	}
+
+    } else if (!isLeaf[0] || !isLeaf[1]) {
+
+	/* Pair the entries of the directory page with the leaf page. */
+	s = isLeaf[0] ? 1 : 0;
+	child = *pair;
+
+	dirEntry[s] = MLGF_ITH_DIRENTRY(&apage[s]->directory, 0, entryLen);
+	for (i = 0; i < apage[s]->directory.hdr.nEntries; i++, dirEntry[s] = MLGF_NEXT_DIRENTRY(dirEntry[s], entryLen)) {
+
+	    mlgf_JoinEntryRegion(&join->kdesc[s], dirEntry[s], child.min[s], child.max[s]);
+	    if (!mlgf_JoinInRange(nKeys, child.min[s], child.max[s], join->lowerBound[s], join->upperBound[s]) ||
+		!mlgf_JoinOverlap(nKeys, child.min[0], child.max[0], child.min[1], child.max[1]))
+		continue;
+
+	    MAKE_PAGEID(child.pid[s], pair->pid[s].volNo, dirEntry[s]->spid);
+
+	    e = mlgf_JoinPushPagePair(handle, join, &child);
+	    if (e < eNOERROR) {
+		(Four)BfM_unfixBuffer(handle, page_BCB[0], PAGE_BUF);
+		ERRB1(handle, e, page_BCB[1], PAGE_BUF);
+	    }
+	}
+
+    } else {
+
+	/* Only the objects which may intersect the other page's region take part. */
+	for (s = 0; s < 2; s++) {
+	    e = mlgf_JoinGatherLeaf(handle, join, s, &pair->pid[s], &apage[s]->leaf,
+				    pair->min[1-s], pair->max[1-s], &nObjects[s]);
+	    if (e < eNOERROR) {
+		(Four)BfM_unfixBuffer(handle, page_BCB[0], PAGE_BUF);
+		ERRB1(handle, e, page_BCB[1], PAGE_BUF);
+	    }
+	}
+
+	for (i = 0; i < nObjects[0]; i++) {
+	    obj1 = &MLGF_JOIN_OBJECT(join, 0, i);
+
+	    for (j = 0; j < nObjects[1]; j++) {
+		obj2 = &MLGF_JOIN_OBJECT(join, 1, j);
+
+		if (!mlgf_JoinOverlap(nKeys, obj1->keys, obj1->keys, obj2->keys, obj2->keys)) continue;
+
+		if (join->nObjectPairs >= join->objectPairs.nEntries) {
+		    e = Util_doublesizeVarArray(handle, &join->objectPairs, sizeof(mlgf_JoinObjectPair));
+		    if (e < eNOERROR) {
+			(Four)BfM_unfixBuffer(handle, page_BCB[0], PAGE_BUF);
+			ERRB1(handle, e, page_BCB[1], PAGE_BUF);
+		    }
+		}
+
+		opair = &MLGF_JOIN_OBJECTPAIR(join, join->nObjectPairs++);
+		opair->oid[0] = obj1->oid;
+		opair->oid[1] = obj2->oid;
+	    }
+	}
+    }
+
+    e = mlgf_JoinUnfixPage(handle, xactEntry, &pair->pid[0], page_BCB[0], lockup);
+    if (e < eNOERROR) ERRB1(handle, e, page_BCB[1], PAGE_BUF);
+
+    e = mlgf_JoinUnfixPage(handle, xactEntry, &pair->pid[1], page_BCB[1], lockup);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* mlgf_JoinExpandPagePair() */
+
+
+
+/*
+ * Function: mlgf_JoinFixPage(Four, XactTableEntry_T*, PageID*, Buffer_ACC_CB**, LockParameter*)
+ *
+ * Description:
+ *  Lock and fix a page of an index. The key range lock of a leaf page is
+ *  upgraded to L_S since its objects are read.
+ *
+ * Returns:
+ *  Error code
+ *    eDEADLOCK
+ *    some errors caused by function calls
+ */
+static Four mlgf_JoinFixPage(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    PageID			*pid,			/* IN page to fix */
+    Buffer_ACC_CB 		**page_BCB,		/* OUT buffer control block for the page */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    mlgf_Page 			*apage;			/* an MLGF page */
+    LockReply 			lockReply;
+    LockMode 			oldMode;
+
+
+    if (lockup) {
+	e = LM_getKeyRangeLock(handle, &xactEntry->xactId, pid, L_IS, L_MANUAL,
+			       L_UNCONDITIONAL, &lockReply);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (lockReply == LR_DEADLOCK) ERR(handle, eDEADLOCK);
+
+	e = LM_getFlatPageLock(handle, &xactEntry->xactId, pid, lockup->mode, L_MANUAL,
+			       L_UNCONDITIONAL, &lockReply, &oldMode);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (lockReply == LR_DEADLOCK) ERR(handle, eDEADLOCK);
+    }
+
+    e = BfM_getAndFixBuffer(handle, pid, M_FREE, page_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    apage = (mlgf_Page*)(*page_BCB)->bufPagePtr;
+
+    /* upgrade lock mode */
+    if (lockup && (apage->any.hdr.type & MLGF_LEAFPAGE)) {
+	e = LM_getKeyRangeLock(handle, &xactEntry->xactId, pid, L_S, L_MANUAL,
+			       L_UNCONDITIONAL, &lockReply);
+	if (e < eNOERROR) ERRB1(handle, e, *page_BCB, PAGE_BUF);
+
+	if (lockReply == LR_DEADLOCK) ERRB1(handle, eDEADLOCK, *page_BCB, PAGE_BUF);
+    }
+
+    return(eNOERROR);
+
+} /* mlgf_JoinFixPage() */
+
+
+
+/*
+ * Function: mlgf_JoinUnfixPage(Four, XactTableEntry_T*, PageID*, Buffer_ACC_CB*, LockParameter*)
+ *
+ * Description:
+ *  Unfix a page fixed by mlgf_JoinFixPage(). The flat page lock of a leaf
+ *  page is released as mlgf_Fetch() does.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_JoinUnfixPage(
+    Four                        handle,                 /* IN handle */
+    XactTableEntry_T 		*xactEntry, 		/* IN transaction table entry */
+    PageID			*pid,			/* IN page to unfix */
+    Buffer_ACC_CB 		*page_BCB,		/* IN buffer control block for the page */
+    LockParameter 		*lockup)      		/* IN request lock or not */
+{
+    Four 			e;			/* error code */
+    Boolean 			isLeafNode;
+
+
+    isLeafNode = (((mlgf_Page*)page_BCB->bufPagePtr)->any.hdr.type & MLGF_LEAFPAGE) ? TRUE : FALSE;
+
+    e = BfM_unfixBuffer(handle, page_BCB, PAGE_BUF);
+    if (e < eNOERROR) ERR(handle, e);
+
+    if (lockup && isLeafNode) {
+	e = LM_releaseFlatPageLock(handle, &xactEntry->xactId, pid, L_MANUAL);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* mlgf_JoinUnfixPage() */
+
+
+
+/*
+ * Function: mlgf_JoinGatherLeaf(Four, MLGF_SpatialJoinCursor*, Two, PageID*, mlgf_LeafPage*,
+ *                               MLGF_HashValue[], MLGF_HashValue[], Four*)
+ *
+ * Description:
+ *  Collect into join->objects[side] the objects of a leaf page which are in
+ *  the range of the index and whose MBRs may intersect the region [min, max]
+ *  of the other page. The overflow chains are followed.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_JoinGatherLeaf(
+    Four                        handle,                 /* IN handle */
+    MLGF_SpatialJoinCursor	*join,			/* INOUT state of the join */
+    Two				side,			/* IN which index the page belongs to */
+    PageID			*pid,			/* IN the leaf page */
+    mlgf_LeafPage		*apage,			/* IN pointer to the leaf page */
+    MLGF_HashValue 		*min,			/* IN region of the other page */
+    MLGF_HashValue 		*max,
+    Four			*nObjects)		/* OUT # of gathered objects */
+{
+    Four 			e;			/* error code */
+    Four 			i, j;			/* index variable */
+    Four 			elemLen;		/* length of an object item */
+    Four 			nKeys;			/* # of keys */
+    Four 			extraDataLen;		/* length of the extra data */
+    char 			*objectItem;		/* starting point of object item */
+    mlgf_LeafEntry 		*leafEntry;		/* a leaf entry */
+    mlgf_OverflowPage 		*opage;			/* an overflow page */
+    Buffer_ACC_CB 		*ov_BCB;		/* buffer control block for overflow page */
+    PageID			ovPid;			/* an overflow page */
+    mlgf_JoinObject		*obj;			/* a gathered object */
+
+
+    nKeys = join->kdesc[side].nKeys;
+    extraDataLen = join->kdesc[side].extraDataLen;
+    elemLen = MLGF_LEAFENTRY_OBJECTITEM_LEN(extraDataLen);
+
+    *nObjects = 0;
+
+    for (i = 0; i < apage->hdr.nEntries; i++) {
+	leafEntry = MLGF_ITH_LEAFENTRY(apage, i);
+
+	if (!mlgf_JoinInRange(nKeys, leafEntry->keys, leafEntry->keys,
+			      join->lowerBound[side], join->upperBound[side]) ||
+	    !mlgf_JoinOverlap(nKeys, leafEntry->keys, leafEntry->keys, min, max))
+	    continue;
+
+	if (leafEntry->nObjects >= 0) { /* normal entry */
+
+	    for (j = 0; j < leafEntry->nObjects; j++) {
+		if (*nObjects >= join->objects[side].nEntries) {
+		    e = Util_doublesizeVarArray(handle, &join->objects[side], sizeof(mlgf_JoinObject));
+		    if (e < eNOERROR) ERR(handle, e);
+		}
+
+		objectItem = MLGF_LEAFENTRY_ITH_OBJECTITEM(nKeys, extraDataLen, leafEntry, j);
+		obj = &MLGF_JOIN_OBJECT(join, side, (*nObjects)++);
+		obj->oid = *((ObjectID*)objectItem);
+		memcpy((char*)obj->keys, (char*)leafEntry->keys, sizeof(obj->keys[0])*nKeys);
+	    }
+
+	} else {		/* overflow entry */
+
+	    MAKE_PAGEID(ovPid, pid->volNo, MLGF_LEAFENTRY_FIRST_OVERFLOW(nKeys, leafEntry));
+
+	    while (ovPid.pageNo != NIL) {
+		e = BfM_getAndFixBuffer(handle, &ovPid, M_FREE, &ov_BCB, PAGE_BUF);
+		if (e < eNOERROR) ERR(handle, e);
+
+		opage = (mlgf_OverflowPage*)ov_BCB->bufPagePtr;
+
+		for (j = 0; j < opage->hdr.nObjects; j++) {
+		    if (*nObjects >= join->objects[side].nEntries) {
+			e = Util_doublesizeVarArray(handle, &join->objects[side], sizeof(mlgf_JoinObject));
+			if (e < eNOERROR) ERRB1(handle, e, ov_BCB, PAGE_BUF);
+		    }
+
+		    objectItem = MLGF_OVERFLOW_ITH_OBJECTITEM(elemLen, opage, j);
+		    obj = &MLGF_JOIN_OBJECT(join, side, (*nObjects)++);
+		    obj->oid = *((ObjectID*)objectItem);
+		    memcpy((char*)obj->keys, (char*)leafEntry->keys, sizeof(obj->keys[0])*nKeys);
+		}
+
+		ovPid.pageNo = opage->hdr.nextPage;
+
+		e = BfM_unfixBuffer(handle, ov_BCB, PAGE_BUF);
+		if (e < eNOERROR) ERR(handle, e);
+	    }
+	}
+    }
+
+    return(eNOERROR);
+
+} /* mlgf_JoinGatherLeaf() */
+
+
+
+/*
+ * Function: mlgf_JoinEntryRegion(MLGF_KeyDesc*, mlgf_DirectoryEntry*, MLGF_HashValue[], MLGF_HashValue[])
+ *
+ * Description:
+ *  Get the region represented by a directory entry.
+ *
+ * Returns:
+ *  None
+ */
+static void mlgf_JoinEntryRegion(
+    MLGF_KeyDesc 		*kdesc,			/* IN key descriptor of the index */
+    mlgf_DirectoryEntry 	*dirEntry, 		/* IN a directory entry */
+    MLGF_HashValue 		*min,			/* OUT region represented by the entry */
+    MLGF_HashValue 		*max)
+{
+    Four 			k;			/* index variable */
+    MLGF_HashValue 		*hashVector;		/* vector of hash values */
+
+
+    hashVector = MLGF_DIRENTRY_HASHVALUEPTR(dirEntry, kdesc->nKeys);
+
+    for (k = 0; k < kdesc->nKeys; k++) {
+	if (MLGF_KEYDESC_IS_MINTYPE(*kdesc,k)) {
+	    min[k] = hashVector[k];
+	    max[k] = MLGF_HASHVALUE_SET_EXCEPT_UPPER_N_BITS(dirEntry->nValidBits[k]) | hashVector[k];
+	} else {	/* max type attribute */
+	    min[k] = MLGF_HASHVALUE_MASK_UPPER_N_BITS(hashVector[k], dirEntry->nValidBits[k]);
+	    max[k] = hashVector[k];
+	}
+    }
+
+} /* mlgf_JoinEntryRegion() */
+
+
+
+/*
+ * Function: mlgf_JoinOverlap(Four, MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[])
+ *
+ * Description:
+ *  Check whether some MBR in the region [min1, max1] may intersect some MBR
+ *  in the region [min2, max2]. The first half of the keys is the lower corner
+ *  of an MBR and the second half the upper corner. With min == max the
+ *  regions are MBRs themselves and the MBRs are tested.
+ *
+ * Returns:
+ *  TRUE if they may intersect
+ */
+static Boolean mlgf_JoinOverlap(
+    Four			nKeys,			/* IN # of keys */
+    MLGF_HashValue 		*min1,			/* IN the first region */
+    MLGF_HashValue 		*max1,
+    MLGF_HashValue 		*min2,			/* IN the second region */
+    MLGF_HashValue 		*max2)
+{
+    Four 			k;			/* index variable */
+    Four 			d;			/* dimension */
+
+
+    d = nKeys / 2;
+
+    for (k = 0; k < d; k++)
+	if (min1[k] > max2[k+d] || min2[k] > max1[k+d]) return(FALSE);
+
+    return(TRUE);
+
+} /* mlgf_JoinOverlap() */
+
+
+
+/*
+ * Function: mlgf_JoinInRange(Four, MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[], MLGF_HashValue[])
+ *
+ * Description:
+ *  Check whether the region [min, max] intersects the range [lowerBound, upperBound].
+ *
+ * Returns:
+ *  TRUE if they intersect
+ */
+static Boolean mlgf_JoinInRange(
+    Four			nKeys,			/* IN # of keys */
+    MLGF_HashValue 		*min,			/* IN the region */
+    MLGF_HashValue 		*max,
+    MLGF_HashValue 		*lowerBound,		/* IN the range */
+    MLGF_HashValue 		*upperBound)
+{
+    Four 			k;			/* index variable */
+
+
+    for (k = 0; k < nKeys; k++)
+	if (min[k] > upperBound[k] || max[k] < lowerBound[k]) return(FALSE);
+
+    return(TRUE);
+
+} /* mlgf_JoinInRange() */
+
+
+
+/*
+ * Function: mlgf_JoinPushPagePair(Four, MLGF_SpatialJoinCursor*, mlgf_JoinPagePair*)
+ *
+ * Description:
+ *  Push a pair of pages onto the stack.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+static Four mlgf_JoinPushPagePair(
+    Four                        handle,                 /* IN handle */
+    MLGF_SpatialJoinCursor	*join,			/* INOUT state of the join */
+    mlgf_JoinPagePair		*pair)			/* IN pair to push */
+{
+    Four 			e;			/* error code */
+
+
+    if (join->nPagePairs >= join->pagePairs.nEntries) {
+	e = Util_doublesizeVarArray(handle, &join->pagePairs, sizeof(mlgf_JoinPagePair));
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    MLGF_JOIN_PAGEPAIR(join, join->nPagePairs++) = *pair;
+
+    return(eNOERROR);
+
+} /* mlgf_JoinPushPagePair() */
@@ -83,6 +83,7 @@
  *  This function is used for sequential sacn.
  *  When the sequential scan is opened, the file must be locked.
  *  So, we don't need to lock the page.
+ *  The data pages are fixed with BFM_HINT_SEQUENTIAL as in OM_NextObject().
  *
  * Exports:
  *  Four OM_PrevObject(Four, DataFileInfo*, ObjectID*, ObjectID*, ObjectHdr*, LockParameter*)
@@ -215,12 +216,12 @@ Four OM_PrevObject(
         /* Read the page into the buffer page */
 
 #ifdef CCPL
-        e = BfM_getAndFixBuffer(handle, (PageID *)curOID, M_FREE, &aPage_BCBP, PAGE_BUF);
+        e = BfM_getAndFixBufferWithHint(handle, (PageID *)curOID, M_FREE, &aPage_BCBP, PAGE_BUF, BFM_HINT_SEQUENTIAL);
         if( e < 0 )  ERR(handle, e);
 #endif /* CCPL */
 
 #ifdef CCRL
-        e = BfM_getAndFixBuffer(handle, (PageID *)curOID, M_SHARED, &aPage_BCBP, PAGE_BUF);
+        e = BfM_getAndFixBufferWithHint(handle, (PageID *)curOID, M_SHARED, &aPage_BCBP, PAGE_BUF, BFM_HINT_SEQUENTIAL);
         if( e < 0 )  ERR(handle, e);
 #endif /* CCRL */
 
@@ -299,12 +300,12 @@ Four OM_PrevObject(
 
     while (pid.pageNo != NIL) {
 #ifdef CCPL
-	e = BfM_getAndFixBuffer(handle, &pid, M_FREE, &aPage_BCBP, PAGE_BUF);
+	e = BfM_getAndFixBufferWithHint(handle, &pid, M_FREE, &aPage_BCBP, PAGE_BUF, BFM_HINT_SEQUENTIAL);
 	if( e < 0 )  ERR(handle, e);
 #endif /* CCPL */
 
 #ifdef CCRL
-	e = BfM_getAndFixBuffer(handle, &pid, M_SHARED, &aPage_BCBP, PAGE_BUF);
+	e = BfM_getAndFixBufferWithHint(handle, &pid, M_SHARED, &aPage_BCBP, PAGE_BUF, BFM_HINT_SEQUENTIAL);
 	if( e < 0 )  ERR(handle, e);
 #endif /* CCRL */
 
@@ -0,0 +1,311 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: RDsM_AttachVolume.c
+ *
+ * Description:
+ *  Open the devices of a volume already mounted in the system so that
+ *  the given handle can read and write its trains. Unlike RDsM_Mount( ),
+ *  the mount count of the volume is not changed; the volume remains owned
+ *  by the threads which have mounted it.
+ *  These functions are used by the background threads of the storage
+ *  system, e.g. the page cleaners of the buffer manager.
+ *
+ * Exports:
+ *  Four RDsM_AttachVolume(Four, Four)
+ *  Four RDsM_DetachVolumes(Four)
+ */
+
+
+#include <string.h>
+#ifndef WIN32
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif /* WIN32 */
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "latch.h"
+#include "SHM.h"
+#include "RDsM.h"
+#include "Util_varArray.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*
+ * Internal Function Prototypes
+ */
+static void rdsm_CloseAttachedDevices(rdsm_UserVolTableEntry_T*, Four);
+
+
+
+/*@================================
+ * RDsM_AttachVolume()
+ *================================*/
+/*
+ * Function: Four RDsM_AttachVolume(Four, Four)
+ *
+ * Description:
+ *  Open the devices of the mounted volume 'volNo' for the given handle.
+ *  If the devices are already opened, nothing is done.
+ *
+ *  The attached entries are not protected against RDsM_Dismount( ) by the
+ *  mount count, so the entries whose volume has been dismounted or
+ *  expanded since are reopened here before they are used.
+ *
+ * Returns:
+ *  error code
+ *    eVOLNOTMOUNTED_RDSM
+ *    eDEVICEOPENFAIL_RDSM
+ *    some errors caused by function calls
+ */
+Four RDsM_AttachVolume(
+    Four                 handle,                  /* IN handle */
+    Four                 volNo)                   /* IN volume to attach */
+{
+    Four                 e;                       /* error number */
+    Four                 i;                       /* loop index */
+    Four                 entryNo;                 /* volume table entry number */
+    rdsm_VolTableEntry_T *entry;                  /* volume table entry */
+    rdsm_UserVolTableEntry_T *userEntry;          /* user volume table entry */
+    RDsM_DevInfo         *devInfo;                /* device information of the volume */
+    FileDesc             fd;                      /* opened file descriptor */
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("RDsM_AttachVolume(volNo=%ld)", volNo));
+
+
+    /*
+     * Mutex Begin : for controlling attach operation with mount operations
+     */
+    e = SHM_getLatch(handle, &RDSM_LATCH_VOLTABLE, procIndex, M_EXCLUSIVE, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERR(handle, e);
+
+    /*
+     * close the attached entries which are out of date
+     */
+    for (entryNo = 0; entryNo < MAXNUMOFVOLS; entryNo++) {
+        userEntry = &RDSM_USERVOLTABLE(handle)[entryNo];
+        entry = &RDSM_VOLTABLE[entryNo];
+
+        if (userEntry->volNo != NOVOL && userEntry->attachFlag &&
+            (userEntry->volNo != entry->volInfo.volNo || userEntry->numDevices != entry->volInfo.numDevices))
+            rdsm_CloseAttachedDevices(userEntry, userEntry->numDevices);
+    }
+
+    /*
+     * find the volume table entry of the volume
+     */
+    for (entryNo = 0, entry = &RDSM_VOLTABLE[0]; entryNo < MAXNUMOFVOLS; entryNo++, entry++)
+        if (entry->volInfo.volNo == volNo) break;
+
+    if (entryNo >= MAXNUMOFVOLS) ERRL1(handle, eVOLNOTMOUNTED_RDSM, &RDSM_LATCH_VOLTABLE);
+
+    userEntry = &RDSM_USERVOLTABLE(handle)[entryNo];
+
+    /* the devices are already opened by this handle */
+    if (userEntry->volNo == volNo) {
+        e = SHM_releaseLatch(handle, &RDSM_LATCH_VOLTABLE, procIndex);
+        if (e < eNOERROR) ERR(handle, e);
+
+        return(eNOERROR);
+    }
+
+    /* Mutex Begin :: Volume Table Entry */
+    e = SHM_getLatch(handle, &entry->latch, procIndex, M_SHARED, M_UNCONDITIONAL, NULL);
+    if (e < eNOERROR) ERRL1(handle, e, &RDSM_LATCH_VOLTABLE);
+
+    devInfo = PHYSICAL_PTR(entry->volInfo.devInfo);
+
+    /*
+     * set 'openFileDesc' of user volume table
+     */
+    for (i = 0; i < entry->volInfo.numDevices; i++) {
+
+        /* doubling openFileDesc array if needed */
+        if (i >= userEntry->openFileDesc.nEntries) {
+            e = Util_doublesizeVarArray(handle, &userEntry->openFileDesc, sizeof(FileDesc));
+            if (e < eNOERROR) break;
+        }
+
+#ifndef WIN32
+#ifndef _LARGEFILE64_SOURCE
+        if ((fd = open(devInfo[i].devName, rdsm_OpenFlags())) == -1) {
+#else
+        if ((fd = open64(devInfo[i].devName, rdsm_OpenFlags())) == -1) {
+#endif
+#else
+        if ((fd = CreateFile(devInfo[i].devName, GENERIC_WRITE | GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, NULL)) == INVALID_HANDLE_VALUE) {
+#endif /* WIN32 */
+            e = eDEVICEOPENFAIL_RDSM;
+            break;
+        }
+
+        OPENFILEDESC_ARRAY(userEntry->openFileDesc)[i] = fd;
+    }
+
+    if (e < eNOERROR) {
+        /* close the devices opened so far */
+        rdsm_CloseAttachedDevices(userEntry, i);
+    }
+    else {
+        userEntry->volNo = volNo;
+        userEntry->numDevices = entry->volInfo.numDevices;
+        userEntry->attachFlag = TRUE;
+    }
+
+    /* Mutex End :: Volume Table Entry */
+    if (e < eNOERROR) ERRL2(handle, e, &entry->latch, &RDSM_LATCH_VOLTABLE);
+
+    e = SHM_releaseLatch(handle, &entry->latch, procIndex);
+    if (e < eNOERROR) ERRL1(handle, e, &RDSM_LATCH_VOLTABLE);
+
+    /* Mutex End : for controlling attach operation with mount operations */
+    e = SHM_releaseLatch(handle, &RDSM_LATCH_VOLTABLE, procIndex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* RDsM_AttachVolume() */
+
+
+
+/*@================================
+ * RDsM_DetachVolumes()
+ *================================*/
+/*
+ * Function: Four RDsM_DetachVolumes(Four)
+ *
+ * Description:
+ *  Close the devices of all the volumes attached to the given handle by
+ *  RDsM_AttachVolume( ). The volumes mounted by the handle are not touched.
+ *
+ * Returns:
+ *  error code
+ */
+Four RDsM_DetachVolumes(
+    Four                 handle)                  /* IN handle */
+{
+    Four                 entryNo;                 /* volume table entry number */
+    rdsm_UserVolTableEntry_T *userEntry;          /* user volume table entry */
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("RDsM_DetachVolumes()"));
+
+
+    for (entryNo = 0; entryNo < MAXNUMOFVOLS; entryNo++) {
+        userEntry = &RDSM_USERVOLTABLE(handle)[entryNo];
+
+        if (userEntry->volNo != NOVOL && userEntry->attachFlag)
+            rdsm_CloseAttachedDevices(userEntry, userEntry->numDevices);
+    }
+
+    return(eNOERROR);
+
+} /* RDsM_DetachVolumes() */
+
+
+
+/*
+ * Function: void rdsm_CloseAttachedDevices(rdsm_UserVolTableEntry_T*, Four)
+ *
+ * Description:
+ *  Close the first 'numDevices' devices of the user volume table entry
+ *  and mark the entry as an empty entry.
+ *  The errors of close( ) are ignored since the devices are still opened
+ *  by the threads which have mounted the volume.
+ */
+static void rdsm_CloseAttachedDevices(
+    rdsm_UserVolTableEntry_T *userEntry,          /* INOUT user volume table entry */
+    Four                 numDevices)              /* IN # of opened devices */
+{
+    Four                 i;                       /* loop index */
+
+
+    for (i = 0; i < numDevices; i++) {
+#ifndef WIN32
+        (void) close(OPENFILEDESC_ARRAY(userEntry->openFileDesc)[i]);
+#else
+        (void) CloseHandle(OPENFILEDESC_ARRAY(userEntry->openFileDesc)[i]);
+#endif /* WIN32 */
+    }
+
+    userEntry->volNo = NOVOL;
+    userEntry->numDevices = 0;
+    userEntry->attachFlag = FALSE;
+
+} /* rdsm_CloseAttachedDevices() */
@@ -161,8 +161,12 @@ Four RDsM_Dismount(
 
     /*
      *	close the volume device
+     *  The pages written without the sync are forced out to the disk first.
      */
     for (i = 0; i < RDSM_USERVOLTABLE(handle)[entryNo].numDevices; i++) {
+        e = rdsm_SyncDevice(OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[i]);
+        if (e < eNOERROR) ERR(handle, e);
+
 #ifndef WIN32
         if (close(OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[i]) == -1) ERR(handle, eDEVICECLOSEFAIL_RDSM);
 #else
@@ -155,6 +155,10 @@ Four RDsM_finalLocalDS(
     e = rdsm_FinalReadWriteBuffer(handle, &rdsm_perThreadDSptr->rdsm_ReadWriteBuffer);
 #endif
 
+    /* finalize the I/O engine context */
+    e = rdsm_FinalIOContext(handle);
+    if (e < eNOERROR) ERR(handle, e);
+
 
     return eNOERROR;
 
@@ -189,6 +189,7 @@ Four RDsM_InitLocalDS(
 
         RDSM_USERVOLTABLE(handle)[i].volNo = NOVOL;
         RDSM_USERVOLTABLE(handle)[i].numDevices = 0;
+        RDSM_USERVOLTABLE(handle)[i].attachFlag = FALSE;
 	for (j = 0; j < INIT_SIZE_OF_DEVINFO_ARRAY; j++)
             OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[i].openFileDesc)[j] = NIL;
     }
@@ -198,6 +199,9 @@ Four RDsM_InitLocalDS(
     e = rdsm_InitReadWriteBuffer(handle, &rdsm_perThreadDSptr->rdsm_ReadWriteBuffer);
 #endif
 
+    /* the I/O engine context is allocated on the first batch of I/Os */
+    rdsm_perThreadDSptr->rdsm_ioCtx = NULL;
+
 
     return(eNOERROR);
 
@@ -249,6 +249,7 @@ Four RDsM_Mount(
 
             /* set 'volNo' of user volume table */
             RDSM_USERVOLTABLE(handle)[entryNo].volNo = volInfo->volNo;
+            RDSM_USERVOLTABLE(handle)[entryNo].attachFlag = FALSE;
 
             /* set 'numDevices' of user volume table */
             RDSM_USERVOLTABLE(handle)[entryNo].numDevices = numDevices;
@@ -258,9 +259,9 @@ Four RDsM_Mount(
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-		if ((fd[i] = open(devNames[i], O_RDWR | O_SYNC)) == -1) { 
+		if ((fd[i] = open(devNames[i], rdsm_OpenFlags())) == -1) { 
 #else
-		if ((fd[i] = open64(devNames[i], O_RDWR | O_SYNC)) == -1) { 
+		if ((fd[i] = open64(devNames[i], rdsm_OpenFlags())) == -1) { 
 #endif
 
 #else
@@ -324,9 +325,9 @@ Four RDsM_Mount(
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-	if ((fd[i] = open(devNames[i], O_RDWR | O_SYNC)) == -1) ERRL1(handle, eDEVICEOPENFAIL_RDSM, &RDSM_LATCH_VOLTABLE); 
+	if ((fd[i] = open(devNames[i], rdsm_OpenFlags())) == -1) ERRL1(handle, eDEVICEOPENFAIL_RDSM, &RDSM_LATCH_VOLTABLE); 
 #else
-	if ((fd[i] = open64(devNames[i], O_RDWR | O_SYNC)) == -1) ERRL1(handle, eDEVICEOPENFAIL_RDSM, &RDSM_LATCH_VOLTABLE); 
+	if ((fd[i] = open64(devNames[i], rdsm_OpenFlags())) == -1) ERRL1(handle, eDEVICEOPENFAIL_RDSM, &RDSM_LATCH_VOLTABLE); 
 #endif
 
 #else
@@ -452,6 +453,7 @@ Four RDsM_Mount(
      * fill the user volume table entry.
      */
     RDSM_USERVOLTABLE(handle)[entryNo].volNo = entry->volInfo.volNo;
+    RDSM_USERVOLTABLE(handle)[entryNo].attachFlag = FALSE;
     RDSM_USERVOLTABLE(handle)[entryNo].numDevices = entry->volInfo.numDevices;
     for (i = 0; i < numDevices; i++) {
 
@@ -555,9 +557,9 @@ Four rdsm_CheckDevices(
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-    if ((fd = open(devNames[0], O_RDWR | O_SYNC)) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
+    if ((fd = open(devNames[0], rdsm_OpenFlags())) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
 #else
-    if ((fd = open64(devNames[0], O_RDWR | O_SYNC)) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
+    if ((fd = open64(devNames[0], rdsm_OpenFlags())) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
 #endif
 
 #else
@@ -610,9 +612,9 @@ Four rdsm_CheckDevices(
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-	if ((fd = open(devNames[i], O_RDWR | O_SYNC)) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
+	if ((fd = open(devNames[i], rdsm_OpenFlags())) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
 #else
-	if ((fd = open64(devNames[i], O_RDWR | O_SYNC)) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
+	if ((fd = open64(devNames[i], rdsm_OpenFlags())) == -1) ERR(handle, eDEVICEOPENFAIL_RDSM); 
 #endif
 
 #else
@@ -0,0 +1,257 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: RDsM_SubmitIOs.c
+ *
+ * Description:
+ *  Carry out a batch of I/O requests through the configured I/O engine.
+ *  Unlike RDsM_WriteTrain(), the written pages are not forced out to the
+ *  disk; the caller should call RDsM_SyncVolume() when it needs them durable.
+ *
+ * Exports:
+ *  Four RDsM_SubmitIOs(Four, RDsM_IORequest_T*, Four)
+ */
+
+
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "latch.h"
+#include "RDsM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/*
+ * internal function prototypes
+ */
+static Four rdsm_LocateIORequest(Four, RDsM_IORequest_T*);
+
+
+
+/*@================================
+ * RDsM_SubmitIOs()
+ *================================*/
+/*
+ * Function: Four RDsM_SubmitIOs(Four, RDsM_IORequest_T*, Four)
+ *
+ * Description:
+ *  Carry out the given I/O requests and wait for all of them. Up to
+ *  RDSM_IO_QUEUE_DEPTH requests are in flight at a time, so the requests
+ *  should not overlap each other. After a request completes, its status is
+ *  set and its callback is called.
+ *
+ *  When the volumes are opened with O_DIRECT, a request whose buffer is not
+ *  aligned is carried out alone through the aligned read/write buffer.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER
+ *    the first error among the requests
+ */
+Four RDsM_SubmitIOs(
+    Four             handle,            /* IN    handle */
+    RDsM_IORequest_T *reqs,             /* INOUT I/O requests */
+    Four             nReqs)             /* IN    # of I/O requests */
+{
+    Four             e;                 /* error code */
+    Four             firstError;        /* the first error among the requests */
+    Four             start;             /* first request of a round */
+    Four             i, j;              /* loop index */
+    Four             nBatch;            /* # of requests in the batch */
+    RDsM_IORequest_T *batch[RDSM_IO_QUEUE_DEPTH]; /* requests submitted together */
+    RDsM_IORequest_T *req;
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("RDsM_SubmitIOs(reqs=%P, nReqs=%ld)", reqs, nReqs));
+
+    /*
+     *  Check input parameters
+     */
+    if (nReqs < 0 || (nReqs > 0 && reqs == NULL)) ERR(handle, eBADPARAMETER);
+
+    firstError = eNOERROR;
+
+    for (start = 0; start < nReqs; start = i) {
+
+        /*
+         *  Collect a batch of requests
+         */
+        for (nBatch = 0, i = start; i < nReqs && nBatch < RDSM_IO_QUEUE_DEPTH; i++) {
+            req = &reqs[i];
+
+            req->fd = NIL;
+            req->status = rdsm_LocateIORequest(handle, req);
+            if (req->status < eNOERROR) continue;
+
+            if (req->opType == RDSM_IO_WRITE)
+                RDSM_INCREMENT_WRITESEQS(req->trainId.volNo, req->trainId.pageNo, req->nPages);
+
+#ifdef READ_WRITE_BUFFER_ALIGN_FOR_LINUX
+            if (CFG_RDSMDIRECTIO && !RDSM_IS_ALIGNED_READ_WRITE_BUFFER(req->bufPtr)) {
+                /* rdsm_ReadTrain() and rdsm_WriteTrain() update the statistics */
+                if (req->opType == RDSM_IO_READ)
+                    req->status = rdsm_ReadTrain(handle, req->fd, req->pageOffset, req->bufPtr, req->nPages);
+                else
+                    req->status = rdsm_WriteTrain(handle, req->fd, req->pageOffset, req->bufPtr, req->nPages);
+                continue;
+            }
+#endif
+
+            batch[nBatch++] = req;
+        }
+
+        /*
+         *  Submit the batch
+         */
+        if (nBatch > 0) {
+            e = rdsm_SubmitIOBatch(handle, batch, nBatch);
+            if (e < eNOERROR) ERR(handle, e);
+
+            for (j = 0; j < nBatch; j++)
+                if (batch[j]->status == eNOERROR)
+                    rdsm_updateDiskStatistics(handle, batch[j]->fd, batch[j]->pageOffset, batch[j]->nPages, batch[j]->opType);
+        }
+
+        /*
+         *  Complete the requests of this round
+         */
+        for (j = start; j < i; j++) {
+            req = &reqs[j];
+
+            if (req->opType == RDSM_IO_WRITE && req->fd != NIL)
+                RDSM_INCREMENT_WRITESEQS(req->trainId.volNo, req->trainId.pageNo, req->nPages);
+
+            if (req->status < eNOERROR && firstError == eNOERROR) firstError = req->status;
+
+            if (req->callback != NULL) (*req->callback)(handle, req);
+        }
+    }
+
+    if (firstError < eNOERROR) ERR(handle, firstError);
+
+    return(eNOERROR);
+
+} /* RDsM_SubmitIOs() */
+
+
+
+/*
+ * Function: static Four rdsm_LocateIORequest(Four, RDsM_IORequest_T*)
+ *
+ * Description:
+ *  Validate the request and fill its physical location.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rdsm_LocateIORequest(
+    Four              handle,           /* IN    handle */
+    RDsM_IORequest_T  *req)             /* INOUT I/O request */
+{
+    Four              e;                /* error code */
+    Four              entryNo;          /* entry number of volume table entry */
+    Four              devNo;            /* device number in which the pages are located */
+    RDsM_VolumeInfo_T *volInfo;         /* volume information in volume table entry */
+    RDsM_DevInfo      *devInfo;         /* device information of the volume */
+
+
+    if (req->opType != RDSM_IO_READ && req->opType != RDSM_IO_WRITE) return(eBADPARAMETER);
+    if (req->bufPtr == NULL || req->nPages <= 0) return(eBADPARAMETER);
+
+    /*
+     *  get the corresponding volume table entry via searching the volTable
+     */
+    e = rdsm_GetVolTableEntryNoByVolNo(handle, req->trainId.volNo, &entryNo);
+    if (e < eNOERROR) return(e);
+
+    volInfo = &RDSM_VOLTABLE[entryNo].volInfo;
+
+    /*
+     *  validate the pages; they should be in one device
+     */
+    if (req->trainId.pageNo < 0 || req->trainId.pageNo + req->nPages > volInfo->numExts*volInfo->extSize)
+        return(eBADPAGEID);
+
+    e = rdsm_GetPhysicalInfo(handle, volInfo, req->trainId.pageNo, &devNo, &req->pageOffset);
+    if (e < eNOERROR) return(e);
+
+    devInfo = PHYSICAL_PTR(volInfo->devInfo);
+    if (req->pageOffset + req->nPages > devInfo[devNo].numExtsInDevice * volInfo->extSize)
+        return(eBADPARAMETER);
+
+    req->fd = OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[devNo];
+
+    return(eNOERROR);
+
+} /* rdsm_LocateIORequest() */
@@ -0,0 +1,240 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: RDsM_SyncVolume.c
+ *
+ * Description:
+ *  Force the written pages of volumes out to the disk. Since the volumes
+ *  are not opened with O_SYNC, the writers which need the durability, e.g.
+ *  the log manager and the checkpoint, call these functions.
+ *
+ * Exports:
+ *  Four RDsM_SyncVolume(Four, Four)
+ *  Four RDsM_SyncVolumes(Four, Four)
+ */
+
+
+#ifndef WIN32
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif /* WIN32 */
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "latch.h"
+#include "RDsM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/*
+ * internal function prototypes
+ */
+static Four rdsm_SyncVolTableEntry(Four, Four);
+
+
+
+/*@================================
+ * RDsM_SyncVolume()
+ *================================*/
+/*
+ * Function: Four RDsM_SyncVolume(Four, Four)
+ *
+ * Description:
+ *  Force the written pages of the given volume out to the disk.
+ *
+ * Returns:
+ *  error code
+ *    eVOLNOTMOUNTED_RDSM
+ *    eWRITEFAIL_RDSM
+ */
+Four RDsM_SyncVolume(
+    Four handle,                /* IN handle */
+    Four volNo)                 /* IN volume number */
+{
+    Four e;                     /* error code */
+    Four entryNo;               /* entry no of volume table entry */
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("RDsM_SyncVolume(volNo=%ld)", volNo));
+
+    e = rdsm_GetVolTableEntryNoByVolNo(handle, volNo, &entryNo);
+    if (e < eNOERROR) ERR(handle, e);
+
+    e = rdsm_SyncVolTableEntry(handle, entryNo);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* RDsM_SyncVolume() */
+
+
+
+/*@================================
+ * RDsM_SyncVolumes()
+ *================================*/
+/*
+ * Function: Four RDsM_SyncVolumes(Four, Four)
+ *
+ * Description:
+ *  Force the written pages of all the mounted volumes of the given type
+ *  (VOLUME_TYPE_DATA or VOLUME_TYPE_RAW) out to the disk. The devices of a
+ *  volume not mounted by this handle are opened only for the sync.
+ *
+ *  The volume table is not latched since we may be called while the latch
+ *  is held, e.g. for a checkpoint taken on switching the log file. A device
+ *  which cannot be opened belongs to a volume being dismounted, and the
+ *  dismount syncs the volume by itself.
+ *
+ * Returns:
+ *  error code
+ *    eWRITEFAIL_RDSM
+ */
+Four RDsM_SyncVolumes(
+    Four handle,                /* IN handle */
+    Four volType)               /* IN volume type */
+{
+    Four e;                     /* error code */
+    Four i, j;                  /* loop index */
+    FileDesc fd;                /* file descriptor opened for the sync */
+    RDsM_DevInfo *devInfo;      /* device information of the volume */
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("RDsM_SyncVolumes(volType=%ld)", volType));
+
+    for (i = 0; i < MAXNUMOFVOLS; i++) {
+        if (RDSM_VOLTABLE[i].volInfo.volNo == NOVOL || RDSM_VOLTABLE[i].volInfo.type != volType) continue;
+
+        if (RDSM_USERVOLTABLE(handle)[i].volNo == RDSM_VOLTABLE[i].volInfo.volNo) {
+            e = rdsm_SyncVolTableEntry(handle, i);
+            if (e < eNOERROR) ERR(handle, e);
+            continue;
+        }
+
+        devInfo = PHYSICAL_PTR(RDSM_VOLTABLE[i].volInfo.devInfo);
+        for (j = 0; j < RDSM_VOLTABLE[i].volInfo.numDevices; j++) {
+#ifndef WIN32
+#ifndef _LARGEFILE64_SOURCE
+            if ((fd = open(devInfo[j].devName, O_RDWR)) == -1) continue;
+#else
+            if ((fd = open64(devInfo[j].devName, O_RDWR)) == -1) continue;
+#endif
+#else
+            if ((fd = CreateFile(devInfo[j].devName, GENERIC_WRITE | GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)) == INVALID_HANDLE_VALUE) continue;
+#endif /* WIN32 */
+
+            e = rdsm_SyncDevice(fd);
+
+#ifndef WIN32
+            (void) close(fd);
+#else
+            (void) CloseHandle(fd);
+#endif /* WIN32 */
+
+            if (e < eNOERROR) ERR(handle, e);
+        }
+    }
+
+    return(eNOERROR);
+
+} /* RDsM_SyncVolumes() */
+
+
+
+/*
+ * Function: static Four rdsm_SyncVolTableEntry(Four, Four)
+ *
+ * Description:
+ *  Sync the devices of a volume through the descriptors of this handle.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rdsm_SyncVolTableEntry(
+    Four handle,                /* IN handle */
+    Four entryNo)               /* IN entry no of volume table entry */
+{
+    Four e;                     /* error code */
+    Four i;                     /* loop index */
+
+
+    for (i = 0; i < RDSM_USERVOLTABLE(handle)[entryNo].numDevices; i++) {
+        e = rdsm_SyncDevice(OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[i]);
+        if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* rdsm_SyncVolTableEntry() */
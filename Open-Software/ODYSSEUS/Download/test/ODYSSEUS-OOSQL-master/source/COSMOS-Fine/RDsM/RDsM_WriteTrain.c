@@ -96,7 +96,9 @@
  * Function: Four RDsM_WriteTrain(Four, char*, PageID*, Four)
  *
  * Description:
- *   Write a train from a main memory buffer to a disk.
+ *   Write a train from a main memory buffer to a disk. The train is forced
+ *   out to the disk before return; the writers which do not need it use
+ *   RDsM_SubmitIOs() instead.
  *
  * Returns:
  *  Error code
@@ -156,7 +158,18 @@ Four RDsM_WriteTrain(
     /*
      * Write the train into the disk.
      */
+    RDSM_INCREMENT_WRITESEQS(trainId->volNo, trainId->pageNo, sizeOfTrain);
+
     e = rdsm_WriteTrain(handle, OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[devNo], trainOffset, bufPtr, sizeOfTrain);
+
+    RDSM_INCREMENT_WRITESEQS(trainId->volNo, trainId->pageNo, sizeOfTrain);
+
+    if (e < eNOERROR) ERR(handle, e);
+
+    /*
+     * The train is durable on return; the device is not opened with O_SYNC.
+     */
+    e = rdsm_SyncDevice(OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[devNo]);
     if (e < eNOERROR) ERR(handle, e);
 
 
@@ -193,7 +193,16 @@ Four RDsM_WriteTrains(
                         numTotalWritePages : (numPagesInDevice - startTrainOffset);
 
         /* write the train into the buffer */
+        RDSM_INCREMENT_WRITESEQS(startTrainId->volNo, startPageNo, numWritePages);
+
         e = rdsm_WriteTrain(handle, OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[devNo], startTrainOffset, bufPtr, numWritePages);
+
+        RDSM_INCREMENT_WRITESEQS(startTrainId->volNo, startPageNo, numWritePages);
+
+        if (e < eNOERROR) ERR(handle, e);
+
+        /* the trains are durable on return; the device is not opened with O_SYNC */
+        e = rdsm_SyncDevice(OPENFILEDESC_ARRAY(RDSM_USERVOLTABLE(handle)[entryNo].openFileDesc)[devNo]);
         if (e < eNOERROR) ERR(handle, e);
 
         bufPtr += numWritePages*PAGESIZE;
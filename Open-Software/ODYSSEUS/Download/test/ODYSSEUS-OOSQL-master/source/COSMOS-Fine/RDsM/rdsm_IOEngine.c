@@ -0,0 +1,756 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: rdsm_IOEngine.c
+ *
+ * Description:
+ *  I/O engines which carry out a batch of I/O requests. The PSYNC engine
+ *  does pread()/pwrite() one by one. The AIO engine (Linux native AIO) and
+ *  the URING engine (io_uring) keep up to RDSM_IO_QUEUE_DEPTH I/Os in flight
+ *  and wait for all of them. Both are driven through the raw system calls,
+ *  so no user-level library is needed. An engine which cannot be set up
+ *  falls back to the next simpler one: URING, AIO, and then PSYNC.
+ *
+ *  Each handle has its own engine context; it is allocated on the first
+ *  batch and freed by RDsM_finalLocalDS().
+ *
+ * Exports:
+ *  Four rdsm_OpenFlags(void)
+ *  Four rdsm_SyncDevice(FileDesc)
+ *  Four rdsm_SubmitIOBatch(Four, RDsM_IORequest_T**, Four)
+ *  Four rdsm_FinalIOContext(Four)
+ */
+
+
+#ifdef LINUX
+#define _GNU_SOURCE             /* for O_DIRECT */
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifndef WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#else
+#include <windows.h>
+#endif /* WIN32 */
+#ifdef LINUX
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sched.h>
+#ifdef __NR_io_setup
+#define RDSM_HAVE_AIO
+#include <linux/aio_abi.h>
+#endif
+#ifdef __NR_io_uring_setup
+#define RDSM_HAVE_URING
+#include <linux/io_uring.h>
+#endif
+#endif /* LINUX */
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "latch.h"
+#include "RDsM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/* status of a request which is not completed yet; a request is completed
+   when its status is set to eNOERROR or an error code */
+#define RDSM_IO_PENDING         1
+
+
+/*
+ * per handle context of the I/O engine
+ */
+struct rdsm_IOContext_T_tag {
+    Four engine;                                        /* engine in use */
+
+#ifdef RDSM_HAVE_AIO
+    aio_context_t aioCtx;                               /* Linux native AIO context */
+    struct iocb iocbs[RDSM_IO_QUEUE_DEPTH];
+    struct iocb *iocbPtrs[RDSM_IO_QUEUE_DEPTH];
+    struct io_event events[RDSM_IO_QUEUE_DEPTH];
+#endif
+
+#ifdef RDSM_HAVE_URING
+    int ringFd;                                         /* io_uring instance */
+    void *sqRing;                                       /* mapped submission queue ring */
+    size_t sqRingSize;
+    void *cqRing;                                       /* mapped completion queue ring */
+    size_t cqRingSize;
+    struct io_uring_sqe *sqes;                          /* mapped submission queue entries */
+    size_t sqesSize;
+    unsigned *sqTail, *sqMask, *sqArray;
+    unsigned *cqHead, *cqTail, *cqMask;
+    struct io_uring_cqe *cqes;
+    struct iovec iovecs[RDSM_IO_QUEUE_DEPTH];
+#endif
+};
+
+
+/*
+ * internal function prototypes
+ */
+static Four rdsm_GetIOContext(Four, rdsm_IOContext_T**);
+static void rdsm_CompleteIO(RDsM_IORequest_T*, Four);
+static Four rdsm_PsyncBatch(RDsM_IORequest_T**, Four);
+static void rdsm_CompletePending(RDsM_IORequest_T**, Four);
+#ifdef RDSM_HAVE_AIO
+static Boolean rdsm_AioSetup(rdsm_IOContext_T*);
+static void rdsm_AioTeardown(rdsm_IOContext_T*);
+static Four rdsm_AioBatch(rdsm_IOContext_T*, RDsM_IORequest_T**, Four);
+#endif
+#ifdef RDSM_HAVE_URING
+static Boolean rdsm_UringSetup(rdsm_IOContext_T*);
+static void rdsm_UringTeardown(rdsm_IOContext_T*);
+static Four rdsm_UringBatch(rdsm_IOContext_T*, RDsM_IORequest_T**, Four);
+#endif
+
+
+
+/*@================================
+ * rdsm_OpenFlags( )
+ *================================*/
+/*
+ * Function: Four rdsm_OpenFlags(void)
+ *
+ * Description:
+ *  Return the flags used to open the device of a mounted volume.
+ *  The volumes are no longer opened with O_SYNC; the writers which need the
+ *  durability call RDsM_SyncVolume() or RDsM_SyncVolumes() instead.
+ *
+ * Returns:
+ *  flags for open()
+ */
+Four rdsm_OpenFlags(void)
+{
+#if defined(LINUX) && defined(O_DIRECT)
+    if (CFG_RDSMDIRECTIO) return (O_RDWR | O_DIRECT);
+#endif
+
+    return (O_RDWR);
+
+} /* rdsm_OpenFlags() */
+
+
+
+/*@================================
+ * rdsm_SyncDevice( )
+ *================================*/
+/*
+ * Function: Four rdsm_SyncDevice(FileDesc)
+ *
+ * Description:
+ *  Force the written data of a device out to the disk.
+ *
+ * Returns:
+ *  Error code
+ */
+Four rdsm_SyncDevice(
+    FileDesc fd)                /* IN open file descriptor for the device */
+{
+#ifndef WIN32
+#ifdef LINUX
+    if (fdatasync(fd) == -1) return (eWRITEFAIL_RDSM);
+#else
+    if (fsync(fd) == -1) return (eWRITEFAIL_RDSM);
+#endif
+#else
+    if (FlushFileBuffers(fd) == 0) return (eWRITEFAIL_RDSM);
+#endif /* WIN32 */
+
+    return (eNOERROR);
+
+} /* rdsm_SyncDevice() */
+
+
+
+/*@================================
+ * rdsm_SubmitIOBatch( )
+ *================================*/
+/*
+ * Function: Four rdsm_SubmitIOBatch(Four, RDsM_IORequest_T**, Four)
+ *
+ * Description:
+ *  Carry out the given I/O requests and wait for all of them.
+ *  The physical location of each request should be already filled.
+ *  The status of each request is set; the callbacks are not called.
+ *  No request is left in flight when this function returns.
+ *
+ * Returns:
+ *  Error code (errors of the individual requests are in their status)
+ */
+Four rdsm_SubmitIOBatch(
+    Four handle,                /* IN handle */
+    RDsM_IORequest_T **reqs,    /* INOUT I/O requests */
+    Four nReqs)                 /* IN # of I/O requests */
+{
+    Four e;                     /* error code */
+    Four i;
+    Four n;                     /* # of requests in a round */
+    rdsm_IOContext_T *ctx;      /* I/O engine context */
+
+
+    TR_PRINT(handle, TR_RDSM, TR1, ("rdsm_SubmitIOBatch(reqs=%P, nReqs=%ld)", reqs, nReqs));
+
+    e = rdsm_GetIOContext(handle, &ctx);
+    if (e < eNOERROR) ERR(handle, e);
+
+    for ( ; nReqs > 0; reqs += n, nReqs -= n) {
+        n = MIN(nReqs, RDSM_IO_QUEUE_DEPTH);
+
+        for (i = 0; i < n; i++) reqs[i]->status = RDSM_IO_PENDING;
+
+        switch (ctx->engine) {
+#ifdef RDSM_HAVE_URING
+          case RDSM_IO_ENGINE_URING:
+            e = rdsm_UringBatch(ctx, reqs, n);
+            break;
+#endif
+#ifdef RDSM_HAVE_AIO
+          case RDSM_IO_ENGINE_AIO:
+            e = rdsm_AioBatch(ctx, reqs, n);
+            break;
+#endif
+          default:
+            e = rdsm_PsyncBatch(reqs, n);
+            break;
+        }
+        if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return (eNOERROR);
+
+} /* rdsm_SubmitIOBatch() */
+
+
+
+/*@================================
+ * rdsm_FinalIOContext( )
+ *================================*/
+/*
+ * Function: Four rdsm_FinalIOContext(Four)
+ *
+ * Description:
+ *  Free the I/O engine context of the handle.
+ *
+ * Returns:
+ *  Error code
+ */
+Four rdsm_FinalIOContext(
+    Four handle)                /* IN handle */
+{
+    rdsm_IOContext_T *ctx;      /* I/O engine context */
+
+    /* pointer for RDsM Data Structure of perThreadTable */
+    RDsM_PerThreadDS_T *rdsm_perThreadDSptr = RDsM_PER_THREAD_DS_PTR(handle);
+
+
+    ctx = rdsm_perThreadDSptr->rdsm_ioCtx;
+    if (ctx == NULL) return (eNOERROR);
+
+#ifdef RDSM_HAVE_URING
+    if (ctx->engine == RDSM_IO_ENGINE_URING) rdsm_UringTeardown(ctx);
+#endif
+#ifdef RDSM_HAVE_AIO
+    if (ctx->engine == RDSM_IO_ENGINE_AIO) rdsm_AioTeardown(ctx);
+#endif
+
+    free(ctx);
+    rdsm_perThreadDSptr->rdsm_ioCtx = NULL;
+
+    return (eNOERROR);
+
+} /* rdsm_FinalIOContext() */
+
+
+
+/*
+ * Function: static Four rdsm_GetIOContext(Four, rdsm_IOContext_T**)
+ *
+ * Description:
+ *  Return the I/O engine context of the handle; set up the configured
+ *  engine on the first call.
+ */
+static Four rdsm_GetIOContext(
+    Four handle,                /* IN handle */
+    rdsm_IOContext_T **ctx)     /* OUT I/O engine context */
+{
+    /* pointer for RDsM Data Structure of perThreadTable */
+    RDsM_PerThreadDS_T *rdsm_perThreadDSptr = RDsM_PER_THREAD_DS_PTR(handle);
+
+
+    if (rdsm_perThreadDSptr->rdsm_ioCtx == NULL) {
+
+        *ctx = (rdsm_IOContext_T*)malloc(sizeof(rdsm_IOContext_T));
+        if (*ctx == NULL) ERR(handle, eMEMORYALLOCERR);
+
+        (*ctx)->engine = RDSM_IO_ENGINE_PSYNC;
+
+#ifdef RDSM_HAVE_URING
+        if (CFG_RDSMIOENGINE == RDSM_IO_ENGINE_URING && rdsm_UringSetup(*ctx))
+            (*ctx)->engine = RDSM_IO_ENGINE_URING;
+#endif
+#ifdef RDSM_HAVE_AIO
+        if (CFG_RDSMIOENGINE != RDSM_IO_ENGINE_PSYNC && (*ctx)->engine == RDSM_IO_ENGINE_PSYNC && rdsm_AioSetup(*ctx))
+            (*ctx)->engine = RDSM_IO_ENGINE_AIO;
+#endif
+
+        rdsm_perThreadDSptr->rdsm_ioCtx = *ctx;
+    }
+
+    *ctx = rdsm_perThreadDSptr->rdsm_ioCtx;
+
+    return (eNOERROR);
+
+} /* rdsm_GetIOContext() */
+
+
+
+/*
+ * Function: static void rdsm_CompleteIO(RDsM_IORequest_T*, Four)
+ *
+ * Description:
+ *  Finish a request of which 'done' bytes have been transferred; a short
+ *  transfer is completed with the positional read/write.
+ */
+static void rdsm_CompleteIO(
+    RDsM_IORequest_T *req,      /* INOUT I/O request */
+    Four done)                  /* IN # of bytes already transferred (< 0 : error) */
+{
+    Four total;                 /* # of bytes of the request */
+    devOffset_t offset;         /* offset of the next byte in the device */
+    Four n;                     /* # of bytes transferred by a call */
+#ifdef WIN32
+    DWORD nIO;
+#endif /* WIN32 */
+
+
+    total = req->nPages * PAGESIZE;
+    offset = ((devOffset_t)req->pageOffset) * PAGESIZE;
+
+    while (done >= 0 && done < total) {
+#ifndef WIN32
+#ifndef _LARGEFILE64_SOURCE
+        if (req->opType == RDSM_IO_READ)
+            n = pread(req->fd, req->bufPtr + done, total - done, offset + done);
+        else
+            n = pwrite(req->fd, req->bufPtr + done, total - done, offset + done);
+#else
+        if (req->opType == RDSM_IO_READ)
+            n = pread64(req->fd, req->bufPtr + done, total - done, offset + done);
+        else
+            n = pwrite64(req->fd, req->bufPtr + done, total - done, offset + done);
+#endif
+#else
+        if (SetFilePointer(req->fd, offset + done, NULL, FILE_BEGIN) == 0xFFFFFFFF) n = -1;
+        else if (req->opType == RDSM_IO_READ)
+            n = (ReadFile(req->fd, req->bufPtr + done, total - done, &nIO, NULL) == 0) ? -1 : nIO;
+        else
+            n = (WriteFile(req->fd, req->bufPtr + done, total - done, &nIO, NULL) == 0) ? -1 : nIO;
+#endif /* WIN32 */
+
+        if (n == -1 && errno == EINTR) continue;
+        if (n <= 0) done = -1;
+        else done += n;
+    }
+
+    if (done == total)
+        req->status = eNOERROR;
+    else
+        req->status = (req->opType == RDSM_IO_READ) ? eREADFAIL_RDSM : eWRITEFAIL_RDSM;
+
+} /* rdsm_CompleteIO() */
+
+
+
+/*
+ * Function: static Four rdsm_PsyncBatch(RDsM_IORequest_T**, Four)
+ *
+ * Description:
+ *  PSYNC engine: carry out the requests one by one.
+ *
+ * Returns:
+ *  Error code
+ */
+static Four rdsm_PsyncBatch(
+    RDsM_IORequest_T **reqs,    /* INOUT I/O requests */
+    Four nReqs)                 /* IN # of I/O requests */
+{
+    Four i;
+
+
+    for (i = 0; i < nReqs; i++)
+        rdsm_CompleteIO(reqs[i], 0);
+
+    return (eNOERROR);
+
+} /* rdsm_PsyncBatch() */
+
+
+
+/*
+ * Function: static void rdsm_CompletePending(RDsM_IORequest_T**, Four)
+ *
+ * Description:
+ *  Carry out synchronously the requests whose completions were not reaped.
+ *  Should be called only after all the I/Os of the requests have stopped,
+ *  so a request is never in flight twice. Repeating a transfer whose
+ *  completion was lost is harmless since it reads or writes the same
+ *  buffer at the same location.
+ */
+static void rdsm_CompletePending(
+    RDsM_IORequest_T **reqs,    /* INOUT I/O requests */
+    Four nReqs)                 /* IN # of I/O requests */
+{
+    Four i;
+
+
+    for (i = 0; i < nReqs; i++)
+        if (reqs[i]->status == RDSM_IO_PENDING)
+            rdsm_CompleteIO(reqs[i], 0);
+
+} /* rdsm_CompletePending() */
+
+
+
+#ifdef RDSM_HAVE_AIO
+/*
+ * Function: static Boolean rdsm_AioSetup(rdsm_IOContext_T*)
+ *
+ * Description:
+ *  Create the Linux native AIO context.
+ */
+static Boolean rdsm_AioSetup(
+    rdsm_IOContext_T *ctx)      /* INOUT I/O engine context */
+{
+    ctx->aioCtx = 0;
+    if (syscall(__NR_io_setup, RDSM_IO_QUEUE_DEPTH, &ctx->aioCtx) < 0) return (FALSE);
+
+    return (TRUE);
+
+} /* rdsm_AioSetup() */
+
+
+
+/*
+ * Function: static void rdsm_AioTeardown(rdsm_IOContext_T*)
+ *
+ * Description:
+ *  Destroy the Linux native AIO context.
+ */
+static void rdsm_AioTeardown(
+    rdsm_IOContext_T *ctx)      /* INOUT I/O engine context */
+{
+    (void) syscall(__NR_io_destroy, ctx->aioCtx);
+    ctx->engine = RDSM_IO_ENGINE_PSYNC;
+
+} /* rdsm_AioTeardown() */
+
+
+
+/*
+ * Function: static Four rdsm_AioBatch(rdsm_IOContext_T*, RDsM_IORequest_T**, Four)
+ *
+ * Description:
+ *  AIO engine: submit the requests at once and reap their completions.
+ *  Each completion identifies its request by aio_data, since the requests
+ *  complete in any order. If the submission or the reaping fails, the
+ *  engine falls back to PSYNC; io_destroy() waits for the I/Os still in
+ *  flight, and then the requests not completed are carried out
+ *  synchronously.
+ *
+ * Returns:
+ *  Error code
+ */
+static Four rdsm_AioBatch(
+    rdsm_IOContext_T *ctx,      /* INOUT I/O engine context */
+    RDsM_IORequest_T **reqs,    /* INOUT I/O requests */
+    Four nReqs)                 /* IN # of I/O requests (<= RDSM_IO_QUEUE_DEPTH) */
+{
+    Four i;
+    long n;                     /* returned value of the system calls */
+    Four nSubmitted;            /* # of requests submitted */
+    Four nCompleted;            /* # of requests completed */
+    RDsM_IORequest_T *req;
+
+
+    for (i = 0; i < nReqs; i++) {
+        memset(&ctx->iocbs[i], 0, sizeof(struct iocb));
+        ctx->iocbs[i].aio_lio_opcode = (reqs[i]->opType == RDSM_IO_READ) ? IOCB_CMD_PREAD : IOCB_CMD_PWRITE;
+        ctx->iocbs[i].aio_fildes = reqs[i]->fd;
+        ctx->iocbs[i].aio_buf = (__u64)(MEMORY_ALIGN_TYPE)reqs[i]->bufPtr;
+        ctx->iocbs[i].aio_nbytes = reqs[i]->nPages * PAGESIZE;
+        ctx->iocbs[i].aio_offset = ((devOffset_t)reqs[i]->pageOffset) * PAGESIZE;
+        ctx->iocbs[i].aio_data = (__u64)(MEMORY_ALIGN_TYPE)reqs[i];
+        ctx->iocbPtrs[i] = &ctx->iocbs[i];
+    }
+
+    for (nSubmitted = 0; nSubmitted < nReqs; ) {
+        n = syscall(__NR_io_submit, ctx->aioCtx, (long)(nReqs - nSubmitted), &ctx->iocbPtrs[nSubmitted]);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        nSubmitted += n;
+    }
+
+    for (nCompleted = 0; nCompleted < nSubmitted; ) {
+        n = syscall(__NR_io_getevents, ctx->aioCtx, 1L, (long)(nSubmitted - nCompleted), ctx->events, NULL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;      /* cannot happen with a valid context */
+
+        for (i = 0; i < n; i++) {
+            req = (RDsM_IORequest_T*)(MEMORY_ALIGN_TYPE)ctx->events[i].data;
+            rdsm_CompleteIO(req, (Four)ctx->events[i].res);
+        }
+        nCompleted += n;
+    }
+
+    if (nSubmitted < nReqs || nCompleted < nSubmitted) {
+        /* io_destroy() returns after the I/Os in flight have stopped */
+        rdsm_AioTeardown(ctx);
+        rdsm_CompletePending(reqs, nReqs);
+    }
+
+    return (eNOERROR);
+
+} /* rdsm_AioBatch() */
+#endif /* RDSM_HAVE_AIO */
+
+
+
+#ifdef RDSM_HAVE_URING
+/*
+ * Function: static Boolean rdsm_UringSetup(rdsm_IOContext_T*)
+ *
+ * Description:
+ *  Create an io_uring instance and map its rings.
+ */
+static Boolean rdsm_UringSetup(
+    rdsm_IOContext_T *ctx)      /* INOUT I/O engine context */
+{
+    struct io_uring_params p;   /* parameters of the instance */
+
+
+    memset(&p, 0, sizeof(p));
+    ctx->ringFd = syscall(__NR_io_uring_setup, RDSM_IO_QUEUE_DEPTH, &p);
+    if (ctx->ringFd < 0) return (FALSE);
+
+    ctx->sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ctx->cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ctx->sqRingSize = ctx->cqRingSize = MAX(ctx->sqRingSize, ctx->cqRingSize);
+
+    ctx->sqRing = mmap(NULL, ctx->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx->ringFd, IORING_OFF_SQ_RING);
+    if (ctx->sqRing == MAP_FAILED) {
+        close(ctx->ringFd);
+        return (FALSE);
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ctx->cqRing = ctx->sqRing;
+    else {
+        ctx->cqRing = mmap(NULL, ctx->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx->ringFd, IORING_OFF_CQ_RING);
+        if (ctx->cqRing == MAP_FAILED) {
+            munmap(ctx->sqRing, ctx->sqRingSize);
+            close(ctx->ringFd);
+            return (FALSE);
+        }
+    }
+
+    ctx->sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+    ctx->sqes = (struct io_uring_sqe*)mmap(NULL, ctx->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx->ringFd, IORING_OFF_SQES);
+    if (ctx->sqes == MAP_FAILED) {
+        if (ctx->cqRing != ctx->sqRing) munmap(ctx->cqRing, ctx->cqRingSize);
+        munmap(ctx->sqRing, ctx->sqRingSize);
+        close(ctx->ringFd);
+        return (FALSE);
+    }
+
+    ctx->sqTail = (unsigned*)((char*)ctx->sqRing + p.sq_off.tail);
+    ctx->sqMask = (unsigned*)((char*)ctx->sqRing + p.sq_off.ring_mask);
+    ctx->sqArray = (unsigned*)((char*)ctx->sqRing + p.sq_off.array);
+    ctx->cqHead = (unsigned*)((char*)ctx->cqRing + p.cq_off.head);
+    ctx->cqTail = (unsigned*)((char*)ctx->cqRing + p.cq_off.tail);
+    ctx->cqMask = (unsigned*)((char*)ctx->cqRing + p.cq_off.ring_mask);
+    ctx->cqes = (struct io_uring_cqe*)((char*)ctx->cqRing + p.cq_off.cqes);
+
+    return (TRUE);
+
+} /* rdsm_UringSetup() */
+
+
+
+/*
+ * Function: static void rdsm_UringTeardown(rdsm_IOContext_T*)
+ *
+ * Description:
+ *  Unmap the rings and close the io_uring instance.
+ */
+static void rdsm_UringTeardown(
+    rdsm_IOContext_T *ctx)      /* INOUT I/O engine context */
+{
+    munmap(ctx->sqes, ctx->sqesSize);
+    if (ctx->cqRing != ctx->sqRing) munmap(ctx->cqRing, ctx->cqRingSize);
+    munmap(ctx->sqRing, ctx->sqRingSize);
+    close(ctx->ringFd);
+    ctx->engine = RDSM_IO_ENGINE_PSYNC;
+
+} /* rdsm_UringTeardown() */
+
+
+
+/*
+ * Function: static Four rdsm_UringBatch(rdsm_IOContext_T*, RDsM_IORequest_T**, Four)
+ *
+ * Description:
+ *  URING engine: queue the requests in the submission ring, submit them
+ *  with one system call and reap their completions. Each completion
+ *  identifies its request by user_data, since the requests complete in
+ *  any order. All the submitted requests are reaped before returning;
+ *  if waiting in the kernel fails, the completion ring is polled instead.
+ *  If the submission fails, the engine falls back to PSYNC and the
+ *  requests not submitted are carried out synchronously.
+ *
+ * Returns:
+ *  Error code
+ */
+static Four rdsm_UringBatch(
+    rdsm_IOContext_T *ctx,      /* INOUT I/O engine context */
+    RDsM_IORequest_T **reqs,    /* INOUT I/O requests */
+    Four nReqs)                 /* IN # of I/O requests (<= RDSM_IO_QUEUE_DEPTH) */
+{
+    Four i;
+    long n;                     /* returned value of the system calls */
+    unsigned tail, head;        /* ring indexes */
+    unsigned idx;               /* index of a submission queue entry */
+    struct io_uring_sqe *sqe;   /* submission queue entry */
+    struct io_uring_cqe *cqe;   /* completion queue entry */
+    Four nSubmitted;            /* # of requests submitted */
+    Four nCompleted;            /* # of requests completed */
+
+
+    /* We are the only producer of the submission ring. */
+    tail = *ctx->sqTail;
+    for (i = 0; i < nReqs; i++, tail++) {
+        idx = tail & *ctx->sqMask;
+        sqe = &ctx->sqes[idx];
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+        ctx->iovecs[i].iov_base = reqs[i]->bufPtr;
+        ctx->iovecs[i].iov_len = reqs[i]->nPages * PAGESIZE;
+
+        sqe->opcode = (reqs[i]->opType == RDSM_IO_READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+        sqe->fd = reqs[i]->fd;
+        sqe->addr = (__u64)(MEMORY_ALIGN_TYPE)&ctx->iovecs[i];
+        sqe->len = 1;
+        sqe->off = ((devOffset_t)reqs[i]->pageOffset) * PAGESIZE;
+        sqe->user_data = (__u64)(MEMORY_ALIGN_TYPE)reqs[i];
+        ctx->sqArray[idx] = idx;
+    }
+    __atomic_store_n(ctx->sqTail, tail, __ATOMIC_RELEASE);
+
+    for (nSubmitted = 0; nSubmitted < nReqs; ) {
+        n = syscall(__NR_io_uring_enter, ctx->ringFd, (unsigned)(nReqs - nSubmitted), 0U, 0U, NULL, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        nSubmitted += n;
+    }
+
+    for (nCompleted = 0; nCompleted < nSubmitted; ) {
+        head = *ctx->cqHead;
+        if (head == __atomic_load_n(ctx->cqTail, __ATOMIC_ACQUIRE)) {
+            n = syscall(__NR_io_uring_enter, ctx->ringFd, 0U, 1U, IORING_ENTER_GETEVENTS, NULL, 0);
+            /* the buffers may not be released while the I/Os are in flight */
+            if (n < 0 && errno != EINTR) sched_yield();
+            continue;
+        }
+
+        cqe = &ctx->cqes[head & *ctx->cqMask];
+        rdsm_CompleteIO((RDsM_IORequest_T*)(MEMORY_ALIGN_TYPE)cqe->user_data, (Four)cqe->res);
+        __atomic_store_n(ctx->cqHead, head + 1, __ATOMIC_RELEASE);
+        nCompleted++;
+    }
+
+    if (nSubmitted < nReqs) {
+        /* the entries left in the ring are dropped together with the instance */
+        rdsm_UringTeardown(ctx);
+        rdsm_CompletePending(reqs, nReqs);
+    }
+
+    return (eNOERROR);
+
+} /* rdsm_UringBatch() */
+#endif /* RDSM_HAVE_URING */
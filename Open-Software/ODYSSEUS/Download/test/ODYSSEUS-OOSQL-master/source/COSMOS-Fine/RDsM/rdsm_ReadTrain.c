@@ -143,29 +143,24 @@ Four rdsm_ReadTrain(
 #endif
 
     /*
-     *	locate position on the given train
+     * read the train into the buffer
+     *  The positional read leaves the file offset alone, so the threads
+     *  sharing a descriptor do not race on it.
      */
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-    if (lseek(fd, ((devOffset_t)trainOffset)*PAGESIZE, SEEK_SET) == -1) /* Type Converting */
+    if (pread(fd, _bufPtr, PAGESIZE*sizeOfTrain, ((devOffset_t)trainOffset)*PAGESIZE) != PAGESIZE*sizeOfTrain) /* Type Converting */
 #else
-    if (lseek64(fd, ((devOffset_t)trainOffset)*PAGESIZE, SEEK_SET) == -1) /* Type Converting */
+    if (pread64(fd, _bufPtr, PAGESIZE*sizeOfTrain, ((devOffset_t)trainOffset)*PAGESIZE) != PAGESIZE*sizeOfTrain) /* Type Converting */
 #endif
 
 #else
     if (SetFilePointer(fd, trainOffset*PAGESIZE, NULL, FILE_BEGIN) == 0xFFFFFFFF)
-#endif /* WIN32 */
         ERR(handle, eLSEEKFAIL_RDSM);
 
-    /*
-     * read the train into the buffer
-     */
-#ifndef WIN32
-    if (read(fd, _bufPtr, PAGESIZE*sizeOfTrain) != PAGESIZE*sizeOfTrain) 
-#else
     if (ReadFile(fd, _bufPtr, PAGESIZE*sizeOfTrain, &readSize, NULL) == 0 || readSize != PAGESIZE*sizeOfTrain) 
-#endif
+#endif /* WIN32 */
         ERR(handle, eREADFAIL_RDSM);
 
     /*
@@ -179,27 +179,20 @@ Four rdsm_WriteTrain(
 #endif
 
     /*
-     *	locate position on the given train
+     *	write the BufPtr into the disk
      */
 #ifndef WIN32
 
 #ifndef _LARGEFILE64_SOURCE 
-    if (lseek(fd, ((devOffset_t)trainOffset)*PAGESIZE, SEEK_SET) == -1) /* Type Converting *//
+    if (pwrite(fd, _bufPtr, PAGESIZE*sizeOfTrain, ((devOffset_t)trainOffset)*PAGESIZE) != PAGESIZE*sizeOfTrain) /* Type Converting */
 #else
-    if (lseek64(fd, ((devOffset_t)trainOffset)*PAGESIZE, SEEK_SET) == -1) /* Type Converting */
+    if (pwrite64(fd, _bufPtr, PAGESIZE*sizeOfTrain, ((devOffset_t)trainOffset)*PAGESIZE) != PAGESIZE*sizeOfTrain) /* Type Converting */
 #endif
 
 #else
     if (SetFilePointer(fd, trainOffset*PAGESIZE, NULL, FILE_BEGIN) == 0xFFFFFFFF)
-#endif /* WIN32 */
         ERR(handle, eLSEEKFAIL_RDSM);
 
-    /*
-     *	write the BufPtr into the disk
-     */
-#ifndef WIN32
-    if ( write(fd, _bufPtr, PAGESIZE*sizeOfTrain) != PAGESIZE*sizeOfTrain ) 
-#else
     if (WriteFile(fd, _bufPtr, PAGESIZE*sizeOfTrain, &writeSize, NULL) == 0 || writeSize != PAGESIZE*sizeOfTrain) 
 #endif /* WIN32 */
 	ERR(handle, eWRITEFAIL_RDSM);
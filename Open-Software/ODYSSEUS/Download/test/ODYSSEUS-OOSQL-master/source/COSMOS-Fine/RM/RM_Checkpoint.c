@@ -110,6 +110,7 @@ Four RM_Checkpoint(
 {
     Four 		e;			/* error code */
     Lsn_T 		chkptLsn;             	/* lsn for the begin checkpoint log record */
+    Lsn_T 		redoLsn;             	/* redo point of this checkpoint */
     Lsn_T 		lsn;                  	/* LSN of the newly written log record */
     Four 		logRecLen;             	/* log record length */
     LOG_LogRecInfo_T 	logRecInfo; 		/* log record information */
@@ -173,8 +174,10 @@ Four RM_Checkpoint(
 
     /*
      * Write the log record containing the list of dirty pages
+     * The redo pass begins with the oldest of them.
      */
-    e = BfM_LogDirtyPageTableEntries(handle);
+    redoLsn = chkptLsn;
+    e = BfM_LogDirtyPageTableEntries(handle, &redoLsn);
     if (e < eNOERROR) ERR(handle, e);
 
 
@@ -210,11 +213,20 @@ Four RM_Checkpoint(
     if (e < eNOERROR) ERR(handle, e);
 
 
+    /*
+     * The pages written before the dirty page table was logged are not redone
+     * from this checkpoint; force them out to the disk before the checkpoint
+     * becomes valid since the data volumes are written without the sync.
+     */
+    e = RDsM_SyncVolumes(handle, VOLUME_TYPE_DATA);
+    if (e < eNOERROR) ERR(handle, e);
+
+
     /*
      * set the lsn of the new valid checkpoint log record and
      * write the checkpoint lsn into the disk
      */
-    e = LOG_SetCheckpointLsn(handle, &chkptLsn);
+    e = LOG_SetCheckpointLsn(handle, &chkptLsn, &redoLsn);
     if (e < eNOERROR) ERR(handle, e);
 
     return(eNOERROR);
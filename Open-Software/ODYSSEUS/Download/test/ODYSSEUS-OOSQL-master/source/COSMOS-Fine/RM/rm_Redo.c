@@ -75,6 +75,13 @@
  *
  * Description:
  *  start the redo pass for restart recovery
+ *  The pages in the dirty page table are loaded into the buffer pool in bulk
+ *  before the log is scanned. If CFG_RMNUMREDOWORKERS > 0, the page updates
+ *  are redone by the redo workers: the log records are distributed to the
+ *  workers by the hash of their page ids, so the updates of a page are redone
+ *  by one worker in the order of their lsns. The updates of the RDsM pages
+ *  go to the first worker since they also modify the shared volume table.
+ *  The other log records are processed by the scanning thread.
  *
  * Exports:
  *  Four rm_Redo(Four, Lsn_T*, RM_DirtyPageTable_T*)
@@ -82,21 +89,78 @@
 
 
 #include <assert.h>
+#include <stdlib.h>  /* for malloc, qsort */
+#include <string.h>  /* for memcpy */
 #include "common.h"
 #include "error.h"
 #include "trace.h"
 #include "Util.h"
 #include "dirtyPageTable.h"
+#include "SHM.h"
+#include "RDsM.h"
 #include "TM.h"
 #include "BfM.h"
 #include "SM.h"
 #include "LOG.h"
 #include "RM.h"
 #include "LM.h"
+#include "THM_cosmosThread.h"
 #include "perProcessDS.h"
 #include "perThreadDS.h"
 
 
+/*
+ * a log record queued for a redo worker
+ * Its images are stored right after the structure.
+ */
+typedef struct rm_RedoRecord_T_tag {
+    struct rm_RedoRecord_T_tag	*next;		/* next record in the queue */
+    Lsn_T 			lsn;		/* lsn of the log record */
+    Four 			logRecLen;	/* log record length */
+    LOG_LogRecInfo_T 		logRecInfo;	/* log record information */
+} rm_RedoRecord_T;
+
+/*
+ * a redo worker
+ */
+typedef struct rm_RedoWorker_T_tag {
+    Four 			handle;		/* handle of the worker */
+    cosmos_thread_t 		tid;		/* thread id of the worker */
+    cosmos_thread_mutex_t 	mutex;		/* protects the fields below */
+    cosmos_thread_cond_t 	notEmpty;	/* signaled when a record is queued or at the end */
+    cosmos_thread_cond_t 	notFull;	/* signaled when a record is dequeued or at an error */
+    rm_RedoRecord_T 		*head;		/* the oldest record in the queue */
+    rm_RedoRecord_T 		*tail;		/* the newest record in the queue */
+    Four 			nQueued;	/* # of records in the queue */
+    Boolean 			endFlag;	/* TRUE if no more record will be queued */
+    Four 			error;		/* the first error of the worker */
+} rm_RedoWorker_T;
+
+/* redo worker of a page; the pages of a train type are aligned, so the high bits of the hash are used */
+#define RM_REDO_WORKER_NO(pid, n) \
+    ((Four)((((UFour_Invariable)(pid)->pageNo * 0x9E3779B1U + (UFour_Invariable)(pid)->volNo) >> 16) % (n)))
+
+/* TRUE if the log record updates an RDsM page */
+#define RM_IS_RDSM_ACTION(action) \
+    ((action) >= LOG_ACTION_RDSM_ALLOC_TRAINS && (action) <= LOG_ACTION_RDSM_MODIFY_FREE_EXTENT_LIST_HEADER)
+
+
+static rm_RedoWorker_T		rm_redoWorkers[RM_MAX_REDO_WORKERS];
+static Four 			rm_nRedoWorkers = 0;	/* # of running redo workers */
+static DirtyPageTable_T		*rm_redoDpt = NULL;	/* dirty page table of the redo pass; NULL if no worker is started */
+static cosmos_thread_mutex_t	rm_redoDptMutex;	/* protects 'rm_redoDpt' while the workers run */
+
+
+static Four rm_RedoLogRecords(Four, Lsn_T*, DirtyPageTable_T*);
+static Four rm_RedoPage(Four, DirtyPageTable_T*, Lsn_T*, Four, LOG_LogRecInfo_T*);
+static Four rm_PrefetchDirtyPages(Four, DirtyPageTable_T*);
+static int rm_ComparePageIDs(const void*, const void*);
+static Four rm_StartRedoWorkers(Four, DirtyPageTable_T*);
+static Four rm_StopRedoWorkers(Four);
+static Four rm_QueueRedoRecord(Four, Lsn_T*, Four, LOG_LogRecInfo_T*);
+static void *rm_redoWorkerMain(void*);
+
+
 
 /*
  * Function: Four rm_Redo(Four, Lsn_T*, DirtyPageTable_T*)
@@ -111,21 +175,80 @@ Four rm_Redo(
     Four 		handle,
     Lsn_T 		*redoLsn,		/* IN starting point of the redo pass */
     DirtyPageTable_T 	*dpt)			/* IN dirty page table */
+{
+    Four 		e;                     	/* returned error code */
+    Four 		e2;                    	/* returned error code */
+
+
+    TR_PRINT(handle, TR_RM, TR1, ("rm_Redo(redoLsn=%P, dpt=%P)", redoLsn, dpt));
+
+
+    /*
+     * load the dirty pages in bulk instead of one by one during the scan
+     */
+    e = rm_PrefetchDirtyPages(handle, dpt);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    if (CFG_RMNUMREDOWORKERS > 0) {
+	e = rm_StartRedoWorkers(handle, dpt);
+	if (e < eNOERROR) {
+	    (void) rm_StopRedoWorkers(handle);
+	    ERR(handle, e);
+	}
+    }
+
+
+    /*
+     * scan the log and redo the updates; all the page updates should be
+     * redone before the pending actions below free pages
+     */
+    e = rm_RedoLogRecords(handle, redoLsn, dpt);
+
+    e2 = rm_StopRedoWorkers(handle);
+    if (e < eNOERROR) ERR(handle, e);
+    if (e2 < eNOERROR) ERR(handle, e2);
+
+
+    /*
+     * If a failure were to occur after the logging of the end record of a
+     * transaction, but before the execution of all the pending actions of
+     * that transaction, the remaining pending actions are redone during
+     * this pass.
+     */
+    e = TM_XT_DoPendingActionsOfCommittedTransactions(handle);
+    if (e < eNOERROR) ERR(handle, e);
+
+    return(eNOERROR);
+
+} /* rm_Redo( ) */
+
+
+
+/*
+ * Function: Four rm_RedoLogRecords(Four, Lsn_T*, DirtyPageTable_T*)
+ *
+ * Description:
+ *  Scan the log from the redo point and redo the log records. The page
+ *  updates are queued for the redo workers if they are running.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rm_RedoLogRecords(
+    Four 		handle,
+    Lsn_T 		*redoLsn,		/* IN starting point of the redo pass */
+    DirtyPageTable_T 	*dpt)			/* IN dirty page table */
 {
     Four 		e;                     	/* returned error code */
     Lsn_T 		lsn;                  	/* lsn of the current log record */
     Lsn_T 		recLsn;			/* recovery lsn of the dirty page */
-    Lsn_T 		tmpLsn;			/* temporary variable */
+    Boolean 		found;			/* TRUE if the page is in the dirty page table */
     Four 		logRecLen;             	/* log record length */
-    Buffer_ACC_CB 	*aPage_BCBP;		/* buffer access control block */
-    PageHdr_T 		*pageHdr;         	/* a page header */
     XactTableEntry_T 	*xactEntryPtr; 		/* ptr to an entry in transaction table */
     LOG_LogRecInfo_T 	logRecInfo; 		/* log record information */
     Four 		i;                     /* loop index */
     Four 		type;                  /* page type */
-    DeallocListElem 	*dlHead;
-    DeallocListElem 	*dlElem;
-    DeallocListElem 	*lastElem;
     Four 		size;			/* size of log image data */
     PageID 		*pids;			/* page identifications */
     SegmentID_T 	*segmentID;     	/* segment identifications */
@@ -137,8 +260,6 @@ Four rm_Redo(
     /* pointer for COMMON Data Structure of perThreadTable */
     COMMON_PerThreadDS_T *common_perThreadDSptr = COMMON_PER_THREAD_DS_PTR(handle);
 
-    TR_PRINT(handle, TR_RM, TR1, ("rm_Redo(redoLsn=%P, dpt=%P)", redoLsn, dpt));
-
 
     /*
      *  allocate enough memory for log record images
@@ -175,51 +296,30 @@ Four rm_Redo(
 	     * might not have made it to disk before sys failure. need to
 	     * access page and check its LSN.
 	     */
-	    if ((logRecInfo.redoUndo == LOG_REDO_ONLY || logRecInfo.redoUndo == LOG_REDO_UNDO) &&
-		RM_DPT_GetEntry(handle, dpt, &logRecInfo.pid, log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType, &recLsn) && LSN_CMP_GE(lsn, recLsn)) { 
-
-                assert(!IS_NILPAGEID(logRecInfo.pid)); 
-
-		/* fix the page */
-		/*
-		 * We don't have to latch the page because the restart redo is
-		 * done by only one process.
-		 */
-		e = BfM_getAndFixBuffer(handle, &(logRecInfo.pid), M_FREE, &aPage_BCBP,
-                                        log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType);
-		if (e < eNOERROR) ERR(handle, e);
-
-		pageHdr = (PageHdr_T*)aPage_BCBP->bufPagePtr;
-
-		/* if the update is not present, then redo it. */
-		if (LSN_CMP_LT(pageHdr->lsn, lsn)) {
-		    /* redo update */
-		    e = (*(log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].redoFnPtr))(handle, aPage_BCBP->bufPagePtr, &logRecInfo);
-		    if (e < eNOERROR) ERRB1(handle, e, aPage_BCBP, log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType);
-
-		    /* Set the page lsn. */
-                    pageHdr->lsn = lsn;
-                    pageHdr->logRecLen = logRecLen;
-
-		    /* Set the dirty flag. */
-		    aPage_BCBP->dirtyFlag = 1;
-
-		} else { /* update already on page */
-		    /* update dirty page list with correct info. */
-		    /*
-		     * this will happen if this page was written to disk after
-		     * the checkpt but before sys failure
-		     */
-		    tmpLsn = pageHdr->lsn;
-		    LOG_INCREASE_LSN(tmpLsn, 1);
-
-		    e = RM_DPT_InsertEntry(handle, dpt, &(logRecInfo.pid), log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType, &tmpLsn); 
-		    if (e < eNOERROR) ERRB1(handle, e, aPage_BCBP, PAGE_BUF);
+	    if (logRecInfo.redoUndo == LOG_REDO_ONLY || logRecInfo.redoUndo == LOG_REDO_UNDO) {
+
+		if (rm_nRedoWorkers > 0) {
+		    e = cosmos_thread_mutex_lock(&rm_redoDptMutex);
+		    if (e < eNOERROR) ERR(handle, e);
+		}
+
+		found = RM_DPT_GetEntry(handle, dpt, &logRecInfo.pid, log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType, &recLsn);
+
+		if (rm_nRedoWorkers > 0) {
+		    e = cosmos_thread_mutex_unlock(&rm_redoDptMutex);
+		    if (e < eNOERROR) ERR(handle, e);
 		}
 
-		/* unfix the page */
-		e = BfM_unfixBuffer(handle, aPage_BCBP, log_perThreadDSptr->LOG_logRecTbl[logRecInfo.action].bufType);
-		if (e < eNOERROR) ERR(handle, e);
+		if (found && LSN_CMP_GE(lsn, recLsn)) {
+
+		    assert(!IS_NILPAGEID(logRecInfo.pid));
+
+		    if (rm_nRedoWorkers > 0)
+			e = rm_QueueRedoRecord(handle, &lsn, logRecLen, &logRecInfo);
+		    else
+			e = rm_RedoPage(handle, dpt, &lsn, logRecLen, &logRecInfo);
+		    if (e < eNOERROR) ERR(handle, e);
+		}
 	    }
 
             /*
@@ -273,7 +373,7 @@ Four rm_Redo(
 		    ERR(handle, eINTERNAL);
 		}
 
-                for (i = 0; i < logRecInfo.imageSize[1]/size; i++) { 
+                for (i = 0; i < logRecInfo.imageSize[1]/size; i++) {
 		    switch (type) {
 		        case DL_PAGE:
                             e = TM_XT_AddToDeallocPageList(handle, xactEntryPtr, &pids[i]);
@@ -283,7 +383,7 @@ Four rm_Redo(
                             e = TM_XT_AddToDeallocTrainList(handle, xactEntryPtr, &pids[i]);
                             if (e < eNOERROR) ERR(handle, e);
 			    break;
-		        case DL_PAGE_SEGMENT: 
+		        case DL_PAGE_SEGMENT:
                             e = TM_XT_AddToDeallocPageSegmentList(handle, xactEntryPtr, &segmentID[i]);
                             if (e < eNOERROR) ERR(handle, e);
 			    break;
@@ -334,16 +434,460 @@ Four rm_Redo(
     e = LOG_CloseScan(handle);
     if (e < eNOERROR) ERR(handle, e);
 
+    return(eNOERROR);
+
+} /* rm_RedoLogRecords( ) */
+
+
+
+/*
+ * Function: Four rm_RedoPage(Four, DirtyPageTable_T*, Lsn_T*, Four, LOG_LogRecInfo_T*)
+ *
+ * Description:
+ *  Redo a page update if it is not present on the page.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rm_RedoPage(
+    Four 		handle,
+    DirtyPageTable_T 	*dpt,			/* INOUT dirty page table */
+    Lsn_T 		*lsn,			/* IN lsn of the log record */
+    Four 		logRecLen,		/* IN log record length */
+    LOG_LogRecInfo_T 	*logRecInfo)		/* IN log record information */
+{
+    Four 		e;                     	/* returned error code */
+    Four 		bufType;		/* buffer type of the page */
+    Lsn_T 		tmpLsn;			/* temporary variable */
+    Buffer_ACC_CB 	*aPage_BCBP;		/* buffer access control block */
+    PageHdr_T 		*pageHdr;         	/* a page header */
+
+    /* pointer for LOG Data Structure of perThreadTable */
+    LOG_PerThreadDS_T *log_perThreadDSptr = LOG_PER_THREAD_DS_PTR(handle);
+
+
+    bufType = log_perThreadDSptr->LOG_logRecTbl[logRecInfo->action].bufType;
 
+    /* fix the page */
     /*
-     * If a failure were to occur after the logging of the end record of a
-     * transaction, but before the execution of all the pending actions of
-     * that transaction, the remaining pending actions are redone during
-     * this pass.
+     * We don't have to latch the page because the restart redo is
+     * done by only one process, and the updates of a page are redone
+     * by only one thread.
      */
-    e = TM_XT_DoPendingActionsOfCommittedTransactions(handle);
+    e = BfM_getAndFixBuffer(handle, &(logRecInfo->pid), M_FREE, &aPage_BCBP, bufType);
+    if (e < eNOERROR) ERR(handle, e);
+
+    pageHdr = (PageHdr_T*)aPage_BCBP->bufPagePtr;
+
+    /* if the update is not present, then redo it. */
+    if (LSN_CMP_LT(pageHdr->lsn, *lsn)) {
+	/* redo update */
+	e = (*(log_perThreadDSptr->LOG_logRecTbl[logRecInfo->action].redoFnPtr))(handle, aPage_BCBP->bufPagePtr, logRecInfo);
+	if (e < eNOERROR) ERRB1(handle, e, aPage_BCBP, bufType);
+
+	/* Set the page lsn. */
+	pageHdr->lsn = *lsn;
+	pageHdr->logRecLen = logRecLen;
+
+	/* Set the dirty flag. */
+	aPage_BCBP->dirtyFlag = 1;
+
+    } else { /* update already on page */
+	/* update dirty page list with correct info. */
+	/*
+	 * this will happen if this page was written to disk after
+	 * the checkpt but before sys failure
+	 */
+	tmpLsn = pageHdr->lsn;
+	LOG_INCREASE_LSN(tmpLsn, 1);
+
+	if (rm_nRedoWorkers > 0) {
+	    e = cosmos_thread_mutex_lock(&rm_redoDptMutex);
+	    if (e < eNOERROR) ERRB1(handle, e, aPage_BCBP, bufType);
+	}
+
+	e = RM_DPT_InsertEntry(handle, dpt, &(logRecInfo->pid), bufType, &tmpLsn);
+
+	if (rm_nRedoWorkers > 0)
+	    (void) cosmos_thread_mutex_unlock(&rm_redoDptMutex);
+
+	if (e < eNOERROR) ERRB1(handle, e, aPage_BCBP, bufType);
+    }
+
+    /* unfix the page */
+    e = BfM_unfixBuffer(handle, aPage_BCBP, bufType);
     if (e < eNOERROR) ERR(handle, e);
 
     return(eNOERROR);
 
-} /* rm_Redo( ) */
+} /* rm_RedoPage( ) */
+
+
+
+/*
+ * Function: Four rm_PrefetchDirtyPages(Four, DirtyPageTable_T*)
+ *
+ * Description:
+ *  Load the pages in the dirty page table into the buffer pool in the
+ *  order of their page ids, so that the consecutive ones are read together.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rm_PrefetchDirtyPages(
+    Four 			handle,
+    DirtyPageTable_T 		*dpt)			/* IN dirty page table */
+{
+    Four 			e;			/* returned error code */
+    Four 			i;			/* loop index */
+    Four 			type;			/* buffer type */
+    Four 			nPages;			/* # of dirty pages of the type */
+    PageID 			*pids;			/* dirty pages of the type */
+    DirtyPageTableEntry_T 	*entryPtr;		/* points to an entry in dirty page table */
+
+
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+
+	nPages = 0;
+	for (i = 0; i <= dpt->hashTableSize_1; i++)
+	    for (entryPtr = dpt->hashTable[type][i]; entryPtr != NULL; entryPtr = entryPtr->nextEntry)
+		nPages++;
+
+	if (nPages == 0) continue;
+
+	pids = (PageID*)malloc(sizeof(PageID) * nPages);
+	if (pids == NULL) ERR(handle, eMEMORYALLOCERR);
+
+	nPages = 0;
+	for (i = 0; i <= dpt->hashTableSize_1; i++)
+	    for (entryPtr = dpt->hashTable[type][i]; entryPtr != NULL; entryPtr = entryPtr->nextEntry)
+		pids[nPages++] = entryPtr->pid;
+
+	qsort(pids, nPages, sizeof(PageID), rm_ComparePageIDs);
+
+	e = BfM_PrefetchTrains(handle, pids, nPages, type);
+	free(pids);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* rm_PrefetchDirtyPages( ) */
+
+
+
+/*
+ * Function: int rm_ComparePageIDs(const void*, const void*)
+ *
+ * Description:
+ *  qsort() comparison of two page ids by the volume and page numbers.
+ */
+static int rm_ComparePageIDs(
+    const void 		*p1,
+    const void 		*p2)
+{
+    const PageID 	*pid1 = (const PageID*)p1;
+    const PageID 	*pid2 = (const PageID*)p2;
+
+
+    if (pid1->volNo != pid2->volNo) return((pid1->volNo < pid2->volNo) ? -1 : 1);
+    if (pid1->pageNo != pid2->pageNo) return((pid1->pageNo < pid2->pageNo) ? -1 : 1);
+
+    return(0);
+
+} /* rm_ComparePageIDs( ) */
+
+
+
+/*
+ * Function: Four rm_StartRedoWorkers(Four, DirtyPageTable_T*)
+ *
+ * Description:
+ *  Start CFG_RMNUMREDOWORKERS redo workers. Each worker runs on its own
+ *  handle which is allocated here.
+ *
+ * Returns:
+ *  error code
+ */
+static Four rm_StartRedoWorkers(
+    Four 		handle,
+    DirtyPageTable_T 	*dpt)			/* IN dirty page table */
+{
+    Four 		e;			/* returned error code */
+    rm_RedoWorker_T 	*worker;		/* a new worker */
+
+
+    e = cosmos_thread_mutex_create(&rm_redoDptMutex, 0);
+    if (e < eNOERROR) ERR(handle, e);
+
+    rm_redoDpt = dpt;
+
+    /*
+     * The restart is done by THM_AllocHandle() before the restarting thread
+     * is counted. Count it during the redo pass so that THM_AllocHandle()
+     * does not restart again for the workers.
+     */
+    NUM_OF_THREADS_IN_SYSTEM++;
+    NUM_OF_THREADS_IN_PROCESS++;
+
+    while (rm_nRedoWorkers < CFG_RMNUMREDOWORKERS && rm_nRedoWorkers < RM_MAX_REDO_WORKERS) {
+
+	worker = &rm_redoWorkers[rm_nRedoWorkers];
+	worker->head = worker->tail = NULL;
+	worker->nQueued = 0;
+	worker->endFlag = FALSE;
+	worker->error = eNOERROR;
+
+	e = cosmos_thread_mutex_create(&worker->mutex, 0);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = cosmos_thread_cond_create(&worker->notEmpty, 0);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = cosmos_thread_cond_create(&worker->notFull, 0);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = THM_AllocHandle(&worker->handle);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = cosmos_thread_create(&worker->tid, rm_redoWorkerMain, (void*)worker, 0);
+	if (e < eNOERROR) {
+	    (void) THM_FreeHandle(worker->handle);
+	    ERR(handle, e);
+	}
+
+	rm_nRedoWorkers++;
+    }
+
+    return(eNOERROR);
+
+} /* rm_StartRedoWorkers( ) */
+
+
+
+/*
+ * Function: Four rm_StopRedoWorkers(Four)
+ *
+ * Description:
+ *  Wait until the redo workers redo all the queued log records, and free
+ *  their handles.
+ *
+ * Returns:
+ *  error code
+ *    the first error of the workers
+ */
+static Four rm_StopRedoWorkers(
+    Four 		handle)
+{
+    Four 		e;			/* returned error code */
+    Four 		i;			/* loop index */
+    Four 		workerError;		/* the first error of the workers */
+    rm_RedoWorker_T 	*worker;		/* a worker */
+
+
+    if (rm_redoDpt == NULL) return(eNOERROR);
+
+    for (i = 0; i < rm_nRedoWorkers; i++) {
+	worker = &rm_redoWorkers[i];
+
+	e = cosmos_thread_mutex_lock(&worker->mutex);
+	if (e < eNOERROR) ERR(handle, e);
+
+	worker->endFlag = TRUE;
+	(void) cosmos_thread_cond_signal(&worker->notEmpty);
+
+	e = cosmos_thread_mutex_unlock(&worker->mutex);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    workerError = eNOERROR;
+    for (i = 0; i < rm_nRedoWorkers; i++) {
+	worker = &rm_redoWorkers[i];
+
+	e = cosmos_thread_wait(worker->tid);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (workerError == eNOERROR) workerError = worker->error;
+
+	e = RDsM_DetachVolumes(worker->handle);
+	if (e < eNOERROR) ERR(handle, e);
+
+	e = THM_FreeHandle(worker->handle);
+	if (e < eNOERROR) ERR(handle, e);
+
+	(void) cosmos_thread_cond_destroy(&worker->notEmpty);
+	(void) cosmos_thread_cond_destroy(&worker->notFull);
+	(void) cosmos_thread_mutex_destroy(&worker->mutex);
+    }
+
+    rm_nRedoWorkers = 0;
+    rm_redoDpt = NULL;
+
+    NUM_OF_THREADS_IN_SYSTEM--;
+    NUM_OF_THREADS_IN_PROCESS--;
+
+    e = cosmos_thread_mutex_destroy(&rm_redoDptMutex);
+    if (e < eNOERROR) ERR(handle, e);
+
+    if (workerError < eNOERROR) ERR(handle, workerError);
+
+    return(eNOERROR);
+
+} /* rm_StopRedoWorkers( ) */
+
+
+
+/*
+ * Function: Four rm_QueueRedoRecord(Four, Lsn_T*, Four, LOG_LogRecInfo_T*)
+ *
+ * Description:
+ *  Queue a copy of the log record for the redo worker of its page.
+ *  Wait while the queue of the worker is full.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR
+ *    the first error of the worker
+ */
+static Four rm_QueueRedoRecord(
+    Four 		handle,
+    Lsn_T 		*lsn,			/* IN lsn of the log record */
+    Four 		logRecLen,		/* IN log record length */
+    LOG_LogRecInfo_T 	*logRecInfo)		/* IN log record information */
+{
+    Four 		e;			/* returned error code */
+    Four 		i;			/* loop index */
+    Four 		size;			/* size of the queued record */
+    char 		*ptr;			/* where the next image is copied */
+    rm_RedoRecord_T 	*record;		/* the queued record */
+    rm_RedoWorker_T 	*worker;		/* worker of the page */
+
+
+    /*@ copy the log record with its images */
+    size = ALIGNED_LENGTH(sizeof(rm_RedoRecord_T));
+    for (i = 0; i < logRecInfo->nImages; i++)
+	size += ALIGNED_LENGTH(logRecInfo->imageSize[i]);
+
+    record = (rm_RedoRecord_T*)malloc(size);
+    if (record == NULL) ERR(handle, eMEMORYALLOCERR);
+
+    record->next = NULL;
+    record->lsn = *lsn;
+    record->logRecLen = logRecLen;
+    record->logRecInfo = *logRecInfo;
+
+    ptr = (char*)record + ALIGNED_LENGTH(sizeof(rm_RedoRecord_T));
+    for (i = 0; i < LOG_MAX_NUM_IMAGES; i++) {
+	if (i < logRecInfo->nImages) {
+	    memcpy(ptr, logRecInfo->imageData[i], logRecInfo->imageSize[i]);
+	    record->logRecInfo.imageData[i] = ptr;
+	    ptr += ALIGNED_LENGTH(logRecInfo->imageSize[i]);
+	}
+	else
+	    record->logRecInfo.imageData[i] = NULL;
+    }
+
+    /*@ queue the record */
+    if (RM_IS_RDSM_ACTION(logRecInfo->action))
+	worker = &rm_redoWorkers[0];
+    else
+	worker = &rm_redoWorkers[RM_REDO_WORKER_NO(&logRecInfo->pid, rm_nRedoWorkers)];
+
+    e = cosmos_thread_mutex_lock(&worker->mutex);
+    if (e < eNOERROR) {
+	free(record);
+	ERR(handle, e);
+    }
+
+    while (worker->nQueued >= RM_REDO_QUEUE_SIZE && worker->error == eNOERROR)
+	(void) cosmos_thread_cond_wait(&worker->notFull, &worker->mutex);
+
+    e = worker->error;
+    if (e == eNOERROR) {
+	if (worker->tail == NULL)
+	    worker->head = record;
+	else
+	    worker->tail->next = record;
+	worker->tail = record;
+	worker->nQueued++;
+
+	(void) cosmos_thread_cond_signal(&worker->notEmpty);
+    }
+
+    (void) cosmos_thread_mutex_unlock(&worker->mutex);
+
+    if (e < eNOERROR) {
+	free(record);
+	ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+} /* rm_QueueRedoRecord( ) */
+
+
+
+/*
+ * Function: void *rm_redoWorkerMain(void*)
+ *
+ * Description:
+ *  Start routine of a redo worker.
+ *  It redoes the queued log records in order until rm_StopRedoWorkers() is
+ *  called. After an error, the records are dropped and the error is
+ *  reported by rm_StopRedoWorkers().
+ */
+static void *rm_redoWorkerMain(
+    void 		*arg)			/* IN the worker */
+{
+    Four 		e;			/* returned error code */
+    rm_RedoWorker_T 	*worker = (rm_RedoWorker_T*)arg;
+    Four 		handle = worker->handle;
+    VolNo 		volNo = NIL;		/* the volume attached last */
+    rm_RedoRecord_T 	*record;		/* record being redone */
+
+
+    for (;;) {
+
+	if (cosmos_thread_mutex_lock(&worker->mutex) < eNOERROR) break;
+
+	while (worker->head == NULL && !worker->endFlag)
+	    (void) cosmos_thread_cond_wait(&worker->notEmpty, &worker->mutex);
+
+	record = worker->head;
+	if (record != NULL) {
+	    worker->head = record->next;
+	    if (worker->head == NULL) worker->tail = NULL;
+	    worker->nQueued--;
+
+	    (void) cosmos_thread_cond_signal(&worker->notFull);
+	}
+
+	e = worker->error;
+
+	(void) cosmos_thread_mutex_unlock(&worker->mutex);
+
+	if (record == NULL) break;	/* no more records */
+
+	if (e == eNOERROR && record->logRecInfo.pid.volNo != volNo) {
+	    e = RDsM_AttachVolume(handle, record->logRecInfo.pid.volNo);
+	    if (e >= eNOERROR) volNo = record->logRecInfo.pid.volNo;
+	}
+
+	if (e == eNOERROR)
+	    e = rm_RedoPage(handle, rm_redoDpt, &record->lsn, record->logRecLen, &record->logRecInfo);
+
+	free(record);
+
+	if (e < eNOERROR && worker->error == eNOERROR) {
+	    if (cosmos_thread_mutex_lock(&worker->mutex) < eNOERROR) break;
+
+	    worker->error = e;
+	    (void) cosmos_thread_cond_signal(&worker->notFull);
+
+	    (void) cosmos_thread_mutex_unlock(&worker->mutex);
+	}
+    }
+
+    return(NULL);
+
+} /* rm_redoWorkerMain( ) */
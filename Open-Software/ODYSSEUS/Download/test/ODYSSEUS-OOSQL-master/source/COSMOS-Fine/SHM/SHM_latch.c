@@ -75,6 +75,9 @@
  *
  * Description:
  *  support Mutual Exclusion for a critical section
+ *  With USEFUTEX on Linux, a latch is an atomic word with futex parking;
+ *  otherwise the latch state is protected by a mutex (or testandset) and
+ *  the waiting threads are queued in the latch.
  *
  * Exports:
  *	SHM_initLatch()
@@ -102,6 +105,437 @@
 #include "perThreadDS.h"
 
 
+#ifdef SHM_FUTEX_LATCH
+
+#include <errno.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/*
+ * Futex latch
+ *
+ * The latch word holds the writer bit, the waiters bit and the number of
+ * the M_SHARED holders. A latch is acquired and released by one atomic
+ * operation on the word when there is no contention. A blocked thread
+ * spins for a while and then sets the waiters bit and parks on the word;
+ * the releasing thread which clears the waiters bit wakes up all the parked
+ * threads, which compete for the latch again. As in the queue-based latch,
+ * M_SHARED requests are granted while the latch is held in M_SHARED mode.
+ *
+ * A woken thread may lose the latch again to a running thread. Not to starve,
+ * a thread which fails after it was parked sets the handoff bit and becomes
+ * the heir of the latch; while the bit is set, a free latch is granted only
+ * to the heir, which clears the bit when it gets (or, for M_INSTANT, sees)
+ * the latch.
+ *
+ * The M_EXCLUSIVE holder is recorded in the owner field, so a recursive
+ * request is found without searching. Each grant is pushed on the granted
+ * latch list of the thread, and a release pops it from the top, which is
+ * O(1) for the usual LIFO order of latches. The list is searched only for
+ * the S-to-X conversion check on the slow path and in SHM_releaseMyLatches().
+ */
+
+#if defined(__i386__) || defined(__x86_64__)
+#define SHM_CPU_RELAX()		__asm__ __volatile__ ("pause" ::: "memory")
+#else
+#define SHM_CPU_RELAX()		__asm__ __volatile__ ("" ::: "memory")
+#endif
+
+#define SHM_FUTEX_WAIT(_addr, _val) \
+    syscall(SYS_futex, (_addr), FUTEX_WAIT, (_val), NULL, NULL, 0)
+#define SHM_FUTEX_WAKE_ALL(_addr) \
+    syscall(SYS_futex, (_addr), FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0)
+
+
+/* # of processors; no spinning on a uniprocessor */
+static Four shm_nCPUs = 0;
+
+
+/* Internal Function Prototypes */
+static Boolean shm_isLatchBlocked(LATCH_TYPE *, UFour_Invariable, Four, Four);
+static Boolean shm_tryLatch(LATCH_TYPE *, Four, Four);
+static Boolean shm_isLatchGrantable(LATCH_TYPE *, Four, Four);
+static void shm_waitLatch(LATCH_TYPE *, Four, Four, Boolean);
+static Four shm_removeGrantedLatch(Four, LATCH_TYPE *);
+
+
+
+/*@================================
+ * SHM_initLatch( )
+ *================================*/
+Four SHM_initLatch(
+    Four 		handle,
+    LATCH_TYPE 		*latchPtr
+)
+{
+    latchPtr->word = 0;
+    latchPtr->owner = 0;
+    latchPtr->heir = 0;
+    latchPtr->spinLimit = SHM_LATCH_MIN_SPINS;
+    latchPtr->latchCounter = 0;
+
+    latchPtr->mode = M_FREE;
+    latchPtr->queue = LOGICAL_PTR(NULL); 
+
+
+    return(eNOERROR);
+}
+
+
+
+/*@================================
+ * SHM_getLatch( )
+ *================================*/
+Four SHM_getLatch(
+    Four 		handle,
+    LATCH_TYPE 		*latchPtr,		/* target latch pointer */
+    Four 		procIndex,		/* process index */
+    Four 		reqMode,		/* M_FREE, M_SHARED, M_EXCLUSIVE */
+    Four 		reqCondition,		/* M_CONDITIONAL, M_UNCONDITIONAL, M_INSTANT */
+    LATCH_TYPE 		*releasedLatchPtr) 	/* to be release latch pointer */
+{
+    Four 		me;			/* owner identifier of this thread */
+    Boolean 		grantedFlag;		/* TRUE if the request is granted (or grantable for M_INSTANT) */
+    Boolean 		instantFlag;		/* TRUE if the request is M_INSTANT */
+    LatchEntry  	*list;
+    Four 		i;			/* loop index */
+    Four 		e;			/* error handling */
+
+
+    if (procIndex < 0 || handle < 0) {
+	return(eNOERROR);
+    }
+
+    me = SHM_LATCH_OWNER(procIndex, handle);
+    instantFlag = (reqCondition & M_INSTANT) ? TRUE : FALSE;
+
+    /* make room for recording the grant before getting the latch */
+    if (!instantFlag && MY_NUMGRANTED(handle) == MY_GRANTEDLATCHSTRUCT(handle)->nEntries) {
+	e = Util_doublesizeVarArray(handle, MY_GRANTEDLATCHSTRUCT(handle), sizeof(LatchEntry));
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    if (instantFlag)
+	grantedFlag = shm_isLatchGrantable(latchPtr, reqMode, me);
+    else
+	grantedFlag = shm_tryLatch(latchPtr, reqMode, me);
+
+    /* do not allow conversion from M_SHARED to M_EXCLUSIVE */
+    if (!grantedFlag && reqMode == M_EXCLUSIVE && latchPtr != releasedLatchPtr &&
+	(latchPtr->word & SHM_LATCH_READERS)) {
+
+	list = MY_GRANTEDLATCHLIST(handle);
+	for (i = MY_NUMGRANTED(handle)-1; i >= 0; i--)
+	    if (list[i].counter > 0 && list[i].latchPtr == latchPtr)
+		ERR(handle, eBADLATCHCONVERSION_SHM);
+    }
+
+    /*@ release latch */
+    /* for concurrency and for deadlock avoidance */
+    if (releasedLatchPtr) {
+	e = SHM_releaseLatch(handle, releasedLatchPtr, procIndex);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    if (!grantedFlag) {
+	if (reqCondition & M_CONDITIONAL) {
+    	    TR_PRINT(handle, TR_SHM, TR1, ("\tpid %ld :: fails a getCondLatch", procIndex));
+	    return(SHM_BUSYLATCH);
+	}
+
+	shm_waitLatch(latchPtr, reqMode, me, instantFlag);
+    }
+
+    /* record this grant */
+    if (!instantFlag) {
+	i = MY_NUMGRANTED(handle)++;
+	MY_GRANTEDLATCHENTRY(handle, i).counter = 1;
+	MY_GRANTEDLATCHENTRY(handle, i).latchPtr = latchPtr;
+    }
+
+    return(eNOERROR);
+}
+
+
+
+/*@================================
+ * SHM_releaseLatch( )
+ *================================*/
+Four SHM_releaseLatch(
+    Four 		handle,
+    LATCH_TYPE 		*latchPtr,
+    Four 		procIndex)
+{
+    UFour_Invariable 	word;			/* value of the latch word */
+    UFour_Invariable 	newWord;		/* new value of the latch word */
+    Four  		e;
+
+
+    if (procIndex < 0 || handle < 0) return(eNOERROR);
+
+    word = latchPtr->word;
+
+    if (word & SHM_LATCH_WRITER) {
+
+	if (latchPtr->owner != SHM_LATCH_OWNER(procIndex, handle)) ERR(handle, eBADPARAMETER);
+
+	e = shm_removeGrantedLatch(handle, latchPtr);
+	if (e < eNOERROR) ERR(handle, e);
+
+	if (--latchPtr->latchCounter > 0) return(eNOERROR);
+
+	latchPtr->owner = 0;
+	word = __sync_fetch_and_and(&latchPtr->word, ~(SHM_LATCH_WRITER|SHM_LATCH_WAITERS));
+
+	if (word & SHM_LATCH_WAITERS) (void) SHM_FUTEX_WAKE_ALL(&latchPtr->word);
+
+    } else if (word & SHM_LATCH_READERS) {
+
+	e = shm_removeGrantedLatch(handle, latchPtr);
+	if (e < eNOERROR) ERR(handle, e);
+
+	/* the last reader clears the waiters bit */
+	do {
+	    word = latchPtr->word;
+	    newWord = word - 1;
+	    if ((newWord & SHM_LATCH_READERS) == 0) newWord &= ~SHM_LATCH_WAITERS;
+	} while (!__sync_bool_compare_and_swap(&latchPtr->word, word, newWord));
+
+	if ((word & SHM_LATCH_WAITERS) && !(newWord & SHM_LATCH_WAITERS))
+	    (void) SHM_FUTEX_WAKE_ALL(&latchPtr->word);
+
+    } else
+	ERR(handle, eBADPARAMETER);
+
+
+    return(eNOERROR);
+}
+
+
+
+/*@================================
+ * SHM_releaseMyLatches( )
+ *================================*/
+Four SHM_releaseMyLatches(
+    Four 	handle,
+    Four 	procIndex)
+{
+
+    LatchEntry  *list;
+    Four 	e;			/* returned error number */
+
+    list = MY_GRANTEDLATCHLIST(handle);
+    while (MY_NUMGRANTED(handle) > 0) {
+	e = SHM_releaseLatch(handle, list[MY_NUMGRANTED(handle)-1].latchPtr, procIndex);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    return(eNOERROR);
+
+
+}
+
+
+
+/*@================================
+ * shm_tryLatch()
+ *================================*/
+/* get the latch if it can be granted immediately */
+static Boolean shm_tryLatch(
+    LATCH_TYPE 		*latchPtr,
+    Four 		reqMode,
+    Four 		me)
+{
+    UFour_Invariable 	word;
+    UFour_Invariable 	newWord;
+
+
+    for (;;) {
+	word = latchPtr->word;
+
+	/* already acquired latch */
+	if ((word & SHM_LATCH_WRITER) && latchPtr->owner == me) {
+	    latchPtr->latchCounter++;
+	    return(TRUE);
+	}
+
+	if (shm_isLatchBlocked(latchPtr, word, reqMode, me)) return(FALSE);
+
+	/* the heir takes the handoff bit back */
+	newWord = ((word & SHM_LATCH_HANDOFF) && latchPtr->heir == me) ? (word & ~SHM_LATCH_HANDOFF) : word;
+
+	if (reqMode == M_EXCLUSIVE) {
+	    if (__sync_bool_compare_and_swap(&latchPtr->word, word, newWord | SHM_LATCH_WRITER)) {
+		latchPtr->owner = me;
+		latchPtr->latchCounter = 1;
+		return(TRUE);
+	    }
+	} else {
+	    if (__sync_bool_compare_and_swap(&latchPtr->word, word, newWord + 1))
+		return(TRUE);
+	}
+    }
+}
+
+
+
+/*@================================
+ * shm_isLatchGrantable()
+ *================================*/
+/* check if the latch can be granted now; used for M_INSTANT requests */
+static Boolean shm_isLatchGrantable(
+    LATCH_TYPE 		*latchPtr,
+    Four 		reqMode,
+    Four 		me)
+{
+    UFour_Invariable 	word;
+
+
+    for (;;) {
+	word = latchPtr->word;
+
+	if ((word & SHM_LATCH_WRITER) && latchPtr->owner == me) return(TRUE);
+
+	if (shm_isLatchBlocked(latchPtr, word, reqMode, me)) return(FALSE);
+
+	if (!(word & SHM_LATCH_HANDOFF) || latchPtr->heir != me) return(TRUE);
+
+	/* the heir does not hold the latch; give it to the parked threads */
+	if (__sync_bool_compare_and_swap(&latchPtr->word, word, word & ~(SHM_LATCH_HANDOFF|SHM_LATCH_WAITERS))) {
+	    if (word & SHM_LATCH_WAITERS) (void) SHM_FUTEX_WAKE_ALL(&latchPtr->word);
+	    return(TRUE);
+	}
+    }
+}
+
+
+
+/*@================================
+ * shm_isLatchBlocked()
+ *================================*/
+/* check if the request conflicts with the latch word; the owner is not checked */
+static Boolean shm_isLatchBlocked(
+    LATCH_TYPE 		*latchPtr,
+    UFour_Invariable 	word,
+    Four 		reqMode,
+    Four 		me)
+{
+    if (word & SHM_LATCH_WRITER) return(TRUE);
+
+    if (reqMode == M_EXCLUSIVE && (word & SHM_LATCH_READERS)) return(TRUE);
+
+    /* a free latch is reserved for the heir; M_SHARED holders may be joined */
+    if ((word & SHM_LATCH_HANDOFF) && latchPtr->heir != me &&
+	(reqMode == M_EXCLUSIVE || !(word & SHM_LATCH_READERS)))
+	return(TRUE);
+
+    return(FALSE);
+}
+
+
+
+/*@================================
+ * shm_waitLatch()
+ *================================*/
+/*
+ * Wait until the latch is granted (or becomes grantable for M_INSTANT).
+ * Spin first, as a latch is usually held for a short time, and then park.
+ * The spin limit of the latch doubles when spinning was enough and halves
+ * when the thread had to park.
+ */
+static void shm_waitLatch(
+    LATCH_TYPE 		*latchPtr,
+    Four 		reqMode,
+    Four 		me,
+    Boolean 		instantFlag)
+{
+    UFour_Invariable 	word;
+    Four 		nSpins;			/* # of spins done */
+    Four 		spinLimit;		/* # of spins before parking */
+    Boolean 		parkedFlag;		/* TRUE if the thread was parked */
+
+
+    if (shm_nCPUs == 0) shm_nCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+
+    spinLimit = (shm_nCPUs > 1) ? MAX(latchPtr->spinLimit, SHM_LATCH_MIN_SPINS) : 0;
+    parkedFlag = FALSE;
+
+    for (nSpins = 0; ; ) {
+
+	if (instantFlag ? shm_isLatchGrantable(latchPtr, reqMode, me) : shm_tryLatch(latchPtr, reqMode, me))
+	    break;
+
+	if (nSpins < spinLimit) {
+	    nSpins++;
+	    SHM_CPU_RELAX();
+	    continue;
+	}
+
+	word = latchPtr->word;
+
+	if (!shm_isLatchBlocked(latchPtr, word, reqMode, me))
+	    continue;		/* released meanwhile */
+
+	/* lost the latch after being woken up; ask for the handoff */
+	/* the heir is published before the bit, so the bit never names a stale heir; */
+	/* if another waiter overwrites it, that waiter becomes the heir instead */
+	if (parkedFlag && !(word & SHM_LATCH_HANDOFF)) {
+	    latchPtr->heir = me;
+	    (void) __sync_bool_compare_and_swap(&latchPtr->word, word, word | SHM_LATCH_HANDOFF);
+	    continue;
+	}
+
+	/* park on the latch word after announcing it by the waiters bit */
+
+	if (!(word & SHM_LATCH_WAITERS) &&
+	    !__sync_bool_compare_and_swap(&latchPtr->word, word, word | SHM_LATCH_WAITERS))
+	    continue;
+
+	(void) SHM_FUTEX_WAIT(&latchPtr->word, word | SHM_LATCH_WAITERS);
+	parkedFlag = TRUE;
+    }
+
+    if (spinLimit > 0) {
+	if (parkedFlag)
+	    latchPtr->spinLimit = MAX(spinLimit/2, SHM_LATCH_MIN_SPINS);
+	else
+	    latchPtr->spinLimit = MIN(spinLimit*2, SHM_LATCH_MAX_SPINS);
+    }
+}
+
+
+
+/*@================================
+ * shm_removeGrantedLatch()
+ *================================*/
+/* remove a grant of the latch from the granted latch list of the thread */
+static Four shm_removeGrantedLatch(
+    Four 		handle,
+    LATCH_TYPE 		*latchPtr)
+{
+    LatchEntry 		*list;
+    Four 		current;
+
+
+    list = MY_GRANTEDLATCHLIST(handle);
+
+    for (current = MY_NUMGRANTED(handle)-1; current >= 0; current--)
+	if (list[current].counter > 0 && list[current].latchPtr == latchPtr) {
+	    list[current].counter = 0;
+	    break;
+	}
+
+    if (current < 0) return(eBADPARAMETER);
+
+    /* pop the released entries from the top */
+    while (MY_NUMGRANTED(handle) > 0 && list[MY_NUMGRANTED(handle)-1].counter == 0)
+	MY_NUMGRANTED(handle)--;
+
+    return(eNOERROR);
+}
+
+#else /* SHM_FUTEX_LATCH */
+
 /* Internal Function Prototypes */
 void enter_latch_queue(LATCH_TYPE *, TCB *);
 Four shm_getInfoFromSemID(cosmos_thread_semName_t* ,GlobalHandle*);
@@ -596,5 +1030,7 @@ Four shm_getInfoFromSemID(cosmos_thread_semName_t *semName, GlobalHandle *global
     return (eNOERROR);
 }
 
+#endif /* SHM_FUTEX_LATCH */
+
 #endif
 
@@ -106,9 +106,28 @@
 #include "SHM.h"
 
 
+/* huge page size encoding for shmget() (linux/shm.h) */
+#ifdef SHM_HUGETLB
+#ifndef SHM_HUGE_SHIFT
+#define SHM_HUGE_SHIFT	26
+#endif
+#ifndef SHM_HUGE_1GB
+#define SHM_HUGE_1GB	(30 << SHM_HUGE_SHIFT)
+#endif
+#endif /* SHM_HUGETLB */
+
+
 /* Static Variable */
 Four_Invariable         shmId;
 static Four 		sharedHeapSize;		/* needed shared memory size */
+static Four_Invariable	bufferPoolShmId;	/* id of the buffer pool segment */
+static Eight 		bufferPoolSize;		/* size of the buffer pool segment */
+
+
+/*
+ * Internal Function Prototypes
+ */
+static Four shm_attachBufferPool(Four, key_t);
 
 
 /*@================================
@@ -132,6 +151,9 @@ Four shm_initFn(
      */
     memset(shmPtr, 0x00, sizeof(SemStruct)+sharedHeapSize);
 
+    shmPtr->bufferPoolSize = bufferPoolSize;
+    shmPtr->bufferPoolUsed = 0;
+
     /*
      * Initialize all the shared data structures of all the components.
      */
@@ -199,6 +221,12 @@ Four shm_finalFn(
         e = thm_FinalPerThreadDS(handle);
         if (e < eNOERROR) ERR(handle, e);
 
+        if (shmdt(shm_bufferPoolPtr) < 0) {
+            if (errno != EINVAL) { /* ignore EINVAL */
+		ERR(handle, eSHMDTFAILED_SHM);
+	    }
+        }
+
         if (shmdt((char *) shmPtr) < 0) {
             if (errno != EINVAL) { /* ignore EINVAL */
 		ERR(handle, eSHMDTFAILED_SHM);
@@ -235,12 +263,22 @@ Four shm_finalFn(
         e = thm_FinalPerThreadDS(handle);
         if (e < eNOERROR) ERR(handle, e);
 
+        if (shmdt(shm_bufferPoolPtr) < 0) {
+            if (errno != EINVAL) {  /* ignore EINVAL */
+                ERR(handle, eSHMDTFAILED_SHM);
+            }
+        }
+
         if (shmdt((char *) shmPtr) < 0) {
             if (errno != EINVAL) {  /* ignore EINVAL */
                 ERR(handle, eSHMDTFAILED_SHM);
             }
         }
 
+        if ( shmctl(bufferPoolShmId, IPC_RMID, (struct shmid_ds *) 0) < 0 ) {
+            ERR(handle, eSHMCTLFAILED_SHM);
+        }
+
         if ( shmctl(shmId, IPC_RMID, (struct shmid_ds *) 0) < 0 ) {
             ERR(handle, eSHMCTLFAILED_SHM);
         }
@@ -275,9 +313,8 @@ Four SHM_beginProcess(
 
     /*@ evaluate the size */
     /* these are defined in BfM_init() */
-    sharedHeapSize = PAGESIZE*NUM_PAGE_BUFS+ /* for page size buffer */
-	             PAGESIZE*NUM_LOT_LEAF_BUFS*TRAINSIZE2+/* for large object buffer */ 
-	             sizeof(bfmHashEntry)*NUM_PAGE_BUFS*7+sizeof(Lock_hashEntry)*NUM_PAGE_BUFS*7+
+    /* Note: the buffers themselves are in the buffer pool segment. */
+    sharedHeapSize = sizeof(bfmHashEntry)*NUM_PAGE_BUFS*7+sizeof(Lock_hashEntry)*NUM_PAGE_BUFS*7+
 	             sizeof(Lock_ctrlBlock)*NUM_PAGE_BUFS*7+MAXFREESPACE;
 
     TR_PRINT(handle, TR_SHM, TR2, ("SemStruct size is %ld\n", sizeof(SemStruct)));
@@ -325,6 +362,10 @@ Four SHM_beginProcess(
     printf("Shared memory is attached at shmPtr=%p\n",shmPtr);
     fflush(stdout);
 
+    /* get and attach the buffer pool segment */
+    e = shm_attachBufferPool(handle, shmkey + SHM_BUFFERPOOL_KEY_OFFSET);
+    if (e < eNOERROR) ERR(handle, e);
+
 
     TR_PRINT(handle, TR_ALL, TR0, ("value of smPtr = %p\n", shmPtr));
 
@@ -394,3 +435,86 @@ Four SHM_endProcess(
 
 } /* SHM_endProcess() */
 
+
+
+/*@================================
+ * shm_attachBufferPool( )
+ *================================*/
+/*
+ * Function: Four shm_attachBufferPool(Four, key_t)
+ *
+ * Description:
+ *  Get the buffer pool segment and attach it into this process.
+ *  The segment is backed by huge pages to reduce the TLB misses on the
+ *  buffer accesses. The size of a huge page is selected by the environment
+ *  variable COSMOS_BUFFER_POOL_HUGE_PAGE: "2M"(default), "1G", or "NONE".
+ *  If the huge pages are not available (e.g. not reserved by vm.nr_hugepages),
+ *  the normal pages are used instead. All the processes should use the same
+ *  setting.
+ *
+ * Returns:
+ *  error code
+ *    eSHMGETFAILED_SHM
+ *    eSHMATFAILED_SHM
+ */
+static Four shm_attachBufferPool(
+    Four 		handle,
+    key_t		bufferPoolKey)	/* IN key of the buffer pool segment */
+{
+    char		*hugePagePtr;	/* pointer to environment value of COSMOS_BUFFER_POOL_HUGE_PAGE */
+    Eight		hugePageSize;	/* size of a huge page; 0 if huge pages are not used */
+    Four		hugePageFlag;	/* flags of shmget() for huge pages */
+
+
+    TR_PRINT(handle, TR_SHM, TR1, ("shm_attachBufferPool(bufferPoolKey=%ld)", bufferPoolKey));
+
+
+    /* get the huge page size */
+    hugePageSize = SHM_HUGEPAGE_SIZE_2M;
+    if ((hugePagePtr = getenv("COSMOS_BUFFER_POOL_HUGE_PAGE")) != NULL) {
+        if (strcmp(hugePagePtr, "NONE") == 0)
+            hugePageSize = 0;
+        else if (strcmp(hugePagePtr, "1G") == 0)
+            hugePageSize = SHM_HUGEPAGE_SIZE_1G;
+    }
+
+#ifdef SHM_HUGETLB
+    if (hugePageSize == SHM_HUGEPAGE_SIZE_1G)
+        hugePageFlag = SHM_HUGETLB | SHM_HUGE_1GB;
+    else if (hugePageSize == SHM_HUGEPAGE_SIZE_2M)
+        hugePageFlag = SHM_HUGETLB; /* the default huge page size of the system */
+    else
+        hugePageFlag = 0;
+#else
+    hugePageSize = 0;
+    hugePageFlag = 0;
+#endif /* SHM_HUGETLB */
+
+    /* The size of a huge page segment should be a multiple of the huge page size. */
+    bufferPoolSize = SHM_BUFFERPOOL_SIZE;
+    if (hugePageSize > 0)
+        bufferPoolSize = ((bufferPoolSize + hugePageSize - 1) / hugePageSize) * hugePageSize;
+
+    /* get the buffer pool segment from system */
+    bufferPoolShmId = -1;
+    if (hugePageFlag != 0) {
+        if ((bufferPoolShmId = shmget(bufferPoolKey, (size_t)bufferPoolSize, PERMS | IPC_CREAT | hugePageFlag)) < 0)
+            Util_ErrorLog_Printf("Huge pages are not available for the buffer pool (errno=%d). Normal pages are used.\n", errno);
+    }
+
+    if (bufferPoolShmId < 0) {
+        if ((bufferPoolShmId = shmget(bufferPoolKey, (size_t)bufferPoolSize, PERMS | IPC_CREAT)) < 0) {
+            perror("shmget");
+            ERR(handle, eSHMGETFAILED_SHM);
+        }
+    }
+
+    /* attach the segment; the buffers are accessed via offsets, so any address is OK */
+    if ((shm_bufferPoolPtr = (char *)shmat(bufferPoolShmId, (char *)NULL, 0)) == (char *) -1) {
+        perror("shmat");
+        ERR(handle, eSHMATFAILED_SHM);
+    }
+
+    return(eNOERROR);
+
+} /* shm_attachBufferPool() */
@@ -115,7 +115,7 @@ Four shm_dumpMyLatches(
 	if ( list[current].counter > 0) {
 	    printf("count = %ld,", list[current].counter);
 	    printf("latchPtr = %P,", list[current].latchPtr);
-	    printf("latch mode = %ld\n", list[current].latchPtr->mode);
+	    printf("latch mode = %ld\n", (long)SHM_GET_LATCH_MODE(*list[current].latchPtr));
 	}
 
     return(eNOERROR);
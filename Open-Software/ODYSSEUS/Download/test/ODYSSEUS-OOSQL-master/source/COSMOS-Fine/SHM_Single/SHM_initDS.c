@@ -93,6 +93,7 @@
 
 Four procIndex;
 SemStruct *shmPtr; 
+char *shm_bufferPoolPtr = NULL;	/* per process address of the buffer pool segment */
 VarArray shm_grantedLatchStruct[MAXTHREADS];
 
 COMMON_SHM *common_shmPtr;
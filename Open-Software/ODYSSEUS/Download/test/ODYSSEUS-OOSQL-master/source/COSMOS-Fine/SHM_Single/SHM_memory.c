@@ -79,6 +79,7 @@
  * Exports:
  *	SHM_alloc( )
  *	SHM_free( )
+ *	SHM_allocBufferPool( )
  */
 
 
@@ -272,3 +273,37 @@ Four SHM_free(
     return(eNOERROR);
 
 }
+
+
+
+/*@================================
+ * SHM_allocBufferPool( )
+ *================================*/
+/* SHM_allocBufferPool :: allocate the buffers of a buffer pool from the
+   		buffer pool segment. Called only when initialize time, so no
+   		latch is acquired. The buffers are never freed individually;
+   		they are released with the segment.
+   		The offset from the start of the segment is returned since
+   		the segment may be attached at a different address in each process. */
+Four SHM_allocBufferPool(
+    Four 	handle,
+    Eight 	size,		/* IN size of the buffers */
+    Eight 	*offset		/* OUT offset of the buffers in the segment */
+)
+{
+    TR_PRINT(handle, TR_SHM, TR1, ("SHM_allocBufferPool(size=%ld)", size));
+
+    /*@ check parameters */
+    if (size < 0 || offset == NULL) ERR(handle, eBADPARAMETER);
+
+    /* keep every buffer pool aligned on the page boundary */
+    size = ((size + PAGESIZE - 1) / PAGESIZE) * (Eight)PAGESIZE;
+
+    if (shmPtr->bufferPoolUsed + size > shmPtr->bufferPoolSize) ERR(handle, eNOFREESPACEINGHEAP_SHM);
+
+    *offset = shmPtr->bufferPoolUsed;
+    shmPtr->bufferPoolUsed += size;
+
+    return(eNOERROR);
+
+}
@@ -85,6 +85,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include "perProcessDS.h"
 #include "perThreadDS.h"
 
@@ -97,9 +98,21 @@
 #include "SHM.h"
 
 
+/* huge page size encoding for mmap() (linux/mman.h) */
+#ifdef MAP_HUGETLB
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT	26
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB	(30 << MAP_HUGE_SHIFT)
+#endif
+#endif /* MAP_HUGETLB */
+
+
 /* Static Variable */
 static Four_Invariable  shmId;
 static Four 		sharedHeapSize;		/* needed shared memory size */
+static Eight 		bufferPoolSize;		/* size of the buffer pool */
 
 
 
@@ -121,9 +134,8 @@ Four SHM_beginProcess(
      *  Evaluate the size
      */
     /* these are defined in BfM_init() */
-    sharedHeapSize = PAGESIZE*NUM_PAGE_BUFS+ /* for page size buffer */
-                     PAGESIZE*NUM_LOT_LEAF_BUFS*TRAINSIZE2+/* for large object buffer */
-                     sizeof(bfmHashEntry)*NUM_PAGE_BUFS*7+sizeof(Lock_hashEntry)*NUM_PAGE_BUFS*7+
+    /* Note: the buffers themselves are in the buffer pool. */
+    sharedHeapSize = sizeof(bfmHashEntry)*NUM_PAGE_BUFS*7+sizeof(Lock_hashEntry)*NUM_PAGE_BUFS*7+
                      sizeof(Lock_ctrlBlock)*NUM_PAGE_BUFS*7+MAXFREESPACE;
 
 
@@ -134,6 +146,62 @@ Four SHM_beginProcess(
     if (shmPtr == NULL) ERR(handle, eMEMORYALLOCERR);
 
 
+    /*
+     *  Get the buffer pool.
+     *  It is backed by huge pages as in the multi-user version;
+     *  see shm_attachBufferPool() in SHM/SHM_process.c.
+     */
+    {
+        char	*hugePagePtr;	/* pointer to environment value of COSMOS_BUFFER_POOL_HUGE_PAGE */
+        Eight	hugePageSize;	/* size of a huge page; 0 if huge pages are not used */
+        Four	hugePageFlag;	/* flags of mmap() for huge pages */
+
+        hugePageSize = SHM_HUGEPAGE_SIZE_2M;
+        if ((hugePagePtr = getenv("COSMOS_BUFFER_POOL_HUGE_PAGE")) != NULL) {
+            if (strcmp(hugePagePtr, "NONE") == 0)
+                hugePageSize = 0;
+            else if (strcmp(hugePagePtr, "1G") == 0)
+                hugePageSize = SHM_HUGEPAGE_SIZE_1G;
+        }
+
+#ifdef MAP_HUGETLB
+        if (hugePageSize == SHM_HUGEPAGE_SIZE_1G)
+            hugePageFlag = MAP_HUGETLB | MAP_HUGE_1GB;
+        else if (hugePageSize == SHM_HUGEPAGE_SIZE_2M)
+            hugePageFlag = MAP_HUGETLB;
+        else
+            hugePageFlag = 0;
+#else
+        hugePageSize = 0;
+        hugePageFlag = 0;
+#endif /* MAP_HUGETLB */
+
+        bufferPoolSize = SHM_BUFFERPOOL_SIZE;
+        if (hugePageSize > 0)
+            bufferPoolSize = ((bufferPoolSize + hugePageSize - 1) / hugePageSize) * hugePageSize;
+
+        shm_bufferPoolPtr = MAP_FAILED;
+        if (hugePageFlag != 0) {
+            shm_bufferPoolPtr = mmap(NULL, (size_t)bufferPoolSize, PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS | hugePageFlag, -1, 0);
+            if (shm_bufferPoolPtr == MAP_FAILED)
+                Util_ErrorLog_Printf("Huge pages are not available for the buffer pool (errno=%d). Normal pages are used.\n", errno);
+        }
+
+        if (shm_bufferPoolPtr == MAP_FAILED) {
+            shm_bufferPoolPtr = mmap(NULL, (size_t)bufferPoolSize, PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (shm_bufferPoolPtr == MAP_FAILED) {
+                free(shmPtr);
+                ERR(handle, eMEMORYALLOCERR);
+            }
+        }
+
+        shmPtr->bufferPoolSize = bufferPoolSize;
+        shmPtr->bufferPoolUsed = 0;
+    }
+
+
     /*
      * Initialize all the local data structures of all the components.
      */
@@ -207,6 +275,9 @@ Four SHM_endProcess(
      */
     free(shmPtr);
 
+    (void) munmap(shm_bufferPoolPtr, (size_t)bufferPoolSize);
+    shm_bufferPoolPtr = NULL;
+
     e = thm_FinalPerThreadDS(handle);
     if (e < eNOERROR) ERR(handle, e);
 
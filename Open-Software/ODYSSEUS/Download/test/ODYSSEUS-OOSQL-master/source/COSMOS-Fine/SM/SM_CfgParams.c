@@ -82,6 +82,7 @@
 
 
 #include <string.h>
+#include <stdlib.h>
 #include "common.h"
 #include "error.h"
 #include "trace.h"
@@ -93,6 +94,9 @@
 
 extern CfgParams_T sm_cfgParams;
 
+/* buffer used to return the numeric parameters as a string */
+static char sm_cfgParamValueBuf[32];
+
 
 /*@================================
  * SM_SetCfgParam( )
@@ -116,6 +120,91 @@ Four SM_SetCfgParam(
 
         strcpy(sm_cfgParams.logVolumeDeviceList, value);
 
+    } else if (strcmp(name, "BFM_NUM_CLEANERS") == 0) {
+
+        sm_cfgParams.bfmNumCleaners = atoi(value);
+        if (sm_cfgParams.bfmNumCleaners < 0 || sm_cfgParams.bfmNumCleaners > BFM_MAX_CLEANERS)
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_CLEAN_RATIO") == 0) {
+
+        sm_cfgParams.bfmCleanRatio = atoi(value);
+        if (sm_cfgParams.bfmCleanRatio <= 0 || sm_cfgParams.bfmCleanRatio > 100)
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_CLEANER_INTERVAL") == 0) {
+
+        sm_cfgParams.bfmCleanerInterval = atoi(value);
+        if (sm_cfgParams.bfmCleanerInterval <= 0) ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_NUM_PARTITIONS") == 0) {
+
+        sm_cfgParams.bfmNumPartitions = atoi(value);
+        if (sm_cfgParams.bfmNumPartitions <= 0 || sm_cfgParams.bfmNumPartitions > BFM_MAX_PARTITIONS)
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_REPLACEMENT_POLICY") == 0) {
+
+        if (strcmp(value, "CLOCK") == 0)
+            sm_cfgParams.bfmReplacementPolicy = BFM_POLICY_CLOCK;
+        else if (strcmp(value, "2Q") == 0)
+            sm_cfgParams.bfmReplacementPolicy = BFM_POLICY_2Q;
+        else
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_NUM_PREFETCHERS") == 0) {
+
+        sm_cfgParams.bfmNumPrefetchers = atoi(value);
+        if (sm_cfgParams.bfmNumPrefetchers < 0 || sm_cfgParams.bfmNumPrefetchers > BFM_MAX_PREFETCHERS)
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "BFM_MAX_READAHEAD") == 0) {
+
+        sm_cfgParams.bfmMaxReadAhead = atoi(value);
+        if (sm_cfgParams.bfmMaxReadAhead < 0) ERR(handle, eBADPARAMETER);
+    } else if (strcmp(name, "RDSM_IO_ENGINE") == 0) {
+        if (strcmp(value, "PSYNC") == 0)
+            sm_cfgParams.rdsmIOEngine = RDSM_IO_ENGINE_PSYNC;
+        else if (strcmp(value, "AIO") == 0)
+            sm_cfgParams.rdsmIOEngine = RDSM_IO_ENGINE_AIO;
+        else if (strcmp(value, "URING") == 0)
+            sm_cfgParams.rdsmIOEngine = RDSM_IO_ENGINE_URING;
+        else
+            ERR(handle, eBADPARAMETER);
+    } else if (strcmp(name, "RDSM_DIRECT_IO") == 0) {
+        if (strcmp(value, "TRUE") == 0)
+            sm_cfgParams.rdsmDirectIO = TRUE;
+        else if (strcmp(value, "FALSE") == 0)
+            sm_cfgParams.rdsmDirectIO = FALSE;
+        else
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "LOG_GROUP_COMMIT_WINDOW") == 0) {
+
+        sm_cfgParams.logGroupCommitWindow = atoi(value);
+        if (sm_cfgParams.logGroupCommitWindow < 0) ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "LOG_GROUP_COMMIT_SIZE") == 0) {
+
+        sm_cfgParams.logGroupCommitSize = atoi(value);
+        if (sm_cfgParams.logGroupCommitSize <= 0) ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "RM_NUM_REDO_WORKERS") == 0) {
+
+        sm_cfgParams.rmNumRedoWorkers = atoi(value);
+        if (sm_cfgParams.rmNumRedoWorkers < 0 || sm_cfgParams.rmNumRedoWorkers > RM_MAX_REDO_WORKERS)
+            ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "RM_TARGET_REDO_DISTANCE") == 0) {
+
+        sm_cfgParams.rmTargetRedoDistance = atoi(value);
+        if (sm_cfgParams.rmTargetRedoDistance < 0) ERR(handle, eBADPARAMETER);
+
+    } else if (strcmp(name, "RM_CHECKPOINT_DISTANCE") == 0) {
+
+        sm_cfgParams.rmCheckpointDistance = atoi(value);
+        if (sm_cfgParams.rmCheckpointDistance < 0) ERR(handle, eBADPARAMETER);
+
     } else if (strcmp(name, "COHERENCY_VOLUME_DEVICE") == 0) {
 
         /* needless in multi-user version */
@@ -161,6 +250,84 @@ char* SM_GetCfgParam(
 
         value = sm_cfgParams.logVolumeDeviceList;
 
+    }
+    else if (strcmp(name, "BFM_NUM_CLEANERS") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmNumCleaners);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "BFM_CLEAN_RATIO") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmCleanRatio);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "BFM_CLEANER_INTERVAL") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmCleanerInterval);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "BFM_NUM_PARTITIONS") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmNumPartitions);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "BFM_REPLACEMENT_POLICY") == 0) {
+
+        value = (sm_cfgParams.bfmReplacementPolicy == BFM_POLICY_2Q) ? "2Q" : "CLOCK";
+
+    }
+    else if (strcmp(name, "BFM_NUM_PREFETCHERS") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmNumPrefetchers);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "BFM_MAX_READAHEAD") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.bfmMaxReadAhead);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "RDSM_IO_ENGINE") == 0) {
+        value = (sm_cfgParams.rdsmIOEngine == RDSM_IO_ENGINE_URING) ? "URING" :
+                (sm_cfgParams.rdsmIOEngine == RDSM_IO_ENGINE_AIO) ? "AIO" : "PSYNC";
+    }
+    else if (strcmp(name, "RDSM_DIRECT_IO") == 0) {
+        value = (sm_cfgParams.rdsmDirectIO) ? "TRUE" : "FALSE";
+    }
+    else if (strcmp(name, "LOG_GROUP_COMMIT_WINDOW") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.logGroupCommitWindow);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "LOG_GROUP_COMMIT_SIZE") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.logGroupCommitSize);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "RM_NUM_REDO_WORKERS") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.rmNumRedoWorkers);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "RM_TARGET_REDO_DISTANCE") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.rmTargetRedoDistance);
+        value = sm_cfgParamValueBuf;
+
+    }
+    else if (strcmp(name, "RM_CHECKPOINT_DISTANCE") == 0) {
+
+        sprintf(sm_cfgParamValueBuf, "%ld", (long)sm_cfgParams.rmCheckpointDistance);
+        value = sm_cfgParamValueBuf;
+
     }
     else {
 
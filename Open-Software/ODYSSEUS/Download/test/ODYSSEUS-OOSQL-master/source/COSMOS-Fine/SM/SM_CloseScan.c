@@ -120,6 +120,25 @@ Four SM_CloseScan(
     if (SM_SCANTABLE(handle)[scanId].scanType == MLGFINDEX) {
 	e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].cursor.mlgf.path);
 	if (e < eNOERROR) ERR(handle, e);
+
+	if (SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearestFlag) {
+	    e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearest.heap);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
+
+	if (SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.joinFlag) {
+	    e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.join.pagePairs);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.join.objectPairs);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.join.objects[0]);
+	    if (e < eNOERROR) ERR(handle, e);
+
+	    e = Util_finalVarArray(handle, &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.join.objects[1]);
+	    if (e < eNOERROR) ERR(handle, e);
+	}
     }
 
     /* The scan isn't accessible any more. */
@@ -0,0 +1,225 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: SM_FinalMLGFBulkLoad.c
+ *
+ * Description :
+ *  Finalize MLGF index bulkload
+ *
+ * Exports:
+ *  Four SM_FinalMLGFBulkLoad(Four, Four, IndexID*, Two, Two, LockParameter*)
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util_Sort.h"
+#include "MLGF.h"
+#include "SM.h"
+#include "BL_SM.h"
+#include "perThreadDS.h"
+#include "perProcessDS.h"
+
+
+
+/*@===========================
+ * SM_FinalMLGFBulkLoad()
+ *===========================*/
+/*
+ * Function: Four SM_FinalMLGFBulkLoad(Four, Four, IndexID*, Two, Two, LockParameter*)
+ *
+ * Description:
+ *  Sort given sort stream, and then build the MLGF index using the objects
+ *  sorted in the Morton order. The MLGF index should be empty.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER
+ *    some errors caused by function calss
+ *
+ * Side Effects:
+ *
+ */
+Four SM_FinalMLGFBulkLoad (
+    Four		    handle,
+    Four                    indexBlkLdId,           /* IN index bulkload id */
+    IndexID                 *iid,                   /* IN MLGF index where the given ObjectIDs are inserted */
+    Two                     eff,                    /* IN Extent fill factor */
+    Two                     pff,                    /* IN Page fill factor */
+    LockParameter      	    *lockup)                /* IN lockup parameter for data volume */
+{
+    Four                    e;                      /* error number */
+    Four                    v;                      /* index for the used volume on the mount table */
+    SM_IdxBlkLdTableEntry*  blkLdEntry;             /* entry in which information about bulkload is saved */
+    BtreeIndexInfo          btreeIinfo;             /* index information from the catalog */
+    MLGFIndexInfo           iinfo;                  /* MLGF index information */
+    PhysicalIndexID         pIid;
+    ObjectID                catObjForIdx;           /* catalog object of MLGF index */
+    LogParameter_T          logParamForSortStream;
+    LogParameter_T          logParamForBulkload;
+
+
+    TR_PRINT(handle, TR_SM, TR1,
+            ("SM_FinalMLGFBulkLoad(indexBlkLdId=%ld, iid=%P, eff=%ld, pff=%ld)",
+            indexBlkLdId, iid, eff, pff));
+
+
+    /*
+    **  O. Check parameters
+    */
+
+    if (indexBlkLdId < 0 || indexBlkLdId >= SM_IDXBLKLD_TABLE_SIZE) ERR(handle, eBADPARAMETER);
+
+    if (iid == NULL)                    ERR(handle, eBADPARAMETER);
+
+    if (eff < 0 || eff > 100)           ERR(handle, eBADPARAMETER);
+
+    if (pff < MINPFF || pff > MAXPFF)   ERR(handle, eBADPARAMETER);
+
+
+
+    /*
+    **  I. set entry for fast access
+    */
+    blkLdEntry = &SM_IDXBLKLD_TABLE(handle)[indexBlkLdId];
+
+
+    /*
+    **  II. Get catalog entry for the given MLGF index
+    */
+
+    /* 1. find the given volume in the scan manager mount table */
+    for (v = 0; v < MAXNUMOFVOLS; v++)
+        if (SM_MOUNTTABLE[v].volId == iid->volNo) break; /* found */
+
+    if (v == MAXNUMOFVOLS) ERR(handle, eNOTMOUNTEDVOLUME_SM);
+
+
+    /* 2. get the catalog object for the given MLGF index. */
+    e = sm_GetCatalogEntryFromIndexId(handle, v, iid, &catObjForIdx, &pIid);
+    if (e < 0)  ERR(handle, e);
+
+
+    /* 3. get the index-info for the given MLGF index. */
+    e = sm_GetIndexInfoFromIndexId(handle, v, iid, &btreeIinfo, &blkLdEntry->fid);
+    if (e < 0)  ERR(handle, e);
+
+    iinfo.iid = btreeIinfo.iid;
+    iinfo.tmpIndexFlag = btreeIinfo.tmpIndexFlag;
+    if (iinfo.tmpIndexFlag)
+        iinfo.catalog.entry = btreeIinfo.catalog.entry;
+    else
+        iinfo.catalog.oid = btreeIinfo.catalog.oid;
+
+
+
+    /*
+    **  III. Sort given stream - <Morton value, oid> list
+    */
+    SET_LOG_PARAMETER(logParamForSortStream, common_shmPtr->recoveryFlag, FALSE);
+
+    e = Util_SortingSortStream(handle, MY_XACT_TABLE_ENTRY(handle), blkLdEntry->streamId, &logParamForSortStream);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+
+    /*
+    **  IV. Bulkload MLGF index given sorted list
+    */
+    SET_LOG_PARAMETER(logParamForBulkload, common_shmPtr->recoveryFlag, iinfo.tmpIndexFlag);
+
+    e = MLGF_BulkLoad(handle, MY_XACT_TABLE_ENTRY(handle), &iinfo, &blkLdEntry->mlgfKdesc, (PageID*)&pIid,
+                      blkLdEntry->streamId, eff, pff, &logParamForBulkload);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+
+    /*
+    **  V. Close the given sort stream
+    */
+
+    e = Util_CloseSortStream(handle, MY_XACT_TABLE_ENTRY(handle), blkLdEntry->streamId, &logParamForSortStream);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    /*
+    **  VI. empty entry of SM bulkload table
+    */
+
+    blkLdEntry->isUsed = FALSE;
+
+
+    return eNOERROR;
+
+}   /* SM_FinalMLGFBulkLoad() */
@@ -103,7 +103,12 @@
 #include "perProcessDS.h"
 #include "perThreadDS.h"
 
-CfgParams_T sm_cfgParams = { "" };
+CfgParams_T sm_cfgParams = { "", 0, BFM_DEFAULT_CLEAN_RATIO, BFM_DEFAULT_CLEANER_INTERVAL,
+                             BFM_DEFAULT_NUM_PARTITIONS, BFM_DEFAULT_REPLACEMENT_POLICY,
+                             0, BFM_DEFAULT_MAX_READAHEAD,
+                             RDSM_DEFAULT_IO_ENGINE, FALSE,
+                             LOG_DEFAULT_GROUP_COMMIT_WINDOW, LOG_DEFAULT_GROUP_COMMIT_SIZE,
+                             0, 0, 0 };
 
 
 
@@ -270,6 +270,19 @@ Four SM_AllocHandle(Four *handle)
     e = THM_AllocHandle(handle);
     if (e < eNOERROR) ERR(*handle, e);
 
+    /* start the page cleaners and prefetchers of this process with its first handle */
+    if (NUM_OF_THREADS_IN_PROCESS == 1) {
+        if (CFG_BFMNUMCLEANERS > 0) {
+            e = BfM_StartCleaners(*handle);
+            if (e < eNOERROR) ERR(*handle, e);
+        }
+
+        if (CFG_BFMNUMPREFETCHERS > 0) {
+            e = BfM_StartPrefetchers(*handle);
+            if (e < eNOERROR) ERR(*handle, e);
+        }
+    }
+
     /*
      * CRITICAL SECTION END
      */
@@ -293,6 +306,16 @@ Four SM_FreeHandle(Four handle)
      */
     START_CRITICAL_SECTION_FOR_SHARED_MEMORY_ACCESS(handle, &fd_1);
 
+    /* stop the page cleaners and prefetchers before the last handle of this process is freed */
+    if ((BfM_NumCleaners() > 0 || BfM_NumPrefetchers() > 0) &&
+        NUM_OF_THREADS_IN_PROCESS == BfM_NumCleaners() + BfM_NumPrefetchers() + 1) {
+        e = BfM_StopPrefetchers(handle);
+        if (e < eNOERROR) ERR(handle, e);
+
+        e = BfM_StopCleaners(handle);
+        if (e < eNOERROR) ERR(handle, e);
+    }
+
     e = THM_FreeHandle(handle);
     if (e < eNOERROR) ERR(handle, e);
 
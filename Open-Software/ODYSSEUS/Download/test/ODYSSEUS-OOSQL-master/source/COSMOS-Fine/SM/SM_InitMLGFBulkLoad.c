@@ -0,0 +1,197 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: SM_InitMLGFBulkLoad.c
+ *
+ * Description :
+ *  Initialize MLGF index bulkload.
+ *
+ * Exports:
+ *  Four SM_InitMLGFBulkLoad(Four, VolID, MLGF_KeyDesc*)
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "Util_Sort.h"
+#include "MLGF.h"
+#include "SM.h"
+#include "BL_SM.h"
+#include "RDsM.h"
+#include "perThreadDS.h"
+#include "perProcessDS.h"
+
+
+
+/*@===========================
+ * SM_InitMLGFBulkLoad()
+ *===========================*/
+/*
+ * Function: Four SM_InitMLGFBulkLoad(Four, VolID, MLGF_KeyDesc*)
+ *
+ * Description:
+ *  Initialize MLGF index bulkload.
+ *  The objects are sorted in the Morton order of their keys, and then in
+ *  the ObjectID order for the same keys.
+ *
+ * Returns:
+ *  index bulkload ID
+ *  error code
+ *    eBADPARAMETER
+ *    eBLKLDTABLEFULL
+ *    some errors caused by function calss
+ */
+Four SM_InitMLGFBulkLoad (
+    Four		    handle,
+    VolID                   volId,                  /* IN volume ID in which temporary files are allocated */
+    MLGF_KeyDesc            *kdesc)                 /* IN key descriptor of the given MLGF index */
+{
+    Four                    v;                      /* array index on scan manager mount table */
+    SortTupleDesc           sortKeyDesc;            /* sort key descriptor of MLGF index */
+    Four                    blkLdId;                /* index bulkload ID */
+    SM_IdxBlkLdTableEntry*  blkLdEntry;             /* entry in which information about bulkload is saved */
+    LogParameter_T          logParam;
+
+
+    TR_PRINT(handle, TR_SM, TR1,
+            ("SM_InitMLGFBulkLoad(volId=%ld, kdesc=%P)", volId, kdesc));
+
+
+    /*
+    **  O. Check parameters
+    */
+
+    /* find the given volume in the scan manager mount table */
+    for (v = 0; v < MAXNUMOFVOLS; v++)
+        if (SM_MOUNTTABLE[v].volId == volId) break; /* found */
+
+    if (v == MAXNUMOFVOLS) ERR(handle, eNOTMOUNTEDVOLUME_SM);
+
+    if (kdesc == NULL)          ERR(handle, eBADPARAMETER);
+
+    if (kdesc->nKeys < 1 || kdesc->nKeys > MLGF_MAXNUM_KEYS) ERR(handle, eBADPARAMETER);
+
+    if (kdesc->extraDataLen < 0 || kdesc->extraDataLen > MLGF_MAXLEN_EXTRADATA) ERR(handle, eBADPARAMETER);
+
+
+    /*
+    **  I. Find empty entry from SM index bulkload table
+    */
+
+    for (blkLdId = 0; blkLdId < SM_IDXBLKLD_TABLE_SIZE; blkLdId++ ) {
+	if (SM_IDXBLKLD_TABLE(handle)[blkLdId].isUsed == FALSE) break;
+    }
+    if (blkLdId == SM_IDXBLKLD_TABLE_SIZE) ERR(handle, eBLKLDTABLEFULL);
+
+    /* set entry for fast access */
+    blkLdEntry = &SM_IDXBLKLD_TABLE(handle)[blkLdId];
+
+    /* set isUsed flag */
+    blkLdEntry->isUsed = TRUE;
+
+    blkLdEntry->mlgfKdesc = *kdesc;
+
+
+    /*
+    **  II. Make sortKeyDesc : <Morton value of keys, oid>
+    */
+
+    sortKeyDesc.nparts  = 2;
+    sortKeyDesc.hdrSize = 0;
+
+    sortKeyDesc.parts[0].type   = SM_STRING;
+    sortKeyDesc.parts[0].length = MLGF_BLKLD_SORTKEY_LEN(kdesc->nKeys);
+    sortKeyDesc.parts[0].flag   = SORTKEYDESC_ATTR_ASC;
+
+    sortKeyDesc.parts[1].type   = SM_OBJECT_ID;
+    sortKeyDesc.parts[1].length = SM_OBJECT_ID_SIZE;
+    sortKeyDesc.parts[1].flag   = SORTKEYDESC_ATTR_ASC;
+
+
+    /*
+    **  III. Open sort stream for bulkload
+    */
+    SET_LOG_PARAMETER(logParam, common_shmPtr->recoveryFlag, FALSE);
+
+    blkLdEntry->streamId = Util_OpenSortStream(handle, MY_XACT_TABLE_ENTRY(handle), volId, &sortKeyDesc, &logParam);
+    if (blkLdEntry->streamId < 0) {
+        blkLdEntry->isUsed = FALSE;
+        ERR(handle, blkLdEntry->streamId);
+    }
+
+
+    return blkLdId;
+
+
+}   /* SM_InitMLGFBulkLoad() */
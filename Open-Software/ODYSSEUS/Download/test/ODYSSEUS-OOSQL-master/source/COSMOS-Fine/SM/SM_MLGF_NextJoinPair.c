@@ -0,0 +1,214 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: SM_MLGF_NextJoinPair.c
+ *
+ * Description:
+ *  Return the next pair of objects of a spatial join of two MLGF index scans.
+ *
+ * Exports:
+ *  Four SM_MLGF_NextJoinPair(Four, Four, ObjectID*, ObjectID*, LockParameter*)
+ */
+
+
+#include "common.h"
+#include "error.h"
+#include "trace.h"
+#include "latch.h"
+#include "TM.h"
+#include "LM.h"
+#include "OM.h"
+#include "MLGF.h"
+#include "SM.h"
+#include "SHM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*@================================
+ * SM_MLGF_NextJoinPair()
+ *================================*/
+/*
+ * Function: Four SM_MLGF_NextJoinPair(Four, Four, ObjectID*, ObjectID*, LockParameter*)
+ *
+ * Description:
+ *  Return the next pair of objects whose MBRs intersect. 'oid' is an object
+ *  of the scan 'scanId' and 'innerOid' an object of the scan joined by
+ *  SM_MLGF_SetSpatialJoin(). The pairs are returned in no particular order.
+ *
+ * Returns:
+ *  1) Error code - negative value
+ *        eBADPARAMETER
+ *        eBADCURSOR
+ *        some errors caused by function calls
+ *  2) return EOS if there is no more pair.
+ */
+Four SM_MLGF_NextJoinPair(
+    Four handle,
+    Four scanId,		/* IN scan to use */
+    ObjectID *oid,		/* OUT object of the scan */
+    ObjectID *innerOid,		/* OUT object of the inner scan */
+    LockParameter *lockup)      /* IN request lock or not */
+{
+    Four e;			/* error code */
+    Four innerScanId;		/* the inner scan */
+    sm_ScanInfoForMLGF_Scan *mlgfScan; /* scan information of the MLGF scan */
+    sm_ScanInfoForMLGF_Scan *innerScan; /* scan information of the inner scan */
+    LockParameter *realLockup;
+
+
+    TR_PRINT(handle, TR_SM, TR1,
+	     ("SM_MLGF_NextJoinPair(handle, scanId=%ld, oid=%P, innerOid=%P, lockup=%P)",
+	      scanId, oid, innerOid, lockup));
+
+
+    /*@ check parameters */
+
+    if (!VALID_SCANID(handle, scanId) || oid == NULL || innerOid == NULL) ERR(handle, eBADPARAMETER);
+
+    if (SM_SCANTABLE(handle)[scanId].scanType != MLGFINDEX ||
+	!SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.joinFlag)
+	ERR(handle, eBADCURSOR);
+
+    innerScanId = SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.innerScanId;
+
+    if (!VALID_SCANID(handle, innerScanId) || SM_SCANTABLE(handle)[innerScanId].scanType != MLGFINDEX)
+	ERR(handle, eBADCURSOR);
+
+    mlgfScan = &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf;
+    innerScan = &SM_SCANTABLE(handle)[innerScanId].scanInfo.mlgf;
+
+    if(SM_NEED_AUTO_ACTION(handle)) {
+        e = LM_beginAction(handle, &MY_XACTID(handle), AUTO_ACTION);
+        if(e < eNOERROR) ERR(handle, e);
+    }
+
+    realLockup = NULL;
+
+    /* Locks are requested unless both data files are already locked enough. */
+    if (lockup) {
+	if(lockup->duration != L_COMMIT) ERR(handle, eCOMMITDURATIONLOCKREQUIRED_SM);
+	if((lockup->mode != L_X) && (lockup->mode != L_S)) ERR(handle, eBADLOCKMODE_SM);
+
+	if ((SM_SCANTABLE(handle)[scanId].acquiredFileLock != L_S &&
+	     SM_SCANTABLE(handle)[scanId].acquiredFileLock != L_X) ||
+	    (SM_SCANTABLE(handle)[innerScanId].acquiredFileLock != L_S &&
+	     SM_SCANTABLE(handle)[innerScanId].acquiredFileLock != L_X))
+	    realLockup = lockup;
+    }
+
+    switch (SM_SCANTABLE(handle)[scanId].cursor.any.flag) {
+
+      case CURSOR_BOS:		/* Begin of the scan */
+	e = MLGF_SpatialJoin(handle, MY_XACT_TABLE_ENTRY(handle),
+			     &mlgfScan->iinfo, &mlgfScan->kdesc, mlgfScan->lowerBound, mlgfScan->upperBound,
+			     &innerScan->iinfo, &innerScan->kdesc, innerScan->lowerBound, innerScan->upperBound,
+			     &mlgfScan->join, realLockup);
+	if (e < 0) {
+	    SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_INVALID;
+	    ERR(handle, e);
+	}
+
+	SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_ON;
+
+	/* fall through */
+
+      case CURSOR_ON:
+	e = MLGF_NextSpatialJoin(handle, MY_XACT_TABLE_ENTRY(handle), &mlgfScan->join, oid, innerOid, realLockup);
+	if (e < 0) {
+	    SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_INVALID;
+	    ERR(handle, e);
+	}
+
+	if (e == EOS) SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_EOS;
+	break;
+
+      case CURSOR_EOS:		/* End of the scan */
+	break;
+
+      default:
+	ERR(handle, eBADCURSOR);
+    }
+
+    if(ACTION_ON(handle)){
+	e = LM_endAction(handle, &MY_XACTID(handle), AUTO_ACTION);
+	if(e < eNOERROR) ERR(handle, e);
+    }
+
+    /*@ end of scan? */
+    if (SM_SCANTABLE(handle)[scanId].cursor.any.flag == CURSOR_EOS) return(EOS);
+
+    return(eNOERROR);
+
+} /* SM_MLGF_NextJoinPair() */
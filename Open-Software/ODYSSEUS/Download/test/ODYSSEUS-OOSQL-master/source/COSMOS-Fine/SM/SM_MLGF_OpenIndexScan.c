@@ -301,6 +301,8 @@ Four SM_MLGF_OpenIndexScan(
 	SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound[i] = lowerBound[i];
 	SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound[i] = upperBound[i];
     }
+    SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearestFlag = FALSE;
+    SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.joinFlag = FALSE;
 
     SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_BOS;
     SM_SCANTABLE(handle)[scanId].scanType = MLGFINDEX;
@@ -0,0 +1,160 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: SM_MLGF_SetNearestQuery.c
+ *
+ * Description:
+ *  Make an MLGF index scan return objects in increasing distance order.
+ *
+ * Exports:
+ *  Four SM_MLGF_SetNearestQuery(Four, Four, MLGF_HashValue[], MLGF_HashToCoordFunc)
+ */
+
+
+#include <string.h>
+#include "common.h"
+#include "error.h"
+#include "Util.h"
+#include "trace.h"
+#include "latch.h"
+#include "TM.h"
+#include "OM.h"
+#include "MLGF.h"
+#include "SM.h"
+#include "SHM.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+
+/*@================================
+ * SM_MLGF_SetNearestQuery()
+ *================================*/
+/*
+ * Function: Four SM_MLGF_SetNearestQuery(Four, Four, MLGF_HashValue[], MLGF_HashToCoordFunc)
+ *
+ * Description:
+ *  Turn a newly opened MLGF index scan into a nearest-neighbour scan.
+ *  SM_NextObject() then returns the objects in the region of the scan in
+ *  increasing distance from 'queryPoint', reading only the pages needed to
+ *  produce the objects fetched so far; closing the scan after k objects
+ *  answers a k-nearest-neighbour query.
+ *  'hashToCoord' maps a hash value back to its coordinate; it may be NULL
+ *  when the hash values themselves are the coordinates.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER
+ *    eBADCURSOR
+ *    some errors caused by function calls
+ */
+Four SM_MLGF_SetNearestQuery(
+    Four handle,
+    Four scanId,		/* IN scan to use */
+    MLGF_HashValue queryPoint[], /* IN query point */
+    MLGF_HashToCoordFunc hashToCoord) /* IN hash value to coordinate mapping */
+{
+    Four e;			/* error code */
+    sm_ScanInfoForMLGF_Scan *mlgfScan; /* scan information of the MLGF scan */
+
+
+    TR_PRINT(handle, TR_SM, TR1, ("SM_MLGF_SetNearestQuery(scanId=%ld, queryPoint=%P, hashToCoord=%P)", scanId, queryPoint, hashToCoord));
+
+
+    /*@ check parameters */
+
+    if (!VALID_SCANID(handle, scanId)) ERR(handle, eBADPARAMETER);
+
+    if (queryPoint == NULL) ERR(handle, eBADPARAMETER);
+
+    /* The order can be changed only before the first object is fetched. */
+    if (SM_SCANTABLE(handle)[scanId].scanType != MLGFINDEX ||
+        SM_SCANTABLE(handle)[scanId].cursor.any.flag != CURSOR_BOS)
+	ERR(handle, eBADCURSOR);
+
+    mlgfScan = &SM_SCANTABLE(handle)[scanId].scanInfo.mlgf;
+
+    if (!mlgfScan->nearestFlag) {
+	e = Util_initVarArray(handle, &mlgfScan->nearest.heap, sizeof(mlgf_NearestElem), MLGF_NEAREST_QUEUE_INIT_SIZE);
+	if (e < eNOERROR) ERR(handle, e);
+    }
+
+    memcpy(mlgfScan->nearest.queryPoint, queryPoint, sizeof(MLGF_HashValue)*mlgfScan->kdesc.nKeys);
+    mlgfScan->nearest.hashToCoord = hashToCoord;
+    mlgfScan->nearest.nElems = 0;
+    mlgfScan->nearestFlag = TRUE;
+
+
+    return(eNOERROR);
+
+} /* SM_MLGF_SetNearestQuery() */
@@ -251,13 +251,23 @@ Four SM_NextObject(
 	    break;
 
 	  case MLGFINDEX:
-	    e = MLGF_Fetch(handle, MY_XACT_TABLE_ENTRY(handle),
-                           &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo), 
-			   &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
-			   SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
-			   SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
-			   &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
-			   extraData, realLockup);
+	    if (SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearestFlag)
+		e = MLGF_FetchNearest(handle, MY_XACT_TABLE_ENTRY(handle),
+				      &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo),
+				      &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
+				      SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
+				      SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
+				      &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearest),
+				      &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
+				      extraData, realLockup);
+	    else
+		e = MLGF_Fetch(handle, MY_XACT_TABLE_ENTRY(handle),
+			       &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo),
+			       &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
+			       SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
+			       SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
+			       &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
+			       extraData, realLockup);
 	    if (e < 0) {
 		SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_INVALID;
 		ERR(handle, e);
@@ -325,13 +335,23 @@ Four SM_NextObject(
 
 	  case MLGFINDEX:
 
-	    e = MLGF_FetchNext(handle, MY_XACT_TABLE_ENTRY(handle),
-                               &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo), 
-			       &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
-			       SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
-			       SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
-			       &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
-			       extraData, realLockup);
+	    if (SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearestFlag)
+		e = MLGF_FetchNextNearest(handle, MY_XACT_TABLE_ENTRY(handle),
+					  &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo),
+					  &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
+					  SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
+					  SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
+					  &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.nearest),
+					  &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
+					  extraData, realLockup);
+	    else
+		e = MLGF_FetchNext(handle, MY_XACT_TABLE_ENTRY(handle),
+				   &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.iinfo),
+				   &(SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.kdesc),
+				   SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.lowerBound,
+				   SM_SCANTABLE(handle)[scanId].scanInfo.mlgf.upperBound,
+				   &(SM_SCANTABLE(handle)[scanId].cursor.mlgf),
+				   extraData, realLockup);
 	    if (e < 0) {
 		SM_SCANTABLE(handle)[scanId].cursor.any.flag = CURSOR_INVALID;
 		ERR(handle, e);
@@ -287,6 +287,9 @@ Four SM_OpenIndexScan(
     SM_SCANTABLE(handle)[scanId].scanInfo.btree.iinfo = iinfo; 
     SM_SCANTABLE(handle)[scanId].scanInfo.btree.kdesc = *kdesc;
 
+    /* choose the key compare routine once for the searches of this scan */
+    BtM_SetKeyCompareFunc(&SM_SCANTABLE(handle)[scanId].scanInfo.btree.kdesc);
+
     /* Save the region conditions. */
     SM_SCANTABLE(handle)[scanId].scanInfo.btree.startCond = *startCond;
     SM_SCANTABLE(handle)[scanId].scanInfo.btree.stopCond = *stopCond;
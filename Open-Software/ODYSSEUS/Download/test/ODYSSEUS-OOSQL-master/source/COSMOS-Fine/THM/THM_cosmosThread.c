@@ -331,8 +331,8 @@ Four cosmos_thread_wait(cosmos_thread_t tid)
 
     e = pthread_join(tid, NULL);
 
-    /* error check */
-    switch (errno) {
+    /* error check: pthread_join() returns the error number instead of setting errno */
+    switch (e) {
         case 0:         /* success */
             return (eNOERROR);
         case ESRCH:     /* tid is not a valid, undetached thread in the current process */
@@ -507,6 +507,7 @@ Four cosmos_thread_cond_create(cosmos_thread_cond_t *cv, Four flag)
     Four e;
 
     e = pthread_cond_init(cv, &cosmos_thread_cond_attr_default);
+    if (e == 0) return (eNOERROR);
 
     /* error check */
     switch (errno) {
@@ -541,6 +542,7 @@ Four cosmos_thread_cond_destroy(cosmos_thread_cond_t *cv)
     Four e;
 
     e = pthread_cond_destroy(cv);
+    if (e == 0) return (eNOERROR);
 
     /* error check */
     switch (errno) {
@@ -570,6 +572,7 @@ Four cosmos_thread_cond_wait(cosmos_thread_cond_t *cv, cosmos_thread_mutex_t *mp
     Four e;
 
     e = pthread_cond_wait(cv, mp);
+    if (e == 0) return (eNOERROR);
 
     /* error check */
     switch (errno) {
@@ -598,6 +601,7 @@ Four cosmos_thread_cond_signal(cosmos_thread_cond_t *cv)
     Four e;
 
     e = pthread_cond_signal(cv);
+    if (e == 0) return (eNOERROR);
 
     /* error check */
     switch (errno) {
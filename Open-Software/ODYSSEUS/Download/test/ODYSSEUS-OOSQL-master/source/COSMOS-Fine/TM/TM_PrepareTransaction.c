@@ -152,7 +152,7 @@ Four TM_PrepareTransaction(
         e = LOG_WriteLogRecord(handle, xactEntry, &logRecInfo, &lsn, &logRecLen);
         if (e < eNOERROR) ERR(handle, e);
 
-        e = LOG_FlushLogRecords(handle, &lsn, logRecLen);
+        e = LOG_GroupCommit(handle, &lsn, logRecLen);
         if (e < eNOERROR) ERR(handle, e);
 
     }
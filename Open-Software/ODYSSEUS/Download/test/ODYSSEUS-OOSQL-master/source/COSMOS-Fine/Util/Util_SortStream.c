@@ -481,7 +481,7 @@ Four util_CreateRun(
     assert(k == entry->numTuples);
 
     /* sort tuples */
-    e = util_QuickSort(handle, &entry->sortTupleDesc, TUPLE_ARRAY(entry->tuples), entry->numTuples);
+    e = util_ParallelSort(handle, &entry->sortTupleDesc, TUPLE_ARRAY(entry->tuples), entry->numTuples);
     if (e < eNOERROR) ERR(handle, e);
 
     /* if internal sort is used, return!! */
@@ -641,12 +641,12 @@ Four Util_SortingSortStream(
             /* calculate number of page which will be readed into In Buffer */
             entry->numRunInBuffer = (j == numCreateRun-1) ? entry->numSrcRun-accumNumRun : MAX_NUM_RUN;
 
-            /* read runs into In Buffer & initialze leaf of loser tree */
-            for (k = 0; k < entry->numRunInBuffer; k++ ) {
+            /* read the first pages of all runs into In Buffer in one batch */
+            e = util_ReadRunsIntoInBuffer(handle, entry, accumNumRun, 0, entry->numRunInBuffer);
+            if (e < eNOERROR) ERR(handle, e);
 
-                /* read pages of k'th run */
-                e = util_ReadIthRunIntoInBuffer(handle, entry, accumNumRun+k, k);
-                if (e < eNOERROR) ERR(handle, e);
+            /* initialze leaf of loser tree */
+            for (k = 0; k < entry->numRunInBuffer; k++ ) {
 
                 /* insert first tuple of each run's first page into tree of loser's leaf */
                 TUPLE_ARRAY(entry->tuples)[k] = entry->sortInBufferArray[k*READ_UNIT].data;
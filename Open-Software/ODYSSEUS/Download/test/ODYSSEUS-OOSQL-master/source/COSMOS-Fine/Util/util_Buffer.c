@@ -79,6 +79,8 @@
  * Exports :
  *  Four util_PutTupleIntoSortInBufferArray(SortStreamTableEntry*, Two, char*)
  *  Four util_PutTupleIntoSortOutBufferArray(SortStreamTableEntry*, Two, char*)
+ *  Four util_ReadIthRunIntoInBuffer(Four, SortStreamTableEntry*, Four, Four)
+ *  Four util_ReadRunsIntoInBuffer(Four, SortStreamTableEntry*, Four, Four, Four)
  */
 
 
@@ -386,53 +388,109 @@ Four util_ReadIthRunIntoInBuffer(
     Four                  ithRunInBuffer)
 {
     Four                  e;
-    Four                  i;
-    Four                  numReadPage;
+
+
+    e = util_ReadRunsIntoInBuffer(handle, entry, ithRunInSrcFile, ithRunInBuffer, 1);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    return eNOERROR;
+
+} /* util_ReadIthRunIntoInBuffer() */
+
+
+
+/*=============================================
+ * util_ReadRunsIntoInBuffer()
+ *============================================*/
+/*
+ * Function : Four util_ReadRunsIntoInBuffer(Four, SortStreamTableEntry*, Four, Four, Four)
+ *
+ * Description :
+ *  Read the next READ_UNIT pages of 'numRuns' runs starting from
+ *  'firstRunInSrcFile' into the In Buffer, starting from the
+ *  'firstRunInBuffer'th run area. The pages of all the runs are read in one
+ *  batch.
+ *
+ * Return Values :
+ *  Error codes
+ */
+Four util_ReadRunsIntoInBuffer(
+    Four		  handle,
+    SortStreamTableEntry* entry,              /* IN pointer to entry of sortStreamTable */
+    Four                  firstRunInSrcFile,  /* IN the first run to be read */
+    Four                  firstRunInBuffer,   /* IN run area of the In Buffer for the first run */
+    Four                  numRuns)            /* IN # of runs to be read */
+{
+    Four                  e;
+    Four                  i, k;
+    Four                  ithRunInSrcFile;
+    Four                  ithRunInBuffer;
     PageID                pid;
-    PageID                readPageIdArray[READ_UNIT];
+    PageID                readPageIdArray[MAX_NUM_RUN][READ_UNIT];
+    PageID*               readPageIdArrays[MAX_NUM_RUN];
+    char*                 readBufPtrArray[MAX_NUM_RUN];
+    Four                  numReadPageArray[MAX_NUM_RUN];
+
 
+    /* assertion check */
+    assert(numRuns <= MAX_NUM_RUN);
 
     /* set pid's volNo */
     pid.volNo = entry->volId;
 
-    /* read ithRunInSrcFile into ithRunInBuffer */
-    for (i = 0; i < READ_UNIT; i++ ) {
+    for (k = 0; k < numRuns; k++) {
 
-        /* if source's run is exhausted */
-        /* Note!! use slotted page's 'free' field as tuple counter */
-        if (RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].start == RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].end+1) {
+        ithRunInSrcFile = firstRunInSrcFile + k;
+        ithRunInBuffer = firstRunInBuffer + k;
 
-            /* assertion check */
-            assert (i > 0);
+        /* read ithRunInSrcFile into ithRunInBuffer */
+        for (i = 0; i < READ_UNIT; i++ ) {
 
-            entry->sortInBufferArray[ithRunInBuffer*READ_UNIT+i].header.free = NIL;
-            break;
-        }
+            /* if source's run is exhausted */
+            /* Note!! use slotted page's 'free' field as tuple counter */
+            if (RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].start == RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].end+1) {
+
+                /* assertion check */
+                assert (i > 0);
 
-        /* get PID of first READ_UNIT pages of remaining source's run */
-        pid.pageNo = PNO_ARRAY(entry->srcPnoArray)[RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].start++];
+                entry->sortInBufferArray[ithRunInBuffer*READ_UNIT+i].header.free = NIL;
+                break;
+            }
 
-        /* set 'readPageIdArray' & 'readPageBufPtrArray' */
-        readPageIdArray[i] = pid;
+            /* get PID of first READ_UNIT pages of remaining source's run */
+            pid.pageNo = PNO_ARRAY(entry->srcPnoArray)[RUN_ARRAY(entry->srcRunArray)[ithRunInSrcFile].start++];
 
-    } /* for 'i' */
+            /* set 'readPageIdArray' & 'readPageBufPtrArray' */
+            readPageIdArray[k][i] = pid;
+
+        } /* for 'i' */
+
+        /* set 'numReadPage' */
+        numReadPageArray[k] = i;
+        readPageIdArrays[k] = readPageIdArray[k];
+        readBufPtrArray[k] = (char *) &entry->sortInBufferArray[ithRunInBuffer*READ_UNIT];
 
-    /* set 'numReadPage' */
-    numReadPage = i;
+    } /* for 'k' */
 
     /* read pages into buffer */
-    e = util_ReadTrains(handle, readPageIdArray, (char *) &entry->sortInBufferArray[ithRunInBuffer*READ_UNIT], numReadPage, PAGESIZE2);
+    e = util_ReadTrainsBatch(handle, numRuns, readPageIdArrays, readBufPtrArray, numReadPageArray, PAGESIZE2);
     if (e < eNOERROR) ERR(handle, e);
 
-    /* initialize slotted page's 'free' field as tuple counter */
-    /* Note!! this operation must be executed after read trains from disk */
-    for (i = 0; i < numReadPage; i++ ) entry->sortInBufferArray[ithRunInBuffer*READ_UNIT+i].header.free = 0;
+    for (k = 0; k < numRuns; k++) {
 
-    /* set 'pageIdxInRun' */
-    /* Note!! each entry of pageIdxInRun[] have value between 0 and READ_UNIT-1 */
-    entry->pageIdxInRun[ithRunInBuffer] = 0;
+        ithRunInBuffer = firstRunInBuffer + k;
+
+        /* initialize slotted page's 'free' field as tuple counter */
+        /* Note!! this operation must be executed after read trains from disk */
+        for (i = 0; i < numReadPageArray[k]; i++ ) entry->sortInBufferArray[ithRunInBuffer*READ_UNIT+i].header.free = 0;
+
+        /* set 'pageIdxInRun' */
+        /* Note!! each entry of pageIdxInRun[] have value between 0 and READ_UNIT-1 */
+        entry->pageIdxInRun[ithRunInBuffer] = 0;
+    }
 
 
     return eNOERROR;
 
-} /* util_ReadIthRunIntoInBuffer() */
+} /* util_ReadRunsIntoInBuffer() */
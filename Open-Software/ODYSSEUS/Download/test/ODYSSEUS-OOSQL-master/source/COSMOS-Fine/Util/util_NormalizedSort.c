@@ -0,0 +1,321 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : util_NormalizedSort.c
+ *
+ * Description :
+ *  sort given tuples by their normalized key prefixes.
+ *  The first key part of each tuple is encoded into an unsigned 8-byte
+ *  integer whose order agrees with util_SortKeyCompare(), the tuples are
+ *  radix sorted on the integers, and tuples with the same integer are sorted
+ *  by util_QuickSort().
+ *
+ * Exports :
+ *  Four util_NormalizedSort(Four, SortTupleDesc*, void**, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc */
+#include <string.h> /* for memcpy */
+
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "Util_Sort.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/* the smallest # of tuples sorted by the normalized key prefixes */
+#define UTIL_NORMALIZED_SORT_MIN_TUPLES  64
+
+/* # of bits in a radix sort digit */
+#define UTIL_RADIX_BITS     8
+#define UTIL_RADIX_SIZE     (1 << UTIL_RADIX_BITS)
+
+/* sign bit of a normalized key prefix */
+#define UTIL_PREFIX_SIGN_BIT  ((UEight_Invariable)1 << (sizeof(UEight_Invariable)*8 - 1))
+
+/* a tuple with its normalized key prefix */
+typedef struct {
+    UEight_Invariable   prefix;                   /* normalized key prefix */
+    void*               tuple;                    /* pointer to the object containing the tuple */
+} util_KeyPrefix;
+
+
+/* Internal Function Prototypes */
+static Boolean util_IsNormalizableKey(SortTupleDesc*, Boolean*);
+static UEight_Invariable util_NormalizeKey(SortTupleDesc*, void*);
+
+
+
+/*=========================================
+ * util_NormalizedSort()
+ *========================================*/
+/*
+ * Function : util_NormalizedSort(Four, SortTupleDesc*, void**, Four)
+ *
+ * Description :
+ *  sort given tuples by LSD radix sort over the normalized key prefixes.
+ *  If the first key part cannot be normalized or there are few tuples,
+ *  the tuples are sorted by util_QuickSort().
+ *
+ * Return Values :
+ *  Error codes
+ *    eMEMORYALLOCERR
+ *    some errors caused by function calls
+ *
+ * Side effects :
+ *  contents of tuples will be sorted
+ */
+Four util_NormalizedSort(
+    Four           	handle,
+    SortTupleDesc* 	sortTupleDesc,            /* IN */
+    void**       	tuples,                   /* INOUT pointer array which points each object containg tuple */
+    Four         	numTuples)                /* IN number of tuples */
+{
+    Four        	e;                        /* error number */
+    Four        	i, j;                     /* index variable */
+    Four        	shift;                    /* shift of the current digit */
+    Four        	digit;                    /* the current digit */
+    Four        	count[UTIL_RADIX_SIZE];   /* # of tuples for each digit */
+    Boolean     	exact;                    /* TRUE if prefixes decide the order completely */
+    util_KeyPrefix*	buffer;                   /* array for 'src' and 'dst' */
+    util_KeyPrefix*	src;                      /* tuples to be distributed */
+    util_KeyPrefix*	dst;                      /* tuples distributed */
+    util_KeyPrefix*	tmp;                      /* temporary variable for swapping */
+
+
+    if (numTuples < UTIL_NORMALIZED_SORT_MIN_TUPLES || !util_IsNormalizableKey(sortTupleDesc, &exact))
+        return(util_QuickSort(handle, sortTupleDesc, tuples, numTuples));
+
+    buffer = (util_KeyPrefix *) malloc(sizeof(util_KeyPrefix)*numTuples*2);
+    if (buffer == NULL) ERR(handle, eMEMORYALLOCERR);
+    src = buffer;
+    dst = buffer + numTuples;
+
+    /* extract the normalized key prefixes */
+    for (i = 0; i < numTuples; i++) {
+        src[i].prefix = util_NormalizeKey(sortTupleDesc, tuples[i]);
+        src[i].tuple = tuples[i];
+    }
+
+    /* distribute the tuples digit by digit from the least significant one */
+    for (shift = 0; shift < sizeof(UEight_Invariable)*8; shift += UTIL_RADIX_BITS) {
+
+        memset(count, 0, sizeof(count));
+        for (i = 0; i < numTuples; i++)
+            count[(src[i].prefix >> shift) & (UTIL_RADIX_SIZE-1)]++;
+
+        /* skip the digit which is same in all tuples */
+        if (count[(src[0].prefix >> shift) & (UTIL_RADIX_SIZE-1)] == numTuples) continue;
+
+        for (digit = 0, j = 0; digit < UTIL_RADIX_SIZE; digit++) {
+            i = count[digit];
+            count[digit] = j;
+            j += i;
+        }
+
+        for (i = 0; i < numTuples; i++)
+            dst[count[(src[i].prefix >> shift) & (UTIL_RADIX_SIZE-1)]++] = src[i];
+
+        tmp = src; src = dst; dst = tmp;
+    }
+
+    for (i = 0; i < numTuples; i++) tuples[i] = src[i].tuple;
+
+    /* sort the tuples with the same prefix by comparing the whole keys */
+    if (!exact) {
+        for (i = 0; i < numTuples; i = j) {
+            for (j = i+1; j < numTuples && src[j].prefix == src[i].prefix; j++);
+
+            if (j - i > 1) {
+                e = util_QuickSort(handle, sortTupleDesc, &tuples[i], j - i);
+                if (e < eNOERROR) {
+                    free(buffer);
+                    ERR(handle, e);
+                }
+            }
+        }
+    }
+
+    free(buffer);
+
+
+    return(eNOERROR);
+
+} /* util_NormalizedSort() */
+
+
+
+/*
+ * Function : Boolean util_IsNormalizableKey(SortTupleDesc*, Boolean*)
+ *
+ * Description :
+ *  Check if the first key part can be normalized. 'exact' is set to TRUE
+ *  when the prefixes decide the order of the tuples completely, that is,
+ *  the key has one integer part.
+ */
+static Boolean util_IsNormalizableKey(
+    SortTupleDesc* 	sortKeyDesc,              /* IN */
+    Boolean*            exact)                    /* OUT */
+{
+    if (sortKeyDesc->nparts < 1) return(FALSE);
+
+    switch (sortKeyDesc->parts[0].type) {
+      case SM_SHORT:
+      case SM_INT:
+      case SM_LONG:
+      case SM_LONG_LONG:
+        *exact = (sortKeyDesc->nparts == 1) ? TRUE : FALSE;
+        return(TRUE);
+
+      case SM_STRING:
+      case SM_VARSTRING:
+        *exact = FALSE;
+        return(TRUE);
+
+      default:
+        return(FALSE);
+    }
+
+} /* util_IsNormalizableKey() */
+
+
+
+/*
+ * Function : UEight_Invariable util_NormalizeKey(SortTupleDesc*, void*)
+ *
+ * Description :
+ *  Encode the first key part of the tuple into an unsigned integer.
+ *  Integers get their sign bit flipped, and strings take their first
+ *  eight bytes in big-endian order padded with zeros. A descending key
+ *  is complemented. If the integers of two tuples differ, they are ordered
+ *  as util_SortKeyCompare() orders them.
+ */
+static UEight_Invariable util_NormalizeKey(
+    SortTupleDesc* 	sortKeyDesc,              /* IN */
+    void*               p)                        /* IN pointer which points object containing tuple */
+{
+    unsigned char*      key;                      /* the first key part */
+    UEight_Invariable   prefix;                   /* normalized key prefix */
+    Four                i;                        /* index variable */
+    Four                len;                      /* # of bytes in the prefix */
+    Two                 slen;                     /* length of variable length attribute */
+    Two_Invariable      s;                        /* variable for '2byte-Short' type */
+    Four_Invariable     l;                        /* variable for '4byte-Int/Long' type */
+    Eight_Invariable    ll;                       /* variable for '8byte-Long' type */
+
+
+    key = (unsigned char *)&(((SlottedPageForSortTuple *) p)->data)[sortKeyDesc->hdrSize];
+
+    switch (sortKeyDesc->parts[0].type) {
+      case SM_SHORT:
+        memcpy(&s, key, sizeof(Two_Invariable));
+        prefix = (UEight_Invariable)((Eight_Invariable)s) ^ UTIL_PREFIX_SIGN_BIT;
+        break;
+
+      case SM_INT:
+      case SM_LONG:
+        memcpy(&l, key, sizeof(Four_Invariable));
+        prefix = (UEight_Invariable)((Eight_Invariable)l) ^ UTIL_PREFIX_SIGN_BIT;
+        break;
+
+      case SM_LONG_LONG:
+        memcpy(&ll, key, sizeof(Eight_Invariable));
+        prefix = (UEight_Invariable)ll ^ UTIL_PREFIX_SIGN_BIT;
+        break;
+
+      case SM_STRING:
+      case SM_VARSTRING:
+        if (sortKeyDesc->parts[0].type == SM_VARSTRING) {
+            memcpy(&slen, key, sizeof(Two));
+            key += sizeof(Two);
+            len = MIN(slen, sizeof(UEight_Invariable));
+        } else
+            len = MIN(sortKeyDesc->parts[0].length, sizeof(UEight_Invariable));
+
+        for (prefix = 0, i = 0; i < sizeof(UEight_Invariable); i++)
+            prefix = (prefix << 8) | ((i < len) ? key[i] : 0);
+        break;
+
+      default:
+        prefix = 0;
+        break;
+    }
+
+    if (sortKeyDesc->parts[0].flag & SORTKEYDESC_ATTR_DESC) prefix = ~prefix;
+
+    return(prefix);
+
+} /* util_NormalizeKey() */
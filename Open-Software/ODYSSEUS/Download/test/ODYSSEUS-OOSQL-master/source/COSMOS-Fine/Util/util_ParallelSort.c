@@ -0,0 +1,270 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/COSMOS General-Purpose Large-Scale Object Storage System --    */
+/*    Fine-Granule Locking Version                                            */
+/*    Version 3.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : util_ParallelSort.c
+ *
+ * Description :
+ *  sort given tuples on several threads. The tuple array is divided into
+ *  ranges, each range is sorted by util_NormalizedSort() on its own thread,
+ *  and the sorted ranges are merged.
+ *
+ * Exports :
+ *  Four util_ParallelSort(Four, SortTupleDesc*, void**, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc */
+#include <string.h> /* for memcpy */
+#include <unistd.h> /* for sysconf */
+
+#include "common.h"
+#include "trace.h"
+#include "error.h"
+#include "Util_Sort.h"
+#include "THM_cosmosThread.h"
+#include "perProcessDS.h"
+#include "perThreadDS.h"
+
+
+/* argument of a sort thread */
+typedef struct {
+    Four           	handle;                   /* handle of the caller */
+    SortTupleDesc* 	sortTupleDesc;            /* sort key descriptor */
+    void**       	tuples;                   /* the first tuple of the range */
+    Four         	numTuples;                /* # of tuples in the range */
+    Four         	e;                        /* OUT result of util_NormalizedSort() */
+} util_SortThreadArg;
+
+
+/* Internal Function Prototypes */
+static void *util_SortThreadMain(void*);
+static void util_MergeRanges(Four, SortTupleDesc*, void**, void**, Four, Four, Four);
+
+
+
+/*=========================================
+ * util_ParallelSort()
+ *========================================*/
+/*
+ * Function : util_ParallelSort(Four, SortTupleDesc*, void**, Four)
+ *
+ * Description :
+ *  sort given tuples using up to UTIL_SORT_NUM_THREADS threads, but no more
+ *  than the number of online processors. A small array, or any array on a
+ *  uniprocessor, is sorted by util_NormalizedSort() on the calling thread.
+ *
+ * Return Values :
+ *  Error codes
+ *    eMEMORYALLOCERR
+ *    some errors caused by function calls
+ *
+ * Side effects :
+ *  contents of tuples will be sorted
+ *
+ * Note :
+ *  util_SortKeyCompare() does not touch per-thread data, so the sort
+ *  threads use the caller's handle.
+ */
+Four util_ParallelSort(
+    Four           	handle,
+    SortTupleDesc* 	sortTupleDesc,            /* IN */
+    void**       	tuples,                   /* INOUT pointer array which points each object containg tuple */
+    Four         	numTuples)                /* IN number of tuples */
+{
+    Four        	e;                        /* error number */
+    Four        	i;                        /* index variable */
+    Four        	nThreads;                 /* # of sort threads */
+    Four        	nCreated;                 /* # of sort threads created */
+    Four        	width;                    /* # of tuples in a sorted range */
+    Four        	start[UTIL_SORT_NUM_THREADS+1]; /* the first tuple of each range */
+    util_SortThreadArg  args[UTIL_SORT_NUM_THREADS]; /* arguments of the sort threads */
+    cosmos_thread_t     tids[UTIL_SORT_NUM_THREADS]; /* thread ids of the sort threads */
+    void**       	src;                      /* ranges to be merged */
+    void**       	dst;                      /* ranges merged */
+    void**       	tmp;                      /* temporary variable for swapping */
+    void**       	buffer;                   /* temporary pointer array for merge */
+
+
+    nThreads = MIN(UTIL_SORT_NUM_THREADS, sysconf(_SC_NPROCESSORS_ONLN));
+
+    if (nThreads <= 1 || numTuples < UTIL_PARALLEL_SORT_MIN_TUPLES)
+        return(util_NormalizedSort(handle, sortTupleDesc, tuples, numTuples));
+
+    buffer = (void **) malloc(sizeof(void *)*numTuples);
+    if (buffer == NULL) ERR(handle, eMEMORYALLOCERR);
+
+    /* divide the tuple array into ranges of (almost) equal size */
+    for (i = 0; i <= nThreads; i++)
+        start[i] = (Four)(((double)numTuples * i) / nThreads);
+
+    /* the last range is sorted on the calling thread */
+    for (nCreated = 0; nCreated < nThreads - 1; nCreated++) {
+        args[nCreated].handle = handle;
+        args[nCreated].sortTupleDesc = sortTupleDesc;
+        args[nCreated].tuples = &tuples[start[nCreated]];
+        args[nCreated].numTuples = start[nCreated+1] - start[nCreated];
+        args[nCreated].e = eNOERROR;
+
+        e = cosmos_thread_create(&tids[nCreated], util_SortThreadMain, (void *)&args[nCreated], 0);
+        if (e < eNOERROR) break;
+    }
+
+    /* If a thread cannot be created, the rest ranges are sorted here. */
+    for (i = nCreated; i < nThreads; i++) {
+        args[i].e = util_NormalizedSort(handle, sortTupleDesc, &tuples[start[i]], start[i+1] - start[i]);
+    }
+
+    for (i = 0; i < nCreated; i++) {
+        e = cosmos_thread_wait(tids[i]);
+        if (e < eNOERROR) args[i].e = e;
+    }
+
+    for (i = 0; i < nThreads; i++) {
+        if (args[i].e < eNOERROR) {
+            free(buffer);
+            ERR(handle, args[i].e);
+        }
+    }
+
+    /* merge the sorted ranges pairwise until one range remains */
+    src = tuples;
+    dst = buffer;
+    for (width = 1; width < nThreads; width *= 2) {
+        for (i = 0; i < nThreads; i += 2*width) {
+            util_MergeRanges(handle, sortTupleDesc, src, dst, start[i],
+                             start[MIN(i+width, nThreads)], start[MIN(i+2*width, nThreads)]);
+        }
+        tmp = src; src = dst; dst = tmp;
+    }
+
+    if (src != tuples) memcpy(tuples, src, sizeof(void *)*numTuples);
+
+    free(buffer);
+
+
+    return(eNOERROR);
+
+} /* util_ParallelSort() */
+
+
+
+/*
+ * Function : void *util_SortThreadMain(void*)
+ *
+ * Description :
+ *  Start routine of a sort thread; sort one range by util_NormalizedSort().
+ */
+static void *util_SortThreadMain(
+    void                *arg)                     /* IN util_SortThreadArg of the range */
+{
+    util_SortThreadArg  *sortArg = (util_SortThreadArg *)arg;
+
+
+    sortArg->e = util_NormalizedSort(sortArg->handle, sortArg->sortTupleDesc, sortArg->tuples, sortArg->numTuples);
+
+    return(NULL);
+
+} /* util_SortThreadMain() */
+
+
+
+/*
+ * Function : void util_MergeRanges(Four, SortTupleDesc*, void**, void**, Four, Four, Four)
+ *
+ * Description :
+ *  Merge two sorted ranges src[low..mid-1] and src[mid..high-1] into
+ *  dst[low..high-1]. Equal tuples are taken from the left range first.
+ */
+static void util_MergeRanges(
+    Four           	handle,
+    SortTupleDesc* 	sortTupleDesc,            /* IN */
+    void**       	src,                      /* IN pointer array containing two sorted ranges */
+    void**       	dst,                      /* OUT pointer array for the merged range */
+    Four         	low,                      /* IN the first tuple of the left range */
+    Four         	mid,                      /* IN the first tuple of the right range */
+    Four         	high)                     /* IN the end of the right range */
+{
+    Four        	i, j, k;                  /* index variable */
+
+
+    for (i = low, j = mid, k = low; i < mid && j < high; k++) {
+        if (util_SortKeyCompare(handle, sortTupleDesc, src[j], src[i]) < 0)
+            dst[k] = src[j++];
+        else
+            dst[k] = src[i++];
+    }
+
+    while (i < mid) dst[k++] = src[i++];
+    while (j < high) dst[k++] = src[j++];
+
+} /* util_MergeRanges() */
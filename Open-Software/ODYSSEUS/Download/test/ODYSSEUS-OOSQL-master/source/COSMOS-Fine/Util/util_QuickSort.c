@@ -116,7 +116,7 @@ Four util_QuickSort(
     void*       	tmp;                      /* temporary variable for swapping */
     Four        	i, j;                     /* index variable */
     void*       	pivot;                    /* pivot which indicates split point */
-    static Seed         rand=0;                   /* varible for generating random variable */
+    Seed                rand=0;                   /* varible for generating random variable (per call, for util_ParallelSort()) */
 
 
     /* initialize 'curStart' & 'curEnd' */
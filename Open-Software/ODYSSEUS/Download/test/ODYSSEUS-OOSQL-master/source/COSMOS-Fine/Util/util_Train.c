@@ -79,6 +79,7 @@
  * Exports:
  *  Four util_WriteTrains(char *, PageID *, Four, Four)
  *  Four util_ReadTrains(PageID *, char *, Four, Four)
+ *  Four util_ReadTrainsBatch(Four, PageID **, char **, Four *, Four)
  */
 
 #include "common.h"
@@ -159,26 +160,101 @@ Four util_ReadTrains(
     Four          sizeOfTrain)       /* IN    size of train */
 {
     Four          e;                 /* for errors */
+
+
+    e = util_ReadTrainsBatch(handle, 1, &trainIdArray, &bufPtr, &numTrains, sizeOfTrain);
+    if (e < eNOERROR) ERR(handle, e);
+
+
+    return(eNOERROR);
+
+}  /* util_ReadTrains() */
+
+
+
+
+/*@================================
+ * util_ReadTrainsBatch()
+ *================================*/
+/*
+ * Function: Four util_ReadTrainsBatch(Four, PageID **, char **, Four *, Four)
+ *
+ * Description :
+ *  Read several groups of trains from the disk. The i-th group consists of
+ *  'numTrainsArray[i]' trains specified by 'trainIdArrays[i]' and is read
+ *  into 'bufPtrArray[i]'. Contiguous trains in an extent are read by one
+ *  request, and the requests are submitted together by RDsM_SubmitIOs(),
+ *  so that the I/O engine can carry them out concurrently.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four util_ReadTrainsBatch(
+    Four	  handle,
+    Four          numGroups,         /* IN    number of groups */
+    PageID**      trainIdArrays,     /* IN    Array of train ID array of each group */
+    char**        bufPtrArray,       /* INOUT buffer of each group */
+    Four*         numTrainsArray,    /* IN    number of trains of each group */
+    Four          sizeOfTrain)       /* IN    size of train */
+{
+    Four          e;                 /* for errors */
+    Four          g;                 /* index of group */
     Four          i, j;              /* index variable */
     Four          numContTrains;     /* number of contiguous trains */
+    Four          sizeOfExt;         /* # of pages in an extent */
+    Four          nReqs;             /* # of requests in 'reqs' */
+    PageID*       trainIdArray;      /* train ID array of the current group */
+    char*         bufPtr;            /* buffer of the current train */
+    RDsM_IORequest_T reqs[UTIL_MAX_READ_REQUESTS]; /* requests submitted together */
 
 
-    for (i = 0; i < numTrains; i += numContTrains) {
+    for (nReqs = 0, g = 0; g < numGroups; g++) {
 
-        /* calculate 'numContTrains' */
-        for (numContTrains = 1, j = i ;
-             j + 1 < numTrains && trainIdArray[j].pageNo + sizeOfTrain == trainIdArray[j+1].pageNo ;
-             j++, numContTrains++);
+        if (numTrainsArray[g] == 0) continue;
 
-        /*@ write a train into the disk */
-        e = RDsM_ReadTrains(handle, &trainIdArray[i], bufPtr, numContTrains, sizeOfTrain);
+        trainIdArray = trainIdArrays[g];
+        bufPtr = bufPtrArray[g];
+
+        e = RDsM_GetSizeOfExt(handle, trainIdArray[0].volNo, &sizeOfExt);
         if (e < eNOERROR) ERR(handle, e);
 
-        /* update 'bufPtr' */
-        bufPtr += numContTrains*sizeOfTrain*PAGESIZE;
+        for (i = 0; i < numTrainsArray[g]; i += numContTrains) {
+
+            /* calculate 'numContTrains'; a request does not cross an extent */
+            for (numContTrains = 1, j = i ;
+                 j + 1 < numTrainsArray[g] && trainIdArray[j].pageNo + sizeOfTrain == trainIdArray[j+1].pageNo &&
+                 trainIdArray[j+1].pageNo % sizeOfExt != 0;
+                 j++, numContTrains++);
+
+            reqs[nReqs].opType = RDSM_IO_READ;
+            reqs[nReqs].trainId = trainIdArray[i];
+            reqs[nReqs].nPages = numContTrains*sizeOfTrain;
+            reqs[nReqs].bufPtr = bufPtr;
+            reqs[nReqs].callback = NULL;
+            reqs[nReqs].arg = NULL;
+            nReqs++;
+
+            /*@ read the requests into the buffers when the array is full */
+            if (nReqs == UTIL_MAX_READ_REQUESTS) {
+                e = RDsM_SubmitIOs(handle, reqs, nReqs);
+                if (e < eNOERROR) ERR(handle, e);
+
+                nReqs = 0;
+            }
+
+            /* update 'bufPtr' */
+            bufPtr += numContTrains*sizeOfTrain*PAGESIZE;
+        }
+    }
+
+    /*@ read the remaining requests */
+    if (nReqs > 0) {
+        e = RDsM_SubmitIOs(handle, reqs, nReqs);
+        if (e < eNOERROR) ERR(handle, e);
     }
 
 
     return(eNOERROR);
 
-}  /* util_ReadTrains() */
+}  /* util_ReadTrainsBatch() */
@@ -74,6 +74,7 @@
 #include "OOSQL_APIs_Internal.hxx"
 #include "OOSQL_Error.h"
 #include "OOSQL_ServerQuery.hxx"
+#include "OOSQL_PlanCache.hxx"
 #include "DBM.h"
 #include <string.h>
 #include <stdlib.h>
@@ -333,6 +334,10 @@ Four OOSQL_Dismount(
 	e = LOM_Dismount(&OOSQL_GET_LOM_SYSTEMHANDLE(systemHandle), volID);
 	OOSQL_CHECK_ERR(e);
 
+	// cached plans refer to the catalog of the mounted volumes
+	e = OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache->Clear();
+	OOSQL_CHECK_ERR(e);
+
 	return eNOERROR;
 }
 
@@ -76,6 +76,7 @@
 #include "OOSQL_ServerQuery.hxx"
 #include "OOSQL_ExternalFunctionManager.hxx"
 #include "OOSQL_ExternalFunctionDispatcher.hxx"
+#include "OOSQL_PlanCache.hxx"
 
 #ifdef COSMOS_MULTITHREAD
 extern cosmos_thread_mutex_t mutexVar;
@@ -124,6 +125,9 @@ Four OOSQL_DestroySystemHandle(
 	OOSQL_DELETE(OOSQL_GDSINSTTABLE[systemHandle->instanceId].externalFunctionManager);
 	OOSQL_DELETE(OOSQL_GDSINSTTABLE[systemHandle->instanceId].externalFunctionDispatcher);
 
+	// final plan cache
+	OOSQL_DELETE(OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache);
+
 	// final memory manager
 	delete OOSQL_GDSINSTTABLE[systemHandle->instanceId].memoryManager;
 
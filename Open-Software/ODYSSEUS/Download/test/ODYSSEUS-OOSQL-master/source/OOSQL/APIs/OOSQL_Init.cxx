@@ -76,6 +76,7 @@
 #include "OOSQL_ServerQuery.hxx"
 #include "OOSQL_ExternalFunctionManager.hxx"
 #include "OOSQL_ExternalFunctionDispatcher.hxx"
+#include "OOSQL_PlanCache.hxx"
 
 VarArray oosqlGDSInstanceTable;
 
@@ -201,6 +202,9 @@ Four OOSQL_CreateSystemHandle(
 	// init external function manager and dispatcher
 	OOSQL_NEW(OOSQL_GDSINSTTABLE[systemHandle->instanceId].externalFunctionManager, OOSQL_GDSINSTTABLE[systemHandle->instanceId].memoryManager, OOSQL_ExternalFunctionManager(systemHandle));
 	OOSQL_NEW(OOSQL_GDSINSTTABLE[systemHandle->instanceId].externalFunctionDispatcher, OOSQL_GDSINSTTABLE[systemHandle->instanceId].memoryManager, OOSQL_ExternalFunctionDispatcher(systemHandle, OOSQL_GDSINSTTABLE[systemHandle->instanceId].dbInfo));
+
+	// init plan cache
+	OOSQL_NEW(OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache, OOSQL_GDSINSTTABLE[systemHandle->instanceId].memoryManager, OOSQL_PlanCache(OOSQL_PLANCACHE_SIZE));
 	
 	// init OOSQL query instance table
 	e = LOM_initVarArray(&OOSQL_GET_LOM_SYSTEMHANDLE(systemHandle), &OOSQL_GDSINSTTABLE[systemHandle->instanceId].queryInstanceTable, sizeof(OOSQL_QueryInstance), INITQUERYINSTANCETABLE);
@@ -484,6 +484,35 @@ Four OOSQL_EstimateNumResults(
 	return OOSQL_QUERYINSTTABLE(systemHandle)[handle].query->EstimateNumResults(nResults);
 }
 
+/****************************************************************************
+DESCRIPTION:
+	Set the # of threads which evaluate the WHERE condition of a sequential
+	scan of the query. 1 evaluates the query in the calling thread only.
+
+RETURN VALUE:
+eBADPARAMETER_OOSQL 
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_SetDegreeOfParallelism(
+	OOSQL_SystemHandle*		systemHandle,	// IN  
+	OOSQL_Handle			handle,			// IN  
+	Four					degree			// IN  
+)
+{
+	if(!OOSQL_CHECKGDSINSTTABLE(systemHandle))
+		return eBADPARAMETER_OOSQL;
+
+	if(OOSQL_QUERYINSTTABLE(systemHandle)[handle].inUse == SM_FALSE)
+		return eBADPARAMETER_OOSQL;
+
+	if(degree < 1 || degree > OOSQL_PARALLELSCAN_MAXDEGREE)
+		return eBADPARAMETER_OOSQL;
+
+	return OOSQL_QUERYINSTTABLE(systemHandle)[handle].query->SetDegreeOfParallelism(degree);
+}
+
 /****************************************************************************
 DESCRIPTION:
 
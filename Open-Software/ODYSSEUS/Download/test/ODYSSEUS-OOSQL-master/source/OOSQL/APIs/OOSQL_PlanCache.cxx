@@ -0,0 +1,727 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/OOSQL DB-IR-Spatial Tightly-Integrated DBMS                    */
+/*    Version 5.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+
+#include "OOSQL_StorageSystemHeaders.h"
+#include "OOSQL_PlanCache.hxx"
+#include "OOSQL_Compiler.hxx"
+#include "OOSQL_StorageManager.hxx"
+#include "OOSQL_Error.h"
+#include <string.h>
+
+// catalog version shared by the plan caches of all system handles
+static Four oosqlPlanCacheCatalogVersion = 0;
+
+#ifdef COSMOS_MULTITHREAD
+static cosmos_thread_mutex_t planCacheMutex = COSMOS_THREAD_MUTEX_INIT_FOR_INTRAPROCESS;
+#endif
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+OOSQL_PlanCache::OOSQL_PlanCache(
+	Four	capacity		// IN  max. number of cached queries (0 disables the cache)
+)
+{
+	Four	i;
+
+	m_capacity       = capacity;
+	m_nEntries       = 0;
+	for(i = 0; i < OOSQL_PLANCACHE_NBUCKETS; i++)
+		m_buckets[i] = NULL;
+	m_lruHead        = NULL;
+	m_lruTail        = NULL;
+	m_catalogVersion = oosqlPlanCacheCatalogVersion;
+	m_nUnversionedVols = 0;
+	m_ddlInTransaction = SM_FALSE;
+
+	ResetStatistics();
+}
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+OOSQL_PlanCache::~OOSQL_PlanCache()
+{
+	Clear();
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Looks up the compiled query of queryStr. If it is found, it is copied
+	into compiler, which can then make the access plan at once. An entry
+	compiled against an older catalog version of the volume is dropped.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::Lookup(
+	OOSQL_StorageManager*	storageManager,	// IN  
+	Four					volID,			// IN  
+	char*					queryStr,		// IN  
+	OOSQL_Compiler*			compiler,		// INOUT 
+	Boolean*				found			// OUT 
+)
+{
+	Four					e;
+	char*					normalizedStr;
+	UFour					hashValue;
+	Four					catalogVersion;
+	Boolean					isVersioned;
+	OOSQL_PlanCacheEntry*	entry;
+
+	*found = SM_FALSE;
+	if(m_capacity <= 0)
+		return eNOERROR;
+
+	e = CheckCatalogVersion();
+	OOSQL_CHECK_ERR(e);
+
+	e = GetCatalogVersion(storageManager, volID, &catalogVersion, &isVersioned);
+	OOSQL_CHECK_ERR(e);
+
+	if(!isVersioned)
+		return eNOERROR;
+
+	e = NormalizeQueryString(queryStr, &normalizedStr, &hashValue);
+	OOSQL_CHECK_ERR(e);
+
+	entry = Find(volID, normalizedStr, hashValue);
+	pMemoryManager->Free(normalizedStr);
+
+	// the catalog has been changed since the query was compiled
+	if(entry != NULL && entry->m_catalogVersion != catalogVersion)
+	{
+		e = DestroyEntry(entry);
+		OOSQL_CHECK_ERR(e);
+
+		m_nInvalidations ++;
+		entry = NULL;
+	}
+
+	if(entry == NULL)
+	{
+		m_nMisses ++;
+		return eNOERROR;
+	}
+
+	e = compiler->copyCompiledQuery(*entry->m_compiler);
+	OOSQL_CHECK_ERR(e);
+
+	// make the entry the most recently used one
+	Unlink(entry);
+	LinkAtHead(entry);
+
+	m_nHits ++;
+	*found = SM_TRUE;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Stores a copy of the query compiled by compiler. If the cache is full,
+	the least recently used entry is evicted.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::Insert(
+	OOSQL_StorageManager*	storageManager,	// IN  
+	Four					volID,			// IN  
+	char*					queryStr,		// IN  
+	OOSQL_Compiler*			compiler		// IN  
+)
+{
+	Four					e;
+	char*					normalizedStr;
+	UFour					hashValue;
+	Four					catalogVersion;
+	Boolean					isVersioned;
+	OOSQL_PlanCacheEntry*	entry;
+
+	if(m_capacity <= 0)
+		return eNOERROR;
+
+	// the query may have been compiled against an old catalog
+	if(m_catalogVersion != oosqlPlanCacheCatalogVersion)
+	{
+		e = CheckCatalogVersion();
+		OOSQL_CHECK_ERR(e);
+
+		return eNOERROR;
+	}
+
+	e = GetCatalogVersion(storageManager, volID, &catalogVersion, &isVersioned);
+	OOSQL_CHECK_ERR(e);
+
+	if(!isVersioned)
+		return eNOERROR;
+
+	e = NormalizeQueryString(queryStr, &normalizedStr, &hashValue);
+	OOSQL_CHECK_ERR(e);
+
+	entry = Find(volID, normalizedStr, hashValue);
+	if(entry != NULL && entry->m_catalogVersion == catalogVersion)
+	{
+		pMemoryManager->Free(normalizedStr);
+
+		Unlink(entry);
+		LinkAtHead(entry);
+
+		return eNOERROR;
+	}
+
+	if(entry != NULL)
+	{
+		e = DestroyEntry(entry);
+		if(e < eNOERROR)
+		{
+			pMemoryManager->Free(normalizedStr);
+			OOSQL_ERR(e);
+		}
+
+		m_nInvalidations ++;
+	}
+
+	while(m_nEntries >= m_capacity)
+	{
+		e = DestroyEntry(m_lruTail);
+		OOSQL_CHECK_ERR(e);
+
+		m_nEvictions ++;
+	}
+
+	entry = (OOSQL_PlanCacheEntry*)pMemoryManager->Alloc(sizeof(OOSQL_PlanCacheEntry));
+	if(entry == NULL)
+	{
+		pMemoryManager->Free(normalizedStr);
+		OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+	}
+
+	OOSQL_NEW(entry->m_compiler, pMemoryManager, OOSQL_Compiler(volID, NULL, NULL, NULL, NULL));
+	if(entry->m_compiler == NULL)
+	{
+		pMemoryManager->Free(normalizedStr);
+		pMemoryManager->Free(entry);
+		OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+	}
+
+	e = entry->m_compiler->copyCompiledQuery(*compiler);
+	if(e < eNOERROR)
+	{
+		OOSQL_DELETE(entry->m_compiler);
+		pMemoryManager->Free(normalizedStr);
+		pMemoryManager->Free(entry);
+		OOSQL_ERR(e);
+	}
+
+	entry->m_volID          = volID;
+	entry->m_catalogVersion = catalogVersion;
+	entry->m_queryStr       = normalizedStr;
+	entry->m_hashValue      = hashValue;
+
+	entry->m_hashNext  = m_buckets[hashValue % OOSQL_PLANCACHE_NBUCKETS];
+	m_buckets[hashValue % OOSQL_PLANCACHE_NBUCKETS] = entry;
+	LinkAtHead(entry);
+	m_nEntries ++;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Removes all entries of the cache. The volumes found without a catalog
+	version counter are checked again.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::Clear()
+{
+	Four	e;
+
+	while(m_lruHead != NULL)
+	{
+		e = DestroyEntry(m_lruHead);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	m_nUnversionedVols = 0;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Increases the catalog version of volID in the current transaction. If
+	the volume has no version counter yet, it is created. Called after a
+	DDL statement is executed, even if it has failed halfway; the entries
+	of every plan cache in the process are dropped at once.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::IncreaseCatalogVersion(
+	OOSQL_StorageManager*	storageManager,	// IN  
+	Four					volID			// IN  
+)
+{
+	Four	e;
+	Four	catalogVersion;
+
+	m_ddlInTransaction = SM_TRUE;
+
+	e = InvalidateAll();
+	OOSQL_CHECK_ERR(e);
+
+	e = storageManager->CheckSequence(volID, OOSQL_PLANCACHE_VERSIONCOUNTER);
+	if(e == eNOT_FOUND_OOSQL)
+		e = storageManager->CreateSequence(volID, OOSQL_PLANCACHE_VERSIONCOUNTER, 0);
+	OOSQL_CHECK_ERR(e);
+
+	e = storageManager->GetSeqNextVal(volID, OOSQL_PLANCACHE_VERSIONCOUNTER, &catalogVersion);
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Called when the current transaction is committed or aborted. If the
+	aborted transaction has executed DDL, its catalog version is rolled
+	back and may be reached again by other DDL, so the plans compiled
+	against its catalog are dropped.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::EndTransaction(
+	Boolean	isAborted		// IN  
+)
+{
+	Four	e;
+
+	if(isAborted && m_ddlInTransaction)
+	{
+		e = InvalidateAll();
+		OOSQL_CHECK_ERR(e);
+	}
+
+	m_ddlInTransaction = SM_FALSE;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+void OOSQL_PlanCache::ResetStatistics()
+{
+	m_nHits          = 0;
+	m_nMisses        = 0;
+	m_nEvictions     = 0;
+	m_nInvalidations = 0;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Returns SM_TRUE if the compiled query of queryType can be reused.
+	DDL statements are executed only once and are never cached.
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+Boolean OOSQL_PlanCache::IsCacheableQuery(
+	OOSQL_QueryType	queryType		// IN  
+)
+{
+	switch(queryType)
+	{
+	case OOSQL_SELECT_QUERY:
+	case OOSQL_INSERT_QUERY:
+	case OOSQL_INSERT_QUERY_WITH_PARAM:
+	case OOSQL_DELETE_QUERY:
+	case OOSQL_UPDATE_QUERY:
+	case OOSQL_UPDATE_QUERY_WITH_PARAM:
+		return SM_TRUE;
+	default:
+		return SM_FALSE;
+	}
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Returns SM_TRUE if executing a query of queryType may change the catalog.
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+Boolean OOSQL_PlanCache::IsDDLQuery(
+	OOSQL_QueryType	queryType		// IN  
+)
+{
+	switch(queryType)
+	{
+	case OOSQL_SELECT_QUERY:
+	case OOSQL_INSERT_QUERY:
+	case OOSQL_INSERT_QUERY_WITH_PARAM:
+	case OOSQL_DELETE_QUERY:
+	case OOSQL_UPDATE_QUERY:
+	case OOSQL_UPDATE_QUERY_WITH_PARAM:
+	case OOSQL_CALL_PROCEDURE_QUERY:
+		return SM_FALSE;
+	default:
+		return SM_TRUE;
+	}
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Increases the catalog version so that the entries of every plan cache
+	are dropped on their next use. Called after a class or an index is
+	created, altered or dropped.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::InvalidateAll()
+{
+#ifdef COSMOS_MULTITHREAD
+	Four	e;
+
+	e = cosmos_thread_mutex_lock(&planCacheMutex);
+	if (e < eNOERROR) OOSQL_ERR(e);
+#endif
+
+	oosqlPlanCacheCatalogVersion ++;
+
+#ifdef COSMOS_MULTITHREAD
+	e = cosmos_thread_mutex_unlock(&planCacheMutex);
+	if (e < eNOERROR) OOSQL_ERR(e);
+#endif
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Copies queryStr collapsing each run of blanks outside of literals into
+	one space, and computes the hash value of the copy.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::NormalizeQueryString(
+	char*	queryStr,			// IN  
+	char**	normalizedStr,		// OUT 
+	UFour*	hashValue			// OUT 
+)
+{
+	char*	dest;
+	char*	src;
+	char	quote;
+	Boolean	pendingBlank;
+
+	*normalizedStr = (char*)pMemoryManager->Alloc(strlen(queryStr) + 1);
+	if(*normalizedStr == NULL)
+		OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+
+	dest         = *normalizedStr;
+	quote        = '\0';
+	pendingBlank = SM_FALSE;
+	*hashValue   = 0;
+	for(src = queryStr; *src != '\0'; src++)
+	{
+		if(quote == '\0' && (*src == ' ' || *src == '\t' || *src == '\n' || *src == '\r'))
+		{
+			// leading blanks are dropped
+			if(dest != *normalizedStr)
+				pendingBlank = SM_TRUE;
+			continue;
+		}
+
+		if(pendingBlank)
+		{
+			*dest++      = ' ';
+			*hashValue   = *hashValue * 31 + ' ';
+			pendingBlank = SM_FALSE;
+		}
+
+		if(quote == '\0' && (*src == '\'' || *src == '"'))
+			quote = *src;
+		else if(*src == quote)
+			quote = '\0';
+
+		*dest++    = *src;
+		*hashValue = *hashValue * 31 + (unsigned char)*src;
+	}
+	*dest = '\0';
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+the entry of the query, or NULL if it is not cached
+
+IMPLEMENTATION:
+****************************************************************************/
+OOSQL_PlanCacheEntry* OOSQL_PlanCache::Find(
+	Four	volID,				// IN  
+	char*	normalizedStr,		// IN  
+	UFour	hashValue			// IN  
+)
+{
+	OOSQL_PlanCacheEntry*	entry;
+
+	for(entry = m_buckets[hashValue % OOSQL_PLANCACHE_NBUCKETS]; entry != NULL; entry = entry->m_hashNext)
+	{
+		if(entry->m_hashValue == hashValue && entry->m_volID == volID && !strcmp(entry->m_queryStr, normalizedStr))
+			return entry;
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Removes entry from the LRU list.
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+void OOSQL_PlanCache::Unlink(
+	OOSQL_PlanCacheEntry*	entry		// IN  
+)
+{
+	if(entry->m_lruPrev != NULL)
+		entry->m_lruPrev->m_lruNext = entry->m_lruNext;
+	else
+		m_lruHead = entry->m_lruNext;
+
+	if(entry->m_lruNext != NULL)
+		entry->m_lruNext->m_lruPrev = entry->m_lruPrev;
+	else
+		m_lruTail = entry->m_lruPrev;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Puts entry at the head of the LRU list as the most recently used one.
+
+RETURN VALUE:
+
+IMPLEMENTATION:
+****************************************************************************/
+void OOSQL_PlanCache::LinkAtHead(
+	OOSQL_PlanCacheEntry*	entry		// IN  
+)
+{
+	entry->m_lruPrev = NULL;
+	entry->m_lruNext = m_lruHead;
+	if(m_lruHead != NULL)
+		m_lruHead->m_lruPrev = entry;
+	else
+		m_lruTail = entry;
+	m_lruHead = entry;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Removes entry from the hash chain and the LRU list and frees it.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::DestroyEntry(
+	OOSQL_PlanCacheEntry*	entry		// IN  
+)
+{
+	OOSQL_PlanCacheEntry**	link;
+
+	for(link = &m_buckets[entry->m_hashValue % OOSQL_PLANCACHE_NBUCKETS]; *link != entry; link = &(*link)->m_hashNext)
+		;
+	*link = entry->m_hashNext;
+
+	Unlink(entry);
+
+	OOSQL_DELETE(entry->m_compiler);
+	pMemoryManager->Free(entry->m_queryStr);
+	pMemoryManager->Free(entry);
+
+	m_nEntries --;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Drops all entries if DDL has been executed since they were cached.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::CheckCatalogVersion()
+{
+	Four	e;
+
+	if(m_catalogVersion == oosqlPlanCacheCatalogVersion)
+		return eNOERROR;
+
+	m_nInvalidations += m_nEntries;
+
+	e = Clear();
+	OOSQL_CHECK_ERR(e);
+
+	m_catalogVersion = oosqlPlanCacheCatalogVersion;
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Reads the catalog version of volID. isVersioned is SM_FALSE if the
+	volume has no version counter yet; such a volume is remembered until
+	the cache is cleared, so the counter is not searched at every lookup.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_PlanCache::GetCatalogVersion(
+	OOSQL_StorageManager*	storageManager,	// IN  
+	Four					volID,			// IN  
+	Four*					catalogVersion,	// OUT 
+	Boolean*				isVersioned		// OUT 
+)
+{
+	Four	e;
+	Four	i;
+
+	*isVersioned = SM_FALSE;
+
+	for(i = 0; i < m_nUnversionedVols; i++)
+		if(m_unversionedVolIDs[i] == volID)
+			return eNOERROR;
+
+	e = storageManager->CheckSequence(volID, OOSQL_PLANCACHE_VERSIONCOUNTER);
+	if(e == eNOT_FOUND_OOSQL)
+	{
+		if(m_nUnversionedVols < MAXNUMOFVOLS)
+			m_unversionedVolIDs[m_nUnversionedVols++] = volID;
+		return eNOERROR;
+	}
+	OOSQL_CHECK_ERR(e);
+
+	e = storageManager->GetSeqCurrVal(volID, OOSQL_PLANCACHE_VERSIONCOUNTER, catalogVersion);
+	OOSQL_CHECK_ERR(e);
+
+	*isVersioned = SM_TRUE;
+
+	return eNOERROR;
+}
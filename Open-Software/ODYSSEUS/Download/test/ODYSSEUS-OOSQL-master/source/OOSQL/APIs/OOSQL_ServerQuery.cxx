@@ -75,6 +75,7 @@
 #include "OOSQL_AccessPlan.hxx"
 #include "OOSQL_Compiler.hxx"
 #include "OOSQL_Evaluator.hxx"
+#include "OOSQL_PlanCache.hxx"
 #include "OOSQL_Error.h"
 #include <string.h>
 
@@ -103,6 +104,7 @@ OOSQL_ServerQuery::OOSQL_ServerQuery(OOSQL_ExternalFunctionManager* externalFunc
 	m_errorMessage					= NULL;
 	m_externalFunctionManager		= externalFunctionManager;
 	m_externalFunctionDispatcher	= externalFunctionDispatcher;
+	m_degreeOfParallelism			= OOSQL_PARALLELSCAN_DEGREE;
 }
 
 /****************************************************************************
@@ -232,6 +234,8 @@ Four OOSQL_ServerQuery::Prepare(char* stmtText, OOSQL_SortBufferInfo* sortBuffer
 {
 	Four	e;		// error code
 	Four	_e;
+	OOSQL_PlanCache* planCache;
+	Boolean	isCached;
 
 	// check if Execute() is called since this instance has been created
 	if(m_status == OOSQL_NOTREADY) 
@@ -245,6 +249,7 @@ Four OOSQL_ServerQuery::Prepare(char* stmtText, OOSQL_SortBufferInfo* sortBuffer
 		OOSQL_NEW(m_evaluator, pMemoryManager, OOSQL_Evaluator(m_storageManager, m_catalog, m_errorMessage, 
 			                                                   m_externalFunctionManager, m_externalFunctionDispatcher,
 															   m_transID, m_volID));
+		m_evaluator->SetDegreeOfParallelism(m_degreeOfParallelism);
 
 	    // initialize OOSQL m_status
 	    m_status = OOSQL_READY;
@@ -263,6 +268,7 @@ Four OOSQL_ServerQuery::Prepare(char* stmtText, OOSQL_SortBufferInfo* sortBuffer
 		OOSQL_NEW(m_evaluator, pMemoryManager, OOSQL_Evaluator(m_storageManager, m_catalog, m_errorMessage, 
 			                                                   m_externalFunctionManager, m_externalFunctionDispatcher,
 															   m_transID, m_volID));
+		m_evaluator->SetDegreeOfParallelism(m_degreeOfParallelism);
 
 		e = m_compiler->ReInit();
 		if(e < eNOERROR) OOSQL_ERR(e);
@@ -272,39 +278,59 @@ Four OOSQL_ServerQuery::Prepare(char* stmtText, OOSQL_SortBufferInfo* sortBuffer
 		m_accessPlan = NULL;
 	}
 
-	// compile query: 
-	//	1. syntactic analysis
-	//	2. semantic analysis & global data structure generation
-	//	3. access plan generation
-	// step 1. do syntactic analysis
+	// reuse the compiled query if the same statement has been prepared before
+	planCache = OOSQL_GDSINSTTABLE[m_oosqlSystemHandle->instanceId].planCache;
+	e = planCache->Lookup(m_storageManager, m_volID, stmtText, m_compiler, &isCached);
+	if (e < eNOERROR) OOSQL_ERR(e);
+
+	if(isCached)
+	{
+		e = m_compiler->makeAccessPlan(m_accessPlan);
+		if (e < eNOERROR) OOSQL_ERR(e);
+	}
+	else
+	{
+		// compile query: 
+		//	1. syntactic analysis
+		//	2. semantic analysis & global data structure generation
+		//	3. access plan generation
+		// step 1. do syntactic analysis
 
 #ifdef COSMOS_MULTITHREAD
-    _e = cosmos_thread_mutex_lock(&mutexVar2);
-    if (_e < eNOERROR) OOSQL_ERR(_e);
+	    _e = cosmos_thread_mutex_lock(&mutexVar2);
+	    if (_e < eNOERROR) OOSQL_ERR(_e);
 #endif
 
-	e = m_compiler->parse(stmtText);
-	if (e < eNOERROR) 
-	{
+		e = m_compiler->parse(stmtText);
+		if (e < eNOERROR) 
+		{
 #ifdef COSMOS_MULTITHREAD
-        _e = cosmos_thread_mutex_unlock(&mutexVar2);
-        if (_e < eNOERROR) OOSQL_ERR(_e);
+	        _e = cosmos_thread_mutex_unlock(&mutexVar2);
+	        if (_e < eNOERROR) OOSQL_ERR(_e);
 #endif
-		OOSQL_ERR(e);
-	}
+			OOSQL_ERR(e);
+		}
 
 #ifdef COSMOS_MULTITHREAD
-    _e = cosmos_thread_mutex_unlock(&mutexVar2);
-    if (_e < eNOERROR) OOSQL_ERR(_e);
+	    _e = cosmos_thread_mutex_unlock(&mutexVar2);
+	    if (_e < eNOERROR) OOSQL_ERR(_e);
 #endif
 
-	// step 2. do semantic analysis and generate global data structures
-	e = m_compiler->smtChkAndGenGDS();
-	if (e < eNOERROR) OOSQL_ERR(e);
+		// step 2. do semantic analysis and generate global data structures
+		e = m_compiler->smtChkAndGenGDS();
+		if (e < eNOERROR) OOSQL_ERR(e);
 
-	// step 3. generate access plan
-	e = m_compiler->genAccessPlan(m_accessPlan);
-	if (e < eNOERROR) OOSQL_ERR(e);
+		// step 3. generate access plan
+		e = m_compiler->genAccessPlan(m_accessPlan);
+		if (e < eNOERROR) OOSQL_ERR(e);
+
+		// keep the compiled query before the evaluator modifies its pools
+		if(OOSQL_PlanCache::IsCacheableQuery(m_compiler->GetQueryType()))
+		{
+			e = planCache->Insert(m_storageManager, m_volID, stmtText, m_compiler);
+			if (e < eNOERROR) OOSQL_ERR(e);
+		}
+	}
 
 	// change the m_status information
 	m_status    = OOSQL_COMPILED;
@@ -373,6 +399,15 @@ Four OOSQL_ServerQuery::Execute(Four nEvaluationsToDo, void* headerBuffer, Four
 		OOSQL_ERR(eNOTCOMPILED_OOSQL);
 
 	e = m_evaluator->EvalAndFetch(nEvaluationsToDo, headerBuffer, headerBufferSize, dataBuffer, dataBufferSize, nEvaluationsDone);
+
+	// DDL makes the cached plans of every process obsolete, even if it
+	// has failed halfway; the error of the DDL is reported first
+	if(OOSQL_PlanCache::IsDDLQuery(m_queryType))
+	{
+		Four e2 = OOSQL_GDSINSTTABLE[m_oosqlSystemHandle->instanceId].planCache->IncreaseCatalogVersion(m_storageManager, m_volID);
+		if (e >= eNOERROR && e2 < eNOERROR) OOSQL_ERR(e2);
+	}
+
 	if (e < eNOERROR) OOSQL_ERR(e);
 
 	return e;
@@ -654,3 +689,14 @@ Four OOSQL_ServerQuery::EstimateNumResults(Four* nResults)
 
 	return eNOERROR;
 }
+
+Four OOSQL_ServerQuery::SetDegreeOfParallelism(Four degree)
+{
+	m_degreeOfParallelism = degree;
+
+	// the degree takes effect on the scans opened from now on
+	if (m_evaluator)
+		m_evaluator->SetDegreeOfParallelism(degree);
+
+	return eNOERROR;
+}
@@ -73,6 +73,7 @@
 #include "OOSQL_StorageSystemHeaders.h"
 #include "OOSQL_APIs_Internal.hxx"
 #include "OOSQL_Error.h"
+#include "OOSQL_PlanCache.hxx"
 
 /****************************************************************************
 DESCRIPTION:
@@ -234,3 +235,55 @@ Four OOSQL_GetNumObjectsInClass(
 
 	return eNOERROR;
 }
+
+/****************************************************************************
+DESCRIPTION:
+	Returns the hit/miss statistics of the plan cache of the system handle.
+
+RETURN VALUE:
+eBADPARAMETER_OOSQL 
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_GetPlanCacheStatistics(
+	OOSQL_SystemHandle*			systemHandle,	// IN  
+	OOSQL_PlanCacheStatistics*	statistics		// OUT 
+)
+{
+	OOSQL_PlanCache*	planCache;
+
+	if(!OOSQL_CHECKGDSINSTTABLE(systemHandle) || statistics == NULL)
+		return eBADPARAMETER_OOSQL;
+
+	planCache = OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache;
+
+	statistics->nEntries       = planCache->GetNumEntries();
+	statistics->nHits          = planCache->GetNumHits();
+	statistics->nMisses        = planCache->GetNumMisses();
+	statistics->nEvictions     = planCache->GetNumEvictions();
+	statistics->nInvalidations = planCache->GetNumInvalidations();
+
+	return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+eBADPARAMETER_OOSQL 
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_ResetPlanCacheStatistics(
+	OOSQL_SystemHandle*	systemHandle	// IN  
+)
+{
+	if(!OOSQL_CHECKGDSINSTTABLE(systemHandle))
+		return eBADPARAMETER_OOSQL;
+
+	OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache->ResetStatistics();
+
+	return eNOERROR;
+}
@@ -74,6 +74,7 @@
 #include "OOSQL_APIs_Internal.hxx"
 #include "OOSQL_Error.h"
 #include "OOSQL_ServerQuery.hxx"
+#include "OOSQL_PlanCache.hxx"
 
 /****************************************************************************
 DESCRIPTION:
@@ -130,6 +131,9 @@ Four OOSQL_TransCommit(
 	e =  LOM_TransCommit(&OOSQL_GET_LOM_SYSTEMHANDLE(systemHandle), xactId);
 	OOSQL_CHECK_ERR(e);
 
+	e = OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache->EndTransaction(SM_FALSE);
+	OOSQL_CHECK_ERR(e);
+
 	return eNOERROR;
 }
 
@@ -149,6 +153,7 @@ Four OOSQL_TransAbort(
 {
 	Four i;
 	Four e;
+	Four e2;
 
 	if(!OOSQL_CHECKGDSINSTTABLE(systemHandle))
 		return eBADPARAMETER_OOSQL;
@@ -163,5 +168,13 @@ Four OOSQL_TransAbort(
 		}
 	}
 
-	return LOM_TransAbort(&OOSQL_GET_LOM_SYSTEMHANDLE(systemHandle), xactId);
+	e = LOM_TransAbort(&OOSQL_GET_LOM_SYSTEMHANDLE(systemHandle), xactId);
+
+	// the plans compiled against the catalog changed by the transaction are
+	// dropped even if the abort has failed
+	e2 = OOSQL_GDSINSTTABLE[systemHandle->instanceId].planCache->EndTransaction(SM_TRUE);
+	OOSQL_CHECK_ERR(e);
+	OOSQL_CHECK_ERR(e2);
+
+	return eNOERROR;
 }
@@ -314,7 +314,6 @@ Four OOSQL_Compiler::genAccessPlan(
 )
 {
     Four 	      					e;
-    CommonAP_PoolElements			accessPlan(m_pool->commonAP_Pool);
 	Four							i;
 	AP_ProjectionListPoolElements	projList;
 	AP_ProjectionPoolElements		projection;
@@ -373,6 +372,30 @@ Four OOSQL_Compiler::genAccessPlan(
 	}
 
     // convert m_commonAP to oosql_accessPlan
+    e = makeAccessPlan(oosql_accessPlan);
+    OOSQL_CHECK_ERR(e);
+
+    return eNOERROR;
+}
+
+/****************************************************************************
+DESCRIPTION:
+	Creates an OOSQL_AccessPlan object over the pools of the compiled query.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_Compiler::makeAccessPlan(
+	OOSQL_AccessPlan*& oosql_accessPlan		// OUT Access Plan
+)
+{
+    CommonAP_PoolElements			accessPlan(m_pool->commonAP_Pool);
+
+    if(m_status != GDS_TO_PLAN)
+        return -1; // some valid error code....
+
     // create OOSQL_AccessPlan object
     accessPlan = m_commonAP->commonAP;
     OOSQL_NEW(oosql_accessPlan, pMemoryManager, OOSQL_AccessPlan(accessPlan, m_storageManager, m_catalog,
@@ -408,6 +431,70 @@ Four OOSQL_Compiler::genAccessPlan(
     return eNOERROR;
 }
 
+/****************************************************************************
+DESCRIPTION:
+	Makes this compiler hold the same compiled query as source, as if the
+	query had been compiled here. The syntax tree is not copied, so only
+	makeAccessPlan() and the result/query type accessors may be used after.
+
+RETURN VALUE:
+eBADPARAMETER_OOSQL 
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OOSQL_Compiler::copyCompiledQuery(
+	OOSQL_Compiler& source		// IN  
+)
+{
+	Four	e;
+	Four	i;
+
+	if(source.m_status != GDS_TO_PLAN)
+		OOSQL_ERR(eBADPARAMETER_OOSQL);
+
+	destroyObjects();
+
+	OOSQL_NEW(m_gds, pMemoryManager, OQL_GDS);
+	OOSQL_NEW(m_pool, pMemoryManager, OQL_GDSPOOL);
+	OOSQL_NEW(m_commonAP, pMemoryManager, OQL_CommonAP);
+	if(m_gds == NULL || m_pool == NULL || m_commonAP == NULL)
+		OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+
+	e = m_gds->copyFrom(*source.m_gds);
+	OOSQL_CHECK_ERR(e);
+
+	e = m_pool->copyFrom(*source.m_pool);
+	OOSQL_CHECK_ERR(e);
+
+	m_commonAP->commonAP = source.m_commonAP->commonAP;
+
+	// copy query result informations
+	if(source.m_nResultColumns > 0)
+	{
+		m_resultTypes = (Four*)pMemoryManager->Alloc(sizeof(Four) * source.m_nResultColumns);
+		if(m_resultTypes == NULL)
+			OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+		m_resultNames = (char**)pMemoryManager->Alloc(sizeof(char*) * source.m_nResultColumns);
+		if(m_resultNames == NULL)
+			OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+
+		for(i = 0; i < source.m_nResultColumns; i++)
+		{
+			m_resultTypes[i] = source.m_resultTypes[i];
+			m_resultNames[i] = (char*)pMemoryManager->Alloc(strlen(source.m_resultNames[i]) + 1);
+			if(m_resultNames[i] == NULL)
+				OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+			strcpy(m_resultNames[i], source.m_resultNames[i]);
+			m_nResultColumns = i + 1;
+		}
+	}
+
+	m_status = GDS_TO_PLAN;
+
+	return eNOERROR;
+}
+
 /****************************************************************************
 DESCRIPTION:
 
@@ -8257,6 +8257,7 @@ Four OQL_ASTtoGDS::smtChkClLim(
 
 	lcElements = m_pool->limitClausePool.addNewEntry();
 
+	lcElements[0].limitStart = 0;
 	lcElements[0].limitCount = limitValue1;
 	limitClause.setPoolIndex(0, 1);
 	e = m_gds->setLimitClause(m_pool, limitClause);
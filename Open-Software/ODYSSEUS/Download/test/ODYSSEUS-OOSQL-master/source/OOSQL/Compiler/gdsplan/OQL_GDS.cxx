@@ -95,6 +95,41 @@ IMPLEMENTATION:
 OQL_GDS::~OQL_GDS()
 {}
 
+/****************************************************************************
+DESCRIPTION:
+	Copies the query type and the pool indexes of source. The pools they
+	refer to must be copied separately (see OQL_GDSPOOL::copyFrom).
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OQL_GDS::copyFrom(OQL_GDS& source)
+{
+	queryType = source.queryType;
+	switch(queryType)
+	{
+	case OQL_GDS::SELECT_QUERY:
+		selectQuery = source.selectQuery;
+		break;
+	case OQL_GDS::UPDATE_QUERY:
+		updateQuery = source.updateQuery;
+		break;
+	case OQL_GDS::INSERT_QUERY:
+		insertQuery = source.insertQuery;
+		break;
+	case OQL_GDS::DELETE_QUERY:
+		deleteQuery = source.deleteQuery;
+		break;
+	default:
+		break;
+	}
+	m_unusedConditionList = source.m_unusedConditionList;
+
+	return eNOERROR;
+}
+
 /****************************************************************************
 DESCRIPTION:
 
@@ -155,6 +155,87 @@ OQL_GDSPOOL::~OQL_GDSPOOL()
 {
 }
 
+/****************************************************************************
+DESCRIPTION:
+	Copies every pool of source into this object so that the pool indexes
+	kept in a compiled access plan remain valid against this object.
+
+RETURN VALUE:
+< eNOERROR          
+
+IMPLEMENTATION:
+****************************************************************************/
+Four OQL_GDSPOOL::copyFrom(
+	OQL_GDSPOOL& source		// IN  
+)
+{
+    Four e;
+
+    e = selectQueryPool.copyFrom(source.selectQueryPool);    OOSQL_CHECK_ERR(e);
+    e = updateQueryPool.copyFrom(source.updateQueryPool);    OOSQL_CHECK_ERR(e);
+    e = insertQueryPool.copyFrom(source.insertQueryPool);    OOSQL_CHECK_ERR(e);
+    e = deleteQueryPool.copyFrom(source.deleteQueryPool);    OOSQL_CHECK_ERR(e);
+    e = selListPool.copyFrom(source.selListPool);        OOSQL_CHECK_ERR(e);
+    e = targetListPool.copyFrom(source.targetListPool);     OOSQL_CHECK_ERR(e);
+    e = exprPool.copyFrom(source.exprPool);           OOSQL_CHECK_ERR(e);
+    e = groupByListPool.copyFrom(source.groupByListPool);    OOSQL_CHECK_ERR(e);
+    e = orderByListPool.copyFrom(source.orderByListPool);    OOSQL_CHECK_ERR(e);
+    e = qgNodePool.copyFrom(source.qgNodePool);         OOSQL_CHECK_ERR(e);
+    e = pathExprPool.copyFrom(source.pathExprPool);       OOSQL_CHECK_ERR(e);
+    e = argumentPool.copyFrom(source.argumentPool);       OOSQL_CHECK_ERR(e);
+    e = structurePool.copyFrom(source.structurePool);      OOSQL_CHECK_ERR(e);
+    e = valuePool.copyFrom(source.valuePool);          OOSQL_CHECK_ERR(e);
+    e = intPool.copyFrom(source.intPool);            OOSQL_CHECK_ERR(e);
+    e = realPool.copyFrom(source.realPool);           OOSQL_CHECK_ERR(e);
+    e = stringPool.copyFrom(source.stringPool);         OOSQL_CHECK_ERR(e);
+    e = stringIndexPool.copyFrom(source.stringIndexPool);    OOSQL_CHECK_ERR(e);
+    e = funcPool.copyFrom(source.funcPool);           OOSQL_CHECK_ERR(e);
+    e = aggrFuncPool.copyFrom(source.aggrFuncPool);       OOSQL_CHECK_ERR(e);
+    e = collectionPool.copyFrom(source.collectionPool);     OOSQL_CHECK_ERR(e);
+    e = domainPool.copyFrom(source.domainPool);         OOSQL_CHECK_ERR(e);
+    e = mbrPool.copyFrom(source.mbrPool);            OOSQL_CHECK_ERR(e);
+    e = objectPool.copyFrom(source.objectPool);         OOSQL_CHECK_ERR(e);
+    e = memberPool.copyFrom(source.memberPool);         OOSQL_CHECK_ERR(e);
+    e = subClassPool.copyFrom(source.subClassPool);       OOSQL_CHECK_ERR(e);
+    e = joinInfoPool.copyFrom(source.joinInfoPool);       OOSQL_CHECK_ERR(e);
+    e = pathExprInfoPool.copyFrom(source.pathExprInfoPool);   OOSQL_CHECK_ERR(e);
+    e = condInfoPool.copyFrom(source.condInfoPool);       OOSQL_CHECK_ERR(e);
+    e = constructPool.copyFrom(source.constructPool);      OOSQL_CHECK_ERR(e);
+    e = datePool.copyFrom(source.datePool);           OOSQL_CHECK_ERR(e);
+    e = timePool.copyFrom(source.timePool);           OOSQL_CHECK_ERR(e);
+    e = timestampPool.copyFrom(source.timestampPool);      OOSQL_CHECK_ERR(e);
+    e = intervalPool.copyFrom(source.intervalPool);       OOSQL_CHECK_ERR(e);
+    e = insertValuePool.copyFrom(source.insertValuePool);    OOSQL_CHECK_ERR(e);
+    e = updateValuePool.copyFrom(source.updateValuePool);    OOSQL_CHECK_ERR(e);
+    e = colNoMapPool.copyFrom(source.colNoMapPool);       OOSQL_CHECK_ERR(e);
+    e = usedColPool.copyFrom(source.usedColPool);        OOSQL_CHECK_ERR(e);
+    e = methodNoMapPool.copyFrom(source.methodNoMapPool);    OOSQL_CHECK_ERR(e);
+    e = usedMethodPool.copyFrom(source.usedMethodPool);     OOSQL_CHECK_ERR(e);
+    e = projectionPool.copyFrom(source.projectionPool);     OOSQL_CHECK_ERR(e);
+    e = ap_condListPool.copyFrom(source.ap_condListPool);    OOSQL_CHECK_ERR(e);
+    e = ap_exprPool.copyFrom(source.ap_exprPool);        OOSQL_CHECK_ERR(e);
+    e = ap_argumentPool.copyFrom(source.ap_argumentPool);    OOSQL_CHECK_ERR(e);
+    e = ap_aggrFuncPool.copyFrom(source.ap_aggrFuncPool);    OOSQL_CHECK_ERR(e);
+    e = projectionListPool.copyFrom(source.projectionListPool); OOSQL_CHECK_ERR(e);
+    e = tempFileInfoPool.copyFrom(source.tempFileInfoPool);   OOSQL_CHECK_ERR(e);
+    e = indexInfoPool.copyFrom(source.indexInfoPool);      OOSQL_CHECK_ERR(e);
+    e = textIndexCondPool.copyFrom(source.textIndexCondPool);  OOSQL_CHECK_ERR(e);
+    e = ap_insertValuePool.copyFrom(source.ap_insertValuePool); OOSQL_CHECK_ERR(e);
+    e = ap_updateValuePool.copyFrom(source.ap_updateValuePool); OOSQL_CHECK_ERR(e);
+    e = commonAP_Pool.copyFrom(source.commonAP_Pool);      OOSQL_CHECK_ERR(e);
+    e = clientAP_Pool.copyFrom(source.clientAP_Pool);      OOSQL_CHECK_ERR(e);
+    e = attributeInfoPool.copyFrom(source.attributeInfoPool);  OOSQL_CHECK_ERR(e);
+    e = methodInfoPool.copyFrom(source.methodInfoPool);     OOSQL_CHECK_ERR(e);
+    e = keyInfoPool.copyFrom(source.keyInfoPool);        OOSQL_CHECK_ERR(e);
+    e = dbCommandPool.copyFrom(source.dbCommandPool);      OOSQL_CHECK_ERR(e);
+    e = superClassPool.copyFrom(source.superClassPool);     OOSQL_CHECK_ERR(e);
+    e = argumentTypePool.copyFrom(source.argumentTypePool);   OOSQL_CHECK_ERR(e);
+    e = ap_boolExprPool.copyFrom(source.ap_boolExprPool);    OOSQL_CHECK_ERR(e);
+    e = limitClausePool.copyFrom(source.limitClausePool);    OOSQL_CHECK_ERR(e);
+
+    return eNOERROR;
+}
+
 /****************************************************************************
 DESCRIPTION:
 
@@ -1874,7 +1874,12 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod(Four currentPlanNo, Four cl
 		break;
 
     default:
+        // no index is applicable, use the hash join for an equi-join predicate
         accessMethod = CAP_ACCESSMETHOD_SEQSCAN;
+        e = makePlan_determineScanMethod_HashJoin(currentPlanNo, classId, conds, indexInfoPoolIndex);
+        OOSQL_CHECK_ERR(e);
+        if(e == SM_TRUE)
+            accessMethod = CAP_ACCESSMETHOD_HASHJOIN;
         break;
     }
 
@@ -3132,6 +3137,9 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod_MlgfMbrScan(Four currentPla
 				indexInfo[0].scan.boolExprs.setNull();
 				indexInfo[0].scan.nCols         = 0;
 
+				e = m_catalog->attr_AttrInfo_to_ColNo(classInfo, attrInfo, indexInfo[0].scan.colNo);
+				OOSQL_CHECK_ERR(e);
+
 				OperatorID spatialOp;
 				if(expr[0].oper.operatorId == OP_OGIS_CONTAINS)
 					spatialOp = OP_GEO_CONTAIN;
@@ -3283,6 +3291,9 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod_MlgfMbrScan(Four currentPla
 					indexInfo[0].scan.boolExprs.setNull();
 					indexInfo[0].scan.nCols         = 0;
 					
+					e = m_catalog->attr_AttrInfo_to_ColNo(classInfo, attrInfo, indexInfo[0].scan.colNo);
+					OOSQL_CHECK_ERR(e);
+					
                     // determine start bound and stop bound
                     if(operandSwapped)
                     {   
@@ -3380,6 +3391,9 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod_MlgfMbrJoin(Four currentPla
 			indexInfo[0].scan.boolExprs.setNull();
 			indexInfo[0].scan.nCols         = 0;
 
+			e = m_catalog->attr_AttrInfo_to_ColNo(classInfo, attrInfo, indexInfo[0].scan.colNo);
+			OOSQL_CHECK_ERR(e);
+
             OperatorID spatialOp;
             if(expr[0].oper.operatorId == OP_OGIS_CONTAINS)
                 spatialOp = OP_GEO_CONTAIN;
@@ -3525,6 +3539,9 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod_MlgfMbrJoin(Four currentPla
                         indexInfo[0].scan.boolExprs.setNull();
 						indexInfo[0].scan.nCols     = 0;
 
+						e = m_catalog->attr_AttrInfo_to_ColNo(classInfo, attrInfo, indexInfo[0].scan.colNo);
+						OOSQL_CHECK_ERR(e);
+
                         // determine start bound and stop bound
 						if(operandSwapped)
 						{   
@@ -3560,6 +3577,99 @@ Four OQL_GDStoCommonAP::makePlan_determineScanMethod_MlgfMbrJoin(Four currentPla
     return SM_FALSE;
 }
 
+Four OQL_GDStoCommonAP::makePlan_determineScanMethod_HashJoin(Four currentPlanNo, Four classId, AP_CondListPoolElements conds, 
+                                                              AP_IndexInfoPoolIndex& indexInfoPoolIndex)
+{
+    AP_ExprPoolElements         expr(m_pool->ap_exprPool);
+    AP_ExprPoolElements         operand1(m_pool->ap_exprPool), operand2(m_pool->ap_exprPool);
+    AP_ExprPoolIndex            outerKey;
+    AP_IndexInfoPoolElements    indexInfo(m_pool->indexInfoPool);
+    CataClassInfo               classInfo;
+    CataAttrInfo                attrInfo;
+    TypeID                      innerType, outerType;
+    Boolean                     innerIsNumber, outerIsNumber;
+    Four                        i;
+    Four                        e;
+
+    // the inner class is read once into a hash table, so it should not be changed by the query
+    if(m_gds->queryType != OQL_GDS::SELECT_QUERY)
+        return SM_FALSE;
+
+    for(i = 0; i < conds.size; i++)
+    {
+        // check if the condition is an equi-join predicate between the current class and an outer class
+        expr = conds[i].expr;
+        if(expr[0].exprKind != EXPR_KIND_OPER || expr[0].oper.operatorId != OP_EQ)
+            continue;
+
+        operand1 = expr[0].oper.operand1;
+        operand2 = expr[0].oper.operand2;
+        outerKey = expr[0].oper.operand2;
+        if(operand1[0].exprKind != EXPR_KIND_PATHEXPR || operand2[0].exprKind != EXPR_KIND_PATHEXPR)
+            continue;
+        if(operand1[0].pathExpr.kind != PATHEXPR_KIND_ATTR || operand2[0].pathExpr.kind != PATHEXPR_KIND_ATTR)
+            continue;
+
+        if(currentPlanNo == operand2[0].pathExpr.col.planNo)
+        {   // swap operand1 and operand2
+            operand1 = expr[0].oper.operand2;
+            operand2 = expr[0].oper.operand1;
+            outerKey = expr[0].oper.operand1;
+        }
+
+        // the outer key should be bound before the current class is accessed
+        if(operand1[0].pathExpr.col.planNo != currentPlanNo || operand2[0].pathExpr.col.planNo >= currentPlanNo)
+            continue;
+
+        // only numbers and strings are hashed
+        innerType = operand1[0].resultType;
+        outerType = operand2[0].resultType;
+
+        innerIsNumber = (innerType == TYPEID_SHORT || innerType == TYPEID_INT    || innerType == TYPEID_LONG ||
+                         innerType == TYPEID_LONG_LONG || innerType == TYPEID_FLOAT || innerType == TYPEID_DOUBLE) ? SM_TRUE : SM_FALSE;
+        outerIsNumber = (outerType == TYPEID_SHORT || outerType == TYPEID_INT    || outerType == TYPEID_LONG ||
+                         outerType == TYPEID_LONG_LONG || outerType == TYPEID_FLOAT || outerType == TYPEID_DOUBLE) ? SM_TRUE : SM_FALSE;
+
+        if(!(innerIsNumber && outerIsNumber) &&
+           !((innerType == TYPEID_STRING || innerType == TYPEID_VARSTRING) && 
+             (outerType == TYPEID_STRING || outerType == TYPEID_VARSTRING)))
+            continue;
+
+        // a B+ tree index on the join column is better than the hash join
+        e = m_catalog->class_ClassId_to_ClassInfo(classId, classInfo);
+        OOSQL_CHECK_ERR(e);
+
+        e = m_catalog->attr_ColNo_to_AttrInfo(classInfo, operand1[0].pathExpr.col.colNo, attrInfo);
+        OOSQL_CHECK_ERR(e);
+
+        e = m_catalog->index_isB_TreeIndexExist(classInfo, attrInfo);
+        OOSQL_CHECK_ERR(e);
+        if(e == SM_TRUE)
+            continue;
+
+        // make indexInfo
+        indexInfo                       = m_pool->indexInfoPool.addNewEntry();
+        indexInfoPoolIndex              = indexInfo.getPoolIndex();
+        indexInfo[0].nodeKind           = INDEXINFO_SCAN;
+        indexInfo[0].scan.classId       = classId;
+        indexInfo[0].scan.indexType     = INDEXTYPE_NONE;
+        indexInfo[0].scan.boolExprs.setNull();
+        indexInfo[0].scan.readObjectValueFromIndexFlag = SM_FALSE;
+        indexInfo[0].scan.nCols         = 0;
+
+        e = m_catalog->attr_AttrInfo_to_ColNo(classInfo, attrInfo, indexInfo[0].scan.colNo);
+        OOSQL_CHECK_ERR(e);
+
+        indexInfo[0].scan.hash.outerKey = outerKey;
+        indexInfo[0].scan.hash.keyType  = innerType;
+
+        // the original condition list is used as refinement
+        return SM_TRUE;
+    }
+
+    return SM_FALSE;
+}
+
 Four OQL_GDStoCommonAP::makePlan_determineScanMethod_TextScan_MakeIndexNode(Four currentPlanNo, Four classId, Four operand1_indexType, Four operand2_indexType, 
 																			AP_ExprPoolElements& expr, AP_IndexInfoPoolIndex& indexInfoPoolIndex, 
 																			Boolean& isCurrentCondsInBoundConds)
@@ -5383,6 +5493,7 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
     Four                            i, j;   // loop counter
     Four                            index;  // loop counter
     Four                            nGrpByKeys;
+    One                             hashAggrFlag;
     Four                            e;      // error code
     ExprPoolElements                havingCond(m_pool->exprPool);
     ExprPoolElements                expr(m_pool->exprPool);
@@ -5422,6 +5533,10 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
     // connect projection with accessplan
     apNode[0].projectionList = projectionList.getPoolIndex();
 
+    // aggr function with DISTINCT needs its arguments sorted within each group,
+    // so groups can be made by hashing only if there is none
+    hashAggrFlag = (projectionList.size == 1) ? SM_TRUE : SM_FALSE;
+
     // count tempFileInfo length for group by (for projectionList[0]) and allocate
     // length = groupby pathexpr elements + selList pathExpr or aggrfunc elements without DISTINCT 
     length = 0;
@@ -5550,6 +5665,10 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
             {
                 argument = aggrFunc[0].argument;
                 e = makePlan_constructTempFileInfo(tempFileInfo[index], projectionInfo[index], argument[0]);
+                OOSQL_CHECK_ERR(e);
+
+                if(!makePlan_isHashableAggrFunc(aggrFunc[0], tempFileInfo[index]))
+                    hashAggrFlag = SM_FALSE;
             }
             else
                 e = makePlan_constructTempFileInfo(tempFileInfo[index], projectionInfo[index], selList[i]);
@@ -5625,6 +5744,9 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
                 e = makePlan_constructTempFileInfo(tempFileInfo[index], projectionInfo[index], argument[0]);
                 OOSQL_CHECK_ERR(e);
 
+                if(!makePlan_isHashableAggrFunc(aggrFunc[0], tempFileInfo[index]))
+                    hashAggrFlag = SM_FALSE;
+
                 index++;
                 break;
             case EXPR_KIND_FUNCTION:
@@ -5657,6 +5779,9 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
 			e = makePlan_constructTempFileInfo(tempFileInfo[index], projectionInfo[index], argument[0]);
 			OOSQL_CHECK_ERR(e);
 
+			if(!makePlan_isHashableAggrFunc(aggrFunc[0], tempFileInfo[index]))
+				hashAggrFlag = SM_FALSE;
+
 			index++;
 			break;
 		case ORDERBYLIST_KIND_FUNC:
@@ -5753,6 +5878,20 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
     for(i = 0; i < nGrpByKeys; i++)
         apNode[0].grpByKeys[i] = i;
 
+    // make groups by hashing if few groups are expected.
+    // then the temporary file for group by need not be sorted
+    // NOTE: ORDER BY is processed by its own plan element, so the result order is kept
+    if(hashAggrFlag)
+    {
+        e = makePlan_isFewGroups(groupByList, tempFileInfo);
+        OOSQL_CHECK_ERR(e);
+        if(e == SM_TRUE)
+        {
+            apNode[0].hashAggrFlag      = SM_TRUE;
+            projectionList[0].nSortKeys = 0;
+        }
+    }
+
     // set m_aggrFuncInfo_planNo
     if(m_aggrFuncInfo_planNo == NULL_POOLINDEX)
     {
@@ -5790,6 +5929,73 @@ Four OQL_GDStoCommonAP::makePlan_constructGroupByHaving()
     return eNOERROR;
 }
 
+One OQL_GDStoCommonAP::makePlan_isHashableAggrFunc(AggrFuncElement& aggrFunc, AP_TempFileInfoElement& tempFileInfo)
+{
+    // MIN and MAX of a string refer to the input object instead of copying it,
+    // so they are evaluated only on the sorted groups
+    if(aggrFunc.aggrFunctionID == AGGRFUNC_MIN || aggrFunc.aggrFunctionID == AGGRFUNC_MAX)
+    {
+        if(tempFileInfo.typeId == TYPEID_STRING || tempFileInfo.typeId == TYPEID_VARSTRING)
+            return SM_FALSE;
+    }
+
+    return SM_TRUE;
+}
+
+Four OQL_GDStoCommonAP::makePlan_isFewGroups(GroupByListPoolElements& groupByList, AP_TempFileInfoPoolElements& tempFileInfo)
+{
+    PathExprPoolElements            pathExpr(m_pool->pathExprPool);
+    OOSQL_StorageManager::IndexID   indexId_array[OOSQL_HASHAGGR_MAXNINDEXES];
+    OOSQL_StorageManager::KeyDesc   btreeKeyDesc;
+    CataIndexInfo                   cataIndexInfo;
+    Four                            nIndexes;
+    Four                            lastElemIndex;
+    Four                            i, j;
+    Four                            e;
+
+    // text is not hashed
+    for(i = 0; i < tempFileInfo.size; i++)
+    {
+        if(tempFileInfo[i].typeId == TYPEID_TEXT)
+            return SM_FALSE;
+    }
+
+    // there is no statistics about the number of distinct values, so
+    // we expect few groups unless a group by key is unique by itself
+    for(i = 0; i < groupByList.size; i++)
+    {
+        if(groupByList[i].grpByKeyKind != GROUPBY_KIND_PATHEXPR)
+            continue;
+
+        pathExpr      = groupByList[i].pathExpr;
+        lastElemIndex = pathExpr.size - 1;
+        if(pathExpr[lastElemIndex].fromAttrKind != PATHEXPR_KIND_ATTR)
+            continue;
+
+        if(!m_catalog->index_isB_TreeIndexExist(pathExpr[lastElemIndex].classInfo, pathExpr[lastElemIndex].attr.attrInfo))
+            continue;
+
+        nIndexes = OOSQL_HASHAGGR_MAXNINDEXES;
+        e = m_catalog->index_getB_TreeIndexes(pathExpr[lastElemIndex].classInfo, pathExpr[lastElemIndex].attr.attrInfo, nIndexes, indexId_array);
+        OOSQL_CHECK_ERR(e);
+
+        for(j = 0; j < nIndexes; j++)
+        {
+            e = m_catalog->index_IndexId_to_IndexInfo(pathExpr[lastElemIndex].classInfo, indexId_array[j], cataIndexInfo);
+            OOSQL_CHECK_ERR(e);
+
+            e = m_catalog->index_GetIndexDesc(pathExpr[lastElemIndex].classInfo, cataIndexInfo, btreeKeyDesc);
+            OOSQL_CHECK_ERR(e);
+
+            // each object makes its own group
+            if((btreeKeyDesc.flag & KEYFLAG_UNIQUE) && btreeKeyDesc.nparts == 1)
+                return SM_FALSE;
+        }
+    }
+
+    return SM_TRUE;
+}
+
 Four OQL_GDStoCommonAP::replacePathExprForGroupbyKey(AP_ExprPoolElements& ap_expr, Four groupby_planNo)
 {
     Four e;
@@ -6207,6 +6413,8 @@ Four OQL_GDStoCommonAP::makePlan_constructOrderBy()
     // make new AP element
     // -------------------
 
+    apNode_temp.setPoolIndex(apNode.startIndex, 1);
+
     apNode = m_pool->commonAP_Pool.addNewEntry();
     apNode[0].init();
 
@@ -6223,6 +6431,16 @@ Four OQL_GDStoCommonAP::makePlan_constructOrderBy()
     apNode[0].classInfo.classKind   = CLASSKIND_SORTSTREAM;
     apNode[0].classInfo.tempFileNum = tempFileNumForOrderBy;
 
+    // LIMIT is applied to the sorted result, so move it to the new AP element.
+    // then the sort needs to keep only the first tuples (top-K) unless DISTINCT 
+    // removes some of them later
+    apNode[0].limitStart = apNode_temp[0].limitStart;
+    apNode[0].limitCount = apNode_temp[0].limitCount;
+    if(apNode_temp[0].limitCount > 0 && apNode_temp[0].selDistinctFlag == SM_FALSE)
+        projectionList[0].topK = apNode_temp[0].limitStart + apNode_temp[0].limitCount - 1;
+    apNode_temp[0].limitStart = 0;
+    apNode_temp[0].limitCount = 0;
+
     // set usedColInfo
     colNoMap    = m_pool->colNoMapPool.addNewEntry(tempFileInfo.size);
     usedColInfo = m_pool->usedColPool.addNewEntry(tempFileInfo.size);
@@ -1767,6 +1767,7 @@ OQL_OutStream& operator<<(OQL_OutStream& os, AP_ProjectionListElement& object)
 			os << "DESC ";
 	}
 	os << endl;
+	os << "topK            " << object.topK << endl;
 	os << "tempFileNum     " << object.tempFileNum << endl;
 
 	switch(object.projectionType)
@@ -2046,6 +2047,21 @@ DESCRIPTION:
 
 RETURN VALUE:
 
+IMPLEMENTATION:
+****************************************************************************/
+OQL_OutStream& operator<<(OQL_OutStream& os, AP_HashJoinCond& object)
+{
+    os << "outerKey " << object.outerKey << endl;
+    os << "keyType  " << object.keyType << endl;
+
+    return os;
+}
+
+/****************************************************************************
+DESCRIPTION:
+
+RETURN VALUE:
+
 IMPLEMENTATION:
 ****************************************************************************/
 OQL_OutStream& operator<<(OQL_OutStream& os, AP_TextIndexSubPlan& object)
@@ -2100,6 +2116,7 @@ OQL_OutStream& operator<<(OQL_OutStream& os, AP_IndexScanInfo& object)
     {
     case INDEXTYPE_NONE:
         os << "indexType " << "INDEXTYPE_NONE" << endl;
+        os << "hash      " << object.hash;
         break;
     case INDEXTYPE_BTREE:
         os << "indexType " << "INDEXTYPE_BTREE" << endl;
@@ -2484,6 +2501,12 @@ OQL_OutStream& operator<<(OQL_OutStream& os, CommonAP_Element& object)
     case CAP_ACCESSMETHOD_MLGF_INDEXSCAN: 
         os << "accessMethod    " << "CAP_ACCESSMETHOD_MLGF_INDEXSCAN" << endl;
         break;
+    case CAP_ACCESSMETHOD_MLGF_MBR_INDEXSCAN: 
+        os << "accessMethod    " << "CAP_ACCESSMETHOD_MLGF_MBR_INDEXSCAN" << endl;
+        break;
+    case CAP_ACCESSMETHOD_HASHJOIN: 
+        os << "accessMethod    " << "CAP_ACCESSMETHOD_HASHJOIN" << endl;
+        break;
     }
     
 	if(object.isUseOid)
@@ -2505,6 +2528,9 @@ OQL_OutStream& operator<<(OQL_OutStream& os, CommonAP_Element& object)
     os << endl;
     os << "noHavConds      " << object.noHavConds << endl;
     os << "havCondNodes    " << object.havCondNodes << endl;
+    os << "hashAggrFlag    ";
+    if(object.hashAggrFlag)     os << "SM_TRUE"  << endl;
+    else				        os << "SM_FALSE" << endl;
     os << "projectionList  " << object.projectionList << endl;
 
     os << "selDistinctFlag ";
@@ -2803,6 +2829,7 @@ void AP_ProjectionListElement::init(ProjectionType aprojectionType)
 {
 	projectionInfo.setNull();
 	nSortKeys      = 0;
+	topK           = 0;
 	tempFileNum    = -1;	
 	projectionType = aprojectionType;
 	switch(projectionType)
@@ -2854,10 +2881,14 @@ void CommonAP_Element::init()
     nGrpByKeys           = 0;
     noHavConds           = 0;
     havCondNodes.setNull();
+    hashAggrFlag         = SM_FALSE;
 
     projectionList.setNull();
 
     selDistinctFlag      = SM_FALSE;
+
+	limitStart           = 0;
+	limitCount           = 0;
 }
 
 #ifdef  TEMPLATE_NOT_SUPPORTED
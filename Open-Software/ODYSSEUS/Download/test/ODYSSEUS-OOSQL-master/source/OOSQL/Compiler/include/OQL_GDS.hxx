@@ -102,6 +102,7 @@ public:
 	enum QueryType {NO_QUERY, SELECT_QUERY, UPDATE_QUERY, INSERT_QUERY, DELETE_QUERY};
 
 	Four init(OQL_GDSPOOL *pool, QueryType queryType);
+	Four copyFrom(OQL_GDS& source);
 
 	Four setTargetList(OQL_GDSPOOL *pool, TargetListPoolIndex targetList);
 	Four getTargetList(OQL_GDSPOOL *pool, TargetListPoolIndex& targetList);
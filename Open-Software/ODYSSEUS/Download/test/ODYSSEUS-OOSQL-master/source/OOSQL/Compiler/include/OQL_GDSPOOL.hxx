@@ -91,6 +91,8 @@ class OQL_GDSPOOL : public OOSQL_MemoryManagedObject {
 public:
     OQL_GDSPOOL();
     virtual ~OQL_GDSPOOL();
+
+    Four copyFrom(OQL_GDSPOOL& source);
 	
     friend OQL_OutStream& operator<<(OQL_OutStream& os, OQL_GDSPOOL& object);
 	friend class OQL_GDS;
@@ -195,6 +195,8 @@ private:
     Four makePlan_determineScanMethod_MlgfMbrJoin(Four currentPlanNo, Four classId, AP_CondListPoolElements conds, 
 													Four condNumber,
 													AP_IndexInfoPoolIndex& indexInfo, AP_CondListPoolIndex& resultConds);
+    Four makePlan_determineScanMethod_HashJoin(Four currentPlanNo, Four classId, AP_CondListPoolElements conds, 
+                                               AP_IndexInfoPoolIndex& indexInfo);
     Four makePlan_determineBoundConditionForB_TreeScan(Four planNo, Four nKeyCols, Two* colNos, AP_CondListPoolElements conds,
                                                        AP_BoundCondInfo& startBound, AP_BoundCondInfo& stopBound,
                                                        AP_CondListPoolIndex& resultConds, Boolean operandSwapped,
@@ -237,6 +239,8 @@ private:
 																	 AP_BoundCondInfo& stopBound);
 
     Four makePlan_constructGroupByHaving();
+    One  makePlan_isHashableAggrFunc(AggrFuncElement& aggrFunc, AP_TempFileInfoElement& tempFileInfo);
+    Four makePlan_isFewGroups(GroupByListPoolElements& groupByList, AP_TempFileInfoPoolElements& tempFileInfo);
     Four makePlan_constructOrderBy();
     Four makePlan_constructSelect();
 	Four makePlan_constructFinalProjection();
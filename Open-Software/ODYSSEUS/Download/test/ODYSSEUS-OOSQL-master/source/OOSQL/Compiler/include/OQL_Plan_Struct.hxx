@@ -573,6 +573,7 @@ struct AP_ProjectionListElement {
     Two                         nSortKeys;					// 0 if sort is not used
     Two                         sortKeys[MAX_NUM_KEYS];
     SortOrderType               sortAscDesc[MAX_NUM_KEYS];
+    Four                        topK;						// > 0 if only the first topK tuples in sort order are used (LIMIT)
     Four                        tempFileNum;				// -1 if not used 
 	ProjectionType				projectionType;
 	union {
@@ -912,6 +913,13 @@ struct AP_MlgfMbrIndexCond {
 
 OQL_OutStream& operator<<(OQL_OutStream& os, AP_MlgfMbrIndexCond& object);
 
+struct AP_HashJoinCond {
+    AP_ExprPoolIndex            outerKey;   // join key evaluated for each outer object
+    TypeID                      keyType;    // type of the join column of the inner class
+};
+
+OQL_OutStream& operator<<(OQL_OutStream& os, AP_HashJoinCond& object);
+
 struct AP_TextIndexSubPlan {
     Four                        matchFuncNum;
     AP_TextIndexCondPoolIndex   textIndexCond;
@@ -938,6 +946,7 @@ struct AP_IndexScanInfo {
         AP_TextIndexSubPlan			text;
         AP_MlgfIndexCond			mlgf;
         AP_MlgfMbrIndexCond			mlgfmbr;
+        AP_HashJoinCond				hash;
     };
 	AP_BoolExprPoolIndex			boolExprs;
 	union {
@@ -1195,7 +1204,8 @@ enum {CAP_ACCESSMETHOD_NONE,
       CAP_ACCESSMETHOD_BTREE_INDEXSCAN, 
       CAP_ACCESSMETHOD_TEXT_INDEXSCAN,  
       CAP_ACCESSMETHOD_MLGF_INDEXSCAN,   
-	  CAP_ACCESSMETHOD_MLGF_MBR_INDEXSCAN 
+	  CAP_ACCESSMETHOD_MLGF_MBR_INDEXSCAN,
+      CAP_ACCESSMETHOD_HASHJOIN
 };
 
 struct CommonAP_Element {
@@ -1246,6 +1256,7 @@ struct CommonAP_Element {
     Two                         grpByKeys[MAX_NUM_KEYS];
     Two                         noHavConds;
     AP_CondListPoolIndex        havCondNodes;
+    One                         hashAggrFlag;       // TRUE if groups are made by hashing instead of sorting
 
     // projection information
     //  project column information
@@ -286,6 +286,7 @@ public:
     PoolIndex<T>    addNewEntry();
     PoolIndex<T>    addNewEntry(Four nElements);
     Four            nElements()     { return top; };
+    Four            copyFrom(OQL_Pool<T>& source);
 
     virtual char* name() { return "OQL_Pool"; }
 
@@ -386,6 +387,32 @@ PoolIndex<T> OQL_Pool<T>::addNewEntry(Four nElements)
     return poolIndex;
 }
 
+template <class T>
+Four OQL_Pool<T>::copyFrom(OQL_Pool<T>& source)
+{
+    T*   pTemp;
+    Four i;
+
+    // enlarge the elements array if it cannot hold all entries of source
+    if(source.top >= maxSize)
+    {
+        pTemp = (T*)pMemoryManager->Alloc(sizeof(T) * source.maxSize);
+        if(pTemp == NULL)
+            OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+
+        pMemoryManager->Free(elements);
+
+        elements = pTemp;
+        maxSize  = source.maxSize;
+    }
+
+    for(i = 0;i < source.top; i++)
+        elements[i] = source.elements[i];
+    top = source.top;
+
+    return eNOERROR;
+}
+
 template <class T>
 OQL_OutStream& operator<<(OQL_OutStream& os, OQL_Pool<T>& object)
 {
@@ -414,6 +441,7 @@ OQL_OutStream& operator<<(OQL_OutStream& os, OQL_Pool<T>& object)
         PoolIndex(type) addNewEntry();                                      \
         PoolIndex(type) addNewEntry(Four nElements);                        \
         Four            nElements()     { return top; };                    \
+        Four            copyFrom(OQL_Pool(type)& source);                   \
                                                                             \
         virtual char* name() { return "OQL_Pool"; }                         \
                                                                             \
@@ -504,6 +532,30 @@ OQL_OutStream& operator<<(OQL_OutStream& os, OQL_Pool<T>& object)
         return poolIndex;                                                   \
     }                                                                       \
                                                                             \
+    Four OQL_Pool(type)::copyFrom(OQL_Pool(type)& source)                   \
+    {                                                                       \
+        type*   pTemp;                                                      \
+        Four    i;                                                          \
+                                                                            \
+        if(source.top >= maxSize)                                           \
+        {                                                                   \
+            pTemp = (type*)pMemoryManager->Alloc(sizeof(type) * source.maxSize);  \
+            if(pTemp == NULL)                                               \
+                OOSQL_ERR(eMEMORYALLOCERR_OOSQL);                           \
+                                                                            \
+            pMemoryManager->Free(elements);                                 \
+                                                                            \
+            elements = pTemp;                                               \
+            maxSize  = source.maxSize;                                      \
+        }                                                                   \
+                                                                            \
+        for(i = 0;i < source.top; i++)                                      \
+            elements[i] = source.elements[i];                               \
+        top = source.top;                                                   \
+                                                                            \
+        return eNOERROR;                                                    \
+    }                                                                       \
+                                                                            \
     OQL_OutStream& operator<<(OQL_OutStream& os, OQL_Pool(type)& object)    \
     {                                                                       \
         Four    i;                                                          \
@@ -139,6 +139,8 @@ OOSQL_Evaluator::OOSQL_Evaluator(
 
 	m_getdata_nInfo = 0;
 	m_getdata_info  = NULL;
+
+	m_degreeOfParallelism = OOSQL_PARALLELSCAN_DEGREE;
 }
 
 
@@ -995,7 +997,8 @@ Four OOSQL_Evaluator::EvalAndFetchForGeneralQuery(
         if(nEvaluationsToDo != -1 && m_numQueryResultTuples >= nEvaluationsToDo)
             break;
         
-        if(ACCESSPLANELEMENTS[m_currPlanIndex].nGrpByKeys > 0) 
+        /* NOTE: groups made by hashing are complete when they are read */
+        if(ACCESSPLANELEMENTS[m_currPlanIndex].nGrpByKeys > 0 && !ACCESSPLANELEMENTS[m_currPlanIndex].hashAggrFlag) 
         {
             if(m_evalStatus.groupingStatus == EVALSTATUS_END) 
             {
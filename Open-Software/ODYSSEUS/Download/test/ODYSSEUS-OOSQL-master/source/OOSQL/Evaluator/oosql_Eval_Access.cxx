@@ -76,6 +76,9 @@
 
     DESCRIPTION:
 
+        A sequential scan of a persistent class whose WHERE condition can be
+        evaluated over vectors reads a batch of objects at a time
+        (see OOSQL_BatchScan).
 */
 
 #include <unistd.h>
@@ -161,6 +164,7 @@ Four    OOSQL_Evaluator::initAccessListTable()
                     case ACCESSMETHOD_TEXT_IDXSCAN:
                     case ACCESSMETHOD_MLGF_IDXSCAN:
                     case ACCESSMETHOD_MLGF_MBR_IDXSCAN: 
+                    case ACCESSMETHOD_HASHJOIN:
                         pAccessList[0].indexInfo = ACCESSPLANELEMENTS[planIndex].indexInfo;
                         break;
                 }
@@ -215,6 +219,7 @@ Four    OOSQL_Evaluator::initAccessListTable()
                         case ACCESSMETHOD_TEXT_IDXSCAN:
                         case ACCESSMETHOD_MLGF_IDXSCAN:
                         case ACCESSMETHOD_MLGF_MBR_IDXSCAN: 
+                        case ACCESSMETHOD_HASHJOIN:
                             pAccessList[i+1].indexInfo = pSubClassInfo[i].indexInfo;
                             break;
                     }
@@ -258,6 +263,7 @@ Four    OOSQL_Evaluator::initAccessListTable()
                     case ACCESSMETHOD_TEXT_IDXSCAN:
                     case ACCESSMETHOD_MLGF_IDXSCAN:
                     case ACCESSMETHOD_MLGF_MBR_IDXSCAN: 
+                    case ACCESSMETHOD_HASHJOIN:
                         pAccessList[0].indexInfo = ACCESSPLANELEMENTS[planIndex].indexInfo;
                         break;
                 }
@@ -519,6 +525,25 @@ Four    OOSQL_Evaluator::finalAccessListTable()
         /* skip if there was no class to access 
          * NOTE: this case could occur if class kind = CLASSKIND_NULL_AGGRFUNC_ONLY
          */
+        /* destroy the groups made by hashing */
+        if (EVAL_ACCESSLISTTABLE[planIndex].hashAggregation != NULL) {
+            e = finalHashAggregation(planIndex);
+            if (e < eNOERROR) OOSQL_ERR(e);
+        }
+
+#ifdef COSMOS_MULTITHREAD
+        /* stop the worker threads before the batch they read is freed */
+        if (EVAL_ACCESSLISTTABLE[planIndex].parallelScan != NULL) {
+            OOSQL_DELETE(EVAL_ACCESSLISTTABLE[planIndex].parallelScan);
+            EVAL_ACCESSLISTTABLE[planIndex].parallelScan = NULL;
+        }
+#endif
+
+        if (EVAL_ACCESSLISTTABLE[planIndex].batchScan != NULL) {
+            OOSQL_DELETE(EVAL_ACCESSLISTTABLE[planIndex].batchScan);
+            EVAL_ACCESSLISTTABLE[planIndex].batchScan = NULL;
+        }
+
         /* 
          * Close scans if the current access plan element is the outermost class of
          * a nested-loop (including a single class).
@@ -571,6 +596,13 @@ Four    OOSQL_Evaluator::finalAccessListTable()
 
                         break;
 
+                    case ACCESSMETHOD_HASHJOIN:
+                        e = finalHashJoin(planIndex, i);
+                        if (e < eNOERROR && e != eSCANALREADYCLOSED_OOSQL)
+                            OOSQL_ERR(e);
+
+                        break;
+
                     default:
                         OOSQL_ERR(eINVALID_CASE_OOSQL);
                 } /* end of switch */
@@ -615,6 +647,12 @@ Four    OOSQL_Evaluator::finalAccessListTable()
                         if (e < eNOERROR && e != eSCANALREADYCLOSED_OOSQL)	
                             OOSQL_ERR(e);
                         break;
+
+                    case ACCESSMETHOD_HASHJOIN:
+                        e = finalHashJoin(planIndex, i);
+                        if (e < eNOERROR && e != eSCANALREADYCLOSED_OOSQL)
+                            OOSQL_ERR(e);
+                        break;
                 } /* end of switch */
             } /* end of for */
         } /* end of if */
@@ -939,6 +977,16 @@ Four    OOSQL_Evaluator::openSeqScan(
             scanId = m_storageManager->OpenSeqScan( accessElement->ocn, accessElement->scanDirection, 0, NULL, &lockup );
             if (scanId < eNOERROR)
                 OOSQL_ERR(scanId);
+
+            /* discard the batch read by the previous scan */
+            if (EVAL_ACCESSLISTTABLE[planIndex].batchScan != NULL)
+                EVAL_ACCESSLISTTABLE[planIndex].batchScan->reset();
+#ifdef COSMOS_MULTITHREAD
+            if (EVAL_ACCESSLISTTABLE[planIndex].parallelScan != NULL) {
+                e = EVAL_ACCESSLISTTABLE[planIndex].parallelScan->reset();
+                if (e < eNOERROR) OOSQL_ERR(e);
+            }
+#endif
             break;
 
         case CLASSKIND_TEMPORARY:
@@ -1055,6 +1103,899 @@ Four    OOSQL_Evaluator::closeSeqScan(
 }
 
 
+OOSQL_BatchScan::OOSQL_BatchScan(
+	Four	nUsedCols_		// IN: the # of used columns of the scanned class
+)
+{
+	Four	i;
+
+	nUsedCols    = nUsedCols_;
+	nCols        = 0;
+	colMap       = (Four*)pMemoryManager->Alloc(sizeof(Four) * (nUsedCols + 1));
+	colTypes     = (Four*)pMemoryManager->Alloc(sizeof(Four) * (nUsedCols + 1));
+	clist        = (OOSQL_StorageManager::ColListStruct*)pMemoryManager->Alloc(sizeof(OOSQL_StorageManager::ColListStruct) * (nUsedCols + 1));
+	colVectors   = (OOSQL_BatchVector*)pMemoryManager->Alloc(sizeof(OOSQL_BatchVector) * (nUsedCols + 1));
+	for(i = 0; i < nUsedCols; i++)
+	{
+		colMap[i]                = NIL;
+		colVectors[i].ivalues    = NULL;
+		colVectors[i].rvalues    = NULL;
+		colVectors[i].nullFlags  = NULL;
+	}
+
+	condNodes.setNull();
+	isVectorized = SM_FALSE;
+
+	vectors         = NULL;
+	nVectors        = 0;
+	nUsedVectors    = 0;
+	selections      = NULL;
+	nSelections     = 0;
+	nUsedSelections = 0;
+
+	reset();
+}
+
+OOSQL_BatchScan::~OOSQL_BatchScan()
+{
+	Four	i;
+
+	for(i = 0; i < nCols; i++)
+	{
+		if(colVectors[i].ivalues)
+			pMemoryManager->Free(colVectors[i].ivalues);
+		if(colVectors[i].rvalues)
+			pMemoryManager->Free(colVectors[i].rvalues);
+		pMemoryManager->Free(colVectors[i].nullFlags);
+	}
+
+	for(i = 0; i < nVectors; i++)
+	{
+		pMemoryManager->Free(vectors[i].ivalues);
+		pMemoryManager->Free(vectors[i].rvalues);
+		pMemoryManager->Free(vectors[i].nullFlags);
+	}
+	if(vectors)
+		pMemoryManager->Free(vectors);
+
+	for(i = 0; i < nSelections; i++)
+		pMemoryManager->Free(selections[i]);
+	if(selections)
+		pMemoryManager->Free(selections);
+
+	pMemoryManager->Free(colMap);
+	pMemoryManager->Free(colTypes);
+	pMemoryManager->Free(clist);
+	pMemoryManager->Free(colVectors);
+}
+
+Four OOSQL_BatchScan::addColumn(
+	Four	mappedColNo,	// IN: index of the column in the evaluation buffer
+	Four	colNo,			// IN: column number of the class
+	Four	typeId,			// IN: 
+	Four	length			// IN: 
+)
+/*
+    Function:
+		Read a column of the condition into a vector.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+		index of the vector
+*/
+{
+	OOSQL_BatchVector*	v;
+
+	if(colMap[mappedColNo] != NIL)
+		return colMap[mappedColNo];
+
+	v = &colVectors[nCols];
+	v->isReal    = (typeId == OOSQL_TYPE_FLOAT || typeId == OOSQL_TYPE_DOUBLE) ? SM_TRUE : SM_FALSE;
+	v->ivalues   = NULL;
+	v->rvalues   = NULL;
+	if(v->isReal)
+		v->rvalues = (double*)pMemoryManager->Alloc(sizeof(double) * OOSQL_BATCHSCAN_SIZE);
+	else
+		v->ivalues = (Eight_Invariable*)pMemoryManager->Alloc(sizeof(Eight_Invariable) * OOSQL_BATCHSCAN_SIZE);
+	v->nullFlags = (One*)pMemoryManager->Alloc(sizeof(One) * OOSQL_BATCHSCAN_SIZE);
+	if((v->ivalues == NULL && v->rvalues == NULL) || v->nullFlags == NULL)
+		OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+	clist[nCols].colNo      = (Two)colNo;
+	clist[nCols].start      = 0;
+	clist[nCols].length     = length;
+	clist[nCols].dataLength = length;
+	clist[nCols].nullFlag   = SM_FALSE;
+	colTypes[nCols]         = typeId;
+
+	colMap[mappedColNo] = nCols;
+
+	return nCols++;
+}
+
+Four OOSQL_BatchScan::copyColumns(
+	OOSQL_BatchScan*	source		// IN: batch scan of the same class
+)
+/*
+    Function:
+		Read the same columns as the source into vectors of the same index.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	Four	mappedColNo;
+	Four	i;
+	Four	e;
+
+	for(i = 0; i < source->nCols; i++)
+	{
+		for(mappedColNo = 0; mappedColNo < source->nUsedCols; mappedColNo++)
+			if(source->colMap[mappedColNo] == i)
+				break;
+		if(mappedColNo == source->nUsedCols)
+			OOSQL_ERR(eINVALID_CASE_OOSQL);
+
+		e = addColumn(mappedColNo, source->clist[i].colNo, source->colTypes[i], source->clist[i].length);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	return eNOERROR;
+}
+
+OOSQL_BatchVector* OOSQL_BatchScan::allocVector(
+	Boolean	isReal			// IN: 
+)
+{
+	OOSQL_BatchVector*	v;
+
+	if(nUsedVectors == nVectors)
+	{
+		if(vectors)
+			vectors = (OOSQL_BatchVector*)pMemoryManager->Realloc(vectors, sizeof(OOSQL_BatchVector) * (nVectors + 1));
+		else
+			vectors = (OOSQL_BatchVector*)pMemoryManager->Alloc(sizeof(OOSQL_BatchVector));
+		if(vectors == NULL)
+			return NULL;
+
+		v = &vectors[nVectors];
+		v->ivalues   = (Eight_Invariable*)pMemoryManager->Alloc(sizeof(Eight_Invariable) * OOSQL_BATCHSCAN_SIZE);
+		v->rvalues   = (double*)pMemoryManager->Alloc(sizeof(double) * OOSQL_BATCHSCAN_SIZE);
+		v->nullFlags = (One*)pMemoryManager->Alloc(sizeof(One) * OOSQL_BATCHSCAN_SIZE);
+		if(v->ivalues == NULL || v->rvalues == NULL || v->nullFlags == NULL)
+			return NULL;
+		nVectors++;
+	}
+
+	v = &vectors[nUsedVectors++];
+	v->isReal = isReal;
+
+	return v;
+}
+
+Four* OOSQL_BatchScan::allocSelection()
+{
+	if(nUsedSelections == nSelections)
+	{
+		if(selections)
+			selections = (Four**)pMemoryManager->Realloc(selections, sizeof(Four*) * (nSelections + 1));
+		else
+			selections = (Four**)pMemoryManager->Alloc(sizeof(Four*));
+		if(selections == NULL)
+			return NULL;
+
+		selections[nSelections] = (Four*)pMemoryManager->Alloc(sizeof(Four) * OOSQL_BATCHSCAN_SIZE);
+		if(selections[nSelections] == NULL)
+			return NULL;
+		nSelections++;
+	}
+
+	return selections[nUsedSelections++];
+}
+
+Four    OOSQL_Evaluator::initBatchScan(
+    Four planIndex                      /* IN: */
+)
+/*
+    Function:
+        Check if the WHERE condition of the current access element can be
+        evaluated over vectors and, if so, choose the columns to read into
+        the vectors.
+
+    Side effect:
+
+    Referenced member variables:
+        m_currWhereCondNodes
+
+    Return value:
+*/
+{
+	OOSQL_BatchScan*			batchScan;
+	AP_CondListPoolElements		whereCondNodes(m_pool->ap_condListPool);
+	Four						i;
+	Four						e;
+
+	batchScan = EVAL_ACCESSLISTTABLE[planIndex].batchScan;
+	if(batchScan == NULL)
+	{
+		OOSQL_NEW(batchScan, pMemoryManager, OOSQL_BatchScan(EVAL_EVALBUFFER[planIndex].nCols));
+		EVAL_ACCESSLISTTABLE[planIndex].batchScan = batchScan;
+	}
+
+	batchScan->reset();
+	batchScan->condNodes    = m_currWhereCondNodes;
+	batchScan->isVectorized = SM_FALSE;
+
+#ifdef COSMOS_MULTITHREAD
+	if(EVAL_ACCESSLISTTABLE[planIndex].parallelScan != NULL)
+	{
+		OOSQL_DELETE(EVAL_ACCESSLISTTABLE[planIndex].parallelScan);
+		EVAL_ACCESSLISTTABLE[planIndex].parallelScan = NULL;
+	}
+#endif
+
+	/* objects of an update query are checked one at a time, since the query changes them */
+	if(IS_NULL_POOLINDEX(m_currWhereCondNodes) || isUpdateQuery())
+		return eNOERROR;
+
+	whereCondNodes = m_currWhereCondNodes;
+	for(i = 0; i < GET_POOLSIZE(whereCondNodes); i++)
+	{
+		e = isBatchCond(planIndex, &(whereCondNodes[i].expr));
+		OOSQL_CHECK_ERR(e);
+
+		if(e == SM_FALSE)
+			return eNOERROR;
+	}
+
+	batchScan->isVectorized = SM_TRUE;
+
+#ifdef COSMOS_MULTITHREAD
+	e = initParallelScan(planIndex);
+	OOSQL_CHECK_ERR(e);
+#endif
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::batchScanNext(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+        Return the next object of the sequential scan which satisfies the
+        WHERE condition. A new batch is read when the selected objects of
+        the current batch are exhausted.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+        eNOERROR        if an object is returned
+        EOS             if the scan is ended
+*/
+{
+	OOSQL_BatchScan*			batchScan;
+	OOSQL_StorageManager::OID*	oid;
+	Four						scanId;
+	Four						nCols;
+	Four						e;
+
+#ifdef COSMOS_MULTITHREAD
+	if(EVAL_ACCESSLISTTABLE[planIndex].parallelScan != NULL)
+		return parallelScanNext(planIndex, accessElemIndex);
+#endif
+
+	batchScan = EVAL_ACCESSLISTTABLE[planIndex].batchScan;
+	scanId    = EVAL_ACCESSLISTTABLE[planIndex].getCurrScanID();
+	if(scanId < 0)
+		return EOS;
+
+	while(batchScan->nextSelected == batchScan->nSelected)
+	{
+		if(batchScan->endOfScan)
+			return EOS;
+
+		e = fillBatchScan(planIndex, scanId);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	/* read the other columns of the selected object */
+	oid = EVAL_EVALBUFFER[planIndex].getOID_Ptr();
+	*oid = batchScan->oids[batchScan->selection[batchScan->nextSelected++]];
+
+	nCols = EVAL_EVALBUFFER[planIndex].nCols;
+	if(nCols > 0)
+	{
+		e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, oid, nCols, EVAL_EVALBUFFER[planIndex].getColSlotPtr(0));
+		if(e < eNOERROR) OOSQL_ERR(e);
+	}
+
+	batchScan->isFiltered = SM_TRUE;
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::fillBatchScan(
+    Four planIndex,                     /* IN: */
+	Four scanId							/* IN: */
+)
+/*
+    Function:
+        Read the columns of the condition of the next batch of objects and
+        select the objects satisfying the condition.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_BatchScan*	batchScan;
+	Four				e;
+
+	batchScan = EVAL_ACCESSLISTTABLE[planIndex].batchScan;
+
+	e = readBatch(scanId, batchScan);
+	OOSQL_CHECK_ERR(e);
+
+	e = checkBatchWhereCond(batchScan);
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::readBatch(
+	Four				scanId,			/* IN: */
+	OOSQL_BatchScan*	batchScan		/* INOUT: */
+)
+/*
+    Function:
+        Read the columns of the condition of the next batch of objects into
+        the vectors of the batch.
+
+    Side effect:
+        batchScan->endOfScan is set if the scan is ended.
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_StorageManager::ColListStruct*	clist;
+	Four									n;
+	Four									i;
+	Four									e;
+
+	clist = batchScan->clist;
+
+	for(n = 0; n < OOSQL_BATCHSCAN_SIZE; n++)
+	{
+		e = m_storageManager->NextObject(scanId, &batchScan->oids[n], NULL);
+		if(e < eNOERROR) OOSQL_ERR(e);
+		if(e == EOS)
+		{
+			batchScan->endOfScan = SM_TRUE;
+			break;
+		}
+
+		if(batchScan->nCols == 0)
+			continue;
+
+		e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, &batchScan->oids[n], batchScan->nCols, clist);
+		if(e < eNOERROR) OOSQL_ERR(e);
+
+		for(i = 0; i < batchScan->nCols; i++)
+		{
+			batchScan->colVectors[i].nullFlags[n] = clist[i].nullFlag;
+
+			switch(batchScan->colTypes[i])
+			{
+			case OOSQL_TYPE_SHORT:
+				batchScan->colVectors[i].ivalues[n] = clist[i].data.s;
+				break;
+			case OOSQL_TYPE_INT:
+				batchScan->colVectors[i].ivalues[n] = clist[i].data.i;
+				break;
+			case OOSQL_TYPE_LONG:
+				batchScan->colVectors[i].ivalues[n] = clist[i].data.l;
+				break;
+			case OOSQL_TYPE_LONG_LONG:
+				batchScan->colVectors[i].ivalues[n] = clist[i].data.ll;
+				break;
+			case OOSQL_TYPE_FLOAT:
+				batchScan->colVectors[i].rvalues[n] = clist[i].data.f;
+				break;
+			case OOSQL_TYPE_DOUBLE:
+				batchScan->colVectors[i].rvalues[n] = clist[i].data.d;
+				break;
+			default:
+				OOSQL_ERR(eINVALID_CASE_OOSQL);
+			}
+		}
+	}
+
+	batchScan->nObjects     = n;
+	batchScan->nextSelected = 0;
+
+	return eNOERROR;
+}
+
+#ifdef COSMOS_MULTITHREAD
+Four    OOSQL_Evaluator::initParallelScan(
+    Four planIndex                      /* IN: */
+)
+/*
+    Function:
+        Start worker threads which filter the batches of a vectorized
+        sequential scan, if the degree of parallelism is greater than 1.
+        The query thread keeps reading the batches, since the scan belongs
+        to the transaction of the query.
+
+    Side effect:
+
+    Referenced member variables:
+        m_degreeOfParallelism
+
+    Return value:
+*/
+{
+	OOSQL_ParallelScan*		parallelScan;
+	Four					degree;
+	Four					nProcessors;
+	Four					e;
+
+	degree      = m_degreeOfParallelism;
+	nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+	if(degree > nProcessors)
+		degree = nProcessors;
+	if(degree <= 1)
+		return eNOERROR;
+
+	/* the query thread and (degree - 1) workers; each of them can hold two morsels */
+	OOSQL_NEW(parallelScan, pMemoryManager, OOSQL_ParallelScan(this, 2 * degree));
+
+	e = parallelScan->init(EVAL_ACCESSLISTTABLE[planIndex].batchScan, EVAL_EVALBUFFER[planIndex].nCols, degree - 1);
+	if(e < eNOERROR)
+	{
+		OOSQL_DELETE(parallelScan);
+		OOSQL_ERR(e);
+	}
+
+	/* if no worker can be created, the batches are filtered by the query thread */
+	if(parallelScan->nWorkers == 0)
+	{
+		OOSQL_DELETE(parallelScan);
+		return eNOERROR;
+	}
+
+	EVAL_ACCESSLISTTABLE[planIndex].parallelScan = parallelScan;
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::parallelScanNext(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+        Return the next object of the sequential scan which satisfies the
+        WHERE condition from the morsels filtered by the worker threads.
+        The objects are returned in the order of the scan.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+        eNOERROR        if an object is returned
+        EOS             if the scan is ended
+*/
+{
+	OOSQL_ParallelScan*			parallelScan;
+	OOSQL_BatchScan*			morsel;
+	OOSQL_StorageManager::OID*	oid;
+	Four						morselNo;
+	Four						scanId;
+	Four						nCols;
+	Four						e;
+
+	parallelScan = EVAL_ACCESSLISTTABLE[planIndex].parallelScan;
+	scanId       = EVAL_ACCESSLISTTABLE[planIndex].getCurrScanID();
+	if(scanId < 0)
+		return EOS;
+
+	while(SM_TRUE)
+	{
+		morselNo = parallelScan->nextToConsume;
+		morsel   = parallelScan->morsels[morselNo];
+
+		if(parallelScan->getState(morselNo) == MORSEL_FILTERED)
+		{
+			if(morsel->nextSelected < morsel->nSelected)
+				break;
+
+			/* all selected objects of the morsel are returned */
+			e = parallelScan->release(morselNo);
+			OOSQL_CHECK_ERR(e);
+			continue;
+		}
+
+		/* read the empty morsels so that the workers are kept busy */
+		e = fillParallelScan(scanId, parallelScan);
+		OOSQL_CHECK_ERR(e);
+
+		if(parallelScan->getState(morselNo) == MORSEL_EMPTY)
+			return EOS;
+
+		e = parallelScan->waitFiltered(morselNo);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	/* read the other columns of the selected object */
+	oid = EVAL_EVALBUFFER[planIndex].getOID_Ptr();
+	*oid = morsel->oids[morsel->selection[morsel->nextSelected++]];
+
+	nCols = EVAL_EVALBUFFER[planIndex].nCols;
+	if(nCols > 0)
+	{
+		e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, oid, nCols, EVAL_EVALBUFFER[planIndex].getColSlotPtr(0));
+		if(e < eNOERROR) OOSQL_ERR(e);
+	}
+
+	EVAL_ACCESSLISTTABLE[planIndex].batchScan->isFiltered = SM_TRUE;
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::fillParallelScan(
+	Four				scanId,			/* IN: */
+	OOSQL_ParallelScan*	parallelScan	/* INOUT: */
+)
+/*
+    Function:
+        Read the next batches of the scan into the empty morsels and hand
+        them over to the workers.
+
+    Side effect:
+        parallelScan->nextToFill and parallelScan->endOfScan are changed.
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_BatchScan*	morsel;
+	Four				e;
+
+	while(!parallelScan->endOfScan && parallelScan->getState(parallelScan->nextToFill) == MORSEL_EMPTY)
+	{
+		morsel = parallelScan->morsels[parallelScan->nextToFill];
+
+		e = readBatch(scanId, morsel);
+		OOSQL_CHECK_ERR(e);
+
+		if(morsel->endOfScan)
+			parallelScan->endOfScan = SM_TRUE;
+		if(morsel->nObjects == 0)
+			break;
+
+		e = parallelScan->submit(parallelScan->nextToFill);
+		OOSQL_CHECK_ERR(e);
+
+		parallelScan->nextToFill = (parallelScan->nextToFill + 1) % parallelScan->nMorsels;
+	}
+
+	return eNOERROR;
+}
+
+OOSQL_ParallelScan::OOSQL_ParallelScan(
+	OOSQL_Evaluator*	evaluator_,		// IN: evaluator whose condition the workers evaluate
+	Four				nMorsels_		// IN: the # of morsels in the ring
+)
+{
+	evaluator = evaluator_;
+	nMorsels  = nMorsels_;
+	condNodes.setNull();
+
+	morsels  = NULL;
+	states   = NULL;
+	errors   = NULL;
+	workers  = NULL;
+	nWorkers = 0;
+	shutdown = SM_FALSE;
+
+	morselMemoryManager = NULL;
+
+	nextToFill    = 0;
+	nextToConsume = 0;
+	endOfScan     = SM_FALSE;
+
+	cosmos_thread_mutex_create(&mutex, 0);
+	cosmos_thread_cond_create(&filledCond, 0);
+	cosmos_thread_cond_create(&filteredCond, 0);
+}
+
+OOSQL_ParallelScan::~OOSQL_ParallelScan()
+{
+	Four	i;
+
+	if(nWorkers > 0)
+	{
+		cosmos_thread_mutex_lock(&mutex);
+		shutdown = SM_TRUE;
+		/* wake up the waiting workers one by one */
+		for(i = 0; i < nWorkers; i++)
+			cosmos_thread_cond_signal(&filledCond);
+		cosmos_thread_mutex_unlock(&mutex);
+
+		for(i = 0; i < nWorkers; i++)
+			cosmos_thread_wait(workers[i]);
+	}
+
+	if(morsels)
+	{
+		for(i = 0; i < nMorsels; i++)
+			if(morsels[i])
+				OOSQL_DELETE(morsels[i]);
+		pMemoryManager->Free(morsels);
+	}
+	if(states)
+		pMemoryManager->Free(states);
+	if(errors)
+		pMemoryManager->Free(errors);
+	if(workers)
+		pMemoryManager->Free(workers);
+
+	if(morselMemoryManager)
+		delete morselMemoryManager;
+
+	cosmos_thread_cond_destroy(&filledCond);
+	cosmos_thread_cond_destroy(&filteredCond);
+	cosmos_thread_mutex_destroy(&mutex);
+}
+
+Four OOSQL_ParallelScan::init(
+	OOSQL_BatchScan*	batchScan,		// IN: batch scan whose batches are filtered
+	Four				nUsedCols,		// IN: the # of used columns of the scanned class
+	Four				nWorkers_		// IN: the # of worker threads to create
+)
+/*
+    Function:
+		Make the morsels read the same columns as the batch scan, and
+		create the worker threads.
+
+    Side effect:
+		nWorkers is the # of worker threads actually created.
+
+    Return value:
+*/
+{
+	Four	i;
+	Four	e;
+
+	/* the morsels are filtered by the workers, so they are allocated by a thread-safe memory manager */
+	morselMemoryManager = new OOSQL_MemoryManager;
+	if(morselMemoryManager == NULL)
+		OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+	morsels = (OOSQL_BatchScan**)pMemoryManager->Alloc(sizeof(OOSQL_BatchScan*) * nMorsels);
+	states  = (Four*)pMemoryManager->Alloc(sizeof(Four) * nMorsels);
+	errors  = (Four*)pMemoryManager->Alloc(sizeof(Four) * nMorsels);
+	workers = (cosmos_thread_t*)pMemoryManager->Alloc(sizeof(cosmos_thread_t) * nWorkers_);
+	if(morsels == NULL || states == NULL || errors == NULL || workers == NULL)
+		OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+	for(i = 0; i < nMorsels; i++)
+		morsels[i] = NULL;
+
+	condNodes = batchScan->condNodes;
+	for(i = 0; i < nMorsels; i++)
+	{
+		OOSQL_NEW(morsels[i], morselMemoryManager, OOSQL_BatchScan(nUsedCols));
+
+		e = morsels[i]->copyColumns(batchScan);
+		OOSQL_CHECK_ERR(e);
+
+		morsels[i]->condNodes    = condNodes;
+		morsels[i]->isVectorized = SM_TRUE;
+
+		states[i] = MORSEL_EMPTY;
+		errors[i] = eNOERROR;
+	}
+
+	for(nWorkers = 0; nWorkers < nWorkers_; nWorkers++)
+	{
+		e = cosmos_thread_create(&workers[nWorkers], workerMain, (void*)this, 0);
+		if(e < eNOERROR)
+			break;
+	}
+
+	return eNOERROR;
+}
+
+Four OOSQL_ParallelScan::reset()
+/*
+    Function:
+		Discard the morsels read by the previous scan.
+
+    Side effect:
+
+    Return value:
+*/
+{
+	Four	i;
+	Four	e;
+
+	e = cosmos_thread_mutex_lock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	/* the workers may still be filtering the morsels */
+	for(i = 0; i < nMorsels; i++)
+	{
+		while(states[i] == MORSEL_FILLED || states[i] == MORSEL_FILTERING)
+			cosmos_thread_cond_wait(&filteredCond, &mutex);
+
+		states[i] = MORSEL_EMPTY;
+		errors[i] = eNOERROR;
+		morsels[i]->reset();
+	}
+
+	nextToFill    = 0;
+	nextToConsume = 0;
+	endOfScan     = SM_FALSE;
+
+	e = cosmos_thread_mutex_unlock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	return eNOERROR;
+}
+
+Four OOSQL_ParallelScan::getState(
+	Four	morselNo		// IN: 
+)
+{
+	Four	state;
+
+	cosmos_thread_mutex_lock(&mutex);
+	state = states[morselNo];
+	cosmos_thread_mutex_unlock(&mutex);
+
+	return state;
+}
+
+Four OOSQL_ParallelScan::submit(
+	Four	morselNo		// IN: morsel read by the query thread
+)
+{
+	Four	e;
+
+	e = cosmos_thread_mutex_lock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	states[morselNo] = MORSEL_FILLED;
+	cosmos_thread_cond_signal(&filledCond);
+
+	e = cosmos_thread_mutex_unlock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	return eNOERROR;
+}
+
+Four OOSQL_ParallelScan::release(
+	Four	morselNo		// IN: morsel whose selected objects are all returned
+)
+{
+	Four	e;
+
+	e = cosmos_thread_mutex_lock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	states[morselNo] = MORSEL_EMPTY;
+	morsels[morselNo]->reset();
+	nextToConsume = (morselNo + 1) % nMorsels;
+
+	e = cosmos_thread_mutex_unlock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	return eNOERROR;
+}
+
+Four OOSQL_ParallelScan::waitFiltered(
+	Four	morselNo		// IN: 
+)
+/*
+    Function:
+		Wait until a worker filters the morsel.
+
+    Side effect:
+
+    Return value:
+		error code of filtering the morsel
+*/
+{
+	Four	e;
+
+	e = cosmos_thread_mutex_lock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	while(states[morselNo] != MORSEL_FILTERED)
+		cosmos_thread_cond_wait(&filteredCond, &mutex);
+
+	e = cosmos_thread_mutex_unlock(&mutex);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	return errors[morselNo];
+}
+
+void* OOSQL_ParallelScan::workerMain(
+	void*	arg				// IN: parallel scan
+)
+/*
+    Function:
+		Filter the filled morsels, the oldest one first, until the parallel
+		scan is destroyed.
+
+    Side effect:
+
+    Return value:
+*/
+{
+	OOSQL_ParallelScan*	parallelScan = (OOSQL_ParallelScan*)arg;
+	Four				morselNo;
+	Four				i;
+	Four				e;
+
+	cosmos_thread_mutex_lock(&parallelScan->mutex);
+
+	while(SM_TRUE)
+	{
+		morselNo = NIL;
+		while(!parallelScan->shutdown)
+		{
+			for(i = 0; i < parallelScan->nMorsels; i++)
+			{
+				morselNo = (parallelScan->nextToConsume + i) % parallelScan->nMorsels;
+				if(parallelScan->states[morselNo] == MORSEL_FILLED)
+					break;
+			}
+			if(i < parallelScan->nMorsels)
+				break;
+
+			morselNo = NIL;
+			cosmos_thread_cond_wait(&parallelScan->filledCond, &parallelScan->mutex);
+		}
+		if(parallelScan->shutdown)
+			break;
+
+		parallelScan->states[morselNo] = MORSEL_FILTERING;
+		cosmos_thread_mutex_unlock(&parallelScan->mutex);
+
+		e = parallelScan->evaluator->checkBatchWhereCond(parallelScan->morsels[morselNo]);
+
+		cosmos_thread_mutex_lock(&parallelScan->mutex);
+		parallelScan->errors[morselNo] = e;
+		parallelScan->states[morselNo] = MORSEL_FILTERED;
+		cosmos_thread_cond_signal(&parallelScan->filteredCond);
+	}
+
+	cosmos_thread_mutex_unlock(&parallelScan->mutex);
+
+	return NULL;
+}
+#endif
+
+
 Four    OOSQL_Evaluator::closeBtreeIndexScan(
     Four planIndex,             /* IN: */
     Four accessElemIndex        /* IN: */
@@ -1263,6 +2204,7 @@ Four    OOSQL_Evaluator::openMLGF_MBR_IndexScan(
     OOSQL_StorageManager::Region		region;
     Four								spatialOp;
     Four								scanId;
+    OOSQL_ScanInfo*						scanInfo;
     Four								e;
 
     /* check input parameters */
@@ -1401,21 +2343,62 @@ Four    OOSQL_Evaluator::openMLGF_MBR_IndexScan(
 			break;
         }
         
-		if(spatialOp == GEO_SPATIAL_KNN && !tidJoinIndexInfo.isNull())
+        /*
+         * A join probing the inner class many times reads the inner MBRs once
+         * and probes them in memory instead of opening an index scan per outer object.
+         */
+        scanInfo = &EVAL_INDEX_SCANINFOTABLEELEMENTS[accessElement->indexInfo.startIndex];
+        if(scanInfo->spatialJoin == NULL &&
+           indexInfoNode->scan.mlgfmbr.operandType == AP_SPATIAL_OPERAND_TYPE_PATHEXPR && !isUpdateQuery())
+        {
+            switch(indexInfoNode->scan.mlgfmbr.spatialOp)
+            {
+            case OP_GEO_CONTAIN:
+            case OP_GEO_CONTAINED:
+            case OP_GEO_COVER:
+            case OP_GEO_COVERED:
+            case OP_GEO_OVERLAP:
+            case OP_GEO_EQUAL:
+            case OP_GEO_MEET:
+                scanInfo->nProbes++;
+                break;
+            }
+
+            if(scanInfo->nProbes > OOSQL_SPATIALJOIN_MINNPROBES)
+            {
+                OOSQL_NEW(scanInfo->spatialJoin, pMemoryManager, OOSQL_SpatialHashJoin);
+                e = scanInfo->spatialJoin->build(m_storageManager, accessElement->ocn, indexInfoNode->scan.colNo, &lockup);
+                if(e < eNOERROR)
+                {
+                    OOSQL_DELETE(scanInfo->spatialJoin);
+                    scanInfo->spatialJoin = NULL;
+                    OOSQL_ERR(e);
+                }
+            }
+        }
+
+        if(scanInfo->spatialJoin)
+        {
+            e = scanInfo->spatialJoin->openProbe(region, indexInfoNode->scan.mlgfmbr.spatialOp);
+            OOSQL_CHECK_ERR(e);
+
+            scanId = -1;    /* no index scan to close */
+        }
+		else if(spatialOp == GEO_SPATIAL_KNN && !tidJoinIndexInfo.isNull())
 		{
 			indexInfo = ACCESSPLAN.getIndexInfoElem(tidJoinIndexInfo);
 			e = makeBtreeIndexBoundCond( &(indexInfo->scan.btree), &startBound, &stopBound );
 			OOSQL_CHECK_ERR(e);
 			scanId = m_storageManager->OpenMBRqueryScan(accessElement->ocn, &(indexInfoNode->scan.indexId),
                  	 region, spatialOp, 0, NULL, &lockup, &(indexInfo->scan.indexId), &startBound, &stopBound);
+			if(scanId < eNOERROR) OOSQL_ERR(scanId);
 		}
 		else
 		{
         scanId = m_storageManager->OpenMBRqueryScan(accessElement->ocn, &(indexInfoNode->scan.indexId),
                                                     region, spatialOp, 0, NULL, &lockup);
-		}										   
-
         if(scanId < eNOERROR) OOSQL_ERR(scanId);
+		}										   
         
         /* set scan Id in the entry of mlgf index scan Id table */
         EVAL_INDEX_SCANINFOTABLEELEMENTS[accessElement->indexInfo.startIndex].scanId   = scanId;
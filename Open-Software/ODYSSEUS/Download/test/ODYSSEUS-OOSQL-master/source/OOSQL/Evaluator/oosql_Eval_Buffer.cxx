@@ -832,6 +832,13 @@ Four	OOSQL_Evaluator::createSortStream(
 												userMemory, userMemorySize);
 	OOSQL_CHECK_ERR(e);
 
+	// ORDER BY with LIMIT reads only the first topK tuples of the sorted result
+	if(projInfo->topK > 0)
+	{
+		e = pTempFileInfo->sortStream->SetLimit(projInfo->topK);
+		OOSQL_CHECK_ERR(e);
+	}
+
     return eNOERROR;
 }
 
@@ -179,6 +179,12 @@ Four OOSQL_Evaluator::moveToAndOpenNextPlanElement()
                     OOSQL_ERR(e);
                 break;
 
+            case ACCESSMETHOD_HASHJOIN:
+                e = openHashJoin(m_currPlanIndex, i);
+                if (e < eNOERROR)
+                    OOSQL_ERR(e);
+                break;
+
             default:
                 OOSQL_ERR(eINVALID_CASE_OOSQL);
         } /* end of switch */
@@ -276,6 +282,12 @@ Four    OOSQL_Evaluator::backtrack()
                 if (e < eNOERROR)
                     OOSQL_ERR(e);
                 break;
+
+            case ACCESSMETHOD_HASHJOIN:
+                e = closeHashJoin(m_currPlanIndex, i);
+                if (e < eNOERROR)
+                    OOSQL_ERR(e);
+                break;
         }
     }
 
@@ -373,6 +385,12 @@ Four    OOSQL_Evaluator::moveToLastPlanElemOfNestedLoop()
                 if (e < eNOERROR)
                     OOSQL_ERR(e);
                 break;
+
+            case ACCESSMETHOD_HASHJOIN:
+                e = closeHashJoin(m_currPlanIndex, i);
+                if (e < eNOERROR)
+                    OOSQL_ERR(e);
+                break;
         }
     }
 
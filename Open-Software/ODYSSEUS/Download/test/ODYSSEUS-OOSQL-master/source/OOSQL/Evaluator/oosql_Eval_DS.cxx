@@ -329,6 +329,10 @@ OOSQL_ScanInfoTable::~OOSQL_ScanInfoTable()
 		{
 			if(scanInfos[i].boolExprs)
 				pMemoryManager->Free(scanInfos[i].boolExprs);
+			if(scanInfos[i].spatialJoin)
+				OOSQL_DELETE(scanInfos[i].spatialJoin);
+			if(scanInfos[i].hashJoin)
+				OOSQL_DELETE(scanInfos[i].hashJoin);
 		}
 
 		OOSQL_ARRAYDELETE(OOSQL_ScanInfo, scanInfos);
@@ -394,6 +398,11 @@ OOSQL_AccessList::OOSQL_AccessList()
     currAccessIndex = 0;
 	writeOcn		= -1;
 	writeColList	= NULL;
+	hashAggregation	= NULL;
+	batchScan		= NULL;
+#ifdef COSMOS_MULTITHREAD
+	parallelScan	= NULL;
+#endif
 
 }
 
@@ -109,6 +109,10 @@ Four OOSQL_Evaluator::checkWhereCond()
     Four					e;                      /* error code */
 	AP_CondListPoolElements whereCondNodes(m_pool->ap_condListPool);
 
+    /* the condition has already been checked for the batch the object was selected from */
+    if (EVAL_ACCESSLISTTABLE[m_currPlanIndex].batchScan != NULL && EVAL_ACCESSLISTTABLE[m_currPlanIndex].batchScan->isFiltered)
+        return SM_TRUE;
+
     m_isCheckingHavingCond = SM_FALSE;
 	whereCondNodes = m_currWhereCondNodes;
     for (i = 0; i < GET_POOLSIZE(whereCondNodes); i++) 
@@ -3659,3 +3663,499 @@ Four OOSQL_Evaluator::evalOGISOperator(
 	return eNOERROR;
 }
 #endif
+
+static Boolean isBatchNumericType(Four typeId)
+{
+	switch(typeId)
+	{
+	case OOSQL_TYPE_SHORT:
+	case OOSQL_TYPE_INT:
+	case OOSQL_TYPE_LONG:
+	case OOSQL_TYPE_LONG_LONG:
+	case OOSQL_TYPE_FLOAT:
+	case OOSQL_TYPE_DOUBLE:
+		return SM_TRUE;
+	default:
+		return SM_FALSE;
+	}
+}
+
+Four OOSQL_Evaluator::isBatchCond(
+	Four				planIndex,		// IN: plan element scanned a batch at a time
+	AP_ExprPoolIndex*	exprIdx			// IN: 
+)
+/*
+    Function:
+        Check if a condition can be evaluated over vectors, i.e. it consists
+        of AND, OR and arithmetic comparisons.
+
+    Side effect:
+
+    Return value:
+        SM_TRUE/SM_FALSE
+*/
+{
+	AP_ExprElement*	exprNode;
+	Four			e;
+
+	exprNode = ACCESSPLAN.getExprElem(*exprIdx);
+	if(exprNode->exprKind != EXPR_KIND_OPER)
+		return SM_FALSE;
+
+	switch(exprNode->oper.operatorId)
+	{
+	case OP_AND:
+	case OP_OR:
+		e = isBatchCond(planIndex, &(exprNode->oper.operand1));
+		if(e != SM_TRUE) return e;
+		return isBatchCond(planIndex, &(exprNode->oper.operand2));
+
+	case OP_EQ:
+	case OP_NE:
+	case OP_GT:
+	case OP_LT:
+	case OP_GE:
+	case OP_LE:
+		if(exprNode->oper.operatorType != ARITHMETIC_OPERATION)
+			return SM_FALSE;
+		e = isBatchValue(planIndex, &(exprNode->oper.operand1));
+		if(e != SM_TRUE) return e;
+		return isBatchValue(planIndex, &(exprNode->oper.operand2));
+
+	default:
+		return SM_FALSE;
+	}
+}
+
+Four OOSQL_Evaluator::isBatchValue(
+	Four				planIndex,		// IN: plan element scanned a batch at a time
+	AP_ExprPoolIndex*	exprIdx			// IN: 
+)
+/*
+    Function:
+        Check if an arithmetic expression can be evaluated over vectors, i.e.
+        it consists of +, -, *, numeric constants and numeric columns of the
+        scanned class. The columns are added to the batch scan.
+
+    Side effect:
+
+    Return value:
+        SM_TRUE/SM_FALSE
+*/
+{
+	AP_ExprElement*			exprNode;
+	AP_UsedColPoolElements	pUsedColPool;
+	ValueElement*			pValue;
+	Four					mappedColNo;
+	Four					e;
+
+	exprNode = ACCESSPLAN.getExprElem(*exprIdx);
+	if(!isBatchNumericType(exprNode->resultType))
+		return SM_FALSE;
+
+	switch(exprNode->exprKind)
+	{
+	case EXPR_KIND_PATHEXPR:
+		if(exprNode->pathExpr.kind != PATHEXPR_KIND_ATTR || exprNode->pathExpr.col.planNo != planIndex)
+			return SM_FALSE;
+
+		mappedColNo = ACCESSPLAN.getMappedColNo(planIndex, exprNode->pathExpr.col.colNo);
+		if(mappedColNo < 0)
+			return SM_FALSE;
+
+		pUsedColPool = ACCESSPLAN.getUsedColPool(planIndex);
+		if(!isBatchNumericType(pUsedColPool[mappedColNo].typeId))
+			return SM_FALSE;
+
+		e = EVAL_ACCESSLISTTABLE[planIndex].batchScan->addColumn(mappedColNo, pUsedColPool[mappedColNo].colNo, 
+			                                                     pUsedColPool[mappedColNo].typeId, pUsedColPool[mappedColNo].length);
+		OOSQL_CHECK_ERR(e);
+		return SM_TRUE;
+
+	case EXPR_KIND_VALUE:
+		pValue = ACCESSPLAN.getValueElem(exprNode->value);
+		if(pValue->valueKind == VALUE_KIND_INTEGER || pValue->valueKind == VALUE_KIND_REAL)
+			return SM_TRUE;
+		return SM_FALSE;
+
+	case EXPR_KIND_OPER:
+		switch(exprNode->oper.operatorId)
+		{
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MULTIPLY:
+			e = isBatchValue(planIndex, &(exprNode->oper.operand1));
+			if(e != SM_TRUE) return e;
+			return isBatchValue(planIndex, &(exprNode->oper.operand2));
+
+		case OP_UNARY_MINUS:
+			return isBatchValue(planIndex, &(exprNode->oper.operand1));
+
+		default:
+			return SM_FALSE;
+		}
+
+	default:
+		return SM_FALSE;
+	}
+}
+
+Four OOSQL_Evaluator::checkBatchWhereCond(
+	OOSQL_BatchScan*	batchScan		// INOUT: 
+)
+/*
+    Function:
+        Select the objects of a batch which satisfy the WHERE condition.
+
+    Side effect:
+        batchScan->selection and batchScan->nSelected are set.
+
+    Return value:
+*/
+{
+	AP_CondListPoolElements whereCondNodes(m_pool->ap_condListPool);
+	Four					i;
+	Four					e;
+
+	for(i = 0; i < batchScan->nObjects; i++)
+		batchScan->selection[i] = i;
+	batchScan->nSelected = batchScan->nObjects;
+
+	whereCondNodes = batchScan->condNodes;
+	for(i = 0; i < GET_POOLSIZE(whereCondNodes) && batchScan->nSelected > 0; i++)
+	{
+		e = evalBatchCond(batchScan, &(whereCondNodes[i].expr), batchScan->selection, &batchScan->nSelected);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	return eNOERROR;
+}
+
+#define BATCH_SELECT(values1, values2, cmp)										\
+	for(i = 0, k = 0; i < *nSelected; i++)										\
+	{																			\
+		r = selection[i];														\
+		if(!op1->nullFlags[r] && !op2->nullFlags[r] && values1[r] cmp values2[r])	\
+			selection[k++] = r;													\
+	}
+
+#define BATCH_SELECT_ALL(values1, values2)										\
+	switch(exprNode->oper.operatorId)											\
+	{																			\
+	case OP_EQ: BATCH_SELECT(values1, values2, ==); break;						\
+	case OP_NE: BATCH_SELECT(values1, values2, !=); break;						\
+	case OP_GT: BATCH_SELECT(values1, values2, >);  break;						\
+	case OP_LT: BATCH_SELECT(values1, values2, <);  break;						\
+	case OP_GE: BATCH_SELECT(values1, values2, >=); break;						\
+	case OP_LE: BATCH_SELECT(values1, values2, <=); break;						\
+	default:    OOSQL_ERR(eILLEGAL_OP_OOSQL);									\
+	}
+
+Four OOSQL_Evaluator::evalBatchCond(
+	OOSQL_BatchScan*	batchScan,		// IN: 
+	AP_ExprPoolIndex*	exprIdx,		// IN: 
+	Four*				selection,		// INOUT: objects to check, sorted
+	Four*				nSelected		// INOUT: 
+)
+/*
+    Function:
+        Remove the objects which do not satisfy a condition from a selection
+        vector. An object remains only if the condition is TRUE, so NULL
+        (UNKNOWN) removes an object as checkWhereCond() does.
+
+    Side effect:
+
+    Return value:
+*/
+{
+	AP_ExprElement*		exprNode;
+	OOSQL_BatchVector*	op1;
+	OOSQL_BatchVector*	op2;
+	Four*				selection1;
+	Four*				selection2;
+	Four				nSelected1;
+	Four				nSelected2;
+	Four				nUsedVectors;
+	Four				i, j, k, r;
+	Four				e;
+
+	exprNode = ACCESSPLAN.getExprElem(*exprIdx);
+
+	switch(exprNode->oper.operatorId)
+	{
+	case OP_AND:
+		e = evalBatchCond(batchScan, &(exprNode->oper.operand1), selection, nSelected);
+		OOSQL_CHECK_ERR(e);
+
+		if(*nSelected > 0)
+		{
+			e = evalBatchCond(batchScan, &(exprNode->oper.operand2), selection, nSelected);
+			OOSQL_CHECK_ERR(e);
+		}
+		break;
+
+	case OP_OR:
+		selection1 = batchScan->allocSelection();
+		selection2 = batchScan->allocSelection();
+		if(selection1 == NULL || selection2 == NULL)
+			OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		/* the 2nd operand is checked only for the objects the 1st operand does not select */
+		memcpy(selection1, selection, sizeof(Four) * (*nSelected));
+		nSelected1 = *nSelected;
+		e = evalBatchCond(batchScan, &(exprNode->oper.operand1), selection1, &nSelected1);
+		OOSQL_CHECK_ERR(e);
+
+		for(i = 0, j = 0, nSelected2 = 0; i < *nSelected; i++)
+		{
+			if(j < nSelected1 && selection1[j] == selection[i])
+				j++;
+			else
+				selection2[nSelected2++] = selection[i];
+		}
+
+		if(nSelected2 > 0)
+		{
+			e = evalBatchCond(batchScan, &(exprNode->oper.operand2), selection2, &nSelected2);
+			OOSQL_CHECK_ERR(e);
+		}
+
+		/* merge the two selections */
+		for(i = 0, j = 0, k = 0; i < nSelected1 || j < nSelected2; )
+		{
+			if(j == nSelected2 || (i < nSelected1 && selection1[i] < selection2[j]))
+				selection[k++] = selection1[i++];
+			else
+				selection[k++] = selection2[j++];
+		}
+		*nSelected = k;
+
+		batchScan->nUsedSelections -= 2;
+		break;
+
+	case OP_EQ:
+	case OP_NE:
+	case OP_GT:
+	case OP_LT:
+	case OP_GE:
+	case OP_LE:
+		nUsedVectors = batchScan->nUsedVectors;
+
+		e = evalBatchValue(batchScan, &(exprNode->oper.operand1), selection, *nSelected, &op1);
+		OOSQL_CHECK_ERR(e);
+		e = evalBatchValue(batchScan, &(exprNode->oper.operand2), selection, *nSelected, &op2);
+		OOSQL_CHECK_ERR(e);
+
+		if(op1->isReal != op2->isReal)
+		{
+			e = convertBatchVectorToReal(batchScan, selection, *nSelected, &op1);
+			OOSQL_CHECK_ERR(e);
+			e = convertBatchVectorToReal(batchScan, selection, *nSelected, &op2);
+			OOSQL_CHECK_ERR(e);
+		}
+
+		if(op1->isReal)
+		{
+			BATCH_SELECT_ALL(op1->rvalues, op2->rvalues);
+		}
+		else
+		{
+			BATCH_SELECT_ALL(op1->ivalues, op2->ivalues);
+		}
+		*nSelected = k;
+
+		batchScan->nUsedVectors = nUsedVectors;
+		break;
+
+	default:
+		OOSQL_ERR(eILLEGAL_OP_OOSQL);
+	}
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::evalBatchValue(
+	OOSQL_BatchScan*	batchScan,		// IN: 
+	AP_ExprPoolIndex*	exprIdx,		// IN: 
+	Four*				selection,		// IN: objects to evaluate
+	Four				nSelected,		// IN: 
+	OOSQL_BatchVector**	res				// OUT: values of the selected objects
+)
+/*
+    Function:
+        Evaluate an arithmetic expression for the selected objects of a batch.
+
+    Side effect:
+        Scratch vectors of the batch scan are allocated.
+
+    Return value:
+*/
+{
+	AP_ExprElement*			exprNode;
+	ValueElement*			pValue;
+	OOSQL_BatchVector*		op1;
+	OOSQL_BatchVector*		op2;
+	OOSQL_BatchVector*		v;
+	Boolean					isReal;
+	Eight_Invariable		ivalue;
+	double					rvalue;
+	Four					i, r;
+	Four					e;
+
+	exprNode = ACCESSPLAN.getExprElem(*exprIdx);
+	isReal   = (exprNode->resultType == OOSQL_TYPE_FLOAT || exprNode->resultType == OOSQL_TYPE_DOUBLE) ? SM_TRUE : SM_FALSE;
+
+	switch(exprNode->exprKind)
+	{
+	case EXPR_KIND_PATHEXPR:
+		*res = &batchScan->colVectors[batchScan->colMap[ACCESSPLAN.getMappedColNo(exprNode->pathExpr.col.planNo, 
+			                                                                      exprNode->pathExpr.col.colNo)]];
+		return eNOERROR;
+
+	case EXPR_KIND_VALUE:
+		pValue = ACCESSPLAN.getValueElem(exprNode->value);
+
+		v = batchScan->allocVector(isReal);
+		if(v == NULL) OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		if(pValue->valueKind == VALUE_KIND_REAL)
+		{
+			rvalue    = ACCESSPLAN.getRealValue(pValue->real);
+			v->isReal = SM_TRUE;
+			for(i = 0; i < nSelected; i++)
+			{
+				r = selection[i];
+				v->rvalues[r]   = rvalue;
+				v->nullFlags[r] = SM_FALSE;
+			}
+		}
+		else if(v->isReal)
+		{
+			rvalue = (double)ACCESSPLAN.getIntValue(pValue->integer);
+			for(i = 0; i < nSelected; i++)
+			{
+				r = selection[i];
+				v->rvalues[r]   = rvalue;
+				v->nullFlags[r] = SM_FALSE;
+			}
+		}
+		else
+		{
+			ivalue = ACCESSPLAN.getIntValue(pValue->integer);
+			for(i = 0; i < nSelected; i++)
+			{
+				r = selection[i];
+				v->ivalues[r]   = ivalue;
+				v->nullFlags[r] = SM_FALSE;
+			}
+		}
+
+		*res = v;
+		return eNOERROR;
+
+	case EXPR_KIND_OPER:
+		e = evalBatchValue(batchScan, &(exprNode->oper.operand1), selection, nSelected, &op1);
+		OOSQL_CHECK_ERR(e);
+
+		if(exprNode->oper.operatorId == OP_UNARY_MINUS)
+		{
+			v = batchScan->allocVector(op1->isReal);
+			if(v == NULL) OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+			for(i = 0; i < nSelected; i++)
+			{
+				r = selection[i];
+				v->nullFlags[r] = op1->nullFlags[r];
+				if(v->isReal)
+					v->rvalues[r] = -op1->rvalues[r];
+				else
+					v->ivalues[r] = -op1->ivalues[r];
+			}
+
+			*res = v;
+			return eNOERROR;
+		}
+
+		e = evalBatchValue(batchScan, &(exprNode->oper.operand2), selection, nSelected, &op2);
+		OOSQL_CHECK_ERR(e);
+
+		if(isReal || op1->isReal || op2->isReal)
+		{
+			isReal = SM_TRUE;
+			e = convertBatchVectorToReal(batchScan, selection, nSelected, &op1);
+			OOSQL_CHECK_ERR(e);
+			e = convertBatchVectorToReal(batchScan, selection, nSelected, &op2);
+			OOSQL_CHECK_ERR(e);
+		}
+
+		v = batchScan->allocVector(isReal);
+		if(v == NULL) OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		for(i = 0; i < nSelected; i++)
+		{
+			r = selection[i];
+			v->nullFlags[r] = op1->nullFlags[r] | op2->nullFlags[r];
+		}
+
+		switch(exprNode->oper.operatorId)
+		{
+		case OP_PLUS:
+			if(isReal)
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->rvalues[r] = op1->rvalues[r] + op2->rvalues[r]; }
+			else
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->ivalues[r] = op1->ivalues[r] + op2->ivalues[r]; }
+			break;
+
+		case OP_MINUS:
+			if(isReal)
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->rvalues[r] = op1->rvalues[r] - op2->rvalues[r]; }
+			else
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->ivalues[r] = op1->ivalues[r] - op2->ivalues[r]; }
+			break;
+
+		case OP_MULTIPLY:
+			if(isReal)
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->rvalues[r] = op1->rvalues[r] * op2->rvalues[r]; }
+			else
+				for(i = 0; i < nSelected; i++) { r = selection[i]; v->ivalues[r] = op1->ivalues[r] * op2->ivalues[r]; }
+			break;
+
+		default:
+			OOSQL_ERR(eILLEGAL_OP_OOSQL);
+		}
+
+		*res = v;
+		return eNOERROR;
+
+	default:
+		OOSQL_ERR(eINVALID_EXPRESSION_OOSQL);
+	}
+}
+
+Four OOSQL_Evaluator::convertBatchVectorToReal(
+	OOSQL_BatchScan*	batchScan,		// IN: 
+	Four*				selection,		// IN: 
+	Four				nSelected,		// IN: 
+	OOSQL_BatchVector**	v				// INOUT: 
+)
+{
+	OOSQL_BatchVector*	realVector;
+	Four				i, r;
+
+	if((*v)->isReal)
+		return eNOERROR;
+
+	realVector = batchScan->allocVector(SM_TRUE);
+	if(realVector == NULL) OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+	for(i = 0; i < nSelected; i++)
+	{
+		r = selection[i];
+		realVector->rvalues[r]   = (double)(*v)->ivalues[r];
+		realVector->nullFlags[r] = (*v)->nullFlags[r];
+	}
+
+	*v = realVector;
+
+	return eNOERROR;
+}
@@ -78,10 +78,21 @@
         This module implements member functions of OOSQL_Evaluator
         that are related to grouping processing.
 
+        When the plan generator expects few groups, the groups are made
+        by hashing the input instead of sorting it. Each group is kept in
+        memory with its intermediate aggregate function results and the
+        groups are returned one by one after the whole input is read.
+        Objects of new groups which do not fit in the sort buffer are
+        spilled to temporary files by hash value and aggregated later.
+
     IMPORTS:
 
     EXPORTS:
         Four    OOSQL_Evaluator::grouping()
+        Four    OOSQL_HashAggregation::probe(UFour, Four*)
+        Four    OOSQL_HashAggregation::insert(UFour)
+        Four    OOSQL_Evaluator::hashAggregationNext(Four, Four)
+        Four    OOSQL_Evaluator::finalHashAggregation(Four)
 */
 
 
@@ -90,6 +101,7 @@
  */
 #include "OOSQL_Evaluator.hxx"
 #include "oosql_Eval_Expr.hxx"
+#include "oosql_Eval_Access.hxx"
 
 
 Four    OOSQL_Evaluator::grouping()
@@ -235,3 +247,864 @@ Four    OOSQL_Evaluator::isSameGroupByKey()
 
     return SM_TRUE;
 }
+
+
+OOSQL_HashAggregation::OOSQL_HashAggregation(
+	Four	nCols,				// IN: the # of columns of the evaluation buffer
+	Four	memoryLimit_		// IN: the # of bytes the hash table may use
+)
+{
+	Four	i;
+
+	recordSize  = 0;
+	strOffsets  = (Four*)pMemoryManager->Alloc(sizeof(Four) * (nCols + 1));
+	for(i = 0; i < nCols; i++)
+		strOffsets[i] = NIL;
+
+	memoryLimit = memoryLimit_;
+	memoryUsed  = 0;
+	level       = 0;
+	nGroups     = 0;
+	nextGroup   = 0;
+
+	for(i = 0; i < OOSQL_HASHAGGR_NPARTITIONS; i++)
+		spillFiles[i] = NULL;
+
+	tableSize  = 0;
+	table      = NULL;
+	hashValues = NULL;
+	records    = NULL;
+	nAllocated = 0;
+
+	pendingFiles           = NULL;
+	pendingLevels          = NULL;
+	nPendingFiles          = 0;
+	nAllocatedPendingFiles = 0;
+}
+
+OOSQL_HashAggregation::~OOSQL_HashAggregation()
+{
+	Four	i;
+
+	clear();
+
+	for(i = 0; i < OOSQL_HASHAGGR_NPARTITIONS; i++)
+		if(spillFiles[i])
+			OOSQL_DELETE(spillFiles[i]);
+
+	for(i = 0; i < nPendingFiles; i++)
+		OOSQL_DELETE(pendingFiles[i]);
+
+	if(pendingFiles)
+		pMemoryManager->Free(pendingFiles);
+	if(pendingLevels)
+		pMemoryManager->Free(pendingLevels);
+	if(strOffsets)
+		pMemoryManager->Free(strOffsets);
+}
+
+Four OOSQL_HashAggregation::probe(
+	UFour	hashValue,		// IN: hash value of the group by keys
+	Four*	slot			// INOUT: the slot to examine; the slot after the returned group
+)
+/*
+    Function:
+		Find the next group having the same hash value by linear probing.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+		index of the group or NIL if there is no more group
+*/
+{
+	Four	group;
+
+	if(tableSize == 0)
+		return NIL;
+
+	while((group = table[*slot]) != NIL)
+	{
+		*slot = (*slot + 1) & (tableSize - 1);
+		if(hashValues[group] == hashValue)
+			return group;
+	}
+
+	return NIL;
+}
+
+Four OOSQL_HashAggregation::insert(
+	UFour	hashValue		// IN: hash value of the group by keys
+)
+/*
+    Function:
+		Make a new group. The caller saves the group into getRecord().
+
+    Side effect:
+		The saved groups may be moved.
+
+    Referenced member variables:
+
+    Return value:
+		index of the new group
+*/
+{
+	Four	slot;
+	Four	n;
+	Four	e;
+
+	if(nGroups == nAllocated)
+	{
+		n = (nAllocated == 0) ? 256 : nAllocated * 2;
+		if(records)
+		{
+			records    = (char*)pMemoryManager->Realloc(records, recordSize * n);
+			hashValues = (UFour*)pMemoryManager->Realloc(hashValues, sizeof(UFour) * n);
+		}
+		else
+		{
+			records    = (char*)pMemoryManager->Alloc(recordSize * n);
+			hashValues = (UFour*)pMemoryManager->Alloc(sizeof(UFour) * n);
+		}
+		if(records == NULL || hashValues == NULL)
+			OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		memoryUsed += (recordSize + sizeof(UFour)) * (n - nAllocated);
+		nAllocated  = n;
+	}
+
+	/* keep the load factor under 1/2 */
+	if((nGroups + 1) * 2 > tableSize)
+	{
+		e = grow();
+		OOSQL_CHECK_ERR(e);
+	}
+
+	slot = getSlot(hashValue);
+	while(table[slot] != NIL)
+		slot = (slot + 1) & (tableSize - 1);
+
+	table[slot]         = nGroups;
+	hashValues[nGroups] = hashValue;
+
+	return nGroups++;
+}
+
+Four OOSQL_HashAggregation::grow()
+{
+	Four	slot;
+	Four	n;
+	Four	i;
+
+	n = (tableSize == 0) ? 512 : tableSize * 2;
+
+	if(table)
+		pMemoryManager->Free(table);
+	table = (Four*)pMemoryManager->Alloc(sizeof(Four) * n);
+	if(table == NULL)
+		OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+	memoryUsed += sizeof(Four) * (n - tableSize);
+	tableSize   = n;
+
+	for(i = 0; i < tableSize; i++)
+		table[i] = NIL;
+
+	for(i = 0; i < nGroups; i++)
+	{
+		slot = getSlot(hashValues[i]);
+		while(table[slot] != NIL)
+			slot = (slot + 1) & (tableSize - 1);
+		table[slot] = i;
+	}
+
+	return eNOERROR;
+}
+
+void OOSQL_HashAggregation::clear()
+{
+	if(table)
+		pMemoryManager->Free(table);
+	if(hashValues)
+		pMemoryManager->Free(hashValues);
+	if(records)
+		pMemoryManager->Free(records);
+
+	table      = NULL;
+	hashValues = NULL;
+	records    = NULL;
+	tableSize  = 0;
+	nAllocated = 0;
+	memoryUsed = 0;
+	nGroups    = 0;
+	nextGroup  = 0;
+}
+
+Four OOSQL_HashAggregation::pushSpillFile(
+	OOSQL_TempFileInfo*	spillFile,	// IN: 
+	Four				spillLevel	// IN: level of the input the file was spilled from
+)
+{
+	Four	n;
+
+	if(nPendingFiles == nAllocatedPendingFiles)
+	{
+		n = (nAllocatedPendingFiles == 0) ? OOSQL_HASHAGGR_NPARTITIONS : nAllocatedPendingFiles * 2;
+		if(pendingFiles)
+		{
+			pendingFiles  = (OOSQL_TempFileInfo**)pMemoryManager->Realloc(pendingFiles, sizeof(OOSQL_TempFileInfo*) * n);
+			pendingLevels = (Four*)pMemoryManager->Realloc(pendingLevels, sizeof(Four) * n);
+		}
+		else
+		{
+			pendingFiles  = (OOSQL_TempFileInfo**)pMemoryManager->Alloc(sizeof(OOSQL_TempFileInfo*) * n);
+			pendingLevels = (Four*)pMemoryManager->Alloc(sizeof(Four) * n);
+		}
+		if(pendingFiles == NULL || pendingLevels == NULL)
+			OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		nAllocatedPendingFiles = n;
+	}
+
+	pendingFiles[nPendingFiles]  = spillFile;
+	pendingLevels[nPendingFiles] = spillLevel;
+	nPendingFiles++;
+
+	return eNOERROR;
+}
+
+OOSQL_TempFileInfo* OOSQL_HashAggregation::popSpillFile(
+	Four*	spillLevel		// OUT: level of the input the file was spilled from
+)
+{
+	if(nPendingFiles == 0)
+		return NULL;
+
+	nPendingFiles--;
+	*spillLevel = pendingLevels[nPendingFiles];
+
+	return pendingFiles[nPendingFiles];
+}
+
+
+Four    OOSQL_Evaluator::hashAggregationNext(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+        Return the next group made by hashing. The whole input is aggregated
+        at the first call.
+
+    Side effect:
+        The evaluation buffer of the plan element holds the first object of
+        the group and the intermediate aggregate function results.
+
+    Referenced member variables:
+
+    Return value:
+        eNOERROR        if a group is returned
+        ENDOFSCAN       if all groups are returned
+*/
+{
+	OOSQL_HashAggregation*	hashAggr;
+	OOSQL_TempFileInfo*		spillFile;
+	Four					level;
+	Four					e;
+
+	if(EVAL_ACCESSLISTTABLE[planIndex].hashAggregation == NULL)
+	{
+		e = initHashAggregation(planIndex);
+		OOSQL_CHECK_ERR(e);
+
+		e = buildHashAggregation(planIndex, accessElemIndex, NULL, 0);
+		OOSQL_CHECK_ERR(e);
+	}
+	hashAggr = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+
+	while(1)
+	{
+		if(hashAggr->nextGroup < hashAggr->nGroups)
+		{
+			e = restoreHashGroup(planIndex, hashAggr->getRecord(hashAggr->nextGroup), SM_FALSE);
+			OOSQL_CHECK_ERR(e);
+			hashAggr->nextGroup++;
+
+			return eNOERROR;
+		}
+
+		/* all groups in memory are returned, so aggregate the next spilled file */
+		hashAggr->clear();
+
+		spillFile = hashAggr->popSpillFile(&level);
+		if(spillFile == NULL)
+			return ENDOFSCAN;
+
+		e = buildHashAggregation(planIndex, accessElemIndex, spillFile, level + 1);
+		if(e < eNOERROR)
+		{
+			destroyHashAggregationFile(spillFile);
+			OOSQL_ERR(e);
+		}
+
+		e = destroyHashAggregationFile(spillFile);
+		OOSQL_CHECK_ERR(e);
+	}
+}
+
+Four    OOSQL_Evaluator::initHashAggregation(
+    Four planIndex                      /* IN: */
+)
+/*
+    Function:
+        Make the hash table and the layout of a saved group.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_EvalBuffer*		evalBuffer;
+	OOSQL_HashAggregation*	hashAggr;
+	AP_UsedColPoolElements	pUsedColPool;
+	Four					memoryLimit;
+	Four					recordSize;
+	Four					i;
+
+	evalBuffer   = &EVAL_EVALBUFFER[planIndex];
+	pUsedColPool = ACCESSPLAN.getUsedColPool(planIndex);
+
+	/* the hash table uses the memory of the sort buffer */
+	if(m_sortBufferInfo.mode == OOSQL_SB_USE_DISK)
+		memoryLimit = OOSQL_DEFAULT_INMEMORY_SORTBUFFER_FOR_SORTSTREAM;
+	else
+		memoryLimit = m_sortBufferInfo.memoryInfo.sortBufferLength;
+
+	OOSQL_NEW(hashAggr, pMemoryManager, OOSQL_HashAggregation(evalBuffer->nCols, memoryLimit));
+	EVAL_ACCESSLISTTABLE[planIndex].hashAggregation = hashAggr;
+
+	/* a saved group consists of the column slots, the aggregate function result slots,
+	 * the # of tuples for SUM and AVG and the strings of the columns
+	 */
+	recordSize = sizeof(EVAL_EvalBufferSlot) * (evalBuffer->nCols + evalBuffer->nAggrFuncResults) +
+		         sizeof(Four) * evalBuffer->nAggrFuncResults;
+
+	for(i = 0; i < evalBuffer->nCols; i++)
+	{
+        switch(pUsedColPool[i].typeId) 
+		{
+        case OOSQL_TYPE_STRING:
+        case OOSQL_TYPE_VARSTRING:
+        case OOSQL_TYPE_GEOMETRY:
+        case OOSQL_TYPE_POINT:
+        case OOSQL_TYPE_LINESTRING:
+        case OOSQL_TYPE_POLYGON:
+        case OOSQL_TYPE_GEOMETRYCOLLECTION:
+        case OOSQL_TYPE_MULTIPOINT:
+        case OOSQL_TYPE_MULTILINESTRING:
+        case OOSQL_TYPE_MULTIPOLYGON:
+			hashAggr->strOffsets[i] = recordSize;
+			recordSize += evalBuffer->clist[i].length + 1;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	/* align saved groups on the boundary of a double */
+	hashAggr->recordSize = (recordSize + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::buildHashAggregation(
+    Four				planIndex,          /* IN: */
+    Four				accessElemIndex,    /* IN: */
+	OOSQL_TempFileInfo*	input,				/* IN: spilled file to read or NULL to read the plan element */
+	Four				level				/* IN: the # of times the input has been partitioned */
+)
+/*
+    Function:
+        Aggregate all objects of the input into the hash table.
+
+    Side effect:
+        The files spilled from the input are queued to be aggregated.
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_HashAggregation*				hashAggr;
+	OOSQL_StorageManager::LockParameter	lockup;
+	OOSQL_StorageManager::OID			oid;
+	Four								scanId;
+	Four								i;
+	Four								e;
+
+	hashAggr        = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	hashAggr->level = level;
+
+	if(input == NULL)
+	{
+		while((e = seqScanNext(planIndex, accessElemIndex)) != ENDOFSCAN)
+		{
+			if(e < eNOERROR) OOSQL_ERR(e);
+
+			e = insertHashAggregation(planIndex);
+			OOSQL_CHECK_ERR(e);
+		}
+	}
+	else
+	{
+		lockup.mode     = OOSQL_StorageManager::L_X;
+		lockup.duration = OOSQL_StorageManager::L_COMMIT;
+
+		scanId = m_storageManager->OpenSeqScan(input->ocn, FORWARD, 0, NULL, &lockup);
+		if(scanId < eNOERROR) OOSQL_ERR(scanId);
+
+		while((e = m_storageManager->NextObject(scanId, &oid, NULL)) != EOS)
+		{
+			if(e < eNOERROR) OOSQL_ERR(e);
+
+			e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, &oid, 
+				                                       EVAL_EVALBUFFER[planIndex].nCols, EVAL_EVALBUFFER[planIndex].clist);
+			if(e < eNOERROR) OOSQL_ERR(e);
+
+			e = insertHashAggregation(planIndex);
+			OOSQL_CHECK_ERR(e);
+		}
+
+		e = m_storageManager->CloseScan(scanId);
+		if(e < eNOERROR) OOSQL_ERR(e);
+	}
+
+	/* the files spilled from this input are aggregated after the groups in memory */
+	for(i = 0; i < OOSQL_HASHAGGR_NPARTITIONS; i++)
+	{
+		if(hashAggr->spillFiles[i] == NULL) continue;
+
+		e = hashAggr->pushSpillFile(hashAggr->spillFiles[i], level);
+		OOSQL_CHECK_ERR(e);
+		hashAggr->spillFiles[i] = NULL;
+	}
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::insertHashAggregation(
+    Four planIndex                      /* IN: */
+)
+/*
+    Function:
+        Aggregate the object in the evaluation buffer into its group.
+        If the group is not in memory and the hash table is full, the object
+        is spilled instead.
+
+    Side effect:
+        m_evalStatus.aggregationStatus is changed.
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_HashAggregation*	hashAggr;
+	UFour					hashValue;
+	Four					slot;
+	Four					group;
+	Boolean					hasAggrFunc;
+	Four					e;
+
+	hashAggr    = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	hasAggrFunc = IS_NULL_POOLINDEX(ACCESSPLANELEMENTS[planIndex].aggrFuncInfo) ? SM_FALSE : SM_TRUE;
+
+	e = hashGroupByKey(planIndex, &hashValue);
+	OOSQL_CHECK_ERR(e);
+
+	/* find the group of the object */
+	slot = hashAggr->getSlot(hashValue);
+	while((group = hashAggr->probe(hashValue, &slot)) != NIL)
+	{
+		e = isSameHashGroup(planIndex, hashAggr->getRecord(group));
+		OOSQL_CHECK_ERR(e);
+		if(e == SM_TRUE) break;
+	}
+
+	if(group != NIL)
+	{
+		if(hasAggrFunc)
+		{
+			e = restoreHashGroup(planIndex, hashAggr->getRecord(group), SM_TRUE);
+			OOSQL_CHECK_ERR(e);
+
+			m_evalStatus.aggregationStatus = EVALSTATUS_PROCESSING;
+			e = aggregation();
+			OOSQL_CHECK_ERR(e);
+
+			e = saveHashGroup(planIndex, hashAggr->getRecord(group), SM_TRUE);
+			OOSQL_CHECK_ERR(e);
+		}
+
+		return eNOERROR;
+	}
+
+	if(hashAggr->isFull())
+	{
+		e = spillHashAggregation(planIndex, hashAggr->getPartition(hashValue));
+		OOSQL_CHECK_ERR(e);
+
+		return eNOERROR;
+	}
+
+	/* make a new group */
+	group = hashAggr->insert(hashValue);
+	OOSQL_CHECK_ERR(group);
+
+	if(hasAggrFunc)
+	{
+		m_evalStatus.aggregationStatus = EVALSTATUS_INIT;
+		e = aggregation();
+		OOSQL_CHECK_ERR(e);
+	}
+
+	e = saveHashGroup(planIndex, hashAggr->getRecord(group), SM_FALSE);
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::hashGroupByKey(
+    Four	planIndex,                  /* IN: */
+	UFour*	hashValue					/* OUT: */
+)
+/*
+    Function:
+        Hash the group by keys of the object in the evaluation buffer.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+    AP_UsedColPoolElements	pUsedColPool;
+	OOSQL_HashAggregation*	hashAggr;
+	EVAL_EvalBufferSlot*	clist;
+	UFour					keyHashValue;
+    Four					grpByColNo;
+    Four					i;
+
+    pUsedColPool = ACCESSPLAN.getUsedColPool(planIndex);
+	hashAggr     = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+
+	*hashValue = 2166136261U;
+    for (i = 0; i < ACCESSPLANELEMENTS[planIndex].nGrpByKeys; i++) {
+        grpByColNo = ACCESSPLANELEMENTS[planIndex].grpByKeys[i];
+		clist      = EVAL_EVALBUFFER[planIndex].getColSlotPtr(grpByColNo);
+
+		if(clist->nullFlag)
+			keyHashValue = 0;
+		else
+		{
+			switch(pUsedColPool[grpByColNo].typeId)
+			{
+			case OOSQL_TYPE_SHORT:
+				keyHashValue = OOSQL_HashJoin::hashNumber((double)clist->data.s);
+				break;
+			case OOSQL_TYPE_INT:
+				keyHashValue = OOSQL_HashJoin::hashNumber((double)clist->data.i);
+				break;
+			case OOSQL_TYPE_LONG:
+				keyHashValue = OOSQL_HashJoin::hashNumber((double)clist->data.l);
+				break;
+			case OOSQL_TYPE_LONG_LONG:
+				keyHashValue = OOSQL_HashJoin::hashNumber((double)clist->data.ll);
+				break;
+			case OOSQL_TYPE_FLOAT:
+				keyHashValue = OOSQL_HashJoin::hashNumber((double)clist->data.f);
+				break;
+			case OOSQL_TYPE_DOUBLE:
+				keyHashValue = OOSQL_HashJoin::hashNumber(clist->data.d);
+				break;
+			default:
+				if(hashAggr->strOffsets[grpByColNo] != NIL)
+					keyHashValue = OOSQL_HashJoin::hashString((char*)clist->data.ptr, clist->retLength);
+				else
+					keyHashValue = OOSQL_HashJoin::hashString((char*)&clist->data, pUsedColPool[grpByColNo].length);
+				break;
+			}
+		}
+
+		*hashValue = (*hashValue ^ keyHashValue) * 16777619U;
+	}
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::isSameHashGroup(
+    Four	planIndex,                  /* IN: */
+	char*	record						/* IN: saved group */
+)
+/*
+    Function:
+        Check if the object in the evaluation buffer belongs to a saved group.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+        SM_TRUE/SM_FALSE
+*/
+{
+    AP_UsedColPoolElements	pUsedColPool;
+	OOSQL_HashAggregation*	hashAggr;
+	EVAL_EvalBufferSlot*	clist;
+	EVAL_EvalBufferSlot		grpByKey;
+    Four					grpByColNo;
+    Four					i;
+    Four					e;
+
+    pUsedColPool = ACCESSPLAN.getUsedColPool(planIndex);
+	hashAggr     = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+
+    for (i = 0; i < ACCESSPLANELEMENTS[planIndex].nGrpByKeys; i++) {
+        grpByColNo = ACCESSPLANELEMENTS[planIndex].grpByKeys[i];
+		clist      = EVAL_EVALBUFFER[planIndex].getColSlotPtr(grpByColNo);
+
+		/* the saved string is in the saved group */
+		grpByKey = ((EVAL_EvalBufferSlot*)record)[grpByColNo];
+		if(hashAggr->strOffsets[grpByColNo] != NIL)
+			grpByKey.data.ptr = record + hashAggr->strOffsets[grpByColNo];
+
+        e = compareColListStruct(pUsedColPool[grpByColNo].typeId, clist, &grpByKey);
+        if (e < eNOERROR) OOSQL_ERR(e);
+
+		if (e == CMP_UN) {  /* Either or both argument value is NULL */
+			/* if both argument values are NULL, we suppose this values are not distinct one */
+			if (!clist->nullFlag || !grpByKey.nullFlag)
+				return SM_FALSE;
+		}
+		else if (e != CMP_EQ) {      // different group 
+			return SM_FALSE;
+        }
+    }
+
+    return SM_TRUE;
+}
+
+Four    OOSQL_Evaluator::saveHashGroup(
+    Four	planIndex,                  /* IN: */
+	char*	record,						/* OUT: saved group */
+	Boolean	aggrOnly					/* IN: TRUE to save the aggregate function results only */
+)
+{
+	OOSQL_EvalBuffer*		evalBuffer;
+	OOSQL_HashAggregation*	hashAggr;
+	EVAL_EvalBufferSlot*	cols;
+	EVAL_EvalBufferSlot*	aggrFuncResults;
+	Four*					nTuples;
+	Four					i;
+
+	evalBuffer      = &EVAL_EVALBUFFER[planIndex];
+	hashAggr        = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	cols            = (EVAL_EvalBufferSlot*)record;
+	aggrFuncResults = cols + evalBuffer->nCols;
+	nTuples         = (Four*)(aggrFuncResults + evalBuffer->nAggrFuncResults);
+
+	if(!aggrOnly)
+	{
+		memcpy(cols, evalBuffer->clist, sizeof(EVAL_EvalBufferSlot) * evalBuffer->nCols);
+		for(i = 0; i < evalBuffer->nCols; i++)
+		{
+			if(hashAggr->strOffsets[i] != NIL && !cols[i].nullFlag && cols[i].retLength > 0)
+				memcpy(record + hashAggr->strOffsets[i], evalBuffer->clist[i].data.ptr, cols[i].retLength);
+		}
+	}
+
+	memcpy(aggrFuncResults, evalBuffer->aggrFuncResults, sizeof(EVAL_EvalBufferSlot) * evalBuffer->nAggrFuncResults);
+	memcpy(nTuples, evalBuffer->nTuplesForSumAndAvg, sizeof(Four) * evalBuffer->nAggrFuncResults);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::restoreHashGroup(
+    Four	planIndex,                  /* IN: */
+	char*	record,						/* IN: saved group */
+	Boolean	aggrOnly					/* IN: TRUE to restore the aggregate function results only */
+)
+{
+	OOSQL_EvalBuffer*		evalBuffer;
+	OOSQL_HashAggregation*	hashAggr;
+	EVAL_EvalBufferSlot*	cols;
+	EVAL_EvalBufferSlot*	aggrFuncResults;
+	Four*					nTuples;
+	void*					strBuf;
+	Four					i;
+
+	evalBuffer      = &EVAL_EVALBUFFER[planIndex];
+	hashAggr        = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	cols            = (EVAL_EvalBufferSlot*)record;
+	aggrFuncResults = cols + evalBuffer->nCols;
+	nTuples         = (Four*)(aggrFuncResults + evalBuffer->nAggrFuncResults);
+
+	if(!aggrOnly)
+	{
+		for(i = 0; i < evalBuffer->nCols; i++)
+		{
+			if(hashAggr->strOffsets[i] != NIL)
+			{
+				/* the string stays in the string buffer of the evaluation buffer */
+				strBuf                        = evalBuffer->clist[i].data.ptr;
+				evalBuffer->clist[i]          = cols[i];
+				evalBuffer->clist[i].data.ptr = strBuf;
+				if(!cols[i].nullFlag && cols[i].retLength > 0)
+					memcpy(strBuf, record + hashAggr->strOffsets[i], cols[i].retLength);
+			}
+			else
+				evalBuffer->clist[i] = cols[i];
+		}
+	}
+
+	memcpy(evalBuffer->aggrFuncResults, aggrFuncResults, sizeof(EVAL_EvalBufferSlot) * evalBuffer->nAggrFuncResults);
+	memcpy(evalBuffer->nTuplesForSumAndAvg, nTuples, sizeof(Four) * evalBuffer->nAggrFuncResults);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::spillHashAggregation(
+    Four	planIndex,                  /* IN: */
+	Four	partition					/* IN: */
+)
+/*
+    Function:
+        Write the object in the evaluation buffer to the temporary file of
+        its partition. The file has the columns of the input temporary file.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_HashAggregation*	hashAggr;
+	OOSQL_TempFileInfo*		spillFile;
+	OOSQL_TempFileInfo*		tempFileInfo;
+	OOSQL_EvalBuffer*		evalBuffer;
+	Four					i;
+	Four					e;
+
+	hashAggr   = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	evalBuffer = &EVAL_EVALBUFFER[planIndex];
+	spillFile  = hashAggr->spillFiles[partition];
+
+	if(spillFile == NULL)
+	{
+		tempFileInfo = EVAL_TEMPFILEINFOTABLEELEMENTS[ACCESSPLANELEMENTS[planIndex].classInfo.tempFileNum];
+
+		OOSQL_NEW(spillFile, pMemoryManager, OOSQL_TempFileInfo(tempFileInfo->nCols, 0));
+		hashAggr->spillFiles[partition] = spillFile;
+
+		for(i = 0; i < tempFileInfo->nCols; i++)
+			spillFile->attrInfo[i] = tempFileInfo->attrInfo[i];
+
+		e = createTempFile(spillFile);
+		OOSQL_CHECK_ERR(e);
+
+		e = m_storageManager->OpenClass(m_sortBufferInfo.diskInfo.sortVolID, spillFile->name);
+		OOSQL_CHECK_ERR(e);
+		spillFile->ocn = e;
+	}
+
+	for(i = 0; i < evalBuffer->nCols; i++)
+	{
+		spillFile->clist[i].colNo      = evalBuffer->clist[i].colNo;
+		spillFile->clist[i].data       = evalBuffer->clist[i].data;
+		spillFile->clist[i].nullFlag   = evalBuffer->clist[i].nullFlag;
+		spillFile->clist[i].dataLength = evalBuffer->clist[i].retLength;
+		spillFile->clist[i].length     = ALL_VALUE;
+		spillFile->clist[i].start      = ALL_VALUE;
+	}
+
+	e = m_storageManager->CreateObjectByColList(spillFile->ocn, SM_FALSE, evalBuffer->nCols, spillFile->clist, &spillFile->oid);
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::destroyHashAggregationFile(
+	OOSQL_TempFileInfo*	spillFile	/* IN: */
+)
+{
+	Four	e;
+
+	if(spillFile->ocn >= 0)
+	{
+		e = m_storageManager->CloseClass(spillFile->ocn);
+		if(e < eNOERROR) OOSQL_ERR(e);
+		RESET_OPENCLASSNUM(spillFile->ocn);
+	}
+
+	if(spillFile->name[0] != NULL)
+	{
+		e = m_storageManager->DestroyClass(m_sortBufferInfo.diskInfo.sortVolID, spillFile->name);
+		if(e < eNOERROR) OOSQL_ERR(e);
+		RESET_CLASSNAME(spillFile->name);
+	}
+
+	OOSQL_DELETE(spillFile);
+
+	return eNOERROR;
+}
+
+Four    OOSQL_Evaluator::finalHashAggregation(
+    Four planIndex                      /* IN: */
+)
+/*
+    Function:
+        Destroy the hash table and the temporary files of the spilled objects.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_HashAggregation*	hashAggr;
+	OOSQL_TempFileInfo*		spillFile;
+	Four					level;
+	Four					i;
+	Four					e;
+
+	hashAggr = EVAL_ACCESSLISTTABLE[planIndex].hashAggregation;
+	if(hashAggr == NULL) return eNOERROR;
+
+	for(i = 0; i < OOSQL_HASHAGGR_NPARTITIONS; i++)
+	{
+		spillFile = hashAggr->spillFiles[i];
+		if(spillFile == NULL) continue;
+
+		hashAggr->spillFiles[i] = NULL;
+		e = destroyHashAggregationFile(spillFile);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	while((spillFile = hashAggr->popSpillFile(&level)) != NULL)
+	{
+		e = destroyHashAggregationFile(spillFile);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	OOSQL_DELETE(hashAggr);
+	EVAL_ACCESSLISTTABLE[planIndex].hashAggregation = NULL;
+
+	return eNOERROR;
+}
@@ -75,14 +75,1086 @@
         oosql_Eval_Join.cxx
 
     DESCRIPTION:
+        A join on a spatial predicate opens an MLGF index scan on the inner
+        class for every outer object. When the inner class is probed many
+        times, its MBRs are partitioned once by a uniform grid and each
+        outer MBR probes only the grid cells it covers (partition-based
+        spatial hash join). The candidates are refined by the original
+        spatial predicate as those of the index scan are.
+
+        An equi-join without an index on the inner join column hashes the
+        inner class once into partitions held in the sort buffer; the
+        partitions which do not fit are spilled to temporary files. Each
+        outer object then reads only the inner objects of its hash value,
+        which are refined by the original WHERE condition.
 
     IMPORTS:
 
     EXPORTS:
         Four    OOSQL_Evaluator::execImplicitForwardNestedLoop( Four planIndex );
         Four    OOSQL_Evaluator::execNestedLoop( Four planIndex );
+        Four    OOSQL_SpatialHashJoin::build(OOSQL_StorageManager*, Four, Four, OOSQL_StorageManager::LockParameter*);
+        Four    OOSQL_SpatialHashJoin::openProbe(OOSQL_StorageManager::Region&, Four);
+        Four    OOSQL_SpatialHashJoin::nextProbe(OOSQL_StorageManager::OID*);
+        Four    OOSQL_HashJoin::insert(UFour, OOSQL_StorageManager::OID*);
+        Four    OOSQL_HashJoin::openProbe(UFour);
+        Four    OOSQL_HashJoin::nextProbe(OOSQL_StorageManager::OID*);
+        Four    OOSQL_Evaluator::openHashJoin(Four, Four);
+        Four    OOSQL_Evaluator::closeHashJoin(Four, Four);
+        Four    OOSQL_Evaluator::finalHashJoin(Four, Four);
 
 */
 
+#include <math.h>
 #include "OOSQL_Evaluator.hxx"
 
+OOSQL_SpatialHashJoin::OOSQL_SpatialHashJoin()
+{
+	nEntries    = 0;
+	entries     = NULL;
+	nCellsX     = 0;
+	nCellsY     = 0;
+	cellStart   = NULL;
+	cellEntries = NULL;
+	xmin        = 0;
+	ymin        = 0;
+	cellWidth   = 0;
+	cellHeight  = 0;
+
+	/* no probe is open */
+	probeX1 = probeY1 = 0;
+	probeX2 = probeY2 = -1;
+	probeX  = probeY  = 0;
+	probePos = 0;
+}
+
+OOSQL_SpatialHashJoin::~OOSQL_SpatialHashJoin()
+{
+	if(entries)
+		pMemoryManager->Free(entries);
+	if(cellStart)
+		pMemoryManager->Free(cellStart);
+	if(cellEntries)
+		pMemoryManager->Free(cellEntries);
+}
+
+Four OOSQL_SpatialHashJoin::build(
+	OOSQL_StorageManager*					storageManager,	// IN: 
+	Four									ocn,			// IN: open class number of the inner class
+	Four									colNo,			// IN: spatial column of the inner class
+	OOSQL_StorageManager::LockParameter*	lockup			// IN: 
+)
+/*
+    Function:
+		Read the MBRs of all objects of the inner class and partition them
+		by a uniform grid which has about OOSQL_SPATIALJOIN_NENTRIES_PER_CELL
+		MBRs per cell. An MBR is stored in every cell it overlaps.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_StorageManager::OID	oid;
+	Four						scanId;
+	Four						nAllocated;
+	Four						nCellEntries;
+	Four						nCells;
+	Four						i, x, y, c;
+	float						x1, y1, x2, y2;
+	float						xmax, ymax;
+	Four						e;
+
+	scanId = storageManager->OpenSeqScan(ocn, FORWARD, 0, NULL, lockup);
+	OOSQL_CHECK_ERR(scanId);
+
+	nAllocated = 0;
+	while((e = storageManager->NextObject(scanId, &oid, NULL)) != ENDOFSCAN)
+	{
+		OOSQL_CHECK_ERR(e);
+
+		/* the MBR is not set for an empty geometry, which never satisfies the predicate */
+		x1 = y1 = 1;
+		x2 = y2 = 0;
+		e = storageManager->Geometry_GetMBR(ocn, SM_FALSE, &oid, colNo, &x1, &y1, &x2, &y2);
+		OOSQL_CHECK_ERR(e);
+
+		if(x1 > x2 || y1 > y2)
+			continue;
+
+		if(nEntries == nAllocated)
+		{
+			nAllocated = (nAllocated == 0) ? 1024 : nAllocated * 2;
+			if(entries)
+				entries = (OOSQL_SpatialJoinEntry*)pMemoryManager->Realloc(entries, sizeof(OOSQL_SpatialJoinEntry) * nAllocated);
+			else
+				entries = (OOSQL_SpatialJoinEntry*)pMemoryManager->Alloc(sizeof(OOSQL_SpatialJoinEntry) * nAllocated);
+		}
+
+		entries[nEntries].oid  = oid;
+		entries[nEntries].xmin = x1;
+		entries[nEntries].ymin = y1;
+		entries[nEntries].xmax = x2;
+		entries[nEntries].ymax = y2;
+		nEntries++;
+	}
+
+	e = storageManager->CloseScan(scanId);
+	OOSQL_CHECK_ERR(e);
+
+	/* determine the grid */
+	xmin = ymin = 0;
+	xmax = ymax = 0;
+	for(i = 0; i < nEntries; i++)
+	{
+		if(i == 0 || entries[i].xmin < xmin) xmin = entries[i].xmin;
+		if(i == 0 || entries[i].ymin < ymin) ymin = entries[i].ymin;
+		if(i == 0 || entries[i].xmax > xmax) xmax = entries[i].xmax;
+		if(i == 0 || entries[i].ymax > ymax) ymax = entries[i].ymax;
+	}
+
+	nCellsX = (Four)ceil(sqrt((double)nEntries / OOSQL_SPATIALJOIN_NENTRIES_PER_CELL));
+	if(nCellsX < 1)                                    nCellsX = 1;
+	if(nCellsX > OOSQL_SPATIALJOIN_MAXNCELLS_PER_AXIS) nCellsX = OOSQL_SPATIALJOIN_MAXNCELLS_PER_AXIS;
+	nCellsY = nCellsX;
+	nCells  = nCellsX * nCellsY;
+
+	cellWidth  = (xmax - xmin) / nCellsX;
+	cellHeight = (ymax - ymin) / nCellsY;
+
+	/* count the MBRs of each cell into cellStart[c + 1], then make cellStart[c] the start of the cell c */
+	cellStart = (Four*)pMemoryManager->Alloc(sizeof(Four) * (nCells + 1));
+	for(c = 0; c <= nCells; c++)
+		cellStart[c] = 0;
+
+	for(i = 0; i < nEntries; i++)
+		for(y = getCellY(entries[i].ymin); y <= getCellY(entries[i].ymax); y++)
+			for(x = getCellX(entries[i].xmin); x <= getCellX(entries[i].xmax); x++)
+				cellStart[y * nCellsX + x + 1]++;
+
+	for(c = 0; c < nCells; c++)
+		cellStart[c + 1] += cellStart[c];
+	nCellEntries = cellStart[nCells];
+
+	/* shift by one cell so that cellStart[c + 1] is the next free position of the cell c */
+	for(c = nCells; c > 0; c--)
+		cellStart[c] = cellStart[c - 1];
+	cellStart[0] = 0;
+
+	/* distribute the MBRs; cellStart[c + 1] ends at the start of the cell c + 1 again */
+	cellEntries = (Four*)pMemoryManager->Alloc(sizeof(Four) * (nCellEntries > 0 ? nCellEntries : 1));
+	for(i = 0; i < nEntries; i++)
+		for(y = getCellY(entries[i].ymin); y <= getCellY(entries[i].ymax); y++)
+			for(x = getCellX(entries[i].xmin); x <= getCellX(entries[i].xmax); x++)
+				cellEntries[cellStart[y * nCellsX + x + 1]++] = i;
+
+	return eNOERROR;
+}
+
+Four OOSQL_SpatialHashJoin::openProbe(
+	OOSQL_StorageManager::Region&	region,		// IN: MBR of the outer object
+	Four							spatialOp	// IN: OP_GEO_XXX of the index scan
+)
+/*
+    Function:
+		Start to return the inner objects whose MBRs satisfy spatialOp with
+		the given region.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	probeRegion = region;
+	probeOp     = spatialOp;
+
+	if(nEntries == 0 || region.x1 > region.x2 || region.y1 > region.y2)
+	{
+		probeX1 = probeY1 = 0;
+		probeX2 = probeY2 = -1;
+	}
+	else
+	{
+		probeX1 = getCellX(region.x1);
+		probeY1 = getCellY(region.y1);
+		probeX2 = getCellX(region.x2);
+		probeY2 = getCellY(region.y2);
+	}
+
+	probeX   = probeX1;
+	probeY   = probeY1;
+	probePos = (probeY <= probeY2) ? cellStart[probeY * nCellsX + probeX] : 0;
+
+	return eNOERROR;
+}
+
+Four OOSQL_SpatialHashJoin::nextProbe(
+	OOSQL_StorageManager::OID*	oid		// OUT: the next inner object
+)
+/*
+    Function:
+		Return the next inner object of the probe. An inner MBR stored in
+		several cells is returned only from the cell which holds the lower
+		left corner of its intersection with the probe region.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+		eNOERROR or ENDOFSCAN
+*/
+{
+	OOSQL_SpatialJoinEntry*	entry;
+	Four					cell;
+
+	while(probeY <= probeY2)
+	{
+		cell = probeY * nCellsX + probeX;
+
+		while(probePos < cellStart[cell + 1])
+		{
+			entry = &entries[cellEntries[probePos++]];
+
+			if(!isMatched(entry))
+				continue;
+
+			if(getCellX(entry->xmin > probeRegion.x1 ? entry->xmin : probeRegion.x1) != probeX ||
+			   getCellY(entry->ymin > probeRegion.y1 ? entry->ymin : probeRegion.y1) != probeY)
+				continue;
+
+			*oid = entry->oid;
+			return eNOERROR;
+		}
+
+		/* move to the next cell */
+		if(++probeX > probeX2)
+		{
+			probeX = probeX1;
+			probeY++;
+		}
+		if(probeY <= probeY2)
+			probePos = cellStart[probeY * nCellsX + probeX];
+	}
+
+	return ENDOFSCAN;
+}
+
+Four OOSQL_SpatialHashJoin::getCellX(float x)
+{
+	Four cell;
+
+	if(cellWidth <= 0)
+		return 0;
+
+	cell = (Four)((x - xmin) / cellWidth);
+	if(cell < 0)        return 0;
+	if(cell >= nCellsX) return nCellsX - 1;
+	return cell;
+}
+
+Four OOSQL_SpatialHashJoin::getCellY(float y)
+{
+	Four cell;
+
+	if(cellHeight <= 0)
+		return 0;
+
+	cell = (Four)((y - ymin) / cellHeight);
+	if(cell < 0)        return 0;
+	if(cell >= nCellsY) return nCellsY - 1;
+	return cell;
+}
+
+Boolean OOSQL_SpatialHashJoin::isMatched(OOSQL_SpatialJoinEntry* entry)
+/*
+    Function:
+		Check the MBR of an inner object against the probe region as the
+		MLGF index scan does. Every predicate needs the MBRs to intersect.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	if(entry->xmin > probeRegion.x2 || entry->xmax < probeRegion.x1 ||
+	   entry->ymin > probeRegion.y2 || entry->ymax < probeRegion.y1)
+		return SM_FALSE;
+
+	switch(probeOp)
+	{
+	case OP_GEO_CONTAIN:	/* the inner object contains the outer object */
+		if(entry->xmin <= probeRegion.x1 && entry->ymin <= probeRegion.y1 &&
+		   entry->xmax >= probeRegion.x2 && entry->ymax >= probeRegion.y2)
+			return SM_TRUE;
+		return SM_FALSE;
+	case OP_GEO_CONTAINED:	/* the inner object is contained by the outer object */
+		if(entry->xmin >= probeRegion.x1 && entry->ymin >= probeRegion.y1 &&
+		   entry->xmax <= probeRegion.x2 && entry->ymax <= probeRegion.y2)
+			return SM_TRUE;
+		return SM_FALSE;
+	case OP_GEO_EQUAL:
+		if(entry->xmin == probeRegion.x1 && entry->ymin == probeRegion.y1 &&
+		   entry->xmax == probeRegion.x2 && entry->ymax == probeRegion.y2)
+			return SM_TRUE;
+		return SM_FALSE;
+	default:
+		return SM_TRUE;
+	}
+}
+
+
+OOSQL_HashJoin::OOSQL_HashJoin(
+	Four	memoryLimit_		// IN: the # of bytes the in-memory partitions may use
+)
+{
+	Four	i;
+
+	memoryLimit = memoryLimit_;
+	memoryUsed  = 0;
+
+	for(i = 0; i < OOSQL_HASHJOIN_NPARTITIONS; i++)
+	{
+		entries[i]    = NULL;
+		nEntries[i]   = 0;
+		nAllocated[i] = 0;
+		spillFiles[i] = NULL;
+	}
+
+	/* no probe is open */
+	probeHashValue = 0;
+	probePartition = -1;
+	probePos       = 0;
+}
+
+OOSQL_HashJoin::~OOSQL_HashJoin()
+{
+	Four	i;
+
+	for(i = 0; i < OOSQL_HASHJOIN_NPARTITIONS; i++)
+	{
+		if(entries[i])
+			pMemoryManager->Free(entries[i]);
+		if(spillFiles[i])
+			OOSQL_DELETE(spillFiles[i]);
+	}
+}
+
+Four OOSQL_HashJoin::insert(
+	UFour						hashValue,	// IN: hash value of the join column
+	OOSQL_StorageManager::OID*	oid			// IN: the inner object
+)
+/*
+    Function:
+		Append an inner object to its in-memory partition.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	Four	p;
+	Four	n;
+
+	p = getPartition(hashValue);
+
+	if(nEntries[p] == nAllocated[p])
+	{
+		n = (nAllocated[p] == 0) ? 256 : nAllocated[p] * 2;
+		if(entries[p])
+			entries[p] = (OOSQL_HashJoinEntry*)pMemoryManager->Realloc(entries[p], sizeof(OOSQL_HashJoinEntry) * n);
+		else
+			entries[p] = (OOSQL_HashJoinEntry*)pMemoryManager->Alloc(sizeof(OOSQL_HashJoinEntry) * n);
+		if(entries[p] == NULL)
+			OOSQL_ERR(eOUTOFMEMORY_OOSQL);
+
+		memoryUsed    += sizeof(OOSQL_HashJoinEntry) * (n - nAllocated[p]);
+		nAllocated[p]  = n;
+	}
+
+	entries[p][nEntries[p]].hashValue = hashValue;
+	entries[p][nEntries[p]].oid       = *oid;
+	nEntries[p]++;
+
+	return eNOERROR;
+}
+
+Four OOSQL_HashJoin::getVictim()
+/*
+    Function:
+		Choose the partition to be spilled when the memory limit is exceeded.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+		the largest in-memory partition or -1 if there is none
+*/
+{
+	Four	i;
+	Four	victim;
+
+	victim = -1;
+	for(i = 0; i < OOSQL_HASHJOIN_NPARTITIONS; i++)
+	{
+		if(spillFiles[i] != NULL || nAllocated[i] == 0)
+			continue;
+		if(victim < 0 || nAllocated[i] > nAllocated[victim])
+			victim = i;
+	}
+
+	return victim;
+}
+
+void OOSQL_HashJoin::freePartition(
+	Four	partition		// IN: 
+)
+{
+	if(entries[partition])
+		pMemoryManager->Free(entries[partition]);
+
+	memoryUsed -= sizeof(OOSQL_HashJoinEntry) * nAllocated[partition];
+
+	entries[partition]    = NULL;
+	nEntries[partition]   = 0;
+	nAllocated[partition] = 0;
+}
+
+static int compareHashJoinEntry(const void* a, const void* b)
+{
+	UFour	hashValue1 = ((OOSQL_HashJoinEntry*)a)->hashValue;
+	UFour	hashValue2 = ((OOSQL_HashJoinEntry*)b)->hashValue;
+
+	if(hashValue1 < hashValue2) return -1;
+	if(hashValue1 > hashValue2) return 1;
+	return 0;
+}
+
+Four OOSQL_HashJoin::sortPartitions()
+/*
+    Function:
+		Sort the in-memory partitions by hash value so that a probe finds
+		its entries by binary search.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	Four	i;
+
+	for(i = 0; i < OOSQL_HASHJOIN_NPARTITIONS; i++)
+		if(nEntries[i] > 1)
+			qsort(entries[i], nEntries[i], sizeof(OOSQL_HashJoinEntry), compareHashJoinEntry);
+
+	return eNOERROR;
+}
+
+Four OOSQL_HashJoin::openProbe(
+	UFour	hashValue		// IN: hash value of the outer key
+)
+/*
+    Function:
+		Start to return the inner objects of an in-memory partition which
+		have the given hash value.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	Four	low, high, mid;
+
+	probeHashValue = hashValue;
+	probePartition = getPartition(hashValue);
+
+	/* find the first entry whose hash value is not less than hashValue */
+	low  = 0;
+	high = nEntries[probePartition];
+	while(low < high)
+	{
+		mid = (low + high) / 2;
+		if(entries[probePartition][mid].hashValue < hashValue)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	probePos = low;
+
+	return eNOERROR;
+}
+
+Four OOSQL_HashJoin::nextProbe(
+	OOSQL_StorageManager::OID*	oid		// OUT: the next inner object
+)
+/*
+    Function:
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+		eNOERROR or ENDOFSCAN
+*/
+{
+	if(probePartition < 0)
+		return ENDOFSCAN;
+
+	if(probePos < nEntries[probePartition] && entries[probePartition][probePos].hashValue == probeHashValue)
+	{
+		*oid = entries[probePartition][probePos++].oid;
+		return eNOERROR;
+	}
+
+	return ENDOFSCAN;
+}
+
+UFour OOSQL_HashJoin::hashNumber(
+	double	number		// IN: 
+)
+/*
+    Function:
+		Hash a number of any numeric type, so that equal keys of different
+		types have the same hash value.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	unsigned char*	p;
+	UFour			hashValue;
+	Four			i;
+
+	if(number == 0)
+		number = 0;		/* -0 equals to 0 */
+
+	/* FNV-1a */
+	p         = (unsigned char*)&number;
+	hashValue = 2166136261U;
+	for(i = 0; i < sizeof(double); i++)
+	{
+		hashValue ^= p[i];
+		hashValue *= 16777619U;
+	}
+
+	return hashValue;
+}
+
+UFour OOSQL_HashJoin::hashString(
+	char*	string,		// IN: 
+	Four	length		// IN: 
+)
+/*
+    Function:
+		Hash a string ignoring trailing blanks and null characters. Only the
+		first OOSQL_HASHJOIN_MAXKEYLENGTH bytes are hashed.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	UFour	hashValue;
+	Four	i;
+
+	if(length > OOSQL_HASHJOIN_MAXKEYLENGTH)
+		length = OOSQL_HASHJOIN_MAXKEYLENGTH;
+	while(length > 0 && (string[length - 1] == ' ' || string[length - 1] == '\0'))
+		length--;
+
+	/* FNV-1a */
+	hashValue = 2166136261U;
+	for(i = 0; i < length; i++)
+	{
+		hashValue ^= (unsigned char)string[i];
+		hashValue *= 16777619U;
+	}
+
+	return hashValue;
+}
+
+Four OOSQL_Evaluator::openHashJoin(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+		Evaluate the join key of the current outer object and start to return
+		the inner objects which have its hash value. The hash table of the
+		inner class is built at the first call.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+    OOSQL_AccessElement*				accessElement;
+    AP_IndexInfoElement*				indexInfoNode;
+	OOSQL_ScanInfo*						scanInfo;
+	OOSQL_HashJoin*						hashJoin;
+	OOSQL_StorageManager::LockParameter	lockup;
+	OOSQL_StorageManager::BoolExp		boolExp;
+	OOSQL_DB_Value						value(pMemoryManager);
+	UFour								hashValue;
+	Four								partition;
+	Four								scanId;
+    Four								e;
+
+    /* check input parameters */
+#ifdef	OOSQL_DEBUG
+    if(planIndex < 0 || ACCESSPLAN.getNumAP_Elem() <= planIndex)
+    	OOSQL_ERR(eBADPARAMETER_OOSQL);
+    if(accessElemIndex < 0 || EVAL_ACCESSLISTTABLE[planIndex].numClasses <= accessElemIndex)
+    	OOSQL_ERR(eBADPARAMETER_OOSQL);
+#endif
+
+    accessElement = &(EVAL_ACCESSLISTTABLE[planIndex].accessList[accessElemIndex]);
+    indexInfoNode = ACCESSPLAN.getIndexInfoElem(accessElement->indexInfo);
+	scanInfo      = &EVAL_INDEX_SCANINFOTABLEELEMENTS[accessElement->indexInfo.startIndex];
+
+	if(scanInfo->hashJoin == NULL)
+	{
+		e = buildHashJoin(planIndex, accessElemIndex);
+		if(e < eNOERROR)
+		{
+			finalHashJoin(planIndex, accessElemIndex);
+			OOSQL_ERR(e);
+		}
+	}
+	hashJoin = scanInfo->hashJoin;
+
+	scanInfo->scanId   = NIL;
+	scanInfo->ocn      = accessElement->ocn;
+	scanInfo->colNoMap = &ACCESSPLANELEMENTS[planIndex].colNoMap.getElements(m_pool->colNoMapPool, 0);
+	scanInfo->nCols    = EVAL_EVALBUFFER[planIndex].nCols;
+	scanInfo->clist    = EVAL_EVALBUFFER[planIndex].getColSlotPtr(0);
+	scanInfo->oid      = EVAL_EVALBUFFER[planIndex].getOID_Ptr();
+
+	/* the WHERE condition is checked for the candidates */
+	e = EVAL_INDEX_SCANINFOTABLE.resetBoolExpression(accessElement->indexInfo.startIndex);
+	OOSQL_CHECK_ERR(e);
+	scanInfo->boolExprInfos = NULL;
+
+	/* evaluate the join key of the outer object */
+	e = evalExpression(&indexInfoNode->scan.hash.outerKey, &value);
+	OOSQL_CHECK_ERR(e);
+
+	if(value.nullFlag)
+	{
+		/* a null key never matches */
+		hashJoin->closeProbe();
+		return eNOERROR;
+	}
+
+	switch(value.type)
+	{
+	case OOSQL_TYPE_SHORT:
+		hashValue = OOSQL_HashJoin::hashNumber((double)value.data.s);
+		break;
+	case OOSQL_TYPE_INT:
+		hashValue = OOSQL_HashJoin::hashNumber((double)value.data.i);
+		break;
+	case OOSQL_TYPE_LONG:
+		hashValue = OOSQL_HashJoin::hashNumber((double)value.data.l);
+		break;
+	case OOSQL_TYPE_LONG_LONG:
+		hashValue = OOSQL_HashJoin::hashNumber((double)value.data.ll);
+		break;
+	case OOSQL_TYPE_FLOAT:
+		hashValue = OOSQL_HashJoin::hashNumber((double)value.data.f);
+		break;
+	case OOSQL_TYPE_DOUBLE:
+		hashValue = OOSQL_HashJoin::hashNumber(value.data.d);
+		break;
+	case OOSQL_TYPE_STRING:
+	case OOSQL_TYPE_VARSTRING:
+		hashValue = OOSQL_HashJoin::hashString((char*)value.data.ptr, value.length);
+		break;
+	default:
+		OOSQL_ERR(eTYPE_ERROR_OOSQL);
+	}
+
+	partition = hashJoin->getPartition(hashValue);
+	if(hashJoin->spillFiles[partition])
+	{
+		/* scan the temporary file of the spilled partition for the hash value */
+		boolExp.op     = OOSQL_StorageManager::SM_EQ;
+		boolExp.colNo  = 0;
+		boolExp.length = OOSQL_TYPE_INT_SIZE;
+		boolExp.data.i = (Four)hashValue;
+
+		lockup.mode     = OOSQL_StorageManager::L_X;
+		lockup.duration = OOSQL_StorageManager::L_COMMIT;
+
+		scanId = m_storageManager->OpenSeqScan(hashJoin->spillFiles[partition]->ocn, FORWARD, 1, &boolExp, &lockup);
+		if(scanId < eNOERROR) OOSQL_ERR(scanId);
+
+		scanInfo->scanId = scanId;
+		hashJoin->closeProbe();
+	}
+	else
+	{
+		e = hashJoin->openProbe(hashValue);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::closeHashJoin(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+		Close the scan of a spilled partition. The hash table is kept for
+		the next outer object.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_ScanInfo*		scanInfo;
+	Four				e;
+
+	scanInfo = &EVAL_INDEX_SCANINFOTABLEELEMENTS[EVAL_ACCESSLISTTABLE[planIndex].accessList[accessElemIndex].indexInfo.startIndex];
+
+	if(scanInfo->hashJoin)
+		scanInfo->hashJoin->closeProbe();
+
+	if(scanInfo->scanId < 0) return eNOERROR;
+
+	e = m_storageManager->CloseScan(scanInfo->scanId);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	scanInfo->scanId = NIL;
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::finalHashJoin(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+		Close the hash join and destroy the temporary files of the spilled
+		partitions.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_ScanInfo*		scanInfo;
+	OOSQL_HashJoin*		hashJoin;
+	OOSQL_TempFileInfo*	spillFile;
+	Four				i;
+	Four				e;
+
+	e = closeHashJoin(planIndex, accessElemIndex);
+	OOSQL_CHECK_ERR(e);
+
+	scanInfo = &EVAL_INDEX_SCANINFOTABLEELEMENTS[EVAL_ACCESSLISTTABLE[planIndex].accessList[accessElemIndex].indexInfo.startIndex];
+	hashJoin = scanInfo->hashJoin;
+	if(hashJoin == NULL) return eNOERROR;
+
+	for(i = 0; i < OOSQL_HASHJOIN_NPARTITIONS; i++)
+	{
+		spillFile = hashJoin->spillFiles[i];
+		if(spillFile == NULL) continue;
+
+		if(spillFile->ocn >= 0)
+		{
+			e = m_storageManager->CloseClass(spillFile->ocn);
+			if(e < eNOERROR) OOSQL_ERR(e);
+			RESET_OPENCLASSNUM(spillFile->ocn);
+		}
+
+		if(spillFile->name[0] != NULL)
+		{
+			e = m_storageManager->DestroyClass(m_sortBufferInfo.diskInfo.sortVolID, spillFile->name);
+			if(e < eNOERROR) OOSQL_ERR(e);
+			RESET_CLASSNAME(spillFile->name);
+		}
+
+		OOSQL_DELETE(spillFile);
+		hashJoin->spillFiles[i] = NULL;
+	}
+
+	OOSQL_DELETE(hashJoin);
+	scanInfo->hashJoin = NULL;
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::buildHashJoin(
+    Four planIndex,                     /* IN: */
+    Four accessElemIndex                /* IN: */
+)
+/*
+    Function:
+		Read the join column of all objects of the inner class and hash them
+		into partitions. When the partitions exceed the sort buffer, the
+		largest one is spilled to a temporary file and the objects of a
+		spilled partition are written to its file directly.
+
+    Side effect:
+		scanInfo->hashJoin is set.
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+    OOSQL_AccessElement*				accessElement;
+    AP_IndexInfoElement*				indexInfoNode;
+	OOSQL_ScanInfo*						scanInfo;
+	OOSQL_HashJoin*						hashJoin;
+	OOSQL_StorageManager::LockParameter	lockup;
+	OOSQL_StorageManager::ColListStruct	clist;
+	OOSQL_StorageManager::OID			oid;
+	char								keyBuffer[OOSQL_HASHJOIN_MAXKEYLENGTH];
+	UFour								hashValue;
+	Four								memoryLimit;
+	Four								partition;
+	Four								scanId;
+    Four								e;
+
+    accessElement = &(EVAL_ACCESSLISTTABLE[planIndex].accessList[accessElemIndex]);
+    indexInfoNode = ACCESSPLAN.getIndexInfoElem(accessElement->indexInfo);
+	scanInfo      = &EVAL_INDEX_SCANINFOTABLEELEMENTS[accessElement->indexInfo.startIndex];
+
+	/* the hash table uses the memory of the sort buffer */
+	if(m_sortBufferInfo.mode == OOSQL_SB_USE_DISK)
+		memoryLimit = OOSQL_DEFAULT_INMEMORY_SORTBUFFER_FOR_SORTSTREAM;
+	else
+		memoryLimit = m_sortBufferInfo.memoryInfo.sortBufferLength;
+
+	OOSQL_NEW(scanInfo->hashJoin, pMemoryManager, OOSQL_HashJoin(memoryLimit));
+	hashJoin = scanInfo->hashJoin;
+
+	/* make lockup parameter */
+	switch(ACCESSPLANELEMENTS[planIndex].classInfo.classKind) 
+	{
+	case CLASSKIND_PERSISTENT:
+		if(isUpdateQuery())
+			lockup.mode = OOSQL_StorageManager::L_IX;
+		else
+			lockup.mode = OOSQL_StorageManager::L_IS;
+		lockup.duration = OOSQL_StorageManager::L_COMMIT;
+		break;
+
+	case CLASSKIND_TEMPORARY:
+		lockup.mode     = OOSQL_StorageManager::L_X;
+		lockup.duration = OOSQL_StorageManager::L_COMMIT;
+		break;
+
+	default:
+		OOSQL_ERR(eINVALID_CASE_OOSQL);
+	}
+
+	/* make the column list to read the join column */
+	clist.colNo = indexInfoNode->scan.colNo;
+	clist.start = 0;
+	switch(indexInfoNode->scan.hash.keyType)
+	{
+	case OOSQL_TYPE_SHORT:
+		clist.length = OOSQL_TYPE_SHORT_SIZE;
+		break;
+	case OOSQL_TYPE_INT:
+		clist.length = OOSQL_TYPE_INT_SIZE;
+		break;
+	case OOSQL_TYPE_LONG:
+		clist.length = OOSQL_TYPE_LONG_SIZE;
+		break;
+	case OOSQL_TYPE_LONG_LONG:
+		clist.length = OOSQL_TYPE_LONG_LONG_SIZE;
+		break;
+	case OOSQL_TYPE_FLOAT:
+		clist.length = OOSQL_TYPE_FLOAT_SIZE;
+		break;
+	case OOSQL_TYPE_DOUBLE:
+		clist.length = OOSQL_TYPE_DOUBLE_SIZE;
+		break;
+	case OOSQL_TYPE_STRING:
+	case OOSQL_TYPE_VARSTRING:
+		clist.length   = OOSQL_HASHJOIN_MAXKEYLENGTH;
+		clist.data.ptr = keyBuffer;
+		break;
+	default:
+		OOSQL_ERR(eTYPE_ERROR_OOSQL);
+	}
+	clist.dataLength = clist.length;
+
+	scanId = m_storageManager->OpenSeqScan(accessElement->ocn, FORWARD, 0, NULL, &lockup);
+	if(scanId < eNOERROR) OOSQL_ERR(scanId);
+
+	while((e = m_storageManager->NextObject(scanId, &oid, NULL)) != EOS)
+	{
+		if(e < eNOERROR) OOSQL_ERR(e);
+
+		e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, &oid, 1, &clist);
+		if(e < eNOERROR) OOSQL_ERR(e);
+
+		/* a null key never matches */
+		if(clist.nullFlag)
+			continue;
+
+		switch(indexInfoNode->scan.hash.keyType)
+		{
+		case OOSQL_TYPE_SHORT:
+			hashValue = OOSQL_HashJoin::hashNumber((double)clist.data.s);
+			break;
+		case OOSQL_TYPE_INT:
+			hashValue = OOSQL_HashJoin::hashNumber((double)clist.data.i);
+			break;
+		case OOSQL_TYPE_LONG:
+			hashValue = OOSQL_HashJoin::hashNumber((double)clist.data.l);
+			break;
+		case OOSQL_TYPE_LONG_LONG:
+			hashValue = OOSQL_HashJoin::hashNumber((double)clist.data.ll);
+			break;
+		case OOSQL_TYPE_FLOAT:
+			hashValue = OOSQL_HashJoin::hashNumber((double)clist.data.f);
+			break;
+		case OOSQL_TYPE_DOUBLE:
+			hashValue = OOSQL_HashJoin::hashNumber(clist.data.d);
+			break;
+		default:
+			hashValue = OOSQL_HashJoin::hashString(keyBuffer, clist.retLength);
+			break;
+		}
+
+		partition = hashJoin->getPartition(hashValue);
+		if(hashJoin->spillFiles[partition])
+		{
+			e = writeHashJoinSpillFile(hashJoin->spillFiles[partition], hashValue, &oid);
+			OOSQL_CHECK_ERR(e);
+		}
+		else
+		{
+			e = hashJoin->insert(hashValue, &oid);
+			OOSQL_CHECK_ERR(e);
+
+			while(hashJoin->memoryUsed > hashJoin->memoryLimit && (partition = hashJoin->getVictim()) >= 0)
+			{
+				e = spillHashJoinPartition(hashJoin, partition);
+				OOSQL_CHECK_ERR(e);
+			}
+		}
+	}
+
+	e = m_storageManager->CloseScan(scanId);
+	if(e < eNOERROR) OOSQL_ERR(e);
+
+	e = hashJoin->sortPartitions();
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::spillHashJoinPartition(
+	OOSQL_HashJoin*	hashJoin,		// IN: 
+	Four			partition		// IN: the partition to spill
+)
+/*
+    Function:
+		Move an in-memory partition to a temporary file of (hash value, oid)
+		tuples.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_TempFileInfo*	spillFile;
+	Four				i;
+	Four				e;
+
+	OOSQL_NEW(spillFile, pMemoryManager, OOSQL_TempFileInfo(2, 0));
+	hashJoin->spillFiles[partition] = spillFile;
+
+	spillFile->attrInfo[0].complexType = SM_COMPLEXTYPE_BASIC;
+	spillFile->attrInfo[0].type        = OOSQL_TYPE_INT;
+	spillFile->attrInfo[0].length      = OOSQL_TYPE_INT_SIZE;
+	strcpy(spillFile->attrInfo[0].name, "");				// no column name
+	spillFile->attrInfo[0].domain      = OOSQL_TYPE_INT;
+
+	spillFile->attrInfo[1].complexType = SM_COMPLEXTYPE_BASIC;
+	spillFile->attrInfo[1].type        = OOSQL_TYPE_OID;
+	spillFile->attrInfo[1].length      = OOSQL_TYPE_OID_SIZE;
+	strcpy(spillFile->attrInfo[1].name, "");				// no column name
+	spillFile->attrInfo[1].domain      = OOSQL_TYPE_OID;
+
+	for(i = 0; i < 2; i++)
+	{
+		spillFile->clist[i].colNo      = (Two)i;
+		spillFile->clist[i].nullFlag   = SM_FALSE;
+		spillFile->clist[i].start      = 0;
+		spillFile->clist[i].length     = spillFile->attrInfo[i].length;
+		spillFile->clist[i].dataLength = spillFile->attrInfo[i].length;
+	}
+
+	e = createTempFile(spillFile);
+	OOSQL_CHECK_ERR(e);
+
+	e = m_storageManager->OpenClass(m_sortBufferInfo.diskInfo.sortVolID, spillFile->name);
+	OOSQL_CHECK_ERR(e);
+	spillFile->ocn = e;
+
+	for(i = 0; i < hashJoin->nEntries[partition]; i++)
+	{
+		e = writeHashJoinSpillFile(spillFile, hashJoin->entries[partition][i].hashValue, &hashJoin->entries[partition][i].oid);
+		OOSQL_CHECK_ERR(e);
+	}
+
+	hashJoin->freePartition(partition);
+
+	return eNOERROR;
+}
+
+Four OOSQL_Evaluator::writeHashJoinSpillFile(
+	OOSQL_TempFileInfo*			spillFile,	// IN: 
+	UFour						hashValue,	// IN: 
+	OOSQL_StorageManager::OID*	oid			// IN: 
+)
+{
+	Four	e;
+
+	spillFile->clist[0].data.i   = (Four)hashValue;
+	spillFile->clist[1].data.oid = *oid;
+
+	e = m_storageManager->CreateObjectByColList(spillFile->ocn, SM_FALSE, 2, spillFile->clist, &spillFile->oid);
+	OOSQL_CHECK_ERR(e);
+
+	return eNOERROR;
+}
@@ -198,6 +198,28 @@ Four    OOSQL_Evaluator::process()
     Four e;
 
 
+    /* check if the group has been made by hashing */
+    if(ACCESSPLANELEMENTS[m_currPlanIndex].hashAggrFlag) {
+        /* all groups are returned, so only the projected groups can remain to be sorted */
+        if(EVAL_ACCESSLISTTABLE[m_currPlanIndex].endOfCurrAccess) {
+            if(m_evalStatus.prepareAndSortStatus == EVALSTATUS_END) {
+                e = sorting();
+                if(e < eNOERROR)
+                    OOSQL_ERR(e);
+            }
+            return(eNOERROR);
+        }
+
+        /* the evaluation buffer holds a complete group with its intermediate aggregate function results */
+        e = setGroupByKey();
+        if(e < eNOERROR)
+            OOSQL_ERR(e);
+
+        m_evalStatus.groupingStatus = EVALSTATUS_END;
+        if(!IS_NULL_POOLINDEX(ACCESSPLANELEMENTS[m_currPlanIndex].aggrFuncInfo))
+            m_evalStatus.aggregationStatus = EVALSTATUS_END;
+    }
+
     /* check if grouping is necessary */
     if(ACCESSPLANELEMENTS[m_currPlanIndex].nGrpByKeys > 0 &&
         m_evalStatus.groupingStatus != EVALSTATUS_END) {
@@ -88,6 +88,9 @@ OOSQL_SortStream::OOSQL_SortStream(OOSQL_StorageManager* storageManager)
 	m_sortBuffer				= NULL;
 	m_nSortTuples				= 0;
 	m_fastEncodingInfos         = NULL;
+	m_limit						= 0;
+	m_useTopK					= false;
+	m_topKSwapBuffer			= NULL;
 }
 
 OOSQL_SortStream::OOSQL_SortStream(OOSQL_MemoryManager* memoryManager, OOSQL_StorageManager* storageManager)
@@ -103,6 +106,9 @@ OOSQL_SortStream::OOSQL_SortStream(OOSQL_MemoryManager* memoryManager, OOSQL_Sto
 	m_sortBuffer				= NULL;
 	m_nSortTuples				= 0;
 	m_fastEncodingInfos         = NULL;
+	m_limit						= 0;
+	m_useTopK					= false;
+	m_topKSwapBuffer			= NULL;
 }
 
 OOSQL_SortStream::~OOSQL_SortStream()
@@ -131,6 +137,10 @@ OOSQL_SortStream::~OOSQL_SortStream()
 		pMemoryManager->Free(m_fastEncodingInfos);
 	m_fastEncodingInfos = NULL;
 
+	if(m_topKSwapBuffer)
+		pMemoryManager->Free(m_topKSwapBuffer);
+	m_topKSwapBuffer = NULL;
+
 	m_largeTemporaryObject.DestroyObject();
 }
 
@@ -165,6 +175,12 @@ Four OOSQL_SortStream::DestroyStream()
 		pMemoryManager->Free(m_fastEncodingInfos);
 	m_fastEncodingInfos = NULL;
 
+	if(m_topKSwapBuffer)
+		pMemoryManager->Free(m_topKSwapBuffer);
+	m_topKSwapBuffer = NULL;
+	m_limit          = 0;
+	m_useTopK        = false;
+
 	e = m_largeTemporaryObject.DestroyObject();
 	OOSQL_CHECK_ERR(e);
 
@@ -274,6 +290,36 @@ Four OOSQL_SortStream::CreateStream(Four volID, Four nAttrs, OOSQL_StorageManage
 	return eNOERROR;
 }
 
+Four OOSQL_SortStream::SetLimit(Four nTuples)
+{
+	/*
+	 * Only the first nTuples tuples in sort order will be read. If they fit in the 
+	 * in-memory sort buffer, the tuples are kept in a heap whose root is the last 
+	 * of them, so that a tuple is stored only if it precedes the root. Otherwise 
+	 * all the tuples are sorted as usual.
+	 */
+	m_limit   = nTuples;
+	m_useTopK = false;
+
+	if(m_limit <= 0 || m_sortTupleDesc.nparts == 0 || !m_useInMemorySorting || m_nSortTuples > 0)
+		return eNOERROR;
+
+	if(m_limit >= m_sortBufferSize / m_sortTupleDataLen)
+		return eNOERROR;
+
+	ChooseCompareFunc();
+
+	if(m_topKSwapBuffer == NULL)
+	{
+		m_topKSwapBuffer = (char*)pMemoryManager->Alloc(m_sortTupleDataLen);
+		if(m_topKSwapBuffer == NULL) OOSQL_ERR(eMEMORYALLOCERR_OOSQL);
+	}
+
+	m_useTopK = true;
+
+	return eNOERROR;
+}
+
 Four OOSQL_SortStream::Sort()
 {
 	Four e;
@@ -979,6 +1025,80 @@ static int CompareForOID(OOSQL_StorageManager::SortTupleDesc* sortTupleDesc, voi
 	return 0;
 }
 
+void OOSQL_SortStream::ChooseCompareFunc()
+{
+	m_compareFunc = CompareForGenernalCase;
+	if(m_sortTupleDesc.nparts == 1)
+	{
+		switch(m_sortTupleDesc.parts[0].type)
+		{
+		case OOSQL_TYPE_SHORT:
+			m_compareFunc = CompareForShort;
+			break;
+		case OOSQL_TYPE_INT:
+			m_compareFunc = CompareForInt;
+			break;
+		case OOSQL_TYPE_LONG:
+			m_compareFunc = CompareForLong;
+			break;
+		case OOSQL_TYPE_LONG_LONG:
+			m_compareFunc = CompareForLongLong;
+			break;
+		case OOSQL_TYPE_FLOAT:
+			m_compareFunc = CompareForFloat;
+			break;
+		case OOSQL_TYPE_DOUBLE:
+			m_compareFunc = CompareForDouble;
+			break;
+		case OOSQL_TYPE_STRING:
+			m_compareFunc = CompareForString;
+			break;
+		case OOSQL_TYPE_VARSTRING:
+			m_compareFunc = CompareForVarstring;
+			break;
+		case OOSQL_TYPE_OID: 
+			m_compareFunc = CompareForOID;
+			break;
+		}
+	}
+}
+
+void OOSQL_SortStream::BuildTopKHeap()
+{
+	Four i;
+
+	for(i = m_nSortTuples / 2 - 1; i >= 0; i--)
+		SiftDownTopKHeap(i);
+}
+
+void OOSQL_SortStream::SiftDownTopKHeap(Four i)
+{
+	Four	child;
+	Four	last;
+	Four	width;
+
+	/* the root of the heap is the last tuple in sort order */
+	width = m_sortTupleDataLen;
+	while(1)
+	{
+		last  = i;
+		child = 2 * i + 1;
+		if(child < m_nSortTuples && m_compareFunc(&m_sortTupleDesc, TUPLES(m_sortBuffer, width, child), TUPLES(m_sortBuffer, width, last)) > 0)
+			last = child;
+		child ++;
+		if(child < m_nSortTuples && m_compareFunc(&m_sortTupleDesc, TUPLES(m_sortBuffer, width, child), TUPLES(m_sortBuffer, width, last)) > 0)
+			last = child;
+
+		if(last == i)
+			break;
+
+		memcpy(m_topKSwapBuffer, TUPLES(m_sortBuffer, width, i), width);
+		memcpy(TUPLES(m_sortBuffer, width, i), TUPLES(m_sortBuffer, width, last), width);
+		memcpy(TUPLES(m_sortBuffer, width, last), m_topKSwapBuffer, width);
+		i = last;
+	}
+}
+
 Four OOSQL_SortStream::SortTuples()
 {
 	Four e;
@@ -987,40 +1107,11 @@ Four OOSQL_SortStream::SortTuples()
 	{
 		m_sortBufferTail = m_sortBuffer;
 
-		m_compareFunc = CompareForGenernalCase;
-		if(m_sortTupleDesc.nparts == 1)
-		{
-			switch(m_sortTupleDesc.parts[0].type)
-			{
-			case OOSQL_TYPE_SHORT:
-				m_compareFunc = CompareForShort;
-				break;
-			case OOSQL_TYPE_INT:
-				m_compareFunc = CompareForInt;
-				break;
-			case OOSQL_TYPE_LONG:
-				m_compareFunc = CompareForLong;
-				break;
-			case OOSQL_TYPE_LONG_LONG:
-				m_compareFunc = CompareForLongLong;
-				break;
-			case OOSQL_TYPE_FLOAT:
-				m_compareFunc = CompareForFloat;
-				break;
-			case OOSQL_TYPE_DOUBLE:
-				m_compareFunc = CompareForDouble;
-				break;
-			case OOSQL_TYPE_STRING:
-				m_compareFunc = CompareForString;
-				break;
-			case OOSQL_TYPE_VARSTRING:
-				m_compareFunc = CompareForVarstring;
-				break;
-			case OOSQL_TYPE_OID: 
-				m_compareFunc = CompareForOID;
-				break;
-            }
-		}
+		/* without sort keys, tuples are read in the order they were written */
+		if(m_sortTupleDesc.nparts == 0)
+			return eNOERROR;
+
+		ChooseCompareFunc();
 
 		e = QuickSort();     
 		OOSQL_CHECK_ERR(e);
@@ -322,6 +322,13 @@ typedef struct OOSQL_GetDataStruct {
 	Four						bufferLength;
 	Four						returnLength;
 } OOSQL_GetDataStruct;
+typedef struct OOSQL_PlanCacheStatistics {
+	Four						nEntries;			/* # of queries in the plan cache */
+	Four						nHits;				/* # of preparations served by the plan cache */
+	Four						nMisses;			/* # of preparations that compiled the query */
+	Four						nEvictions;			/* # of entries replaced by LRU */
+	Four						nInvalidations;		/* # of entries dropped by DDL */
+} OOSQL_PlanCacheStatistics;
 #ifndef _LOM_INTERNAL_H
 
 typedef struct LOM_Handle {
@@ -538,8 +545,11 @@ Four OOSQL_FormatTempDataVolume(OOSQL_SystemHandle* systemHandle, Four numOfDevi
 Four OOSQL_GetNumTextObjectsInVolume(OOSQL_SystemHandle* systemHandle, Four volId, Four* numObjects);
 Four OOSQL_GetNumObjectsInVolume(OOSQL_SystemHandle* systemHandle, Four volId, Four* numObjects);
 Four OOSQL_GetNumObjectsInClass(OOSQL_SystemHandle* systemHandle, Four volId, char* className, Four* numObjects);
+Four OOSQL_GetPlanCacheStatistics(OOSQL_SystemHandle* systemHandle, OOSQL_PlanCacheStatistics* statistics);
+Four OOSQL_ResetPlanCacheStatistics(OOSQL_SystemHandle* systemHandle);
 
 Four OOSQL_EstimateNumResults(OOSQL_SystemHandle* systemHandle, OOSQL_Handle handle, Four* nResults);
+Four OOSQL_SetDegreeOfParallelism(OOSQL_SystemHandle* systemHandle, OOSQL_Handle handle, Four degree);
 
 Four  OOSQL_SetCfgParam(OOSQL_SystemHandle* systemHandle, char *name, char *value);
 char* OOSQL_GetCfgParam(OOSQL_SystemHandle* systemHandle, char *name);
@@ -319,6 +319,7 @@ typedef struct oosql_UserMountVolumeTable {
 #ifdef __cplusplus
 class OOSQL_ExternalFunctionManager;
 class OOSQL_ExternalFunctionDispatcher;
+class OOSQL_PlanCache;
 class OOSQL_MemoryManager;
 class OOSQL_ServerQuery;
 #else
@@ -370,6 +371,7 @@ typedef struct OOSQL_GDSInstance {
 	char								databaseName[DBM_MAXDATABASENAME];
 	OOSQL_ExternalFunctionManager*		externalFunctionManager;
 	OOSQL_ExternalFunctionDispatcher*	externalFunctionDispatcher;
+	OOSQL_PlanCache*					planCache;
 	OOSQL_MemoryManager*				memoryManager;
 	OOSQL_DbInfo						dbInfo;
 	OOSQL_ConnectionInfo				connectionInfo;
@@ -440,6 +442,13 @@ typedef struct OOSQL_GetDataStruct {
 	Four						bufferLength;
 	Four						returnLength;
 } OOSQL_GetDataStruct;
+typedef struct OOSQL_PlanCacheStatistics {
+	Four						nEntries;			/* # of queries in the plan cache */
+	Four						nHits;				/* # of preparations served by the plan cache */
+	Four						nMisses;			/* # of preparations that compiled the query */
+	Four						nEvictions;			/* # of entries replaced by LRU */
+	Four						nInvalidations;		/* # of entries dropped by DDL */
+} OOSQL_PlanCacheStatistics;
 
 typedef struct OOSQL_MBR {
     Four_Invariable values[4];
@@ -605,9 +614,12 @@ Four OOSQL_FormatTempDataVolume(OOSQL_SystemHandle* systemHandle, Four numOfDevi
 Four OOSQL_GetNumObjectsInVolume(OOSQL_SystemHandle* systemHandle, Four volId, Four* numObjects);
 Four OOSQL_GetNumTextObjectsInVolume(OOSQL_SystemHandle* systemHandle, Four volId, Four* numObjects);
 Four OOSQL_GetNumObjectsInClass(OOSQL_SystemHandle* systemHandle, Four volId, char* className, Four* numObjects);
+Four OOSQL_GetPlanCacheStatistics(OOSQL_SystemHandle* systemHandle, OOSQL_PlanCacheStatistics* statistics);
+Four OOSQL_ResetPlanCacheStatistics(OOSQL_SystemHandle* systemHandle);
 Four OOSQL_CheckFeature(OOSQL_SystemHandle* systemHandle, char* feature, Boolean* result);
 
 Four OOSQL_EstimateNumResults(OOSQL_SystemHandle* systemHandle, OOSQL_Handle handle, Four* nResults);
+Four OOSQL_SetDegreeOfParallelism(OOSQL_SystemHandle* systemHandle, OOSQL_Handle handle, Four degree);
 
 Four  OOSQL_SetCfgParam(OOSQL_SystemHandle* systemHandle, char *name, char *value);
 char* OOSQL_GetCfgParam(OOSQL_SystemHandle* systemHandle, char *name);
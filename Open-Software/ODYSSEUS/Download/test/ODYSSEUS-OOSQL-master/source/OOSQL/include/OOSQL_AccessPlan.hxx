@@ -124,6 +124,7 @@
 #define ACCESSMETHOD_TEXT_IDXSCAN       CAP_ACCESSMETHOD_TEXT_INDEXSCAN
 #define ACCESSMETHOD_MLGF_IDXSCAN       CAP_ACCESSMETHOD_MLGF_INDEXSCAN
 #define ACCESSMETHOD_MLGF_MBR_IDXSCAN   CAP_ACCESSMETHOD_MLGF_MBR_INDEXSCAN 
+#define ACCESSMETHOD_HASHJOIN           CAP_ACCESSMETHOD_HASHJOIN
 
 /* macro definitions for checking join method */
 #define IS_IMPLICITFORWARD(joinMethod)  \
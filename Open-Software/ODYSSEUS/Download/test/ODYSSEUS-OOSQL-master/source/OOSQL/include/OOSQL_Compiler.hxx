@@ -164,6 +164,10 @@ public:
     
     Four    genAccessPlan(OOSQL_AccessPlan* &);
 
+    Four    makeAccessPlan(OOSQL_AccessPlan* &);
+
+    Four    copyCompiledQuery(OOSQL_Compiler& source);
+
 	OQL_GDSPOOL& getPool() { return *m_pool; }
 
 	friend OQL_OutStream& operator<<(OQL_OutStream& os, OOSQL_Compiler& object);
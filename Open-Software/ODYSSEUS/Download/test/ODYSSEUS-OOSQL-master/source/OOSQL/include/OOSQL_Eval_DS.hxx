@@ -192,6 +192,267 @@ struct  EvalStatus {
         Four    lastPlanElemOfCurrNestedLoop;
 };
 
+/************************************************************************
+ *      partition-based spatial join                                    *
+ *                                                                      *
+ *      NOTE: the MBRs of the inner class are partitioned by a uniform  *
+ *            grid once, and each outer MBR probes the cells it covers  *
+ *            instead of opening an MLGF index scan                     *
+ ************************************************************************/
+struct OOSQL_SpatialJoinEntry {
+	OOSQL_StorageManager::OID	oid;			// oid of an inner object
+	float						xmin, ymin;		// MBR of the inner object
+	float						xmax, ymax;
+};
+
+class OOSQL_SpatialHashJoin : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_SpatialHashJoin();
+	virtual ~OOSQL_SpatialHashJoin();
+
+	Four build(OOSQL_StorageManager* storageManager, Four ocn, Four colNo, OOSQL_StorageManager::LockParameter* lockup);
+	Four openProbe(OOSQL_StorageManager::Region& region, Four spatialOp);
+	Four nextProbe(OOSQL_StorageManager::OID* oid);
+
+private:
+	Four	getCellX(float x);
+	Four	getCellY(float y);
+	Boolean	isMatched(OOSQL_SpatialJoinEntry* entry);
+
+	Four						nEntries;		// the # of inner objects
+	OOSQL_SpatialJoinEntry*		entries;
+	Four						nCellsX;		// the # of cells along each axis
+	Four						nCellsY;
+	Four*						cellStart;		// cellEntries[cellStart[c]..cellStart[c+1]-1] overlap the cell c
+	Four*						cellEntries;	// indexes into entries; an MBR is stored in every cell it overlaps
+	float						xmin, ymin;		// extent of the grid
+	float						cellWidth, cellHeight;
+
+	/* state of the current probe */
+	OOSQL_StorageManager::Region	probeRegion;
+	Four							probeOp;		// OP_GEO_XXX of the index scan replaced
+	Four							probeX1, probeY1, probeX2, probeY2;
+	Four							probeX, probeY;	// the current cell
+	Four							probePos;		// the next position in the current cell
+};
+
+/************************************************************************
+ *      hash join                                                       *
+ *                                                                      *
+ *      NOTE: the join column of the inner class is hashed once into    *
+ *            partitions and each outer object probes the partition of  *
+ *            its key instead of scanning the inner class. Partitions   *
+ *            that do not fit in the sort buffer are spilled to         *
+ *            temporary files                                           *
+ ************************************************************************/
+struct OOSQL_HashJoinEntry {
+	UFour						hashValue;		// hash value of the join column
+	OOSQL_StorageManager::OID	oid;			// oid of an inner object
+};
+
+class OOSQL_TempFileInfo;
+
+class OOSQL_HashJoin : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_HashJoin(Four memoryLimit);
+	virtual ~OOSQL_HashJoin();
+
+	Four	getPartition(UFour hashValue) { return (Four)(hashValue % OOSQL_HASHJOIN_NPARTITIONS); }
+	Four	insert(UFour hashValue, OOSQL_StorageManager::OID* oid);
+	Four	getVictim();
+	void	freePartition(Four partition);
+	Four	sortPartitions();
+
+	Four	openProbe(UFour hashValue);
+	void	closeProbe() { probePartition = -1; }
+	Four	nextProbe(OOSQL_StorageManager::OID* oid);
+
+	static UFour hashNumber(double number);
+	static UFour hashString(char* string, Four length);
+
+	Four					memoryLimit;	// the # of bytes the in-memory partitions may use
+	Four					memoryUsed;
+	OOSQL_HashJoinEntry*	entries[OOSQL_HASHJOIN_NPARTITIONS];	// in-memory partitions, sorted by hash value after the build
+	Four					nEntries[OOSQL_HASHJOIN_NPARTITIONS];
+	Four					nAllocated[OOSQL_HASHJOIN_NPARTITIONS];
+	OOSQL_TempFileInfo*		spillFiles[OOSQL_HASHJOIN_NPARTITIONS];	// temporary files of the spilled partitions
+
+private:
+	/* state of the current probe of an in-memory partition */
+	UFour					probeHashValue;
+	Four					probePartition;
+	Four					probePos;
+};
+
+/************************************************************************
+ *      hash aggregation                                                *
+ *                                                                      *
+ *      NOTE: the groups of GROUP BY are kept in an open addressing     *
+ *            hash table instead of sorting the input. A group saves    *
+ *            the evaluation buffer of its first object together with   *
+ *            the intermediate aggregate function results. Objects of   *
+ *            new groups are spilled to temporary files by hash value   *
+ *            when the table exceeds the sort buffer, and the spilled   *
+ *            files are aggregated after the groups in memory           *
+ ************************************************************************/
+class OOSQL_HashAggregation : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_HashAggregation(Four nCols, Four memoryLimit);
+	virtual ~OOSQL_HashAggregation();
+
+	Four	getPartition(UFour hashValue) 
+	{ return (Four)((hashValue >> (32 - OOSQL_HASHAGGR_PARTITIONBITS * (level + 1))) % OOSQL_HASHAGGR_NPARTITIONS); }
+	Boolean	isFull() { return (memoryUsed > memoryLimit && level < OOSQL_HASHAGGR_MAXLEVEL) ? SM_TRUE : SM_FALSE; }
+
+	Four	getSlot(UFour hashValue) { return (Four)(hashValue & (tableSize - 1)); }
+	Four	probe(UFour hashValue, Four* slot);
+	Four	insert(UFour hashValue);
+	char*	getRecord(Four group) { return records + recordSize * group; }
+	void	clear();
+
+	Four	pushSpillFile(OOSQL_TempFileInfo* spillFile, Four spillLevel);
+	OOSQL_TempFileInfo* popSpillFile(Four* spillLevel);
+
+	Four					recordSize;		// the # of bytes of a saved group
+	Four*					strOffsets;		// offset of the string of each column in a saved group or NIL
+	Four					memoryLimit;	// the # of bytes the hash table may use
+	Four					memoryUsed;
+	Four					level;			// the # of times the current input has been partitioned
+
+	Four					nGroups;
+	Four					nextGroup;		// the next group to return
+	OOSQL_TempFileInfo*		spillFiles[OOSQL_HASHAGGR_NPARTITIONS];	// temporary files of the current input
+
+private:
+	Four	grow();
+
+	Four					tableSize;		// the # of slots, a power of 2
+	Four*					table;			// group index of each slot or NIL
+	UFour*					hashValues;		// hash value of each group
+	char*					records;		// saved groups
+	Four					nAllocated;
+
+	/* spilled files which are not aggregated yet */
+	OOSQL_TempFileInfo**	pendingFiles;
+	Four*					pendingLevels;
+	Four					nPendingFiles;
+	Four					nAllocatedPendingFiles;
+};
+
+/************************************************************************
+ *      batch scan                                                      *
+ *                                                                      *
+ *      NOTE: a sequential scan whose WHERE condition consists of       *
+ *            arithmetic comparisons on the columns of the scanned      *
+ *            class reads a batch of objects at a time. Only the        *
+ *            columns of the condition are read into vectors, the       *
+ *            condition is evaluated over the vectors into a selection  *
+ *            vector, and the other columns are read for the selected   *
+ *            objects only                                              *
+ ************************************************************************/
+struct OOSQL_BatchVector {
+	Boolean				isReal;			// SM_TRUE if the values are in rvalues, otherwise in ivalues
+	Eight_Invariable*	ivalues;
+	double*				rvalues;
+	One*				nullFlags;
+};
+
+class OOSQL_BatchScan : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_BatchScan(Four nUsedCols);
+	virtual ~OOSQL_BatchScan();
+
+	void	reset() { nObjects = nSelected = nextSelected = 0; endOfScan = SM_FALSE; isFiltered = SM_FALSE; }
+	Four	addColumn(Four mappedColNo, Four colNo, Four typeId, Four length);
+	Four	copyColumns(OOSQL_BatchScan* source);
+
+	/* scratch vectors and selection vectors are allocated and freed like a stack */
+	OOSQL_BatchVector*	allocVector(Boolean isReal);
+	Four*				allocSelection();
+
+	AP_CondListPoolIndex					condNodes;		// the WHERE condition the batch is filtered by
+	Boolean									isVectorized;	// SM_FALSE if the condition is checked an object at a time
+	Boolean									isFiltered;		// SM_TRUE if the object in the evaluation buffer satisfies the condition
+
+	/* columns of the condition */
+	Four									nCols;
+	Four*									colMap;			// vector index of each used column or NIL
+	Four*									colTypes;
+	OOSQL_StorageManager::ColListStruct*	clist;
+	OOSQL_BatchVector*						colVectors;
+
+	OOSQL_StorageManager::OID				oids[OOSQL_BATCHSCAN_SIZE];
+	Four									nObjects;
+	Four									selection[OOSQL_BATCHSCAN_SIZE];
+	Four									nSelected;
+	Four									nextSelected;
+	Boolean									endOfScan;
+
+	Four									nUsedVectors;
+	Four									nUsedSelections;
+
+private:
+	Four									nUsedCols;
+	OOSQL_BatchVector*						vectors;
+	Four									nVectors;
+	Four**									selections;
+	Four									nSelections;
+};
+
+#ifdef COSMOS_MULTITHREAD
+/************************************************************************
+ *      parallel scan                                                   *
+ *                                                                      *
+ *      NOTE: the query thread reads the batches of a batch scan into   *
+ *            a ring of morsels, and worker threads evaluate the WHERE  *
+ *            condition over the morsels. The query thread returns the  *
+ *            selected objects of the morsels in the order of the ring, *
+ *            that is, in the order of the scan                         *
+ ************************************************************************/
+#define MORSEL_EMPTY		0		// free to be read
+#define MORSEL_FILLED		1		// read, waiting for a worker
+#define MORSEL_FILTERING	2		// being filtered by a worker
+#define MORSEL_FILTERED		3		// filtered, waiting for the query thread
+
+class OOSQL_Evaluator;
+
+class OOSQL_ParallelScan : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_ParallelScan(OOSQL_Evaluator* evaluator, Four nMorsels);
+	virtual ~OOSQL_ParallelScan();
+
+	Four	init(OOSQL_BatchScan* batchScan, Four nUsedCols, Four nWorkers);
+	Four	reset();
+
+	Four	getState(Four morselNo);
+	Four	submit(Four morselNo);
+	Four	release(Four morselNo);
+	Four	waitFiltered(Four morselNo);
+
+	static void*	workerMain(void* arg);
+
+	OOSQL_Evaluator*		evaluator;
+	AP_CondListPoolIndex	condNodes;		// the WHERE condition the morsels are filtered by
+
+	Four					nMorsels;
+	OOSQL_BatchScan**		morsels;
+	Four*					states;
+	Four*					errors;			// error code of filtering each morsel
+	Four					nextToFill;
+	Four					nextToConsume;
+	Boolean					endOfScan;
+	Four					nWorkers;
+
+private:
+	OOSQL_MemoryManager*	morselMemoryManager;	// memory of the morsels, shared with the workers
+	cosmos_thread_mutex_t	mutex;
+	cosmos_thread_cond_t	filledCond;		// signaled when a morsel is filled
+	cosmos_thread_cond_t	filteredCond;	// signaled when a morsel is filtered
+	cosmos_thread_t*		workers;
+	Boolean					shutdown;
+};
+#endif
+
 /************************************************************************
  *      data structures necessary for storing access information        *
  ************************************************************************/
@@ -211,6 +472,9 @@ public:
 	OOSQL_TextIR_PostingQueue				postingQueue;
 	OOSQL_TextIR_PostingQueue				op1PostingQueue;
 	OOSQL_TextIR_PostingQueue				op2PostingQueue;
+	OOSQL_SpatialHashJoin*					spatialJoin;	// replaces the MLGF index scans of a spatial join
+	Four									nProbes;		// the # of MLGF index scans opened for a spatial join
+	OOSQL_HashJoin*							hashJoin;		// hash table of the inner class of a hash join
 
 	OOSQL_ScanInfo() : postingQueue(pMemoryManager), op1PostingQueue(pMemoryManager), op2PostingQueue(pMemoryManager) {
 		ocn             = -1;
@@ -224,6 +488,9 @@ public:
 		colNoMap        = NULL;
 		indexNode       = NULL;
 		fnMatchResult	= NULL;
+		spatialJoin		= NULL;
+		nProbes			= 0;
+		hashJoin		= NULL;
 	}
 };
 
@@ -284,6 +551,16 @@ public:
 		Four									writeOcn;
 		OOSQL_StorageManager::ColListStruct*	writeColList;
 
+		// groups of a GROUP BY made by hashing
+		OOSQL_HashAggregation*					hashAggregation;
+
+		// vectors of a sequential scan read a batch at a time
+		OOSQL_BatchScan*						batchScan;
+#ifdef COSMOS_MULTITHREAD
+		// worker threads filtering the batches of batchScan
+		OOSQL_ParallelScan*						parallelScan;
+#endif
+
         /* list of access for an access plan element
          * NOTE: An access plan element accesses the class and its subclass(es),
          *       so an access element contains the information to access a class.
@@ -196,6 +196,9 @@ struct OOSQL_FastEncodingInfo {
 
 class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
 		friend class OOSQL_MultipleResultBuffer;
+#ifdef COSMOS_MULTITHREAD
+		friend class OOSQL_ParallelScan;
+#endif
 
 		/*----------------------------------------------------------------------*
 		 *      private member variables                                        *
@@ -278,6 +281,8 @@ class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
 
 		Four							m_compareMode;
 
+		Four							m_degreeOfParallelism;	// # of threads evaluating a sequential scan
+
 		/*----------------------------------------------------------------------*
 		*      private member functions                                        *
 		*----------------------------------------------------------------------*/
@@ -321,6 +326,15 @@ class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
         Four    openTempSeqScan(Four planIndex, Four accessListIndex);
         Four    openSeqScan(Four planIndex, Four accessElemIndex);
         Four    closeSeqScan(Four planIndex, Four accessListIndex);
+        Four    initBatchScan(Four planIndex);
+        Four    batchScanNext(Four planIndex, Four accessElemIndex);
+        Four    fillBatchScan(Four planIndex, Four scanId);
+        Four    readBatch(Four scanId, OOSQL_BatchScan* batchScan);
+#ifdef COSMOS_MULTITHREAD
+        Four    initParallelScan(Four planIndex);
+        Four    parallelScanNext(Four planIndex, Four accessElemIndex);
+        Four    fillParallelScan(Four scanId, OOSQL_ParallelScan* parallelScan);
+#endif
 
         /* 
          * functions to execute B-tree index scan 
@@ -356,6 +370,17 @@ class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
         Four    closeMLGF_IndexScan(Four planIndex, Four accessElemIndex);
         Four    mlgfIndexScanNext(Four planIndex, Four accessElemIndex);
 
+        /*
+         * functions to execute hash join
+         */
+        Four    openHashJoin(Four planIndex, Four accessElemIndex);
+        Four    closeHashJoin(Four planIndex, Four accessElemIndex);
+        Four    finalHashJoin(Four planIndex, Four accessElemIndex);
+        Four    hashJoinNext(Four planIndex, Four accessElemIndex);
+        Four    buildHashJoin(Four planIndex, Four accessElemIndex);
+        Four    spillHashJoinPartition(OOSQL_HashJoin* hashJoin, Four partition);
+        Four    writeHashJoinSpillFile(OOSQL_TempFileInfo* spillFile, UFour hashValue, OOSQL_StorageManager::OID* oid);
+
 		/************************************
 		 *  functions for evalution control *
 		 ************************************/
@@ -403,6 +428,14 @@ class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
         // check WHERE condition for the current access plan element
         Four            checkWhereCond();
 
+        // check WHERE condition for a batch of objects read by a sequential scan
+        Four            isBatchCond(Four planIndex, AP_ExprPoolIndex*);
+        Four            isBatchValue(Four planIndex, AP_ExprPoolIndex*);
+        Four            checkBatchWhereCond(OOSQL_BatchScan*);
+        Four            evalBatchCond(OOSQL_BatchScan*, AP_ExprPoolIndex*, Four*, Four*);
+        Four            evalBatchValue(OOSQL_BatchScan*, AP_ExprPoolIndex*, Four*, Four, OOSQL_BatchVector**);
+        Four            convertBatchVectorToReal(OOSQL_BatchScan*, Four*, Four, OOSQL_BatchVector**);
+
         // evaluate an expression
         Four            evalExpression(AP_ExprPoolIndex*, OOSQL_DB_Value*);
 		Four			evalExpression(AP_PathExprAccessInfo*, OOSQL_DB_Value*);
@@ -518,6 +551,19 @@ class OOSQL_Evaluator : public OOSQL_MemoryManagedObject {
         // check if the current object belongs to the current group
         Four    isSameGroupByKey();
 
+        // make groups by hashing
+        Four    hashAggregationNext(Four planIndex, Four accessElemIndex);
+        Four    initHashAggregation(Four planIndex);
+        Four    buildHashAggregation(Four planIndex, Four accessElemIndex, OOSQL_TempFileInfo* input, Four level);
+        Four    insertHashAggregation(Four planIndex);
+        Four    hashGroupByKey(Four planIndex, UFour* hashValue);
+        Four    isSameHashGroup(Four planIndex, char* record);
+        Four    saveHashGroup(Four planIndex, char* record, Boolean aggrOnly);
+        Four    restoreHashGroup(Four planIndex, char* record, Boolean aggrOnly);
+        Four    spillHashAggregation(Four planIndex, Four partition);
+        Four    destroyHashAggregationFile(OOSQL_TempFileInfo* spillFile);
+        Four    finalHashAggregation(Four planIndex);
+
         Four    prepareGroupingAndAggrFunc(Four);
 
         // process aggregate function
@@ -728,6 +774,8 @@ public:
 		Four	GetComplexTypeInfo(Two columnNo, OOSQL_ComplexTypeInfo* complexTypeInfo);
 
 		Four 	EstimateNumResults(Four* nResults);
+
+		void	SetDegreeOfParallelism(Four degree) { m_degreeOfParallelism = degree; }
 };
 
 inline Four OOSQL_Evaluator::resetCurrentWhereCondNodes()
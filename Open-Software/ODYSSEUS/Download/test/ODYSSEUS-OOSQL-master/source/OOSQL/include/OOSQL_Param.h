@@ -93,6 +93,27 @@
 #define TEXTIR_MAXNPOSTINGS_FOR_SUBPLANTERMINAL	(10000)	
 #define TEXTIR_MINNPOSTINGS_FOR_SUBPLANTERMINAL	(500000)
 
+#define OOSQL_SPATIALJOIN_MINNPROBES		(1000)
+#define OOSQL_SPATIALJOIN_NENTRIES_PER_CELL	(4)
+#define OOSQL_SPATIALJOIN_MAXNCELLS_PER_AXIS	(1024)
+
+#define OOSQL_HASHJOIN_NPARTITIONS			(64)
+#define OOSQL_HASHJOIN_MAXKEYLENGTH			(256)
+
+#define OOSQL_HASHAGGR_NPARTITIONS			(64)
+#define OOSQL_HASHAGGR_PARTITIONBITS		(6)
+#define OOSQL_HASHAGGR_MAXLEVEL				(4)
+#define OOSQL_HASHAGGR_MAXNINDEXES			(20)
+
+#define OOSQL_BATCHSCAN_SIZE				(1024)
+
+#define OOSQL_PARALLELSCAN_DEGREE			(1)
+#define OOSQL_PARALLELSCAN_MAXDEGREE		(16)
+
+#define OOSQL_PLANCACHE_SIZE				(64)
+#define OOSQL_PLANCACHE_NBUCKETS			(127)
+#define OOSQL_PLANCACHE_VERSIONCOUNTER		"LOM_SYS_CATALOGVERSION"
+
 #define HEURISTIC_BOUNS_WEIGHT_VALUE 1000000.0		
 #define HEURISTIC_MINUS_WEIGHT_MULTIPLY_VALUE 1.3	
 #define HEURISTIC_MODEL								
@@ -0,0 +1,170 @@
+/******************************************************************************/
+/*                                                                            */
+/*    Copyright (c) 1990-2016, KAIST                                          */
+/*    All rights reserved.                                                    */
+/*                                                                            */
+/*    Redistribution and use in source and binary forms, with or without      */
+/*    modification, are permitted provided that the following conditions      */
+/*    are met:                                                                */
+/*                                                                            */
+/*    1. Redistributions of source code must retain the above copyright       */
+/*       notice, this list of conditions and the following disclaimer.        */
+/*                                                                            */
+/*    2. Redistributions in binary form must reproduce the above copyright    */
+/*       notice, this list of conditions and the following disclaimer in      */
+/*       the documentation and/or other materials provided with the           */
+/*       distribution.                                                        */
+/*                                                                            */
+/*    3. Neither the name of the copyright holder nor the names of its        */
+/*       contributors may be used to endorse or promote products derived      */
+/*       from this software without specific prior written permission.        */
+/*                                                                            */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS     */
+/*    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT       */
+/*    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS       */
+/*    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE          */
+/*    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,    */
+/*    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;        */
+/*    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER        */
+/*    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT      */
+/*    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN       */
+/*    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE         */
+/*    POSSIBILITY OF SUCH DAMAGE.                                             */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/OOSQL DB-IR-Spatial Tightly-Integrated DBMS                    */
+/*    Version 5.0                                                             */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: odysseus.oosql@gmail.com                                        */
+/*                                                                            */
+/*    Bibliography:                                                           */
+/*    [1] Whang, K., Lee, J., Lee, M., Han, W., Kim, M., and Kim, J., "DB-IR  */
+/*        Integration Using Tight-Coupling in the Odysseus DBMS," World Wide  */
+/*        Web, Vol. 18, No. 3, pp. 491-520, May 2015.                         */
+/*    [2] Whang, K., Lee, M., Lee, J., Kim, M., and Han, W., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with IR Features," In Proc. */
+/*        IEEE 21st Int'l Conf. on Data Engineering (ICDE), pp. 1104-1105     */
+/*        (demo), Tokyo, Japan, April 5-8, 2005. This paper received the Best */
+/*        Demonstration Award.                                                */
+/*    [3] Whang, K., Park, B., Han, W., and Lee, Y., "An Inverted Index       */
+/*        Storage Structure Using Subindexes and Large Objects for Tight      */
+/*        Coupling of Information Retrieval with Database Management          */
+/*        Systems," U.S. Patent No.6,349,308 (2002) (Appl. No. 09/250,487     */
+/*        (1999)).                                                            */
+/*    [4] Whang, K., Lee, J., Kim, M., Lee, M., Lee, K., Han, W., and Kim,    */
+/*        J., "Tightly-Coupled Spatial Database Features in the               */
+/*        Odysseus/OpenGIS DBMS for High-Performance," GeoInformatica,        */
+/*        Vol. 14, No. 4, pp. 425-446, Oct. 2010.                             */
+/*    [5] Whang, K., Lee, J., Kim, M., Lee, M., and Lee, K., "Odysseus: a     */
+/*        High-Performance ORDBMS Tightly-Coupled with Spatial Database       */
+/*        Features," In Proc. 23rd IEEE Int'l Conf. on Data Engineering       */
+/*        (ICDE), pp. 1493-1494 (demo), Istanbul, Turkey, Apr. 16-20, 2007.   */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _OOSQL_PLANCACHE_H_
+#define _OOSQL_PLANCACHE_H_
+
+#include "OOSQL_Common.h"
+#include "OOSQL_MemoryManager.hxx"
+#include "OOSQL_MemoryManagedObject.hxx"
+#include "OOSQL_Compiler.hxx"
+
+/*
+    MODULE:
+        OOSQL_PlanCache.hxx
+
+    DESCRIPTION:
+        This header defines the cache of compiled queries kept for each system
+        handle. A statement is looked up by its volume and its text with runs
+        of blanks outside of literals collapsed. On a hit, the compiled query
+        is copied into the compiler of the preparing query, so parsing,
+        semantic checking and plan generation are skipped and only the
+        OOSQL_AccessPlan object is rebuilt.
+
+        Entries are replaced in LRU order. Each entry is tagged with the
+        catalog version of its volume, a counter kept in the catalog of the
+        volume. DDL statements increase the counter in their transaction, so
+        the entries compiled against an older catalog are dropped, even if
+        the DDL is executed by another process. The counter is created by
+        the first DDL statement; until then the queries of the volume are
+        not cached.
+
+        Every entry of every cache in the process is also dropped by
+        InvalidateAll(), which is called after DDL statements are executed
+        and when a transaction that has executed DDL is aborted. The abort
+        rolls the counter back, so a plan compiled against the aborted
+        catalog would otherwise match the version again.
+*/
+
+class OOSQL_PlanCacheEntry {
+public:
+	Four					m_volID;
+	Four					m_catalogVersion;	// catalog version of the volume the query was compiled against
+	char*					m_queryStr;
+	UFour					m_hashValue;
+	OOSQL_Compiler*			m_compiler;		// holds the compiled query
+
+	OOSQL_PlanCacheEntry*	m_hashNext;
+	OOSQL_PlanCacheEntry*	m_lruPrev;		// toward the most recently used entry
+	OOSQL_PlanCacheEntry*	m_lruNext;		// toward the least recently used entry
+};
+
+class OOSQL_PlanCache : public OOSQL_MemoryManagedObject {
+public:
+	OOSQL_PlanCache(Four capacity);
+	virtual ~OOSQL_PlanCache();
+
+	Four	Lookup(OOSQL_StorageManager* storageManager, Four volID, char* queryStr, OOSQL_Compiler* compiler, Boolean* found);
+	Four	Insert(OOSQL_StorageManager* storageManager, Four volID, char* queryStr, OOSQL_Compiler* compiler);
+	Four	Clear();
+
+	Four	IncreaseCatalogVersion(OOSQL_StorageManager* storageManager, Four volID);
+	Four	EndTransaction(Boolean isAborted);
+
+	Four	GetNumEntries()			{ return m_nEntries; }
+	Four	GetNumHits()			{ return m_nHits; }
+	Four	GetNumMisses()			{ return m_nMisses; }
+	Four	GetNumEvictions()		{ return m_nEvictions; }
+	Four	GetNumInvalidations()	{ return m_nInvalidations; }
+	void	ResetStatistics();
+
+	static Boolean	IsCacheableQuery(OOSQL_QueryType queryType);
+	static Boolean	IsDDLQuery(OOSQL_QueryType queryType);
+	static Four		InvalidateAll();
+
+private:
+	Four	NormalizeQueryString(char* queryStr, char** normalizedStr, UFour* hashValue);
+	OOSQL_PlanCacheEntry* Find(Four volID, char* normalizedStr, UFour hashValue);
+	void	Unlink(OOSQL_PlanCacheEntry* entry);
+	void	LinkAtHead(OOSQL_PlanCacheEntry* entry);
+	Four	DestroyEntry(OOSQL_PlanCacheEntry* entry);
+	Four	CheckCatalogVersion();
+	Four	GetCatalogVersion(OOSQL_StorageManager* storageManager, Four volID, Four* catalogVersion, Boolean* isVersioned);
+
+	Four					m_capacity;
+	Four					m_nEntries;
+	OOSQL_PlanCacheEntry*	m_buckets[OOSQL_PLANCACHE_NBUCKETS];
+	OOSQL_PlanCacheEntry*	m_lruHead;
+	OOSQL_PlanCacheEntry*	m_lruTail;
+	Four					m_catalogVersion;	// process-wide version the entries were compiled against
+	Four					m_unversionedVolIDs[MAXNUMOFVOLS];	// volumes whose catalogs have no version counter
+	Four					m_nUnversionedVols;
+	Boolean					m_ddlInTransaction;	// SM_TRUE if the current transaction has executed DDL
+
+	// statistics
+	Four					m_nHits;
+	Four					m_nMisses;
+	Four					m_nEvictions;
+	Four					m_nInvalidations;
+};
+
+#endif // _OOSQL_PLANCACHE_H_
@@ -126,6 +126,7 @@ class OOSQL_ServerQuery {
 	OOSQL_QueryType						m_queryType;
 	OOSQL_ExternalFunctionManager*		m_externalFunctionManager;
 	OOSQL_ExternalFunctionDispatcher*	m_externalFunctionDispatcher;
+	Four								m_degreeOfParallelism;	// # of threads evaluating a sequential scan
 
 	// stroage manager and it's catalog
 	OOSQL_StorageManager*				m_storageManager;
@@ -165,6 +166,7 @@ public:
 	Four    GetClassName(Two targetNo, char* className, Four bufferLength);
 	Four	EstimateNumResults(Four* nResults);
 	Four	DumpPlan(void* outBuffer, int outBufferLength);
+	Four	SetDegreeOfParallelism(Four degree);
 	OOSQL_QueryType GetQueryType() { return m_queryType; }
 
 	Four	GetVolumeID() { return m_volID; }
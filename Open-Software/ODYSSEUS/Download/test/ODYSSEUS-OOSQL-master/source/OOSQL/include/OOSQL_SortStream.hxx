@@ -106,6 +106,8 @@ public:
 	Four FastEncodedCreateObject();
 	Four FastEncodedNextScan();
 	
+	Four SetLimit(Four nTuples);
+
 	Four Sort();
 
 	Four OpenScan();
@@ -118,6 +120,10 @@ protected:
 	Four QuickSort();
 	Four MergeSort();
 	Four MergeSort(Four lo, Four hi);
+	void ChooseCompareFunc();
+	void BuildTopKHeap();
+	void SiftDownTopKHeap(Four i);
+	bool IsRejectedByTopK();
 
 	Four									m_volID;				
 	Four									m_sortStreamID;			
@@ -146,6 +152,10 @@ protected:
 
 	char*									m_mergeBuffer;
 
+	Four									m_limit;			// > 0 if only the first m_limit tuples in sort order are needed
+	bool									m_useTopK;			// the tuples are kept in a heap of m_limit tuples in the sort buffer
+	char*									m_topKSwapBuffer;
+
 	int (*m_compareFunc)(OOSQL_StorageManager::SortTupleDesc* sortTupleDesc, void *elem1, void *elem2);
 };
 
@@ -331,6 +341,27 @@ inline Four OOSQL_SortStream::PutTuple(OOSQL_StorageManager::SortStreamTuple* so
 	Four e;
 	Four i;
 
+	if(m_useTopK)
+	{
+		if(m_nSortTuples < m_limit)
+		{
+			memcpy(m_sortBufferTail, sortTuple->data, m_sortTupleDataLen);
+			m_sortBufferTail += m_sortTupleDataLen;
+			m_nSortTuples ++;
+
+			if(m_nSortTuples == m_limit)
+				BuildTopKHeap();
+		}
+		else if(m_compareFunc(&m_sortTupleDesc, sortTuple->data, m_sortBuffer) < 0)
+		{
+			/* replace the last tuple of the first m_limit tuples */
+			memcpy(m_sortBuffer, sortTuple->data, m_sortTupleDataLen);
+			SiftDownTopKHeap(0);
+		}
+
+		return eNOERROR;
+	}
+
 	if(m_useInMemorySorting)
 	{
 		m_sortBufferFreeSize -= m_sortTupleDataLen;
@@ -412,6 +443,14 @@ inline Four OOSQL_SortStream::GetTuple(OOSQL_StorageManager::SortStreamTuple* so
 	}
 }
 
+inline bool OOSQL_SortStream::IsRejectedByTopK()
+{
+	/* the key of the new tuple is in m_keyBuffer and the root of the heap is the 
+	   last tuple of the first m_limit tuples */
+	return m_useTopK && m_nSortTuples == m_limit && 
+		   m_compareFunc(&m_sortTupleDesc, m_keyBuffer, m_sortBuffer) >= 0;
+}
+
 inline Four OOSQL_SortStream::FastCreateObject(Four nCols, OOSQL_StorageManager::ColListStruct* clist)
 {
 	Four			e;
@@ -469,6 +508,10 @@ inline Four OOSQL_SortStream::FastCreateObject(Four nCols, OOSQL_StorageManager:
 		}
 	}
 
+	/* a tuple which cannot be among the first m_limit tuples is not stored */
+	if(IsRejectedByTopK())
+		return eNOERROR;
+
 	if(!m_stringTypeExist)
 	{
 		e = m_largeTemporaryObject.AppendData(sizeof(OOSQL_StorageManager::ColListStruct) * nCols, clist);
@@ -586,6 +629,24 @@ inline Four OOSQL_SortStream::FastEncodedCreateObject()
 	memcpy(p, &posHigh, sizeof(UFour)); p += sizeof(UFour);
 	memcpy(p, &posLow,  sizeof(UFour));
 
+	for(i = 0; i < m_nFastEncodingInfos; i++)
+	{
+		offset = m_keyEncodingInfo[i].offset;
+
+		if(offset != NIL)
+		{
+			memset(m_keyBuffer + offset, 0, m_keyEncodingInfo[i].size);
+			if(!*m_fastEncodingInfos[i].nullFlag)
+			{
+				memcpy(m_keyBuffer + offset, m_fastEncodingInfos[i].ptr, *m_fastEncodingInfos[i].size);
+			}
+		}
+	}
+
+	/* a tuple which cannot be among the first m_limit tuples is not stored */
+	if(IsRejectedByTopK())
+		return eNOERROR;
+
 	for(i = 0; i < m_nFastEncodingInfos; i++)
 	{
 		size = *m_fastEncodingInfos[i].size;
@@ -601,17 +662,6 @@ inline Four OOSQL_SortStream::FastEncodedCreateObject()
 		{
 			memcpy(p, m_fastEncodingInfos[i].ptr, size);
 		}
-
-		offset = m_keyEncodingInfo[i].offset;
-
-		if(offset != NIL)
-		{
-			memset(m_keyBuffer + offset, 0, m_keyEncodingInfo[i].size);
-			if(!*m_fastEncodingInfos[i].nullFlag)
-			{
-				memcpy(m_keyBuffer + offset, m_fastEncodingInfos[i].ptr, size);
-			}
-		}
 	}
 
 	e = PutTuple(&m_sortTuple);
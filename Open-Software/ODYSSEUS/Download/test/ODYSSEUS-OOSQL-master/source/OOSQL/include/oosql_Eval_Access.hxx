@@ -169,6 +169,22 @@ inline Four OOSQL_Evaluator::seqScanNext(
 
         case CLASSKIND_PERSISTENT:
             scanId = EVAL_ACCESSLISTTABLE[planIndex].getCurrScanID();
+
+            /* evaluate the WHERE condition a batch at a time if possible */
+            if(planIndex == m_currPlanIndex && scanId >= 0)
+            {
+                if(EVAL_ACCESSLISTTABLE[planIndex].batchScan == NULL || 
+                   EVAL_ACCESSLISTTABLE[planIndex].batchScan->condNodes != m_currWhereCondNodes)
+                {
+                    e = initBatchScan(planIndex);
+                    OOSQL_CHECK_ERR(e);
+                }
+
+                if(EVAL_ACCESSLISTTABLE[planIndex].batchScan->isVectorized)
+                    return batchScanNext(planIndex, accessElemIndex);
+            }
+            if(EVAL_ACCESSLISTTABLE[planIndex].batchScan != NULL)
+                EVAL_ACCESSLISTTABLE[planIndex].batchScan->isFiltered = SM_FALSE;
             break;
 
         case CLASSKIND_TEMPORARY:
@@ -260,7 +276,10 @@ inline Four OOSQL_Evaluator::mlgfIndexScanNext(
 	while(1)
 	{
 		/* move the scan cursor forward and get the OID of the next object */
-		e = execBtreeIndexInfoNode(indexInfo.getPoolIndex(), oid, cursor);
+		if(scanInfo->spatialJoin)
+			e = scanInfo->spatialJoin->nextProbe(oid);
+		else
+			e = execBtreeIndexInfoNode(indexInfo.getPoolIndex(), oid, cursor);
 		if(e < eNOERROR) 
 		{
 			OOSQL_ERR(e);
@@ -271,7 +290,10 @@ inline Four OOSQL_Evaluator::mlgfIndexScanNext(
 		if(nCols == 0) break;
 
 		/* fetch the next object */
-		e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, oid, nCols, clist);
+		if(scanInfo->spatialJoin)
+			e = m_storageManager->FetchObjectByColList(scanInfo->ocn, SM_FALSE, oid, nCols, clist);
+		else
+			e = m_storageManager->FetchObjectByColList(scanId, SM_TRUE, oid, nCols, clist);
 		if(e < eNOERROR) OOSQL_ERR(e);
 
 		if(nBoolExprs > 0)
@@ -290,6 +312,73 @@ inline Four OOSQL_Evaluator::mlgfIndexScanNext(
     return eNOERROR;
 }
 
+inline Four OOSQL_Evaluator::hashJoinNext(
+	Four planIndex,             /* IN: */
+    Four accessElemIndex)       /* IN: */
+/*
+    Function:
+		Get the next inner object whose join column has the hash value of
+		the current outer key. The candidates are refined by the WHERE
+		condition since different keys may have the same hash value.
+
+    Side effect:
+
+    Referenced member variables:
+
+    Return value:
+*/
+{
+	OOSQL_ScanInfo*							scanInfo;
+	OOSQL_StorageManager::OID*				oid;
+	OOSQL_StorageManager::OID				spillOid;
+	OOSQL_StorageManager::ColListStruct		oidCol;
+	Four									e;
+
+	scanInfo = &EVAL_INDEX_SCANINFOTABLEELEMENTS[EVAL_ACCESSLISTTABLE[planIndex].accessList[accessElemIndex].indexInfo.startIndex];
+	oid      = scanInfo->oid;
+
+	if(scanInfo->scanId >= 0)
+	{
+		/* the partition of the key is spilled: read the oid of the next entry from its temporary file */
+		e = m_storageManager->NextObject(scanInfo->scanId, &spillOid, NULL);
+		if(e < eNOERROR) 
+		{
+			OOSQL_ERR(e);
+		}
+		else if(e == EOS)	/* end of scan */
+			return ENDOFSCAN;
+
+		oidCol.colNo      = 1;
+		oidCol.start      = 0;
+		oidCol.length     = OOSQL_TYPE_OID_SIZE;
+		oidCol.dataLength = OOSQL_TYPE_OID_SIZE;
+		e = m_storageManager->FetchObjectByColList(scanInfo->scanId, SM_TRUE, &spillOid, 1, &oidCol);
+		if(e < eNOERROR) OOSQL_ERR(e);
+
+		*oid = oidCol.data.oid;
+	}
+	else
+	{
+		e = scanInfo->hashJoin->nextProbe(oid);
+		if(e < eNOERROR) 
+		{
+			OOSQL_ERR(e);
+		}
+		else if(e == ENDOFSCAN)	/* end of scan */
+			return e;
+	}
+
+	/* fetch the inner object */
+	if(scanInfo->nCols > 0)
+	{
+		e = m_storageManager->FetchObjectByColList(scanInfo->ocn, SM_FALSE, oid, scanInfo->nCols, scanInfo->clist);
+		if(e < eNOERROR) OOSQL_ERR(e);
+	}
+
+    /* return */
+    return eNOERROR;
+}
+
 inline Four OOSQL_Evaluator::execBtreeIndexScan( 
     AP_IndexInfoPoolIndex				indexInfo,      // IN:
     OOSQL_StorageManager::OID*			oid,			// OUT:
@@ -403,7 +492,10 @@ inline Four OOSQL_Evaluator::getNextObject()
                 break;
 
             case ACCESSMETHOD_SEQ_SCAN:
-                accessRC = seqScanNext(m_currPlanIndex, currAccessIndex);
+				if(ACCESSPLANELEMENTS[m_currPlanIndex].hashAggrFlag)
+					accessRC = hashAggregationNext(m_currPlanIndex, currAccessIndex);
+				else
+					accessRC = seqScanNext(m_currPlanIndex, currAccessIndex);
 				if(accessRC == eNOERROR)
 					break;
                 else if(accessRC == ENDOFSCAN) {
@@ -522,6 +614,32 @@ inline Four OOSQL_Evaluator::getNextObject()
 
                 break;
 
+            case ACCESSMETHOD_HASHJOIN:
+                accessRC = hashJoinNext(m_currPlanIndex, currAccessIndex);
+				if(accessRC == eNOERROR)
+					break;
+                else if(accessRC == ENDOFSCAN) {
+                    /* mark that the current scan is ended */
+                    EVAL_ACCESSLISTTABLE[m_currPlanIndex].endOfCurrAccess = SM_TRUE;
+
+                    /* check if all accesses are ended */
+                    if(!EVAL_ACCESSLISTTABLE[m_currPlanIndex].isEndOfAllAccess()) {
+                        /* move to the next access element */
+                        e = EVAL_ACCESSLISTTABLE[m_currPlanIndex].moveToNextAccessElem();
+                        if(e < eNOERROR) OOSQL_ERR(e);
+
+						resetCurrentWhereCondNodes();	
+
+                        /* clear OOSQL_StorageManager::OID at evaluation buffer to read the first object of the next access element */
+                        EVAL_EVALBUFFER[m_currPlanIndex].clearOID();
+                    }
+                }
+                else if(accessRC < eNOERROR) {
+                    OOSQL_ERR(accessRC);
+                }
+
+                break;
+
             default:
                 OOSQL_ERR(eINVALID_ACCESSMETHOD_OOSQL);
         }